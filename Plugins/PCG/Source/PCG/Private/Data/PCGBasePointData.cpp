@@ -5,6 +5,7 @@
 #include "PCGContext.h"
 #include "Data/PCGPointArrayData.h"
 #include "Data/PCGPointData.h"
+#include "Helpers/PCGCrcHelpers.h"
 #include "Helpers/PCGHelpers.h"
 #include "Helpers/PCGPointHelpers.h"
 #include "Helpers/PCGTagHelpers.h"
@@ -754,6 +755,37 @@ void UPCGBasePointData::RebuildOctree() const
 	bOctreeIsDirty = false;
 }
 
+const FPCGPointSpatialIndex& UPCGBasePointData::GetPointSpatialIndex() const
+{
+	RebuildSpatialIndexIfNeeded();
+
+	return PointSpatialIndex;
+}
+
+void UPCGBasePointData::RebuildSpatialIndex() const
+{
+	FScopeLock Lock(&CachedDataLock);
+	if (!bSpatialIndexIsDirty)
+	{
+		return;
+	}
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(UPCGBasePointData::RebuildSpatialIndex)
+
+	const TConstPCGValueRange<FTransform> TransformRange = GetConstTransformValueRange();
+	const TConstPCGValueRange<float> SteepnessRange = GetConstSteepnessValueRange();
+	const TConstPCGValueRange<FVector> BoundsMinRange = GetConstBoundsMinValueRange();
+	const TConstPCGValueRange<FVector> BoundsMaxRange = GetConstBoundsMaxValueRange();
+
+	PointSpatialIndex.Build(GetNumPoints(), GetBounds(), [&TransformRange, &SteepnessRange, &BoundsMinRange, &BoundsMaxRange](int32 PointIndex)
+	{
+		const FBoxSphereBounds PointBounds = PCGPointHelpers::GetDensityBounds(TransformRange[PointIndex], SteepnessRange[PointIndex], BoundsMinRange[PointIndex], BoundsMaxRange[PointIndex]);
+		return FBox::BuildAABB(PointBounds.Origin, PointBounds.BoxExtent);
+	});
+
+	bSpatialIndexIsDirty = false;
+}
+
 void UPCGBasePointData::SetTransform(const FTransform& InTransform)
 {
 	FreeProperties(EPCGPointNativeProperties::Transform);
@@ -980,7 +1012,7 @@ void UPCGBasePointData::GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSiz
 {
 	Super::GetResourceSizeEx(CumulativeResourceSize);
 
-	CumulativeResourceSize.AddDedicatedSystemMemoryBytes(PCGPointOctree.GetSizeBytes() + sizeof(Bounds));
+	CumulativeResourceSize.AddDedicatedSystemMemoryBytes(PCGPointOctree.GetSizeBytes() + PointSpatialIndex.GetAllocatedSize() + sizeof(Bounds));
 }
 
 void UPCGBasePointData::InitializeFromActor(AActor* InActor, bool* bOutOptionalSanitizedTagAttributeName)
@@ -1377,6 +1409,30 @@ void UPCGBasePointData::AddToCrc(FArchiveCrc32& Ar, bool bFullDataCrc) const
 	Ar << NumPoints;
 
 	// Crc point data.
+	if (PCGCrcHelpers::UseParallelCrc())
+	{
+		const PCGCrcHelpers::FChunkedBuffer Buffers[] =
+		{
+			// Skip Metadata entry keys
+			PCGCrcHelpers::MakeValueRangeBuffer(GetConstTransformValueRange()),
+			PCGCrcHelpers::MakeValueRangeBuffer(GetConstDensityValueRange()),
+			PCGCrcHelpers::MakeValueRangeBuffer(GetConstBoundsMinValueRange()),
+			PCGCrcHelpers::MakeValueRangeBuffer(GetConstBoundsMaxValueRange()),
+			PCGCrcHelpers::MakeValueRangeBuffer(GetConstSteepnessValueRange()),
+			PCGCrcHelpers::MakeValueRangeBuffer(GetConstSeedValueRange()),
+			PCGCrcHelpers::MakeValueRangeBuffer(GetConstColorValueRange())
+		};
+
+		// Unallocated properties hold a single value, the number of values per property disambiguates the chunk Crcs.
+		for (const PCGCrcHelpers::FChunkedBuffer& Buffer : Buffers)
+		{
+			int32 NumValues = Buffer.NumValues;
+			Ar << NumValues;
+		}
+
+		PCGCrcHelpers::AddChunkedBuffersToCrc(Ar, Buffers);
+	}
+	else
 	{
 		auto CrcRange = [] <class T> (FArchiveCrc32 & Ar, const TConstPCGValueRange<T>&ValueRange)
 		{
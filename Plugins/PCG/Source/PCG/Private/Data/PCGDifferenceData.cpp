@@ -219,6 +219,92 @@ bool UPCGDifferenceData::SamplePoint(const FTransform& InTransform, const FBox&
 	}
 }
 
+void UPCGDifferenceData::SamplePointsRange(const FPCGSampleQueryRanges& InQueries, FPCGPointValueRanges& OutRanges, int32 OutStartIndex, UPCGMetadata* OutMetadata) const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UPCGDifferenceData::SamplePointsRange);
+	check(GetSource());
+
+	using FSampledPointsBuffer = FPCGSpatialDataProcessing::FSampledPointsBuffer;
+
+	const int32 NumQueries = InQueries.Num;
+	FSampledPointsBuffer PointsFromSource(NumQueries);
+	{
+		FPCGPointValueRanges PointsFromSourceRanges = PointsFromSource.GetValueRanges();
+		GetSource()->SamplePointsRange(InQueries, PointsFromSourceRanges, /*OutStartIndex=*/0, OutMetadata);
+	}
+
+	// The difference is only sampled where the source was hit.
+	// Important note: here we will not use the points we got from the source, otherwise we are introducing severe bias
+	TArray<int32> HitIndices;
+	FSampledPointsBuffer QueriesForDiff(0, EPCGPointNativeProperties::None);
+	for (int32 Index = 0; Index < NumQueries; ++Index)
+	{
+		if (PointsFromSource.Densities[Index] > 0)
+		{
+			HitIndices.Add(Index);
+			QueriesForDiff.AddQuery(InQueries.GetTransform(Index), InQueries, Index);
+		}
+		else
+		{
+			FPCGSpatialDataProcessing::WriteRejectedSample(OutRanges, OutStartIndex + Index);
+		}
+	}
+
+	if (HitIndices.IsEmpty())
+	{
+		return;
+	}
+
+	FSampledPointsBuffer PointsFromDiff(HitIndices.Num(), EPCGPointNativeProperties::Density | EPCGPointNativeProperties::MetadataEntry);
+	if (GetDifference())
+	{
+		FPCGPointValueRanges PointsFromDiffRanges = PointsFromDiff.GetValueRanges();
+		GetDifference()->SamplePointsRange(QueriesForDiff.GetQueries(), PointsFromDiffRanges, /*OutStartIndex=*/0, (bDiffMetadata ? OutMetadata : nullptr));
+	}
+	else
+	{
+		FMemory::Memzero(PointsFromDiff.Densities.GetData(), PointsFromDiff.Densities.Num() * sizeof(float));
+	}
+
+	const bool bBinaryDensity = (DensityFunction == EPCGDifferenceDensityFunction::Binary);
+
+	for (int32 HitIndex = 0; HitIndex < HitIndices.Num(); ++HitIndex)
+	{
+		const int32 Index = HitIndices[HitIndex];
+		const int32 OutIndex = OutStartIndex + Index;
+
+		const float DensityFromDiff = PointsFromDiff.Densities[HitIndex];
+		if (DensityFromDiff > 0)
+		{
+			// Apply difference
+			float& Density = PointsFromSource.Densities[Index];
+			Density = bBinaryDensity ? 0 : FMath::Max(0, Density - DensityFromDiff);
+
+			if (Density <= 0)
+			{
+				FPCGSpatialDataProcessing::WriteRejectedSample(OutRanges, OutIndex);
+				continue;
+			}
+
+			const int64 EntryFromDiff = PointsFromDiff.MetadataEntries[HitIndex];
+			if (bDiffMetadata && OutMetadata && EntryFromDiff != PCGInvalidEntryKey)
+			{
+				// Merged in place in the entry from the source, as SamplePoint does.
+				int64& EntryFromSource = PointsFromSource.MetadataEntries[Index];
+				OutMetadata->MergeAttributesSubset(EntryFromSource, OutMetadata, GetSource()->Metadata, EntryFromDiff, OutMetadata, GetDifference()->Metadata, EntryFromSource, EPCGMetadataOp::Sub);
+			}
+		}
+
+		PointsFromSource.WriteTo(Index, OutRanges, OutIndex);
+	}
+}
+
+void UPCGDifferenceData::ProjectPointsRange(const FPCGSampleQueryRanges& InQueries, const FPCGProjectionParams& InParams, FPCGPointValueRanges& OutRanges, int32 OutStartIndex, UPCGMetadata* OutMetadata) const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UPCGDifferenceData::ProjectPointsRange);
+	ProjectPointsRangeFromSamples(InQueries, InParams, OutRanges, OutStartIndex, OutMetadata);
+}
+
 bool UPCGDifferenceData::HasNonTrivialTransform() const
 {
 	check(GetSource());
@@ -279,20 +365,22 @@ const UPCGBasePointData* UPCGDifferenceData::CreateBasePointData(FPCGContext* Co
 
 	constexpr int ChunkSize = FPCGSpatialDataProcessing::DefaultSamplePointsChunkSize;
 
-	auto ChunkSamplePoints = [this, SourceMetadata, TempDiffMetadata, OutMetadata](const TArrayView<TPair<FTransform, FBox>>& Samples, const UPCGBasePointData* SourcePointData, int32 SourceReadIndex, UPCGBasePointData* TargetPointData, int32 TargetWriteIndex)
+	auto ChunkSamplePoints = [this, SourceMetadata, TempDiffMetadata, OutMetadata](const FPCGSampleQueryRanges& Queries, const UPCGBasePointData* SourcePointData, int32 SourceReadIndex, UPCGBasePointData* TargetPointData, int32 TargetWriteIndex)
 	{
 		int32 NumWritten = 0;
 
 		FConstPCGPointValueRanges SourceRanges(SourcePointData);
 		FPCGPointValueRanges TargetRanges(TargetPointData, /*bAllocate=*/false);
 
-		const int32 NumPoints = Samples.Num();
-
-		TArray<FPCGPoint, TInlineAllocator<ChunkSize>> PointsFromDiff;
-		PointsFromDiff.SetNum(NumPoints);
+		const int32 NumPoints = Queries.Num;
 
-		check(GetDifference());
-		GetDifference()->SamplePoints(Samples, PointsFromDiff, TempDiffMetadata);
+		// Only the properties used below are sampled from the difference.
+		FPCGSpatialDataProcessing::FSampledPointsBuffer PointsFromDiff(NumPoints, EPCGPointNativeProperties::Density | EPCGPointNativeProperties::MetadataEntry);
+		{
+			check(GetDifference());
+			FPCGPointValueRanges PointsFromDiffRanges = PointsFromDiff.GetValueRanges();
+			GetDifference()->SamplePointsRange(Queries, PointsFromDiffRanges, /*OutStartIndex=*/0, TempDiffMetadata);
+		}
 
 		struct FKeptPoint
 		{
@@ -309,9 +397,9 @@ const UPCGBasePointData* UPCGDifferenceData::CreateBasePointData(FPCGContext* Co
 		{
 			const int32 SourceIndex = SourceReadIndex + PointIndex;
 			
-			const FPCGPoint& PointFromDiff = PointsFromDiff[PointIndex];
+			const float DensityFromDiff = PointsFromDiff.Densities[PointIndex];
 
-			const float Density = (bBinaryDensity && PointFromDiff.Density > 0) ? 0.0f : SourceRanges.DensityRange[SourceIndex] - PointFromDiff.Density;
+			const float Density = (bBinaryDensity && DensityFromDiff > 0) ? 0.0f : SourceRanges.DensityRange[SourceIndex] - DensityFromDiff;
 
 			if (Density > 0)
 			{
@@ -330,14 +418,14 @@ const UPCGBasePointData* UPCGDifferenceData::CreateBasePointData(FPCGContext* Co
 				const int32 WriteIndex = TargetWriteIndex + NumWritten;
 				const int32 ReadIndex = SourceReadIndex + KeptPoint.Index;
 
-				const FPCGPoint& PointFromDiff = PointsFromDiff[KeptPoint.Index];
+				const int64 MetadataEntryFromDiff = PointsFromDiff.MetadataEntries[KeptPoint.Index];
 								
 				TargetRanges.SetFromValueRanges(WriteIndex, SourceRanges, ReadIndex);
 				TargetRanges.DensityRange[WriteIndex] = KeptPoint.Density;
 				
-				if (TempDiffMetadata && PointFromDiff.MetadataEntry != PCGInvalidEntryKey)
+				if (TempDiffMetadata && MetadataEntryFromDiff != PCGInvalidEntryKey)
 				{
-					OutMetadata->MergeAttributesSubset(SourceRanges.MetadataEntryRange[ReadIndex], SourceMetadata, SourceMetadata, PointFromDiff.MetadataEntry, TempDiffMetadata, TempDiffMetadata, TargetRanges.MetadataEntryRange[WriteIndex], EPCGMetadataOp::Sub);
+					OutMetadata->MergeAttributesSubset(SourceRanges.MetadataEntryRange[ReadIndex], SourceMetadata, SourceMetadata, MetadataEntryFromDiff, TempDiffMetadata, TempDiffMetadata, TargetRanges.MetadataEntryRange[WriteIndex], EPCGMetadataOp::Sub);
 				}
 				
 				++NumWritten;
@@ -153,6 +153,91 @@ bool UPCGIntersectionData::SamplePoint(const FTransform& InTransform, const FBox
 	return true;
 }
 
+void UPCGIntersectionData::SamplePointsRange(const FPCGSampleQueryRanges& InQueries, FPCGPointValueRanges& OutRanges, int32 OutStartIndex, UPCGMetadata* OutMetadata) const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UPCGIntersectionData::SamplePointsRange);
+	check(GetA() && GetB());
+	const UPCGSpatialData* X = (GetA()->HasNonTrivialTransform() || !GetB()->HasNonTrivialTransform()) ? GetA() : GetB();
+	const UPCGSpatialData* Y = (X == GetA()) ? GetB() : GetA();
+
+	using FSampledPointsBuffer = FPCGSpatialDataProcessing::FSampledPointsBuffer;
+
+	const int32 NumQueries = InQueries.Num;
+	FSampledPointsBuffer PointsFromX(NumQueries, EPCGPointNativeProperties::Transform | EPCGPointNativeProperties::Density | EPCGPointNativeProperties::Color | EPCGPointNativeProperties::MetadataEntry);
+	{
+		FPCGPointValueRanges PointsFromXRanges = PointsFromX.GetValueRanges();
+		X->SamplePointsRange(InQueries, PointsFromXRanges, /*OutStartIndex=*/0, OutMetadata);
+	}
+
+	// Y is only sampled where X was hit, at the transforms sampled from X.
+	TArray<int32> HitIndices;
+	FSampledPointsBuffer QueriesForY(0, EPCGPointNativeProperties::None);
+	for (int32 Index = 0; Index < NumQueries; ++Index)
+	{
+		if (PointsFromX.Densities[Index] > 0)
+		{
+			HitIndices.Add(Index);
+			QueriesForY.AddQuery(PointsFromX.Transforms[Index], InQueries, Index);
+		}
+		else
+		{
+			FPCGSpatialDataProcessing::WriteRejectedSample(OutRanges, OutStartIndex + Index);
+		}
+	}
+
+	if (HitIndices.IsEmpty())
+	{
+		return;
+	}
+
+	FSampledPointsBuffer PointsFromY(HitIndices.Num());
+	{
+		FPCGPointValueRanges PointsFromYRanges = PointsFromY.GetValueRanges();
+		Y->SamplePointsRange(QueriesForY.GetQueries(), PointsFromYRanges, /*OutStartIndex=*/0, OutMetadata);
+	}
+
+	for (int32 HitIndex = 0; HitIndex < HitIndices.Num(); ++HitIndex)
+	{
+		const int32 Index = HitIndices[HitIndex];
+		const int32 OutIndex = OutStartIndex + Index;
+
+		const float DensityFromY = PointsFromY.Densities[HitIndex];
+		if (DensityFromY <= 0)
+		{
+			FPCGSpatialDataProcessing::WriteRejectedSample(OutRanges, OutIndex);
+			continue;
+		}
+
+		// Merge points into a single point
+		PointsFromY.Densities[HitIndex] = PCGIntersectionDataMaths::ComputeDensity(PointsFromX.Densities[Index], DensityFromY, DensityFunction);
+		PointsFromY.Colors[HitIndex] = PointsFromX.Colors[Index] * PointsFromY.Colors[HitIndex];
+
+		if (OutMetadata)
+		{
+			const int64 EntryFromX = PointsFromX.MetadataEntries[Index];
+			int64& EntryFromY = PointsFromY.MetadataEntries[HitIndex];
+
+			if (EntryFromX != PCGInvalidEntryKey && EntryFromY != PCGInvalidEntryKey)
+			{
+				// Merged in place in the entry from Y, as SamplePoint does.
+				OutMetadata->MergeAttributesSubset(EntryFromX, OutMetadata, X->Metadata, EntryFromY, OutMetadata, Y->Metadata, EntryFromY, EPCGMetadataOp::Min);
+			}
+			else if (EntryFromX != PCGInvalidEntryKey)
+			{
+				EntryFromY = EntryFromX;
+			}
+		}
+
+		PointsFromY.WriteTo(HitIndex, OutRanges, OutIndex);
+	}
+}
+
+void UPCGIntersectionData::ProjectPointsRange(const FPCGSampleQueryRanges& InQueries, const FPCGProjectionParams& InParams, FPCGPointValueRanges& OutRanges, int32 OutStartIndex, UPCGMetadata* OutMetadata) const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UPCGIntersectionData::ProjectPointsRange);
+	ProjectPointsRangeFromSamples(InQueries, InParams, OutRanges, OutStartIndex, OutMetadata);
+}
+
 bool UPCGIntersectionData::HasNonTrivialTransform() const
 {
 	check(GetA() && GetB());
@@ -238,19 +323,21 @@ UPCGBasePointData* UPCGIntersectionData::CreateAndFilterPointData(FPCGContext* C
 
 	constexpr int ChunkSize = FPCGSpatialDataProcessing::DefaultSamplePointsChunkSize;
 
-	auto ChunkSamplePoints = [this, SourceMetadata, Y, TempYMetadata, bPointDataHasCommonAttributes](const TArrayView<TPair<FTransform, FBox>>& Samples, const UPCGBasePointData* SourcePointData, int32 SourceReadIndex, UPCGBasePointData* TargetPointData, int32 TargetWriteIndex)
+	auto ChunkSamplePoints = [this, SourceMetadata, Y, TempYMetadata, bPointDataHasCommonAttributes](const FPCGSampleQueryRanges& Queries, const UPCGBasePointData* SourcePointData, int32 SourceReadIndex, UPCGBasePointData* TargetPointData, int32 TargetWriteIndex)
 	{
 		int32 NumWritten = 0;
 
 		const FConstPCGPointValueRanges SourceRanges(SourcePointData);
 		FPCGPointValueRanges TargetRanges(TargetPointData, /*bAllocate=*/false);
 				
-		const int NumPoints = Samples.Num();
-
-		TArray<FPCGPoint, TInlineAllocator<ChunkSize>> PointsFromY;
-		PointsFromY.SetNum(NumPoints);
+		const int NumPoints = Queries.Num;
 
-		Y->SamplePoints(Samples, PointsFromY, TempYMetadata);
+		// Only the properties merged below are sampled from Y.
+		FPCGSpatialDataProcessing::FSampledPointsBuffer PointsFromY(NumPoints, EPCGPointNativeProperties::Density | EPCGPointNativeProperties::Color | EPCGPointNativeProperties::MetadataEntry);
+		{
+			FPCGPointValueRanges PointsFromYRanges = PointsFromY.GetValueRanges();
+			Y->SamplePointsRange(Queries, PointsFromYRanges, /*OutStartIndex=*/0, TempYMetadata);
+		}
 
 		TArray<int32, TInlineAllocator<ChunkSize>> KeptPoints;
 		TArray<int32, TInlineAllocator<ChunkSize>> RejectedPoints;
@@ -258,11 +345,7 @@ UPCGBasePointData* UPCGIntersectionData::CreateAndFilterPointData(FPCGContext* C
 		// Filter points based on output density
 		for (int PointIndex = 0; PointIndex < NumPoints; ++PointIndex)
 		{
-			const int32 SourceIndex = SourceReadIndex + PointIndex;
-
-			FPCGPoint& PointFromY = PointsFromY[PointIndex];
-
-			if (PointFromY.Density > 0)
+			if (PointsFromY.Densities[PointIndex] > 0)
 			{
 				KeptPoints.Add(PointIndex); // note: not the sampled point
 			}
@@ -279,19 +362,19 @@ UPCGBasePointData* UPCGIntersectionData::CreateAndFilterPointData(FPCGContext* C
 				const int32 WriteIndex = TargetWriteIndex + NumWritten;
 				const int32 ReadIndex = SourceReadIndex + KeptIndex;
 
-				FPCGPoint& PointFromY = PointsFromY[KeptIndex];
+				const int64 MetadataEntryFromY = PointsFromY.MetadataEntries[KeptIndex];
 
 				TargetRanges.SetFromValueRanges(WriteIndex, SourceRanges, ReadIndex);
 
-				TargetRanges.DensityRange[WriteIndex] = PCGIntersectionDataMaths::ComputeDensity(SourceRanges.DensityRange[ReadIndex], PointFromY.Density, DensityFunction);
-				TargetRanges.ColorRange[WriteIndex] = SourceRanges.ColorRange[ReadIndex] * PointFromY.Color;
+				TargetRanges.DensityRange[WriteIndex] = PCGIntersectionDataMaths::ComputeDensity(SourceRanges.DensityRange[ReadIndex], PointsFromY.Densities[KeptIndex], DensityFunction);
+				TargetRanges.ColorRange[WriteIndex] = SourceRanges.ColorRange[ReadIndex] * PointsFromY.Colors[KeptIndex];
 				
 				// TODO: create an array-based MergePointsAttributeSubset..
 				// If either the point from Y has metadata or the merge would be a non-trivial value, then perform the full merge
 				UPCGMetadata* TargetMetadata = TargetPointData->MutableMetadata();
-				if (TargetMetadata && (bPointDataHasCommonAttributes || PointFromY.MetadataEntry != PCGInvalidEntryKey))
+				if (TargetMetadata && (bPointDataHasCommonAttributes || MetadataEntryFromY != PCGInvalidEntryKey))
 				{
-					TargetMetadata->MergeAttributesSubset(SourceRanges.MetadataEntryRange[ReadIndex], SourceMetadata, SourceMetadata, PointFromY.MetadataEntry, TempYMetadata, TempYMetadata, TargetRanges.MetadataEntryRange[WriteIndex], EPCGMetadataOp::Min);
+					TargetMetadata->MergeAttributesSubset(SourceRanges.MetadataEntryRange[ReadIndex], SourceMetadata, SourceMetadata, MetadataEntryFromY, TempYMetadata, TempYMetadata, TargetRanges.MetadataEntryRange[WriteIndex], EPCGMetadataOp::Min);
 				}
 
 				++NumWritten;
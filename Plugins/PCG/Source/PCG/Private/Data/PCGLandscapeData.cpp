@@ -14,6 +14,7 @@
 #include "Helpers/PCGWorldQueryHelpers.h"
 #include "Utils/PCGLogErrors.h"
 
+#include "Async/ParallelFor.h"
 #include "ChaosInterfaceWrapperCore.h"
 #include "Landscape.h"
 #include "LandscapeInfo.h"
@@ -201,19 +202,65 @@ bool UPCGLandscapeData::SamplePoint(const FTransform& InTransform, const FBox& I
 
 void UPCGLandscapeData::SamplePoints(const TArrayView<const TPair<FTransform, FBox>>& Samples, const TArrayView<FPCGPoint>& OutPoints, UPCGMetadata* OutMetadata) const
 {
+	TBitArray<> KeptSamples;
+	FindOverlappingSamples(Samples.Num(), [&Samples](int32 Index) { return Samples[Index].Key; }, [&Samples](int32 Index) { return Samples[Index].Value; }, KeptSamples);
+
+	// Finally, write back the data to the OutPoints
+	for (int SampleIndex = 0; SampleIndex < Samples.Num(); ++SampleIndex)
+	{
+		FPCGPoint& OutPoint = OutPoints[SampleIndex];
+		if (KeptSamples[SampleIndex])
+		{
+			new(&OutPoint) FPCGPoint(Samples[SampleIndex].Key, /*Density=*/1.0f, /*Seed=*/0);
+			OutPoint.SetLocalBounds(Samples[SampleIndex].Value);
+		}
+		else
+		{
+			OutPoint.Density = 0;
+		}
+	}
+}
+
+void UPCGLandscapeData::SamplePointsRange(const FPCGSampleQueryRanges& InQueries, FPCGPointValueRanges& OutRanges, int32 OutStartIndex, UPCGMetadata* OutMetadata) const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UPCGLandscapeData::SamplePointsRange);
+
+	TBitArray<> KeptSamples;
+	FindOverlappingSamples(InQueries.Num, [&InQueries](int32 Index) { return InQueries.GetTransform(Index); }, [&InQueries](int32 Index) { return InQueries.GetLocalBounds(Index); }, KeptSamples);
+
+	for (int32 SampleIndex = 0; SampleIndex < InQueries.Num; ++SampleIndex)
+	{
+		if (KeptSamples[SampleIndex])
+		{
+			FPCGSpatialDataProcessing::WriteSampledPoint(OutRanges, OutStartIndex + SampleIndex, InQueries.GetTransform(SampleIndex), InQueries.GetLocalBounds(SampleIndex), /*Density=*/1.0f);
+		}
+		else
+		{
+			FPCGSpatialDataProcessing::WriteRejectedSample(OutRanges, OutStartIndex + SampleIndex);
+		}
+	}
+}
+
+void UPCGLandscapeData::FindOverlappingSamples(int32 InNumSamples, TFunctionRef<FTransform(int32)> InGetTransform, TFunctionRef<FBox(int32)> InGetBounds, TBitArray<>& OutKeptSamples) const
+{
+	OutKeptSamples.Init(false, InNumSamples);
+
 	// Implementation note:
 	// We will first build a list of all relevant landscsape collision components and the samples to test against them
 	constexpr int32 ChunkSize = FPCGSpatialDataProcessing::DefaultSamplePointsChunkSize;
 	TMap<ULandscapeHeightfieldCollisionComponent*, TArray<int, TInlineAllocator<ChunkSize>>> LandscapeCollisionComponentsToSamples;
 	TMap<const ULandscapeInfo*, FTransform> LandscapeTransformsMap;
 
-	for (int SampleIndex = 0; SampleIndex < Samples.Num(); ++SampleIndex)
-	{
-		const TPair<FTransform, FBox>& Sample = Samples[SampleIndex];
-		const ULandscapeInfo* LandscapeInfo = GetLandscapeInfo(Sample.Key.GetLocation());
+	TArray<FTransform, TInlineAllocator<ChunkSize>> SampleTransforms;
+	TArray<FBox, TInlineAllocator<ChunkSize>> SampleBounds;
+	SampleTransforms.Reserve(InNumSamples);
+	SampleBounds.Reserve(InNumSamples);
 
-		// Implementation note: we reset the density here to simplify the early return cases + the points that wouldn't be kept at the end of the process
-		OutPoints[SampleIndex].Density = 0;
+	for (int SampleIndex = 0; SampleIndex < InNumSamples; ++SampleIndex)
+	{
+		const FTransform& SampleTransform = SampleTransforms.Add_GetRef(InGetTransform(SampleIndex));
+		const FBox& SampleBox = SampleBounds.Add_GetRef(InGetBounds(SampleIndex));
+		const ULandscapeInfo* LandscapeInfo = GetLandscapeInfo(SampleTransform.GetLocation());
 
 		if (!LandscapeInfo || !LandscapeInfo->GetLandscapeProxy())
 		{
@@ -228,8 +275,8 @@ void UPCGLandscapeData::SamplePoints(const TArrayView<const TPair<FTransform, FB
 		const FTransform& LandscapeTransform = LandscapeTransformsMap[LandscapeInfo];
 
 		// Transform Box in local space -> box in world space -> box in landscape space
-		const FTransform BoundsTransformInLanscapeSpace = Sample.Key.GetRelativeTransform(LandscapeTransform);
-		FBox BoundsInLanscapeSpace = Sample.Value.TransformBy(BoundsTransformInLanscapeSpace);
+		const FTransform BoundsTransformInLanscapeSpace = SampleTransform.GetRelativeTransform(LandscapeTransform);
+		FBox BoundsInLanscapeSpace = SampleBox.TransformBy(BoundsTransformInLanscapeSpace);
 
 		// The landscape is transformed so that its coordinates are [0, ComponentSizeQuads], so we'll compute our min/max bounds here in landscape local space down below
 		// Gather all landscape heightfield components we need to test
@@ -257,14 +304,13 @@ void UPCGLandscapeData::SamplePoints(const TArrayView<const TPair<FTransform, FB
 
 	TArray<FCollisionShape, TInlineAllocator<ChunkSize>> CollisionShapes;
 	TArray<FPhysicsShapeAdapter_Chaos, TInlineAllocator<ChunkSize>> CollisionShapeAdapters;
-	TBitArray<TInlineAllocator<ChunkSize>> KeptSamples(false, Samples.Num());
-	CollisionShapes.Reserve(Samples.Num());
+	CollisionShapes.Reserve(InNumSamples);
 
-	for (const TPair<FTransform, FBox>& Sample : Samples)
+	for (int SampleIndex = 0; SampleIndex < InNumSamples; ++SampleIndex)
 	{
 		FCollisionShape& CollisionShape = CollisionShapes.Emplace_GetRef();
-		CollisionShape.SetBox(FVector3f(Sample.Value.GetExtent() * Sample.Key.GetScale3D()));
-		CollisionShapeAdapters.Emplace(Sample.Key.GetRotation(), CollisionShape);
+		CollisionShape.SetBox(FVector3f(SampleBounds[SampleIndex].GetExtent() * SampleTransforms[SampleIndex].GetScale3D()));
+		CollisionShapeAdapters.Emplace(SampleTransforms[SampleIndex].GetRotation(), CollisionShape);
 	}
 
 	// For each landscape collision component, lock, test all points, repeat.
@@ -289,36 +335,25 @@ void UPCGLandscapeData::SamplePoints(const TArrayView<const TPair<FTransform, FB
 
 		for (int ShapeIndex : SampleIndices)
 		{
-			if (KeptSamples[ShapeIndex])
+			if (OutKeptSamples[ShapeIndex])
 			{
 				continue;
 			}
 
 			const FPhysicsGeometry& Geometry = CollisionShapeAdapters[ShapeIndex].GetGeometry();
-			const FTransform& SampleTransform = Samples[ShapeIndex].Key;
+			const FTransform& SampleTransform = SampleTransforms[ShapeIndex];
 
 			if (CollisionInterface.ShapeOverlap(Objects, Geometry, { SampleTransform.GetRotation(), SampleTransform.GetLocation() }, OverlapHits))
 			{
 				if (!OverlapHits.IsEmpty())
 				{
-					KeptSamples[ShapeIndex] = true;
+					OutKeptSamples[ShapeIndex] = true;
 				}
 
 				OverlapHits.Reset();
 			}
 		}
 	}
-
-	// Finally, write back the data to the OutPoints
-	for (int SampleIndex = 0; SampleIndex < Samples.Num(); ++SampleIndex)
-	{
-		FPCGPoint& OutPoint = OutPoints[SampleIndex];
-		if (KeptSamples[SampleIndex])
-		{
-			new(&OutPoint) FPCGPoint(Samples[SampleIndex].Key, /*Density=*/1.0f, /*Seed=*/0);
-			OutPoint.SetLocalBounds(Samples[SampleIndex].Value);
-		}
-	}
 }
 
 bool UPCGLandscapeData::ProjectPoint(const FTransform& InTransform, const FBox& InBounds, const FPCGProjectionParams& InParams, FPCGPoint& OutPoint, UPCGMetadata* OutMetadata) const
@@ -349,6 +384,84 @@ bool UPCGLandscapeData::ProjectPoint(const FTransform& InTransform, const FBox&
 	}
 
 	const FVector2D ComponentLocalPoint(LocalPoint.X - ComponentMapKey.X * LandscapeInfo->ComponentSizeQuads, LocalPoint.Y - ComponentMapKey.Y * LandscapeInfo->ComponentSizeQuads);
+	ULandscapeHeightfieldCollisionComponent* LandscapeCollisionComponent = LandscapeInfo->XYtoCollisionComponentMap.FindRef(ComponentMapKey);
+
+	ProjectPointOnComponent(InTransform, InParams, LandscapeCacheEntry, LandscapeCollisionComponent, ComponentMapKey, ComponentLocalPoint, OutPoint, OutMetadata);
+	return true;
+}
+
+void UPCGLandscapeData::ProjectPointsRange(const FPCGSampleQueryRanges& InQueries, const FPCGProjectionParams& InParams, FPCGPointValueRanges& OutRanges, int32 OutStartIndex, UPCGMetadata* OutMetadata) const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UPCGLandscapeData::ProjectPointsRange);
+
+	if (!LandscapeCache)
+	{
+		for (int32 Index = 0; Index < InQueries.Num; ++Index)
+		{
+			FPCGSpatialDataProcessing::WriteRejectedSample(OutRanges, OutStartIndex + Index);
+		}
+
+		return;
+	}
+
+	// Same as ProjectPoint, but the landscape transform and the component lookups are only resolved when they change.
+	// Consecutive queries mostly fall on the same landscape component.
+	const ULandscapeInfo* LastLandscapeInfo = nullptr;
+	FTransform LandscapeTransform = FTransform::Identity;
+
+	bool bHasLastComponent = false;
+	FIntPoint LastComponentMapKey = FIntPoint::ZeroValue;
+	const FPCGLandscapeCacheEntry* LandscapeCacheEntry = nullptr;
+	ULandscapeHeightfieldCollisionComponent* LandscapeCollisionComponent = nullptr;
+
+	for (int32 Index = 0; Index < InQueries.Num; ++Index)
+	{
+		const FTransform& InTransform = InQueries.GetTransform(Index);
+		const int32 OutIndex = OutStartIndex + Index;
+
+		const ULandscapeInfo* LandscapeInfo = GetLandscapeInfo(InTransform.GetLocation());
+		ALandscapeProxy* LandscapeProxy = LandscapeInfo ? LandscapeInfo->GetLandscapeProxy() : nullptr;
+		if (!LandscapeProxy)
+		{
+			FPCGSpatialDataProcessing::WriteRejectedSample(OutRanges, OutIndex);
+			continue;
+		}
+
+		if (LandscapeInfo != LastLandscapeInfo)
+		{
+			LastLandscapeInfo = LandscapeInfo;
+			LandscapeTransform = LandscapeProxy->LandscapeActorToWorld();
+			bHasLastComponent = false;
+		}
+
+		const FVector LocalPoint = LandscapeTransform.InverseTransformPosition(InTransform.GetLocation());
+		const FIntPoint ComponentMapKey(FMath::FloorToInt(LocalPoint.X / LandscapeInfo->ComponentSizeQuads), FMath::FloorToInt(LocalPoint.Y / LandscapeInfo->ComponentSizeQuads));
+
+		if (!bHasLastComponent || ComponentMapKey != LastComponentMapKey)
+		{
+			bHasLastComponent = true;
+			LastComponentMapKey = ComponentMapKey;
+			LandscapeCacheEntry = LandscapeCache->GetCacheEntry(LandscapeInfo, ComponentMapKey);
+			LandscapeCollisionComponent = LandscapeInfo->XYtoCollisionComponentMap.FindRef(ComponentMapKey);
+		}
+
+		if (!LandscapeCacheEntry)
+		{
+			FPCGSpatialDataProcessing::WriteRejectedSample(OutRanges, OutIndex);
+			continue;
+		}
+
+		const FVector2D ComponentLocalPoint(LocalPoint.X - ComponentMapKey.X * LandscapeInfo->ComponentSizeQuads, LocalPoint.Y - ComponentMapKey.Y * LandscapeInfo->ComponentSizeQuads);
+
+		FPCGPoint OutPoint;
+		ProjectPointOnComponent(InTransform, InParams, LandscapeCacheEntry, LandscapeCollisionComponent, ComponentMapKey, ComponentLocalPoint, OutPoint, OutMetadata);
+		OutRanges.SetFromPoint(OutIndex, OutPoint);
+	}
+}
+
+void UPCGLandscapeData::ProjectPointOnComponent(const FTransform& InTransform, const FPCGProjectionParams& InParams, const FPCGLandscapeCacheEntry* LandscapeCacheEntry, ULandscapeHeightfieldCollisionComponent* LandscapeCollisionComponent, const FIntPoint& ComponentMapKey, const FVector2D& ComponentLocalPoint, FPCGPoint& OutPoint, UPCGMetadata* OutMetadata) const
+{
+	check(LandscapeCacheEntry);
 
 	if (DataProps.bGetHeightOnly)
 	{
@@ -359,8 +472,6 @@ bool UPCGLandscapeData::ProjectPoint(const FTransform& InTransform, const FBox&
 		LandscapeCacheEntry->GetInterpolatedPoint(ComponentLocalPoint, OutPoint, DataProps.bGetLayerWeights ? OutMetadata : nullptr);
 	}
 
-	ULandscapeHeightfieldCollisionComponent* LandscapeCollisionComponent = LandscapeInfo->XYtoCollisionComponentMap.FindRef(ComponentMapKey);
-
 	if (DataProps.bGetActorReference && OutMetadata && LandscapeCollisionComponent)
 	{
 		if (FPCGMetadataAttribute<FSoftObjectPath>* ActorReferenceAttribute = OutMetadata->FindOrCreateAttribute<FSoftObjectPath>(PCGPointDataConstants::ActorReferenceAttribute))
@@ -420,6 +531,267 @@ bool UPCGLandscapeData::ProjectPoint(const FTransform& InTransform, const FBox&
 	{
 		OutPoint.Transform.SetScale3D(InTransform.GetScale3D());
 	}
+}
+
+bool UPCGLandscapeData::SampleGrid(const FPCGLandscapeGridSamplingParams& InParams, FPCGLandscapeGridSamples& OutSamples) const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UPCGLandscapeData::SampleGrid);
+
+	if (!LandscapeCache || LandscapeInfos.IsEmpty() || InParams.GridX < 1 || InParams.GridY < 1)
+	{
+		return false;
+	}
+
+	const int32 GridX = InParams.GridX;
+	const int32 NumSamples = InParams.GridX * InParams.GridY;
+
+	OutSamples.Heights.SetNumZeroed(NumSamples);
+	OutSamples.Hits.SetNumZeroed(NumSamples);
+
+	OutSamples.Normals.Reset();
+	if (InParams.bSampleNormals)
+	{
+		OutSamples.Normals.Init(FVector::UpVector, NumSamples);
+	}
+
+	// Layer weights follow the same rules as the metadata path: they are only retrieved if the data asks for them and the layer is known to the cache.
+	OutSamples.bHasLayer = HasLayerWeight(InParams.LayerName);
+
+	OutSamples.LayerWeights.Reset();
+	if (OutSamples.bHasLayer)
+	{
+		OutSamples.LayerWeights.SetNumZeroed(NumSamples);
+	}
+
+	// Resolve the landscape transforms once, instead of once per sample.
+	struct FLandscapeSamplingInfo
+	{
+		const ULandscapeInfo* LandscapeInfo = nullptr;
+		FTransform LandscapeTransform = FTransform::Identity;
+		int32 ComponentSizeQuads = 0;
+	};
+
+	TArray<FLandscapeSamplingInfo, TInlineAllocator<4>> SamplingInfos;
+	SamplingInfos.SetNum(LandscapeInfos.Num());
+
+	for (int32 LandscapeIndex = 0; LandscapeIndex < LandscapeInfos.Num(); ++LandscapeIndex)
+	{
+		const ULandscapeInfo* LandscapeInfo = LandscapeInfos[LandscapeIndex];
+		ALandscapeProxy* LandscapeProxy = LandscapeInfo ? LandscapeInfo->GetLandscapeProxy() : nullptr;
+		if (LandscapeProxy && LandscapeInfo->ComponentSizeQuads > 0)
+		{
+			SamplingInfos[LandscapeIndex].LandscapeInfo = LandscapeInfo;
+			SamplingInfos[LandscapeIndex].LandscapeTransform = LandscapeProxy->LandscapeActorToWorld();
+			SamplingInfos[LandscapeIndex].ComponentSizeQuads = LandscapeInfo->ComponentSizeQuads;
+		}
+	}
+
+	// 1. Find the landscape and the landscape-space position of every vertex, one row per task.
+	TArray<int32> SampleLandscapeIndices;
+	TArray<FVector2D> SampleLocalPoints;
+	SampleLandscapeIndices.SetNumUninitialized(NumSamples);
+	SampleLocalPoints.SetNumUninitialized(NumSamples);
+
+	ParallelFor(InParams.GridY, [this, &InParams, &SamplingInfos, &SampleLandscapeIndices, &SampleLocalPoints, GridX](int32 Y)
+	{
+		for (int32 X = 0; X < GridX; ++X)
+		{
+			const int32 SampleIndex = X + Y * GridX;
+			const FVector WorldPosition(InParams.GridMin.X + (double)X * InParams.CellSize, InParams.GridMin.Y + (double)Y * InParams.CellSize, 0.0);
+
+			const ULandscapeInfo* LandscapeInfo = GetLandscapeInfo(WorldPosition);
+			const int32 LandscapeIndex = LandscapeInfo ? LandscapeInfos.IndexOfByKey(LandscapeInfo) : INDEX_NONE;
+
+			if (LandscapeIndex == INDEX_NONE || !SamplingInfos[LandscapeIndex].LandscapeInfo)
+			{
+				SampleLandscapeIndices[SampleIndex] = INDEX_NONE;
+				continue;
+			}
+
+			const FVector LocalPoint = SamplingInfos[LandscapeIndex].LandscapeTransform.InverseTransformPosition(WorldPosition);
+			SampleLandscapeIndices[SampleIndex] = LandscapeIndex;
+			SampleLocalPoints[SampleIndex] = FVector2D(LocalPoint.X, LocalPoint.Y);
+		}
+	});
+
+	// 2. Group the vertices by landscape component. Consecutive vertices of a row mostly share a component, so only look up the map on changes.
+	struct FComponentGroup
+	{
+		int32 LandscapeIndex = INDEX_NONE;
+		FIntPoint ComponentKey = FIntPoint::ZeroValue;
+		const FPCGLandscapeCacheEntry* CacheEntry = nullptr;
+		int32 FirstSample = 0;
+		int32 NumSamples = 0;
+	};
+
+	TArray<FComponentGroup> Groups;
+	TMap<TPair<int32, FIntPoint>, int32> GroupLookup;
+	TArray<int32> SampleGroups;
+	SampleGroups.SetNumUninitialized(NumSamples);
+
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(UPCGLandscapeData::SampleGrid::GroupByComponent);
+
+		TPair<int32, FIntPoint> LastKey(INDEX_NONE, FIntPoint::ZeroValue);
+		int32 LastGroupIndex = INDEX_NONE;
+
+		for (int32 SampleIndex = 0; SampleIndex < NumSamples; ++SampleIndex)
+		{
+			const int32 LandscapeIndex = SampleLandscapeIndices[SampleIndex];
+			if (LandscapeIndex == INDEX_NONE)
+			{
+				SampleGroups[SampleIndex] = INDEX_NONE;
+				continue;
+			}
+
+			const int32 ComponentSizeQuads = SamplingInfos[LandscapeIndex].ComponentSizeQuads;
+			FVector2D& LocalPoint = SampleLocalPoints[SampleIndex];
+			const FIntPoint ComponentMapKey(FMath::FloorToInt(LocalPoint.X / ComponentSizeQuads), FMath::FloorToInt(LocalPoint.Y / ComponentSizeQuads));
+
+			// Rebase in the component referential, same as ProjectPoint
+			LocalPoint = FVector2D(LocalPoint.X - ComponentMapKey.X * ComponentSizeQuads, LocalPoint.Y - ComponentMapKey.Y * ComponentSizeQuads);
+
+			const TPair<int32, FIntPoint> Key(LandscapeIndex, ComponentMapKey);
+			if (LastGroupIndex == INDEX_NONE || Key != LastKey)
+			{
+				LastGroupIndex = GroupLookup.FindOrAdd(Key, Groups.Num());
+				LastKey = Key;
+
+				if (LastGroupIndex == Groups.Num())
+				{
+					FComponentGroup& NewGroup = Groups.Emplace_GetRef();
+					NewGroup.LandscapeIndex = LandscapeIndex;
+					NewGroup.ComponentKey = ComponentMapKey;
+				}
+			}
+
+			SampleGroups[SampleIndex] = LastGroupIndex;
+			++Groups[LastGroupIndex].NumSamples;
+		}
+	}
+
+	if (Groups.IsEmpty())
+	{
+		return true;
+	}
+
+	// Bucket the samples per group, keeping them in grid order inside each group.
+	TArray<int32> GroupedSamples;
+	{
+		int32 Offset = 0;
+		for (FComponentGroup& Group : Groups)
+		{
+			Group.FirstSample = Offset;
+			Offset += Group.NumSamples;
+		}
+
+		GroupedSamples.SetNumUninitialized(Offset);
+
+		TArray<int32> WriteOffsets;
+		WriteOffsets.Reserve(Groups.Num());
+		for (const FComponentGroup& Group : Groups)
+		{
+			WriteOffsets.Add(Group.FirstSample);
+		}
+
+		for (int32 SampleIndex = 0; SampleIndex < NumSamples; ++SampleIndex)
+		{
+			if (SampleGroups[SampleIndex] != INDEX_NONE)
+			{
+				GroupedSamples[WriteOffsets[SampleGroups[SampleIndex]]++] = SampleIndex;
+			}
+		}
+	}
+
+	// 3. Resolve the cache entries on the calling thread, since creating entries is not allowed from workers in editor.
+	for (FComponentGroup& Group : Groups)
+	{
+		Group.CacheEntry = LandscapeCache->GetCacheEntry(SamplingInfos[Group.LandscapeIndex].LandscapeInfo, Group.ComponentKey);
+	}
+
+	// 4. Read heights, normals and layer weights straight from the cache, one component per task.
+	const bool bSampleNormals = InParams.bSampleNormals;
+	const bool bSampleLayer = OutSamples.bHasLayer;
+	const FName LayerName = InParams.LayerName;
+
+	ParallelFor(Groups.Num(), [&Groups, &GroupedSamples, &SampleLocalPoints, &OutSamples, bSampleNormals, bSampleLayer, LayerName](int32 GroupIndex)
+	{
+		const FComponentGroup& Group = Groups[GroupIndex];
+		if (!Group.CacheEntry)
+		{
+			return;
+		}
+
+		const TConstArrayView<int32> GroupSamples(GroupedSamples.GetData() + Group.FirstSample, Group.NumSamples);
+
+		for (const int32 SampleIndex : GroupSamples)
+		{
+			FVector Position;
+			Group.CacheEntry->GetInterpolatedPositionAndNormal(SampleLocalPoints[SampleIndex], Position, bSampleNormals ? &OutSamples.Normals[SampleIndex] : nullptr);
+
+			OutSamples.Heights[SampleIndex] = Position.Z;
+			OutSamples.Hits[SampleIndex] = true;
+		}
+
+		if (bSampleLayer)
+		{
+			// Gather the component-local points contiguously so the whole group reads the single layer in one call, then scatter back in grid order.
+			// Layers that are not painted on this component have a zero weight, like the default value of the layer attribute.
+			TArray<FVector2D> GroupLocalPoints;
+			TArray<float> GroupWeights;
+			GroupLocalPoints.SetNumUninitialized(GroupSamples.Num());
+			GroupWeights.SetNumUninitialized(GroupSamples.Num());
+
+			for (int32 Index = 0; Index < GroupSamples.Num(); ++Index)
+			{
+				GroupLocalPoints[Index] = SampleLocalPoints[GroupSamples[Index]];
+			}
+
+			Group.CacheEntry->GetInterpolatedLayerWeight(GroupLocalPoints, Group.CacheEntry->GetLayerIndex(LayerName), GroupWeights);
+
+			for (int32 Index = 0; Index < GroupSamples.Num(); ++Index)
+			{
+				OutSamples.LayerWeights[GroupSamples[Index]] = GroupWeights[Index];
+			}
+		}
+	});
+
+	return true;
+}
+
+bool UPCGLandscapeData::HasLayerWeight(FName InLayerName) const
+{
+	return LandscapeCache && DataProps.bGetLayerWeights && !InLayerName.IsNone() && LandscapeCache->GetLayerNames(nullptr).Contains(InLayerName);
+}
+
+bool UPCGLandscapeData::SampleLayerWeight(const FVector& InPosition, FName InLayerName, float& OutWeight) const
+{
+	OutWeight = 0.0f;
+
+	if (!LandscapeCache)
+	{
+		return false;
+	}
+
+	const ULandscapeInfo* LandscapeInfo = GetLandscapeInfo(InPosition);
+	ALandscapeProxy* LandscapeProxy = LandscapeInfo ? LandscapeInfo->GetLandscapeProxy() : nullptr;
+	if (!LandscapeProxy)
+	{
+		return false;
+	}
+
+	// Same component lookup as ProjectPoint.
+	const FVector LocalPoint = LandscapeProxy->LandscapeActorToWorld().InverseTransformPosition(InPosition);
+	const FIntPoint ComponentMapKey(FMath::FloorToInt(LocalPoint.X / LandscapeInfo->ComponentSizeQuads), FMath::FloorToInt(LocalPoint.Y / LandscapeInfo->ComponentSizeQuads));
+
+	const FPCGLandscapeCacheEntry* LandscapeCacheEntry = LandscapeCache->GetCacheEntry(LandscapeInfo, ComponentMapKey);
+	if (!LandscapeCacheEntry)
+	{
+		return false;
+	}
+
+	const FVector2D ComponentLocalPoint(LocalPoint.X - ComponentMapKey.X * LandscapeInfo->ComponentSizeQuads, LocalPoint.Y - ComponentMapKey.Y * LandscapeInfo->ComponentSizeQuads);
+	OutWeight = LandscapeCacheEntry->GetInterpolatedLayerWeight(ComponentLocalPoint, LandscapeCacheEntry->GetLayerIndex(InLayerName));
 
 	return true;
 }
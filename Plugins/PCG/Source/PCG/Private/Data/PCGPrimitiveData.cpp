@@ -6,6 +6,7 @@
 #include "Data/PCGPointArrayData.h"
 #include "Data/PCGPointData.h"
 #include "Data/PCGSpatialData.h"
+#include "Data/PCGSpatialDataTpl.h"
 #include "Elements/PCGVolumeSampler.h"
 #include "Components/PrimitiveComponent.h"
 
@@ -49,6 +50,39 @@ bool UPCGPrimitiveData::SamplePoint(const FTransform& InTransform, const FBox& I
 	}
 }
 
+void UPCGPrimitiveData::SamplePointsRange(const FPCGSampleQueryRanges& InQueries, FPCGPointValueRanges& OutRanges, int32 OutStartIndex, UPCGMetadata* OutMetadata) const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UPCGPrimitiveData::SamplePointsRange);
+
+	const UPrimitiveComponent* PrimitiveComponent = Primitive.Get();
+	const bool bIsPrimitiveValid = ensure(IsValid(PrimitiveComponent));
+
+	FCollisionShape CollisionShape;
+	for (int32 Index = 0; Index < InQueries.Num; ++Index)
+	{
+		const FTransform& QueryTransform = InQueries.GetTransform(Index);
+		const FBox LocalBounds = InQueries.GetLocalBounds(Index);
+
+		CollisionShape.SetBox(FVector3f(LocalBounds.GetExtent() * QueryTransform.GetScale3D()));
+		const FVector BoxCenter = QueryTransform.TransformPosition(LocalBounds.GetCenter());
+
+		if (bIsPrimitiveValid && PrimitiveComponent->OverlapComponent(BoxCenter, QueryTransform.GetRotation(), CollisionShape))
+		{
+			FPCGSpatialDataProcessing::WriteSampledPoint(OutRanges, OutStartIndex + Index, QueryTransform, LocalBounds, /*Density=*/1.0f);
+		}
+		else
+		{
+			FPCGSpatialDataProcessing::WriteRejectedSample(OutRanges, OutStartIndex + Index);
+		}
+	}
+}
+
+void UPCGPrimitiveData::ProjectPointsRange(const FPCGSampleQueryRanges& InQueries, const FPCGProjectionParams& InParams, FPCGPointValueRanges& OutRanges, int32 OutStartIndex, UPCGMetadata* OutMetadata) const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UPCGPrimitiveData::ProjectPointsRange);
+	ProjectPointsRangeFromSamples(InQueries, InParams, OutRanges, OutStartIndex, OutMetadata);
+}
+
 const UPCGPointData* UPCGPrimitiveData::CreatePointData(FPCGContext* Context) const
 {
 	TRACE_CPUPROFILER_EVENT_SCOPE(UPCGPrimitiveData::CreatePointData);
@@ -8,6 +8,7 @@
 #include "Data/PCGPointData.h"
 #include "Data/PCGSplineData.h"
 #include "Data/PCGSpatialData.h"
+#include "Data/PCGSpatialDataTpl.h"
 #include "Elements/PCGProjectionParams.h"
 #include "Helpers/PCGAsync.h"
 #include "Metadata/PCGMetadataAccessor.h"
@@ -205,6 +206,86 @@ bool UPCGProjectionData::SamplePoint(const FTransform& InTransform, const FBox&
 	return true;
 }
 
+void UPCGProjectionData::SamplePointsRange(const FPCGSampleQueryRanges& InQueries, FPCGPointValueRanges& OutRanges, int32 OutStartIndex, UPCGMetadata* OutMetadata) const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UPCGProjectionData::SamplePointsRange);
+
+	// See SamplePoint
+	if (RequiresCollapseToSample())
+	{
+		ToBasePointData(nullptr)->SamplePointsRange(InQueries, OutRanges, OutStartIndex, OutMetadata);
+		return;
+	}
+
+	using FSampledPointsBuffer = FPCGSpatialDataProcessing::FSampledPointsBuffer;
+
+	const int32 NumQueries = InQueries.Num;
+	FSampledPointsBuffer PointsFromSource(NumQueries);
+	{
+		FPCGPointValueRanges PointsFromSourceRanges = PointsFromSource.GetValueRanges();
+		Source->SamplePointsRange(InQueries, PointsFromSourceRanges, /*OutStartIndex=*/0, OutMetadata);
+	}
+
+	// The target is only sampled where the source was hit, at the sampled source points.
+	TArray<int32> HitIndices;
+	FSampledPointsBuffer QueriesForTarget(0, EPCGPointNativeProperties::None);
+	for (int32 Index = 0; Index < NumQueries; ++Index)
+	{
+		if (PointsFromSource.Densities[Index] > 0)
+		{
+			HitIndices.Add(Index);
+			QueriesForTarget.AddQuery(PointsFromSource.Transforms[Index], PointsFromSource.BoundsMins[Index], PointsFromSource.BoundsMaxs[Index]);
+		}
+		else
+		{
+			FPCGSpatialDataProcessing::WriteRejectedSample(OutRanges, OutStartIndex + Index);
+		}
+	}
+
+	if (HitIndices.IsEmpty())
+	{
+		return;
+	}
+
+	FSampledPointsBuffer PointsFromTarget(HitIndices.Num());
+	{
+		FPCGPointValueRanges PointsFromTargetRanges = PointsFromTarget.GetValueRanges();
+		Target->SamplePointsRange(QueriesForTarget.GetQueries(), PointsFromTargetRanges, /*OutStartIndex=*/0, OutMetadata);
+	}
+
+	for (int32 HitIndex = 0; HitIndex < HitIndices.Num(); ++HitIndex)
+	{
+		const int32 Index = HitIndices[HitIndex];
+		const int32 OutIndex = OutStartIndex + Index;
+
+		if (PointsFromTarget.Densities[HitIndex] <= 0)
+		{
+			FPCGSpatialDataProcessing::WriteRejectedSample(OutRanges, OutIndex);
+			continue;
+		}
+
+		// Merge points into a single point, with the same logic as SamplePoint
+		const FPCGPoint PointFromSource = PointsFromSource.GetPoint(Index);
+		const FPCGPoint PointFromTarget = PointsFromTarget.GetPoint(HitIndex);
+		FPCGPoint OutPoint = PointFromSource;
+
+		ApplyProjectionResult(PointFromTarget, OutPoint);
+
+		if (OutMetadata && PointFromTarget.MetadataEntry != PCGInvalidEntryKey)
+		{
+			OutMetadata->MergePointAttributesSubset(PointFromSource, OutMetadata, Source->Metadata, PointFromTarget, OutMetadata, Target->Metadata, OutPoint, ProjectionParams.AttributeMergeOperation);
+		}
+
+		OutRanges.SetFromPoint(OutIndex, OutPoint);
+	}
+}
+
+void UPCGProjectionData::ProjectPointsRange(const FPCGSampleQueryRanges& InQueries, const FPCGProjectionParams& InParams, FPCGPointValueRanges& OutRanges, int32 OutStartIndex, UPCGMetadata* OutMetadata) const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UPCGProjectionData::ProjectPointsRange);
+	ProjectPointsRangeFromSamples(InQueries, InParams, OutRanges, OutStartIndex, OutMetadata);
+}
+
 bool UPCGProjectionData::HasNonTrivialTransform() const
 {
 	return Target->HasNonTrivialTransform();
@@ -15,7 +15,7 @@ void UPCGRenderTargetData::Initialize(UTextureRenderTarget2D* InRenderTarget, co
 	bSkipReadbackToCPU = bInSkipReadbackToCPU;
 	bOwnsRenderTarget = bInTakeOwnershipOfRenderTarget;
 
-	ColorData.Reset();
+	ResetCPUTexels();
 
 	if (RenderTarget)
 	{
@@ -33,6 +33,7 @@ void UPCGRenderTargetData::Initialize(UTextureRenderTarget2D* InRenderTarget, co
 					const FIntRect Rect = FIntRect(0, 0, RenderTarget->SizeX, RenderTarget->SizeY);
 					const FReadSurfaceDataFlags ReadPixelFlags(RCM_MinMax);
 					RTResource->ReadLinearColorPixels(ColorData, ReadPixelFlags, Rect);
+					FinalizeCPUTexels();
 				}
 			}
 		}
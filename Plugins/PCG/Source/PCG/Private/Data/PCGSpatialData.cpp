@@ -8,6 +8,7 @@
 #include "Data/PCGPointData.h"
 #include "Data/PCGPointArrayData.h"
 #include "Data/PCGProjectionData.h"
+#include "Data/PCGSpatialDataTpl.h"
 #include "Data/PCGUnionData.h"
 #include "Elements/PCGExecuteBlueprint.h"
 
@@ -34,6 +35,16 @@ FPCGInitializeFromDataParams::FPCGInitializeFromDataParams(const UPCGSpatialData
 {
 }
 
+FPCGSampleQueryRanges::FPCGSampleQueryRanges(const UPCGBasePointData* InPointData, int32 InStartIndex, int32 InNum)
+	: TransformRange(InPointData->GetConstTransformValueRange())
+	, BoundsMinRange(InPointData->GetConstBoundsMinValueRange())
+	, BoundsMaxRange(InPointData->GetConstBoundsMaxValueRange())
+	, StartIndex(InStartIndex)
+	, Num(InNum)
+{
+	check(InStartIndex >= 0 && InStartIndex + InNum <= InPointData->GetNumPoints());
+}
+
 UPCGSpatialData::UPCGSpatialData(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
@@ -209,6 +220,21 @@ void UPCGSpatialData::SamplePoints(const TArrayView<const TPair<FTransform, FBox
 	}
 }
 
+void UPCGSpatialData::SamplePointsRange(const FPCGSampleQueryRanges& InQueries, FPCGPointValueRanges& OutRanges, int32 OutStartIndex, UPCGMetadata* OutMetadata) const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UPCGSpatialData::SamplePointsRange);
+	for (int32 Index = 0; Index < InQueries.Num; ++Index)
+	{
+		FPCGPoint OutPoint;
+		if (!SamplePoint(InQueries.GetTransform(Index), InQueries.GetLocalBounds(Index), OutPoint, OutMetadata))
+		{
+			OutPoint.Density = 0;
+		}
+
+		OutRanges.SetFromPoint(OutStartIndex + Index, OutPoint);
+	}
+}
+
 bool UPCGSpatialData::ProjectPoint(const FTransform& InTransform, const FBox& InBounds, const FPCGProjectionParams& InParams, FPCGPoint& OutPoint, UPCGMetadata* OutMetadata) const
 {
 	// Fallback implementation - calls SamplePoint because SamplePoint was being used for projection previously.
@@ -253,6 +279,27 @@ void UPCGSpatialData::ProjectPoints(const TArrayView<const TPair<FTransform, FBo
 	}
 }
 
+void UPCGSpatialData::ProjectPointsRange(const FPCGSampleQueryRanges& InQueries, const FPCGProjectionParams& InParams, FPCGPointValueRanges& OutRanges, int32 OutStartIndex, UPCGMetadata* OutMetadata) const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UPCGSpatialData::ProjectPointsRange);
+	for (int32 Index = 0; Index < InQueries.Num; ++Index)
+	{
+		FPCGPoint OutPoint;
+		if (!ProjectPoint(InQueries.GetTransform(Index), InQueries.GetLocalBounds(Index), InParams, OutPoint, OutMetadata))
+		{
+			OutPoint.Density = 0;
+		}
+
+		OutRanges.SetFromPoint(OutStartIndex + Index, OutPoint);
+	}
+}
+
+void UPCGSpatialData::ProjectPointsRangeFromSamples(const FPCGSampleQueryRanges& InQueries, const FPCGProjectionParams& InParams, FPCGPointValueRanges& OutRanges, int32 OutStartIndex, UPCGMetadata* OutMetadata) const
+{
+	SamplePointsRange(InQueries, OutRanges, OutStartIndex, OutMetadata);
+	FPCGSpatialDataProcessing::ApplyProjectionParams(InQueries, InParams, OutRanges, OutStartIndex);
+}
+
 UPCGIntersectionData* UPCGSpatialData::K2_IntersectWith(const UPCGSpatialData* InOther) const
 {
 	return IntersectWith(UPCGBlueprintElement::ResolveContext(), InOther);
@@ -8,6 +8,7 @@
 #include "Data/PCGPolyLineData.h"
 #include "Data/PCGProjectionData.h"
 #include "Data/PCGSpatialData.h"
+#include "Data/PCGSpatialDataTpl.h"
 #include "Elements/PCGSplineSampler.h"
 #include "Helpers/PCGHelpers.h"
 #include "Metadata/Accessors/PCGSplineAccessor.h"
@@ -538,6 +539,47 @@ bool UPCGSplineData::SamplePoint(const FTransform& InTransform, const FBox& InBo
 	}
 }
 
+void UPCGSplineData::SamplePointsRange(const FPCGSampleQueryRanges& InQueries, FPCGPointValueRanges& OutRanges, int32 OutStartIndex, UPCGMetadata* OutMetadata) const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UPCGSplineData::SamplePointsRange);
+
+	// Metadata is written through a point, only when the caller reads the entries.
+	const bool bWriteMetadata = OutMetadata && !OutRanges.MetadataEntryRange.IsEmpty();
+
+	for (int32 Index = 0; Index < InQueries.Num; ++Index)
+	{
+		const FTransform& QueryTransform = InQueries.GetTransform(Index);
+		const int32 OutIndex = OutStartIndex + Index;
+
+		// Same as SamplePoint
+		const FVector InPosition = QueryTransform.GetLocation();
+		const float NearestPointKey = SplineStruct.FindInputKeyClosestToWorldLocation(InPosition);
+		const FTransform NearestTransform = SplineStruct.GetTransformAtSplineInputKey(NearestPointKey, ESplineCoordinateSpace::World, true);
+		const float Distance = NearestTransform.InverseTransformPosition(InPosition).Length();
+
+		if (Distance > 1.0f)
+		{
+			FPCGSpatialDataProcessing::WriteRejectedSample(OutRanges, OutIndex);
+			continue;
+		}
+
+		FPCGSpatialDataProcessing::WriteSampledPoint(OutRanges, OutIndex, QueryTransform, InQueries.GetLocalBounds(Index), 1.0f - Distance);
+
+		if (bWriteMetadata)
+		{
+			FPCGPoint Point;
+			WriteMetadataToPoint(NearestPointKey, Point, OutMetadata);
+			OutRanges.MetadataEntryRange[OutIndex] = Point.MetadataEntry;
+		}
+	}
+}
+
+void UPCGSplineData::ProjectPointsRange(const FPCGSampleQueryRanges& InQueries, const FPCGProjectionParams& InParams, FPCGPointValueRanges& OutRanges, int32 OutStartIndex, UPCGMetadata* OutMetadata) const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UPCGSplineData::ProjectPointsRange);
+	ProjectPointsRangeFromSamples(InQueries, InParams, OutRanges, OutStartIndex, OutMetadata);
+}
+
 UPCGSpatialData* UPCGSplineData::ProjectOn(FPCGContext* InContext, const UPCGSpatialData* InOther, const FPCGProjectionParams& InParams) const
 {
 	if (InOther->GetDimension() == 2)
@@ -6,12 +6,14 @@
 #include "PCGTextureReadback.h"
 #include "Data/PCGPointArrayData.h"
 #include "Data/PCGPointData.h"
+#include "Data/PCGSpatialDataTpl.h"
 #include "Helpers/PCGAsync.h"
 #include "Helpers/PCGHelpers.h"
 
 #include "RHIStaticStates.h"
 #include "RenderCaptureInterface.h"
 #include "TextureResource.h"
+#include "Async/ParallelFor.h"
 #include "Engine/Texture2D.h"
 #include "Engine/Texture2DArray.h"
 
@@ -25,6 +27,74 @@ namespace PCGTextureSamplingHelpers
 		GTriggerReadbackCaptureDispatches,
 		TEXT("Trigger GPU readback captures for this many of the subsequent texture data initializations."));
 
+	static TAutoConsoleVariable<bool> CVarCompactCPUStorage(
+		TEXT("pcg.TextureData.CompactCPUStorage"),
+		true,
+		TEXT("Texture data keeps its texels in CPU memory in the native layout of the source (R8, R16F, R32F, BGRA8, ...) instead of one FLinearColor per texel. Sampling results are the same."));
+
+	static TAutoConsoleVariable<bool> CVarHalfPrecisionCPUStorage(
+		TEXT("pcg.TextureData.HalfPrecisionCPUStorage"),
+		false,
+		TEXT("With compact storage, 32-bit float textures are kept as 16-bit floats in CPU memory. Halves their footprint, but sampled values are rounded to half precision."));
+
+	int32 GetBytesPerTexel(EPCGTextureCPUStorage InStorage)
+	{
+		switch (InStorage)
+		{
+		case EPCGTextureCPUStorage::BGRA8:
+			return sizeof(FColor);
+		case EPCGTextureCPUStorage::RGBA16:
+			return 4 * sizeof(uint16);
+		case EPCGTextureCPUStorage::RGBA16F:
+			return sizeof(FFloat16Color);
+		case EPCGTextureCPUStorage::R8:
+			return sizeof(uint8);
+		case EPCGTextureCPUStorage::R16F:
+			return sizeof(FFloat16);
+		case EPCGTextureCPUStorage::R32F:
+			return sizeof(float);
+		case EPCGTextureCPUStorage::RGBA32F:
+		default:
+			return sizeof(FLinearColor);
+		}
+	}
+
+	/** Writes Color at Index in texels laid out as InStorage, the inverse of DecodeTexel (integer layouts are rounded). */
+	void EncodeTexel(EPCGTextureCPUStorage InStorage, uint8* OutTexelData, int32 Index, const FLinearColor& Color)
+	{
+		switch (InStorage)
+		{
+		case EPCGTextureCPUStorage::BGRA8:
+			reinterpret_cast<FColor*>(OutTexelData)[Index] = Color.QuantizeRound();
+			break;
+		case EPCGTextureCPUStorage::RGBA16:
+		{
+			uint16* Texel = reinterpret_cast<uint16*>(OutTexelData) + 4 * Index;
+			Texel[0] = static_cast<uint16>(FMath::Clamp(FMath::RoundToInt32(Color.R), 0, MAX_uint16));
+			Texel[1] = static_cast<uint16>(FMath::Clamp(FMath::RoundToInt32(Color.G), 0, MAX_uint16));
+			Texel[2] = static_cast<uint16>(FMath::Clamp(FMath::RoundToInt32(Color.B), 0, MAX_uint16));
+			Texel[3] = static_cast<uint16>(FMath::Clamp(FMath::RoundToInt32(Color.A), 0, MAX_uint16));
+			break;
+		}
+		case EPCGTextureCPUStorage::RGBA16F:
+			reinterpret_cast<FFloat16Color*>(OutTexelData)[Index] = FFloat16Color(Color);
+			break;
+		case EPCGTextureCPUStorage::R8:
+			OutTexelData[Index] = static_cast<uint8>(FMath::Clamp(FMath::RoundToInt32(Color.R * 255.0f), 0, MAX_uint8));
+			break;
+		case EPCGTextureCPUStorage::R16F:
+			reinterpret_cast<FFloat16*>(OutTexelData)[Index] = FFloat16(Color.R);
+			break;
+		case EPCGTextureCPUStorage::R32F:
+			reinterpret_cast<float*>(OutTexelData)[Index] = Color.R;
+			break;
+		case EPCGTextureCPUStorage::RGBA32F:
+		default:
+			reinterpret_cast<FLinearColor*>(OutTexelData)[Index] = Color;
+			break;
+		}
+	}
+
 	TOptional<bool> IsTextureCPUAccessible(UTexture2D* Texture)
 	{
 		if (!Texture)
@@ -122,7 +192,7 @@ namespace PCGTextureSamplingHelpers
 		int32 Width,
 		int32 Height,
 		ValueType& SampledValue,
-		TFunctionRef<ValueType(int32 Index)> SamplingFunction)
+		TFunctionRef<ValueType(const FVector2D& TexturePosition)> SamplingFunction)
 	{
 		check(Width > 0 && Height > 0);
 		if (Width <= 0 || Height <= 0 || InSurface.GetSize().SquaredLength() <= 0)
@@ -168,10 +238,23 @@ namespace PCGTextureSamplingHelpers
 			Pos = FVector2D(X, Y);
 		}
 
-		SampledValue = SampleInternal(Pos, Width, Height, InTextureData->Filter, SamplingFunction);
+		SampledValue = SamplingFunction(Pos);
 		return true;
 	}
 
+	/** Footprint in texture 'UV' units of a sample covering InSurfaceFootprint of the [-1, 1] local surface. */
+	FVector2D GetTextureFootprint(const FVector2D& InSurfaceFootprint, const UPCGBaseTextureData* InTextureData)
+	{
+		FVector2D Footprint = InSurfaceFootprint * 0.5;
+		if (InTextureData->bUseAdvancedTiling)
+		{
+			Footprint.X = (FMath::Abs(InTextureData->Tiling.X) > SMALL_NUMBER) ? Footprint.X / FMath::Abs(InTextureData->Tiling.X) : 0.0;
+			Footprint.Y = (FMath::Abs(InTextureData->Tiling.Y) > SMALL_NUMBER) ? Footprint.Y / FMath::Abs(InTextureData->Tiling.Y) : 0.0;
+		}
+
+		return Footprint;
+	}
+
 	float SampleFloatChannel(const FLinearColor& InColor, EPCGTextureColorChannel ColorChannel)
 	{
 		switch (ColorChannel)
@@ -235,6 +318,59 @@ bool UPCGBaseTextureData::SamplePoint(const FTransform& InTransform, const FBox&
 	// 2 - We suppose that the surface has an infinite 'z' size, in which case the sampling is basically the same as the sampling, except that it does not change the position
 	// 3 - The surface is infinitesimal - we'll return something if and only if the point overlaps with the projected position
 
+	if (!CanSampleCPUTexels())
+	{
+		return false;
+	}
+
+	FTransform SampledTransform;
+	FLinearColor Color;
+	float Density = 0.0f;
+	if (!SampleTransformAndColor(InTransform, InBounds, SampledTransform, Color, Density))
+	{
+		return false;
+	}
+
+	// TODO: embed local bounds center offset at this time?
+	OutPoint.Transform = SampledTransform;
+	OutPoint.SetLocalBounds(InBounds); // TODO: should set Min.Z = Max.Z = 0;
+	OutPoint.Color = Color;
+	OutPoint.Density = Density;
+	return true;
+}
+
+void UPCGBaseTextureData::SamplePointsRange(const FPCGSampleQueryRanges& InQueries, FPCGPointValueRanges& OutRanges, int32 OutStartIndex, UPCGMetadata* OutMetadata) const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UPCGBaseTextureData::SamplePointsRange);
+
+	const bool bCanSample = CanSampleCPUTexels();
+
+	for (int32 Index = 0; Index < InQueries.Num; ++Index)
+	{
+		const FBox LocalBounds = InQueries.GetLocalBounds(Index);
+
+		FTransform SampledTransform;
+		FLinearColor Color;
+		float Density = 0.0f;
+		if (bCanSample && SampleTransformAndColor(InQueries.GetTransform(Index), LocalBounds, SampledTransform, Color, Density))
+		{
+			FPCGSpatialDataProcessing::WriteSampledPoint(OutRanges, OutStartIndex + Index, SampledTransform, LocalBounds, Density, FVector4(Color));
+		}
+		else
+		{
+			FPCGSpatialDataProcessing::WriteRejectedSample(OutRanges, OutStartIndex + Index);
+		}
+	}
+}
+
+void UPCGBaseTextureData::ProjectPointsRange(const FPCGSampleQueryRanges& InQueries, const FPCGProjectionParams& InParams, FPCGPointValueRanges& OutRanges, int32 OutStartIndex, UPCGMetadata* OutMetadata) const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UPCGBaseTextureData::ProjectPointsRange);
+	ProjectPointsRangeFromSamples(InQueries, InParams, OutRanges, OutStartIndex, OutMetadata);
+}
+
+bool UPCGBaseTextureData::CanSampleCPUTexels() const
+{
 	if (!IsValid())
 	{
 		return false;
@@ -251,24 +387,34 @@ bool UPCGBaseTextureData::SamplePoint(const FTransform& InTransform, const FBox&
 		return false;
 	}
 
+	return true;
+}
+
+bool UPCGBaseTextureData::SampleTransformAndColor(const FTransform& InTransform, const FBox& InBounds, FTransform& OutTransform, FLinearColor& OutColor, float& OutDensity) const
+{
 	// Compute transform
-	// TODO: embed local bounds center offset at this time?
-	OutPoint.Transform = InTransform;
+	OutTransform = InTransform;
 	FVector PointPositionInLocalSpace = Transform.InverseTransformPosition(InTransform.GetLocation());
-	OutPoint.Transform.SetLocation(Transform.TransformPosition(PointPositionInLocalSpace));
-	OutPoint.SetLocalBounds(InBounds); // TODO: should set Min.Z = Max.Z = 0;
+	OutTransform.SetLocation(Transform.TransformPosition(PointPositionInLocalSpace));
 
 	// Compute density & color (& metadata)
 	// TODO: sample in the bounds given, not only on a single pixel
 	FVector2D Position2D(PointPositionInLocalSpace.X, PointPositionInLocalSpace.Y);
 	FBox2D Surface(FVector2D(-1.0f, -1.0f), FVector2D(1.0f, 1.0f));
 
-	FLinearColor Color = FLinearColor(EForceInit::ForceInit);
-	if (PCGTextureSamplingHelpers::Sample<FLinearColor>(Position2D, Surface, this, Width, Height, Color, [this](int32 Index) { return ColorData[Index]; }))
+	// Samples larger than a texel read from the mip level matching the point bounds, when mip filtering is enabled.
+	float MipLevel = 0.0f;
+	if (MipFilter != EPCGTextureMipFilter::None)
 	{
-		OutPoint.Color = Color;
-		OutPoint.Density = bUseDensitySourceChannel ? PCGTextureSamplingHelpers::SampleFloatChannel(Color, ColorChannel) : 1.0f;
-		return OutPoint.Density > 0 || bKeepZeroDensityPoints;
+		const FVector LocalFootprint = InBounds.GetSize() * InTransform.GetScale3D().GetAbs() / Transform.GetScale3D().GetAbs();
+		MipLevel = ComputeMipLevel(PCGTextureSamplingHelpers::GetTextureFootprint(FVector2D(LocalFootprint), this));
+	}
+
+	OutColor = FLinearColor(EForceInit::ForceInit);
+	if (PCGTextureSamplingHelpers::Sample<FLinearColor>(Position2D, Surface, this, Width, Height, OutColor, [this, MipLevel](const FVector2D& TexturePosition) { return SampleTexturePosition(TexturePosition, MipLevel); }))
+	{
+		OutDensity = bUseDensitySourceChannel ? PCGTextureSamplingHelpers::SampleFloatChannel(OutColor, ColorChannel) : 1.0f;
+		return OutDensity > 0 || bKeepZeroDensityPoints;
 	}
 	else
 	{
@@ -335,7 +481,14 @@ const UPCGBasePointData* UPCGBaseTextureData::CreateBasePointData(FPCGContext* C
 		Data->SetExtents(FVector(TexelSize / 2.0));
 	}
 
-	auto ProcessRangeFunc = [this, XCount, YCount, &Surface, Data](int32 StartReadIndex, int32 StartWriteIndex, int32 Count)
+	// Each point covers one cell of the XCount x YCount grid laid over the surface.
+	const float MipLevel = (MipFilter != EPCGTextureMipFilter::None) ? ComputeMipLevel(PCGTextureSamplingHelpers::GetTextureFootprint(FVector2D(2.0 / XCount, 2.0 / YCount), this)) : 0.0f;
+	if (MipLevel > 0.0f)
+	{
+		BuildCPUMipChain();
+	}
+
+	auto ProcessRangeFunc = [this, XCount, YCount, MipLevel, &Surface, Data](int32 StartReadIndex, int32 StartWriteIndex, int32 Count)
 	{
 		int32 NumWritten = 0;
 		FPCGPointValueRanges OutRanges(Data, /*bAllocate=*/false);
@@ -351,7 +504,7 @@ const UPCGBasePointData* UPCGBaseTextureData::CreateBasePointData(FPCGContext* C
 			FVector2D LocalCoordinate((2.0 * X + 0.5) / XCount - 1.0, (2.0 * Y + 0.5) / YCount - 1.0);
 			FLinearColor Color = FLinearColor(EForceInit::ForceInit);
 
-			if (PCGTextureSamplingHelpers::Sample<FLinearColor>(LocalCoordinate, Surface, this, Width, Height, Color, [this](int32 Index) { return ColorData[Index]; }))
+			if (PCGTextureSamplingHelpers::Sample<FLinearColor>(LocalCoordinate, Surface, this, Width, Height, Color, [this, MipLevel](const FVector2D& TexturePosition) { return SampleTexturePosition(TexturePosition, MipLevel); }))
 			{
 				const float Density = bUseDensitySourceChannel ? PCGTextureSamplingHelpers::SampleFloatChannel(Color, ColorChannel) : 1.0f;
 				if (Density > 0 || bKeepZeroDensityPoints)
@@ -396,12 +549,115 @@ const UPCGBasePointData* UPCGBaseTextureData::CreateBasePointData(FPCGContext* C
 	return Data;
 }
 
+void UPCGBaseTextureData::GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize)
+{
+	Super::GetResourceSizeEx(CumulativeResourceSize);
+
+	CumulativeResourceSize.AddDedicatedSystemMemoryBytes(GetCPUTexelsSizeBytes());
+}
+
+SIZE_T UPCGBaseTextureData::GetCPUTexelsSizeBytes() const
+{
+	SIZE_T SizeBytes = ColorData.GetAllocatedSize() + CompactTexelData.GetAllocatedSize();
+
+	if (bCPUMipChainBuilt)
+	{
+		SizeBytes += CPUMips.GetAllocatedSize();
+		for (const FPCGTextureCPUMip& Mip : CPUMips)
+		{
+			SizeBytes += Mip.TexelData.GetAllocatedSize();
+		}
+	}
+
+	return SizeBytes;
+}
+
+void UPCGBaseTextureData::AllocateCPUTexels(EPCGTextureCPUStorage InStorage)
+{
+	ResetCPUTexels();
+
+	CPUStorage = InStorage;
+
+	const int32 TexelCount = Width * Height;
+	if (InStorage == EPCGTextureCPUStorage::RGBA32F)
+	{
+		ColorData.SetNumUninitialized(TexelCount);
+	}
+	else
+	{
+		CompactTexelData.SetNumUninitialized(TexelCount * PCGTextureSamplingHelpers::GetBytesPerTexel(InStorage));
+	}
+}
+
+void UPCGBaseTextureData::ResetCPUTexels()
+{
+	ColorData.Empty();
+	CompactTexelData.Empty();
+	CPUStorage = EPCGTextureCPUStorage::RGBA32F;
+
+	FScopeLock Lock(&CPUMipChainLock);
+	CPUMips.Empty();
+	bCPUMipChainBuilt = false;
+}
+
+void UPCGBaseTextureData::FinalizeCPUTexels()
+{
+	const int32 TexelCount = Width * Height;
+
+	if (!PCGTextureSamplingHelpers::CVarCompactCPUStorage.GetValueOnAnyThread())
+	{
+		if (CPUStorage != EPCGTextureCPUStorage::RGBA32F)
+		{
+			TArray<FLinearColor> WideTexels;
+			WideTexels.SetNumUninitialized(TexelCount);
+			for (int32 D = 0; D < TexelCount; ++D)
+			{
+				WideTexels[D] = GetTexel(D);
+			}
+
+			ResetCPUTexels();
+			ColorData = MoveTemp(WideTexels);
+		}
+
+		return;
+	}
+
+	if (!PCGTextureSamplingHelpers::CVarHalfPrecisionCPUStorage.GetValueOnAnyThread())
+	{
+		return;
+	}
+
+	if (CPUStorage == EPCGTextureCPUStorage::RGBA32F)
+	{
+		TArray<FLinearColor> WideTexels = MoveTemp(ColorData);
+		AllocateCPUTexels(EPCGTextureCPUStorage::RGBA16F);
+
+		FFloat16Color* Texels = GetMutableCPUTexels<FFloat16Color>();
+		for (int32 D = 0; D < TexelCount; ++D)
+		{
+			Texels[D] = FFloat16Color(WideTexels[D]);
+		}
+	}
+	else if (CPUStorage == EPCGTextureCPUStorage::R32F)
+	{
+		TArray<uint8> WideTexels = MoveTemp(CompactTexelData);
+		AllocateCPUTexels(EPCGTextureCPUStorage::R16F);
+
+		const float* Source = reinterpret_cast<const float*>(WideTexels.GetData());
+		FFloat16* Texels = GetMutableCPUTexels<FFloat16>();
+		for (int32 D = 0; D < TexelCount; ++D)
+		{
+			Texels[D] = FFloat16(Source[D]);
+		}
+	}
+}
+
 bool UPCGBaseTextureData::IsValid() const
 {
-	return Height > 0 && Width > 0 && (!ColorData.IsEmpty() || bSkipReadbackToCPU);
+	return Height > 0 && Width > 0 && (HasCPUTexels() || bSkipReadbackToCPU);
 }
 
-bool UPCGBaseTextureData::SamplePointLocal(const FVector2D& LocalPosition, FVector4& OutColor, float& OutDensity) const
+bool UPCGBaseTextureData::SamplePointLocal(const FVector2D& LocalPosition, FVector4& OutColor, float& OutDensity, float InMipLevel) const
 {
 	if (!IsValid())
 	{
@@ -423,7 +679,7 @@ bool UPCGBaseTextureData::SamplePointLocal(const FVector2D& LocalPosition, FVect
 	Pos.X = FMath::Frac(LocalPosition.X);
 	Pos.Y = FMath::Frac(LocalPosition.Y);
 
-	const FLinearColor OutSample = PCGTextureSamplingHelpers::SampleInternal<FLinearColor>(Pos, Width, Height, Filter, [this](int32 Index) { return ColorData[Index]; });
+	const FLinearColor OutSample = SampleTexturePosition(Pos, InMipLevel);
 
 	OutColor = OutSample;
 	OutDensity = bUseDensitySourceChannel ? PCGTextureSamplingHelpers::SampleFloatChannel(OutSample, ColorChannel) : 1.0f;
@@ -431,6 +687,217 @@ bool UPCGBaseTextureData::SamplePointLocal(const FVector2D& LocalPosition, FVect
 	return OutDensity > 0.0 || bKeepZeroDensityPoints;
 }
 
+bool UPCGBaseTextureData::SampleChannelLocal(TConstArrayView<FVector2D> InLocalPositions, EPCGTextureColorChannel InChannel, TArrayView<float> OutValues, float InDefaultValue, float InMipLevel) const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UPCGBaseTextureData::SampleChannelLocal);
+
+	check(InLocalPositions.Num() == OutValues.Num());
+
+	if (!IsValid() || bSkipReadbackToCPU)
+	{
+		if (bSkipReadbackToCPU && !bEmittedNoReadbackDataError)
+		{
+			UE_LOG(LogPCG, Error, TEXT("Texture data was initialized with bSkipReadbackToCPU enabled - point cannot be sampled."));
+			bEmittedNoReadbackDataError = true;
+		}
+
+		for (float& Value : OutValues)
+		{
+			Value = InDefaultValue;
+		}
+
+		return false;
+	}
+
+	const int32 ChannelIndex = static_cast<int32>(InChannel);
+
+	// Same rejection as SamplePointLocal: density from the source channel, zero density is a failed sample unless zero density points are kept.
+	const bool bTestDensity = bUseDensitySourceChannel && !bKeepZeroDensityPoints;
+	const int32 DensityChannelIndex = static_cast<int32>(ColorChannel);
+
+	// Coarser samples go through the mip chain, one color per sample.
+	if (MipFilter != EPCGTextureMipFilter::None && InMipLevel > 0.0f)
+	{
+		BuildCPUMipChain();
+
+		for (int32 SampleIndex = 0; SampleIndex < InLocalPositions.Num(); ++SampleIndex)
+		{
+			const FVector2D Pos(FMath::Frac(InLocalPositions[SampleIndex].X), FMath::Frac(InLocalPositions[SampleIndex].Y));
+			const FLinearColor Color = SampleTexturePosition(Pos, InMipLevel);
+
+			OutValues[SampleIndex] = (bTestDensity && Color.Component(DensityChannelIndex) <= 0.0f) ? InDefaultValue : Color.Component(ChannelIndex);
+		}
+
+		return true;
+	}
+
+	for (int32 SampleIndex = 0; SampleIndex < InLocalPositions.Num(); ++SampleIndex)
+	{
+		const double TexelX = FMath::Frac(InLocalPositions[SampleIndex].X) * Width;
+		const double TexelY = FMath::Frac(InLocalPositions[SampleIndex].Y) * Height;
+
+		float Value = 0.0f;
+		float Density = 1.0f;
+
+		if (Filter == EPCGTextureFilter::Point)
+		{
+			const int32 X = FMath::Clamp(FMath::FloorToInt(TexelX), 0, Width - 1);
+			const int32 Y = FMath::Clamp(FMath::FloorToInt(TexelY), 0, Height - 1);
+			const FLinearColor Texel = GetTexel(X + Y * Width);
+
+			Value = Texel.Component(ChannelIndex);
+			Density = Texel.Component(DensityChannelIndex);
+		}
+		else
+		{
+			// Matches SampleInternal: texel values at texel centers, color lerps with float alphas.
+			const double TexelXOffset = TexelX - 0.5;
+			const double TexelYOffset = TexelY - 0.5;
+
+			const int32 X0 = FMath::Clamp(FMath::FloorToInt(TexelXOffset), 0, Width - 1);
+			const int32 X1 = FMath::Min(X0 + 1, Width - 1);
+			const int32 Y0 = FMath::Clamp(FMath::FloorToInt(TexelYOffset), 0, Height - 1);
+			const int32 Y1 = FMath::Min(Y0 + 1, Height - 1);
+
+			const float AlphaX = static_cast<float>(TexelXOffset - X0);
+			const float AlphaY = static_cast<float>(TexelYOffset - Y0);
+
+			const FLinearColor Texel00 = GetTexel(X0 + Y0 * Width);
+			const FLinearColor Texel10 = GetTexel(X1 + Y0 * Width);
+			const FLinearColor Texel01 = GetTexel(X0 + Y1 * Width);
+			const FLinearColor Texel11 = GetTexel(X1 + Y1 * Width);
+
+			auto BiLerpChannel = [&](int32 InChannelIndex)
+			{
+				const float Value0 = Texel00.Component(InChannelIndex) + AlphaX * (Texel10.Component(InChannelIndex) - Texel00.Component(InChannelIndex));
+				const float Value1 = Texel01.Component(InChannelIndex) + AlphaX * (Texel11.Component(InChannelIndex) - Texel01.Component(InChannelIndex));
+				return Value0 + AlphaY * (Value1 - Value0);
+			};
+
+			Value = BiLerpChannel(ChannelIndex);
+			if (bTestDensity)
+			{
+				Density = (DensityChannelIndex == ChannelIndex) ? Value : BiLerpChannel(DensityChannelIndex);
+			}
+		}
+
+		OutValues[SampleIndex] = (bTestDensity && Density <= 0.0f) ? InDefaultValue : Value;
+	}
+
+	return true;
+}
+
+float UPCGBaseTextureData::ComputeMipLevel(const FVector2D& InLocalFootprint) const
+{
+	const double FootprintTexels = FMath::Max(FMath::Abs(InLocalFootprint.X) * Width, FMath::Abs(InLocalFootprint.Y) * Height);
+	return (FootprintTexels > 1.0) ? static_cast<float>(FMath::Log2(FootprintTexels)) : 0.0f;
+}
+
+void UPCGBaseTextureData::BuildCPUMipChain() const
+{
+	if (bCPUMipChainBuilt || !HasCPUTexels())
+	{
+		return;
+	}
+
+	FScopeLock Lock(&CPUMipChainLock);
+	if (bCPUMipChainBuilt)
+	{
+		return;
+	}
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(UPCGBaseTextureData::BuildCPUMipChain);
+
+	CPUMips.Reset();
+	CPUMips.Reserve(FMath::CeilLogTwo(static_cast<uint32>(FMath::Max(Width, Height))));
+
+	// 2x2 box average of the source level, stored in the same layout. Odd sizes fold the last row / column into the last texel.
+	auto Downsample = [this](FPCGTextureCPUMip& Mip, int32 SourceWidth, int32 SourceHeight, const uint8* SourceTexelData)
+	{
+		Mip.Width = FMath::Max(SourceWidth / 2, 1);
+		Mip.Height = FMath::Max(SourceHeight / 2, 1);
+		Mip.TexelData.SetNumUninitialized(Mip.Width * Mip.Height * PCGTextureSamplingHelpers::GetBytesPerTexel(CPUStorage));
+
+		ParallelFor(Mip.Height, [&Mip, SourceTexelData, SourceWidth, SourceHeight, Storage = CPUStorage](int32 Y)
+		{
+			const int32 Y0 = 2 * Y;
+			const int32 Y1 = (Y == Mip.Height - 1) ? SourceHeight : FMath::Min(Y0 + 2, SourceHeight);
+
+			for (int32 X = 0; X < Mip.Width; ++X)
+			{
+				const int32 X0 = 2 * X;
+				const int32 X1 = (X == Mip.Width - 1) ? SourceWidth : FMath::Min(X0 + 2, SourceWidth);
+
+				FLinearColor Sum = FLinearColor::Transparent;
+				for (int32 SourceY = Y0; SourceY < Y1; ++SourceY)
+				{
+					for (int32 SourceX = X0; SourceX < X1; ++SourceX)
+					{
+						Sum += PCGTextureSamplingHelpers::DecodeTexel(Storage, SourceTexelData, SourceX + SourceY * SourceWidth);
+					}
+				}
+
+				PCGTextureSamplingHelpers::EncodeTexel(Storage, Mip.TexelData.GetData(), X + Y * Mip.Width, Sum / static_cast<float>((X1 - X0) * (Y1 - Y0)));
+			}
+		});
+	};
+
+	if (Width > 1 || Height > 1)
+	{
+		Downsample(CPUMips.Emplace_GetRef(), Width, Height, GetCPUTexelData());
+	}
+
+	while (CPUMips.Num() > 0 && (CPUMips.Last().Width > 1 || CPUMips.Last().Height > 1))
+	{
+		const int32 SourceLevel = CPUMips.Num() - 1;
+		FPCGTextureCPUMip& Mip = CPUMips.Emplace_GetRef();
+		const FPCGTextureCPUMip& Source = CPUMips[SourceLevel];
+
+		Downsample(Mip, Source.Width, Source.Height, Source.TexelData.GetData());
+	}
+
+	bCPUMipChainBuilt = true;
+}
+
+FLinearColor UPCGBaseTextureData::SampleTexturePosition(const FVector2D& InTexturePosition, float InMipLevel) const
+{
+	if (MipFilter == EPCGTextureMipFilter::None || InMipLevel <= 0.0f)
+	{
+		return PCGTextureSamplingHelpers::SampleInternal<FLinearColor>(InTexturePosition, Width, Height, Filter, [this](int32 Index) { return GetTexel(Index); });
+	}
+
+	BuildCPUMipChain();
+
+	// Mip levels are in the layout of level 0 and decoded the same way.
+	auto SampleLevel = [this, &InTexturePosition](int32 Level) -> FLinearColor
+	{
+		const FPCGTextureCPUMip* Mip = (Level > 0) ? &CPUMips[Level - 1] : nullptr;
+		const int32 LevelWidth = Mip ? Mip->Width : Width;
+		const int32 LevelHeight = Mip ? Mip->Height : Height;
+		const uint8* LevelTexelData = Mip ? Mip->TexelData.GetData() : GetCPUTexelData();
+
+		return PCGTextureSamplingHelpers::SampleInternal<FLinearColor>(InTexturePosition, LevelWidth, LevelHeight, Filter, [Storage = CPUStorage, LevelTexelData](int32 Index)
+		{
+			return PCGTextureSamplingHelpers::DecodeTexel(Storage, LevelTexelData, Index);
+		});
+	};
+
+	const float MaxLevel = static_cast<float>(GetNumCPUMipLevels() - 1);
+	const float Level = FMath::Min(InMipLevel, MaxLevel);
+
+	if (MipFilter == EPCGTextureMipFilter::Box)
+	{
+		return SampleLevel(FMath::RoundToInt(Level));
+	}
+
+	const int32 Level0 = FMath::FloorToInt(Level);
+	const int32 Level1 = FMath::Min(Level0 + 1, static_cast<int32>(MaxLevel));
+	const float Alpha = Level - Level0;
+
+	const FLinearColor Sample0 = SampleLevel(Level0);
+	return (Alpha > 0.0f && Level1 != Level0) ? FMath::Lerp(Sample0, SampleLevel(Level1), Alpha) : Sample0;
+}
+
 void UPCGBaseTextureData::CopyBaseTextureData(UPCGBaseTextureData* NewTextureData) const
 {
 	CopyBaseSurfaceData(NewTextureData);
@@ -445,6 +912,15 @@ void UPCGBaseTextureData::CopyBaseTextureData(UPCGBaseTextureData* NewTextureDat
 	NewTextureData->bUseTileBounds = bUseTileBounds;
 	NewTextureData->TileBounds = TileBounds;
 	NewTextureData->ColorData = ColorData;
+	NewTextureData->CompactTexelData = CompactTexelData;
+	NewTextureData->CPUStorage = CPUStorage;
+	NewTextureData->MipFilter = MipFilter;
+
+	if (bCPUMipChainBuilt)
+	{
+		NewTextureData->CPUMips = CPUMips;
+		NewTextureData->bCPUMipChainBuilt = true;
+	}
 	NewTextureData->Bounds = Bounds;
 	NewTextureData->Height = Height;
 	NewTextureData->Width = Width;
@@ -727,92 +1203,71 @@ TOptional<bool> UPCGTextureData::InitializeFromCPUTexture()
 	Height = CPUTextureRef->SizeY;
 
 	const int32 PixelCount = Width * Height;
-	ColorData.SetNum(PixelCount);
 
+	// Texels are kept in the layout of the source image and decoded by GetTexel, so single channel
+	// textures cost one or a few bytes per texel instead of a full FLinearColor.
 	if (CPUTextureRef->Format == ERawImageFormat::G8)
 	{
 		const TArrayView64<const uint8> DataView = CPUTextureRef->AsG8();
 
-		for (int32 D = 0; D < PixelCount; ++D)
-		{
-			ColorData[D] = FColor(DataView[D], DataView[D], DataView[D]).ReinterpretAsLinear();
-		}
+		AllocateCPUTexels(EPCGTextureCPUStorage::R8);
+		FMemory::Memcpy(GetMutableCPUTexels<uint8>(), DataView.GetData(), PixelCount * sizeof(uint8));
 	}
-	else if (CPUTextureRef->Format == ERawImageFormat::BGRA8)
+	else if (CPUTextureRef->Format == ERawImageFormat::BGRA8 || CPUTextureRef->Format == ERawImageFormat::BGRE8)
 	{
-		const TArrayView64<const FColor> DataView = CPUTextureRef->AsBGRA8();
+		// BGRE8 is decoded as plain BGRA8, as before.
+		const TArrayView64<const FColor> DataView = (CPUTextureRef->Format == ERawImageFormat::BGRA8) ? CPUTextureRef->AsBGRA8() : CPUTextureRef->AsBGRE8();
 
-		// Memory representation of FColor is BGRA, so we reinterpret as FLinearColor to get RGBA.
-		for (int32 D = 0; D < PixelCount; ++D)
-		{
-			ColorData[D] = DataView[D].ReinterpretAsLinear();
-		}
-	}
-	else if (CPUTextureRef->Format == ERawImageFormat::BGRE8)
-	{
-		const TArrayView64<const FColor> DataView = CPUTextureRef->AsBGRE8();
-
-		// Memory representation of FColor is BGRA, so we reinterpret as FLinearColor to get RGBA.
-		for (int32 D = 0; D < PixelCount; ++D)
-		{
-			ColorData[D] = DataView[D].ReinterpretAsLinear();
-		}
+		AllocateCPUTexels(EPCGTextureCPUStorage::BGRA8);
+		FMemory::Memcpy(GetMutableCPUTexels<FColor>(), DataView.GetData(), PixelCount * sizeof(FColor));
 	}
 	else if (CPUTextureRef->Format == ERawImageFormat::RGBA16)
 	{
 		const TArrayView64<const uint16> DataView = CPUTextureRef->AsRGBA16();
 		check(PixelCount * 4 == DataView.Num());
 
-		for (int32 D = 0; D < PixelCount; ++D)
-		{
-			const uint32 Index = D * 4;
-			ColorData[D] = FLinearColor(DataView[Index + 0], DataView[Index + 1], DataView[Index + 2], DataView[Index + 3]);
-		}
+		AllocateCPUTexels(EPCGTextureCPUStorage::RGBA16);
+		FMemory::Memcpy(GetMutableCPUTexels<uint16>(), DataView.GetData(), PixelCount * 4 * sizeof(uint16));
 	}
 	else if (CPUTextureRef->Format == ERawImageFormat::RGBA16F)
 	{
 		const TArrayView64<const FFloat16Color> DataView = CPUTextureRef->AsRGBA16F();
 
-		for (int32 D = 0; D < PixelCount; ++D)
-		{
-			ColorData[D] = FLinearColor(DataView[D]);
-		}
+		AllocateCPUTexels(EPCGTextureCPUStorage::RGBA16F);
+		FMemory::Memcpy(GetMutableCPUTexels<FFloat16Color>(), DataView.GetData(), PixelCount * sizeof(FFloat16Color));
 	}
 	else if (CPUTextureRef->Format == ERawImageFormat::RGBA32F)
 	{
 		const TArrayView64<const FLinearColor> DataView = CPUTextureRef->AsRGBA32F();
 
-		for (int32 D = 0; D < PixelCount; ++D)
-		{
-			ColorData[D] = DataView[D];
-		}
+		AllocateCPUTexels(EPCGTextureCPUStorage::RGBA32F);
+		FMemory::Memcpy(GetMutableCPUTexels<FLinearColor>(), DataView.GetData(), PixelCount * sizeof(FLinearColor));
 	}
 	else if (CPUTextureRef->Format == ERawImageFormat::G16)
 	{
 		const TArrayView64<const uint16> DataView = CPUTextureRef->AsG16();
 
+		// G16 has always been read through FColor, which keeps the low 8 bits of each value. Store exactly that.
+		AllocateCPUTexels(EPCGTextureCPUStorage::R8);
+		uint8* Texels = GetMutableCPUTexels<uint8>();
 		for (int32 D = 0; D < PixelCount; ++D)
 		{
-			ColorData[D] = FColor(DataView[D], DataView[D], DataView[D]).ReinterpretAsLinear();
+			Texels[D] = static_cast<uint8>(DataView[D]);
 		}
 	}
 	else if (CPUTextureRef->Format == ERawImageFormat::R16F)
 	{
 		const TArrayView64<const FFloat16> DataView = CPUTextureRef->AsR16F();
 
-		for (int32 D = 0; D < PixelCount; ++D)
-		{
-			ColorData[D] = FLinearColor(DataView[D], DataView[D], DataView[D]);
-		}
+		AllocateCPUTexels(EPCGTextureCPUStorage::R16F);
+		FMemory::Memcpy(GetMutableCPUTexels<FFloat16>(), DataView.GetData(), PixelCount * sizeof(FFloat16));
 	}
 	else if (CPUTextureRef->Format == ERawImageFormat::R32F)
 	{
 		const TArrayView64<const float> DataView = CPUTextureRef->AsR32F();
 
-		for (int32 D = 0; D < PixelCount; ++D)
-		{
-			ColorData[D] = FLinearColor(DataView[D], DataView[D], DataView[D]);
-		}
+		AllocateCPUTexels(EPCGTextureCPUStorage::R32F);
+		FMemory::Memcpy(GetMutableCPUTexels<float>(), DataView.GetData(), PixelCount * sizeof(float));
 	}
 	else
 	{
@@ -820,11 +1275,13 @@ TOptional<bool> UPCGTextureData::InitializeFromCPUTexture()
 
 		Width = 0;
 		Height = 0;
-		ColorData.SetNum(0);
+		ResetCPUTexels();
 
 		return false;
 	}
 
+	FinalizeCPUTexels();
+
 	return true;
 }
 
@@ -904,8 +1361,9 @@ bool UPCGTextureData::ReadbackFromGPUTexture()
 			{
 				This->Width = TextureSize.X;
 				This->Height = TextureSize.Y;
-				This->ColorData.SetNum(TextureSize.X * TextureSize.Y);
+				This->AllocateCPUTexels(EPCGTextureCPUStorage::BGRA8);
 
+				FColor* Texels = This->GetMutableCPUTexels<FColor>();
 				int32 ActualTexelIndex = 0;
 
 				for (int32 TexelY = 0; TexelY < TextureSize.Y; ++TexelY)
@@ -914,9 +1372,11 @@ bool UPCGTextureData::ReadbackFromGPUTexture()
 					{
 						const int32 ReadbackTexelIndex = TexelY * ReadbackWidth + TexelX;
 
-						This->ColorData[ActualTexelIndex++] = FormattedImageData[ReadbackTexelIndex].ReinterpretAsLinear();
+						Texels[ActualTexelIndex++] = FormattedImageData[ReadbackTexelIndex];
 					}
 				}
+
+				This->FinalizeCPUTexels();
 			}
 			else
 			{
@@ -1018,13 +1478,10 @@ TOptional<bool> UPCGTextureData::InitializeGPUTextureFromCPU()
 		Width = PlatformData->SizeX;
 		Height = PlatformData->SizeY;
 		const int32 PixelCount = Width * Height;
-		ColorData.SetNum(PixelCount);
 
-		const FColor* FormattedImageData = reinterpret_cast<const FColor*>(BulkData);
-		for (int32 D = 0; D < PixelCount; ++D)
-		{
-			ColorData[D] = FormattedImageData[D].ReinterpretAsLinear();
-		}
+		AllocateCPUTexels(EPCGTextureCPUStorage::BGRA8);
+		FMemory::Memcpy(GetMutableCPUTexels<FColor>(), BulkData, PixelCount * sizeof(FColor));
+		FinalizeCPUTexels();
 	}
 	else
 	{
@@ -6,6 +6,7 @@
 #include "Data/PCGPointArrayData.h"
 #include "Data/PCGPointData.h"
 #include "Data/PCGSpatialData.h"
+#include "Data/PCGSpatialDataTpl.h"
 #include "Helpers/PCGAsync.h"
 #include "Helpers/PCGHelpers.h"
 #include "Metadata/PCGMetadataAccessor.h"
@@ -212,6 +213,154 @@ bool UPCGUnionData::SamplePoint(const FTransform& InTransform, const FBox& InBou
 	return (bHasSetPoint && OutPoint.Density > 0);
 }
 
+void UPCGUnionData::SamplePointsRange(const FPCGSampleQueryRanges& InQueries, FPCGPointValueRanges& OutRanges, int32 OutStartIndex, UPCGMetadata* OutMetadata) const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UPCGUnionData::SamplePointsRange);
+
+	// Range version of SamplePoint: each operand samples all the queries that are not saturated yet in one call.
+	// A sample is considered set when its density is > 0, since SamplePointsRange does not report overlaps otherwise.
+	using FSampledPointsBuffer = FPCGSpatialDataProcessing::FSampledPointsBuffer;
+
+	const int32 NumQueries = InQueries.Num;
+	FSampledPointsBuffer Result(NumQueries);
+	TBitArray<> HasSetPoint(false, NumQueries);
+
+	if (FirstNonTrivialTransformData)
+	{
+		FPCGPointValueRanges ResultRanges = Result.GetValueRanges();
+		FirstNonTrivialTransformData->SamplePointsRange(InQueries, ResultRanges, /*OutStartIndex=*/0, OutMetadata);
+
+		for (int32 Index = 0; Index < NumQueries; ++Index)
+		{
+			if (Result.Densities[Index] > 0)
+			{
+				HasSetPoint[Index] = true;
+
+				if (DensityFunction == EPCGUnionDensityFunction::Binary)
+				{
+					Result.Densities[Index] = 1.0f;
+				}
+			}
+		}
+	}
+
+	// Queries for the other operands: the transform of the first sample if any, the query bounds.
+	TArray<FTransform> PointTransforms;
+	PointTransforms.SetNumUninitialized(NumQueries);
+	for (int32 Index = 0; Index < NumQueries; ++Index)
+	{
+		PointTransforms[Index] = HasSetPoint[Index] ? Result.Transforms[Index] : InQueries.GetTransform(Index);
+	}
+
+	// Only the queries that are not saturated are sampled.
+	TArray<int32> ActiveIndices;
+	FSampledPointsBuffer ActiveQueries(0, EPCGPointNativeProperties::None);
+	auto GatherActiveQueries = [&]()
+	{
+		ActiveIndices.Reset();
+		ActiveQueries.ResetQueries();
+
+		for (int32 Index = 0; Index < NumQueries; ++Index)
+		{
+			if (OutMetadata || !HasSetPoint[Index] || Result.Densities[Index] < 1.0f)
+			{
+				ActiveIndices.Add(Index);
+				ActiveQueries.AddQuery(PointTransforms[Index], InQueries, Index);
+			}
+		}
+	};
+
+	GatherActiveQueries();
+
+	for (const UPCGSpatialData* InputData : Data)
+	{
+		if (ActiveIndices.IsEmpty())
+		{
+			break;
+		}
+
+		if (InputData == FirstNonTrivialTransformData)
+		{
+			continue;
+		}
+
+		const FPCGSampleQueryRanges Queries = ActiveQueries.GetQueries();
+
+		FSampledPointsBuffer PointsInData(ActiveIndices.Num());
+		{
+			FPCGPointValueRanges PointsInDataRanges = PointsInData.GetValueRanges();
+			InputData->SamplePointsRange(Queries, PointsInDataRanges, /*OutStartIndex=*/0, OutMetadata);
+		}
+
+		for (int32 ActiveIndex = 0; ActiveIndex < ActiveIndices.Num(); ++ActiveIndex)
+		{
+			if (PointsInData.Densities[ActiveIndex] <= 0)
+			{
+				continue;
+			}
+
+			const int32 Index = ActiveIndices[ActiveIndex];
+			if (!HasSetPoint[Index])
+			{
+				Result.CopyEntry(PointsInData, ActiveIndex, Index);
+				HasSetPoint[Index] = true;
+				continue;
+			}
+
+			// Update density
+			PCGUnionDataMaths::UpdateDensity(Result.Densities[Index], PointsInData.Densities[ActiveIndex], DensityFunction);
+
+			const FVector4& Color = PointsInData.Colors[ActiveIndex];
+			FVector4& ResultColor = Result.Colors[Index];
+			ResultColor = FVector4(
+				FMath::Max(ResultColor.X, Color.X),
+				FMath::Max(ResultColor.Y, Color.Y),
+				FMath::Max(ResultColor.Z, Color.Z),
+				FMath::Max(ResultColor.W, Color.W));
+
+			// Merge properties into the result
+			if (OutMetadata)
+			{
+				const int64 EntryInData = PointsInData.MetadataEntries[ActiveIndex];
+				int64& ResultEntry = Result.MetadataEntries[Index];
+
+				if (ResultEntry != PCGInvalidEntryKey && EntryInData != PCGInvalidEntryKey)
+				{
+					OutMetadata->MergeAttributesSubset(ResultEntry, OutMetadata, OutMetadata, EntryInData, OutMetadata, InputData->Metadata, ResultEntry, EPCGMetadataOp::Max);
+				}
+				else if (EntryInData != PCGInvalidEntryKey)
+				{
+					ResultEntry = EntryInData;
+				}
+			}
+		}
+
+		// The transform of set samples does not change, only drop the saturated queries.
+		if (!OutMetadata)
+		{
+			GatherActiveQueries();
+		}
+	}
+
+	for (int32 Index = 0; Index < NumQueries; ++Index)
+	{
+		if (HasSetPoint[Index] && Result.Densities[Index] > 0)
+		{
+			Result.WriteTo(Index, OutRanges, OutStartIndex + Index);
+		}
+		else
+		{
+			FPCGSpatialDataProcessing::WriteRejectedSample(OutRanges, OutStartIndex + Index);
+		}
+	}
+}
+
+void UPCGUnionData::ProjectPointsRange(const FPCGSampleQueryRanges& InQueries, const FPCGProjectionParams& InParams, FPCGPointValueRanges& OutRanges, int32 OutStartIndex, UPCGMetadata* OutMetadata) const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UPCGUnionData::ProjectPointsRange);
+	ProjectPointsRangeFromSamples(InQueries, InParams, OutRanges, OutStartIndex, OutMetadata);
+}
+
 bool UPCGUnionData::HasNonTrivialTransform() const
 {
 	return (FirstNonTrivialTransformData != nullptr || Super::HasNonTrivialTransform());
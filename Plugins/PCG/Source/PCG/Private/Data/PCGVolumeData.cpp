@@ -4,6 +4,7 @@
 #include "Data/PCGPointArrayData.h"
 #include "Data/PCGPointData.h"
 #include "Data/PCGSpatialData.h"
+#include "Data/PCGSpatialDataTpl.h"
 #include "Elements/PCGVolumeSampler.h"
 #include "Helpers/PCGHelpers.h"
 
@@ -177,38 +178,72 @@ bool UPCGVolumeData::SamplePoint(const FTransform& InTransform, const FBox& InBo
 
 	// This is a pure implementation
 
-	const FVector InPosition = InTransform.GetLocation();
-	if (PCGHelpers::IsInsideBounds(GetBounds(), InPosition))
+	float PointDensity = 0.0f;
+	if (!ComputeDensityAtPosition(InTransform.GetLocation(), PointDensity))
 	{
-		float PointDensity = 0.0f;
+		return false;
+	}
 
-		if (!Volume.IsValid() || PCGHelpers::IsInsideBounds(GetStrictBounds(), InPosition))
-		{
-			PointDensity = 1.0f;
-		}
-		else if (VolumeBodyInstance)
+	OutPoint.Transform = InTransform;
+	OutPoint.SetLocalBounds(InBounds);
+	OutPoint.Density = PointDensity;
+
+	return OutPoint.Density > 0;
+}
+
+void UPCGVolumeData::SamplePointsRange(const FPCGSampleQueryRanges& InQueries, FPCGPointValueRanges& OutRanges, int32 OutStartIndex, UPCGMetadata* OutMetadata) const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UPCGVolumeData::SamplePointsRange);
+
+	for (int32 Index = 0; Index < InQueries.Num; ++Index)
+	{
+		const FTransform& QueryTransform = InQueries.GetTransform(Index);
+
+		float PointDensity = 0.0f;
+		if (ComputeDensityAtPosition(QueryTransform.GetLocation(), PointDensity) && PointDensity > 0)
 		{
-			float OutDistanceSquared = -1.0f;
-			if (FPhysicsInterface::GetSquaredDistanceToBody(VolumeBodyInstance, InPosition, OutDistanceSquared))
-			{
-				PointDensity = (OutDistanceSquared == 0.0f ? 1.0f : 0.0f);
-			}
+			FPCGSpatialDataProcessing::WriteSampledPoint(OutRanges, OutStartIndex + Index, QueryTransform, InQueries.GetLocalBounds(Index), PointDensity);
 		}
 		else
 		{
-			PointDensity = Volume->EncompassesPoint(InPosition) ? 1.0f : 0.0f;
+			FPCGSpatialDataProcessing::WriteRejectedSample(OutRanges, OutStartIndex + Index);
 		}
+	}
+}
+
+void UPCGVolumeData::ProjectPointsRange(const FPCGSampleQueryRanges& InQueries, const FPCGProjectionParams& InParams, FPCGPointValueRanges& OutRanges, int32 OutStartIndex, UPCGMetadata* OutMetadata) const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UPCGVolumeData::ProjectPointsRange);
+	ProjectPointsRangeFromSamples(InQueries, InParams, OutRanges, OutStartIndex, OutMetadata);
+}
+
+bool UPCGVolumeData::ComputeDensityAtPosition(const FVector& InPosition, float& OutDensity) const
+{
+	if (!PCGHelpers::IsInsideBounds(GetBounds(), InPosition))
+	{
+		return false;
+	}
 
-		OutPoint.Transform = InTransform;
-		OutPoint.SetLocalBounds(InBounds);
-		OutPoint.Density = PointDensity;
+	OutDensity = 0.0f;
 
-		return OutPoint.Density > 0;
+	if (!Volume.IsValid() || PCGHelpers::IsInsideBounds(GetStrictBounds(), InPosition))
+	{
+		OutDensity = 1.0f;
+	}
+	else if (VolumeBodyInstance)
+	{
+		float OutDistanceSquared = -1.0f;
+		if (FPhysicsInterface::GetSquaredDistanceToBody(VolumeBodyInstance, InPosition, OutDistanceSquared))
+		{
+			OutDensity = (OutDistanceSquared == 0.0f ? 1.0f : 0.0f);
+		}
 	}
 	else
 	{
-		return false;
+		OutDensity = Volume->EncompassesPoint(InPosition) ? 1.0f : 0.0f;
 	}
+
+	return true;
 }
 
 void UPCGVolumeData::CopyBaseVolumeData(UPCGVolumeData* NewVolumeData) const
@@ -11,11 +11,84 @@
 #include "Helpers/PCGHelpers.h"
 
 #include "Algo/Copy.h"
+#include "Algo/StableSort.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(PCGLoopElement)
 
 #define LOCTEXT_NAMESPACE "PCGLoopElement"
 
+namespace PCGLoopHelpers
+{
+	FString GetIterationTagName(const FString& IterationTag, const FPCGStack* Stack)
+	{
+		const uint32 StackCrc = Stack ? Stack->GetCrc().GetValue() : 0;
+		return FString::Printf(TEXT("%s_%08X"), *IterationTag, StackCrc);
+	}
+
+	FString GetIterationTag(const FString& IterationTagName, int32 IterationIndex)
+	{
+		return FString::Printf(TEXT("%s:%d"), *IterationTagName, IterationIndex);
+	}
+
+	int32 SortByIterationAndRemoveTags(const FString& IterationTagName, TArray<FPCGTaggedData>& InOutTaggedData)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(PCGLoopHelpers::SortByIterationAndRemoveTags);
+
+		const FString IterationTagPrefix = IterationTagName + TEXT(":");
+
+		// Data without an iteration tag goes after all iterations
+		TArray<int32> DataIterations;
+		DataIterations.Init(MAX_int32, InOutTaggedData.Num());
+
+		TArray<FString> IterationTags;
+		for (int32 DataIndex = 0; DataIndex < InOutTaggedData.Num(); ++DataIndex)
+		{
+			IterationTags.Reset();
+
+			for (const FString& Tag : InOutTaggedData[DataIndex].Tags)
+			{
+				int32 IterationIndex = INDEX_NONE;
+				if (Tag.StartsWith(IterationTagPrefix, ESearchCase::CaseSensitive) && LexTryParseString(IterationIndex, *Tag.RightChop(IterationTagPrefix.Len())) && IterationIndex >= 0)
+				{
+					DataIterations[DataIndex] = FMath::Min(DataIterations[DataIndex], IterationIndex);
+					IterationTags.Add(Tag);
+				}
+			}
+
+			for (const FString& Tag : IterationTags)
+			{
+				InOutTaggedData[DataIndex].Tags.Remove(Tag);
+			}
+		}
+
+		TArray<int32> SortedIndices;
+		SortedIndices.Reserve(InOutTaggedData.Num());
+		for (int32 DataIndex = 0; DataIndex < InOutTaggedData.Num(); ++DataIndex)
+		{
+			SortedIndices.Add(DataIndex);
+		}
+
+		Algo::StableSortBy(SortedIndices, [&DataIterations](int32 DataIndex) { return DataIterations[DataIndex]; });
+
+		int32 NumUntaggedData = 0;
+		for (int32 DataIndex = SortedIndices.Num() - 1; DataIndex >= 0 && DataIterations[SortedIndices[DataIndex]] == MAX_int32; --DataIndex)
+		{
+			++NumUntaggedData;
+		}
+
+		TArray<FPCGTaggedData> SortedTaggedData;
+		SortedTaggedData.Reserve(InOutTaggedData.Num());
+		for (int32 DataIndex : SortedIndices)
+		{
+			SortedTaggedData.Add(MoveTemp(InOutTaggedData[DataIndex]));
+		}
+
+		InOutTaggedData = MoveTemp(SortedTaggedData);
+
+		return NumUntaggedData;
+	}
+}
+
 #if WITH_EDITOR
 FText UPCGLoopSettings::GetDefaultNodeTitle() const
 {
@@ -252,6 +325,71 @@ bool FPCGLoopElement::ExecuteInternal(FPCGContext* InContext) const
 		FPCGDataCollection FixedDataCollection;
 		PrepareSubgraphData(Settings, Context, FixedInputDataCollection, FixedDataCollection);
 
+		const bool bIsFeedbackLoop = !(FeedbackPinNames.IsEmpty());
+
+		if (Settings->bBatchIterations && bIsFeedbackLoop)
+		{
+			PCGE_LOG(Verbose, LogOnly, LOCTEXT("CannotBatchFeedbackLoop", "Iterations of a feedback loop depend on each other and cannot be batched - will execute each iteration separately."));
+		}
+		else if (Settings->bBatchIterations)
+		{
+			TRACE_CPUPROFILER_EVENT_SCOPE(FPCGLoopElement::ExecuteInternal::ScheduleBatched);
+
+			// The input of the single execution is the data of all iterations, tagged with their iteration, then the fixed data, used only once.
+			// The tag name is unique to this execution, the loop data may already carry the iteration tags of an enclosing batched loop.
+			const FString IterationTagName = PCGLoopHelpers::GetIterationTagName(Settings->IterationTag, Context->GetStack());
+
+			FPCGDataCollection InputDataCollection;
+			InputDataCollection.TaggedData.Reserve(NumberOfIterations * LoopDataCollection.Num() + FixedDataCollection.TaggedData.Num());
+
+			for (int EntryIndex = 0; EntryIndex < NumberOfIterations; ++EntryIndex)
+			{
+				const FString IterationTag = PCGLoopHelpers::GetIterationTag(IterationTagName, EntryIndex);
+
+				for (int LoopCollectionIndex = 0; LoopCollectionIndex < LoopDataCollection.Num(); ++LoopCollectionIndex)
+				{
+					FPCGTaggedData& IterationData = InputDataCollection.TaggedData.Add_GetRef(LoopDataCollection[LoopCollectionIndex].TaggedData[EntryIndex]);
+					IterationData.Tags.Add(IterationTag);
+				}
+			}
+
+			InputDataCollection.TaggedData.Append(FixedDataCollection.TaggedData);
+
+			// Prepare the invocation stack - which is the stack up to this node, and then this node and the 'not-a-loop index' since all iterations run in the same execution
+			const FPCGStack* Stack = Context->GetStack();
+			FPCGStack InvocationStack = ensure(Stack) ? *Stack : FPCGStack();
+
+			TArray<FPCGStackFrame>& StackFrames = InvocationStack.GetStackFramesMutable();
+			StackFrames.Reserve(StackFrames.Num() + 2);
+			StackFrames.Emplace(Context->Node);
+			StackFrames.Emplace(INDEX_NONE);
+
+			Context->AddToReferencedObjects(InputDataCollection);
+
+			FPCGTaskId SubgraphTaskId = Context->ScheduleGraph(FPCGScheduleGraphParams(
+				Subgraph,
+				Context->ExecutionSource.Get(),
+				PreGraphElement,
+				MakeShared<FPCGInputForwardingElement>(InputDataCollection),
+				/*Dependencies=*/{},
+				&InvocationStack,
+				/*bAllowHierarchicalGeneration=*/false));
+
+			if (SubgraphTaskId != InvalidPCGTaskId)
+			{
+				Context->SubgraphTaskIds.Add(SubgraphTaskId);
+				Context->bScheduledSubgraph = true;
+				Context->bIsPaused = true;
+				Context->DynamicDependencies.Add(SubgraphTaskId);
+				return false;
+			}
+			else
+			{
+				// Nothing to do
+				return true;
+			}
+		}
+
 		// If we execute more than once, it's the same as if we were using the data multiple times for fixed input.
 		if (NumberOfIterations > 1)
 		{
@@ -262,7 +400,6 @@ bool FPCGLoopElement::ExecuteInternal(FPCGContext* InContext) const
 		}
 
 		FPCGTaskId PreviousTaskId = InvalidPCGTaskId;
-		const bool bIsFeedbackLoop = !(FeedbackPinNames.IsEmpty());
 
 		// Dispatch the subgraph for each loop entries we have.
 		// Implementation note: even if the execution gets cancelled, these tasks would get cancelled because they are associated to the current source component
@@ -378,6 +515,21 @@ bool FPCGLoopElement::ExecuteInternal(FPCGContext* InContext) const
 			}
 		}
 
+		// A batched loop executed all iterations at once, split its output back per iteration
+		if (Settings->bBatchIterations && FeedbackPinNames.IsEmpty())
+		{
+			const FString IterationTagName = PCGLoopHelpers::GetIterationTagName(Settings->IterationTag, Context->GetStack());
+			const int32 NumUntaggedData = PCGLoopHelpers::SortByIterationAndRemoveTags(IterationTagName, Context->OutputData.TaggedData);
+
+			if (NumUntaggedData > 0)
+			{
+				PCGE_LOG(Warning, GraphAndLog, FText::Format(
+					LOCTEXT("BatchedOutputWithoutIteration", "{0} output data of the batched loop have no iteration tag ('{1}') and can't be split per iteration - they are output after all iterations. A node of the subgraph drops or replaces the tags of its inputs."),
+					NumUntaggedData,
+					FText::FromString(IterationTagName)));
+			}
+		}
+
 		return true;
 	}
 }
@@ -12,6 +12,8 @@
 #include "Metadata/Accessors/PCGAttributeAccessorKeys.h"
 #include "Metadata/Accessors/PCGAttributeExtractor.h"
 
+#include "Async/ParallelFor.h"
+
 #include "CollisionShape.h"
 #include "Chaos/GeometryQueries.h"
 #include "Chaos/ImplicitObject.h"
@@ -159,6 +161,151 @@ namespace PCGSelfPruningElement
 		return true;
 	}
 
+	/**
+	* Same result as DensityBoundsExclusion, computed on multiple threads.
+	* In the sequential pruning, a point is kept if and only if no point before it in the sorted order that overlaps it was kept.
+	* So a point can be decided as soon as all the overlapping points before it are decided: it is pruned if one of them is kept, kept otherwise.
+	* Each pass decides in parallel all the points that can be decided from the previous passes, and the first undecided point is always decided,
+	* so the result is exactly the one of the sequential pruning, whatever the scheduling. When the passes stop being efficient, the remaining points
+	* are decided in order on the calling thread.
+	*/
+	bool ParallelDensityBoundsExclusion(FIterationState& IterationState, FPCGContext* InOptionalContext)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(FPCGSelfPruningElement::Execute::ParallelDensityBoundsExclusion);
+
+		check(IterationState.InputData);
+		const PCGPointOctree::FPointOctree& Octree = IterationState.InputData->GetPointOctree();
+		const int32 NumPoints = IterationState.SortedPointRefs.Num();
+
+		// Below this number of undecided points, or if a pass decided less than 1 / MinPassEfficiency of them, finish sequentially.
+		static constexpr int32 MinPendingForParallelPass = 4096;
+		static constexpr int32 MinPassEfficiency = 8;
+
+		if (!IterationState.bParallelInitDone)
+		{
+			IterationState.PointRanks.SetNumUninitialized(NumPoints);
+			ParallelFor(NumPoints, [&IterationState](int32 SortedIndex)
+			{
+				IterationState.PointRanks[IterationState.SortedPointRefs[SortedIndex].Index] = SortedIndex;
+			});
+
+			IterationState.PointStates.Init(EPointPruningState::Undecided, NumPoints);
+
+			IterationState.PendingSortedIndices.SetNumUninitialized(NumPoints);
+			for (int32 SortedIndex = 0; SortedIndex < NumPoints; ++SortedIndex)
+			{
+				IterationState.PendingSortedIndices[SortedIndex] = SortedIndex;
+			}
+
+			IterationState.bParallelInitDone = true;
+
+			if (ShouldStop(InOptionalContext))
+			{
+				return false;
+			}
+		}
+
+		// Decides a point from the points before it that overlap it. Must only read states that are not written concurrently.
+		auto DecidePoint = [&IterationState, &Octree](int32 SortedIndex) -> EPointPruningState
+		{
+			const PCGPointOctree::FPointRef& PointRef = IterationState.SortedPointRefs[SortedIndex];
+			bool bHasUndecided = false;
+			bool bHasKept = false;
+
+			// Bounds intersection is symmetric, so the points found are exactly the ones that would have found this point when they were processed.
+			Octree.FindElementsWithBoundsTest(FBoxCenterAndExtent(PointRef.Bounds.Origin, PointRef.Bounds.BoxExtent), [&IterationState, SortedIndex, &bHasUndecided, &bHasKept](const PCGPointOctree::FPointRef& OtherPointRef)
+			{
+				if (bHasKept || IterationState.PointRanks[OtherPointRef.Index] >= SortedIndex)
+				{
+					return;
+				}
+
+				const EPointPruningState OtherState = IterationState.PointStates[OtherPointRef.Index];
+				bHasKept = (OtherState == EPointPruningState::Kept);
+				bHasUndecided |= (OtherState == EPointPruningState::Undecided);
+			});
+
+			return bHasKept ? EPointPruningState::Pruned : (bHasUndecided ? EPointPruningState::Undecided : EPointPruningState::Kept);
+		};
+
+		TArray<int32>& Pending = IterationState.PendingSortedIndices;
+		TArray<EPointPruningState> Decisions;
+		bool bFinishSequentially = false;
+
+		while (!bFinishSequentially && Pending.Num() >= MinPendingForParallelPass)
+		{
+			TRACE_CPUPROFILER_EVENT_SCOPE(FPCGSelfPruningElement::Execute::ParallelDensityBoundsExclusion::Pass);
+
+			// States are only read during the pass and written after it, so the decisions don't depend on the scheduling.
+			Decisions.SetNumUninitialized(Pending.Num(), EAllowShrinking::No);
+			ParallelFor(Pending.Num(), [&Pending, &Decisions, &DecidePoint](int32 PendingIndex)
+			{
+				Decisions[PendingIndex] = DecidePoint(Pending[PendingIndex]);
+			});
+
+			int32 NumStillPending = 0;
+			for (int32 PendingIndex = 0; PendingIndex < Pending.Num(); ++PendingIndex)
+			{
+				const int32 SortedIndex = Pending[PendingIndex];
+				if (Decisions[PendingIndex] == EPointPruningState::Undecided)
+				{
+					Pending[NumStillPending++] = SortedIndex;
+				}
+				else
+				{
+					IterationState.PointStates[IterationState.SortedPointRefs[SortedIndex].Index] = Decisions[PendingIndex];
+				}
+			}
+
+			bFinishSequentially = (Pending.Num() - NumStillPending) * MinPassEfficiency < Pending.Num();
+			Pending.SetNum(NumStillPending, EAllowShrinking::No);
+
+			if (ShouldStop(InOptionalContext))
+			{
+				return false;
+			}
+		}
+
+		// Remaining points are decided in order, all the points before each of them are decided at this point.
+		int32 CheckTimeSlicingCount = 0;
+		int32 NumDecided = 0;
+
+		for (; NumDecided < Pending.Num(); ++NumDecided)
+		{
+			if (++CheckTimeSlicingCount >= TimeSliceFrequencyCheck)
+			{
+				if (ShouldStop(InOptionalContext))
+				{
+					Pending.RemoveAt(0, NumDecided, EAllowShrinking::No);
+					return false;
+				}
+
+				CheckTimeSlicingCount = 0;
+			}
+
+			const int32 SortedIndex = Pending[NumDecided];
+			const EPointPruningState Decision = DecidePoint(SortedIndex);
+			check(Decision != EPointPruningState::Undecided);
+			IterationState.PointStates[IterationState.SortedPointRefs[SortedIndex].Index] = Decision;
+		}
+
+		Pending.Empty();
+
+		for (int32 PointIndex = 0; PointIndex < NumPoints; ++PointIndex)
+		{
+			if (IterationState.PointStates[PointIndex] == EPointPruningState::Kept)
+			{
+				IterationState.ExclusionPoints.Add(PointIndex);
+			}
+		}
+
+		IterationState.CurrentPointIndex = NumPoints;
+		IterationState.PointRanks.Empty();
+		IterationState.PointStates.Empty();
+
+		return true;
+	}
+
 	/** Self-pruning driven by use of collision shapes. Implementation is in practice just a secondary step after the octree query to filter out points if their collisions don`t intersect. */
 	bool CollisionExclusion(FIterationState& IterationState, FPCGContext* InOptionalContext, EPCGCollisionQueryFlag InCollisionQueryFlag)
 	{
@@ -684,6 +831,10 @@ PRAGMA_ENABLE_DEPRECATION_WARNINGS
 		{
 			bIsDone = PCGSelfPruningElement::CollisionExclusion(InState, InOptionalContext, InParameters.CollisionQueryFlag);
 		}
+		else if (InParameters.bParallelPruning)
+		{
+			bIsDone = PCGSelfPruningElement::ParallelDensityBoundsExclusion(InState, InOptionalContext);
+		}
 		else
 		{
 			bIsDone = PCGSelfPruningElement::DensityBoundsExclusion(InState, InOptionalContext);
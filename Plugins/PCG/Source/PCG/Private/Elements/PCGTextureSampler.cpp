@@ -311,6 +311,7 @@ bool FPCGTextureSamplerElement::ExecuteInternal(FPCGContext* InContext) const
 	BaseTextureData->bUseDensitySourceChannel = Settings->bUseDensitySourceChannel;
 	BaseTextureData->ColorChannel = Settings->ColorChannel;
 	BaseTextureData->Filter = Settings->Filter;
+	BaseTextureData->MipFilter = Settings->MipFilter;
 	BaseTextureData->TexelSize = Settings->TexelSize;
 	BaseTextureData->bUseAdvancedTiling = Settings->bUseAdvancedTiling;
 	BaseTextureData->Tiling = Settings->Tiling;
@@ -319,6 +320,12 @@ bool FPCGTextureSamplerElement::ExecuteInternal(FPCGContext* InContext) const
 	BaseTextureData->bUseTileBounds = Settings->bUseTileBounds;
 	BaseTextureData->TileBounds = FBox2D(Settings->TileBoundsMin, Settings->TileBoundsMax);
 
+	// Build the mip chain now rather than on the first coarse sample downstream.
+	if (BaseTextureData->MipFilter != EPCGTextureMipFilter::None && !Settings->bSkipReadbackToCPU)
+	{
+		BaseTextureData->BuildCPUMipChain();
+	}
+
 #if WITH_EDITOR
 	// If we have an override, register for dynamic tracking.
 	if (Context->IsValueOverriden(GET_MEMBER_NAME_CHECKED(UPCGTextureSamplerSettings, Texture)))
@@ -50,6 +50,11 @@ FPCGGraphCache::FPCGGraphCache()
 FPCGGraphCache::~FPCGGraphCache()
 {
 	ClearCache();
+
+	if (FPCGGraphDiskCache::IsEnabled())
+	{
+		DiskCache.LogStats();
+	}
 }
 
 bool FPCGGraphCache::GetFromCache(const FPCGGetFromCacheParams& Params, FPCGDataCollection& OutOutput) const
@@ -89,16 +94,50 @@ bool FPCGGraphCache::GetFromCache(const FPCGGetFromCacheParams& Params, FPCGData
 
 			return true;
 		}
-		else
+	}
+
+	// Loading from disk creates objects, so it is only done on the game thread, where it can't race with the GC.
+	const FPCGPersistentDependencies* PersistentDependencies = (InNode && Params.GetPersistentDependencies && FPCGGraphDiskCache::IsEnabled() && IsInGameThread())
+		? &Params.GetPersistentDependencies()
+		: nullptr;
+
+	if (PersistentDependencies && PersistentDependencies->IsValid())
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(FPCGGraphCache::GetFromDiskCache);
+
+		FPCGDataCollection DiskOutput;
+		if (DiskCache.Load(FPCGGraphDiskCache::MakeKey(InNode, InElement, PersistentDependencies->Crc), PersistentDependencies->InputCrcs, DiskOutput))
 		{
 			if (bDebuggingEnabled)
 			{
-				UE_LOG(LogPCG, Warning, TEXT("[%s] %s\t\tCACHE MISS %u"), *InExecutionSource->GetExecutionState().GetDebugName(), *InNode->GetNodeTitle(EPCGNodeTitleType::ListView).ToString(), InDependenciesCrc.GetValue());
+				UE_LOG(LogPCG, Log, TEXT("         [%s] %s\t\tDISK CACHE HIT %u"), *InExecutionSource->GetExecutionState().GetDebugName(), *InNode->GetNodeTitle(EPCGNodeTitleType::ListView).ToString(), InDependenciesCrc.GetValue());
+			}
+
+			// Promote to the memory cache, which also keeps the loaded data referenced.
+			{
+				FPCGGraphCache* MutableThis = const_cast<FPCGGraphCache*>(this);
+				UE::TScopeLock ScopedLock(CacheLock);
+
+				if (MutableThis->CacheData.Num() == MutableThis->CacheData.Max())
+				{
+					MutableThis->GrowCache_Unsafe();
+				}
+
+				MutableThis->AddToCacheInternal(FPCGCacheEntryKey(InElement, InDependenciesCrc), DiskOutput, /*bAddToMemory=*/true);
 			}
 
-			return false;
+			OutOutput = MoveTemp(DiskOutput);
+
+			return true;
 		}
 	}
+
+	if (bDebuggingEnabled)
+	{
+		UE_LOG(LogPCG, Warning, TEXT("[%s] %s\t\tCACHE MISS %u"), *InExecutionSource->GetExecutionState().GetDebugName(), *InNode->GetNodeTitle(EPCGNodeTitleType::ListView).ToString(), InDependenciesCrc.GetValue());
+	}
+
+	return false;
 }
 
 void FPCGGraphCache::StoreInCache(const FPCGStoreInCacheParams& Params, const FPCGDataCollection& InOutput)
@@ -134,6 +173,22 @@ void FPCGGraphCache::StoreInCache(const FPCGStoreInCacheParams& Params, const FP
 		const FPCGCacheEntryKey CacheKey(InElement, InDependenciesCrc);
 		AddToCacheInternal(CacheKey, InOutput, /*bAddToMemory=*/true);
 	}
+
+	if (Params.Node && Params.PersistentDependencies && Params.PersistentDependencies->IsValid() && FPCGGraphDiskCache::IsEnabled())
+	{
+		const FSHAHash DiskCacheKey = FPCGGraphDiskCache::MakeKey(Params.Node, InElement, Params.PersistentDependencies->Crc);
+
+		// Writing to disk duplicates the data, so it is deferred to the game thread (see FlushPendingDiskWrites).
+		if (IsInGameThread())
+		{
+			DiskCache.Store(DiskCacheKey, Params.PersistentDependencies->InputCrcs, InOutput);
+		}
+		else
+		{
+			UE::TScopeLock ScopedLock(CacheLock);
+			PendingDiskWrites.Add({ DiskCacheKey, Params.PersistentDependencies->InputCrcs, InOutput });
+		}
+	}
 }
 
 void FPCGGraphCache::ClearCache()
@@ -142,6 +197,35 @@ void FPCGGraphCache::ClearCache()
 
 	// Remove all entries
 	ClearCacheInternal(CacheData.Max(), /*bClearMemory=*/true);
+	PendingDiskWrites.Empty();
+}
+
+void FPCGGraphCache::FlushPendingDiskWrites(double InEndTime)
+{
+	check(IsInGameThread());
+
+	bool bFirstWrite = true;
+
+	while (bFirstWrite || FPlatformTime::Seconds() < InEndTime)
+	{
+		FPendingDiskWrite PendingWrite;
+
+		{
+			UE::TScopeLock ScopedLock(CacheLock);
+			if (PendingDiskWrites.IsEmpty())
+			{
+				break;
+			}
+
+			// Keep the data referenced until it is written, GC can't run in the meantime on the game thread.
+			PendingWrite = MoveTemp(PendingDiskWrites[0]);
+			PendingDiskWrites.RemoveAt(0);
+		}
+
+		TRACE_CPUPROFILER_EVENT_SCOPE(FPCGGraphCache::FlushPendingDiskWrites);
+		DiskCache.Store(PendingWrite.Key, PendingWrite.InputCrcs, PendingWrite.Collection);
+		bFirstWrite = false;
+	}
 }
 
 bool FPCGGraphCache::EnforceMemoryBudget()
@@ -231,6 +315,11 @@ void FPCGGraphCache::AddReferencedObjects(FReferenceCollector& Collector)
 	{
 		CacheEntry.AddReferences(Collector);
 	}
+
+	for (FPendingDiskWrite& PendingWrite : PendingDiskWrites)
+	{
+		PendingWrite.Collection.AddReferences(Collector);
+	}
 }
 
 void FPCGGraphCache::ValidateElementToCacheEntryKeys() const
@@ -5,6 +5,7 @@
 #include "PCGCrc.h"
 #include "PCGData.h"
 #include "Graph/IPCGGraphCache.h"
+#include "Graph/PCGGraphDiskCache.h"
 
 #include "Containers/LruCache.h"
 #include "Misc/SpinLock.h"
@@ -69,15 +70,18 @@ public:
 	FPCGGraphCache();
 	~FPCGGraphCache();
 
-	/** Returns true if data was found from the cache, in which case the outputs are written in OutOutput. InNode is optional and for logging only. */
+	/** Returns true if data was found from the cache, in which case the outputs are written in OutOutput. Falls back on the disk cache when a persistent Crc is provided. */
 	virtual bool GetFromCache(const FPCGGetFromCacheParams& Params, FPCGDataCollection& OutCollection) const override;
 
-	/** Stores data in the cache for later use */
+	/** Stores data in the cache for later use, and in the disk cache when a node and a persistent Crc are provided. */
 	virtual void StoreInCache(const FPCGStoreInCacheParams& Params, const FPCGDataCollection& InCollection) override;
 
-	/** Removes all entries from the cache, unroots data, etc. */
+	/** Removes all entries from the cache, unroots data, etc. The disk cache is kept ('pcg.Cache.Disk.Clear' deletes it). */
 	void ClearCache();
 
+	/** Writes results stored from other threads to the disk cache, until InEndTime is reached (at least one). Game thread only. */
+	void FlushPendingDiskWrites(double InEndTime);
+
 	/** While memory usage is more than budget, remove cache entries for elements, LRU policy. Returns true if something removed. */
 	bool EnforceMemoryBudget();
 
@@ -120,6 +124,19 @@ private:
 	/** Map from data UIDs to records. Provides ref counting and caches memory size. */
 	TMap<uint64, FCachedMemoryRecord> MemoryRecords;
 
+	/** Second tier, keyed by node and persistent Crc. Only accessed from the game thread. */
+	mutable FPCGGraphDiskCache DiskCache;
+
+	struct FPendingDiskWrite
+	{
+		FSHAHash Key;
+		TArray<FPCGCrc> InputCrcs;
+		FPCGDataCollection Collection;
+	};
+
+	/** Results stored from other threads, waiting to be written to the disk cache. */
+	TArray<FPendingDiskWrite> PendingDiskWrites;
+
 	/** Total memory usage by all data objects in cache. */
 	uint64 TotalMemoryUsed = 0;
 
@@ -17,6 +17,7 @@
 #include "Graph/PCGGraphExecutor.h"
 #include "Graph/PCGPinDependencyExpression.h"
 
+#include "Algo/AnyOf.h"
 #include "HAL/IConsoleManager.h"
 #include "Misc/ScopeRWLock.h"
 
@@ -1063,6 +1064,89 @@ bool FPCGGraphCompiler::VisitTasksInExecutionOrder(const TArray<FPCGGraphTask>&
 	return true;
 }
 
+void FPCGGraphCompiler::ComputeSchedulingHints(TArray<FPCGGraphTask>& InOutCompiledTasks)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FPCGGraphCompiler::ComputeSchedulingHints);
+
+	const int32 NumTasks = InOutCompiledTasks.Num();
+
+	// Count the edges going out of each task. A task is visited once all its successors were visited, starting from the end of the graph.
+	TArray<int32> NumUnvisitedSuccessorEdges;
+	NumUnvisitedSuccessorEdges.SetNumZeroed(NumTasks);
+
+	for (int32 TaskIndex = 0; TaskIndex < NumTasks; ++TaskIndex)
+	{
+		if (!ensure(InOutCompiledTasks[TaskIndex].NodeId == FPCGTaskId(TaskIndex)))
+		{
+			// Hints are only an optimization, tasks without them are scheduled as before.
+			return;
+		}
+	}
+
+	for (FPCGGraphTask& Task : InOutCompiledTasks)
+	{
+		Task.CriticalPathLength = 0;
+		Task.NumSuccessors = 0;
+	}
+
+	for (int32 TaskIndex = 0; TaskIndex < NumTasks; ++TaskIndex)
+	{
+		const TArray<FPCGGraphTaskInput>& Inputs = InOutCompiledTasks[TaskIndex].Inputs;
+		for (int32 InputIndex = 0; InputIndex < Inputs.Num(); ++InputIndex)
+		{
+			const FPCGTaskId InputTaskId = Inputs[InputIndex].TaskId;
+			if (!InOutCompiledTasks.IsValidIndex(InputTaskId))
+			{
+				continue;
+			}
+
+			++NumUnvisitedSuccessorEdges[InputTaskId];
+
+			// Same task can be connected through multiple pins, only count it once as a successor.
+			const bool bIsFirstEdgeFromInput = !Algo::AnyOf(MakeArrayView(Inputs.GetData(), InputIndex), [InputTaskId](const FPCGGraphTaskInput& PreviousInput) { return PreviousInput.TaskId == InputTaskId; });
+			if (bIsFirstEdgeFromInput)
+			{
+				++InOutCompiledTasks[InputTaskId].NumSuccessors;
+			}
+		}
+	}
+
+	TArray<FPCGTaskId> TasksToVisit;
+	TasksToVisit.Reserve(NumTasks);
+
+	for (int32 TaskIndex = 0; TaskIndex < NumTasks; ++TaskIndex)
+	{
+		if (NumUnvisitedSuccessorEdges[TaskIndex] == 0)
+		{
+			TasksToVisit.Add(TaskIndex);
+		}
+	}
+
+	// Critical path length is only final once all successors were visited, which holds since the graph is acyclic.
+	// Before that, it holds the longest path found so far through the visited successors.
+	while (!TasksToVisit.IsEmpty())
+	{
+		FPCGGraphTask& Task = InOutCompiledTasks[TasksToVisit.Pop(EAllowShrinking::No)];
+		++Task.CriticalPathLength;
+
+		for (const FPCGGraphTaskInput& Input : Task.Inputs)
+		{
+			if (!InOutCompiledTasks.IsValidIndex(Input.TaskId))
+			{
+				continue;
+			}
+
+			FPCGGraphTask& InputTask = InOutCompiledTasks[Input.TaskId];
+			InputTask.CriticalPathLength = FMath::Max(InputTask.CriticalPathLength, Task.CriticalPathLength);
+
+			if (--NumUnvisitedSuccessorEdges[Input.TaskId] == 0)
+			{
+				TasksToVisit.Add(Input.TaskId);
+			}
+		}
+	}
+}
+
 void FPCGGraphCompiler::PostCullStackCleanup(TArray<FPCGGraphTask>& InCompiledTasks, FPCGStackContext& InOutStackContext)
 {
 	// Build set of stack IDs used by tasks. Using array as set is likely small.
@@ -1490,6 +1574,9 @@ void FPCGGraphCompiler::CompileTopGraph(UPCGGraph* InGraph, uint32 GenerationGri
 		}
 	}
 
+	// Task list is final, attach the hints the executor uses to launch tasks on long chains first.
+	ComputeSchedulingHints(CompiledTasks);
+
 	// Store back the results in the cache
 	Cache.GraphToTaskMapLock.WriteLock();
 	TMap<uint32, TArray<FPCGGraphTask>>& TasksPerGenerationGrid = Cache.TopGraphToTaskMap.FindOrAdd(InGraph);
@@ -100,6 +100,9 @@ public:
 	* Returns true if all tasks visited. */
 	static bool VisitTasksInExecutionOrder(const TArray<FPCGGraphTask>& InTasks, const TMap<FPCGTaskId, TArray<FPCGTaskId>>& InTaskToTaskSuccessors, const TFunction<bool(FPCGTaskId)>& InVisitor);
 
+	/** Computes the scheduling hints (critical path length, successor count) of compiled tasks, where task ids are indices in the array. */
+	static void ComputeSchedulingHints(TArray<FPCGGraphTask>& InOutCompiledTasks);
+
 private:
 	TArray<FPCGGraphTask> CompileGraph(UPCGGraph* InGraph, FPCGTaskId& NextId, FPCGStackContext& InOutStackContext);
 
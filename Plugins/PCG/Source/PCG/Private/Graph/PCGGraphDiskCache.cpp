@@ -0,0 +1,619 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Graph/PCGGraphDiskCache.h"
+
+#include "PCGCustomVersion.h"
+#include "PCGData.h"
+#include "PCGElement.h"
+#include "PCGModule.h"
+#include "PCGNode.h"
+#include "PCGParamData.h"
+#include "PCGSettings.h"
+
+#include "Algo/StableSort.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/PackageName.h"
+#include "Misc/ScopeLock.h"
+#include "Modules/ModuleManager.h"
+#include "Misc/EngineVersion.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/CustomVersion.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/ObjectAndNameAsStringProxyArchive.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectHash.h"
+
+static TAutoConsoleVariable<bool> CVarDiskCacheEnabled(
+	TEXT("pcg.Cache.Disk.Enabled"),
+	false,
+	TEXT("Enables the disk cache, which keeps the results of cacheable nodes across sessions."));
+
+static TAutoConsoleVariable<int32> CVarDiskCacheBudgetMB(
+	TEXT("pcg.Cache.Disk.BudgetMB"),
+	4096,
+	TEXT("Size budget of the disk cache (MB). Least recently used entries are removed when it is exceeded."));
+
+static TAutoConsoleVariable<FString> CVarDiskCachePath(
+	TEXT("pcg.Cache.Disk.Path"),
+	TEXT(""),
+	TEXT("Directory of the disk cache. Empty to use <ProjectSaved>/PCG/GraphCache."));
+
+static FAutoConsoleCommand CommandClearDiskCache(
+	TEXT("pcg.Cache.Disk.Clear"),
+	TEXT("Deletes all entries of the disk cache. Entries known by running executors are dropped when they fail to load."),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		IFileManager::Get().DeleteDirectory(*FPCGGraphDiskCache::GetCacheDirectory(), /*bRequireExists=*/false, /*bTree=*/true);
+	}));
+
+namespace PCGGraphDiskCache
+{
+	// Bump when the file layout changes. It is part of the key, so entries written with another version are never found.
+	constexpr uint32 FormatVersion = 2;
+	constexpr uint32 FileMagic = 0x50434743; // 'PCGC'
+	const TCHAR* FileExtension = TEXT(".pcgcache");
+
+	// Evict down to a ratio of the budget, so that a full cache doesn't evict on every write.
+	constexpr double EvictionTargetRatio = 0.9;
+
+	struct FObjectRecord
+	{
+		FString ClassPath;
+		FString Name;
+		int32 OuterIndex = INDEX_NONE;
+
+		friend FArchive& operator<<(FArchive& Ar, FObjectRecord& Record)
+		{
+			return Ar << Record.ClassPath << Record.Name << Record.OuterIndex;
+		}
+	};
+
+	/** Writes references to objects of the entry as indices, and references to any other object as paths. */
+	class FObjectWriter : public FObjectAndNameAsStringProxyArchive
+	{
+	public:
+		FObjectWriter(FArchive& InInnerArchive, const TMap<const UObject*, int32>& InLocalObjects)
+			: FObjectAndNameAsStringProxyArchive(InInnerArchive, /*bInLoadIfFindFails=*/false)
+			, LocalObjects(InLocalObjects)
+		{
+		}
+
+		virtual FArchive& operator<<(UObject*& Obj) override
+		{
+			const int32* FoundIndex = Obj ? LocalObjects.Find(Obj) : nullptr;
+			int32 LocalIndex = FoundIndex ? *FoundIndex : INDEX_NONE;
+			InnerArchive << LocalIndex;
+
+			if (LocalIndex == INDEX_NONE)
+			{
+				FString Path = Obj ? Obj->GetPathName() : FString();
+				InnerArchive << Path;
+			}
+
+			return *this;
+		}
+
+		virtual FArchive& operator<<(FObjectPtr& Obj) override
+		{
+			UObject* Object = Obj.Get();
+			return *this << Object;
+		}
+
+	private:
+		const TMap<const UObject*, int32>& LocalObjects;
+	};
+
+	/** Reads references written by FObjectWriter. Objects outside of the entry are only found, never loaded, and missing ones are reported. */
+	class FObjectReader : public FObjectAndNameAsStringProxyArchive
+	{
+	public:
+		FObjectReader(FArchive& InInnerArchive, TConstArrayView<UObject*> InLocalObjects)
+			: FObjectAndNameAsStringProxyArchive(InInnerArchive, /*bInLoadIfFindFails=*/false)
+			, LocalObjects(InLocalObjects)
+		{
+		}
+
+		virtual FArchive& operator<<(UObject*& Obj) override
+		{
+			int32 LocalIndex = INDEX_NONE;
+			InnerArchive << LocalIndex;
+
+			if (LocalIndex != INDEX_NONE)
+			{
+				Obj = LocalObjects.IsValidIndex(LocalIndex) ? LocalObjects[LocalIndex] : nullptr;
+				bHasUnresolvedReferences |= (Obj == nullptr);
+			}
+			else
+			{
+				FString Path;
+				InnerArchive << Path;
+				Obj = Path.IsEmpty() ? nullptr : FindObject<UObject>(nullptr, *Path);
+				bHasUnresolvedReferences |= (!Path.IsEmpty() && !Obj);
+			}
+
+			return *this;
+		}
+
+		virtual FArchive& operator<<(FObjectPtr& Obj) override
+		{
+			UObject* Object = nullptr;
+			*this << Object;
+			Obj = Object;
+			return *this;
+		}
+
+		bool bHasUnresolvedReferences = false;
+
+	private:
+		TConstArrayView<UObject*> LocalObjects;
+	};
+
+	/**
+	* Identifies the build of the module implementing the node settings, from the size and time stamp of its binary (or of the executable in monolithic builds).
+	* The engine changelist alone is 0 in local builds, so it doesn't change when the code of an element does.
+	*/
+	FString GetModuleBuildStamp(const UPCGNode* InNode)
+	{
+		static FCriticalSection BuildStampsLock;
+		static TMap<FName, FString> BuildStamps;
+
+		const UPCGSettings* Settings = InNode->GetSettings();
+		const FName ModuleName = Settings ? FName(FPackageName::GetShortName(Settings->GetClass()->GetPackage())) : NAME_None;
+
+		FScopeLock ScopeLock(&BuildStampsLock);
+
+		if (const FString* BuildStamp = BuildStamps.Find(ModuleName))
+		{
+			return *BuildStamp;
+		}
+
+		FString Filename = ModuleName.IsNone() ? FString() : FModuleManager::Get().GetModuleFilename(ModuleName);
+		if (Filename.IsEmpty())
+		{
+			Filename = FPlatformProcess::ExecutablePath();
+		}
+
+		const FFileStatData StatData = IFileManager::Get().GetStatData(*Filename);
+		return BuildStamps.Add(ModuleName, FString::Printf(TEXT("%s|%lld|%lld"), *ModuleName.ToString(), StatData.FileSize, StatData.ModificationTime.GetTicks()));
+	}
+
+	bool InputCrcsMatch(TConstArrayView<uint32> InStoredCrcValues, TConstArrayView<FPCGCrc> InInputCrcs)
+	{
+		if (InStoredCrcValues.Num() != InInputCrcs.Num())
+		{
+			return false;
+		}
+
+		for (int32 InputIndex = 0; InputIndex < InInputCrcs.Num(); ++InputIndex)
+		{
+			if (!InInputCrcs[InputIndex].IsValid() || InInputCrcs[InputIndex].GetValue() != InStoredCrcValues[InputIndex])
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	/** Appends the data and all its inner objects, outers first. */
+	void GatherObjects(const UPCGData* InData, TArray<const UObject*>& OutObjects, TMap<const UObject*, int32>& OutObjectToIndex)
+	{
+		const int32 RootIndex = OutObjects.Num();
+		OutObjects.Add(InData);
+		OutObjectToIndex.Add(InData, RootIndex);
+
+		TArray<UObject*> InnerObjects;
+		GetObjectsWithOuter(InData, InnerObjects, /*bIncludeNestedObjects=*/true);
+
+		auto GetDepth = [InData](const UObject* Object)
+		{
+			int32 Depth = 0;
+			for (const UObject* Outer = Object; Outer && Outer != InData; Outer = Outer->GetOuter())
+			{
+				++Depth;
+			}
+
+			return Depth;
+		};
+
+		Algo::StableSortBy(InnerObjects, GetDepth);
+
+		for (const UObject* InnerObject : InnerObjects)
+		{
+			OutObjectToIndex.Add(InnerObject, OutObjects.Num());
+			OutObjects.Add(InnerObject);
+		}
+	}
+}
+
+bool FPCGGraphDiskCache::IsEnabled()
+{
+	return CVarDiskCacheEnabled.GetValueOnAnyThread();
+}
+
+bool FPCGGraphDiskCache::CanPersist(const UPCGData* InData)
+{
+	// Data with a full data Crc is fully described by its content. Param data Crc is always computed from its content.
+	return InData && (InData->SupportsFullDataCrc() || InData->GetClass() == UPCGParamData::StaticClass());
+}
+
+FSHAHash FPCGGraphDiskCache::MakeKey(const UPCGNode* InNode, const IPCGElement* InElement, const FPCGCrc& InPersistentCrc)
+{
+	check(InNode && InPersistentCrc.IsValid());
+
+	// Results of the same node can change with the code, so also key on the versions.
+	FString KeyString = FString::Printf(TEXT("%s|%u|%u|%d|%u|%u|%s"),
+		*InNode->GetPathName(),
+		InPersistentCrc.GetValue(),
+		PCGGraphDiskCache::FormatVersion,
+		static_cast<int32>(FPCGCustomVersion::LatestVersion),
+		FEngineVersion::Current().GetChangelist(),
+		InElement ? InElement->GetPersistentCacheVersion() : 0u,
+		*PCGGraphDiskCache::GetModuleBuildStamp(InNode));
+
+	FSHAHash Key;
+	FSHA1::HashBuffer(*KeyString, KeyString.Len() * sizeof(TCHAR), Key.Hash);
+	return Key;
+}
+
+bool FPCGGraphDiskCache::Load(const FSHAHash& InKey, TConstArrayView<FPCGCrc> InInputCrcs, FPCGDataCollection& OutCollection)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FPCGGraphDiskCache::Load);
+	check(IsInGameThread());
+
+	Initialize();
+
+	FEntry* Entry = Entries.Find(InKey);
+	if (!Entry)
+	{
+		++Stats.Misses;
+		return false;
+	}
+
+	TArray<uint8> Bytes;
+	bool bSuccess = FFileHelper::LoadFileToArray(Bytes, *GetEntryFilename(InKey), FILEREAD_Silent);
+
+	if (bSuccess)
+	{
+		FMemoryReader Reader(Bytes, /*bIsPersistent=*/true);
+		// Versions are part of the key, so the entry was written with the current ones.
+		Reader.SetCustomVersions(FCurrentCustomVersions::GetAll());
+
+		uint32 Magic = 0;
+		FSHAHash Key;
+		TArray<uint32> InputCrcValues;
+		TArray<PCGGraphDiskCache::FObjectRecord> Records;
+		Reader << Magic << Key;
+
+		bSuccess = Magic == PCGGraphDiskCache::FileMagic && Key == InKey;
+		if (bSuccess)
+		{
+			Reader << InputCrcValues;
+			bSuccess = !Reader.IsError();
+		}
+
+		// Same combined Crc, but not the same inputs: a collision, the entry was written for other inputs. Remove it so the new results can be stored.
+		if (bSuccess && !PCGGraphDiskCache::InputCrcsMatch(InputCrcValues, InInputCrcs))
+		{
+			UE_LOG(LogPCG, Verbose, TEXT("Graph disk cache entry '%s' was written for other inputs, removing it."), *InKey.ToString());
+			RemoveEntry(InKey);
+			++Stats.Misses;
+			++Stats.Collisions;
+			return false;
+		}
+
+		if (bSuccess)
+		{
+			Reader << Records;
+			bSuccess = !Reader.IsError();
+		}
+
+		// Create all the objects first, so that references between them can be resolved.
+		TArray<UObject*> Objects;
+		for (int32 RecordIndex = 0; bSuccess && RecordIndex < Records.Num(); ++RecordIndex)
+		{
+			const PCGGraphDiskCache::FObjectRecord& Record = Records[RecordIndex];
+			UClass* Class = FindObject<UClass>(nullptr, *Record.ClassPath);
+			UObject* Outer = Record.OuterIndex == INDEX_NONE ? GetTransientPackage() : (Objects.IsValidIndex(Record.OuterIndex) ? Objects[Record.OuterIndex] : nullptr);
+			if (!Class || !Outer || (Record.OuterIndex == INDEX_NONE && !Class->IsChildOf<UPCGData>()))
+			{
+				bSuccess = false;
+				break;
+			}
+
+			// Default subobjects already exist when their outer is created.
+			UObject* Object = Record.Name.IsEmpty() ? nullptr : StaticFindObjectFast(Class, Outer, FName(*Record.Name), /*bExactClass=*/true);
+			if (!Object)
+			{
+				Object = NewObject<UObject>(Outer, Class, Record.Name.IsEmpty() ? NAME_None : FName(*Record.Name));
+			}
+
+			Objects.Add(Object);
+		}
+
+		if (bSuccess)
+		{
+			PCGGraphDiskCache::FObjectReader ObjectReader(Reader, Objects);
+
+			for (UObject* Object : Objects)
+			{
+				Object->Serialize(ObjectReader);
+			}
+
+			int32 NumTaggedData = 0;
+			ObjectReader << NumTaggedData;
+			bSuccess = !ObjectReader.IsError() && NumTaggedData >= 0;
+
+			for (int32 TaggedDataIndex = 0; bSuccess && TaggedDataIndex < NumTaggedData; ++TaggedDataIndex)
+			{
+				int32 ObjectIndex = INDEX_NONE;
+				FPCGTaggedData& TaggedData = OutCollection.TaggedData.Emplace_GetRef();
+				ObjectReader << ObjectIndex << TaggedData.Tags << TaggedData.Pin << TaggedData.bPinlessData;
+
+				if (ObjectIndex != INDEX_NONE)
+				{
+					TaggedData.Data = Objects.IsValidIndex(ObjectIndex) ? Cast<UPCGData>(Objects[ObjectIndex]) : nullptr;
+					bSuccess = (TaggedData.Data != nullptr);
+				}
+			}
+
+			ObjectReader << OutCollection.bCancelExecutionOnEmpty << OutCollection.InactiveOutputPinBitmask;
+			bSuccess &= !ObjectReader.IsError() && !ObjectReader.bHasUnresolvedReferences;
+		}
+	}
+
+	if (!bSuccess)
+	{
+		// Objects created so far are not referenced and will be collected.
+		UE_LOG(LogPCG, Verbose, TEXT("Graph disk cache entry '%s' could not be read, removing it."), *InKey.ToString());
+		OutCollection.Reset();
+		RemoveEntry(InKey);
+		++Stats.Misses;
+		return false;
+	}
+
+	OutCollection.ComputeCrcs(/*bFullDataCrc=*/false);
+
+	Entry->LastAccessTime = FDateTime::UtcNow();
+	++Stats.Hits;
+
+	return true;
+}
+
+void FPCGGraphDiskCache::Store(const FSHAHash& InKey, TConstArrayView<FPCGCrc> InInputCrcs, const FPCGDataCollection& InCollection)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FPCGGraphDiskCache::Store);
+	check(IsInGameThread());
+
+	for (const FPCGTaggedData& TaggedData : InCollection.TaggedData)
+	{
+		if (TaggedData.Data && !CanPersist(TaggedData.Data))
+		{
+			++Stats.RejectedWrites;
+			return;
+		}
+	}
+
+	Initialize();
+
+	if (Entries.Contains(InKey))
+	{
+		return;
+	}
+
+	// Write flattened copies, metadata and properties inherited from other data would not be found when reading back.
+	// The copies are not referenced, they will be collected.
+	TArray<const UObject*> Objects;
+	TMap<const UObject*, int32> ObjectToIndex;
+	TMap<const UPCGData*, int32> DataToObjectIndex;
+
+	for (const FPCGTaggedData& TaggedData : InCollection.TaggedData)
+	{
+		if (!TaggedData.Data || DataToObjectIndex.Contains(TaggedData.Data))
+		{
+			continue;
+		}
+
+		UPCGData* DataCopy = TaggedData.Data->DuplicateData(/*Context=*/nullptr);
+		if (!DataCopy)
+		{
+			++Stats.RejectedWrites;
+			return;
+		}
+
+		DataCopy->Flatten();
+
+		DataToObjectIndex.Add(TaggedData.Data, Objects.Num());
+		PCGGraphDiskCache::GatherObjects(DataCopy, Objects, ObjectToIndex);
+	}
+
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes, /*bIsPersistent=*/true);
+
+	uint32 Magic = PCGGraphDiskCache::FileMagic;
+	FSHAHash Key = InKey;
+	Writer << Magic << Key;
+
+	TArray<uint32> InputCrcValues;
+	InputCrcValues.Reserve(InInputCrcs.Num());
+	for (const FPCGCrc& InputCrc : InInputCrcs)
+	{
+		InputCrcValues.Add(InputCrc.GetValue());
+	}
+
+	Writer << InputCrcValues;
+
+	TArray<PCGGraphDiskCache::FObjectRecord> Records;
+	Records.Reserve(Objects.Num());
+	for (const UObject* Object : Objects)
+	{
+		PCGGraphDiskCache::FObjectRecord& Record = Records.Emplace_GetRef();
+		Record.ClassPath = Object->GetClass()->GetPathName();
+
+		if (const int32* OuterIndex = ObjectToIndex.Find(Object->GetOuter()))
+		{
+			Record.OuterIndex = *OuterIndex;
+			Record.Name = Object->GetName();
+		}
+	}
+
+	Writer << Records;
+
+	PCGGraphDiskCache::FObjectWriter ObjectWriter(Writer, ObjectToIndex);
+
+	for (const UObject* Object : Objects)
+	{
+		const_cast<UObject*>(Object)->Serialize(ObjectWriter);
+	}
+
+	int32 NumTaggedData = InCollection.TaggedData.Num();
+	ObjectWriter << NumTaggedData;
+
+	for (const FPCGTaggedData& TaggedData : InCollection.TaggedData)
+	{
+		int32 ObjectIndex = TaggedData.Data ? DataToObjectIndex.FindChecked(TaggedData.Data) : INDEX_NONE;
+		ObjectWriter << ObjectIndex << const_cast<TSet<FString>&>(TaggedData.Tags) << const_cast<FName&>(TaggedData.Pin) << const_cast<bool&>(TaggedData.bPinlessData);
+	}
+
+	bool bCancelExecutionOnEmpty = InCollection.bCancelExecutionOnEmpty;
+	uint64 InactiveOutputPinBitmask = InCollection.InactiveOutputPinBitmask;
+	ObjectWriter << bCancelExecutionOnEmpty << InactiveOutputPinBitmask;
+
+	// Write to a temporary file first, so that a partially written entry is never read.
+	const FString Filename = GetEntryFilename(InKey);
+	const FString TempFilename = Filename + TEXT(".tmp");
+	const bool bSuccess = !ObjectWriter.IsError()
+		&& FFileHelper::SaveArrayToFile(Bytes, *TempFilename)
+		&& IFileManager::Get().Move(*Filename, *TempFilename, /*bReplace=*/true, /*bEvenIfReadOnly=*/true, /*bAttributes=*/false, /*bDoNotRetryOrError=*/true);
+
+	if (!bSuccess)
+	{
+		IFileManager::Get().Delete(*TempFilename, /*bRequireExists=*/false, /*bEvenReadOnly=*/true, /*bQuiet=*/true);
+		++Stats.RejectedWrites;
+		return;
+	}
+
+	FEntry& Entry = Entries.Add(InKey);
+	Entry.SizeInBytes = Bytes.Num();
+	Entry.LastAccessTime = FDateTime::UtcNow();
+	Stats.SizeInBytes += Entry.SizeInBytes;
+	Stats.NumEntries = Entries.Num();
+	++Stats.Writes;
+
+	EnforceBudget();
+}
+
+void FPCGGraphDiskCache::Clear()
+{
+	IFileManager::Get().DeleteDirectory(*GetCacheDirectory(), /*bRequireExists=*/false, /*bTree=*/true);
+	Entries.Reset();
+	Stats.NumEntries = 0;
+	Stats.SizeInBytes = 0;
+	bInitialized = true;
+}
+
+void FPCGGraphDiskCache::LogStats() const
+{
+	const uint64 NumLookups = Stats.Hits + Stats.Misses;
+
+	UE_LOG(LogPCG, Log, TEXT("Graph disk cache: %llu hits, %llu misses (%.1f%% hit rate, %llu input mismatches), %llu writes, %llu rejected writes, %llu evictions, %d entries (%.1f MB)."),
+		Stats.Hits,
+		Stats.Misses,
+		NumLookups > 0 ? 100.0 * Stats.Hits / NumLookups : 0.0,
+		Stats.Collisions,
+		Stats.Writes,
+		Stats.RejectedWrites,
+		Stats.Evictions,
+		Stats.NumEntries,
+		Stats.SizeInBytes / (1024.0 * 1024.0));
+}
+
+void FPCGGraphDiskCache::Initialize()
+{
+	if (bInitialized)
+	{
+		return;
+	}
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(FPCGGraphDiskCache::Initialize);
+	bInitialized = true;
+
+	IFileManager::Get().IterateDirectoryStatRecursively(*GetCacheDirectory(), [this](const TCHAR* InFilenameOrDirectory, const FFileStatData& InStatData)
+	{
+		const FString Filename(InFilenameOrDirectory);
+		if (InStatData.bIsDirectory || !Filename.EndsWith(PCGGraphDiskCache::FileExtension))
+		{
+			return true;
+		}
+
+		FSHAHash Key;
+		Key.FromString(FPaths::GetBaseFilename(Filename));
+
+		FEntry& Entry = Entries.Add(Key);
+		Entry.SizeInBytes = InStatData.FileSize;
+		Entry.LastAccessTime = InStatData.AccessTime != FDateTime::MinValue() ? InStatData.AccessTime : InStatData.ModificationTime;
+		Stats.SizeInBytes += Entry.SizeInBytes;
+
+		return true;
+	});
+
+	Stats.NumEntries = Entries.Num();
+
+	EnforceBudget();
+}
+
+void FPCGGraphDiskCache::EnforceBudget()
+{
+	const int64 Budget = static_cast<int64>(FMath::Max(0, CVarDiskCacheBudgetMB.GetValueOnAnyThread())) * 1024 * 1024;
+	if (Stats.SizeInBytes <= Budget)
+	{
+		return;
+	}
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(FPCGGraphDiskCache::EnforceBudget);
+
+	TArray<TPair<FSHAHash, FDateTime>> EntriesByAccessTime;
+	EntriesByAccessTime.Reserve(Entries.Num());
+	for (const TPair<FSHAHash, FEntry>& Entry : Entries)
+	{
+		EntriesByAccessTime.Emplace(Entry.Key, Entry.Value.LastAccessTime);
+	}
+
+	EntriesByAccessTime.Sort([](const TPair<FSHAHash, FDateTime>& A, const TPair<FSHAHash, FDateTime>& B) { return A.Value < B.Value; });
+
+	const int64 TargetSize = static_cast<int64>(Budget * PCGGraphDiskCache::EvictionTargetRatio);
+	for (int32 EntryIndex = 0; EntryIndex < EntriesByAccessTime.Num() && Stats.SizeInBytes > TargetSize; ++EntryIndex)
+	{
+		RemoveEntry(EntriesByAccessTime[EntryIndex].Key);
+		++Stats.Evictions;
+	}
+}
+
+void FPCGGraphDiskCache::RemoveEntry(const FSHAHash& InKey)
+{
+	FEntry Entry;
+	if (Entries.RemoveAndCopyValue(InKey, Entry))
+	{
+		Stats.SizeInBytes -= Entry.SizeInBytes;
+		Stats.NumEntries = Entries.Num();
+	}
+
+	IFileManager::Get().Delete(*GetEntryFilename(InKey), /*bRequireExists=*/false, /*bEvenReadOnly=*/true, /*bQuiet=*/true);
+}
+
+FString FPCGGraphDiskCache::GetCacheDirectory()
+{
+	const FString Path = CVarDiskCachePath.GetValueOnAnyThread();
+	return Path.IsEmpty() ? FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("PCG"), TEXT("GraphCache")) : Path;
+}
+
+FString FPCGGraphDiskCache::GetEntryFilename(const FSHAHash& InKey)
+{
+	// Spread entries over sub directories, to keep directories small.
+	const FString KeyString = InKey.ToString();
+	return FPaths::Combine(GetCacheDirectory(), KeyString.Left(2), KeyString + PCGGraphDiskCache::FileExtension);
+}
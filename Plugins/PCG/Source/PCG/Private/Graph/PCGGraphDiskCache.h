@@ -0,0 +1,90 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "PCGCrc.h"
+
+#include "Misc/DateTime.h"
+#include "Misc/SecureHash.h"
+
+class IPCGElement;
+class UPCGData;
+class UPCGNode;
+struct FPCGDataCollection;
+
+/**
+* Second tier of the graph cache, persisted on disk so results survive editor restarts.
+* Entries are keyed by a stable node identity and a persistent dependencies Crc (see IPCGElement::ComputePersistentDependencies),
+* since element pointers and data UIDs change from one session to the next. Entries also store the persistent Crc of each input,
+* which must match on load, so that a collision of the combined Crc is not served as a hit.
+* Only self-contained data is persisted (data with a full data Crc, like point arrays and dynamic meshes, and param data),
+* and entries are evicted least recently used first once the size budget is exceeded.
+* Reading and writing entries creates objects, so it is only done on the game thread.
+*/
+class FPCGGraphDiskCache
+{
+public:
+	struct FStats
+	{
+		uint64 Hits = 0;
+		uint64 Misses = 0;
+		/** Misses on entries found for the key but written for other input Crcs. */
+		uint64 Collisions = 0;
+		uint64 Writes = 0;
+		uint64 RejectedWrites = 0;
+		uint64 Evictions = 0;
+		int32 NumEntries = 0;
+		int64 SizeInBytes = 0;
+	};
+
+	/** True if the disk cache is enabled ('pcg.Cache.Disk.Enabled'). */
+	static bool IsEnabled();
+
+	/** True if the data can be written to and restored from disk, and its Crc can be part of a persistent dependencies Crc. */
+	static bool CanPersist(const UPCGData* InData);
+
+	/**
+	* Builds the key of an entry, from the node path, a persistent dependencies Crc, and the versions of the code producing the results:
+	* the element version (IPCGElement::GetPersistentCacheVersion) and the build of the module implementing the node settings.
+	*/
+	static FSHAHash MakeKey(const UPCGNode* InNode, const IPCGElement* InElement, const FPCGCrc& InPersistentCrc);
+
+	/** Directory of the entries ('pcg.Cache.Disk.Path'). */
+	static FString GetCacheDirectory();
+
+	/**
+	* Returns true if an entry was found, was written for the same input Crcs, and could be fully restored.
+	* New data is created in the transient package, the caller must reference it before the next GC.
+	*/
+	bool Load(const FSHAHash& InKey, TConstArrayView<FPCGCrc> InInputCrcs, FPCGDataCollection& OutCollection);
+
+	/** Writes the collection and the input Crcs to disk, if all its data can be persisted. Evicts older entries if the budget is exceeded. */
+	void Store(const FSHAHash& InKey, TConstArrayView<FPCGCrc> InInputCrcs, const FPCGDataCollection& InCollection);
+
+	/** Deletes all entries from disk. */
+	void Clear();
+
+	const FStats& GetStats() const { return Stats; }
+	void LogStats() const;
+
+private:
+	struct FEntry
+	{
+		int64 SizeInBytes = 0;
+		FDateTime LastAccessTime;
+	};
+
+	/** Scans the cache directory the first time it is needed, to find entries written by previous sessions. */
+	void Initialize();
+
+	/** Removes least recently used entries until the cache fits in its budget. */
+	void EnforceBudget();
+
+	void RemoveEntry(const FSHAHash& InKey);
+
+	static FString GetEntryFilename(const FSHAHash& InKey);
+
+	TMap<FSHAHash, FEntry> Entries;
+	FStats Stats;
+	bool bInitialized = false;
+};
@@ -21,7 +21,9 @@
 #include "Utils/PCGGraphExecutionLogging.h"
 
 #include "Algo/AnyOf.h"
+#include "Algo/BinarySearch.h"
 #include "Algo/ForEach.h"
+#include "Algo/StableSort.h"
 #include "Engine/Engine.h"
 #include "GameFramework/Actor.h"
 #include "Misc/ScopeExit.h"
@@ -91,6 +93,11 @@ namespace PCGGraphExecutor
 		true,
 		TEXT("Controls whether tasks are culled at execution time, for example in response to an deactivated dynamic branch pin"));
 
+	TAutoConsoleVariable<bool> CVarPriorityScheduling(
+		TEXT("pcg.Graph.PriorityScheduling"),
+		true,
+		TEXT("Controls whether ready tasks are launched by priority (longest downstream chain first, then longest past execution time) instead of in arrival order"));
+
 	TAutoConsoleVariable<bool> CVarPassGPUDataThroughGridLinks(
 		TEXT("pcg.Graph.GPU.PassGPUDataThroughGridLinks"),
 		true,
@@ -137,6 +144,74 @@ namespace PCGGraphExecutor
 		}
 	}
 
+	bool IsLowerPriority(const FPCGGraphTask& A, const FPCGGraphTask& B)
+	{
+		return A.CriticalPathLength != B.CriticalPathLength ? A.CriticalPathLength < B.CriticalPathLength : A.NumSuccessors < B.NumSuccessors;
+	}
+
+	bool IsHigherPriority(const FPCGGraphActiveTask& A, const FPCGGraphActiveTask& B)
+	{
+		if (A.CriticalPathLength != B.CriticalPathLength)
+		{
+			return A.CriticalPathLength > B.CriticalPathLength;
+		}
+
+		if (A.ExpectedExecutionSeconds != B.ExpectedExecutionSeconds)
+		{
+			return A.ExpectedExecutionSeconds > B.ExpectedExecutionSeconds;
+		}
+
+		return A.NumSuccessors > B.NumSuccessors;
+	}
+
+	// Needs to be called by owner of LiveTasksLock
+	// Ready tasks are consumed from the back, so keep them sorted by increasing priority.
+	void AddToReadyTaskArrayNoLock(TArray<FPCGGraphTask>& ReadyTaskArray, FPCGGraphTask&& Task)
+	{
+		if (CVarPriorityScheduling.GetValueOnAnyThread())
+		{
+			// Insert after tasks of the same priority so they are still consumed last in, first out.
+			const int32 InsertIndex = Algo::UpperBound(ReadyTaskArray, Task, &IsLowerPriority);
+			ReadyTaskArray.Insert(MoveTemp(Task), InsertIndex);
+		}
+		else
+		{
+			ReadyTaskArray.Emplace(MoveTemp(Task));
+		}
+	}
+
+	// Needs to be called by owner of LiveTasksLock
+	// Returns the task the main thread should execute next: the first available one, or the one with the highest priority.
+	TSharedPtr<FPCGGraphActiveTask>* FindTaskToExecuteNoLock(TArray<TSharedPtr<FPCGGraphActiveTask>>& ActiveTaskArray)
+	{
+		const bool bUsePriority = CVarPriorityScheduling.GetValueOnAnyThread();
+
+		TSharedPtr<FPCGGraphActiveTask>* FoundActiveTask = nullptr;
+		for (TSharedPtr<FPCGGraphActiveTask>& ActiveTask : ActiveTaskArray)
+		{
+			if (ActiveTask->bIsExecutingTask || ActiveTask->Context->bIsPaused)
+			{
+				continue;
+			}
+
+			if (!FoundActiveTask)
+			{
+				FoundActiveTask = &ActiveTask;
+
+				if (!bUsePriority)
+				{
+					break;
+				}
+			}
+			else if (IsHigherPriority(*ActiveTask, **FoundActiveTask))
+			{
+				FoundActiveTask = &ActiveTask;
+			}
+		}
+
+		return FoundActiveTask;
+	}
+
 	// Needs to be called by owner of LiveTasksLock
 	void InsertToActiveTaskArrayNoLock(int32 Index, TArray<TSharedPtr<FPCGGraphActiveTask>>& ActiveTaskArray, TSharedPtr<FPCGGraphActiveTask> ActiveTask)
 	{
@@ -585,7 +660,7 @@ TSet<IPCGGraphExecutionSource*> FPCGGraphExecutor::Cancel(TFunctionRef<bool(TWea
 					if (CancelledExecutionSources.Contains(Task.ExecutionSource.Get()))
 					{
 						CancelledReadyTasks.Add(MoveTemp(Task));
-						ReadyTasks.RemoveAtSwap(ReadyTaskIndex);
+						ReadyTasks.RemoveAt(ReadyTaskIndex);
 					}
 				}
 			}
@@ -1256,6 +1331,14 @@ void FPCGGraphExecutor::PostTaskExecute(TSharedPtr<FPCGGraphActiveTask> ActiveTa
 		// Make sure we set this to false inside lock
 		ActiveTask.StopExecuting();
 
+		// Keep a moving average of the execution time of each node, to refine the priority of its future tasks.
+		if (bTaskFullyExecuted && ActiveTask.Context->Node)
+		{
+			const float ExecutionSeconds = static_cast<float>(ActiveTask.ExecutionSeconds);
+			float& AverageExecutionSeconds = NodeExecutionSeconds.FindOrAdd(ActiveTask.Context->Node, ExecutionSeconds);
+			AverageExecutionSeconds = FMath::Lerp(AverageExecutionSeconds, ExecutionSeconds, 0.25f);
+		}
+
 		// Next Scheduling call needs to check if this task completion unblocked some paused task(s)
 		bNeedToCheckPausedTasks = true;
 	}
@@ -1285,7 +1368,7 @@ void FPCGGraphExecutor::OnTaskInputsReady(FPCGGraphTask& Task, TArray<FCachedRes
 		}
 		else 
 		{
-			ReadyTasks.Emplace(MoveTemp(Task));
+			PCGGraphExecutor::AddToReadyTaskArrayNoLock(ReadyTasks, MoveTemp(Task));
 		}
 	}
 
@@ -1373,6 +1456,7 @@ void FPCGGraphExecutor::PrepareForExecute(FPCGGraphTask& Task, FCachedResult*& O
 
 	// Calculate Crc of dependencies (input data Crcs, settings) and use this as the key in the cache lookup
 	FPCGCrc DependenciesCrc;
+	FPCGPersistentDependencies PersistentDependencies;
 	EPCGCachingStatus CacheStatus = EPCGCachingStatus::NotInCache;
 	bool bResultAlreadyInCache = false;
 
@@ -1380,7 +1464,7 @@ void FPCGGraphExecutor::PrepareForExecute(FPCGGraphTask& Task, FCachedResult*& O
 	{
 		PCGGraphExecutor::TScopeLock ScopeLock(CachingResultsLock);
 		FCachedResult LocalCachedResult;
-		CacheStatus = Task.Element->RetrieveResultsFromCache(&GraphCache, Task.Node, Task.TaskInput, Task.ExecutionSource.Get(), LocalCachedResult.Output, &DependenciesCrc);
+		CacheStatus = Task.Element->RetrieveResultsFromCache(&GraphCache, Task.Node, Task.TaskInput, Task.ExecutionSource.Get(), LocalCachedResult.Output, &DependenciesCrc, &PersistentDependencies);
 
 		bResultAlreadyInCache = (CacheStatus == EPCGCachingStatus::Cached);
 		if (bResultAlreadyInCache)
@@ -1451,6 +1535,7 @@ void FPCGGraphExecutor::PrepareForExecute(FPCGGraphTask& Task, FCachedResult*& O
 		Task.Context->TaskId = Task.NodeId;
 		Task.Context->CompiledTaskId = Task.CompiledTaskId;
 		Task.Context->DependenciesCrc = DependenciesCrc;
+		Task.Context->PersistentDependencies = MoveTemp(PersistentDependencies);
 		Task.Context->StackHandle = Task.GetStackHandle();
 		PRAGMA_DISABLE_DEPRECATION_WARNINGS
 		Task.Context->Stack = Task.GetStack();
@@ -1604,7 +1689,7 @@ bool FPCGGraphExecutor::ExecuteScheduling(double EndTime, TSharedPtr<FPCGGraphAc
 #endif
 						check(CachedResult->TaskId != InvalidPCGTaskId);
 						CachedResults.Add(MoveTemp(CachedResult));
-						ReadyTasks.RemoveAtSwap(ReadyTaskIndex, EAllowShrinking::No);
+						ReadyTasks.RemoveAt(ReadyTaskIndex, EAllowShrinking::No);
 						bStateChanged = true;
 
 						if (FPlatformTime::Seconds() > EndTime)
@@ -1631,11 +1716,17 @@ bool FPCGGraphExecutor::ExecuteScheduling(double EndTime, TSharedPtr<FPCGGraphAc
 				ActiveTask.Context = TUniquePtr<FPCGContext>(Task.Context);
 				ActiveTask.StackIndex = Task.StackIndex;
 				ActiveTask.StackContext = Task.StackContext;
+				ActiveTask.CriticalPathLength = Task.CriticalPathLength;
+				ActiveTask.NumSuccessors = Task.NumSuccessors;
+				if (const float* ExpectedExecutionSeconds = Task.Node ? NodeExecutionSeconds.Find(Task.Node) : nullptr)
+				{
+					ActiveTask.ExpectedExecutionSeconds = *ExpectedExecutionSeconds;
+				}
 #if WITH_EDITOR
 				ActiveTask.bIsBypassed = Task.bIsBypassed;
 #endif
-				// Move the task up front if it needs to run on the main thread
-				ReadyTasks.RemoveAtSwap(ReadyTaskIndex, EAllowShrinking::No);
+				// Keep the remaining ready tasks sorted by priority
+				ReadyTasks.RemoveAt(ReadyTaskIndex, EAllowShrinking::No);
 				bStateChanged = true;
 
 				if (FPlatformTime::Seconds() > EndTime)
@@ -1660,15 +1751,10 @@ bool FPCGGraphExecutor::ExecuteScheduling(double EndTime, TSharedPtr<FPCGGraphAc
 				// Execute main thread task
 				if (!ActiveTasksGameThreadOnly.IsEmpty() || !ActiveTasks.IsEmpty())
 				{
-					auto FindTaskToExecute = [](const TSharedPtr<FPCGGraphActiveTask>& InActiveTask)
-					{
-						return !InActiveTask->bIsExecutingTask && !InActiveTask->Context->bIsPaused;
-					};
-
-					TSharedPtr<FPCGGraphActiveTask>* FoundActiveTask = ActiveTasksGameThreadOnly.FindByPredicate(FindTaskToExecute);
+					TSharedPtr<FPCGGraphActiveTask>* FoundActiveTask = PCGGraphExecutor::FindTaskToExecuteNoLock(ActiveTasksGameThreadOnly);
 					if (!FoundActiveTask)
 					{
-						FoundActiveTask = ActiveTasks.FindByPredicate(FindTaskToExecute);
+						FoundActiveTask = PCGGraphExecutor::FindTaskToExecuteNoLock(ActiveTasks);
 					}
 
 					if (FoundActiveTask)
@@ -1696,7 +1782,24 @@ bool FPCGGraphExecutor::ExecuteScheduling(double EndTime, TSharedPtr<FPCGGraphAc
 				const double SchedulingBudgetInSeconds = GetTickBudgetInSeconds();
 
 				TRACE_CPUPROFILER_EVENT_SCOPE(FPCGGraphExecutor::ExecuteScheduling::LaunchTasks);
+
+				// Launch the tasks in order of priority, when there are more tasks than available threads the ones on the critical path go first.
+				TArray<int32, TInlineAllocator<64>> LaunchOrder;
+				LaunchOrder.Reserve(ActiveTasks.Num());
 				for (int32 ExecutionIndex = 0; ExecutionIndex < ActiveTasks.Num(); ++ExecutionIndex)
+				{
+					if (!ActiveTasks[ExecutionIndex]->bIsExecutingTask && !ActiveTasks[ExecutionIndex]->Context->bIsPaused)
+					{
+						LaunchOrder.Add(ExecutionIndex);
+					}
+				}
+
+				if (PCGGraphExecutor::CVarPriorityScheduling.GetValueOnAnyThread())
+				{
+					Algo::StableSort(LaunchOrder, [this](int32 A, int32 B) { return PCGGraphExecutor::IsHigherPriority(*ActiveTasks[A], *ActiveTasks[B]); });
+				}
+
+				for (const int32 ExecutionIndex : LaunchOrder)
 				{
 					TSharedPtr<FPCGGraphActiveTask>& ActiveTask = ActiveTasks[ExecutionIndex];
 
@@ -1904,6 +2007,8 @@ void FPCGGraphExecutor::Execute(double& InOutEndTime)
 	}
 
 	ExecuteTasksEnded();
+
+	GraphCache.FlushPendingDiskWrites(InOutEndTime);
 }
 
 void FPCGGraphExecutor::ClearAllTasks()
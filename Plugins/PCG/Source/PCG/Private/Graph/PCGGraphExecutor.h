@@ -16,6 +16,7 @@
 #include "Tasks/Task.h"
 #include "Templates/UniquePtr.h"
 #include "UObject/GCObject.h"
+#include "UObject/ObjectKey.h"
 
 #if WITH_EDITOR
 #include "Editor/IPCGEditorProgressNotification.h"
@@ -314,6 +315,8 @@ private:
 	TArray<TSharedPtr<FPCGGraphActiveTask>> ActiveTasksGameThreadOnly;
 	TArray<TSharedPtr<FPCGGraphActiveTask>> PausedTasks;
 	bool bNeedToCheckPausedTasks = false;
+	/** Moving average of the execution time of each node, used to prioritize ready tasks. */
+	TMap<TObjectKey<UPCGNode>, float> NodeExecutionSeconds;
 
 	/** Lock level leaf */
 	FPCGLock CollectGCReferenceTasksLock;
@@ -160,6 +160,7 @@ void FPCGGraphActiveTask::StartExecuting()
 	}
 
 	bIsExecutingTask = true;
+	ExecutionStartTime = FPlatformTime::Seconds();
 }
 
 void FPCGGraphActiveTask::StopExecuting()
@@ -167,6 +168,7 @@ void FPCGGraphActiveTask::StopExecuting()
 	if (bIsExecutingTask)
 	{
 		bIsExecutingTask = false;
+		ExecutionSeconds += FPlatformTime::Seconds() - ExecutionStartTime;
 		ExecutingTask = {};
 		--NumExecuting;
 
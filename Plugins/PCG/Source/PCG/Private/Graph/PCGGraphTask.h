@@ -136,6 +136,14 @@ struct FPCGGraphTask
 	UPROPERTY()
 	int32 StackIndex = INDEX_NONE;
 
+	/** Scheduling hint computed by the compiler: number of tasks on the longest path from this task to the end of the graph, this task included. */
+	UPROPERTY()
+	int32 CriticalPathLength = 0;
+
+	/** Scheduling hint computed by the compiler: number of tasks that directly depend on this task. */
+	UPROPERTY()
+	int32 NumSuccessors = 0;
+
 	FPCGElementPtr Element; // Added to have tasks that aren't node-bound
 
 	TWeakInterfacePtr<IPCGGraphExecutionSource> ExecutionSource = nullptr;
@@ -198,6 +206,15 @@ struct FPCGGraphActiveTask : TSharedFromThis<FPCGGraphActiveTask>
 #endif
 	int32 StackIndex = INDEX_NONE;
 	TSharedPtr<const FPCGStackContext> StackContext;
+
+	// Scheduling priority, tasks on longer chains or that took longer in previous executions are launched first
+	int32 CriticalPathLength = 0;
+	int32 NumSuccessors = 0;
+	float ExpectedExecutionSeconds = 0.0f;
+
+	// Time spent executing so far, accumulated across time slices
+	double ExecutionStartTime = 0.0;
+	double ExecutionSeconds = 0.0;
 		
 	// Those members need to be modified under the FPCGGraphExecutor::LiveTasksLock (unless we are running the old executor path)
 	UE::Tasks::TTask<bool> ExecutingTask;
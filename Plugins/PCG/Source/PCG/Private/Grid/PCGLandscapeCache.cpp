@@ -59,6 +59,14 @@ namespace PCGLandscapeCache
 		return Result;
 	}
 
+	float InterpolateLayerWeight(const TArray<uint8>& LayerData, const FSafeIndices& Indices)
+	{
+		check(Indices.X1Y1 < LayerData.Num());
+		const float Y0Data = FMath::Lerp((float)LayerData[Indices.X0Y0] / 255.0f, (float)LayerData[Indices.X1Y0] / 255.0f, Indices.XFraction);
+		const float Y1Data = FMath::Lerp((float)LayerData[Indices.X0Y1] / 255.0f, (float)LayerData[Indices.X1Y1] / 255.0f, Indices.XFraction);
+		return FMath::Lerp(Y0Data, Y1Data, Indices.YFraction);
+	}
+
 	FIntPoint GetCoordinates(const ULandscapeComponent* LandscapeComponent)
 	{
 		check(LandscapeComponent && LandscapeComponent->ComponentSizeQuads != 0);
@@ -227,6 +235,60 @@ void FPCGLandscapeCacheEntry::GetInterpolatedLayerWeights(const FVector2D& Local
 	}
 }
 
+void FPCGLandscapeCacheEntry::GetInterpolatedPositionAndNormal(const FVector2D& LocalPoint, FVector& OutPosition, FVector* OutNormal) const
+{
+	check(bDataLoaded);
+	const PCGLandscapeCache::FSafeIndices Indices = PCGLandscapeCache::CalcSafeIndices(LocalPoint, Stride);
+	check(2 * Indices.X1Y1 < PositionsAndNormals.Num());
+
+	const FVector LerpPositionY0 = FMath::Lerp(PositionsAndNormals[2 * Indices.X0Y0], PositionsAndNormals[2 * Indices.X1Y0], Indices.XFraction);
+	const FVector LerpPositionY1 = FMath::Lerp(PositionsAndNormals[2 * Indices.X0Y1], PositionsAndNormals[2 * Indices.X1Y1], Indices.XFraction);
+	OutPosition = FMath::Lerp(LerpPositionY0, LerpPositionY1, Indices.YFraction);
+
+	if (OutNormal)
+	{
+		// Same interpolation as GetInterpolatedPointInternal, so that both paths produce the same surface normal
+		const FVector LerpNormalY0 = FMath::Lerp(PositionsAndNormals[2 * Indices.X0Y0 + 1].GetSafeNormal(), PositionsAndNormals[2 * Indices.X1Y0 + 1].GetSafeNormal(), Indices.XFraction).GetSafeNormal();
+		const FVector LerpNormalY1 = FMath::Lerp(PositionsAndNormals[2 * Indices.X0Y1 + 1].GetSafeNormal(), PositionsAndNormals[2 * Indices.X1Y1 + 1].GetSafeNormal(), Indices.XFraction).GetSafeNormal();
+		*OutNormal = FMath::Lerp(LerpNormalY0, LerpNormalY1, Indices.YFraction).GetSafeNormal();
+	}
+}
+
+float FPCGLandscapeCacheEntry::GetInterpolatedLayerWeight(const FVector2D& LocalPoint, int32 LayerIndex) const
+{
+	check(bDataLoaded);
+	if (!LayerData.IsValidIndex(LayerIndex))
+	{
+		return 0.0f;
+	}
+
+	const PCGLandscapeCache::FSafeIndices Indices = PCGLandscapeCache::CalcSafeIndices(LocalPoint, Stride);
+	return PCGLandscapeCache::InterpolateLayerWeight(LayerData[LayerIndex], Indices);
+}
+
+void FPCGLandscapeCacheEntry::GetInterpolatedLayerWeight(TConstArrayView<FVector2D> LocalPoints, int32 LayerIndex, TArrayView<float> OutWeights) const
+{
+	check(bDataLoaded);
+	check(LocalPoints.Num() == OutWeights.Num());
+
+	if (!LayerData.IsValidIndex(LayerIndex))
+	{
+		for (float& OutWeight : OutWeights)
+		{
+			OutWeight = 0.0f;
+		}
+
+		return;
+	}
+
+	const TArray<uint8>& CurrentLayerData = LayerData[LayerIndex];
+	for (int32 PointIndex = 0; PointIndex < LocalPoints.Num(); ++PointIndex)
+	{
+		const PCGLandscapeCache::FSafeIndices Indices = PCGLandscapeCache::CalcSafeIndices(LocalPoints[PointIndex], Stride);
+		OutWeights[PointIndex] = PCGLandscapeCache::InterpolateLayerWeight(CurrentLayerData, Indices);
+	}
+}
+
 void FPCGLandscapeCacheEntry::GetInterpolatedPointInternal(const PCGLandscapeCache::FSafeIndices& Indices, FPCGPoint& OutPoint, bool bHeightOnly) const
 {
 	check(bDataLoaded);
@@ -33,6 +33,12 @@ namespace FPCGAsync
 		TEXT("For quick benchmarking, we can override the value of chunk size for async processing. Any negative value is discarded.")
 	};
 
+	TAutoConsoleVariable<bool> ConsoleVar::CVarAsyncDynamicChunkScheduling{
+		TEXT("pcg.Async.DynamicChunkScheduling"),
+		true,
+		TEXT("If true, async processing tasks claim chunks from a shared cursor instead of processing fixed ranges, to balance uneven costs per iteration.")
+	};
+
 	int32 GetNumTasks(FPCGAsyncState* AsyncState, int32 InDefaultNumTasks)
 	{
 		// Get number of available threads from the async state
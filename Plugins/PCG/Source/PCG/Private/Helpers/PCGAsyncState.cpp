@@ -16,6 +16,7 @@ void FPCGAsyncState::Reset()
 	CurrentChunkToCollapse = 0;
 	ChunkToNumElementsWrittenMap.Reset();
 	InitialNumIterations = 0;
+	NextChunkToProcess = INDEX_NONE;
 
 	bStarted = false;
 }
@@ -0,0 +1,57 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Helpers/PCGCrcHelpers.h"
+
+#include "Async/ParallelFor.h"
+#include "HAL/IConsoleManager.h"
+#include "Serialization/ArchiveCrc32.h"
+
+static TAutoConsoleVariable<bool> CVarParallelDataCrc(
+	TEXT("pcg.Cache.ParallelDataCrc"),
+	true,
+	TEXT("Computes full data Crcs (points, metadata) in parallel chunks. When disabled, values are hashed one by one on the calling thread."));
+
+namespace PCGCrcHelpers
+{
+	bool UseParallelCrc()
+	{
+		return CVarParallelDataCrc.GetValueOnAnyThread();
+	}
+
+	void AddChunkedBuffersToCrc(FArchiveCrc32& Ar, TConstArrayView<FChunkedBuffer> InBuffers)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(PCGCrcHelpers::AddChunkedBuffersToCrc);
+
+		struct FChunk
+		{
+			int32 BufferIndex = 0;
+			int32 StartIndex = 0;
+			int32 Count = 0;
+		};
+
+		TArray<FChunk> Chunks;
+		for (int32 BufferIndex = 0; BufferIndex < InBuffers.Num(); ++BufferIndex)
+		{
+			const int32 NumValues = InBuffers[BufferIndex].NumValues;
+			for (int32 StartIndex = 0; StartIndex < NumValues; StartIndex += ChunkSize)
+			{
+				Chunks.Add({ BufferIndex, StartIndex, FMath::Min(ChunkSize, NumValues - StartIndex) });
+			}
+		}
+
+		TArray<uint32> ChunkCrcs;
+		ChunkCrcs.SetNumUninitialized(Chunks.Num());
+
+		ParallelFor(Chunks.Num(), [&Chunks, &ChunkCrcs, InBuffers](int32 ChunkIndex)
+		{
+			const FChunk& Chunk = Chunks[ChunkIndex];
+			ChunkCrcs[ChunkIndex] = InBuffers[Chunk.BufferIndex].ChunkCrc(Chunk.StartIndex, Chunk.Count);
+		});
+
+		// Chunks are ordered by buffer then by index, so the combination doesn't depend on the scheduling.
+		for (uint32& ChunkCrc : ChunkCrcs)
+		{
+			Ar << ChunkCrc;
+		}
+	}
+}
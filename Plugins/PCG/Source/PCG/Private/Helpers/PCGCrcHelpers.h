@@ -0,0 +1,104 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Utils/PCGValueRange.h"
+
+#include "Containers/Array.h"
+#include "Math/Transform.h"
+#include "Misc/Crc.h"
+#include "Templates/Function.h"
+
+class FArchiveCrc32;
+
+/**
+* Helpers to compute content Crcs of large buffers in parallel.
+* Values are split in chunks of a fixed size, hashed in parallel and the chunk Crcs are added to the archive in order,
+* so the result doesn't depend on the number of workers and is stable from one run to the next.
+*/
+namespace PCGCrcHelpers
+{
+	/** Number of values per chunk. Changing it changes all the full data Crcs. */
+	constexpr int32 ChunkSize = 32 * 1024;
+
+	/** True if full data Crcs should be computed in parallel chunks ('pcg.Cache.ParallelDataCrc'), false for the value by value path. */
+	bool UseParallelCrc();
+
+	inline int32 GetNumChunks(int32 InNumValues)
+	{
+		return (InNumValues + ChunkSize - 1) / ChunkSize;
+	}
+
+	/** A buffer to hash, split in chunks of ChunkSize values. ChunkCrc computes the Crc of the values [StartIndex, StartIndex + Count). */
+	struct FChunkedBuffer
+	{
+		int32 NumValues = 0;
+		TFunction<uint32(int32 StartIndex, int32 Count)> ChunkCrc;
+	};
+
+	/** Hashes the chunks of all the buffers in parallel, then adds their Crcs to the archive, buffer by buffer and chunk by chunk. */
+	void AddChunkedBuffersToCrc(FArchiveCrc32& Ar, TConstArrayView<FChunkedBuffer> InBuffers);
+
+	/** Writes the bytes hashed for a value. Transforms are written component by component, to skip the padding of their vector registers. */
+	template<typename T>
+	void AppendValueBytes(const T& InValue, TArray<uint8>& OutBytes)
+	{
+		if constexpr (std::is_same_v<T, FTransform>)
+		{
+			const FQuat Rotation = InValue.GetRotation();
+			const FVector Translation = InValue.GetTranslation();
+			const FVector Scale = InValue.GetScale3D();
+			AppendValueBytes(Rotation, OutBytes);
+			AppendValueBytes(Translation, OutBytes);
+			AppendValueBytes(Scale, OutBytes);
+		}
+		else
+		{
+			OutBytes.Append(reinterpret_cast<const uint8*>(&InValue), sizeof(T));
+		}
+	}
+
+	/** Values that have no padding can be hashed directly from memory. */
+	template<typename T>
+	constexpr bool IsPacked()
+	{
+		return !std::is_same_v<T, FTransform>;
+	}
+
+	/** Crc of the values [InStartIndex, InStartIndex + InCount) of a range. Contiguous values are hashed as one block, strided values are gathered first. */
+	template<typename T>
+	uint32 ComputeValueRangeChunkCrc(const TConstPCGValueRange<T>& InRange, int32 InStartIndex, int32 InCount)
+	{
+		if constexpr (IsPacked<T>())
+		{
+			if (const T* Data = PCGValueRangeHelpers::GetContiguousData(InRange); Data && InRange.ViewNum() >= InStartIndex + InCount)
+			{
+				return FCrc::MemCrc32(Data + InStartIndex, sizeof(T) * InCount);
+			}
+		}
+
+		TArray<uint8> Bytes;
+		Bytes.Reserve(sizeof(T) * InCount);
+
+		for (int32 Index = InStartIndex; Index < InStartIndex + InCount; ++Index)
+		{
+			AppendValueBytes(InRange[Index], Bytes);
+		}
+
+		return FCrc::MemCrc32(Bytes.GetData(), Bytes.Num());
+	}
+
+	/** Makes the buffer for a value range. A single value range (unallocated property) is hashed once, whatever the number of values it represents. */
+	template<typename T>
+	FChunkedBuffer MakeValueRangeBuffer(const TConstPCGValueRange<T>& InRange)
+	{
+		FChunkedBuffer Buffer;
+		Buffer.NumValues = InRange.ViewNum();
+		Buffer.ChunkCrc = [InRange](int32 StartIndex, int32 Count)
+		{
+			return ComputeValueRangeChunkCrc(InRange, StartIndex, Count);
+		};
+
+		return Buffer;
+	}
+}
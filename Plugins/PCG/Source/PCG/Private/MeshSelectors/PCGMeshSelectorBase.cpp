@@ -3,8 +3,11 @@
 #include "MeshSelectors/PCGMeshSelectorBase.h"
 
 #include "PCGElement.h"
+#include "Data/PCGBasePointData.h"
 #include "Elements/PCGStaticMeshSpawnerContext.h"
 
+#include "Async/ParallelFor.h"
+
 #include UE_INLINE_GENERATED_CPP_BY_NAME(PCGMeshSelectorBase)
 
 #define LOCTEXT_NAMESPACE "PCGMeshSelectorBase"
@@ -117,6 +120,9 @@ void FPCGMeshMaterialOverrideHelper::Reset()
 	MaterialAttributes.Reset();
 	ValueKeyToOverrideMaterials.Reset();
 	WorkingMaterialOverrides.Reset();
+	Combinations.Reset();
+	PointCombinationIds.Reset();
+	bHasResolvedCombinations = false;
 	bIsInitialized = false;
 	bIsValid = false;
 	bUseMaterialOverrideAttributes = false;
@@ -175,4 +181,122 @@ const TArray<TSoftObjectPtr<UMaterialInterface>>& FPCGMeshMaterialOverrideHelper
 	}
 }
 
+void FPCGMeshMaterialOverrideHelper::ResolveCombinations(const UPCGBasePointData* InPointData)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FPCGMeshMaterialOverrideHelper::ResolveCombinations);
+
+	check(bIsValid && InPointData);
+
+	Combinations.Reset();
+	PointCombinationIds.Reset();
+	bHasResolvedCombinations = true;
+
+	// Without override attributes, all the points share the same overrides
+	if (!bUseMaterialOverrideAttributes || MaterialAttributes.IsEmpty())
+	{
+		Combinations.Add(bUseMaterialOverrideAttributes ? TArray<TSoftObjectPtr<UMaterialInterface>>() : StaticMaterialOverrides);
+		return;
+	}
+
+	const int32 NumPoints = InPointData->GetNumPoints();
+	const int32 NumAttributes = MaterialAttributes.Num();
+	const TConstPCGValueRange<int64> MetadataEntryRange = InPointData->GetConstMetadataEntryValueRange();
+
+	// Gather the value keys of all the material attributes, per point
+	TArray<PCGMetadataValueKey> PointValueKeys;
+	PointValueKeys.SetNumUninitialized(NumPoints * NumAttributes);
+	{
+		constexpr int32 PointsPerBatch = 4096;
+		const int32 NumBatches = FMath::DivideAndRoundUp(NumPoints, PointsPerBatch);
+
+		ParallelFor(NumBatches, [this, &PointValueKeys, &MetadataEntryRange, NumPoints, NumAttributes, PointsPerBatch](int32 BatchIndex)
+		{
+			const int32 StartIndex = BatchIndex * PointsPerBatch;
+			const int32 EndIndex = FMath::Min(StartIndex + PointsPerBatch, NumPoints);
+
+			for (int32 PointIndex = StartIndex; PointIndex < EndIndex; ++PointIndex)
+			{
+				for (int32 MaterialIndex = 0; MaterialIndex < NumAttributes; ++MaterialIndex)
+				{
+					PointValueKeys[PointIndex * NumAttributes + MaterialIndex] = MaterialAttributes[MaterialIndex]->GetValueKey(MetadataEntryRange[PointIndex]);
+				}
+			}
+		}, NumBatches > 1 ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+	}
+
+	auto HashMaterials = [](const TArray<TSoftObjectPtr<UMaterialInterface>>& Materials)
+	{
+		uint32 Hash = GetTypeHash(Materials.Num());
+		for (const TSoftObjectPtr<UMaterialInterface>& Material : Materials)
+		{
+			Hash = HashCombineFast(Hash, GetTypeHash(Material));
+		}
+
+		return Hash;
+	};
+
+	// Value key tuples are identified one attribute at a time: (id of the previous attributes, value key) -> id.
+	// Each new tuple is resolved to materials once, and different tuples resolving to the same materials share their combination.
+	TMap<TPair<int32, PCGMetadataValueKey>, int32> TupleIds;
+	TMap<int32, int32> TupleToCombination;
+	TMultiMap<uint32, int32> CombinationsByHash;
+
+	PointCombinationIds.SetNumUninitialized(NumPoints);
+
+	for (int32 PointIndex = 0; PointIndex < NumPoints; ++PointIndex)
+	{
+		const PCGMetadataValueKey* ValueKeys = PointValueKeys.GetData() + PointIndex * NumAttributes;
+
+		// Consecutive points often share their overrides
+		if (PointIndex > 0 && FMemory::Memcmp(ValueKeys, ValueKeys - NumAttributes, NumAttributes * sizeof(PCGMetadataValueKey)) == 0)
+		{
+			PointCombinationIds[PointIndex] = PointCombinationIds[PointIndex - 1];
+			continue;
+		}
+
+		int32 TupleId = INDEX_NONE;
+		for (int32 MaterialIndex = 0; MaterialIndex < NumAttributes; ++MaterialIndex)
+		{
+			const TPair<int32, PCGMetadataValueKey> PartialTuple(TupleId, ValueKeys[MaterialIndex]);
+			if (const int32* ExistingTupleId = TupleIds.Find(PartialTuple))
+			{
+				TupleId = *ExistingTupleId;
+			}
+			else
+			{
+				const int32 NewTupleId = TupleIds.Num();
+				TupleIds.Add(PartialTuple, NewTupleId);
+				TupleId = NewTupleId;
+			}
+		}
+
+		int32* CombinationId = TupleToCombination.Find(TupleId);
+		if (!CombinationId)
+		{
+			const TArray<TSoftObjectPtr<UMaterialInterface>>& Materials = GetMaterialOverrides(MetadataEntryRange[PointIndex]);
+			const uint32 Hash = HashMaterials(Materials);
+
+			int32 MatchingCombinationId = INDEX_NONE;
+			for (auto It = CombinationsByHash.CreateConstKeyIterator(Hash); It; ++It)
+			{
+				if (Combinations[It.Value()] == Materials)
+				{
+					MatchingCombinationId = It.Value();
+					break;
+				}
+			}
+
+			if (MatchingCombinationId == INDEX_NONE)
+			{
+				MatchingCombinationId = Combinations.Add(Materials);
+				CombinationsByHash.Add(Hash, MatchingCombinationId);
+			}
+
+			CombinationId = &TupleToCombination.Add(TupleId, MatchingCombinationId);
+		}
+
+		PointCombinationIds[PointIndex] = *CombinationId;
+	}
+}
+
 #undef LOCTEXT_NAMESPACE
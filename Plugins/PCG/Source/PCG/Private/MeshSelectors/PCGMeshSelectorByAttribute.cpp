@@ -149,6 +149,10 @@ bool UPCGMeshSelectorByAttribute::SelectMeshInstances(
 	if (!MaterialOverrideHelper.IsInitialized())
 	{
 		MaterialOverrideHelper.Initialize(Context, bUseAttributeMaterialOverrides, TemplateDescriptor.OverrideMaterials, MaterialOverrideAttributes, InPointData->Metadata);
+		if (MaterialOverrideHelper.IsValid())
+		{
+			MaterialOverrideHelper.ResolveCombinations(InPointData);
+		}
 	}
 
 	if (!MaterialOverrideHelper.IsValid())
@@ -243,7 +247,6 @@ bool UPCGMeshSelectorByAttribute::SelectMeshInstances(
 		TRACE_CPUPROFILER_EVENT_SCOPE(UPCGMeshSelectorByAttribute::SelectEntries::PushingPointsToInstanceLists);
 
 		const TConstPCGValueRange<FTransform> InTransformRange = InPointData->GetConstTransformValueRange();
-		const TConstPCGValueRange<int64> InMetadataEntryRange = InPointData->GetConstMetadataEntryValueRange();
 				
 		// TODO: Revisit this when attribute partitioning is returned in a more optimized form
 		// The partition index is used to assign the point to the correct partition's instance
@@ -291,15 +294,27 @@ bool UPCGMeshSelectorByAttribute::SelectMeshInstances(
 				Partition.SetNum(WriteIndex);
 			}
 
-			auto AddPointsToInstanceList = [&OutMeshInstances, &CurrentPartitionDescriptor, &MaterialOverrideHelper, &InTransformRange, &InMetadataEntryRange, PartitionIndex, InPointData](const TArray<int32>& PointIndices, bool bReverseTransform)
+			auto AddPointsToInstanceList = [&OutMeshInstances, &CurrentPartitionDescriptor, &MaterialOverrideHelper, &InTransformRange, PartitionIndex, InPointData](const TArray<int32>& PointIndices, bool bReverseTransform)
 			{
 				if (MaterialOverrideHelper.OverridesMaterials())
 				{
+					// Instance list index per material overrides combination, found on the first point using it
+					TArray<int32> CombinationToInstanceList;
+					CombinationToInstanceList.Init(INDEX_NONE, MaterialOverrideHelper.GetNumCombinations());
+
 					for (int32 PointIndex = 0; PointIndex < PointIndices.Num(); ++PointIndex)
 					{
 						const FTransform& InTransform = InTransformRange[PointIndices[PointIndex]];
-						const int64& InMetadataEntry = InMetadataEntryRange[PointIndices[PointIndex]];
-						FPCGMeshInstanceList& InstanceList = PCGMeshSelectorAttribute::GetInstanceList(OutMeshInstances, CurrentPartitionDescriptor, CurrentPartitionDescriptor.StaticMesh, MaterialOverrideHelper.GetMaterialOverrides(InMetadataEntry), bReverseTransform, InPointData, PartitionIndex);
+						const int32 CombinationId = MaterialOverrideHelper.GetCombinationId(PointIndices[PointIndex]);
+
+						int32& InstanceListIndex = CombinationToInstanceList[CombinationId];
+						if (InstanceListIndex == INDEX_NONE)
+						{
+							const FPCGMeshInstanceList& FoundInstanceList = PCGMeshSelectorAttribute::GetInstanceList(OutMeshInstances, CurrentPartitionDescriptor, CurrentPartitionDescriptor.StaticMesh, MaterialOverrideHelper.GetCombination(CombinationId), bReverseTransform, InPointData, PartitionIndex);
+							InstanceListIndex = UE_PTRDIFF_TO_INT32(&FoundInstanceList - OutMeshInstances.GetData());
+						}
+
+						FPCGMeshInstanceList& InstanceList = OutMeshInstances[InstanceListIndex];
 						InstanceList.Instances.Emplace(InTransform);
 						InstanceList.InstancesIndices.Emplace(PointIndices[PointIndex]);
 					}
@@ -9,6 +9,7 @@
 #include "Helpers/PCGHelpers.h"
 #include "MeshSelectors/PCGMeshSelectorBase.h"
 
+#include "Async/ParallelFor.h"
 #include "Engine/StaticMesh.h"
 #include "Math/RandomStream.h"
 
@@ -52,6 +53,75 @@ namespace PCGMeshSelectorWeighted
 
 		return NewInstanceList;
 	}
+
+	FWeightedPickTable::FWeightedPickTable(const TArray<int>& InCumulativeWeights)
+		: CumulativeWeights(InCumulativeWeights)
+		, TotalWeight(InCumulativeWeights.IsEmpty() ? 0 : InCumulativeWeights.Last())
+	{
+		const int32 NumEntries = CumulativeWeights.Num();
+		BucketFirstEntry.SetNumUninitialized(NumEntries);
+
+		int32 Entry = 0;
+		for (int32 Bucket = 0; Bucket < NumEntries; ++Bucket)
+		{
+			const int64 BucketStart = (static_cast<int64>(Bucket) * TotalWeight) / NumEntries;
+			while (CumulativeWeights[Entry] <= BucketStart)
+			{
+				++Entry;
+			}
+
+			BucketFirstEntry[Bucket] = Entry;
+		}
+	}
+
+	/** Identifies the instance list of a point, with its material overrides combination. */
+	struct FPointBucketKey
+	{
+		int32 PickIndex = INDEX_NONE;
+		int32 CombinationId = 0;
+		bool bReverseCulling = false;
+
+		bool operator==(const FPointBucketKey& Other) const
+		{
+			return PickIndex == Other.PickIndex && CombinationId == Other.CombinationId && bReverseCulling == Other.bReverseCulling;
+		}
+
+		friend uint32 GetTypeHash(const FPointBucketKey& Key)
+		{
+			return HashCombineFast(HashCombineFast(GetTypeHash(Key.PickIndex), GetTypeHash(Key.CombinationId)), GetTypeHash(Key.bReverseCulling));
+		}
+	};
+
+	/** Identifies an instance list within a pick, same as the comparison in GetInstanceList. */
+	struct FInstanceListKey
+	{
+		TArray<TSoftObjectPtr<UMaterialInterface>> MaterialOverrides;
+		bool bReverseCulling = false;
+
+		bool operator==(const FInstanceListKey& Other) const
+		{
+			return bReverseCulling == Other.bReverseCulling && MaterialOverrides == Other.MaterialOverrides;
+		}
+
+		friend uint32 GetTypeHash(const FInstanceListKey& Key)
+		{
+			uint32 Hash = GetTypeHash(Key.bReverseCulling);
+			for (const TSoftObjectPtr<UMaterialInterface>& Material : Key.MaterialOverrides)
+			{
+				Hash = HashCombineFast(Hash, GetTypeHash(Material));
+			}
+
+			return Hash;
+		}
+	};
+
+	/** Points of a chunk, bucketed by key in order of first appearance. */
+	struct FPointChunk
+	{
+		TArray<FPointBucketKey> BucketKeys;
+		TArray<TArray<int32>> BucketPointIndices;
+		TArray<int32> PointBuckets;
+	};
 }
 
 FPCGMeshSelectorWeightedEntry::FPCGMeshSelectorWeightedEntry(TSoftObjectPtr<UStaticMesh> InMesh, int InWeight)
@@ -162,6 +232,10 @@ bool UPCGMeshSelectorWeighted::SelectMeshInstances(
 	if (!MaterialOverrideHelper.IsInitialized())
 	{
 		MaterialOverrideHelper.Initialize(Context, bUseAttributeMaterialOverrides, MaterialOverrideAttributes, InPointData->Metadata);
+		if (MaterialOverrideHelper.IsValid())
+		{
+			MaterialOverrideHelper.ResolveCombinations(InPointData);
+		}
 	}
 
 	if (!MaterialOverrideHelper.IsValid())
@@ -202,83 +276,226 @@ bool UPCGMeshSelectorWeighted::SelectMeshInstances(
 	// Assign points to entries
 	{
 		TRACE_CPUPROFILER_EVENT_SCOPE(FPCGStaticMeshSpawnerElement::Execute::SelectEntries);
-		
-		const FConstPCGPointValueRanges InRanges(InPointData);
 
-		int32 CurrentPointIndex = Context.CurrentPointIndex;
-		int32 LastCheckpointIndex = CurrentPointIndex;
-		constexpr int32 TimeSlicingCheckFrequency = 1024;
-		TMap<TSoftObjectPtr<UStaticMesh>, PCGMetadataValueKey>& MeshToValueKey = Context.MeshToValueKey;
+		using namespace PCGMeshSelectorWeighted;
+
+		const FConstPCGPointValueRanges InRanges(InPointData);
+		const FWeightedPickTable PickTable(CumulativeWeights);
 		const int32 TotalWeight = CumulativeWeights.Last();
+		const int32 NumPoints = InPointData->GetNumPoints();
+		const bool bWriteOutPoints = OutPointData && OutAttribute;
+		const IPCGGraphExecutionSource* ExecutionSource = Context.ExecutionSource.Get();
+		TMap<TSoftObjectPtr<UStaticMesh>, PCGMetadataValueKey>& MeshToValueKey = Context.MeshToValueKey;
 
-		while (CurrentPointIndex < InPointData->GetNumPoints())
+		// Instance lists are unique per material overrides and reverse culling, within a pick.
+		TArray<TMap<FInstanceListKey, int32>> InstanceListLookup;
+		InstanceListLookup.SetNum(MeshInstances.Num());
+		for (int32 PickIndex = 0; PickIndex < MeshInstances.Num(); ++PickIndex)
 		{
-			const int32 InPointIndex = CurrentPointIndex++;
+			for (int32 ListIndex = 0; ListIndex < MeshInstances[PickIndex].Num(); ++ListIndex)
+			{
+				const FPCGSoftISMComponentDescriptor& Descriptor = MeshInstances[PickIndex][ListIndex].Descriptor;
+				InstanceListLookup[PickIndex].FindOrAdd(FInstanceListKey{ Descriptor.OverrideMaterials, Descriptor.bReverseCulling }, ListIndex);
+			}
+		}
 
-			const FTransform& InTransform = InRanges.TransformRange[InPointIndex];
-			const int64& InMetadataEntry = InRanges.MetadataEntryRange[InPointIndex];
-			const int32& InSeed = InRanges.SeedRange[InPointIndex];
-			
-			FRandomStream RandomSource = PCGHelpers::GetRandomStreamFromSeed(InSeed, Settings, Context.ExecutionSource.Get());
-			const int RandomWeightedPick = RandomSource.RandRange(0, TotalWeight - 1);
+		TMap<FPointBucketKey, int32> BucketKeyToInstanceList;
 
-			int RandomPick = 0;
-			while(RandomPick < MeshInstances.Num() && CumulativeWeights[RandomPick] <= RandomWeightedPick)
+		auto FindOrAddInstanceList = [this, &MeshInstances, &InstanceListLookup, &BucketKeyToInstanceList, &MaterialOverrideHelper, InPointData](const FPointBucketKey& BucketKey) -> int32
+		{
+			if (const int32* ListIndex = BucketKeyToInstanceList.Find(BucketKey))
 			{
-				++RandomPick;
+				return *ListIndex;
 			}
 
-			if(RandomPick < MeshInstances.Num())
+			TArray<FPCGMeshInstanceList>& InstanceLists = MeshInstances[BucketKey.PickIndex];
+
+			FInstanceListKey ListKey;
+			ListKey.MaterialOverrides = bUseAttributeMaterialOverrides ? MaterialOverrideHelper.GetCombination(BucketKey.CombinationId) : InstanceLists[0].Descriptor.OverrideMaterials;
+			ListKey.bReverseCulling = BucketKey.bReverseCulling;
+
+			int32 ListIndex = INDEX_NONE;
+			if (const int32* ExistingListIndex = InstanceListLookup[BucketKey.PickIndex].Find(ListKey))
+			{
+				ListIndex = *ExistingListIndex;
+			}
+			else
 			{
-				const bool bNeedsReverseCulling = (InTransform.GetDeterminant() < 0);
-				FPCGMeshInstanceList& InstanceList = PCGMeshSelectorWeighted::GetInstanceList(MeshInstances[RandomPick], bUseAttributeMaterialOverrides, MaterialOverrideHelper.GetMaterialOverrides(InMetadataEntry), bNeedsReverseCulling, InPointData);
-				InstanceList.Instances.Emplace(InTransform);
-				InstanceList.InstancesIndices.Emplace(CurrentPointIndex - 1); // - 1 because it is already incremented.
+				FPCGSoftISMComponentDescriptor Descriptor = InstanceLists[0].Descriptor;
+				Descriptor.bReverseCulling = ListKey.bReverseCulling;
+				Descriptor.OverrideMaterials = ListKey.MaterialOverrides;
 
-				const TSoftObjectPtr<UStaticMesh>& Mesh = InstanceList.Descriptor.StaticMesh;
+				ListIndex = InstanceLists.Num();
+				InstanceLists.Emplace_GetRef(Descriptor).PointData = InPointData;
+				InstanceListLookup[BucketKey.PickIndex].Add(MoveTemp(ListKey), ListIndex);
+			}
+
+			BucketKeyToInstanceList.Add(BucketKey, ListIndex);
+			return ListIndex;
+		};
+
+		TArray<FPointChunk> Chunks;
+		TArray<int32> BucketInstanceLists;
+		TArray<PCGMetadataValueKey> BucketValueKeys;
+		TSet<TPair<int32, int32>> ChunkInstanceLists;
+		TArray<PCGMetadataEntryKey> OutEntryKeys;
+		TArray<PCGMetadataValueKey> OutValueKeys;
+
+		while (Context.CurrentPointIndex < NumPoints)
+		{
+			const int32 SliceStart = Context.CurrentPointIndex;
+			const int32 SliceEnd = FMath::Min(SliceStart + PointsPerChunk * ChunksPerSlice, NumPoints);
+			const int32 NumChunks = FMath::DivideAndRoundUp(SliceEnd - SliceStart, PointsPerChunk);
+			const int32 WriteStart = Context.CurrentWriteIndex;
+
+			Chunks.Reset();
+			Chunks.SetNum(NumChunks);
 
-				if (OutPointData && OutAttribute)
+			// Pick and bucket points in parallel. Every point gets a pick, so out points are written at the same offset as in points.
+			ParallelFor(NumChunks, [&](int32 ChunkIndex)
+			{
+				const int32 ChunkStart = SliceStart + ChunkIndex * PointsPerChunk;
+				const int32 ChunkEnd = FMath::Min(ChunkStart + PointsPerChunk, SliceEnd);
+
+				FPointChunk& Chunk = Chunks[ChunkIndex];
+				Chunk.PointBuckets.SetNumUninitialized(ChunkEnd - ChunkStart);
+
+				TMap<FPointBucketKey, int32> KeyToBucket;
+				FPointBucketKey Key;
+
+				for (int32 PointIndex = ChunkStart; PointIndex < ChunkEnd; ++PointIndex)
 				{
-					OutRanges.SetFromValueRanges(Context.CurrentWriteIndex, InRanges, InPointIndex);
+					FRandomStream RandomSource = PCGHelpers::GetRandomStreamFromSeed(InRanges.SeedRange[PointIndex], Settings, ExecutionSource);
+					Key.PickIndex = PickTable.Pick(RandomSource.RandRange(0, TotalWeight - 1));
+					Key.bReverseCulling = (InRanges.TransformRange[PointIndex].GetDeterminant() < 0);
+					Key.CombinationId = MaterialOverrideHelper.GetCombinationId(PointIndex);
 
-					PCGMetadataValueKey* OutValueKey = MeshToValueKey.Find(Mesh);
-					if (!OutValueKey)
+					int32 BucketIndex = INDEX_NONE;
+					if (const int32* ExistingBucketIndex = KeyToBucket.Find(Key))
+					{
+						BucketIndex = *ExistingBucketIndex;
+					}
+					else
 					{
-						PCGMetadataValueKey ValueKey = OutAttribute->AddValue(Mesh.ToSoftObjectPath().ToString());
-						OutValueKey = &MeshToValueKey.Add(Mesh, ValueKey);
+						BucketIndex = Chunk.BucketKeys.Add(Key);
+						Chunk.BucketPointIndices.Emplace();
+						KeyToBucket.Add(Key, BucketIndex);
 					}
 
-					check(OutValueKey);
+					Chunk.BucketPointIndices[BucketIndex].Add(PointIndex);
+					Chunk.PointBuckets[PointIndex - ChunkStart] = BucketIndex;
 
-					OutPointData->Metadata->InitializeOnSet(OutRanges.MetadataEntryRange[Context.CurrentWriteIndex]);
-					OutAttribute->SetValueFromValueKey(OutRanges.MetadataEntryRange[Context.CurrentWriteIndex], *OutValueKey);
+					if (bWriteOutPoints)
+					{
+						OutRanges.SetFromValueRanges(WriteStart + PointIndex - SliceStart, InRanges, PointIndex);
+					}
+				}
+			}, NumChunks > 1 ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
 
-					++Context.CurrentWriteIndex;
+			// Then concatenate the buckets in point order. Instance lists (and out values) are created in order of first appearance.
+			for (int32 ChunkIndex = 0; ChunkIndex < NumChunks; ++ChunkIndex)
+			{
+				const FPointChunk& Chunk = Chunks[ChunkIndex];
+				const int32 ChunkStart = SliceStart + ChunkIndex * PointsPerChunk;
+				const int32 NumBuckets = Chunk.BucketKeys.Num();
+
+				BucketInstanceLists.SetNumUninitialized(NumBuckets);
+				BucketValueKeys.SetNumUninitialized(NumBuckets);
+				ChunkInstanceLists.Reset();
+				bool bInstanceListsAreUnique = true;
 
-					if (Settings->bApplyMeshBoundsToPoints)
+				for (int32 BucketIndex = 0; BucketIndex < NumBuckets; ++BucketIndex)
+				{
+					const FPointBucketKey& BucketKey = Chunk.BucketKeys[BucketIndex];
+					const int32 ListIndex = FindOrAddInstanceList(BucketKey);
+					BucketInstanceLists[BucketIndex] = ListIndex;
+
+					bool bIsAlreadyInChunk = false;
+					ChunkInstanceLists.Add({ BucketKey.PickIndex, ListIndex }, &bIsAlreadyInChunk);
+					bInstanceListsAreUnique &= !bIsAlreadyInChunk;
+
+					if (bWriteOutPoints)
 					{
-						TArray<int32>& PointIndices = Context.MeshToOutPoints.FindOrAdd(Mesh).FindOrAdd(OutPointData);
-						// CurrentPointIndex - 1, because CurrentPointIndex is incremented at the beginning of the loop
-						PointIndices.Emplace(CurrentPointIndex - 1);
+						const TSoftObjectPtr<UStaticMesh>& Mesh = MeshInstances[BucketKey.PickIndex][ListIndex].Descriptor.StaticMesh;
+
+						PCGMetadataValueKey* OutValueKey = MeshToValueKey.Find(Mesh);
+						if (!OutValueKey)
+						{
+							PCGMetadataValueKey ValueKey = OutAttribute->AddValue(Mesh.ToSoftObjectPath().ToString());
+							OutValueKey = &MeshToValueKey.Add(Mesh, ValueKey);
+						}
+
+						BucketValueKeys[BucketIndex] = *OutValueKey;
 					}
 				}
-			}
 
-			// Check if we should stop here and continue in a subsequent call
-			if (CurrentPointIndex - LastCheckpointIndex >= TimeSlicingCheckFrequency)
-			{
-				if (Context.ShouldStop())
+				if (bInstanceListsAreUnique)
 				{
-					break;
+					for (int32 BucketIndex = 0; BucketIndex < NumBuckets; ++BucketIndex)
+					{
+						const TArray<int32>& PointIndices = Chunk.BucketPointIndices[BucketIndex];
+						FPCGMeshInstanceList& InstanceList = MeshInstances[Chunk.BucketKeys[BucketIndex].PickIndex][BucketInstanceLists[BucketIndex]];
+
+						InstanceList.Instances.Reserve(InstanceList.Instances.Num() + PointIndices.Num());
+						for (const int32 PointIndex : PointIndices)
+						{
+							InstanceList.Instances.Emplace(InRanges.TransformRange[PointIndex]);
+						}
+
+						InstanceList.InstancesIndices.Append(PointIndices);
+					}
 				}
 				else
 				{
-					LastCheckpointIndex = CurrentPointIndex;
+					// Several buckets resolved to the same instance list, append point by point to keep the point order.
+					for (int32 PointOffset = 0; PointOffset < Chunk.PointBuckets.Num(); ++PointOffset)
+					{
+						const int32 BucketIndex = Chunk.PointBuckets[PointOffset];
+						FPCGMeshInstanceList& InstanceList = MeshInstances[Chunk.BucketKeys[BucketIndex].PickIndex][BucketInstanceLists[BucketIndex]];
+						InstanceList.Instances.Emplace(InRanges.TransformRange[ChunkStart + PointOffset]);
+						InstanceList.InstancesIndices.Emplace(ChunkStart + PointOffset);
+					}
+				}
+
+				if (bWriteOutPoints)
+				{
+					for (int32 PointOffset = 0; PointOffset < Chunk.PointBuckets.Num(); ++PointOffset)
+					{
+						const int32 PointIndex = ChunkStart + PointOffset;
+						const int32 BucketIndex = Chunk.PointBuckets[PointOffset];
+
+						int64& OutMetadataEntry = OutRanges.MetadataEntryRange[WriteStart + PointIndex - SliceStart];
+						OutPointData->Metadata->InitializeOnSet(OutMetadataEntry);
+						OutEntryKeys.Add(OutMetadataEntry);
+						OutValueKeys.Add(BucketValueKeys[BucketIndex]);
+
+						if (Settings->bApplyMeshBoundsToPoints)
+						{
+							const TSoftObjectPtr<UStaticMesh>& Mesh = MeshInstances[Chunk.BucketKeys[BucketIndex].PickIndex][BucketInstanceLists[BucketIndex]].Descriptor.StaticMesh;
+							TArray<int32>& PointIndices = Context.MeshToOutPoints.FindOrAdd(Mesh).FindOrAdd(OutPointData);
+							PointIndices.Emplace(PointIndex);
+						}
+					}
 				}
 			}
-		}
 
-		Context.CurrentPointIndex = CurrentPointIndex;
+			if (bWriteOutPoints)
+			{
+				OutAttribute->SetValuesFromValueKeys(OutEntryKeys, OutValueKeys, /*bResetValueOnDefaultValueKey=*/false);
+				OutEntryKeys.Reset();
+				OutValueKeys.Reset();
+
+				Context.CurrentWriteIndex += SliceEnd - SliceStart;
+			}
+
+			Context.CurrentPointIndex = SliceEnd;
+
+			// Check if we should stop here and continue in a subsequent call
+			if (Context.ShouldStop())
+			{
+				break;
+			}
+		}
 	}
 
 	if (Context.CurrentPointIndex == InPointData->GetNumPoints())
@@ -149,6 +149,10 @@ bool UPCGMeshSelectorWeightedByCategory::SelectMeshInstances(
 	if (!MaterialOverrideHelper.IsInitialized())
 	{
 		MaterialOverrideHelper.Initialize(Context, bUseAttributeMaterialOverrides, MaterialOverrideAttributes, InPointData->Metadata);
+		if (MaterialOverrideHelper.IsValid())
+		{
+			MaterialOverrideHelper.ResolveCombinations(InPointData);
+		}
 	}
 
 	if (!MaterialOverrideHelper.IsValid())
@@ -193,6 +197,9 @@ bool UPCGMeshSelectorWeightedByCategory::SelectMeshInstances(
 	constexpr int32 TimeSlicingCheckFrequency = 1024;
 	TMap<TSoftObjectPtr<UStaticMesh>, PCGMetadataValueKey>& MeshToValueKey = Context.MeshToValueKey;
 
+	// Instance list index for each (category, pick, material overrides combination, reverse culling) already seen
+	TMap<TTuple<PCGMetadataValueKey, int32, int32, bool>, int32> PointKeyToInstanceList;
+
 	// Assign points to entries
 	const FConstPCGPointValueRanges InRanges(InPointData);
 
@@ -207,11 +214,13 @@ bool UPCGMeshSelectorWeightedByCategory::SelectMeshInstances(
 		const PCGMetadataValueKey ValueKey = Attribute->GetValueKey(InMetadataEntry);
 
 		// if no mesh list was processed for this attribute value, fallback to the default mesh list
+		PCGMetadataValueKey CategoryValueKey = ValueKey;
 		FPCGInstancesAndWeights* InstancesAndWeights = CategoryEntryToInstancesAndWeights.Find(ValueKey);
 		if (!InstancesAndWeights)
 		{
 			if (DefaultValueKey != PCGDefaultValueKey)
 			{
+				CategoryValueKey = DefaultValueKey;
 				InstancesAndWeights = CategoryEntryToInstancesAndWeights.Find(DefaultValueKey);
 				check(InstancesAndWeights);
 			}
@@ -235,7 +244,18 @@ bool UPCGMeshSelectorWeightedByCategory::SelectMeshInstances(
 		if(RandomPick < InstancesAndWeights->MeshInstances.Num())
 		{
 			const bool bNeedsReverseCulling = (InTransform.GetDeterminant() < 0);
-			FPCGMeshInstanceList& InstanceList = PCGMeshSelectorWeighted::GetInstanceList(InstancesAndWeights->MeshInstances[RandomPick], bUseAttributeMaterialOverrides, MaterialOverrideHelper.GetMaterialOverrides(InMetadataEntry), bNeedsReverseCulling, InPointData);
+			const int32 CombinationId = MaterialOverrideHelper.GetCombinationId(InPointIndex);
+			TArray<FPCGMeshInstanceList>& InstanceLists = InstancesAndWeights->MeshInstances[RandomPick];
+
+			const TTuple<PCGMetadataValueKey, int32, int32, bool> PointKey(CategoryValueKey, RandomPick, CombinationId, bNeedsReverseCulling);
+			int32* InstanceListIndex = PointKeyToInstanceList.Find(PointKey);
+			if (!InstanceListIndex)
+			{
+				const FPCGMeshInstanceList& FoundInstanceList = PCGMeshSelectorWeighted::GetInstanceList(InstanceLists, bUseAttributeMaterialOverrides, MaterialOverrideHelper.GetCombination(CombinationId), bNeedsReverseCulling, InPointData);
+				InstanceListIndex = &PointKeyToInstanceList.Add(PointKey, UE_PTRDIFF_TO_INT32(&FoundInstanceList - InstanceLists.GetData()));
+			}
+
+			FPCGMeshInstanceList& InstanceList = InstanceLists[*InstanceListIndex];
 			InstanceList.Instances.Emplace(InTransform);
 			InstanceList.InstancesIndices.Emplace(CurrentPointIndex - 1); // - 1 because it is already incremented.
 
@@ -135,6 +135,10 @@ bool UPCGSkinnedMeshSelector::SelectInstances(
 	if (!MaterialOverrideHelper.IsInitialized())
 	{
 		MaterialOverrideHelper.Initialize(Context, bUseAttributeMaterialOverrides, {} /*TemplateDescriptor.OverrideMaterials*/, MaterialOverrideAttributes, InPointData->Metadata);
+		if (MaterialOverrideHelper.IsValid())
+		{
+			MaterialOverrideHelper.ResolveCombinations(InPointData);
+		}
 	}
 
 	if (!MaterialOverrideHelper.IsValid())
@@ -297,20 +301,33 @@ bool UPCGSkinnedMeshSelector::SelectInstances(
 			{
 				if (MaterialOverrideHelper.OverridesMaterials())
 				{
+					// Instance list index per material overrides combination, found on the first point using it
+					TArray<int32> CombinationToInstanceList;
+					CombinationToInstanceList.Init(INDEX_NONE, MaterialOverrideHelper.GetNumCombinations());
+
 					for (int32 PointIndex = 0; PointIndex < PointIndices.Num(); ++PointIndex)
 					{
 						const int32 InstanceToPoint = PointIndices[PointIndex];
 
 						const FPCGPoint& Point = Points[InstanceToPoint];
-						FPCGSkinnedMeshInstanceList& InstanceList = PCGSkinnedMeshSelector::GetInstanceList(
-							OutMeshInstances,
-							CurrentPartitionDescriptor,
-							CurrentPartitionDescriptor.SkinnedAsset,
-							MaterialOverrideHelper.GetMaterialOverrides(Point.MetadataEntry),
-							bReverseTransform,
-							InPointData,
-							PartitionIndex
-						);
+						const int32 CombinationId = MaterialOverrideHelper.GetCombinationId(InstanceToPoint);
+
+						int32& InstanceListIndex = CombinationToInstanceList[CombinationId];
+						if (InstanceListIndex == INDEX_NONE)
+						{
+							const FPCGSkinnedMeshInstanceList& FoundInstanceList = PCGSkinnedMeshSelector::GetInstanceList(
+								OutMeshInstances,
+								CurrentPartitionDescriptor,
+								CurrentPartitionDescriptor.SkinnedAsset,
+								MaterialOverrideHelper.GetCombination(CombinationId),
+								bReverseTransform,
+								InPointData,
+								PartitionIndex
+							);
+							InstanceListIndex = UE_PTRDIFF_TO_INT32(&FoundInstanceList - OutMeshInstances.GetData());
+						}
+
+						FPCGSkinnedMeshInstanceList& InstanceList = OutMeshInstances[InstanceListIndex];
 
 						FSoftAnimBankItem BankItem;
 						{
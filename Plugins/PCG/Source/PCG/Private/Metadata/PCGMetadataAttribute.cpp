@@ -3,10 +3,16 @@
 #include "Metadata/PCGMetadataAttribute.h"
 #include "Metadata/PCGMetadata.h"
 
+#include "Algo/Count.h"
+#include "Async/ParallelFor.h"
+
 namespace PCGMetadataAttributeBase
 {
 	static constexpr TCHAR AllowedSpecialCharacters[4] = {' ', '_', '-', '/'};
 
+	/** Unset entries allowed in a dense span on top of one per set entry, so small or half filled ranges still use dense storage. */
+	static constexpr int64 DenseSpanSlack = 64;
+
 	bool IsValidNameCharacter(TCHAR Character)
 	{
 		if (FChar::IsAlpha(Character) || FChar::IsDigit(Character))
@@ -53,7 +59,24 @@ PRAGMA_ENABLE_DEPRECATION_WARNINGS
 
 void FPCGMetadataAttributeBase::Serialize(FPCGMetadataDomain* InMetadata, FArchive& InArchive)
 {
-	InArchive << EntryToValueKeyMap;
+	// Entries are always serialized as a map, dense storage is a runtime layout only.
+	if (EntryStorage == EPCGMetadataEntryStorage::Dense && !InArchive.IsLoading())
+	{
+		TMap<PCGMetadataEntryKey, PCGMetadataValueKey> EntryMap;
+		EntryMap.Reserve(NumDenseEntries);
+		ForEachLocalEntry_Unsafe([&EntryMap](PCGMetadataEntryKey EntryKey, PCGMetadataValueKey ValueKey) { EntryMap.Add(EntryKey, ValueKey); });
+		InArchive << EntryMap;
+	}
+	else
+	{
+		if (InArchive.IsLoading())
+		{
+			ResetEntries_Unsafe();
+		}
+
+		InArchive << EntryToValueKeyMap;
+	}
+
 	Metadata = InMetadata;
 
 	int32 ParentAttributeId = (Parent ? Parent->AttributeId : -1);
@@ -88,7 +111,73 @@ void FPCGMetadataAttributeBase::SetValueFromValueKey_Unsafe(PCGMetadataEntryKey
 		return;
 	}
 
-	if (ValueKey == PCGDefaultValueKey && bResetValueOnDefaultValueKey)
+	SetLocalValueKey_Unsafe(EntryKey, (ValueKey == PCGDefaultValueKey && bResetValueOnDefaultValueKey) ? PCGNotFoundValueKey : ValueKey);
+}
+
+void FPCGMetadataAttributeBase::SetLocalValueKey_Unsafe(PCGMetadataEntryKey EntryKey, PCGMetadataValueKey ValueKey)
+{
+	check(EntryKey != PCGInvalidEntryKey);
+
+	// Writer holds the write lock, readers of a sealed attribute don't take it (see Seal).
+	Unseal_Unsafe();
+
+	if (EntryStorage == EPCGMetadataEntryStorage::Dense)
+	{
+		if (DenseEntryToValueKeys.IsEmpty())
+		{
+			DenseEntryKeyOffset = EntryKey;
+		}
+
+		int64 Index = EntryKey - DenseEntryKeyOffset;
+		if (Index >= 0 && Index < DenseEntryToValueKeys.Num())
+		{
+			PCGMetadataValueKey& DenseValueKey = DenseEntryToValueKeys[Index];
+			NumDenseEntries += (ValueKey != PCGNotFoundValueKey ? 1 : 0) - (DenseValueKey != PCGNotFoundValueKey ? 1 : 0);
+			DenseValueKey = ValueKey;
+			return;
+		}
+
+		if (ValueKey == PCGNotFoundValueKey)
+		{
+			// Removing an entry that is not there.
+			return;
+		}
+
+		const PCGMetadataEntryKey MinKey = FMath::Min(EntryKey, DenseEntryKeyOffset);
+		const PCGMetadataEntryKey MaxKey = FMath::Max(EntryKey, DenseEntryKeyOffset + DenseEntryToValueKeys.Num() - 1);
+		if (IsDenseSpan(MinKey, MaxKey, NumDenseEntries + 1))
+		{
+			if (Index < 0)
+			{
+				DenseEntryToValueKeys.InsertUninitialized(0, static_cast<int32>(-Index));
+				for (int32 i = 0; i < -Index; ++i)
+				{
+					DenseEntryToValueKeys[i] = PCGNotFoundValueKey;
+				}
+
+				DenseEntryKeyOffset = EntryKey;
+				Index = 0;
+			}
+			else
+			{
+				const int32 OldNum = DenseEntryToValueKeys.Num();
+				DenseEntryToValueKeys.SetNumUninitialized(static_cast<int32>(Index) + 1, EAllowShrinking::No);
+				for (int32 i = OldNum; i < Index; ++i)
+				{
+					DenseEntryToValueKeys[i] = PCGNotFoundValueKey;
+				}
+			}
+
+			DenseEntryToValueKeys[Index] = ValueKey;
+			++NumDenseEntries;
+			return;
+		}
+
+		// Too scattered for a flat array anymore.
+		ConvertToSparse_Unsafe();
+	}
+
+	if (ValueKey == PCGNotFoundValueKey)
 	{
 		EntryToValueKeyMap.Remove(EntryKey);
 	}
@@ -98,6 +187,315 @@ void FPCGMetadataAttributeBase::SetValueFromValueKey_Unsafe(PCGMetadataEntryKey
 	}
 }
 
+bool FPCGMetadataAttributeBase::IsDenseSpan(PCGMetadataEntryKey InMinKey, PCGMetadataEntryKey InMaxKey, int32 InNumEntries)
+{
+	const int64 Span = InMaxKey - InMinKey + 1;
+	return InMinKey >= 0 && Span <= MAX_int32 && Span <= 2 * static_cast<int64>(InNumEntries) + PCGMetadataAttributeBase::DenseSpanSlack;
+}
+
+bool FPCGMetadataAttributeBase::ConvertToDense_Unsafe()
+{
+	if (EntryStorage == EPCGMetadataEntryStorage::Dense)
+	{
+		return true;
+	}
+
+	PCGMetadataEntryKey MinKey = 0;
+	PCGMetadataEntryKey MaxKey = -1;
+	if (!EntryToValueKeyMap.IsEmpty())
+	{
+		MinKey = MAX_int64;
+		MaxKey = MIN_int64;
+		for (const TPair<PCGMetadataEntryKey, PCGMetadataValueKey>& EntryValuePair : EntryToValueKeyMap)
+		{
+			MinKey = FMath::Min(MinKey, EntryValuePair.Key);
+			MaxKey = FMath::Max(MaxKey, EntryValuePair.Key);
+		}
+
+		if (!IsDenseSpan(MinKey, MaxKey, EntryToValueKeyMap.Num()))
+		{
+			return false;
+		}
+	}
+
+	DenseEntryToValueKeys.Init(PCGNotFoundValueKey, static_cast<int32>(MaxKey - MinKey + 1));
+	for (const TPair<PCGMetadataEntryKey, PCGMetadataValueKey>& EntryValuePair : EntryToValueKeyMap)
+	{
+		DenseEntryToValueKeys[EntryValuePair.Key - MinKey] = EntryValuePair.Value;
+	}
+
+	DenseEntryKeyOffset = MinKey;
+	NumDenseEntries = EntryToValueKeyMap.Num();
+	EntryToValueKeyMap.Empty();
+	EntryStorage = EPCGMetadataEntryStorage::Dense;
+
+	return true;
+}
+
+void FPCGMetadataAttributeBase::ConvertToSparse_Unsafe()
+{
+	Unseal_Unsafe();
+
+	if (EntryStorage == EPCGMetadataEntryStorage::Sparse)
+	{
+		return;
+	}
+
+	EntryToValueKeyMap.Reset();
+	EntryToValueKeyMap.Reserve(NumDenseEntries);
+	ForEachLocalEntry_Unsafe([this](PCGMetadataEntryKey EntryKey, PCGMetadataValueKey ValueKey) { EntryToValueKeyMap.Add(EntryKey, ValueKey); });
+
+	DenseEntryToValueKeys.Empty();
+	DenseEntryKeyOffset = 0;
+	NumDenseEntries = 0;
+	EntryStorage = EPCGMetadataEntryStorage::Sparse;
+}
+
+void FPCGMetadataAttributeBase::Unseal_Unsafe()
+{
+	if (bSealed.load(std::memory_order_relaxed))
+	{
+		bSealed.store(false, std::memory_order_relaxed);
+		SealedValueKeys.Empty();
+		SealedEntryKeyOffset = 0;
+	}
+}
+
+void FPCGMetadataAttributeBase::SetDenseEntries_Unsafe(TArray<PCGMetadataValueKey>&& InValueKeys, PCGMetadataEntryKey InEntryKeyOffset)
+{
+	Unseal_Unsafe();
+
+	EntryToValueKeyMap.Empty();
+	DenseEntryToValueKeys = MoveTemp(InValueKeys);
+	DenseEntryKeyOffset = InEntryKeyOffset;
+	NumDenseEntries = DenseEntryToValueKeys.Num() - Algo::Count(DenseEntryToValueKeys, PCGNotFoundValueKey);
+	EntryStorage = EPCGMetadataEntryStorage::Dense;
+}
+
+void FPCGMetadataAttributeBase::ResetEntries_Unsafe()
+{
+	Unseal_Unsafe();
+
+	EntryToValueKeyMap.Reset();
+	DenseEntryToValueKeys.Reset();
+	DenseEntryKeyOffset = 0;
+	NumDenseEntries = 0;
+	EntryStorage = EPCGMetadataEntryStorage::Sparse;
+}
+
+void FPCGMetadataAttributeBase::SetFlattenedEntries_Unsafe(TArray<PCGMetadataValueKey>&& InValueKeys, int32 InNumSetEntries)
+{
+	if (IsDenseSpan(0, InValueKeys.Num() - 1, InNumSetEntries))
+	{
+		SetDenseEntries_Unsafe(MoveTemp(InValueKeys), 0);
+		return;
+	}
+
+	ResetEntries_Unsafe();
+	EntryToValueKeyMap.Reserve(InNumSetEntries);
+	for (int32 EntryKey = 0; EntryKey < InValueKeys.Num(); ++EntryKey)
+	{
+		if (InValueKeys[EntryKey] != PCGNotFoundValueKey)
+		{
+			EntryToValueKeyMap.Add(EntryKey, InValueKeys[EntryKey]);
+		}
+	}
+}
+
+void FPCGMetadataAttributeBase::GetValueKeys_Parallel(TArrayView<const PCGMetadataEntryKey> EntryKeys, TArrayView<PCGMetadataValueKey> OutValueKeys) const
+{
+	check(EntryKeys.Num() == OutValueKeys.Num());
+
+	const int32 BatchSize = PCGMetadataAttributeConstants::FlattenBatchSize;
+	const int32 NumBatches = FMath::DivideAndRoundUp(EntryKeys.Num(), BatchSize);
+
+	ParallelFor(NumBatches, [this, EntryKeys, OutValueKeys, BatchSize](int32 BatchIndex)
+	{
+		const int32 Start = BatchIndex * BatchSize;
+		const int32 Count = FMath::Min(BatchSize, EntryKeys.Num() - Start);
+
+		TConstPCGValueRange<PCGMetadataEntryKey> BatchEntryKeys = PCGValueRangeHelpers::MakeConstValueRange<PCGMetadataEntryKey>(EntryKeys.Slice(Start, Count));
+		TArrayView<PCGMetadataValueKey> BatchValueKeys = OutValueKeys.Slice(Start, Count);
+
+		if (IsSealed() && GetValueKeys_Sealed(BatchEntryKeys, BatchValueKeys))
+		{
+			return;
+		}
+
+		TBitArray<> UnsetValues(true, Count);
+		GetValueKeys_Internal(BatchEntryKeys, BatchValueKeys, UnsetValues, /*bOwnerOfEntryKeysView=*/false);
+	}, NumBatches > 1 ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+}
+
+void FPCGMetadataAttributeBase::FlattenEntries(int64 NumEntries)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FPCGMetadataAttributeBase::FlattenEntries);
+
+	if (NumEntries <= 0 || !ensure(NumEntries <= MAX_int32))
+	{
+		return;
+	}
+
+	TArray<PCGMetadataEntryKey> EntryKeys;
+	EntryKeys.SetNumUninitialized(static_cast<int32>(NumEntries));
+	for (int32 i = 0; i < EntryKeys.Num(); ++i)
+	{
+		EntryKeys[i] = i;
+	}
+
+	// Get value using value inheritance as expected
+	TArray<PCGMetadataValueKey> ValueKeys;
+	ValueKeys.SetNumUninitialized(EntryKeys.Num());
+	GetValueKeys_Parallel(EntryKeys, ValueKeys);
+
+	FWriteScopeLock ScopeLock(EntryMapLock);
+	Unseal_Unsafe();
+
+	// Local entries outside of the range are kept as they are, through the regular setter.
+	bool bHasEntriesOutOfRange = false;
+	ForEachLocalEntry_Unsafe([&bHasEntriesOutOfRange, NumEntries](PCGMetadataEntryKey EntryKey, PCGMetadataValueKey)
+	{
+		bHasEntriesOutOfRange |= (EntryKey < 0 || EntryKey >= NumEntries);
+	});
+
+	if (bHasEntriesOutOfRange)
+	{
+		for (int32 EntryKey = 0; EntryKey < ValueKeys.Num(); ++EntryKey)
+		{
+			if (ValueKeys[EntryKey] != PCGDefaultValueKey)
+			{
+				SetLocalValueKey_Unsafe(EntryKey, ValueKeys[EntryKey]);
+			}
+		}
+
+		return;
+	}
+
+	// Concrete non-default values, plus the default value keys that were explicitly set locally.
+	const int32 BatchSize = PCGMetadataAttributeConstants::FlattenBatchSize;
+	const int32 NumBatches = FMath::DivideAndRoundUp(ValueKeys.Num(), BatchSize);
+	TArray<int32> NumSetEntriesPerBatch;
+	NumSetEntriesPerBatch.SetNumZeroed(NumBatches);
+
+	ParallelFor(NumBatches, [this, &ValueKeys, &NumSetEntriesPerBatch, BatchSize](int32 BatchIndex)
+	{
+		const int32 Start = BatchIndex * BatchSize;
+		const int32 End = FMath::Min(Start + BatchSize, ValueKeys.Num());
+
+		int32 NumSetEntries = 0;
+		for (int32 EntryKey = Start; EntryKey < End; ++EntryKey)
+		{
+			PCGMetadataValueKey& ValueKey = ValueKeys[EntryKey];
+			if (ValueKey == PCGDefaultValueKey && !FindLocalValueKey_Unsafe(EntryKey, ValueKey))
+			{
+				ValueKey = PCGNotFoundValueKey;
+			}
+			else
+			{
+				++NumSetEntries;
+			}
+		}
+
+		NumSetEntriesPerBatch[BatchIndex] = NumSetEntries;
+	}, NumBatches > 1 ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+
+	int32 NumSetEntries = 0;
+	for (const int32 NumBatchSetEntries : NumSetEntriesPerBatch)
+	{
+		NumSetEntries += NumBatchSetEntries;
+	}
+
+	SetFlattenedEntries_Unsafe(MoveTemp(ValueKeys), NumSetEntries);
+}
+
+bool FPCGMetadataAttributeBase::SetEntryStorage(EPCGMetadataEntryStorage InEntryStorage)
+{
+	FWriteScopeLock ScopeLock(EntryMapLock);
+	Unseal_Unsafe();
+
+	if (InEntryStorage == EPCGMetadataEntryStorage::Dense)
+	{
+		return ConvertToDense_Unsafe();
+	}
+
+	ConvertToSparse_Unsafe();
+	return true;
+}
+
+bool FPCGMetadataAttributeBase::Seal()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FPCGMetadataAttributeBase::Seal);
+
+	if (IsSealed())
+	{
+		return true;
+	}
+
+	// Without parent the local entries are all there is, unset entries have the default value.
+	if (!Parent)
+	{
+		FWriteScopeLock ScopeLock(EntryMapLock);
+		bSealed.store(true, std::memory_order_release);
+		return true;
+	}
+
+	int32 ParentDepth = 0;
+	for (const FPCGMetadataAttributeBase* Current = Parent; Current; Current = Current->Parent)
+	{
+		++ParentDepth;
+	}
+
+	// Range owned by this metadata domain, extended to the keys set on the attribute (if any).
+	PCGMetadataEntryKey FirstKey = 0;
+	PCGMetadataEntryKey EndKey = 0;
+	{
+		FReadScopeLock ScopeLock(EntryMapLock);
+		if (Metadata)
+		{
+			EndKey = Metadata->GetItemCountForChild();
+			FirstKey = EndKey - Metadata->GetLocalItemCount();
+		}
+
+		ForEachLocalEntry_Unsafe([&FirstKey, &EndKey](PCGMetadataEntryKey EntryKey, PCGMetadataValueKey)
+		{
+			FirstKey = FMath::Min(FirstKey, EntryKey);
+			EndKey = FMath::Max(EndKey, EntryKey + 1);
+		});
+	}
+
+	// Deep chains are flattened: the parent entries are resolved too, reads never go to the parents.
+	if (ParentDepth > PCGMetadataAttributeConstants::MaxSealedParentDepth)
+	{
+		FirstKey = 0;
+	}
+
+	if (EndKey - FirstKey > MAX_int32)
+	{
+		return false;
+	}
+
+	// Resolve every entry through the regular reads, walking the parents once in bulk. The local entries are left as they are.
+	TArray<PCGMetadataValueKey> ResolvedValueKeys;
+	if (EndKey > FirstKey)
+	{
+		TArray<PCGMetadataEntryKey> EntryKeys;
+		EntryKeys.SetNumUninitialized(static_cast<int32>(EndKey - FirstKey));
+		for (int32 i = 0; i < EntryKeys.Num(); ++i)
+		{
+			EntryKeys[i] = FirstKey + i;
+		}
+
+		GetValueKeys(TArrayView<PCGMetadataEntryKey>(EntryKeys), ResolvedValueKeys);
+	}
+
+	FWriteScopeLock ScopeLock(EntryMapLock);
+	SealedValueKeys = MoveTemp(ResolvedValueKeys);
+	SealedEntryKeyOffset = FirstKey;
+	bSealed.store(true, std::memory_order_release);
+
+	return true;
+}
+
 void FPCGMetadataAttributeBase::SetValuesFromValueKeys(const TArrayView<const TTuple<PCGMetadataEntryKey, PCGMetadataValueKey>>& EntryValuePairs, bool bResetValueOnDefaultValueKey)
 {
 	if (EntryValuePairs.IsEmpty())
@@ -150,13 +548,21 @@ PCGMetadataValueKey FPCGMetadataAttributeBase::GetValueKey(PCGMetadataEntryKey E
 	PCGMetadataValueKey ValueKey = PCGDefaultValueKey;
 	bool bFoundKey = false;
 
-	EntryMapLock.ReadLock();
-	if (const PCGMetadataValueKey* FoundLocalKey = EntryToValueKeyMap.Find(EntryKey))
+	if (IsSealed())
 	{
-		ValueKey = *FoundLocalKey;
-		bFoundKey = true;
+		if (FindSealedValueKey(EntryKey, ValueKey))
+		{
+			return ValueKey;
+		}
+
+		bFoundKey = FindLocalValueKey_Unsafe(EntryKey, ValueKey);
+	}
+	else
+	{
+		EntryMapLock.ReadLock();
+		bFoundKey = FindLocalValueKey_Unsafe(EntryKey, ValueKey);
+		EntryMapLock.ReadUnlock();
 	}
-	EntryMapLock.ReadUnlock();
 
 	if (!bFoundKey && Parent)
 	{
@@ -181,6 +587,12 @@ void FPCGMetadataAttributeBase::GetValueKeys(TConstPCGValueRange<PCGMetadataEntr
 	}
 
 	OutValueKeys.SetNumUninitialized(EntryKeys.Num());
+
+	if (IsSealed() && GetValueKeys_Sealed(EntryKeys, OutValueKeys))
+	{
+		return;
+	}
+
 	// Bitset with all unset values. If we have any unset value, we will ask the parent for those.
 	TBitArray<> UnsetValues(true, EntryKeys.Num());
 
@@ -200,12 +612,33 @@ void FPCGMetadataAttributeBase::GetValueKeys(TPCGValueRange<PCGMetadataEntryKey>
 	}
 
 	OutValueKeys.SetNumUninitialized(EntryKeys.Num());
+
+	if (IsSealed() && GetValueKeys_Sealed(PCGValueRangeHelpers::MakeConstValueRange(EntryKeys), OutValueKeys))
+	{
+		return;
+	}
+
 	// Bitset with all unset values. If we have any unset value, we will ask the parent for those.
 	TBitArray<> UnsetValues(true, EntryKeys.Num());
 
 	GetValueKeys_Internal(PCGValueRangeHelpers::MakeConstValueRange(EntryKeys), OutValueKeys, UnsetValues, /*bOwnerOfEntryKeysView=*/true);
 }
 
+bool FPCGMetadataAttributeBase::GetValueKeys_Sealed(TConstPCGValueRange<PCGMetadataEntryKey> EntryKeys, TArrayView<PCGMetadataValueKey> OutValueKeys) const
+{
+	check(EntryKeys.Num() == OutValueKeys.Num());
+
+	for (int32 Index = 0; Index < EntryKeys.Num(); ++Index)
+	{
+		if (!FindSealedValueKey(EntryKeys[Index], OutValueKeys[Index]))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
 void FPCGMetadataAttributeBase::GetValueKeys_Internal(TConstPCGValueRange<PCGMetadataEntryKey> EntryKeys, TArrayView<PCGMetadataValueKey> OutValueKeys, TBitArray<>& UnsetValues, bool bOwnerOfEntryKeysView) const
 {
 	check(EntryKeys.Num() == OutValueKeys.Num() && OutValueKeys.Num() == UnsetValues.Num());
@@ -217,7 +650,12 @@ void FPCGMetadataAttributeBase::GetValueKeys_Internal(TConstPCGValueRange<PCGMet
 		return;
 	}
 
-	EntryMapLock.ReadLock();
+	// Sealed attributes are not written anymore, their entries are read without lock.
+	const bool bLockFree = IsSealed();
+	if (!bLockFree)
+	{
+		EntryMapLock.ReadLock();
+	}
 
 	for (; It; ++It)
 	{
@@ -234,9 +672,9 @@ void FPCGMetadataAttributeBase::GetValueKeys_Internal(TConstPCGValueRange<PCGMet
 		{
 			SetValueKey(PCGDefaultValueKey);
 		}
-		else if (const PCGMetadataValueKey* FoundLocalKey = EntryToValueKeyMap.Find(EntryKey))
+		else if (PCGMetadataValueKey LocalValueKey; FindLocalValueKey_Unsafe(EntryKey, LocalValueKey))
 		{
-			SetValueKey(*FoundLocalKey);
+			SetValueKey(LocalValueKey);
 		}
 		else if (!Parent)
 		{
@@ -248,7 +686,10 @@ void FPCGMetadataAttributeBase::GetValueKeys_Internal(TConstPCGValueRange<PCGMet
 		}
 	}
 
-	EntryMapLock.ReadUnlock();
+	if (!bLockFree)
+	{
+		EntryMapLock.ReadUnlock();
+	}
 
 	ensure(Parent || bFoundAllKeys);
 
@@ -285,7 +726,7 @@ bool FPCGMetadataAttributeBase::HasNonDefaultValue(PCGMetadataEntryKey EntryKey)
 
 void FPCGMetadataAttributeBase::ClearEntries()
 {
-	EntryToValueKeyMap.Reset();
+	ResetEntries_Unsafe();
 }
 
 bool FPCGMetadataAttributeBase::IsValidName(const FString& Name)
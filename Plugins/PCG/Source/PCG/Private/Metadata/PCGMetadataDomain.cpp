@@ -6,6 +6,7 @@
 #include "PCGElement.h"
 #include "Elements/Metadata/PCGMetadataElementCommon.h"
 #include "Metadata/PCGMetadata.h"
+#include "Helpers/PCGCrcHelpers.h"
 #include "Helpers/PCGPropertyHelpers.h"
 
 #include "Algo/AnyOf.h"
@@ -239,6 +240,67 @@ void FPCGMetadataDomain::AddToCrc(FArchiveCrc32& Ar, const UPCGData* Data, bool
 		return;
 	}
 
+	if (PCGCrcHelpers::UseParallelCrc())
+	{
+		const int32 NumKeys = InputKeys->GetNum();
+		const IPCGAttributeAccessorKeys* Keys = InputKeys.Get();
+
+		TArray<TUniquePtr<const IPCGAttributeAccessor>> InputAccessors;
+		TArray<PCGCrcHelpers::FChunkedBuffer> Buffers;
+		InputAccessors.Reserve(AllAttributes.Num());
+		Buffers.Reserve(AllAttributes.Num());
+
+		// Serialize the names, then the values of all the attributes, chunked and hashed in parallel.
+		for (const FPCGMetadataAttributeBase* Attribute : AllAttributes)
+		{
+			Ar << const_cast<FName&>(Attribute->Name);
+
+			TUniquePtr<const IPCGAttributeAccessor> InputAccessor = PCGAttributeAccessorHelpers::CreateConstAccessor(Attribute, this);
+			if (!ensure(InputAccessor.IsValid()))
+			{
+				continue;
+			}
+
+			PCGCrcHelpers::FChunkedBuffer& Buffer = Buffers.Emplace_GetRef();
+			Buffer.NumValues = NumKeys;
+			Buffer.ChunkCrc = [Accessor = InputAccessor.Get(), Keys](int32 StartIndex, int32 Count)
+			{
+				FArchiveCrc32 ChunkAr;
+
+				auto Callback = [Accessor, Keys, StartIndex, Count, &ChunkAr](auto&& Dummy)
+				{
+					using AttributeType = std::decay_t<decltype(Dummy)>;
+					TArray<AttributeType> Values;
+					if constexpr (std::is_trivially_copyable_v<AttributeType>)
+					{
+						Values.SetNumUninitialized(Count);
+					}
+					else
+					{
+						Values.SetNum(Count);
+					}
+
+					Accessor->GetRange<AttributeType>(Values, StartIndex, *Keys);
+
+					for (AttributeType& Value : Values)
+					{
+						PCG::Private::Serialize(ChunkAr, Value);
+					}
+				};
+
+				PCGMetadataAttribute::CallbackWithRightType(Accessor->GetUnderlyingType(), Callback);
+
+				return ChunkAr.GetCrc();
+			};
+
+			InputAccessors.Add(MoveTemp(InputAccessor));
+		}
+
+		PCGCrcHelpers::AddChunkedBuffersToCrc(Ar, Buffers);
+
+		return;
+	}
+
 	// Then for each attribute, serialize the name and its values.
 	for (const FPCGMetadataAttributeBase* Attribute : AllAttributes)
 	{
@@ -543,35 +605,29 @@ void FPCGMetadataDomain::FlattenImpl()
 	const int32 NumEntries = GetItemCountForChild();
 
 	AttributeLock.WriteLock();
-	for (auto& AttributePair : Attributes)
+	TArray<FPCGMetadataAttributeBase*> AttributesToFlatten;
+	Attributes.GenerateValueArray(AttributesToFlatten);
+
+	// Attributes don't share any state, flatten them in parallel. Large attributes also flatten their entries and values in parallel.
+	ParallelFor(AttributesToFlatten.Num(), [&AttributesToFlatten, NumEntries](int32 AttributeIndex)
 	{
-		FPCGMetadataAttributeBase* Attribute = AttributePair.Value;
+		FPCGMetadataAttributeBase* Attribute = AttributesToFlatten[AttributeIndex];
 		check(Attribute);
 
-		// For all stored entries (from the root), we need to make sure that entries that should have a concrete value have it
-		// Optimization notes:
-		// - we could skip entries that existed prior to attribute existence, etc.
-		// - we could skip entries that have no parent, but that would require checking against the parent entries in the parent hierarchy
-		for (int64 EntryKey = 0; EntryKey < NumEntries; ++EntryKey)
-		{
-			// Get value using value inheritance as expected
-			PCGMetadataValueKey ValueKey = Attribute->GetValueKey(EntryKey);
-			if (ValueKey != PCGDefaultValueKey)
-			{
-				// Set concrete non-default value
-				Attribute->SetValueFromValueKey(EntryKey, ValueKey);
-			}
-		}
+		// For all stored entries (from the root), make sure that entries that should have a concrete value have it
+		Attribute->FlattenEntries(NumEntries);
 
 		// Finally, flatten values
 		Attribute->Flatten();
-	}
+	}, AttributesToFlatten.Num() > 1 ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
 	AttributeLock.WriteUnlock();
 
 	Parent = nullptr;
 	ParentKeys.Reset();
 	ParentKeys.Init(PCGInvalidEntryKey, NumEntries);
 	ItemKeyOffset = 0;
+
+	SealAttributes();
 }
 
 bool FPCGMetadataDomain::FlattenAndCompress(const TArrayView<const PCGMetadataEntryKey>& InEntryKeysToKeep)
@@ -593,13 +649,16 @@ bool FPCGMetadataDomain::FlattenAndCompress(const TArrayView<const PCGMetadataEn
 	}
 
 	AttributeLock.WriteLock();
-	for (auto& AttributePair : Attributes)
+	TArray<FPCGMetadataAttributeBase*> AttributesToCompress;
+	Attributes.GenerateValueArray(AttributesToCompress);
+
+	ParallelFor(AttributesToCompress.Num(), [&AttributesToCompress, &EntryKeysToKeep](int32 AttributeIndex)
 	{
-		FPCGMetadataAttributeBase* Attribute = AttributePair.Value;
+		FPCGMetadataAttributeBase* Attribute = AttributesToCompress[AttributeIndex];
 		check(Attribute);
 
 		Attribute->FlattenAndCompress(EntryKeysToKeep);
-	}
+	}, AttributesToCompress.Num() > 1 ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
 	AttributeLock.WriteUnlock();
 
 	Parent = nullptr;
@@ -607,9 +666,25 @@ bool FPCGMetadataDomain::FlattenAndCompress(const TArrayView<const PCGMetadataEn
 	ParentKeys.Init(PCGInvalidEntryKey, EntryKeysToKeep.Num());
 	ItemKeyOffset = 0;
 
+	SealAttributes();
+
 	return true;
 }
 
+void FPCGMetadataDomain::SealAttributes()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FPCGMetadataDomain::SealAttributes);
+
+	// Attributes have no parent anymore, sealing only marks them: nothing is resolved or allocated. Any later write unseals the attribute it touches.
+	AttributeLock.ReadLock();
+	for (TPair<FName, FPCGMetadataAttributeBase*>& AttributePair : Attributes)
+	{
+		check(AttributePair.Value);
+		AttributePair.Value->Seal();
+	}
+	AttributeLock.ReadUnlock();
+}
+
 void FPCGMetadataDomain::AddAttributeInternal(FName AttributeName, FPCGMetadataAttributeBase* Attribute)
 {
 	// This call assumes we have a write lock on the attribute map.
@@ -15,7 +15,7 @@
 #include "Metadata/Accessors/PCGAttributeAccessorHelpers.h"
 #include "Metadata/Accessors/PCGAttributeAccessorKeys.h"
 
-#include "Algo/IndexOf.h"
+#include "Algo/Sort.h"
 #include "UObject/Package.h"
 #include "UObject/UObjectGlobals.h"
 
@@ -23,82 +23,85 @@
 
 namespace PCGMetadataPartitionCommon
 {
-	template <typename T> 
-	constexpr bool IsBitArray = std::is_same_v<T, TBitArray<>>;
+	/** Partition index of every entry. Partitions are numbered in the order they must be output. */
+	struct FPartitionIds
+	{
+		TArray<int32> EntryPartitions;
+		int32 NumPartitions = 0;
 
-	/**
-	* Partition a given attribute, by first partitioning all value keys that point to the same value
-	* and then for each unique value key, list of index in the keys that match for this value.
-	*/
-	template <typename PartitionType>
-	TArray<PartitionType> AttributePartition(const FPCGMetadataAttributeBase* InAttribute, const IPCGAttributeAccessorKeys& InKeys, FPCGContext* InOptionalContext)
+		/** Value key partitions also output a slot for every unused value key, as empty partitions in front. Kept so partition indices don't change. */
+		int32 NumLeadingEmptyPartitions = 0;
+	};
+
+	/** Types where MetadataTraits::Equal is exact equality. Other types are compared with a tolerance, and need a merge after hashing. */
+	template <typename T>
+	constexpr bool HasExactEquality = std::is_integral_v<T> || std::is_same_v<T, FString> || std::is_same_v<T, FName> || std::is_same_v<T, FSoftObjectPath> || std::is_same_v<T, FSoftClassPath>;
+
+	/** Hash values with the metadata hash traits. */
+	template <typename T>
+	struct TPartitionKeyFuncs : BaseKeyFuncs<TPair<T, int32>, T, /*bInAllowDuplicateKeys=*/false>
 	{
-		TRACE_CPUPROFILER_EVENT_SCOPE(PCGMetadataPartitionCommon::AttributePartition);
-		check(InAttribute);
+		static const T& GetSetKey(const TPair<T, int32>& Element) { return Element.Key; }
+		static bool Matches(const T& A, const T& B) { return A == B; }
+		static uint32 GetKeyHash(const T& Key) { return PCG::Private::MetadataTraits<T>::Hash(Key); }
+	};
 
-		const int32 NumberOfEntries = InKeys.GetNum();
+	/** Build the index partitions from the partition ids. Indices are in stable order in each partition. */
+	TArray<TArray<int32>> BuildPartitions(const FPartitionIds& InIds)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(PCGMetadataPartitionCommon::BuildPartitions);
 
-		if (NumberOfEntries <= 0)
+		if (InIds.EntryPartitions.IsEmpty())
 		{
 			return {};
 		}
 
-		// Get all value keys (-1 + 0 - N)
-		const int64 MetadataValueKeyCount = InAttribute->GetValueKeyOffsetForChild();
-
-		// For every value key, check if it should be merged with the default value
-		TMap<PCGMetadataValueKey, int32> ValueKeyMapping;
-		ValueKeyMapping.Reserve(MetadataValueKeyCount);
+		TArray<int32> PartitionSizes;
+		PartitionSizes.SetNumZeroed(InIds.NumPartitions);
+		for (const int32 PartitionId : InIds.EntryPartitions)
+		{
+			++PartitionSizes[PartitionId];
+		}
 
-		int32 NumUniqueValueKeys = 0;
+		TArray<TArray<int32>> Partitions;
+		Partitions.SetNum(InIds.NumLeadingEmptyPartitions + InIds.NumPartitions);
 
-		const bool bUsesValueKeys = InAttribute->UsesValueKeys();
+		for (int32 PartitionId = 0; PartitionId < InIds.NumPartitions; ++PartitionId)
+		{
+			Partitions[InIds.NumLeadingEmptyPartitions + PartitionId].Reserve(PartitionSizes[PartitionId]);
+		}
 
-		if (!bUsesValueKeys)
+		for (int32 EntryIndex = 0; EntryIndex < InIds.EntryPartitions.Num(); ++EntryIndex)
 		{
-			TArray<PCGMetadataValueKey> UniqueValueKeys;
+			Partitions[InIds.NumLeadingEmptyPartitions + InIds.EntryPartitions[EntryIndex]].Add(EntryIndex);
+		}
 
-			for (PCGMetadataValueKey ValueKey = 0; ValueKey < MetadataValueKeyCount; ++ValueKey)
-			{
-				if (InAttribute->IsEqualToDefaultValue(ValueKey))
-				{
-					ValueKeyMapping.Add(ValueKey, -1);
-					continue;
-				}
+		return Partitions;
+	}
 
-				// TODO: Might want to upgrade to something better since it can be quadratic and grow quickly.
-				int32 UniqueValueKeyIndex = Algo::IndexOfByPredicate(UniqueValueKeys, [ValueKey, InAttribute](const PCGMetadataValueKey& Key)
-				{
-					return InAttribute->AreValuesEqual(ValueKey, Key);
-				});
+	/**
+	* Partition a given attribute on its value keys, since attributes that compress their data store each unique value once.
+	* Partitions are numbered by first occurrence, with the unused value keys output as empty partitions in front.
+	*/
+	void AttributePartition(const FPCGMetadataAttributeBase* InAttribute, const IPCGAttributeAccessorKeys& InKeys, FPartitionIds& OutIds)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(PCGMetadataPartitionCommon::AttributePartition);
+		check(InAttribute && InAttribute->UsesValueKeys());
 
-				if (UniqueValueKeyIndex == INDEX_NONE)
-				{
-					ValueKeyMapping.Add(ValueKey, UniqueValueKeys.Num());
-					UniqueValueKeys.Add(ValueKey);
-					NumUniqueValueKeys++;
-				}
-				else
-				{
-					ValueKeyMapping.Add(ValueKey, UniqueValueKeyIndex);
-				}
-			}
-		}
-		else
-		{
-			NumUniqueValueKeys = MetadataValueKeyCount;
-		}
+		const int32 NumberOfEntries = InKeys.GetNum();
 
-		TArray<PartitionType> PartitionedData;
-		PartitionedData.SetNum(1 + NumUniqueValueKeys);
-		if constexpr (IsBitArray<PartitionType>)
+		if (NumberOfEntries <= 0)
 		{
-			for (PartitionType& Partition : PartitionedData)
-			{
-				Partition.Init(false, NumberOfEntries);
-			}
+			return;
 		}
 
+		// Dense value key to partition mapping, value keys going from -1 (default) to N - 1.
+		const int64 MetadataValueKeyCount = InAttribute->GetValueKeyOffsetForChild();
+		TArray<int32> ValueKeyPartitions;
+		ValueKeyPartitions.Init(INDEX_NONE, 1 + MetadataValueKeyCount);
+
+		OutIds.EntryPartitions.SetNumUninitialized(NumberOfEntries);
+
 		constexpr int32 ChunkSize = 256;
 		TArray<const PCGMetadataEntryKey*, TInlineAllocator<ChunkSize>> TempEntries;
 		TempEntries.SetNum(ChunkSize);
@@ -114,128 +117,187 @@ namespace PCGMetadataPartitionCommon
 
 			for (int32 j = 0; j < Range; ++j)
 			{
-				PCGMetadataValueKey ValueKey = InAttribute->GetValueKey(*TempEntries[j]);
-				// Remap if not using value keys
-				if (!bUsesValueKeys && ValueKey != PCGDefaultValueKey)
+				int32& PartitionId = ValueKeyPartitions[1 + InAttribute->GetValueKey(*TempEntries[j])];
+				if (PartitionId == INDEX_NONE)
 				{
-					ValueKey = ValueKeyMapping[ValueKey];
+					PartitionId = OutIds.NumPartitions++;
 				}
 
-				const int32 PartitionDataIndex = 1 + ValueKey;
-				if constexpr (IsBitArray<PartitionType>)
-				{
-					PartitionedData[PartitionDataIndex][StartIndex + j] = true;
-				}
-				else
-				{
-					PartitionedData[PartitionDataIndex].Add(StartIndex + j);
-				}
+				OutIds.EntryPartitions[StartIndex + j] = PartitionId;
 			}
 		}
 
-		// Since we partition on the value array, it is not guaranteed that the values appears in the same order than the entries.
-		// So sort the final array using the first index as a sort criteria. Empty partitions will be at the beginning too.
-		if constexpr (IsBitArray<PartitionType>)
+		OutIds.NumLeadingEmptyPartitions = ValueKeyPartitions.Num() - OutIds.NumPartitions;
+	}
+
+	/** Partition integral values by sorting (value, index) pairs: each run of equal values is a partition, starting at its first occurrence. */
+	template <typename T>
+	void ValuePartitionBySorting(TConstArrayView<T> InValues, FPartitionIds& OutIds)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(PCGMetadataPartitionCommon::ValuePartitionBySorting);
+
+		TArray<int32> SortedEntries;
+		SortedEntries.SetNumUninitialized(InValues.Num());
+		for (int32 EntryIndex = 0; EntryIndex < InValues.Num(); ++EntryIndex)
+		{
+			SortedEntries[EntryIndex] = EntryIndex;
+		}
+
+		Algo::Sort(SortedEntries, [&InValues](int32 A, int32 B)
+		{
+			return InValues[A] < InValues[B] || (InValues[A] == InValues[B] && A < B);
+		});
+
+		struct FRun
+		{
+			int32 FirstEntry = 0;
+			int32 Start = 0;
+			int32 End = 0;
+		};
+
+		TArray<FRun> Runs;
+		for (int32 SortedIndex = 0; SortedIndex < SortedEntries.Num(); ++SortedIndex)
 		{
-			Algo::Sort(PartitionedData, [](const TBitArray<>& LHS, const TBitArray<>& RHS) -> bool
+			if (SortedIndex == 0 || InValues[SortedEntries[SortedIndex]] != InValues[SortedEntries[SortedIndex - 1]])
 			{
-				const int32 FirstBitSetLHS = LHS.Find(true);
-				if (FirstBitSetLHS == INDEX_NONE)
+				if (!Runs.IsEmpty())
 				{
-					return true;
+					Runs.Last().End = SortedIndex;
 				}
 
-				const int32 FirstBitSetRHS = RHS.Find(true);
-				if (FirstBitSetRHS == INDEX_NONE)
-				{
-					return false;
-				}
+				Runs.Add({ SortedEntries[SortedIndex], SortedIndex, SortedIndex });
+			}
+		}
+
+		Runs.Last().End = SortedEntries.Num();
+
+		// Number the partitions by first occurrence.
+		Algo::Sort(Runs, [](const FRun& A, const FRun& B) { return A.FirstEntry < B.FirstEntry; });
 
-				return  FirstBitSetLHS < FirstBitSetRHS;
-			});
+		OutIds.EntryPartitions.SetNumUninitialized(InValues.Num());
+		OutIds.NumPartitions = Runs.Num();
+
+		for (int32 PartitionId = 0; PartitionId < Runs.Num(); ++PartitionId)
+		{
+			for (int32 SortedIndex = Runs[PartitionId].Start; SortedIndex < Runs[PartitionId].End; ++SortedIndex)
+			{
+				OutIds.EntryPartitions[SortedEntries[SortedIndex]] = PartitionId;
+			}
 		}
-		else
+	}
+
+	/** Partition values with a hash map, numbering partitions by first occurrence. */
+	template <typename T>
+	void ValuePartitionByHashing(TConstArrayView<T> InValues, FPartitionIds& OutIds)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(PCGMetadataPartitionCommon::ValuePartitionByHashing);
+
+		TMap<T, int32, FDefaultSetAllocator, TPartitionKeyFuncs<T>> ValueToPartition;
+		TArray<int32> PartitionFirstEntries;
+
+		OutIds.EntryPartitions.SetNumUninitialized(InValues.Num());
+
+		for (int32 EntryIndex = 0; EntryIndex < InValues.Num(); ++EntryIndex)
 		{
-			PartitionedData.Sort([](const PartitionType& LHS, const PartitionType& RHS) -> bool
+			if (const int32* PartitionId = ValueToPartition.Find(InValues[EntryIndex]))
+			{
+				OutIds.EntryPartitions[EntryIndex] = *PartitionId;
+			}
+			else
 			{
-				if (LHS.IsEmpty())
+				const int32 NewPartitionId = PartitionFirstEntries.Add(EntryIndex);
+				ValueToPartition.Add(InValues[EntryIndex], NewPartitionId);
+				OutIds.EntryPartitions[EntryIndex] = NewPartitionId;
+			}
+		}
+
+		OutIds.NumPartitions = PartitionFirstEntries.Num();
+
+		if constexpr (!HasExactEquality<T>)
+		{
+			// Values compared with a tolerance: merge the exactly equal groups with MetadataTraits::Equal, matching each group against the
+			// first occurrence of the merged partitions in order. This gives the same result as matching every value against the unique values,
+			// but is only quadratic in the number of distinct values.
+			TArray<int32> MergedFirstEntries;
+			TArray<int32> PartitionRemap;
+			PartitionRemap.SetNumUninitialized(PartitionFirstEntries.Num());
+
+			for (int32 PartitionId = 0; PartitionId < PartitionFirstEntries.Num(); ++PartitionId)
+			{
+				const T& Value = InValues[PartitionFirstEntries[PartitionId]];
+				int32 MergedPartitionId = MergedFirstEntries.IndexOfByPredicate([&InValues, &Value](int32 OtherEntry)
 				{
-					return true;
-				}
-				else if (RHS.IsEmpty())
+					return PCG::Private::MetadataTraits<T>::Equal(Value, InValues[OtherEntry]);
+				});
+
+				if (MergedPartitionId == INDEX_NONE)
 				{
-					return false;
+					MergedPartitionId = MergedFirstEntries.Add(PartitionFirstEntries[PartitionId]);
 				}
-				else
+
+				PartitionRemap[PartitionId] = MergedPartitionId;
+			}
+
+			if (MergedFirstEntries.Num() != PartitionFirstEntries.Num())
+			{
+				for (int32& PartitionId : OutIds.EntryPartitions)
 				{
-					return LHS[0] < RHS[0];
+					PartitionId = PartitionRemap[PartitionId];
 				}
-			});
-		}
 
-		return PartitionedData;
+				OutIds.NumPartitions = MergedFirstEntries.Num();
+			}
+		}
 	}
 
 	/**
 	* Partition a given accessor that iterate on all values, find the identical ones,
 	* and then for each unique value, list of index in the keys that match for this value.
 	*/
-	template <typename PartitionType, typename T>
-	TArray<PartitionType> ValuePartition(const IPCGAttributeAccessor& InAccessor, const IPCGAttributeAccessorKeys& InKeys, FPCGContext* InOptionalContext)
+	template <typename T>
+	void ValuePartition(const IPCGAttributeAccessor& InAccessor, const IPCGAttributeAccessorKeys& InKeys, FPartitionIds& OutIds)
 	{
 		TRACE_CPUPROFILER_EVENT_SCOPE(PCGMetadataPartitionCommon::ValuePartition);
-		TArray<T> UniqueValues;
-		TArray<PartitionType> PartitionedData;
-
-		PCGMetadataElementCommon::ApplyOnAccessor<T>(InKeys, InAccessor, [&PartitionedData, &UniqueValues, NumberOfEntries = InKeys.GetNum()](const T& InValue, int32 InIndex)
-		{
-			// TODO: Might want to upgrade to something better since it can be quadratic and grow quickly.
-			int32 UniqueValueIndex = UniqueValues.IndexOfByPredicate([&InValue](const T& OtherValue)
-			{
-				// For consistency with the attribute part, use MetadataTraits::Equal
-				return PCG::Private::MetadataTraits<T>::Equal(InValue, OtherValue);
-			});
 
-			if (UniqueValueIndex == INDEX_NONE)
-			{
-				UniqueValueIndex = UniqueValues.Add(InValue);
-				PartitionType& Partition = PartitionedData.Emplace_GetRef();
-				if constexpr (IsBitArray<PartitionType>)
-				{
-					Partition.Init(false, NumberOfEntries);
-				}
-			}
+		TArray<T> Values;
+		Values.Reserve(InKeys.GetNum());
 
-			if constexpr (IsBitArray<PartitionType>)
-			{
-				PartitionedData[UniqueValueIndex][InIndex] = true;
-			}
-			else
-			{
-				PartitionedData[UniqueValueIndex].Add(InIndex);
-			}
+		PCGMetadataElementCommon::ApplyOnAccessorRange<T>(InKeys, InAccessor, [&Values](const TArrayView<T>& View, int32 Start, int32 Range)
+		{
+			Values.Append(View.GetData(), Range);
 		});
 
-		return PartitionedData;
+		if (Values.IsEmpty())
+		{
+			return;
+		}
+
+		if constexpr (std::is_integral_v<T>)
+		{
+			ValuePartitionBySorting<T>(Values, OutIds);
+		}
+		else
+		{
+			ValuePartitionByHashing<T>(Values, OutIds);
+		}
 	}
 
 	/**
 	* Dispatch the partition according to the data and selector.
 	*/
-	template <typename PartitionType>
-	TArray<PartitionType> AttributeGenericPartition(const UPCGData* InData, const FPCGAttributePropertySelector& InSelector, FPCGContext* InOptionalContext, bool bSilenceMissingAttributeErrors)
+	bool ComputePartitionIds(const UPCGData* InData, const FPCGAttributePropertySelector& InSelector, FPCGContext* InOptionalContext, bool bSilenceMissingAttributeErrors, FPartitionIds& OutIds)
 	{
 		TRACE_CPUPROFILER_EVENT_SCOPE(PCGMetadataPartitionCommon::AttributeGenericPartition::SingleSelector);
 		if (!InData)
 		{
-			return {};
+			return false;
 		}
 
 		TUniquePtr<const IPCGAttributeAccessorKeys> Keys = PCGAttributeAccessorHelpers::CreateConstKeys(InData, InSelector);
 		if (!Keys.IsValid())
 		{
 			PCGLog::LogErrorOnGraph(FText::Format(LOCTEXT("InvalidKeys", "Could not create keys for the input data with selector {0}"), InSelector.GetDisplayText()), InOptionalContext);
-			return {};
+			return false;
 		}
 
 		// Implementation note:
@@ -250,7 +312,7 @@ namespace PCGMetadataPartitionCommon
 			if (!Metadata)
 			{
 				PCGLog::LogErrorOnGraph(FText::Format(LOCTEXT("InvalidMetadata", "Input data does not have metadata, while requesting an attribute {0}"), InSelector.GetDisplayText()), InOptionalContext);
-				return {};
+				return false;
 			}
 
 			Attribute = Metadata->GetConstAttribute(InSelector.GetName());
@@ -261,7 +323,7 @@ namespace PCGMetadataPartitionCommon
 					PCGLog::LogErrorOnGraph(FText::Format(LOCTEXT("InvalidAttribute", "Attribute {0} not found"), InSelector.GetDisplayText()), InOptionalContext);
 				}
 
-				return {};
+				return false;
 			}
 
 			bUseAttributePartition = Attribute->UsesValueKeys();
@@ -270,7 +332,8 @@ namespace PCGMetadataPartitionCommon
 		if (bUseAttributePartition)
 		{
 			check(Attribute);
-			return AttributePartition<PartitionType>(Attribute, *Keys, InOptionalContext);
+			AttributePartition(Attribute, *Keys, OutIds);
+			return true;
 		}
 		else
 		{
@@ -282,10 +345,10 @@ namespace PCGMetadataPartitionCommon
 					PCGLog::LogErrorOnGraph(FText::Format(LOCTEXT("InvalidAccessor", "Attribute {0} not found"), InSelector.GetDisplayText()), InOptionalContext);
 				}
 
-				return {};
+				return false;
 			}
 
-			auto Operation = [&Accessor, &Keys, &InSelector, InOptionalContext](auto Dummy) -> TArray<PartitionType>
+			auto Operation = [&Accessor, &Keys, &InSelector, InOptionalContext, &OutIds](auto Dummy) -> bool
 			{
 				// Rotators don't have a hash, convert them to Quat
 				using AttributeType = std::conditional_t<std::is_same_v<decltype(Dummy), FRotator>, FQuat, decltype(Dummy)>;
@@ -294,11 +357,12 @@ namespace PCGMetadataPartitionCommon
 				if constexpr (std::is_same_v<AttributeType, FTransform>)
 				{
 					PCGLog::LogErrorOnGraph(FText::Format(LOCTEXT("InvalidType", "Attribute {0} is a transform, partition on transforms is not supported"), InSelector.GetDisplayText()), InOptionalContext);
-					return {};
+					return false;
 				}
 				else
 				{
-					return ValuePartition<PartitionType, AttributeType>(*Accessor, *Keys, InOptionalContext);
+					ValuePartition<AttributeType>(*Accessor, *Keys, OutIds);
+					return true;
 				}
 			};
 
@@ -306,18 +370,78 @@ namespace PCGMetadataPartitionCommon
 		}
 	}
 
+	/**
+	* Intersect two partitions, using the pair of partition ids of every entry as a combined hash key.
+	* Combined partitions are numbered in lexicographic order of their (InOutIds, InOtherIds) pair, like a nested loop over both partitions would.
+	*/
+	void CombinePartitionIds(FPartitionIds& InOutIds, const FPartitionIds& InOtherIds)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(PCGMetadataPartitionCommon::CombinePartitionIds);
+		check(InOutIds.EntryPartitions.Num() == InOtherIds.EntryPartitions.Num());
+
+		TMap<uint64, int32> PairToPartition;
+		TArray<uint64> UniquePairs;
+
+		for (int32 EntryIndex = 0; EntryIndex < InOutIds.EntryPartitions.Num(); ++EntryIndex)
+		{
+			int32& PartitionId = InOutIds.EntryPartitions[EntryIndex];
+			const uint64 Pair = (static_cast<uint64>(PartitionId) << 32) | static_cast<uint32>(InOtherIds.EntryPartitions[EntryIndex]);
+
+			if (const int32* ExistingPartitionId = PairToPartition.Find(Pair))
+			{
+				PartitionId = *ExistingPartitionId;
+			}
+			else
+			{
+				PartitionId = UniquePairs.Add(Pair);
+				PairToPartition.Add(Pair, PartitionId);
+			}
+		}
+
+		// Pairs pack the first id in the high bits, so ordering the keys is the lexicographic order.
+		TArray<int32> PairOrder;
+		PairOrder.SetNumUninitialized(UniquePairs.Num());
+		for (int32 PairIndex = 0; PairIndex < UniquePairs.Num(); ++PairIndex)
+		{
+			PairOrder[PairIndex] = PairIndex;
+		}
+
+		Algo::Sort(PairOrder, [&UniquePairs](int32 A, int32 B) { return UniquePairs[A] < UniquePairs[B]; });
+
+		TArray<int32> PairRank;
+		PairRank.SetNumUninitialized(UniquePairs.Num());
+		for (int32 Rank = 0; Rank < PairOrder.Num(); ++Rank)
+		{
+			PairRank[PairOrder[Rank]] = Rank;
+		}
+
+		for (int32& PartitionId : InOutIds.EntryPartitions)
+		{
+			PartitionId = PairRank[PartitionId];
+		}
+
+		InOutIds.NumPartitions = UniquePairs.Num();
+		InOutIds.NumLeadingEmptyPartitions = 0;
+	}
+
 	/**
 	* Dispatch the partition according to the data and selector.
 	*/
 	TArray<TArray<int32>> AttributeGenericPartition(const UPCGData* InData, const FPCGAttributePropertySelector& InSelector, FPCGContext* InOptionalContext, bool bSilenceMissingAttributeErrors)
 	{
-		return AttributeGenericPartition<TArray<int32>>(InData, InSelector, InOptionalContext, bSilenceMissingAttributeErrors);
+		FPartitionIds PartitionIds;
+		if (!ComputePartitionIds(InData, InSelector, InOptionalContext, bSilenceMissingAttributeErrors, PartitionIds))
+		{
+			return {};
+		}
+
+		return BuildPartitions(PartitionIds);
 	}
 
 	/**
-	 * Partition on multiple attributes by first partitioning on the attributes independently. Then take the resultant
-	 * partition and convert them to a BitArray representation of each element's partition. Once in BitArray form,
-	 * combine the results with a logical AND operation to filter them into final partition groupings.
+	 * Partition on multiple attributes by first partitioning on the attributes independently. Then combine the partition
+	 * ids of every element, attribute by attribute, using the pair of ids as a hash key to find the final partition groupings.
+	 * Final partitions are in lexicographic order of the per attribute partitions, each being in order of first occurrence.
 	 *
 	 * Multi-Partition Example:
 	 * Pt  A  B  C                         Partition on A->[0,1],[2,3,4]
@@ -334,7 +458,7 @@ namespace PCGMetadataPartitionCommon
 		// Small optimization to partition on a single attribute
 		if (InSelectorArrayView.Num() == 1)
 		{
-			return AttributeGenericPartition<TArray<int32>>(InData, InSelectorArrayView[0], InOptionalContext, bSilenceMissingAttributeErrors);
+			return AttributeGenericPartition(InData, InSelectorArrayView[0], InOptionalContext, bSilenceMissingAttributeErrors);
 		}
 
 		if (!InData || InSelectorArrayView.IsEmpty() || !InData->ConstMetadata())
@@ -342,79 +466,32 @@ namespace PCGMetadataPartitionCommon
 			return {};
 		}
 
-		// Get the element count from the number of keys which should work for spatial points and attribute sets
-		const TUniquePtr<const IPCGAttributeAccessorKeys> Keys = PCGAttributeAccessorHelpers::CreateConstKeys(InData, InSelectorArrayView[0]);
-		if (!Keys.IsValid())
-		{
-			PCGLog::LogErrorOnGraph(FText::Format(LOCTEXT("InvalidKeys", "Could not create keys for the input data with selector {0}"), InSelectorArrayView[0].GetDisplayText()), InOptionalContext);
-			return {};
-		}
-
-		const int64 NumElements = Keys->GetNum();
-		const int64 NumAttributes = InSelectorArrayView.Num();
-
-		using IndexPartition = TArray<TArray<int32>>;
-		using BitPartition = TArray<TBitArray<>>;
-
-		TArray<BitPartition> BitPartitions;
-		BitPartitions.SetNum(NumAttributes);
+		FPartitionIds CombinedIds;
 
+		for (int32 I = 0; I < InSelectorArrayView.Num(); ++I)
 		{
-			TRACE_CPUPROFILER_EVENT_SCOPE(PCGMetadataPartitionCommon::AttributeGenericPartition::MultiSelector::PartitionOnBitArray);
-			/* TODO: Can be executed in parallel, threadsafe. There is a follow up task to evaluate between
-			* option A.) partitioning on all attributes, and then merging and B.) Partitioning on each attribute
-			* in succession, further partitioning the grouping results of the previous iteration.
-			*/
-			// Calculate each partition into a bitfield for simple/efficient intersection processing
-			for (int32 I = 0; I < InSelectorArrayView.Num(); ++I)
+			FPartitionIds PartitionIds;
+			if (!ComputePartitionIds(InData, InSelectorArrayView[I], InOptionalContext, bSilenceMissingAttributeErrors, PartitionIds) || PartitionIds.EntryPartitions.IsEmpty())
 			{
-				BitPartitions[I] = AttributeGenericPartition<TBitArray<>>(InData, InSelectorArrayView[I], InOptionalContext, bSilenceMissingAttributeErrors);
+				return {};
 			}
-		}
-
-		BitPartition IterativePartition = BitPartitions[0]; // TODO: This can be optimized to filter down in pairs in parallel - O(log N) - instead of serial
 
-		{
-			TRACE_CPUPROFILER_EVENT_SCOPE(PCGMetadataPartitionCommon::AttributeGenericPartition::Intersection);
-			// Intersect all the BitArray partitions
-			for (int32 PartitionIndex = 1; PartitionIndex < BitPartitions.Num(); ++PartitionIndex)
+			if (I == 0)
 			{
-				BitPartition CurrentBitPartition = IterativePartition;
-				BitPartition& NextBitPartition = BitPartitions[PartitionIndex];
-
-				IterativePartition.Empty();
-
-				for (const TBitArray<>& FirstBitArray : CurrentBitPartition)
-				{
-					for (const TBitArray<>& SecondBitArray : NextBitPartition)
-					{
-						TBitArray<> Result = TBitArray<>::BitwiseAND(FirstBitArray, SecondBitArray, EBitwiseOperatorFlags::MaxSize);
-						// Only capture if non-empty. Discard empty BitArrays.
-						if (TConstSetBitIterator(Result))
-						{
-							IterativePartition.Emplace(std::move(Result));
-						}
-					}
-				}
+				CombinedIds = MoveTemp(PartitionIds);
+				CombinedIds.NumLeadingEmptyPartitions = 0;
 			}
-		}
-
-		IndexPartition FinalPartition;
-
-		{
-			TRACE_CPUPROFILER_EVENT_SCOPE(PCGMetadataPartitionCommon::AttributeGenericPartition::MultiSelector::ConversionToIndices);
-			// Convert back into indices
-			for (const TBitArray<>& BitArray : IterativePartition)
+			else if (ensure(PartitionIds.EntryPartitions.Num() == CombinedIds.EntryPartitions.Num()))
 			{
-				TArray<int>& Indices = FinalPartition.Emplace_GetRef();
-				for (TConstSetBitIterator It(BitArray); It; ++It)
-				{
-					Indices.Emplace(It.GetIndex());
-				}
+				CombinePartitionIds(CombinedIds, PartitionIds);
+			}
+			else
+			{
+				return {};
 			}
 		}
 
-		return FinalPartition;
+		return BuildPartitions(CombinedIds);
 	}
 
 	/**
@@ -45,6 +45,18 @@ FPCGCrc UPCGData::GetOrComputeCrc(bool bFullDataCrc) const
 	return Crc;
 }
 
+FPCGCrc UPCGData::GetOrComputeCrcUncached(bool bFullDataCrc) const
+{
+	const bool bComputeFullDataCrc = bFullDataCrc && SupportsFullDataCrc();
+
+	if (Crc.IsValid() && (bIsFullDataCrc || !bComputeFullDataCrc))
+	{
+		return Crc;
+	}
+
+	return ComputeCrc(bComputeFullDataCrc);
+}
+
 void UPCGData::MarkUsage(EPCGDataUsage InUsage) const
 {
 #ifdef PCG_DATA_USAGE_LOGGING
@@ -251,23 +263,35 @@ bool FPCGTaggedData::operator!=(const FPCGTaggedData& Other) const
 	return !operator==(Other);
 }
 
-FPCGCrc FPCGTaggedData::ComputeCrc(bool bFullDataCrc) const
+namespace PCGData
 {
-	FArchiveCrc32 Ar;
+	FPCGCrc ComputeTaggedDataCrc(const FPCGTaggedData& InTaggedData, const FPCGCrc& InDataCrc)
+	{
+		FArchiveCrc32 Ar;
 
-	Ar << const_cast<FName&>(Pin);
+		Ar << const_cast<FName&>(InTaggedData.Pin);
 
-	if (Data)
-	{
-		const FPCGCrc DataCrc = Data->GetOrComputeCrc(bFullDataCrc);
-		uint32 CrcValue = DataCrc.GetValue();
-		Ar << CrcValue;
+		if (InTaggedData.Data)
+		{
+			uint32 CrcValue = InDataCrc.GetValue();
+			Ar << CrcValue;
+		}
+
+		// TODO: Ensuring tags are sorted could prevent CRC change.
+		Ar << const_cast<TSet<FString>&>(InTaggedData.Tags);
+
+		return FPCGCrc(Ar.GetCrc());
 	}
+}
 
-	// TODO: Ensuring tags are sorted could prevent CRC change.
-	Ar << const_cast<TSet<FString>&>(Tags);
+FPCGCrc FPCGTaggedData::ComputeCrc(bool bFullDataCrc) const
+{
+	return PCGData::ComputeTaggedDataCrc(*this, Data ? Data->GetOrComputeCrc(bFullDataCrc) : FPCGCrc());
+}
 
-	return FPCGCrc(Ar.GetCrc());
+FPCGCrc FPCGTaggedData::ComputeCrcUncached(bool bFullDataCrc) const
+{
+	return PCGData::ComputeTaggedDataCrc(*this, Data ? Data->GetOrComputeCrcUncached(bFullDataCrc) : FPCGCrc());
 }
 
 TArray<FPCGTaggedData> FPCGDataCollection::GetInputs() const
@@ -12,6 +12,7 @@
 #include "Data/PCGPointData.h"
 #include "Elements/PCGHiGenGridSize.h"
 #include "Graph/PCGGraphCache.h"
+#include "Graph/PCGGraphDiskCache.h"
 #include "Helpers/PCGActorHelpers.h"
 #include "Helpers/PCGHelpers.h"
 
@@ -161,6 +162,34 @@ namespace PCGElementHelpers
 
 		return true;
 	}
+
+	/** Default dependencies Crc: the data Crcs, the settings Crc and the seed if the settings use it. */
+	FPCGCrc CombineDependenciesCrc(const FPCGGetDependenciesCrcParams& InParams, TConstArrayView<FPCGCrc> InDataCrcs)
+	{
+		// Start from a random prime.
+		FPCGCrc Crc(1000003);
+
+		for (const FPCGCrc& DataCrc : InDataCrcs)
+		{
+			Crc.Combine(DataCrc);
+		}
+
+		if (InParams.Settings)
+		{
+			FPCGCrc SettingsCrc = InParams.Settings->GetSettingsCrc();
+			if (ensure(SettingsCrc.IsValid()))
+			{
+				Crc.Combine(SettingsCrc);
+			}
+		}
+
+		if (InParams.ExecutionSource && (!InParams.Settings || InParams.Settings->UseSeed()))
+		{
+			Crc.Combine(InParams.ExecutionSource->GetExecutionState().GetSeed());
+		}
+
+		return Crc;
+	}
 }
 
 bool IPCGElement::Execute(FPCGContext* Context) const
@@ -554,7 +583,7 @@ void IPCGElement::PostExecute(FPCGContext* Context) const
 
 			if (bCacheable)
 			{
-				FPCGStoreInCacheParams Params = { .Element = this, .Crc = Context->DependenciesCrc };
+				FPCGStoreInCacheParams Params = { .Element = this, .Crc = Context->DependenciesCrc, .Node = Context->Node, .PersistentDependencies = &Context->PersistentDependencies };
 				Context->StoreInCache(Params, Context->OutputData);
 			}
 		}
@@ -1116,30 +1145,8 @@ PRAGMA_ENABLE_DEPRECATION_WARNINGS
 	// Call to deprecated method didn't yield a different Crc so we calculate it here
 	if (!OutCrc.IsValid() || CopyCrc == OutCrc)
 	{
-		// Start from a random prime.
-		FPCGCrc Crc(1000003);
-
 		// The cached data CRCs are computed in FPCGGraphExecutor::BuildTaskInput and incorporate data CRC, tags, output pin label and input pin label.
-		for (const FPCGCrc& DataCrc : InParams.InputData->DataCrcs)
-		{
-			Crc.Combine(DataCrc);
-		}
-
-		if (InParams.Settings)
-		{
-			FPCGCrc SettingsCrc = InParams.Settings->GetSettingsCrc();
-			if (ensure(SettingsCrc.IsValid()))
-			{
-				Crc.Combine(SettingsCrc);
-			}
-		}
-
-		if (InParams.ExecutionSource && (!InParams.Settings || InParams.Settings->UseSeed()))
-		{
-			Crc.Combine(InParams.ExecutionSource->GetExecutionState().GetSeed());
-		}
-
-		OutCrc = Crc;
+		OutCrc = PCGElementHelpers::CombineDependenciesCrc(InParams, InParams.InputData->DataCrcs);
 	}
 	else
 	{
@@ -1148,7 +1155,44 @@ PRAGMA_ENABLE_DEPRECATION_WARNINGS
 	}
 }
 
-EPCGCachingStatus IPCGElement::RetrieveResultsFromCache(IPCGGraphCache* Cache, const UPCGNode* Node, const FPCGDataCollection& Input, IPCGGraphExecutionSource* ExecutionSource, FPCGDataCollection& Output, FPCGCrc* OutCrc) const
+void IPCGElement::ComputePersistentDependencies(const FPCGGetDependenciesCrcParams& InParams, const FPCGCrc& InDependenciesCrc, FPCGPersistentDependencies& OutDependencies) const
+{
+	check(InParams.InputData);
+	TRACE_CPUPROFILER_EVENT_SCOPE(IPCGElement::ComputePersistentDependencies);
+
+	OutDependencies = FPCGPersistentDependencies();
+
+	if (!FPCGGraphDiskCache::IsEnabled() || !InDependenciesCrc.IsValid())
+	{
+		return;
+	}
+
+	// Elements that add other dependencies (external data, etc.) have no persistent equivalent, as we can't know what they depend on.
+	if (!(PCGElementHelpers::CombineDependenciesCrc(InParams, InParams.InputData->DataCrcs) == InDependenciesCrc))
+	{
+		return;
+	}
+
+	TArray<FPCGCrc> PersistentDataCrcs;
+	PersistentDataCrcs.Reserve(InParams.InputData->TaggedData.Num());
+
+	for (const FPCGTaggedData& TaggedData : InParams.InputData->TaggedData)
+	{
+		// Other data Crcs are based on per-session UIDs.
+		if (!FPCGGraphDiskCache::CanPersist(TaggedData.Data))
+		{
+			return;
+		}
+
+		// The data Crc used by the rest of the execution must stay the session Crc, or downstream memory cache keys would change.
+		PersistentDataCrcs.Add(TaggedData.ComputeCrcUncached(/*bFullDataCrc=*/true));
+	}
+
+	OutDependencies.Crc = PCGElementHelpers::CombineDependenciesCrc(InParams, PersistentDataCrcs);
+	OutDependencies.InputCrcs = MoveTemp(PersistentDataCrcs);
+}
+
+EPCGCachingStatus IPCGElement::RetrieveResultsFromCache(IPCGGraphCache* Cache, const UPCGNode* Node, const FPCGDataCollection& Input, IPCGGraphExecutionSource* ExecutionSource, FPCGDataCollection& Output, FPCGCrc* OutCrc, FPCGPersistentDependencies* OutPersistentDependencies) const
 {
 	if (!Cache)
 	{
@@ -1160,15 +1204,34 @@ EPCGCachingStatus IPCGElement::RetrieveResultsFromCache(IPCGGraphCache* Cache, c
 	const bool bCacheable = IsCacheableInstance(SettingsInterface);
 
 	FPCGGetFromCacheParams Params = { .Node = Node, .Element = this, .ExecutionSource = ExecutionSource };
+	TOptional<FPCGGetDependenciesCrcParams> CrcParams;
+	TOptional<FPCGPersistentDependencies> PersistentDependencies;
+
+	auto GetPersistentDependencies = [this, &CrcParams, &Params, &PersistentDependencies]() -> const FPCGPersistentDependencies&
+	{
+		if (!PersistentDependencies.IsSet())
+		{
+			ComputePersistentDependencies(CrcParams.GetValue(), Params.Crc, PersistentDependencies.Emplace());
+		}
+
+		return PersistentDependencies.GetValue();
+	};
 
 	if (Settings && bCacheable)
 	{
-		GetDependenciesCrc(FPCGGetDependenciesCrcParams(&Input, Settings, ExecutionSource), Params.Crc);
+		CrcParams.Emplace(&Input, Settings, ExecutionSource);
+		GetDependenciesCrc(CrcParams.GetValue(), Params.Crc);
 
 		if (OutCrc)
 		{
 			*OutCrc = Params.Crc;
 		}
+
+		// Hashing the full content of the inputs is only worth it when the results are not in memory.
+		if (Params.Crc.IsValid() && FPCGGraphDiskCache::IsEnabled())
+		{
+			Params.GetPersistentDependencies = GetPersistentDependencies;
+		}
 	}
 
 	if(Params.Crc.IsValid() && Cache->GetFromCache(Params, Output))
@@ -1177,6 +1240,12 @@ EPCGCachingStatus IPCGElement::RetrieveResultsFromCache(IPCGGraphCache* Cache, c
 	}
 	else
 	{
+		// The element will be executed, its results are stored with the persistent dependencies.
+		if (OutPersistentDependencies && Params.GetPersistentDependencies)
+		{
+			*OutPersistentDependencies = GetPersistentDependencies();
+		}
+
 		return EPCGCachingStatus::NotInCache;
 	}
 }
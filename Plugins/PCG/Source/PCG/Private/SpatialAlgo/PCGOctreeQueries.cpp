@@ -40,6 +40,32 @@ TArray<FPCGPoint> UPCGOctreeQueries::GetPointsInsideBounds(const UPCGPointData*
 	TArray<FPCGPoint> Result;
 	const TArray<FPCGPoint>& Points = InPointData->GetPoints();
 
+	if (FPCGPointSpatialIndex::IsEnabledForQueries())
+	{
+		// The flat index bounds test is conservative up to float precision, redo it exactly on the density bounds, as the octree does.
+		const FBoxCenterAndExtent QueryBounds(InBounds);
+		TArray<int32> PointIndices;
+
+		InPointData->GetPointSpatialIndex().FindElementsWithBoundsTest(QueryBounds, [&Points, &QueryBounds, &PointIndices](int32 PointIndex)
+		{
+			const FBoxSphereBounds PointBounds = Points[PointIndex].GetDensityBounds();
+			if (Intersect(FBoxCenterAndExtent(PointBounds.Origin, PointBounds.BoxExtent), QueryBounds))
+			{
+				PointIndices.Add(PointIndex);
+			}
+		});
+
+		// Points come in index order, whatever the layout of the index.
+		PointIndices.Sort();
+		Result.Reserve(PointIndices.Num());
+		for (const int32 PointIndex : PointIndices)
+		{
+			Result.Add(Points[PointIndex]);
+		}
+
+		return Result;
+	}
+
 	InPointData->GetPointOctree().FindElementsWithBoundsTest(InBounds, [&Points, &Result](const PCGPointOctree::FPointRef& PointRef)
 	{
 		if (Points.IsValidIndex(PointRef.Index))
@@ -0,0 +1,137 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Tests/PCGTestsCommon.h"
+
+#include "PCGNode.h"
+#include "PCGParamData.h"
+#include "Data/PCGBasePointData.h"
+#include "Data/PCGVolumeData.h"
+#include "Graph/PCGGraphDiskCache.h"
+#include "Metadata/PCGMetadata.h"
+
+#include "HAL/IConsoleManager.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeExit.h"
+
+#if WITH_EDITOR
+
+IMPLEMENT_CUSTOM_SIMPLE_AUTOMATION_TEST(FPCGGraphDiskCacheTest_RoundTrip, FPCGTestBaseClass, "Plugins.PCG.GraphDiskCache.RoundTrip", PCGTestsCommon::TestFlags)
+
+/**
+* Stores a collection with point and param data, reads it back and validates the content.
+* An entry read with other input Crcs is a miss, and data that can't be persisted (here, volume data) rejects the whole collection.
+*/
+bool FPCGGraphDiskCacheTest_RoundTrip::RunTest(const FString& Parameters)
+{
+	static const FName AttributeName = TEXT("Attr");
+	static const FName PinLabel = TEXT("Out");
+	constexpr int32 NumPoints = 64;
+	constexpr int32 NumEntries = 8;
+
+	IConsoleVariable* PathCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("pcg.Cache.Disk.Path"));
+	check(PathCVar);
+	const FString PreviousPath = PathCVar->GetString();
+	PathCVar->Set(*FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("PCGGraphDiskCacheTest")), ECVF_SetByCode);
+
+	ON_SCOPE_EXIT
+	{
+		PathCVar->Set(*PreviousPath, ECVF_SetByCode);
+	};
+
+	FPCGGraphDiskCache DiskCache;
+	DiskCache.Clear();
+
+	UPCGNode* Node = NewObject<UPCGNode>();
+
+	UPCGBasePointData* PointData = PCGTestsCommon::CreateRandomBasePointData(NumPoints, /*Seed=*/42);
+
+	UPCGParamData* ParamData = PCGTestsCommon::CreateEmptyParamData();
+	FPCGMetadataAttribute<int32>* Attribute = ParamData->Metadata->CreateAttribute<int32>(AttributeName, 0, /*bAllowsInterpolation=*/false, /*bOverrideParent=*/false);
+	check(Attribute);
+
+	for (int32 i = 0; i < NumEntries; ++i)
+	{
+		Attribute->SetValue(ParamData->Metadata->AddEntry(), i * 10);
+	}
+
+	FPCGDataCollection Collection;
+	FPCGTaggedData& PointTaggedData = Collection.TaggedData.Emplace_GetRef();
+	PointTaggedData.Data = PointData;
+	PointTaggedData.Pin = PinLabel;
+	PointTaggedData.Tags.Add(TEXT("PointTag"));
+
+	FPCGTaggedData& ParamTaggedData = Collection.TaggedData.Emplace_GetRef();
+	ParamTaggedData.Data = ParamData;
+	ParamTaggedData.Pin = PinLabel;
+
+	// Computing the persistent Crc of an input doesn't change the Crc cached on its data.
+	const FPCGCrc PointDataCrc = PointData->GetOrComputeCrc(/*bFullDataCrc=*/false);
+	const FPCGCrc PersistentPointCrc = PointTaggedData.ComputeCrcUncached(/*bFullDataCrc=*/true);
+	UTEST_TRUE("Cached data Crc is unchanged", PointData->GetOrComputeCrc(/*bFullDataCrc=*/false) == PointDataCrc);
+	UTEST_TRUE("Persistent Crc is stable", PointTaggedData.ComputeCrcUncached(/*bFullDataCrc=*/true) == PersistentPointCrc);
+
+	const TArray<FPCGCrc> InputCrcs = { PersistentPointCrc, FPCGCrc(42) };
+	const TArray<FPCGCrc> OtherInputCrcs = { PersistentPointCrc, FPCGCrc(43) };
+
+	const FSHAHash Key = FPCGGraphDiskCache::MakeKey(Node, /*InElement=*/nullptr, FPCGCrc(1234));
+	UTEST_TRUE("Key is deterministic", Key == FPCGGraphDiskCache::MakeKey(Node, /*InElement=*/nullptr, FPCGCrc(1234)));
+	UTEST_FALSE("Key depends on the persistent Crc", Key == FPCGGraphDiskCache::MakeKey(Node, /*InElement=*/nullptr, FPCGCrc(1235)));
+
+	DiskCache.Store(Key, InputCrcs, Collection);
+	UTEST_EQUAL("Collection was written", DiskCache.GetStats().Writes, static_cast<uint64>(1));
+
+	FPCGDataCollection LoadedCollection;
+	UTEST_TRUE("Collection is read back", DiskCache.Load(Key, InputCrcs, LoadedCollection));
+	UTEST_EQUAL("Number of data", LoadedCollection.TaggedData.Num(), 2);
+	UTEST_EQUAL("Pin is restored", LoadedCollection.TaggedData[0].Pin, PinLabel);
+	UTEST_TRUE("Tags are restored", LoadedCollection.TaggedData[0].Tags.Contains(TEXT("PointTag")));
+
+	const UPCGBasePointData* LoadedPointData = Cast<UPCGBasePointData>(LoadedCollection.TaggedData[0].Data);
+	UTEST_NOT_NULL("Point data is restored", LoadedPointData);
+	check(LoadedPointData);
+	UTEST_EQUAL("Point data class", LoadedPointData->GetClass(), PointData->GetClass());
+	UTEST_EQUAL("Number of points", LoadedPointData->GetNumPoints(), NumPoints);
+
+	const TConstPCGValueRange<FTransform> Transforms = PointData->GetConstTransformValueRange();
+	const TConstPCGValueRange<FTransform> LoadedTransforms = LoadedPointData->GetConstTransformValueRange();
+	for (int32 i = 0; i < NumPoints; ++i)
+	{
+		UTEST_TRUE(*FString::Printf(TEXT("Point %d transform"), i), LoadedTransforms[i].Equals(Transforms[i]));
+	}
+
+	const UPCGParamData* LoadedParamData = Cast<UPCGParamData>(LoadedCollection.TaggedData[1].Data);
+	UTEST_NOT_NULL("Param data is restored", LoadedParamData);
+	check(LoadedParamData);
+
+	const FPCGMetadataAttribute<int32>* LoadedAttribute = LoadedParamData->Metadata->GetConstTypedAttribute<int32>(AttributeName);
+	UTEST_NOT_NULL("Attribute is restored", LoadedAttribute);
+	check(LoadedAttribute);
+	UTEST_EQUAL("Number of entries", LoadedParamData->Metadata->GetItemCountForChild(), static_cast<int64>(NumEntries));
+
+	for (int32 i = 0; i < NumEntries; ++i)
+	{
+		UTEST_EQUAL(*FString::Printf(TEXT("Entry %d value"), i), LoadedAttribute->GetValueFromItemKey(i), i * 10);
+	}
+
+	// Same key, other inputs: the entry is not served, and is removed.
+	FPCGDataCollection MismatchCollection;
+	UTEST_FALSE("Entry written for other inputs is a miss", DiskCache.Load(Key, OtherInputCrcs, MismatchCollection));
+	UTEST_EQUAL("Input mismatch is counted", DiskCache.GetStats().Collisions, static_cast<uint64>(1));
+	UTEST_EQUAL("No data is returned on a mismatch", MismatchCollection.TaggedData.Num(), 0);
+	UTEST_FALSE("Mismatching entry was removed", DiskCache.Load(Key, InputCrcs, MismatchCollection));
+
+	// A collection with data that can't be persisted is not written.
+	Collection.TaggedData.Emplace_GetRef().Data = PCGTestsCommon::CreateVolumeData();
+	const FSHAHash RejectedKey = FPCGGraphDiskCache::MakeKey(Node, /*InElement=*/nullptr, FPCGCrc(5678));
+	DiskCache.Store(RejectedKey, InputCrcs, Collection);
+	UTEST_EQUAL("Collection was rejected", DiskCache.GetStats().RejectedWrites, static_cast<uint64>(1));
+
+	FPCGDataCollection RejectedCollection;
+	UTEST_FALSE("Rejected collection is not found", DiskCache.Load(RejectedKey, InputCrcs, RejectedCollection));
+
+	DiskCache.Clear();
+
+	return true;
+}
+
+#endif // WITH_EDITOR
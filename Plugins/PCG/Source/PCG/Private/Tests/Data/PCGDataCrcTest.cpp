@@ -0,0 +1,138 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Tests/PCGTestsCommon.h"
+
+#include "Data/PCGBasePointData.h"
+#include "Metadata/PCGMetadata.h"
+
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/ScopeExit.h"
+
+#if WITH_EDITOR
+
+IMPLEMENT_CUSTOM_SIMPLE_AUTOMATION_TEST(FPCGDataCrcTest_FullPointDataCrc, FPCGTestBaseClass, "Plugins.PCG.DataCrc.FullPointDataCrc", PCGTestsCommon::TestFlags)
+IMPLEMENT_CUSTOM_SIMPLE_AUTOMATION_TEST(FPCGDataCrcTest_Benchmark, FPCGTestBaseClass, "Plugins.PCG.DataCrc.Benchmark", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+namespace PCGDataCrcTest
+{
+	const FName AttributeName = TEXT("Attr");
+
+	/** Random points with a double attribute, all deterministic from the seed. */
+	UPCGBasePointData* CreatePointDataWithAttribute(int32 NumPoints, int32 Seed)
+	{
+		UPCGBasePointData* PointData = PCGTestsCommon::CreateRandomBasePointData(NumPoints, Seed);
+		FPCGMetadataAttribute<double>* Attribute = PointData->Metadata->CreateAttribute<double>(AttributeName, 0.0, /*bAllowsInterpolation=*/true, /*bOverrideParent=*/false);
+		check(Attribute);
+
+		TPCGValueRange<int64> MetadataEntryRange = PointData->GetMetadataEntryValueRange();
+		for (int32 i = 0; i < NumPoints; ++i)
+		{
+			MetadataEntryRange[i] = PointData->Metadata->AddEntry();
+			Attribute->SetValue(MetadataEntryRange[i], static_cast<double>(i) * 0.5);
+		}
+
+		return PointData;
+	}
+
+	void SetParallelCrc(bool bEnabled)
+	{
+		IConsoleVariable* CVar = IConsoleManager::Get().FindConsoleVariable(TEXT("pcg.Cache.ParallelDataCrc"));
+		check(CVar);
+		CVar->Set(bEnabled, ECVF_SetByCode);
+	}
+
+	bool IsParallelCrcEnabled()
+	{
+		IConsoleVariable* CVar = IConsoleManager::Get().FindConsoleVariable(TEXT("pcg.Cache.ParallelDataCrc"));
+		check(CVar);
+		return CVar->GetBool();
+	}
+}
+
+/**
+* Full data Crcs are computed in parallel chunks. Validates that the Crc only depends on the content:
+* the same content gives the same Crc, across several chunks, and any change of a point or attribute value changes it.
+*/
+bool FPCGDataCrcTest_FullPointDataCrc::RunTest(const FString& Parameters)
+{
+	using namespace PCGDataCrcTest;
+
+	// More than a few chunks, with a partial last one.
+	constexpr int32 NumPoints = 100000;
+
+	const bool bWasParallelCrcEnabled = IsParallelCrcEnabled();
+	SetParallelCrc(true);
+
+	ON_SCOPE_EXIT
+	{
+		SetParallelCrc(bWasParallelCrcEnabled);
+	};
+
+	const UPCGBasePointData* PointDataA = CreatePointDataWithAttribute(NumPoints, /*Seed=*/42);
+	const UPCGBasePointData* PointDataB = CreatePointDataWithAttribute(NumPoints, /*Seed=*/42);
+
+	const FPCGCrc CrcA = PointDataA->GetOrComputeCrc(/*bFullDataCrc=*/true);
+	const FPCGCrc CrcB = PointDataB->GetOrComputeCrc(/*bFullDataCrc=*/true);
+	UTEST_TRUE("Crc is valid", CrcA.IsValid());
+	UTEST_EQUAL("Same content gives the same Crc", CrcA.GetValue(), CrcB.GetValue());
+
+	UPCGBasePointData* ModifiedPointData = CreatePointDataWithAttribute(NumPoints, /*Seed=*/42);
+	ModifiedPointData->GetDensityValueRange()[NumPoints - 1] = 0.5f;
+	UTEST_NOT_EQUAL("Point change in the last chunk changes the Crc", ModifiedPointData->GetOrComputeCrc(/*bFullDataCrc=*/true).GetValue(), CrcA.GetValue());
+
+	UPCGBasePointData* ModifiedAttributeData = CreatePointDataWithAttribute(NumPoints, /*Seed=*/42);
+	FPCGMetadataAttribute<double>* Attribute = ModifiedAttributeData->Metadata->GetMutableTypedAttribute<double>(AttributeName);
+	check(Attribute);
+	Attribute->SetValue(ModifiedAttributeData->GetConstMetadataEntryValueRange()[NumPoints / 2], -1.0);
+	UTEST_NOT_EQUAL("Attribute change changes the Crc", ModifiedAttributeData->GetOrComputeCrc(/*bFullDataCrc=*/true).GetValue(), CrcA.GetValue());
+
+	return true;
+}
+
+/**
+* Times the full data Crc of point data with one attribute, value by value on one thread and in parallel chunks.
+*/
+bool FPCGDataCrcTest_Benchmark::RunTest(const FString& Parameters)
+{
+	using namespace PCGDataCrcTest;
+
+	const bool bWasParallelCrcEnabled = IsParallelCrcEnabled();
+
+	ON_SCOPE_EXIT
+	{
+		SetParallelCrc(bWasParallelCrcEnabled);
+	};
+
+	const int32 PointCounts[] = { 10000, 100000, 1000000, 4000000 };
+
+	for (const int32 NumPoints : PointCounts)
+	{
+		double Times[2] = { 0.0, 0.0 };
+
+		for (int32 Mode = 0; Mode < 2; ++Mode)
+		{
+			const bool bParallel = (Mode == 1);
+			SetParallelCrc(bParallel);
+
+			// The Crc is cached on the data, so time a fresh data each time.
+			const UPCGBasePointData* PointData = CreatePointDataWithAttribute(NumPoints, /*Seed=*/42);
+
+			const double StartTime = FPlatformTime::Seconds();
+			const FPCGCrc Crc = PointData->GetOrComputeCrc(/*bFullDataCrc=*/true);
+			Times[Mode] = FPlatformTime::Seconds() - StartTime;
+
+			UTEST_TRUE("Crc is valid", Crc.IsValid());
+		}
+
+		AddInfo(FString::Printf(TEXT("%d points: sequential %.2f ms, parallel %.2f ms (x%.1f)"),
+			NumPoints,
+			Times[0] * 1000.0,
+			Times[1] * 1000.0,
+			Times[1] > 0.0 ? Times[0] / Times[1] : 0.0));
+	}
+
+	return true;
+}
+
+#endif // WITH_EDITOR
@@ -0,0 +1,350 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Tests/PCGTestsCommon.h"
+#include "Data/PCGBasePointData.h"
+#include "Data/PCGDifferenceData.h"
+#include "Data/PCGIntersectionData.h"
+#include "Data/PCGProjectionData.h"
+#include "Data/PCGSpatialDataTpl.h"
+#include "Data/PCGSplineData.h"
+#include "Data/PCGTextureData.h"
+#include "Data/PCGUnionData.h"
+#include "Data/PCGVolumeData.h"
+
+#include "Components/SplineComponent.h"
+#include "Engine/Texture2D.h"
+#include "TextureResource.h"
+
+#if WITH_EDITOR
+
+IMPLEMENT_CUSTOM_SIMPLE_AUTOMATION_TEST(FPCGSamplePointsRangeTest, FPCGTestBaseClass, "Plugins.PCG.SpatialData.SamplePointsRange", PCGTestsCommon::TestFlags)
+IMPLEMENT_CUSTOM_SIMPLE_AUTOMATION_TEST(FPCGProjectPointsRangeTest, FPCGTestBaseClass, "Plugins.PCG.SpatialData.ProjectPointsRange", PCGTestsCommon::TestFlags)
+IMPLEMENT_CUSTOM_SIMPLE_AUTOMATION_TEST(FPCGSamplePointsRangeMetadataTest, FPCGTestBaseClass, "Plugins.PCG.SpatialData.SamplePointsRangeMetadata", PCGTestsCommon::TestFlags)
+
+namespace PCGSamplePointsRangeTest
+{
+	const FName ValueAttribute = TEXT("Value");
+
+	/** Grid of GridSize x GridSize queries over [-1000, 1000] in XY, with a few heights around 0, and varying yaws and scales. */
+	UPCGBasePointData* CreateQueries(int32 GridSize)
+	{
+		UPCGBasePointData* Queries = PCGTestsCommon::CreateEmptyBasePointData();
+		Queries->SetNumPoints(GridSize * GridSize);
+		Queries->AllocateProperties(EPCGPointNativeProperties::Transform | EPCGPointNativeProperties::BoundsMin | EPCGPointNativeProperties::BoundsMax);
+
+		TPCGValueRange<FTransform> TransformRange = Queries->GetTransformValueRange();
+		TPCGValueRange<FVector> BoundsMinRange = Queries->GetBoundsMinValueRange();
+		TPCGValueRange<FVector> BoundsMaxRange = Queries->GetBoundsMaxValueRange();
+
+		for (int32 Index = 0; Index < GridSize * GridSize; ++Index)
+		{
+			const double Step = 2000.0 / (GridSize - 1);
+			const FVector Location(-1000.0 + (Index % GridSize) * Step, -1000.0 + (Index / GridSize) * Step, 10.0 * (Index % 7));
+			const FQuat Rotation = FRotator(0.0, 15.0 * (Index % 11), 0.0).Quaternion();
+			const FVector Scale(1.0 + 0.25 * (Index % 3));
+
+			TransformRange[Index] = FTransform(Rotation, Location, Scale);
+			BoundsMinRange[Index] = FVector(-10.0);
+			BoundsMaxRange[Index] = FVector(10.0);
+		}
+
+		return Queries;
+	}
+
+	/** Texture data covering [-800, 800] in XY at Z = 0, with a color gradient and varying alpha. Returns nullptr if the texture could not be read back. */
+	UPCGTextureData* CreateTextureData()
+	{
+		constexpr int32 TextureSize = 64;
+
+		TArray<FColor> Pixels;
+		Pixels.SetNumUninitialized(TextureSize * TextureSize);
+		for (int32 Y = 0; Y < TextureSize; ++Y)
+		{
+			for (int32 X = 0; X < TextureSize; ++X)
+			{
+				Pixels[X + Y * TextureSize] = FColor(X * 4, Y * 4, 128, 64 + (X + Y) % 192);
+			}
+		}
+
+		UTexture2D* Texture2D = UTexture2D::CreateTransient(TextureSize, TextureSize, EPixelFormat::PF_B8G8R8A8);
+		Texture2D->CompressionSettings = TextureCompressionSettings::TC_VectorDisplacementmap;
+		Texture2D->SRGB = 0;
+		Texture2D->MipGenSettings = TMGS_NoMipmaps;
+		Texture2D->UpdateResource();
+
+		void* RawTextureData = Texture2D->GetPlatformData()->Mips[0].BulkData.Lock(LOCK_READ_WRITE);
+		FMemory::Memcpy(RawTextureData, Pixels.GetData(), Pixels.Num() * sizeof(FColor));
+		Texture2D->GetPlatformData()->Mips[0].BulkData.Unlock();
+		Texture2D->UpdateResource();
+
+		UPCGTextureData* TextureData = NewObject<UPCGTextureData>();
+		const FTransform Transform(FQuat::Identity, FVector::ZeroVector, FVector(800.0, 800.0, 1.0));
+		while (!TextureData->Initialize(Texture2D, /*TextureIndex=*/0, Transform)) {}
+
+		return TextureData->IsSuccessfullyInitialized() ? TextureData : nullptr;
+	}
+
+	/** Closed curve of radius 500 around the origin, scaled so that queries up to ~150 units away from it are sampled. */
+	UPCGSplineData* CreateSplineData()
+	{
+		constexpr int32 NumSplinePoints = 8;
+
+		TArray<FSplinePoint> SplinePoints;
+		for (int32 Index = 0; Index < NumSplinePoints; ++Index)
+		{
+			const double Angle = UE_TWO_PI * Index / NumSplinePoints;
+			FSplinePoint& SplinePoint = SplinePoints.Emplace_GetRef(Index, FVector(500.0 * FMath::Cos(Angle), 500.0 * FMath::Sin(Angle), 0.0));
+			SplinePoint.Scale = FVector(150.0);
+		}
+
+		UPCGSplineData* SplineData = NewObject<UPCGSplineData>();
+		SplineData->Initialize(SplinePoints, /*bInClosedLoop=*/true, FTransform::Identity);
+		return SplineData;
+	}
+
+	/** Point data on a 10 x 10 grid over [-1000, 1000] in XY, with overlapping bounds and a random double attribute. */
+	UPCGBasePointData* CreateAttributePointData(const FVector& InOffset, int32 InSeed)
+	{
+		constexpr int32 GridSize = 10;
+
+		UPCGBasePointData* PointData = PCGTestsCommon::CreateEmptyBasePointData();
+		PointData->SetNumPoints(GridSize * GridSize);
+		PointData->AllocateProperties(EPCGPointNativeProperties::Transform | EPCGPointNativeProperties::BoundsMin | EPCGPointNativeProperties::BoundsMax | EPCGPointNativeProperties::MetadataEntry);
+
+		TPCGValueRange<FTransform> TransformRange = PointData->GetTransformValueRange();
+		TPCGValueRange<FVector> BoundsMinRange = PointData->GetBoundsMinValueRange();
+		TPCGValueRange<FVector> BoundsMaxRange = PointData->GetBoundsMaxValueRange();
+
+		for (int32 Index = 0; Index < GridSize * GridSize; ++Index)
+		{
+			TransformRange[Index] = FTransform(InOffset + FVector(-900.0 + (Index % GridSize) * 200.0, -900.0 + (Index / GridSize) * 200.0, 0.0));
+			BoundsMinRange[Index] = FVector(-120.0, -120.0, -50.0);
+			BoundsMaxRange[Index] = FVector(120.0, 120.0, 50.0);
+		}
+
+		PCGTestsCommon::CreateAndFillRandomAttribute<double>(PointData, ValueAttribute, 0.0, GridSize * GridSize, InSeed);
+		return PointData;
+	}
+
+	/**
+	* Samples the queries with SamplePointsRange, or projects them with ProjectPointsRange when InParams is set, in two chunks with an offset
+	* to cover the query and output start indices, and compares each query with SamplePoint / ProjectPoint.
+	* With bWithMetadata, both paths write to metadata initialized from the data, and the values of the Value attribute are compared too.
+	*/
+	bool TestRangeMatchesPerPoint(FAutomationTestBase& Test, const TCHAR* Name, const UPCGSpatialData* Data, const UPCGBasePointData* Queries, const FPCGProjectionParams* InParams, bool bWithMetadata)
+	{
+		if (!Test.TestNotNull(Name, Data))
+		{
+			return false;
+		}
+
+		UPCGMetadata* RangeMetadata = nullptr;
+		UPCGMetadata* PointMetadata = nullptr;
+		if (bWithMetadata)
+		{
+			UPCGBasePointData* RangeOutput = PCGTestsCommon::CreateEmptyBasePointData();
+			UPCGBasePointData* PointOutput = PCGTestsCommon::CreateEmptyBasePointData();
+			RangeOutput->InitializeFromData(Data);
+			PointOutput->InitializeFromData(Data);
+			RangeMetadata = RangeOutput->Metadata;
+			PointMetadata = PointOutput->Metadata;
+		}
+
+		const int32 NumQueries = Queries->GetNumPoints();
+		const int32 FirstChunkSize = NumQueries / 3;
+		constexpr int32 OutOffset = 5;
+
+		FPCGSpatialDataProcessing::FSampledPointsBuffer Buffer(NumQueries + OutOffset);
+		FPCGPointValueRanges Ranges = Buffer.GetValueRanges();
+
+		const FPCGSampleQueryRanges FirstChunk(Queries, 0, FirstChunkSize);
+		const FPCGSampleQueryRanges SecondChunk(Queries, FirstChunkSize, NumQueries - FirstChunkSize);
+
+		if (InParams)
+		{
+			Data->ProjectPointsRange(FirstChunk, *InParams, Ranges, OutOffset, RangeMetadata);
+			Data->ProjectPointsRange(SecondChunk, *InParams, Ranges, OutOffset + FirstChunkSize, RangeMetadata);
+		}
+		else
+		{
+			Data->SamplePointsRange(FirstChunk, Ranges, OutOffset, RangeMetadata);
+			Data->SamplePointsRange(SecondChunk, Ranges, OutOffset + FirstChunkSize, RangeMetadata);
+		}
+
+		const FPCGMetadataAttribute<double>* RangeAttribute = RangeMetadata ? RangeMetadata->GetConstTypedAttribute<double>(ValueAttribute) : nullptr;
+		const FPCGMetadataAttribute<double>* PointAttribute = PointMetadata ? PointMetadata->GetConstTypedAttribute<double>(ValueAttribute) : nullptr;
+		if (bWithMetadata && (!Test.TestNotNull(*FString::Printf(TEXT("%s range attribute"), Name), RangeAttribute) || !Test.TestNotNull(*FString::Printf(TEXT("%s point attribute"), Name), PointAttribute)))
+		{
+			return false;
+		}
+
+		const FConstPCGPointValueRanges QueryRanges(Queries);
+		int32 NumHits = 0;
+		int32 NumMismatches = 0;
+
+		for (int32 Index = 0; Index < NumQueries; ++Index)
+		{
+			const FPCGPoint Query = QueryRanges.GetPoint(Index);
+			const int32 OutIndex = OutOffset + Index;
+
+			FPCGPoint ExpectedPoint;
+			const bool bOverlaps = InParams
+				? Data->ProjectPoint(Query.Transform, Query.GetLocalBounds(), *InParams, ExpectedPoint, PointMetadata)
+				: Data->SamplePoint(Query.Transform, Query.GetLocalBounds(), ExpectedPoint, PointMetadata);
+			const bool bHit = bOverlaps && ExpectedPoint.Density > 0;
+
+			bool bMatches = FMath::IsNearlyEqual(Buffer.Densities[OutIndex], bHit ? ExpectedPoint.Density : 0.0f);
+			if (bHit)
+			{
+				++NumHits;
+				bMatches &= Buffer.Transforms[OutIndex].Equals(ExpectedPoint.Transform)
+					&& Buffer.BoundsMins[OutIndex].Equals(ExpectedPoint.BoundsMin)
+					&& Buffer.BoundsMaxs[OutIndex].Equals(ExpectedPoint.BoundsMax)
+					&& Buffer.Colors[OutIndex].Equals(ExpectedPoint.Color);
+
+				if (bWithMetadata)
+				{
+					bMatches &= FMath::IsNearlyEqual(RangeAttribute->GetValueFromItemKey(Buffer.MetadataEntries[OutIndex]), PointAttribute->GetValueFromItemKey(ExpectedPoint.MetadataEntry));
+				}
+			}
+
+			NumMismatches += bMatches ? 0 : 1;
+		}
+
+		const TCHAR* PerPointName = InParams ? TEXT("ProjectPoint") : TEXT("SamplePoint");
+		return Test.TestTrue(*FString::Printf(TEXT("%s has hits"), Name), NumHits > 0)
+			&& Test.TestEqual(*FString::Printf(TEXT("%s mismatches with %s"), Name, PerPointName), NumMismatches, 0);
+	}
+}
+
+/** SamplePointsRange matches SamplePoint on volumes, surfaces, splines, projections and composite data. */
+bool FPCGSamplePointsRangeTest::RunTest(const FString& Parameters)
+{
+	using namespace PCGSamplePointsRangeTest;
+
+	const UPCGVolumeData* FirstVolume = PCGTestsCommon::CreateVolumeData(FBox::BuildAABB(FVector::OneVector * 250, FVector::OneVector * 500));
+	const UPCGVolumeData* SecondVolume = PCGTestsCommon::CreateVolumeData(FBox::BuildAABB(FVector::OneVector * -250, FVector::OneVector * 500));
+	const UPCGTextureData* TextureData = CreateTextureData();
+	const UPCGSplineData* SplineData = CreateSplineData();
+	UTEST_NOT_NULL("First volume", FirstVolume);
+	UTEST_NOT_NULL("Second volume", SecondVolume);
+	UTEST_NOT_NULL("Texture", TextureData);
+
+	// Grid of queries crossing both volumes, their overlap, the texture plane, the spline and the outside.
+	const UPCGBasePointData* Queries = CreateQueries(/*GridSize=*/24);
+
+	const TPair<const TCHAR*, const UPCGSpatialData*> TestedData[] =
+	{
+		{ TEXT("Volume"), FirstVolume },
+		{ TEXT("Texture"), TextureData },
+		{ TEXT("Spline"), SplineData },
+		{ TEXT("Union"), FirstVolume->UnionWith(nullptr, SecondVolume) },
+		{ TEXT("Intersection"), FirstVolume->IntersectWith(nullptr, SecondVolume) },
+		{ TEXT("Difference"), FirstVolume->Subtract(nullptr, SecondVolume) },
+		{ TEXT("Projection"), TextureData->ProjectOn(nullptr, SecondVolume) },
+		{ TEXT("SplineProjection"), SplineData->ProjectOn(nullptr, TextureData) },
+	};
+
+	UTEST_NOT_NULL("Projection data", Cast<UPCGProjectionData>(TestedData[6].Value));
+
+	for (const TPair<const TCHAR*, const UPCGSpatialData*>& Data : TestedData)
+	{
+		UTEST_TRUE(Data.Key, TestRangeMatchesPerPoint(*this, Data.Key, Data.Value, Queries, /*InParams=*/nullptr, /*bWithMetadata=*/false));
+	}
+
+	return true;
+}
+
+/** ProjectPointsRange matches ProjectPoint, with the projection params resetting the transform components that are not projected. */
+bool FPCGProjectPointsRangeTest::RunTest(const FString& Parameters)
+{
+	using namespace PCGSamplePointsRangeTest;
+
+	const UPCGVolumeData* FirstVolume = PCGTestsCommon::CreateVolumeData(FBox::BuildAABB(FVector::OneVector * 250, FVector::OneVector * 500));
+	const UPCGVolumeData* SecondVolume = PCGTestsCommon::CreateVolumeData(FBox::BuildAABB(FVector::OneVector * -250, FVector::OneVector * 500));
+	const UPCGTextureData* TextureData = CreateTextureData();
+	const UPCGSplineData* SplineData = CreateSplineData();
+	UTEST_NOT_NULL("First volume", FirstVolume);
+	UTEST_NOT_NULL("Second volume", SecondVolume);
+	UTEST_NOT_NULL("Texture", TextureData);
+
+	const UPCGBasePointData* Queries = CreateQueries(/*GridSize=*/24);
+
+	const TPair<const TCHAR*, const UPCGSpatialData*> TestedData[] =
+	{
+		{ TEXT("Volume"), FirstVolume },
+		{ TEXT("Texture"), TextureData },
+		{ TEXT("Spline"), SplineData },
+		{ TEXT("Union"), FirstVolume->UnionWith(nullptr, SecondVolume) },
+		{ TEXT("Intersection"), FirstVolume->IntersectWith(nullptr, SecondVolume) },
+		{ TEXT("Difference"), FirstVolume->Subtract(nullptr, SecondVolume) },
+		{ TEXT("Projection"), TextureData->ProjectOn(nullptr, SecondVolume) },
+	};
+
+	FPCGProjectionParams DefaultParams;
+
+	FPCGProjectionParams AllParams;
+	AllParams.bProjectPositions = true;
+	AllParams.bProjectRotations = true;
+	AllParams.bProjectScales = true;
+
+	FPCGProjectionParams NoParams;
+	NoParams.bProjectPositions = false;
+	NoParams.bProjectRotations = false;
+	NoParams.bProjectScales = false;
+
+	const TPair<const TCHAR*, const FPCGProjectionParams*> TestedParams[] =
+	{
+		{ TEXT("Default"), &DefaultParams },
+		{ TEXT("All"), &AllParams },
+		{ TEXT("None"), &NoParams },
+	};
+
+	for (const TPair<const TCHAR*, const FPCGProjectionParams*>& Params : TestedParams)
+	{
+		for (const TPair<const TCHAR*, const UPCGSpatialData*>& Data : TestedData)
+		{
+			const FString Name = FString::Printf(TEXT("%s (%s params)"), Data.Key, Params.Key);
+			UTEST_TRUE(*Name, TestRangeMatchesPerPoint(*this, *Name, Data.Value, Queries, Params.Value, /*bWithMetadata=*/false));
+		}
+	}
+
+	return true;
+}
+
+/** Composite data merge the operand attributes the same way with the range API as with SamplePoint / ProjectPoint. */
+bool FPCGSamplePointsRangeMetadataTest::RunTest(const FString& Parameters)
+{
+	using namespace PCGSamplePointsRangeTest;
+
+	// Shifted so that queries fall on either grid, on both, or on none.
+	const UPCGBasePointData* FirstPoints = CreateAttributePointData(FVector(0.0, 0.0, 0.0), /*InSeed=*/42);
+	const UPCGBasePointData* SecondPoints = CreateAttributePointData(FVector(100.0, 60.0, 0.0), /*InSeed=*/1337);
+	const UPCGVolumeData* Volume = PCGTestsCommon::CreateVolumeData(FBox::BuildAABB(FVector::ZeroVector, FVector(600.0, 600.0, 100.0)));
+	UTEST_NOT_NULL("Volume", Volume);
+
+	const UPCGBasePointData* Queries = CreateQueries(/*GridSize=*/24);
+
+	const TPair<const TCHAR*, const UPCGSpatialData*> TestedData[] =
+	{
+		{ TEXT("Union"), FirstPoints->UnionWith(nullptr, SecondPoints) },
+		{ TEXT("Intersection"), FirstPoints->IntersectWith(nullptr, SecondPoints) },
+		{ TEXT("VolumeIntersection"), Volume->IntersectWith(nullptr, FirstPoints) },
+		{ TEXT("Difference"), FirstPoints->Subtract(nullptr, Volume) },
+	};
+
+	FPCGProjectionParams NoRotationParams;
+	NoRotationParams.bProjectRotations = false;
+
+	for (const TPair<const TCHAR*, const UPCGSpatialData*>& Data : TestedData)
+	{
+		UTEST_TRUE(Data.Key, TestRangeMatchesPerPoint(*this, Data.Key, Data.Value, Queries, /*InParams=*/nullptr, /*bWithMetadata=*/true));
+
+		const FString ProjectName = FString::Printf(TEXT("%s (projected)"), Data.Key);
+		UTEST_TRUE(*ProjectName, TestRangeMatchesPerPoint(*this, *ProjectName, Data.Value, Queries, &NoRotationParams, /*bWithMetadata=*/true));
+	}
+
+	return true;
+}
+
+#endif // WITH_EDITOR
@@ -5,11 +5,16 @@
 #include "Data/PCGTextureData.h"
 
 #include "Engine/Texture2D.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/ScopeExit.h"
 #include "TextureResource.h"
 
 #if WITH_EDITOR
 
 IMPLEMENT_CUSTOM_SIMPLE_AUTOMATION_TEST(FPCGTextureDataOffsetTilingRotation, FPCGTestBaseClass, "Plugins.PCG.Texture.OffsetTilingRotation", PCGTestsCommon::TestFlags)
+IMPLEMENT_CUSTOM_SIMPLE_AUTOMATION_TEST(FPCGTextureDataSampleChannelLocal, FPCGTestBaseClass, "Plugins.PCG.Texture.SampleChannelLocal", PCGTestsCommon::TestFlags)
+IMPLEMENT_CUSTOM_SIMPLE_AUTOMATION_TEST(FPCGTextureDataCompactStorage, FPCGTestBaseClass, "Plugins.PCG.Texture.CompactStorage", PCGTestsCommon::TestFlags)
+IMPLEMENT_CUSTOM_SIMPLE_AUTOMATION_TEST(FPCGTextureDataMipChain, FPCGTestBaseClass, "Plugins.PCG.Texture.MipChain", PCGTestsCommon::TestFlags)
 
 bool FPCGTextureDataOffsetTilingRotation::RunTest(const FString& Parameters)
 {
@@ -112,4 +117,243 @@ bool FPCGTextureDataOffsetTilingRotation::RunTest(const FString& Parameters)
 
 	return bTestPassed;
 }
+
+/** The batched channel sampling returns the same values as SamplePointLocal, for both filters and with zero density rejection. */
+bool FPCGTextureDataSampleChannelLocal::RunTest(const FString& Parameters)
+{
+	const int32 TextureSize = 64;
+
+	FRandomStream RandomStream(42);
+
+	TArray<FColor> Pixels;
+	Pixels.SetNumUninitialized(TextureSize * TextureSize);
+	for (FColor& Pixel : Pixels)
+	{
+		// Some texels with a zero red channel, used as density.
+		Pixel = FColor(RandomStream.RandHelper(4) == 0 ? 0 : RandomStream.RandRange(1, 255), RandomStream.RandRange(0, 255), RandomStream.RandRange(0, 255), RandomStream.RandRange(0, 255));
+	}
+
+	UTexture2D* Texture2D = UTexture2D::CreateTransient(TextureSize, TextureSize, EPixelFormat::PF_B8G8R8A8);
+	Texture2D->CompressionSettings = TextureCompressionSettings::TC_VectorDisplacementmap;
+	Texture2D->SRGB = 0;
+	Texture2D->MipGenSettings = TMGS_NoMipmaps;
+	Texture2D->UpdateResource();
+
+	void* RawTextureData = Texture2D->GetPlatformData()->Mips[0].BulkData.Lock(LOCK_READ_WRITE);
+	FMemory::Memcpy(RawTextureData, Pixels.GetData(), Pixels.Num() * sizeof(FColor));
+	Texture2D->GetPlatformData()->Mips[0].BulkData.Unlock();
+	Texture2D->UpdateResource();
+
+	UPCGTextureData* TextureData = NewObject<UPCGTextureData>();
+
+	FTransform Transform;
+	while (!TextureData->Initialize(Texture2D, /*TextureIndex=*/0, Transform)) {}
+
+	UTEST_TRUE("Texture data successfully initialized", TextureData->IsSuccessfullyInitialized());
+
+	// Includes positions outside of [0, 1], which are wrapped.
+	TArray<FVector2D> Positions;
+	for (int32 i = 0; i < 1000; ++i)
+	{
+		Positions.Emplace(RandomStream.FRandRange(-3.0, 3.0), RandomStream.FRandRange(-3.0, 3.0));
+	}
+
+	TArray<float> Values;
+	Values.SetNumUninitialized(Positions.Num());
+
+	constexpr float DefaultValue = -1.0f;
+
+	for (const EPCGTextureFilter Filter : { EPCGTextureFilter::Point, EPCGTextureFilter::Bilinear })
+	{
+		for (const bool bUseDensitySourceChannel : { false, true })
+		{
+			TextureData->Filter = Filter;
+			TextureData->bUseDensitySourceChannel = bUseDensitySourceChannel;
+			TextureData->ColorChannel = EPCGTextureColorChannel::Red;
+
+			UTEST_TRUE("Batched sampling succeeded", TextureData->SampleChannelLocal(Positions, EPCGTextureColorChannel::Alpha, Values, DefaultValue));
+
+			int32 NumMismatches = 0;
+			for (int32 i = 0; i < Positions.Num(); ++i)
+			{
+				FVector4 Color;
+				float Density = 0.0f;
+				const float Expected = TextureData->SamplePointLocal(Positions[i], Color, Density) ? static_cast<float>(Color.W) : DefaultValue;
+
+				if (!FMath::IsNearlyEqual(Values[i], Expected, UE_KINDA_SMALL_NUMBER))
+				{
+					++NumMismatches;
+				}
+			}
+
+			UTEST_EQUAL(*FString::Printf(TEXT("Filter %d, density %d: same values as SamplePointLocal"), static_cast<int32>(Filter), bUseDensitySourceChannel ? 1 : 0), NumMismatches, 0);
+		}
+	}
+
+	return true;
+}
+
+/** Compact CPU storage samples exactly like the legacy FLinearColor storage, with a quarter of the footprint for 8-bit textures. */
+bool FPCGTextureDataCompactStorage::RunTest(const FString& Parameters)
+{
+	const int32 TextureSize = 64;
+
+	IConsoleVariable* CompactStorageCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("pcg.TextureData.CompactCPUStorage"));
+	UTEST_NOT_NULL("Compact storage console variable exists", CompactStorageCVar);
+
+	FRandomStream RandomStream(42);
+
+	TArray<FColor> Pixels;
+	Pixels.SetNumUninitialized(TextureSize * TextureSize);
+	for (FColor& Pixel : Pixels)
+	{
+		Pixel = FColor(RandomStream.RandRange(0, 255), RandomStream.RandRange(0, 255), RandomStream.RandRange(0, 255), RandomStream.RandRange(0, 255));
+	}
+
+	UTexture2D* Texture2D = UTexture2D::CreateTransient(TextureSize, TextureSize, EPixelFormat::PF_B8G8R8A8);
+	Texture2D->CompressionSettings = TextureCompressionSettings::TC_VectorDisplacementmap;
+	Texture2D->SRGB = 0;
+	Texture2D->MipGenSettings = TMGS_NoMipmaps;
+	Texture2D->UpdateResource();
+
+	void* RawTextureData = Texture2D->GetPlatformData()->Mips[0].BulkData.Lock(LOCK_READ_WRITE);
+	FMemory::Memcpy(RawTextureData, Pixels.GetData(), Pixels.Num() * sizeof(FColor));
+	Texture2D->GetPlatformData()->Mips[0].BulkData.Unlock();
+	Texture2D->UpdateResource();
+
+	const bool bPreviousCompactStorage = CompactStorageCVar->GetBool();
+	ON_SCOPE_EXIT { CompactStorageCVar->Set(bPreviousCompactStorage); };
+
+	FTransform Transform;
+
+	CompactStorageCVar->Set(false);
+	UPCGTextureData* LegacyTextureData = NewObject<UPCGTextureData>();
+	while (!LegacyTextureData->Initialize(Texture2D, /*TextureIndex=*/0, Transform)) {}
+
+	CompactStorageCVar->Set(true);
+	UPCGTextureData* CompactTextureData = NewObject<UPCGTextureData>();
+	while (!CompactTextureData->Initialize(Texture2D, /*TextureIndex=*/0, Transform)) {}
+
+	UTEST_TRUE("Legacy texture data successfully initialized", LegacyTextureData->IsSuccessfullyInitialized());
+	UTEST_TRUE("Compact texture data successfully initialized", CompactTextureData->IsSuccessfullyInitialized());
+	UTEST_TRUE("Legacy storage is RGBA32F", LegacyTextureData->GetCPUStorage() == EPCGTextureCPUStorage::RGBA32F);
+	UTEST_TRUE("Compact storage is BGRA8", CompactTextureData->GetCPUStorage() == EPCGTextureCPUStorage::BGRA8);
+	UTEST_TRUE("Compact storage is smaller", CompactTextureData->GetCPUTexelsSizeBytes() * 4 <= LegacyTextureData->GetCPUTexelsSizeBytes());
+
+	int32 NumTexelMismatches = 0;
+	for (int32 Index = 0; Index < TextureSize * TextureSize; ++Index)
+	{
+		if (CompactTextureData->GetTexel(Index) != LegacyTextureData->GetTexel(Index))
+		{
+			++NumTexelMismatches;
+		}
+	}
+
+	UTEST_EQUAL("Texels decode the same", NumTexelMismatches, 0);
+
+	for (const EPCGTextureFilter Filter : { EPCGTextureFilter::Point, EPCGTextureFilter::Bilinear })
+	{
+		LegacyTextureData->Filter = Filter;
+		CompactTextureData->Filter = Filter;
+
+		int32 NumMismatches = 0;
+		for (int32 i = 0; i < 1000; ++i)
+		{
+			const FVector2D Position(RandomStream.FRandRange(-1.0, 1.0), RandomStream.FRandRange(-1.0, 1.0));
+
+			FVector4 LegacyColor, CompactColor;
+			float LegacyDensity = 0.0f, CompactDensity = 0.0f;
+			const bool bLegacySampled = LegacyTextureData->SamplePointLocal(Position, LegacyColor, LegacyDensity);
+			const bool bCompactSampled = CompactTextureData->SamplePointLocal(Position, CompactColor, CompactDensity);
+
+			if (bLegacySampled != bCompactSampled || LegacyColor != CompactColor || LegacyDensity != CompactDensity)
+			{
+				++NumMismatches;
+			}
+		}
+
+		UTEST_EQUAL(*FString::Printf(TEXT("Filter %d: same samples as legacy storage"), static_cast<int32>(Filter)), NumMismatches, 0);
+	}
+
+	return true;
+}
+
+/**
+* Coarse samples of a one texel checkerboard read the box filtered mip levels (uniform gray) instead of aliasing, only when mip filtering is enabled.
+* Mip levels are stored in the compact layout of the texels (BGRA8 here), so gray is rounded to the nearest 8-bit value.
+*/
+bool FPCGTextureDataMipChain::RunTest(const FString& Parameters)
+{
+	const int32 TextureSize = 64;
+
+	TArray<FColor> Pixels;
+	Pixels.SetNumUninitialized(TextureSize * TextureSize);
+	for (int32 Y = 0; Y < TextureSize; ++Y)
+	{
+		for (int32 X = 0; X < TextureSize; ++X)
+		{
+			Pixels[X + Y * TextureSize] = ((X + Y) % 2 == 0) ? FColor::White : FColor::Black;
+		}
+	}
+
+	UTexture2D* Texture2D = UTexture2D::CreateTransient(TextureSize, TextureSize, EPixelFormat::PF_B8G8R8A8);
+	Texture2D->CompressionSettings = TextureCompressionSettings::TC_VectorDisplacementmap;
+	Texture2D->SRGB = 0;
+	Texture2D->MipGenSettings = TMGS_NoMipmaps;
+	Texture2D->UpdateResource();
+
+	void* RawTextureData = Texture2D->GetPlatformData()->Mips[0].BulkData.Lock(LOCK_READ_WRITE);
+	FMemory::Memcpy(RawTextureData, Pixels.GetData(), Pixels.Num() * sizeof(FColor));
+	Texture2D->GetPlatformData()->Mips[0].BulkData.Unlock();
+	Texture2D->UpdateResource();
+
+	UPCGTextureData* TextureData = NewObject<UPCGTextureData>();
+	TextureData->Filter = EPCGTextureFilter::Point;
+
+	FTransform Transform;
+	while (!TextureData->Initialize(Texture2D, /*TextureIndex=*/0, Transform)) {}
+
+	UTEST_TRUE("Texture data successfully initialized", TextureData->IsSuccessfullyInitialized());
+	UTEST_TRUE("Footprint of 8 texels is mip level 3", FMath::IsNearlyEqual(TextureData->ComputeMipLevel(FVector2D(8.0 / TextureSize)), 3.0f, UE_KINDA_SMALL_NUMBER));
+	UTEST_TRUE("Footprint under a texel is mip level 0", TextureData->ComputeMipLevel(FVector2D(0.5 / TextureSize)) == 0.0f);
+
+	const FVector2D Position(10.25 / TextureSize, 20.25 / TextureSize);
+	FVector4 Color;
+	float Density = 0.0f;
+
+	// Without mip filtering, the mip level is ignored.
+	UTEST_TRUE("Sampled without mip filter", TextureData->SamplePointLocal(Position, Color, Density, /*InMipLevel=*/3.0f));
+	UTEST_EQUAL("Full resolution texel without mip filter", Color.X, 1.0);
+	UTEST_EQUAL("Mip chain not built without mip filter", TextureData->GetNumCPUMipLevels(), 1);
+
+	const SIZE_T SizeBeforeMips = TextureData->GetCPUTexelsSizeBytes();
+
+	for (const EPCGTextureMipFilter MipFilter : { EPCGTextureMipFilter::Box, EPCGTextureMipFilter::Trilinear })
+	{
+		TextureData->MipFilter = MipFilter;
+
+		UTEST_TRUE("Sampled at full resolution", TextureData->SamplePointLocal(Position, Color, Density, /*InMipLevel=*/0.0f));
+		UTEST_EQUAL("Full resolution texel at level 0", Color.X, 1.0);
+
+		for (const float MipLevel : { 1.0f, 2.5f, 20.0f })
+		{
+			UTEST_TRUE("Sampled coarse level", TextureData->SamplePointLocal(Position, Color, Density, MipLevel));
+			UTEST_TRUE(*FString::Printf(TEXT("Mip filter %d, level %.1f: checkerboard averages to gray"), static_cast<int32>(MipFilter), MipLevel), FMath::IsNearlyEqual(Color.X, 0.5, 1.0 / 255.0));
+
+			const TArray<FVector2D> Positions = { Position };
+			TArray<float> Values;
+			Values.SetNumUninitialized(1);
+			UTEST_TRUE("Batched sampling succeeded", TextureData->SampleChannelLocal(Positions, EPCGTextureColorChannel::Red, Values, /*InDefaultValue=*/-1.0f, MipLevel));
+			UTEST_TRUE("Batched coarse sample matches SamplePointLocal", FMath::IsNearlyEqual(Values[0], static_cast<float>(Color.X), UE_KINDA_SMALL_NUMBER));
+		}
+	}
+
+	UTEST_EQUAL("Mip chain down to 1x1", TextureData->GetNumCPUMipLevels(), 7);
+	UTEST_TRUE("Compact storage is BGRA8", TextureData->GetCPUStorage() == EPCGTextureCPUStorage::BGRA8);
+	UTEST_TRUE("Mip chain is accounted for", TextureData->GetCPUTexelsSizeBytes() > SizeBeforeMips);
+	UTEST_TRUE("Mip chain is stored compactly (about a third of the texels)", TextureData->GetCPUTexelsSizeBytes() - SizeBeforeMips < SizeBeforeMips / 2);
+
+	return true;
+}
+
 #endif
@@ -8,6 +8,8 @@
 #include "Data/PCGPointData.h"
 
 #include "Elements/Metadata/PCGMetadataPartition.h"
+#include "Metadata/PCGMetadataAttributeTpl.h"
+#include "Metadata/PCGMetadataPartitionCommon.h"
 
 IMPLEMENT_CUSTOM_SIMPLE_AUTOMATION_TEST(FPCGAttributePartition_Points, FPCGTestBaseClass, "Plugins.PCG.AttributePartition.Points", PCGTestsCommon::TestFlags)
 IMPLEMENT_CUSTOM_SIMPLE_AUTOMATION_TEST(FPCGAttributePartition_AttributeSet, FPCGTestBaseClass, "Plugins.PCG.AttributePartition.AttributeSet", PCGTestsCommon::TestFlags)
@@ -16,11 +18,65 @@ IMPLEMENT_CUSTOM_SIMPLE_AUTOMATION_TEST(FPCGAttributePartition_MultiPartition, F
 IMPLEMENT_CUSTOM_SIMPLE_AUTOMATION_TEST(FPCGAttributePartition_MultiPartitionOverride, FPCGTestBaseClass, "Plugins.PCG.AttributePartition.MultiPartitionOverride", PCGTestsCommon::TestFlags)
 IMPLEMENT_CUSTOM_SIMPLE_AUTOMATION_TEST(FPCGAttributePartition_WithPartitionIndex, FPCGTestBaseClass, "Plugins.PCG.AttributePartition.WithPartitionIndex", PCGTestsCommon::TestFlags)
 IMPLEMENT_CUSTOM_SIMPLE_AUTOMATION_TEST(FPCGAttributePartition_NoPartitionWithPartitionIndex, FPCGTestBaseClass, "Plugins.PCG.AttributePartition.NoPartitionWithPartitionIndex", PCGTestsCommon::TestFlags)
+IMPLEMENT_CUSTOM_SIMPLE_AUTOMATION_TEST(FPCGAttributePartition_MatchesReference, FPCGTestBaseClass, "Plugins.PCG.AttributePartition.MatchesReference", PCGTestsCommon::TestFlags)
 
 namespace PCGAttributePartitionTest
 {
 	const static FName PartitionIndexAttributeName = TEXT("PartitionIndex");
 
+	/** Reference partition: match every value against the unique values found so far, in order. */
+	template <typename T>
+	TArray<TArray<int32>> ReferencePartition(const TArray<T>& Values)
+	{
+		TArray<T> UniqueValues;
+		TArray<TArray<int32>> Partitions;
+
+		for (int32 i = 0; i < Values.Num(); ++i)
+		{
+			int32 UniqueIndex = UniqueValues.IndexOfByPredicate([&Value = Values[i]](const T& Other) { return PCG::Private::MetadataTraits<T>::Equal(Value, Other); });
+			if (UniqueIndex == INDEX_NONE)
+			{
+				UniqueIndex = UniqueValues.Add(Values[i]);
+				Partitions.Emplace();
+			}
+
+			Partitions[UniqueIndex].Add(i);
+		}
+
+		return Partitions;
+	}
+
+	/** Reference multi partition: intersect every pair of partitions in a nested loop, dropping empty intersections. */
+	TArray<TArray<int32>> ReferenceIntersection(const TArray<TArray<int32>>& PartitionsA, const TArray<TArray<int32>>& PartitionsB, int32 NumEntries)
+	{
+		TArray<TArray<int32>> Result;
+		for (const TArray<int32>& PartitionA : PartitionsA)
+		{
+			for (const TArray<int32>& PartitionB : PartitionsB)
+			{
+				TBitArray<> InB(false, NumEntries);
+				for (const int32 Index : PartitionB)
+				{
+					InB[Index] = true;
+				}
+
+				TArray<int32> Intersection = PartitionA.FilterByPredicate([&InB](int32 Index) { return InB[Index]; });
+				if (!Intersection.IsEmpty())
+				{
+					Result.Add(MoveTemp(Intersection));
+				}
+			}
+		}
+
+		return Result;
+	}
+
+	TArray<TArray<int32>> RemoveEmptyPartitions(TArray<TArray<int32>> Partitions)
+	{
+		Partitions.RemoveAll([](const TArray<int32>& Partition) { return Partition.IsEmpty(); });
+		return Partitions;
+	}
+
 	bool MultiPartitionTest(FPCGTestBaseClass& TestClass, bool bWithOverride)
 	{
 		PCGTestsCommon::FTestData TestData;
@@ -413,4 +469,67 @@ bool FPCGAttributePartition_NoPartitionWithPartitionIndex::RunTest(const FString
 
 			return true;
 		});
-}
\ No newline at end of file
+}
+
+/**
+* Compares the partition engine against a brute force reference on many distinct values, for every path:
+* sorted integers, hashed floating point values with a tolerance, value keys for strings, and multi-attribute partitions.
+*/
+bool FPCGAttributePartition_MatchesReference::RunTest(const FString& Parameters)
+{
+	using namespace PCGAttributePartitionTest;
+
+	static const FName IntAttributeName = TEXT("IntAttr");
+	static const FName DoubleAttributeName = TEXT("DoubleAttr");
+	static const FName StringAttributeName = TEXT("StringAttr");
+	constexpr int32 NumPoints = 1000;
+
+	UPCGBasePointData* PointData = PCGTestsCommon::CreateEmptyBasePointData();
+	FPCGMetadataAttribute<int32>* IntAttribute = PointData->Metadata->CreateAttribute<int32>(IntAttributeName, 0, /*bAllowsInterpolation=*/false, /*bOverrideParent=*/true);
+	FPCGMetadataAttribute<double>* DoubleAttribute = PointData->Metadata->CreateAttribute<double>(DoubleAttributeName, 0.0, /*bAllowsInterpolation=*/false, /*bOverrideParent=*/true);
+	FPCGMetadataAttribute<FString>* StringAttribute = PointData->Metadata->CreateAttribute<FString>(StringAttributeName, TEXT("Default"), /*bAllowsInterpolation=*/false, /*bOverrideParent=*/true);
+	check(IntAttribute && DoubleAttribute && StringAttribute);
+
+	TArray<int32> IntValues;
+	TArray<double> DoubleValues;
+	TArray<FString> StringValues;
+
+	PointData->SetNumPoints(NumPoints);
+	TPCGValueRange<int64> MetadataEntryRange = PointData->GetMetadataEntryValueRange();
+
+	for (int32 i = 0; i < NumPoints; ++i)
+	{
+		// Spread the first occurrences so that they are not in value order, and jitter the doubles within the equality tolerance.
+		IntValues.Add((i * 7919) % 211 - 100);
+		DoubleValues.Add(((i * 13) % 101) * 0.5 + ((i % 3 == 0) ? 0.5 * UE_DOUBLE_SMALL_NUMBER : 0.0));
+		StringValues.Add(FString::Printf(TEXT("Value_%d"), (i * 31) % 37));
+
+		PointData->Metadata->InitializeOnSet(MetadataEntryRange[i]);
+		IntAttribute->SetValue(MetadataEntryRange[i], IntValues[i]);
+		DoubleAttribute->SetValue(MetadataEntryRange[i], DoubleValues[i]);
+		StringAttribute->SetValue(MetadataEntryRange[i], StringValues[i]);
+	}
+
+	const FPCGAttributePropertySelector IntSelector = FPCGAttributePropertySelector::CreateAttributeSelector(IntAttributeName);
+	const FPCGAttributePropertySelector DoubleSelector = FPCGAttributePropertySelector::CreateAttributeSelector(DoubleAttributeName);
+	const FPCGAttributePropertySelector StringSelector = FPCGAttributePropertySelector::CreateAttributeSelector(StringAttributeName);
+
+	const TArray<TArray<int32>> IntReference = ReferencePartition(IntValues);
+	const TArray<TArray<int32>> DoubleReference = ReferencePartition(DoubleValues);
+	const TArray<TArray<int32>> StringReference = ReferencePartition(StringValues);
+
+	UTEST_EQUAL("Integer partition matches the reference", PCGMetadataPartitionCommon::AttributeGenericPartition(PointData, IntSelector), IntReference);
+	UTEST_EQUAL("Double partition matches the reference", PCGMetadataPartitionCommon::AttributeGenericPartition(PointData, DoubleSelector), DoubleReference);
+
+	// Value key partitions keep a slot per unused value key, as empty partitions in front.
+	const TArray<TArray<int32>> StringPartition = PCGMetadataPartitionCommon::AttributeGenericPartition(PointData, StringSelector);
+	const int32 FirstNonEmpty = StringPartition.IndexOfByPredicate([](const TArray<int32>& Partition) { return !Partition.IsEmpty(); });
+	UTEST_EQUAL("String partition only has empty partitions in front", RemoveEmptyPartitions(StringPartition).Num(), StringPartition.Num() - FirstNonEmpty);
+	UTEST_EQUAL("String partition matches the reference", RemoveEmptyPartitions(StringPartition), StringReference);
+
+	const FPCGAttributePropertySelector MultiSelectors[] = { IntSelector, StringSelector, DoubleSelector };
+	const TArray<TArray<int32>> MultiReference = ReferenceIntersection(ReferenceIntersection(IntReference, StringReference, NumPoints), DoubleReference, NumPoints);
+	UTEST_EQUAL("Multi partition matches the reference", PCGMetadataPartitionCommon::AttributeGenericPartition(PointData, MultiSelectors), MultiReference);
+
+	return true;
+}
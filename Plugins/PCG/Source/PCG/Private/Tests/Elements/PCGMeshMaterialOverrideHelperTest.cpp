@@ -0,0 +1,102 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "PCGContext.h"
+#include "Data/PCGBasePointData.h"
+#include "MeshSelectors/PCGMeshMaterialOverrideHelper.h"
+#include "Metadata/PCGMetadataAttributeTpl.h"
+#include "Tests/PCGTestsCommon.h"
+
+#include "Materials/MaterialInterface.h"
+
+#if WITH_EDITOR
+
+IMPLEMENT_CUSTOM_SIMPLE_AUTOMATION_TEST(FPCGMeshMaterialOverrideHelperCombinationsTest, FPCGTestBaseClass, "Plugins.PCG.MeshMaterialOverrideHelper.Combinations", PCGTestsCommon::TestFlags)
+
+/**
+* Resolves the material override combinations of points using two material attributes, and validates that each point
+* combination matches its per point overrides, and that combinations are unique.
+*/
+bool FPCGMeshMaterialOverrideHelperCombinationsTest::RunTest(const FString& Parameters)
+{
+	static const FName MaterialAttributeAName = TEXT("MaterialA");
+	static const FName MaterialAttributeBName = TEXT("MaterialB");
+	constexpr int32 NumPoints = 10000;
+
+	const FString MaterialPaths[] = { TEXT("/Game/M_Rock.M_Rock"), TEXT("/Game/M_Moss.M_Moss"), TEXT("/Game/M_Sand.M_Sand") };
+
+	PCGTestsCommon::FTestData TestData;
+	TUniquePtr<FPCGContext> Context = TestData.InitializeTestContext();
+	UTEST_TRUE("Context is valid", Context.IsValid());
+
+	UPCGBasePointData* PointData = PCGTestsCommon::CreateEmptyBasePointData();
+	FPCGMetadataAttribute<FString>* MaterialAttributeA = PointData->Metadata->CreateAttribute<FString>(MaterialAttributeAName, FString(), true, true);
+	FPCGMetadataAttribute<FString>* MaterialAttributeB = PointData->Metadata->CreateAttribute<FString>(MaterialAttributeBName, FString(), true, true);
+	check(MaterialAttributeA && MaterialAttributeB);
+
+	PointData->SetNumPoints(NumPoints);
+
+	TPCGValueRange<int64> MetadataEntryRange = PointData->GetMetadataEntryValueRange();
+	for (int32 i = 0; i < NumPoints; ++i)
+	{
+		PointData->Metadata->InitializeOnSet(MetadataEntryRange[i]);
+		MaterialAttributeA->SetValue(MetadataEntryRange[i], MaterialPaths[(i / 3) % 3]);
+
+		// Leave some points on the default value
+		if (i % 5 != 0)
+		{
+			MaterialAttributeB->SetValue(MetadataEntryRange[i], MaterialPaths[(i / 7) % 2]);
+		}
+	}
+
+	const TArray<FName> MaterialAttributeNames = { MaterialAttributeAName, MaterialAttributeBName };
+
+	FPCGMeshMaterialOverrideHelper Helper;
+	Helper.Initialize(*Context, /*bInByAttributeOverride=*/true, MaterialAttributeNames, PointData->Metadata);
+	UTEST_TRUE("Helper is valid", Helper.IsValid());
+
+	Helper.ResolveCombinations(PointData);
+	UTEST_TRUE("Combinations are resolved", Helper.HasResolvedCombinations());
+
+	// Reference overrides, per point
+	FPCGMeshMaterialOverrideHelper ReferenceHelper;
+	ReferenceHelper.Initialize(*Context, /*bInByAttributeOverride=*/true, MaterialAttributeNames, PointData->Metadata);
+
+	TSet<FString> UniqueOverrides;
+	const TConstPCGValueRange<int64> ConstMetadataEntryRange = PointData->GetConstMetadataEntryValueRange();
+	for (int32 i = 0; i < NumPoints; ++i)
+	{
+		const TArray<TSoftObjectPtr<UMaterialInterface>>& ExpectedOverrides = ReferenceHelper.GetMaterialOverrides(ConstMetadataEntryRange[i]);
+		const int32 CombinationId = Helper.GetCombinationId(i);
+
+		if (CombinationId < 0 || CombinationId >= Helper.GetNumCombinations() || Helper.GetCombination(CombinationId) != ExpectedOverrides)
+		{
+			AddError(FString::Printf(TEXT("Point %d: combination %d doesn't match the point material overrides"), i, CombinationId));
+			return false;
+		}
+
+		FString OverridesKey;
+		for (const TSoftObjectPtr<UMaterialInterface>& Material : ExpectedOverrides)
+		{
+			OverridesKey += Material.ToString() + TEXT(";");
+		}
+
+		UniqueOverrides.Add(OverridesKey);
+	}
+
+	UTEST_EQUAL("One combination per unique material overrides", Helper.GetNumCombinations(), UniqueOverrides.Num());
+
+	// Static overrides resolve to a single combination
+	const TArray<TSoftObjectPtr<UMaterialInterface>> StaticOverrides = { TSoftObjectPtr<UMaterialInterface>(FSoftObjectPath(MaterialPaths[0])) };
+
+	FPCGMeshMaterialOverrideHelper StaticHelper;
+	StaticHelper.Initialize(*Context, /*bUseMaterialOverrideAttributes=*/false, StaticOverrides, MaterialAttributeNames, PointData->Metadata);
+	UTEST_TRUE("Static helper is valid", StaticHelper.IsValid());
+
+	StaticHelper.ResolveCombinations(PointData);
+	UTEST_EQUAL("Static overrides have a single combination", StaticHelper.GetNumCombinations(), 1);
+	UTEST_TRUE("Static combination is the static overrides", StaticHelper.GetCombination(StaticHelper.GetCombinationId(NumPoints - 1)) == StaticOverrides);
+
+	return true;
+}
+
+#endif // WITH_EDITOR
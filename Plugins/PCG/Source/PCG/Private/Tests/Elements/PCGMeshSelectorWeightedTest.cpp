@@ -0,0 +1,270 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Data/PCGBasePointData.h"
+#include "Elements/PCGStaticMeshSpawner.h"
+#include "Elements/PCGStaticMeshSpawnerContext.h"
+#include "Helpers/PCGHelpers.h"
+#include "MeshSelectors/PCGMeshMaterialOverrideHelper.h"
+#include "MeshSelectors/PCGMeshSelectorWeighted.h"
+#include "Metadata/PCGMetadataAttributeTpl.h"
+#include "Tests/PCGTestsCommon.h"
+
+#include "Engine/StaticMesh.h"
+#include "Materials/MaterialInterface.h"
+#include "Math/RandomStream.h"
+
+#if WITH_EDITOR
+
+IMPLEMENT_CUSTOM_SIMPLE_AUTOMATION_TEST(FPCGMeshSelectorWeightedPickTableTest, FPCGTestBaseClass, "Plugins.PCG.MeshSelectorWeighted.PickTable", PCGTestsCommon::TestFlags)
+IMPLEMENT_CUSTOM_SIMPLE_AUTOMATION_TEST(FPCGMeshSelectorWeightedChunkedSelectionTest, FPCGTestBaseClass, "Plugins.PCG.MeshSelectorWeighted.ChunkedSelection", PCGTestsCommon::TestFlags)
+
+namespace PCGMeshSelectorWeightedTest
+{
+	/** Reference pick: first entry whose cumulative weight is above the weighted pick. */
+	int32 LinearPick(const TArray<int>& CumulativeWeights, int32 WeightedPick)
+	{
+		for (int32 Entry = 0; Entry < CumulativeWeights.Num(); ++Entry)
+		{
+			if (WeightedPick < CumulativeWeights[Entry])
+			{
+				return Entry;
+			}
+		}
+
+		return INDEX_NONE;
+	}
+
+	TArray<int> ToCumulativeWeights(const TArray<int>& Weights)
+	{
+		TArray<int> CumulativeWeights;
+		int TotalWeight = 0;
+		for (const int Weight : Weights)
+		{
+			TotalWeight += Weight;
+			CumulativeWeights.Add(TotalWeight);
+		}
+
+		return CumulativeWeights;
+	}
+}
+
+/**
+* Validates that the weighted pick table returns the same entry as a linear scan over the cumulative weights, for every
+* weighted pick in [0, TotalWeight), on even, skewed and zero-width weights.
+*/
+bool FPCGMeshSelectorWeightedPickTableTest::RunTest(const FString& Parameters)
+{
+	using namespace PCGMeshSelectorWeightedTest;
+
+	TArray<TArray<int>> WeightSets =
+	{
+		{ 7 },
+		{ 1, 1, 1 },
+		{ 1, 10, 1 },
+		{ 1000, 1, 1 },
+		{ 1, 1, 1000 },
+		{ 0, 0, 3, 0, 5 },
+		{ 5, 0, 0, 2, 0, 0, 13, 0 },
+		{ 1, 0, 0, 0, 0, 0, 0, 0, 0, 100 }
+	};
+
+	// Many entries, with random weights including zero-width and a few heavy ones
+	FRandomStream RandomSource(42);
+	TArray<int>& RandomWeights = WeightSets.Emplace_GetRef();
+	for (int32 Entry = 0; Entry < 257; ++Entry)
+	{
+		const int32 Roll = RandomSource.RandRange(0, 9);
+		RandomWeights.Add(Roll < 3 ? 0 : (Roll == 9 ? RandomSource.RandRange(500, 2000) : RandomSource.RandRange(1, 20)));
+	}
+
+	for (int32 SetIndex = 0; SetIndex < WeightSets.Num(); ++SetIndex)
+	{
+		const TArray<int> CumulativeWeights = ToCumulativeWeights(WeightSets[SetIndex]);
+		const PCGMeshSelectorWeighted::FWeightedPickTable PickTable(CumulativeWeights);
+		UTEST_EQUAL(*FString::Printf(TEXT("Set %d total weight"), SetIndex), PickTable.TotalWeight, static_cast<int64>(CumulativeWeights.Last()));
+
+		for (int32 WeightedPick = 0; WeightedPick < CumulativeWeights.Last(); ++WeightedPick)
+		{
+			const int32 ExpectedEntry = LinearPick(CumulativeWeights, WeightedPick);
+			const int32 Entry = PickTable.Pick(WeightedPick);
+
+			if (Entry != ExpectedEntry)
+			{
+				AddError(FString::Printf(TEXT("Set %d: weighted pick %d picked entry %d instead of %d"), SetIndex, WeightedPick, Entry, ExpectedEntry));
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+/**
+* Selects meshes on several chunks of points, with reverse culled points and by attribute material overrides, and validates
+* that the chunked selection matches a serial reference: instance lists order, instances and their indices order, out
+* attribute values and out points per mesh.
+*/
+bool FPCGMeshSelectorWeightedChunkedSelectionTest::RunTest(const FString& Parameters)
+{
+	using namespace PCGMeshSelectorWeightedTest;
+
+	static const FName MaterialAttributeName = TEXT("Material");
+	static const FName MeshAttributeName = TEXT("Mesh");
+	constexpr int32 NumPoints = 3 * PCGMeshSelectorWeighted::PointsPerChunk + 1000;
+
+	const FString MeshPaths[] = { TEXT("/Engine/BasicShapes/Cube.Cube"), TEXT("/Engine/BasicShapes/Sphere.Sphere"), TEXT("/Engine/BasicShapes/Cylinder.Cylinder"), TEXT("/Engine/BasicShapes/Cone.Cone") };
+	const FString MaterialPaths[] = { TEXT("/Game/M_Rock.M_Rock"), TEXT("/Game/M_Moss.M_Moss"), TEXT("/Game/M_Sand.M_Sand") };
+
+	UPCGStaticMeshSpawnerSettings* Settings = NewObject<UPCGStaticMeshSpawnerSettings>();
+	Settings->OutAttributeName = MeshAttributeName;
+	Settings->bApplyMeshBoundsToPoints = true;
+
+	// Second entry has no weight and is skipped
+	UPCGMeshSelectorWeighted* Selector = NewObject<UPCGMeshSelectorWeighted>();
+	Selector->MeshEntries.Emplace(TSoftObjectPtr<UStaticMesh>(FSoftObjectPath(MeshPaths[0])), 1);
+	Selector->MeshEntries.Emplace(TSoftObjectPtr<UStaticMesh>(FSoftObjectPath(MeshPaths[1])), 0);
+	Selector->MeshEntries.Emplace(TSoftObjectPtr<UStaticMesh>(FSoftObjectPath(MeshPaths[2])), 10);
+	Selector->MeshEntries.Emplace(TSoftObjectPtr<UStaticMesh>(FSoftObjectPath(MeshPaths[3])), 3);
+	Selector->bUseAttributeMaterialOverrides = true;
+	Selector->MaterialOverrideAttributes = { MaterialAttributeName };
+
+	UPCGBasePointData* PointData = PCGTestsCommon::CreateEmptyBasePointData();
+	FPCGMetadataAttribute<FString>* MaterialAttribute = PointData->Metadata->CreateAttribute<FString>(MaterialAttributeName, FString(), true, true);
+	check(MaterialAttribute);
+
+	PointData->SetNumPoints(NumPoints);
+	PointData->AllocateProperties(EPCGPointNativeProperties::Transform | EPCGPointNativeProperties::Seed | EPCGPointNativeProperties::MetadataEntry);
+
+	TPCGValueRange<FTransform> TransformRange = PointData->GetTransformValueRange();
+	TPCGValueRange<int32> SeedRange = PointData->GetSeedValueRange();
+	TPCGValueRange<int64> MetadataEntryRange = PointData->GetMetadataEntryValueRange();
+	for (int32 i = 0; i < NumPoints; ++i)
+	{
+		// Runs of reverse culled points, crossing the chunk boundaries
+		const bool bReverseCulled = ((i / 1500) % 3 == 1);
+		TransformRange[i] = FTransform(FQuat::Identity, FVector(i, 0, 0), FVector(bReverseCulled ? -1.0 : 1.0, 1.0, 1.0));
+		SeedRange[i] = i * 7 + 3;
+
+		PointData->Metadata->InitializeOnSet(MetadataEntryRange[i]);
+
+		// Leave some points on the default value
+		if (i % 11 != 0)
+		{
+			MaterialAttribute->SetValue(MetadataEntryRange[i], MaterialPaths[(i / 5) % 3]);
+		}
+	}
+
+	// Out point data, as created by the static mesh spawner
+	UPCGBasePointData* OutPointData = PCGTestsCommon::CreateEmptyBasePointData();
+	FPCGInitializeFromDataParams InitializeFromDataParams(PointData);
+	InitializeFromDataParams.bInheritSpatialData = false;
+	OutPointData->InitializeFromDataWithParams(InitializeFromDataParams);
+	OutPointData->SetNumPoints(PointData->GetNumPoints());
+	OutPointData->AllocateProperties(PointData->GetAllocatedProperties());
+	OutPointData->Metadata->CreateStringAttribute(MeshAttributeName, FName(NAME_None).ToString(), /*bAllowsInterpolation=*/false);
+
+	TUniquePtr<FPCGStaticMeshSpawnerContext> Context = MakeUnique<FPCGStaticMeshSpawnerContext>();
+
+	TArray<FPCGMeshInstanceList> MeshInstances;
+	int32 NumCalls = 0;
+	while (!Selector->SelectMeshInstances(*Context, Settings, PointData, MeshInstances, OutPointData))
+	{
+		UTEST_TRUE("Selection progresses", ++NumCalls < NumPoints);
+	}
+
+	// Serial reference: one point at a time, same picks
+	TArray<int> CumulativeWeights;
+	TArray<TArray<FPCGMeshInstanceList>> ReferenceInstances;
+	for (const FPCGMeshSelectorWeightedEntry& Entry : Selector->MeshEntries)
+	{
+		if (Entry.Weight > 0)
+		{
+			CumulativeWeights.Add((CumulativeWeights.IsEmpty() ? 0 : CumulativeWeights.Last()) + Entry.Weight);
+			ReferenceInstances.Emplace_GetRef().Emplace_GetRef(Entry.Descriptor).PointData = PointData;
+		}
+	}
+
+	FPCGMeshMaterialOverrideHelper ReferenceHelper;
+	ReferenceHelper.Initialize(*Context, /*bInByAttributeOverride=*/true, Selector->MaterialOverrideAttributes, PointData->Metadata);
+	UTEST_TRUE("Reference helper is valid", ReferenceHelper.IsValid());
+
+	TArray<FString> ExpectedMeshPaths;
+	TMap<TSoftObjectPtr<UStaticMesh>, TArray<int32>> ExpectedMeshToOutPoints;
+	const TConstPCGValueRange<FTransform> ConstTransformRange = PointData->GetConstTransformValueRange();
+	const TConstPCGValueRange<int32> ConstSeedRange = PointData->GetConstSeedValueRange();
+	const TConstPCGValueRange<int64> ConstMetadataEntryRange = PointData->GetConstMetadataEntryValueRange();
+	for (int32 i = 0; i < NumPoints; ++i)
+	{
+		FRandomStream RandomSource = PCGHelpers::GetRandomStreamFromSeed(ConstSeedRange[i], Settings, Context->ExecutionSource.Get());
+		const int32 PickIndex = LinearPick(CumulativeWeights, RandomSource.RandRange(0, CumulativeWeights.Last() - 1));
+		const bool bReverseCulling = (ConstTransformRange[i].GetDeterminant() < 0);
+
+		FPCGMeshInstanceList& InstanceList = PCGMeshSelectorWeighted::GetInstanceList(ReferenceInstances[PickIndex], /*bUseMaterialOverrides=*/true, ReferenceHelper.GetMaterialOverrides(ConstMetadataEntryRange[i]), bReverseCulling, PointData);
+		InstanceList.Instances.Emplace(ConstTransformRange[i]);
+		InstanceList.InstancesIndices.Emplace(i);
+
+		ExpectedMeshPaths.Add(InstanceList.Descriptor.StaticMesh.ToSoftObjectPath().ToString());
+		ExpectedMeshToOutPoints.FindOrAdd(InstanceList.Descriptor.StaticMesh).Add(i);
+	}
+
+	TArray<FPCGMeshInstanceList> ExpectedMeshInstances;
+	for (TArray<FPCGMeshInstanceList>& PickInstances : ReferenceInstances)
+	{
+		ExpectedMeshInstances.Append(MoveTemp(PickInstances));
+	}
+
+	UTEST_TRUE("Selection uses several chunks", NumPoints > 2 * PCGMeshSelectorWeighted::PointsPerChunk);
+	UTEST_TRUE("Reference has several instance lists per mesh", ExpectedMeshInstances.Num() > CumulativeWeights.Num());
+	UTEST_EQUAL("Same number of instance lists", MeshInstances.Num(), ExpectedMeshInstances.Num());
+
+	for (int32 ListIndex = 0; ListIndex < ExpectedMeshInstances.Num(); ++ListIndex)
+	{
+		const FPCGMeshInstanceList& Expected = ExpectedMeshInstances[ListIndex];
+		const FPCGMeshInstanceList& Actual = MeshInstances[ListIndex];
+
+		UTEST_EQUAL(*FString::Printf(TEXT("List %d mesh"), ListIndex), Actual.Descriptor.StaticMesh.ToString(), Expected.Descriptor.StaticMesh.ToString());
+		UTEST_EQUAL(*FString::Printf(TEXT("List %d reverse culling"), ListIndex), Actual.Descriptor.bReverseCulling, Expected.Descriptor.bReverseCulling);
+		UTEST_TRUE(*FString::Printf(TEXT("List %d material overrides"), ListIndex), Actual.Descriptor.OverrideMaterials == Expected.Descriptor.OverrideMaterials);
+		UTEST_TRUE(*FString::Printf(TEXT("List %d instances indices"), ListIndex), Actual.InstancesIndices == Expected.InstancesIndices);
+		UTEST_EQUAL(*FString::Printf(TEXT("List %d number of instances"), ListIndex), Actual.Instances.Num(), Expected.Instances.Num());
+
+		for (int32 InstanceIndex = 0; InstanceIndex < Expected.Instances.Num(); ++InstanceIndex)
+		{
+			if (!Actual.Instances[InstanceIndex].Equals(Expected.Instances[InstanceIndex]))
+			{
+				AddError(FString::Printf(TEXT("List %d: instance %d doesn't match the reference"), ListIndex, InstanceIndex));
+				return false;
+			}
+		}
+	}
+
+	const FPCGMetadataAttribute<FString>* OutAttribute = OutPointData->Metadata->GetConstTypedAttribute<FString>(MeshAttributeName);
+	UTEST_NOT_NULL("Out attribute exists", OutAttribute);
+	UTEST_EQUAL("Out points are all written", OutPointData->GetNumPoints(), NumPoints);
+
+	const TConstPCGValueRange<FTransform> OutTransformRange = OutPointData->GetConstTransformValueRange();
+	const TConstPCGValueRange<int64> OutMetadataEntryRange = OutPointData->GetConstMetadataEntryValueRange();
+	for (int32 i = 0; i < NumPoints; ++i)
+	{
+		if (OutAttribute->GetValueFromItemKey(OutMetadataEntryRange[i]) != ExpectedMeshPaths[i] || !OutTransformRange[i].Equals(ConstTransformRange[i]))
+		{
+			AddError(FString::Printf(TEXT("Out point %d doesn't match the reference"), i));
+			return false;
+		}
+	}
+
+	UTEST_EQUAL("Same number of meshes with out points", Context->MeshToOutPoints.Num(), ExpectedMeshToOutPoints.Num());
+	for (const TPair<TSoftObjectPtr<UStaticMesh>, TArray<int32>>& ExpectedOutPoints : ExpectedMeshToOutPoints)
+	{
+		const TMap<UPCGBasePointData*, TArray<int32>>* OutPoints = Context->MeshToOutPoints.Find(ExpectedOutPoints.Key);
+		UTEST_NOT_NULL(*FString::Printf(TEXT("Mesh %s has out points"), *ExpectedOutPoints.Key.ToString()), OutPoints);
+
+		const TArray<int32>* OutPointIndices = OutPoints->Find(OutPointData);
+		UTEST_NOT_NULL(*FString::Printf(TEXT("Mesh %s has out points in the out data"), *ExpectedOutPoints.Key.ToString()), OutPointIndices);
+		UTEST_TRUE(*FString::Printf(TEXT("Mesh %s out points"), *ExpectedOutPoints.Key.ToString()), *OutPointIndices == ExpectedOutPoints.Value);
+	}
+
+	return true;
+}
+
+#endif // WITH_EDITOR
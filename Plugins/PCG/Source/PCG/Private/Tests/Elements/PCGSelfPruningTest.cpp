@@ -0,0 +1,104 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Tests/PCGTestsCommon.h"
+
+#include "Data/PCGBasePointData.h"
+#include "Elements/PCGSelfPruning.h"
+
+#include "Math/RandomStream.h"
+
+#if WITH_EDITOR
+
+IMPLEMENT_CUSTOM_SIMPLE_AUTOMATION_TEST(FPCGSelfPruningTest_ParallelDeterminism, FPCGTestBaseClass, "Plugins.PCG.SelfPruning.ParallelDeterminism", PCGTestsCommon::TestFlags)
+
+namespace PCGSelfPruningTest
+{
+	/** Points scattered on a square with random extents, dense enough to have chains of overlapping points and large enough for several parallel passes. */
+	UPCGBasePointData* CreateScatteredPointData(int32 NumPoints, int32 Seed)
+	{
+		UPCGBasePointData* PointData = PCGTestsCommon::CreateEmptyBasePointData();
+		PointData->SetNumPoints(NumPoints);
+		PointData->AllocateProperties(EPCGPointNativeProperties::Transform | EPCGPointNativeProperties::BoundsMin | EPCGPointNativeProperties::BoundsMax | EPCGPointNativeProperties::Seed);
+
+		TPCGValueRange<FTransform> TransformRange = PointData->GetTransformValueRange();
+		TPCGValueRange<FVector> BoundsMinRange = PointData->GetBoundsMinValueRange();
+		TPCGValueRange<FVector> BoundsMaxRange = PointData->GetBoundsMaxValueRange();
+		TPCGValueRange<int32> SeedRange = PointData->GetSeedValueRange();
+
+		FRandomStream RandomSource(Seed);
+		for (int32 i = 0; i < NumPoints; ++i)
+		{
+			TransformRange[i] = FTransform(FVector(RandomSource.FRandRange(0.0, 10000.0), RandomSource.FRandRange(0.0, 10000.0), 0.0));
+
+			// A few extent values only, so the similarity factor groups points and the seeds are used.
+			const double Extent = 10.0 * (1 + RandomSource.RandHelper(6));
+			BoundsMinRange[i] = FVector(-Extent);
+			BoundsMaxRange[i] = FVector(Extent);
+			SeedRange[i] = static_cast<int32>(RandomSource.GetUnsignedInt());
+		}
+
+		return PointData;
+	}
+
+	TArray<int32> Prune(const UPCGBasePointData* InPointData, const FPCGSelfPruningParameters& InParameters)
+	{
+		PCGSelfPruningElement::FIterationState State;
+		State.InputData = InPointData;
+
+		while (!PCGSelfPruningElement::ExecuteSlice(State, InParameters)) {}
+
+		TArray<int32> KeptSeeds;
+		if (State.OutputData)
+		{
+			const TConstPCGValueRange<int32> SeedRange = State.OutputData->GetConstSeedValueRange();
+			KeptSeeds.Reserve(State.OutputData->GetNumPoints());
+			for (int32 i = 0; i < State.OutputData->GetNumPoints(); ++i)
+			{
+				KeptSeeds.Add(SeedRange[i]);
+			}
+		}
+
+		return KeptSeeds;
+	}
+}
+
+/**
+* Runs the self pruning with the sequential and the parallel algorithms on the same data, for all the bounds pruning modes,
+* and validates that they keep exactly the same points in the same order.
+*/
+bool FPCGSelfPruningTest_ParallelDeterminism::RunTest(const FString& Parameters)
+{
+	using namespace PCGSelfPruningTest;
+
+	constexpr int32 NumPoints = 50000;
+	const UPCGBasePointData* PointData = CreateScatteredPointData(NumPoints, /*Seed=*/42);
+
+	const EPCGSelfPruningType PruningTypes[] = { EPCGSelfPruningType::LargeToSmall, EPCGSelfPruningType::SmallToLarge, EPCGSelfPruningType::AllEqual };
+
+	for (const EPCGSelfPruningType PruningType : PruningTypes)
+	{
+		for (const bool bRandomizedPruning : { true, false })
+		{
+			FPCGSelfPruningParameters PruningParameters;
+			PruningParameters.PruningType = PruningType;
+			PruningParameters.bRandomizedPruning = bRandomizedPruning;
+			PruningParameters.ComparisonSource.SetPointProperty(EPCGPointProperties::Extents);
+
+			PruningParameters.bParallelPruning = false;
+			const TArray<int32> SequentialSeeds = Prune(PointData, PruningParameters);
+
+			PruningParameters.bParallelPruning = true;
+			const TArray<int32> ParallelSeeds = Prune(PointData, PruningParameters);
+
+			const FString Description = FString::Printf(TEXT("Type %d, randomized %d"), static_cast<int32>(PruningType), bRandomizedPruning ? 1 : 0);
+
+			UTEST_TRUE(*FString::Printf(TEXT("%s: points were pruned"), *Description), SequentialSeeds.Num() > 0 && SequentialSeeds.Num() < NumPoints);
+			UTEST_EQUAL(*FString::Printf(TEXT("%s: same number of points"), *Description), ParallelSeeds.Num(), SequentialSeeds.Num());
+			UTEST_TRUE(*FString::Printf(TEXT("%s: same points"), *Description), ParallelSeeds == SequentialSeeds);
+		}
+	}
+
+	return true;
+}
+
+#endif // WITH_EDITOR
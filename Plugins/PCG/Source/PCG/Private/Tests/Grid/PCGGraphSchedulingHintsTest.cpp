@@ -0,0 +1,56 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#if WITH_EDITOR
+
+#include "Graph/PCGGraphCompiler.h"
+#include "Tests/PCGTestsCommon.h"
+
+IMPLEMENT_CUSTOM_SIMPLE_AUTOMATION_TEST(FPCGGraphSchedulingHintsTest, FPCGTestBaseClass, "Plugins.PCG.GraphCompiler.SchedulingHints", PCGTestsCommon::TestFlags)
+
+/**
+* Pre task feeding a long chain (A -> B -> C) and a short one (D), both gathered by a post task.
+* D is connected twice to the post task, as tasks can be connected through multiple pins.
+*/
+bool FPCGGraphSchedulingHintsTest::RunTest(const FString& Parameters)
+{
+	constexpr FPCGTaskId PreTask = 0;
+	constexpr FPCGTaskId TaskA = 1;
+	constexpr FPCGTaskId TaskB = 2;
+	constexpr FPCGTaskId TaskC = 3;
+	constexpr FPCGTaskId TaskD = 4;
+	constexpr FPCGTaskId PostTask = 5;
+
+	TArray<FPCGGraphTask> Tasks;
+	Tasks.SetNum(6);
+
+	for (int32 TaskIndex = 0; TaskIndex < Tasks.Num(); ++TaskIndex)
+	{
+		Tasks[TaskIndex].NodeId = TaskIndex;
+	}
+
+	Tasks[TaskA].Inputs.Emplace(PreTask);
+	Tasks[TaskB].Inputs.Emplace(TaskA);
+	Tasks[TaskC].Inputs.Emplace(TaskB);
+	Tasks[TaskD].Inputs.Emplace(PreTask);
+	Tasks[PostTask].Inputs.Emplace(TaskC);
+	Tasks[PostTask].Inputs.Emplace(TaskD);
+	Tasks[PostTask].Inputs.Emplace(TaskD);
+
+	FPCGGraphCompiler::ComputeSchedulingHints(Tasks);
+
+	UTEST_EQUAL("Pre task critical path", Tasks[PreTask].CriticalPathLength, 5);
+	UTEST_EQUAL("A critical path", Tasks[TaskA].CriticalPathLength, 4);
+	UTEST_EQUAL("B critical path", Tasks[TaskB].CriticalPathLength, 3);
+	UTEST_EQUAL("C critical path", Tasks[TaskC].CriticalPathLength, 2);
+	UTEST_EQUAL("D critical path", Tasks[TaskD].CriticalPathLength, 2);
+	UTEST_EQUAL("Post task critical path", Tasks[PostTask].CriticalPathLength, 1);
+
+	UTEST_EQUAL("Pre task successors", Tasks[PreTask].NumSuccessors, 2);
+	UTEST_EQUAL("A successors", Tasks[TaskA].NumSuccessors, 1);
+	UTEST_EQUAL("D successors are counted once per task", Tasks[TaskD].NumSuccessors, 1);
+	UTEST_EQUAL("Post task successors", Tasks[PostTask].NumSuccessors, 0);
+
+	return true;
+}
+
+#endif // WITH_EDITOR
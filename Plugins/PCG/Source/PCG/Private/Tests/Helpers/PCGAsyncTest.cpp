@@ -6,6 +6,60 @@
 
 #include "Helpers/PCGAsync.h"
 
+#include "HAL/PlatformTime.h"
+
+namespace PCGAsyncTest
+{
+	/** Runs a filtering AsyncProcessingEx until done, where the first iterations are much more expensive than the rest. Returns the time spent. */
+	double RunSkewedProcessing(FPCGAsyncState& AsyncState, int32 NumIterations, int32 HeavyIterations, int32 HeavyCost, bool bEnableTimeSlicing, TArray<double>& OutValues)
+	{
+		OutValues.Reset();
+		const double StartTime = FPlatformTime::Seconds();
+
+		bool bIsDone = false;
+		while (!bIsDone)
+		{
+			bIsDone = FPCGAsync::AsyncProcessingEx(
+				&AsyncState,
+				NumIterations,
+				[&OutValues, NumIterations]()
+				{
+					OutValues.SetNumUninitialized(NumIterations);
+				},
+				[&OutValues, HeavyIterations, HeavyCost](int32 ReadIndex, int32 WriteIndex)
+				{
+					if ((ReadIndex % 3) == 0)
+					{
+						return false; // remove one out of three
+					}
+
+					// Emulates uneven costs, like sampling a partly masked surface.
+					double Value = ReadIndex;
+					const int32 Cost = ReadIndex < HeavyIterations ? HeavyCost : 1;
+					for (int32 i = 0; i < Cost; ++i)
+					{
+						Value = FMath::Sqrt(Value * Value + 1.0);
+					}
+
+					OutValues[WriteIndex] = Value;
+					return true;
+				},
+				[&OutValues](int32 ReadIndex, int32 WriteIndex)
+				{
+					OutValues[WriteIndex] = OutValues[ReadIndex];
+				},
+				[&OutValues](int32 Count)
+				{
+					OutValues.SetNum(Count);
+				},
+				bEnableTimeSlicing,
+				/*ChunkSize*/ 16);
+		}
+
+		return FPlatformTime::Seconds() - StartTime;
+	}
+}
+
 IMPLEMENT_CUSTOM_SIMPLE_AUTOMATION_TEST(FPCGAsyncTest_AsyncProcessing, FPCGTestBaseClass, "Plugins.PCG.Async.AsyncProcessing", PCGTestsCommon::TestFlags)
 
 bool FPCGAsyncTest_AsyncProcessing::RunTest(const FString& Parameters)
@@ -127,4 +181,64 @@ bool FPCGAsyncTest_AsyncProcessingOneToOneEx::RunTest(const FString& Parameters)
 	return true;
 }
 
+IMPLEMENT_CUSTOM_SIMPLE_AUTOMATION_TEST(FPCGAsyncTest_DynamicChunkScheduling, FPCGTestBaseClass, "Plugins.PCG.Async.DynamicChunkScheduling", PCGTestsCommon::TestFlags)
+
+bool FPCGAsyncTest_DynamicChunkScheduling::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumIterations = 1000;
+
+	TArray<double> StaticOutput;
+	FPCGAsyncState StaticState;
+	StaticState.NumAvailableTasks = 10;
+	StaticState.bAllowDynamicChunkScheduling = false;
+	PCGAsyncTest::RunSkewedProcessing(StaticState, NumIterations, /*HeavyIterations=*/100, /*HeavyCost=*/10, /*bEnableTimeSlicing=*/false, StaticOutput);
+
+	TArray<double> DynamicOutput;
+	FPCGAsyncState DynamicState;
+	DynamicState.NumAvailableTasks = 10;
+	PCGAsyncTest::RunSkewedProcessing(DynamicState, NumIterations, /*HeavyIterations=*/100, /*HeavyCost=*/10, /*bEnableTimeSlicing=*/false, DynamicOutput);
+
+	UTEST_EQUAL("Wrote Correct Number", DynamicOutput.Num(), NumIterations - (NumIterations + 2) / 3);
+	UTEST_EQUAL("Dynamic scheduling keeps the output order", DynamicOutput, StaticOutput);
+
+	// Stop after every slice, so that the cursor and pending collapses are carried over between slices.
+	TArray<double> SlicedOutput;
+	FPCGAsyncState SlicedState;
+	SlicedState.NumAvailableTasks = 10;
+	SlicedState.EndTime = 0.0;
+	PCGAsyncTest::RunSkewedProcessing(SlicedState, NumIterations, /*HeavyIterations=*/100, /*HeavyCost=*/10, /*bEnableTimeSlicing=*/true, SlicedOutput);
+
+	UTEST_EQUAL("Time sliced dynamic scheduling keeps the output order", SlicedOutput, StaticOutput);
+	UTEST_EQUAL("State is reset when done", SlicedState.NextChunkToProcess, static_cast<int32>(INDEX_NONE));
+
+	return true;
+}
+
+IMPLEMENT_CUSTOM_SIMPLE_AUTOMATION_TEST(FPCGAsyncTest_SkewedCostBenchmark, FPCGTestBaseClass, "Plugins.PCG.Async.SkewedCostBenchmark", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FPCGAsyncTest_SkewedCostBenchmark::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumIterations = 1 << 18;
+	const int32 NumAvailableTasks = FMath::Max(3, FPlatformMisc::NumberOfWorkerThreadsToSpawn());
+
+	// All the cost sits in the first eighth of the iterations, which a static split gives to a single task.
+	TArray<double> StaticOutput;
+	FPCGAsyncState StaticState;
+	StaticState.NumAvailableTasks = NumAvailableTasks;
+	StaticState.bAllowDynamicChunkScheduling = false;
+	const double StaticTime = PCGAsyncTest::RunSkewedProcessing(StaticState, NumIterations, NumIterations / 8, /*HeavyCost=*/200, /*bEnableTimeSlicing=*/false, StaticOutput);
+
+	TArray<double> DynamicOutput;
+	FPCGAsyncState DynamicState;
+	DynamicState.NumAvailableTasks = NumAvailableTasks;
+	const double DynamicTime = PCGAsyncTest::RunSkewedProcessing(DynamicState, NumIterations, NumIterations / 8, /*HeavyCost=*/200, /*bEnableTimeSlicing=*/false, DynamicOutput);
+
+	UTEST_EQUAL("Dynamic scheduling keeps the output order", DynamicOutput, StaticOutput);
+
+	AddInfo(FString::Printf(TEXT("%d iterations on %d tasks: static ranges %.2f ms, dynamic chunks %.2f ms (x%.2f)"),
+		NumIterations, NumAvailableTasks, StaticTime * 1000.0, DynamicTime * 1000.0, DynamicTime > 0.0 ? StaticTime / DynamicTime : 0.0));
+
+	return true;
+}
+
 #endif // WITH_EDITOR
@@ -0,0 +1,277 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#if WITH_EDITOR
+
+#include "Tests/PCGTestsCommon.h"
+
+#include "Data/PCGBasePointData.h"
+#include "Metadata/PCGMetadata.h"
+#include "Metadata/PCGMetadataAttributeTpl.h"
+#include "Metadata/Accessors/IPCGAttributeAccessorTpl.h"
+#include "Metadata/Accessors/PCGAttributeAccessorHelpers.h"
+#include "Metadata/Accessors/PCGAttributeAccessorKeys.h"
+
+#include "HAL/PlatformTime.h"
+
+IMPLEMENT_CUSTOM_SIMPLE_AUTOMATION_TEST(FPCGMetadataEntryStorageTest, FPCGTestBaseClass, "Plugins.PCG.Metadata.EntryStorage.Dense", PCGTestsCommon::TestFlags)
+IMPLEMENT_CUSTOM_SIMPLE_AUTOMATION_TEST(FPCGMetadataEntryStorageBenchmark, FPCGTestBaseClass, "Plugins.PCG.Metadata.EntryStorage.Benchmark", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+namespace PCGMetadataEntryStorageTest
+{
+	const FName AttributeName = TEXT("FloatAttr");
+
+	/** Point data with NumEntries metadata entries, where every ValueStride-th entry keeps the default value. */
+	UPCGBasePointData* CreateRootData(int32 NumEntries, int32 ValueStride)
+	{
+		UPCGBasePointData* PointData = PCGTestsCommon::CreateEmptyBasePointData();
+		FPCGMetadataAttribute<float>* Attribute = PointData->Metadata->CreateAttribute<float>(AttributeName, -1.0f, /*bAllowsInterpolation=*/true, /*bOverrideParent=*/false);
+		check(Attribute);
+
+		for (int32 i = 0; i < NumEntries; ++i)
+		{
+			const PCGMetadataEntryKey EntryKey = PointData->Metadata->AddEntry();
+			if (i % ValueStride != 0)
+			{
+				Attribute->SetValue(EntryKey, static_cast<float>(i));
+			}
+		}
+
+		return PointData;
+	}
+
+	TArray<PCGMetadataEntryKey> MakeEntryKeys(int64 NumEntries)
+	{
+		TArray<PCGMetadataEntryKey> EntryKeys;
+		EntryKeys.SetNumUninitialized(static_cast<int32>(NumEntries));
+		for (int32 i = 0; i < EntryKeys.Num(); ++i)
+		{
+			EntryKeys[i] = i;
+		}
+
+		return EntryKeys;
+	}
+
+	TArray<float> GetValues(const FPCGMetadataAttribute<float>* Attribute, const TArray<PCGMetadataEntryKey>& EntryKeys)
+	{
+		TArray<float> Values;
+		Values.SetNumUninitialized(EntryKeys.Num());
+		Attribute->GetValuesFromItemKeys(TArrayView<const PCGMetadataEntryKey>(EntryKeys), Values);
+		return Values;
+	}
+}
+
+/**
+* Dense and sealed entry storage must read the same value keys as the sparse map, through the single, bulk and accessor reads,
+* for a root attribute, a child attribute with scattered local entries and a grandchild (flattened when sealed).
+* Sealing never adds entries. Writing to a sealed attribute unseals it, and flattening (and compressing) metadata produces dense,
+* sealed entries, with unset entries left out.
+*/
+bool FPCGMetadataEntryStorageTest::RunTest(const FString& Parameters)
+{
+	using namespace PCGMetadataEntryStorageTest;
+
+	constexpr int32 NumRootEntries = 1000;
+	constexpr int32 NumChildEntries = 200;
+
+	UPCGBasePointData* RootData = CreateRootData(NumRootEntries, /*ValueStride=*/3);
+	FPCGMetadataAttribute<float>* RootAttribute = RootData->Metadata->GetMutableTypedAttribute<float>(AttributeName);
+	check(RootAttribute);
+
+	const TArray<PCGMetadataEntryKey> RootKeys = MakeEntryKeys(NumRootEntries);
+	TArray<PCGMetadataValueKey> SparseValueKeys;
+	RootAttribute->GetValueKeys(TArrayView<const PCGMetadataEntryKey>(RootKeys), SparseValueKeys);
+
+	UTEST_TRUE("Attributes start sparse", RootAttribute->GetEntryStorage() == EPCGMetadataEntryStorage::Sparse);
+	UTEST_TRUE("Root converts to dense", RootAttribute->SetEntryStorage(EPCGMetadataEntryStorage::Dense));
+	UTEST_EQUAL("Dense keeps the number of entries", RootAttribute->GetNumberOfEntries(), NumRootEntries - NumRootEntries / 3 - 1);
+
+	TArray<PCGMetadataValueKey> DenseValueKeys;
+	RootAttribute->GetValueKeys(TArrayView<const PCGMetadataEntryKey>(RootKeys), DenseValueKeys);
+	UTEST_TRUE("Dense bulk read matches sparse", DenseValueKeys == SparseValueKeys);
+
+	for (int32 i = 0; i < NumRootEntries; ++i)
+	{
+		UTEST_EQUAL(*FString::Printf(TEXT("Dense read of entry %d matches sparse"), i), RootAttribute->GetValueKey(i), SparseValueKeys[i]);
+	}
+
+	// Child with new entries, a few of them set, plus a couple of overrides of parent entries.
+	UPCGBasePointData* ChildData = Cast<UPCGBasePointData>(RootData->DuplicateData(nullptr));
+	FPCGMetadataAttribute<float>* ChildAttribute = ChildData->Metadata->GetMutableTypedAttribute<float>(AttributeName);
+	UTEST_NOT_NULL("Attribute exists in child", ChildAttribute);
+	check(ChildAttribute);
+
+	for (int32 i = 0; i < NumChildEntries; ++i)
+	{
+		const PCGMetadataEntryKey EntryKey = ChildData->Metadata->AddEntry(i);
+		if (i % 2 == 0)
+		{
+			ChildAttribute->SetValue(EntryKey, 10000.0f + i);
+		}
+	}
+
+	ChildAttribute->SetValue(5, 123.0f);
+	ChildAttribute->SetValue(7, 456.0f);
+
+	UTEST_FALSE("Scattered child entries stay sparse", ChildAttribute->SetEntryStorage(EPCGMetadataEntryStorage::Dense));
+
+	const TArray<PCGMetadataEntryKey> ChildKeys = MakeEntryKeys(NumRootEntries + NumChildEntries);
+	const TArray<float> ExpectedChildValues = GetValues(ChildAttribute, ChildKeys);
+	const int32 NumChildLocalEntries = ChildAttribute->GetNumberOfEntries();
+
+	UTEST_TRUE("Child seals", ChildAttribute->Seal());
+	UTEST_TRUE("Child is sealed", ChildAttribute->IsSealed());
+	UTEST_TRUE("Sealing keeps the child storage", ChildAttribute->GetEntryStorage() == EPCGMetadataEntryStorage::Sparse);
+	UTEST_EQUAL("Sealing keeps the child entries", ChildAttribute->GetNumberOfEntries(), NumChildLocalEntries);
+	UTEST_TRUE("Sealed bulk read matches", GetValues(ChildAttribute, ChildKeys) == ExpectedChildValues);
+
+	for (int32 i = 0; i < ChildKeys.Num(); ++i)
+	{
+		UTEST_EQUAL(*FString::Printf(TEXT("Sealed read of entry %d matches"), i), ChildAttribute->GetValueFromItemKey(i), ExpectedChildValues[i]);
+	}
+
+	TUniquePtr<IPCGAttributeAccessor> Accessor = PCGAttributeAccessorHelpers::CreateAccessor(ChildAttribute, ChildData->Metadata);
+	UTEST_TRUE("Accessor is created", Accessor.IsValid());
+
+	TArray<float> AccessorValues;
+	AccessorValues.SetNumZeroed(ChildKeys.Num());
+	const FPCGAttributeAccessorKeysEntries AccessorKeys(TArrayView<const PCGMetadataEntryKey>(ChildKeys));
+	UTEST_TRUE("Accessor reads the sealed range", Accessor->GetRange<float>(AccessorValues, 0, AccessorKeys));
+	UTEST_TRUE("Accessor values match", AccessorValues == ExpectedChildValues);
+
+	// Grandchild: its parent chain is deeper than MaxSealedParentDepth, so sealing resolves every entry, but not as local entries.
+	UPCGBasePointData* GrandChildData = Cast<UPCGBasePointData>(ChildData->DuplicateData(nullptr));
+	FPCGMetadataAttribute<float>* GrandChildAttribute = GrandChildData->Metadata->GetMutableTypedAttribute<float>(AttributeName);
+	check(GrandChildAttribute);
+
+	UTEST_TRUE("Grandchild seals", GrandChildAttribute->Seal());
+	UTEST_EQUAL("Grandchild has no local entries", GrandChildAttribute->GetNumberOfEntries(), 0);
+	UTEST_TRUE("Grandchild values match", GetValues(GrandChildAttribute, ChildKeys) == ExpectedChildValues);
+
+	// Writes unseal.
+	ChildAttribute->SetValue(0, 42.0f);
+	UTEST_FALSE("Writing unseals", ChildAttribute->IsSealed());
+	UTEST_EQUAL("Written value is read back", ChildAttribute->GetValueFromItemKey(0), 42.0f);
+	UTEST_EQUAL("Other values are kept", ChildAttribute->GetValueFromItemKey(5), 123.0f);
+
+	// Attributes never written, or written on a few entries, keep only those entries once flattened and sealed.
+	const FName UnsetAttributeName = TEXT("UnsetAttr");
+	const FName FewAttributeName = TEXT("FewAttr");
+	GrandChildData->Metadata->CreateAttribute<float>(UnsetAttributeName, -1.0f, /*bAllowsInterpolation=*/true, /*bOverrideParent=*/false);
+	FPCGMetadataAttribute<float>* FewAttribute = GrandChildData->Metadata->CreateAttribute<float>(FewAttributeName, -1.0f, /*bAllowsInterpolation=*/true, /*bOverrideParent=*/false);
+	check(FewAttribute);
+	FewAttribute->SetValue(3, 3.0f);
+	FewAttribute->SetValue(NumRootEntries + 1, 4.0f);
+
+	// Flattening leaves entries 0..N-1, stored densely.
+	GrandChildData->Metadata->Flatten();
+	GrandChildAttribute = GrandChildData->Metadata->GetMutableTypedAttribute<float>(AttributeName);
+	check(GrandChildAttribute);
+
+	UTEST_TRUE("Flattened attribute is dense", GrandChildAttribute->GetEntryStorage() == EPCGMetadataEntryStorage::Dense);
+	UTEST_TRUE("Flattened attribute is sealed", GrandChildAttribute->IsSealed());
+	UTEST_TRUE("Flattened values match", GetValues(GrandChildAttribute, ChildKeys) == ExpectedChildValues);
+
+	const FPCGMetadataAttribute<float>* UnsetAttribute = GrandChildData->Metadata->GetConstTypedAttribute<float>(UnsetAttributeName);
+	UTEST_NOT_NULL("Unset attribute exists after flattening", UnsetAttribute);
+	check(UnsetAttribute);
+	UTEST_TRUE("Unset attribute is sealed", UnsetAttribute->IsSealed());
+	UTEST_EQUAL("Unset attribute has no entries", UnsetAttribute->GetNumberOfEntries(), 0);
+	UTEST_EQUAL("Unset attribute reads the default value", UnsetAttribute->GetValueFromItemKey(NumRootEntries), -1.0f);
+
+	FewAttribute = GrandChildData->Metadata->GetMutableTypedAttribute<float>(FewAttributeName);
+	UTEST_NOT_NULL("Sparse attribute exists after flattening", FewAttribute);
+	check(FewAttribute);
+	UTEST_TRUE("Sparse attribute is sealed", FewAttribute->IsSealed());
+	UTEST_EQUAL("Sparse attribute keeps its entries", FewAttribute->GetNumberOfEntries(), 2);
+
+	TArray<float> ExpectedFewValues;
+	ExpectedFewValues.Init(-1.0f, ChildKeys.Num());
+	ExpectedFewValues[3] = 3.0f;
+	ExpectedFewValues[NumRootEntries + 1] = 4.0f;
+	UTEST_TRUE("Sparse attribute values match", GetValues(FewAttribute, ChildKeys) == ExpectedFewValues);
+	UTEST_EQUAL("Sparse attribute single read of an unset entry", FewAttribute->GetValueFromItemKey(4), -1.0f);
+
+	GrandChildAttribute->SetValue(1, 7.0f);
+	UTEST_FALSE("Writing to flattened data unseals", GrandChildAttribute->IsSealed());
+	UTEST_EQUAL("Written value is read back after flattening", GrandChildAttribute->GetValueFromItemKey(1), 7.0f);
+	UTEST_EQUAL("Other flattened values are kept", GrandChildAttribute->GetValueFromItemKey(5), ExpectedChildValues[5]);
+
+	// Flattening and compressing keeps the selected entries, remapped to 0..N-1, and seals too.
+	UPCGBasePointData* CompressedData = Cast<UPCGBasePointData>(ChildData->DuplicateData(nullptr));
+	const TArray<PCGMetadataEntryKey> EntryKeysToKeep = { 5, 7, 3, NumRootEntries + 2, NumRootEntries + 3 };
+	UTEST_TRUE("Compressing changes the entries", CompressedData->Metadata->FlattenAndCompress(EntryKeysToKeep));
+
+	const FPCGMetadataAttribute<float>* CompressedAttribute = CompressedData->Metadata->GetConstTypedAttribute<float>(AttributeName);
+	UTEST_NOT_NULL("Attribute exists after compression", CompressedAttribute);
+	check(CompressedAttribute);
+	UTEST_TRUE("Compressed attribute is sealed", CompressedAttribute->IsSealed());
+
+	for (int32 i = 0; i < EntryKeysToKeep.Num(); ++i)
+	{
+		UTEST_EQUAL(*FString::Printf(TEXT("Compressed entry %d keeps its value"), i), CompressedAttribute->GetValueFromItemKey(i), ChildAttribute->GetValueFromItemKey(EntryKeysToKeep[i]));
+	}
+
+	return true;
+}
+
+/**
+* Times bulk value key reads (as the attribute accessors do) over all the entries of a root attribute and of a child
+* three levels down, with sparse, dense and sealed entries.
+*/
+bool FPCGMetadataEntryStorageBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace PCGMetadataEntryStorageTest;
+
+	constexpr int32 NumEntries = 1 << 20;
+	constexpr int32 NumIterations = 10;
+
+	const TArray<PCGMetadataEntryKey> EntryKeys = MakeEntryKeys(NumEntries);
+	TArray<PCGMetadataValueKey> ValueKeys;
+
+	auto TimeReads = [&EntryKeys, &ValueKeys](const FPCGMetadataAttributeBase* Attribute)
+	{
+		const double Start = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+		{
+			Attribute->GetValueKeys(TArrayView<const PCGMetadataEntryKey>(EntryKeys), ValueKeys);
+		}
+
+		return (FPlatformTime::Seconds() - Start) * 1e9 / (static_cast<double>(NumIterations) * NumEntries);
+	};
+
+	UPCGBasePointData* RootData = CreateRootData(NumEntries, /*ValueStride=*/7);
+	FPCGMetadataAttribute<float>* RootAttribute = RootData->Metadata->GetMutableTypedAttribute<float>(AttributeName);
+	check(RootAttribute);
+
+	// Child chain, reading the root entries through the parents.
+	UPCGBasePointData* ChildData = RootData;
+	for (int32 Depth = 0; Depth < 3; ++Depth)
+	{
+		ChildData = Cast<UPCGBasePointData>(ChildData->DuplicateData(nullptr));
+	}
+
+	FPCGMetadataAttribute<float>* ChildAttribute = ChildData->Metadata->GetMutableTypedAttribute<float>(AttributeName);
+	check(ChildAttribute);
+
+	const double RootSparse = TimeReads(RootAttribute);
+	const double ChildSparse = TimeReads(ChildAttribute);
+
+	UTEST_TRUE("Root converts to dense", RootAttribute->SetEntryStorage(EPCGMetadataEntryStorage::Dense));
+	const double RootDense = TimeReads(RootAttribute);
+	const double ChildDenseRoot = TimeReads(ChildAttribute);
+
+	const double SealStart = FPlatformTime::Seconds();
+	UTEST_TRUE("Child seals", ChildAttribute->Seal());
+	const double SealTime = FPlatformTime::Seconds() - SealStart;
+
+	UTEST_TRUE("Root seals", RootAttribute->Seal());
+	const double RootSealed = TimeReads(RootAttribute);
+	const double ChildSealed = TimeReads(ChildAttribute);
+
+	AddInfo(FString::Printf(TEXT("%d entries, root: sparse %.2f ns/entry, dense %.2f ns/entry, sealed %.2f ns/entry"), NumEntries, RootSparse, RootDense, RootSealed));
+	AddInfo(FString::Printf(TEXT("%d entries, child at depth 3: sparse %.2f ns/entry, dense root %.2f ns/entry, sealed %.2f ns/entry (seal %.3f ms)"), NumEntries, ChildSparse, ChildDenseRoot, ChildSealed, SealTime * 1000.0));
+
+	return true;
+}
+
+#endif // WITH_EDITOR
@@ -9,6 +9,7 @@
 #include "Metadata/PCGMetadataAttributeTpl.h"
 
 IMPLEMENT_CUSTOM_SIMPLE_AUTOMATION_TEST(FPCGMetadataFlatten, FPCGTestBaseClass, "Plugins.PCG.Metadata.Flatten", PCGTestsCommon::TestFlags)
+IMPLEMENT_CUSTOM_SIMPLE_AUTOMATION_TEST(FPCGMetadataFlattenLarge, FPCGTestBaseClass, "Plugins.PCG.Metadata.Flatten.Large", PCGTestsCommon::TestFlags)
 
 /**
 * Series of operations to manipulate points and attributes, to validate the flatten operation.
@@ -155,4 +156,107 @@ bool FPCGMetadataFlatten::RunTest(const FString& Parameters)
 
 	return true;
 }
-#endif // WITH_EDITOR
\ No newline at end of file
+
+/**
+* Flatten and flatten and compress on attributes large enough to be processed in several batches,
+* validating that every entry keeps the value it had before.
+*/
+bool FPCGMetadataFlattenLarge::RunTest(const FString& Parameters)
+{
+	static const FName FloatAttributeName = TEXT("FloatAttr");
+	static const FName StringAttributeName = TEXT("StringAttr");
+	constexpr int32 NumPoints = 3 * PCGMetadataAttributeConstants::FlattenBatchSize + 17;
+
+	UPCGBasePointData* RootPointData = PCGTestsCommon::CreateEmptyBasePointData();
+	FPCGMetadataAttribute<float>* FloatAttribute = RootPointData->Metadata->CreateAttribute<float>(FloatAttributeName, -1.0f, true, true);
+	FPCGMetadataAttribute<FString>* StringAttribute = RootPointData->Metadata->CreateAttribute<FString>(StringAttributeName, TEXT("Default"), true, true);
+	check(FloatAttribute && StringAttribute);
+
+	RootPointData->SetNumPoints(NumPoints);
+
+	TPCGValueRange<int64> MetadataEntryRange = RootPointData->GetMetadataEntryValueRange();
+	for (int32 i = 0; i < NumPoints; ++i)
+	{
+		RootPointData->Metadata->InitializeOnSet(MetadataEntryRange[i]);
+		FloatAttribute->SetValue(MetadataEntryRange[i], static_cast<float>(i));
+
+		if (i % 3 == 0)
+		{
+			StringAttribute->SetValue(MetadataEntryRange[i], FString::Printf(TEXT("%d"), i % 5));
+		}
+	}
+
+	// Child overrides a quarter of the float values, and sets strings on entries that had the default value
+	UPCGBasePointData* ChildPointData = Cast<UPCGBasePointData>(RootPointData->DuplicateData(nullptr));
+	FloatAttribute = ChildPointData->Metadata->GetMutableTypedAttribute<float>(FloatAttributeName);
+	StringAttribute = ChildPointData->Metadata->GetMutableTypedAttribute<FString>(StringAttributeName);
+	UTEST_TRUE("Attributes exists in child", FloatAttribute && StringAttribute);
+	check(FloatAttribute && StringAttribute);
+
+	TPCGValueRange<int64> ChildMetadataEntryRange = ChildPointData->GetMetadataEntryValueRange();
+	for (int32 i = 0; i < NumPoints; ++i)
+	{
+		if (i % 4 == 0)
+		{
+			ChildPointData->Metadata->InitializeOnSet(ChildMetadataEntryRange[i]);
+			FloatAttribute->SetValue(ChildMetadataEntryRange[i], -static_cast<float>(i));
+		}
+
+		if (i % 7 == 1)
+		{
+			ChildPointData->Metadata->InitializeOnSet(ChildMetadataEntryRange[i]);
+			StringAttribute->SetValue(ChildMetadataEntryRange[i], TEXT("Child"));
+		}
+	}
+
+	TArray<float> ExpectedFloats;
+	TArray<FString> ExpectedStrings;
+	ExpectedFloats.SetNum(NumPoints);
+	ExpectedStrings.SetNum(NumPoints);
+	for (int32 i = 0; i < NumPoints; ++i)
+	{
+		ExpectedFloats[i] = FloatAttribute->GetValueFromItemKey(ChildMetadataEntryRange[i]);
+		ExpectedStrings[i] = StringAttribute->GetValueFromItemKey(ChildMetadataEntryRange[i]);
+	}
+
+	auto ValidateValues = [this, NumPoints, &ExpectedFloats, &ExpectedStrings](const UPCGBasePointData* PointData, const TCHAR* What) -> bool
+	{
+		const FPCGMetadataAttribute<float>* Floats = PointData->Metadata->GetConstTypedAttribute<float>(FloatAttributeName);
+		const FPCGMetadataAttribute<FString>* Strings = PointData->Metadata->GetConstTypedAttribute<FString>(StringAttributeName);
+		UTEST_TRUE(*FString::Printf(TEXT("%s: attributes exist"), What), Floats && Strings);
+		check(Floats && Strings);
+
+		UTEST_NULL(*FString::Printf(TEXT("%s: float attribute has no parent"), What), Floats->GetParent());
+		UTEST_NULL(*FString::Printf(TEXT("%s: string attribute has no parent"), What), Strings->GetParent());
+
+		const TConstPCGValueRange<int64> EntryRange = PointData->GetConstMetadataEntryValueRange();
+		for (int32 i = 0; i < NumPoints; ++i)
+		{
+			// Only report the first mismatch, this test has a lot of points
+			if (Floats->GetValueFromItemKey(EntryRange[i]) != ExpectedFloats[i] || Strings->GetValueFromItemKey(EntryRange[i]) != ExpectedStrings[i])
+			{
+				UTEST_EQUAL(*FString::Printf(TEXT("%s: point %d float value"), What, i), Floats->GetValueFromItemKey(EntryRange[i]), ExpectedFloats[i]);
+				UTEST_EQUAL(*FString::Printf(TEXT("%s: point %d string value"), What, i), Strings->GetValueFromItemKey(EntryRange[i]), ExpectedStrings[i]);
+			}
+		}
+
+		return true;
+	};
+
+	// Flatten only, entry keys are kept.
+	UPCGBasePointData* FlattenedPointData = Cast<UPCGBasePointData>(ChildPointData->DuplicateData(nullptr));
+	FlattenedPointData->Metadata->Flatten();
+	UTEST_TRUE("Flatten keeps the values", ValidateValues(FlattenedPointData, TEXT("Flatten")));
+
+	// Flatten and compress, entry keys are remapped to the point indices, and strings only keep the 6 unique values.
+	UPCGBasePointData* CompressedPointData = Cast<UPCGBasePointData>(ChildPointData->DuplicateData(nullptr));
+	CompressedPointData->Flatten();
+	UTEST_TRUE("Flatten and compress keeps the values", ValidateValues(CompressedPointData, TEXT("FlattenAndCompress")));
+
+	const FPCGMetadataAttribute<FString>* CompressedStrings = CompressedPointData->Metadata->GetConstTypedAttribute<FString>(StringAttributeName);
+	UTEST_EQUAL("Compressed string attribute has one value per unique string", CompressedStrings->GetValueKeyOffsetForChild(), 6);
+
+	return true;
+}
+
+#endif // WITH_EDITOR
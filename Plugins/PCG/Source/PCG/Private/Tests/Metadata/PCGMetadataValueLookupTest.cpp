@@ -0,0 +1,163 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#if WITH_EDITOR
+
+#include "Tests/PCGTestsCommon.h"
+
+#include "Data/PCGBasePointData.h"
+#include "Metadata/PCGMetadata.h"
+#include "Metadata/PCGMetadataAttributeTpl.h"
+
+#include "HAL/PlatformTime.h"
+
+IMPLEMENT_CUSTOM_SIMPLE_AUTOMATION_TEST(FPCGMetadataValueLookupTest, FPCGTestBaseClass, "Plugins.PCG.Metadata.ValueLookup.Deduplication", PCGTestsCommon::TestFlags)
+IMPLEMENT_CUSTOM_SIMPLE_AUTOMATION_TEST(FPCGMetadataValueLookupBenchmark, FPCGTestBaseClass, "Plugins.PCG.Metadata.ValueLookup.Benchmark", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+namespace PCGMetadataValueLookupTest
+{
+	FSoftObjectPath MakePath(int32 Index)
+	{
+		return FSoftObjectPath(FString::Printf(TEXT("/Game/Meshes/SM_Mesh_%d.SM_Mesh_%d"), Index, Index));
+	}
+}
+
+/**
+* Compressed attributes deduplicate their values through a hashed index once they hold enough values.
+* Validates that value keys are stable across the linear and hashed lookups, and through the parent chain.
+*/
+bool FPCGMetadataValueLookupTest::RunTest(const FString& Parameters)
+{
+	using PCGMetadataValueLookupTest::MakePath;
+
+	static const FName PathAttributeName = TEXT("PathAttr");
+	static const FName StringAttributeName = TEXT("StringAttr");
+	constexpr int32 NumRootValues = 200;
+	constexpr int32 NumChildValues = 100;
+
+	UPCGBasePointData* RootPointData = PCGTestsCommon::CreateEmptyBasePointData();
+	FPCGMetadataAttribute<FSoftObjectPath>* RootPathAttribute = RootPointData->Metadata->CreateAttribute<FSoftObjectPath>(PathAttributeName, FSoftObjectPath(), /*bAllowsInterpolation=*/false, /*bOverrideParent=*/true);
+	FPCGMetadataAttribute<FString>* RootStringAttribute = RootPointData->Metadata->CreateAttribute<FString>(StringAttributeName, TEXT("Default"), /*bAllowsInterpolation=*/false, /*bOverrideParent=*/true);
+	check(RootPathAttribute && RootStringAttribute);
+
+	TArray<PCGMetadataValueKey> RootKeys;
+	for (int32 i = 0; i < NumRootValues; ++i)
+	{
+		RootKeys.Add(RootPathAttribute->AddValue(MakePath(i)));
+	}
+
+	UTEST_EQUAL("Root holds all unique values", RootPathAttribute->GetValueKeyOffsetForChild(), NumRootValues);
+
+	for (int32 i = 0; i < NumRootValues; ++i)
+	{
+		UTEST_EQUAL(*FString::Printf(TEXT("Re-adding root value %d returns the same key"), i), RootPathAttribute->AddValue(MakePath(i)), RootKeys[i]);
+	}
+
+	UTEST_EQUAL("Re-adding values does not add any", RootPathAttribute->GetValueKeyOffsetForChild(), NumRootValues);
+	UTEST_EQUAL("Default value maps to the default key", RootPathAttribute->FindValue(FSoftObjectPath()), PCGDefaultValueKey);
+	UTEST_EQUAL("Unknown value is not found", RootPathAttribute->FindValue(MakePath(NumRootValues + NumChildValues)), PCGNotFoundValueKey);
+
+	// FString equality is case insensitive, the hashed lookup must behave the same way as the linear search.
+	for (int32 i = 0; i < NumRootValues; ++i)
+	{
+		RootStringAttribute->AddValue(FString::Printf(TEXT("Value_%d"), i));
+	}
+
+	UTEST_EQUAL("String lookup is case insensitive", RootStringAttribute->FindValue(TEXT("VALUE_42")), RootStringAttribute->FindValue(TEXT("value_42")));
+	UTEST_NOT_EQUAL("String lookup finds existing values", RootStringAttribute->FindValue(TEXT("VALUE_42")), PCGNotFoundValueKey);
+
+	// Child values are found in the parent first, and new values are offset past the parent's values.
+	UPCGBasePointData* ChildPointData = Cast<UPCGBasePointData>(RootPointData->DuplicateData(nullptr));
+	FPCGMetadataAttribute<FSoftObjectPath>* ChildPathAttribute = ChildPointData->Metadata->GetMutableTypedAttribute<FSoftObjectPath>(PathAttributeName);
+	UTEST_NOT_NULL("Attribute exists in child", ChildPathAttribute);
+	check(ChildPathAttribute);
+
+	for (int32 i = 0; i < NumRootValues; ++i)
+	{
+		UTEST_EQUAL(*FString::Printf(TEXT("Child finds root value %d in parent"), i), ChildPathAttribute->AddValue(MakePath(i)), RootKeys[i]);
+	}
+
+	TArray<FSoftObjectPath> ChildValues;
+	for (int32 i = 0; i < NumChildValues; ++i)
+	{
+		ChildValues.Add(MakePath(NumRootValues + i));
+		ChildValues.Add(MakePath(i));
+	}
+
+	const TArray<PCGMetadataValueKey> ChildKeys = ChildPathAttribute->AddValues(ChildValues);
+	UTEST_EQUAL("Child added only its new values", ChildPathAttribute->GetValueKeyOffsetForChild(), NumRootValues + NumChildValues);
+
+	for (int32 i = 0; i < NumChildValues; ++i)
+	{
+		UTEST_EQUAL(*FString::Printf(TEXT("Child value %d is offset past the parent"), i), ChildKeys[2 * i], static_cast<PCGMetadataValueKey>(NumRootValues + i));
+		UTEST_EQUAL(*FString::Printf(TEXT("Parent value %d keeps its parent key"), i), ChildKeys[2 * i + 1], RootKeys[i]);
+		UTEST_EQUAL(*FString::Printf(TEXT("Child value %d round-trips"), i), ChildPathAttribute->GetValue(ChildKeys[2 * i]), MakePath(NumRootValues + i));
+	}
+
+	// Flattening replaces the values, the lookup must follow.
+	ChildPointData->Metadata->Flatten();
+	ChildPathAttribute = ChildPointData->Metadata->GetMutableTypedAttribute<FSoftObjectPath>(PathAttributeName);
+	check(ChildPathAttribute);
+
+	for (int32 i = 0; i < NumRootValues + NumChildValues; ++i)
+	{
+		UTEST_EQUAL(*FString::Printf(TEXT("Flattened value %d is found"), i), ChildPathAttribute->FindValue(MakePath(i)), static_cast<PCGMetadataValueKey>(i));
+	}
+
+	return true;
+}
+
+/**
+* Times AddValue on a soft object path attribute for growing numbers of unique values, then the same values again (all hits).
+* With the hashed lookup the time per value stays flat as the attribute grows, instead of growing linearly.
+*/
+bool FPCGMetadataValueLookupBenchmark::RunTest(const FString& Parameters)
+{
+	using PCGMetadataValueLookupTest::MakePath;
+
+	static const FName PathAttributeName = TEXT("PathAttr");
+	const int32 ValueCounts[] = { 1000, 10000, 100000, 1000000 };
+
+	for (const int32 NumValues : ValueCounts)
+	{
+		TArray<FSoftObjectPath> Paths;
+		Paths.Reserve(NumValues);
+		for (int32 i = 0; i < NumValues; ++i)
+		{
+			Paths.Add(MakePath(i));
+		}
+
+		UPCGBasePointData* PointData = PCGTestsCommon::CreateEmptyBasePointData();
+		FPCGMetadataAttribute<FSoftObjectPath>* Attribute = PointData->Metadata->CreateAttribute<FSoftObjectPath>(PathAttributeName, FSoftObjectPath(), /*bAllowsInterpolation=*/false, /*bOverrideParent=*/true);
+		check(Attribute);
+
+		const double InsertStart = FPlatformTime::Seconds();
+		for (const FSoftObjectPath& Path : Paths)
+		{
+			Attribute->AddValue(Path);
+		}
+		const double InsertTime = FPlatformTime::Seconds() - InsertStart;
+
+		// Values added to a child attribute are looked up through the parent chain first.
+		UPCGBasePointData* ChildPointData = Cast<UPCGBasePointData>(PointData->DuplicateData(nullptr));
+		FPCGMetadataAttribute<FSoftObjectPath>* ChildAttribute = ChildPointData->Metadata->GetMutableTypedAttribute<FSoftObjectPath>(PathAttributeName);
+		check(ChildAttribute);
+
+		const double HitStart = FPlatformTime::Seconds();
+		for (const FSoftObjectPath& Path : Paths)
+		{
+			ChildAttribute->AddValue(Path);
+		}
+		const double HitTime = FPlatformTime::Seconds() - HitStart;
+
+		UTEST_EQUAL(*FString::Printf(TEXT("%d values are deduplicated"), NumValues), ChildAttribute->GetValueKeyOffsetForChild(), NumValues);
+
+		AddInfo(FString::Printf(TEXT("%d unique values: insert %.3f ms (%.1f ns/value), re-add through child %.3f ms (%.1f ns/value)"),
+			NumValues,
+			InsertTime * 1000.0, InsertTime * 1e9 / NumValues,
+			HitTime * 1000.0, HitTime * 1e9 / NumValues));
+	}
+
+	return true;
+}
+
+#endif // WITH_EDITOR
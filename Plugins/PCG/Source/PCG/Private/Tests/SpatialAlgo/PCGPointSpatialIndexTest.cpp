@@ -0,0 +1,157 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#if WITH_EDITOR
+
+#include "Tests/PCGTestsCommon.h"
+
+#include "Data/PCGBasePointData.h"
+#include "Utils/PCGPointSpatialIndex.h"
+
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+
+IMPLEMENT_CUSTOM_SIMPLE_AUTOMATION_TEST(FPCGPointSpatialIndexTest_MatchesOctree, FPCGTestBaseClass, "Plugins.PCG.PointSpatialIndex.MatchesOctree", PCGTestsCommon::TestFlags)
+IMPLEMENT_CUSTOM_SIMPLE_AUTOMATION_TEST(FPCGPointSpatialIndexTest_Benchmark, FPCGTestBaseClass, "Plugins.PCG.PointSpatialIndex.Benchmark", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+namespace PCGPointSpatialIndexTest
+{
+	static constexpr double WorldSize = 100000.0;
+
+	/** Points scattered in a box, with random extents and rotations. */
+	UPCGBasePointData* CreatePointData(int32 NumPoints, int32 Seed)
+	{
+		UPCGBasePointData* PointData = PCGTestsCommon::CreateEmptyBasePointData();
+		PointData->SetNumPoints(NumPoints);
+		PointData->AllocateProperties(EPCGPointNativeProperties::Transform | EPCGPointNativeProperties::BoundsMin | EPCGPointNativeProperties::BoundsMax);
+
+		TPCGValueRange<FTransform> TransformRange = PointData->GetTransformValueRange();
+		TPCGValueRange<FVector> BoundsMinRange = PointData->GetBoundsMinValueRange();
+		TPCGValueRange<FVector> BoundsMaxRange = PointData->GetBoundsMaxValueRange();
+
+		FRandomStream RandomSource(Seed);
+		for (int32 i = 0; i < NumPoints; ++i)
+		{
+			const FVector Location(RandomSource.FRandRange(0.0, WorldSize), RandomSource.FRandRange(0.0, WorldSize), RandomSource.FRandRange(0.0, WorldSize * 0.1));
+			TransformRange[i] = FTransform(FRotator(0.0, RandomSource.FRandRange(0.0, 360.0), 0.0), Location);
+
+			const FVector Extents(RandomSource.FRandRange(10.0, 200.0), RandomSource.FRandRange(10.0, 200.0), RandomSource.FRandRange(10.0, 200.0));
+			BoundsMinRange[i] = -Extents;
+			BoundsMaxRange[i] = Extents;
+		}
+
+		return PointData;
+	}
+
+	FBoxCenterAndExtent RandomQueryBounds(FRandomStream& RandomSource, double InMaxExtent)
+	{
+		const FVector Center(RandomSource.FRandRange(0.0, WorldSize), RandomSource.FRandRange(0.0, WorldSize), RandomSource.FRandRange(0.0, WorldSize * 0.1));
+		const FVector Extent(RandomSource.FRandRange(0.0, InMaxExtent), RandomSource.FRandRange(0.0, InMaxExtent), RandomSource.FRandRange(0.0, InMaxExtent));
+		return FBoxCenterAndExtent(Center, Extent);
+	}
+}
+
+/** Bounds queries on the flat index return the same points as the octree. */
+bool FPCGPointSpatialIndexTest_MatchesOctree::RunTest(const FString& Parameters)
+{
+	using namespace PCGPointSpatialIndexTest;
+
+	constexpr int32 NumPoints = 20000;
+	constexpr int32 NumQueries = 500;
+
+	const UPCGBasePointData* PointData = CreatePointData(NumPoints, /*Seed=*/42);
+	const PCGPointOctree::FPointOctree& Octree = PointData->GetPointOctree();
+	const FPCGPointSpatialIndex& SpatialIndex = PointData->GetPointSpatialIndex();
+
+	UTEST_EQUAL("All points are indexed", SpatialIndex.Num(), NumPoints);
+
+	FRandomStream RandomSource(1234);
+	TArray<int32> OctreeResult;
+	TArray<int32> IndexResult;
+	int32 TotalFound = 0;
+
+	for (int32 QueryIndex = 0; QueryIndex < NumQueries; ++QueryIndex)
+	{
+		const FBoxCenterAndExtent QueryBounds = RandomQueryBounds(RandomSource, /*InMaxExtent=*/2000.0);
+
+		OctreeResult.Reset();
+		Octree.FindElementsWithBoundsTest(QueryBounds, [&OctreeResult](const PCGPointOctree::FPointRef& PointRef) { OctreeResult.Add(PointRef.Index); });
+
+		IndexResult.Reset();
+		SpatialIndex.FindElementsWithBoundsTest(QueryBounds, [&IndexResult](int32 PointIndex) { IndexResult.Add(PointIndex); });
+
+		OctreeResult.Sort();
+		IndexResult.Sort();
+
+		UTEST_TRUE(*FString::Printf(TEXT("Query %d returns the same points"), QueryIndex), OctreeResult == IndexResult);
+		TotalFound += OctreeResult.Num();
+	}
+
+	UTEST_TRUE("Queries found points", TotalFound > 0);
+
+	return true;
+}
+
+/** Build time, memory and query time of the octree and of the flat index. */
+bool FPCGPointSpatialIndexTest_Benchmark::RunTest(const FString& Parameters)
+{
+	using namespace PCGPointSpatialIndexTest;
+
+	constexpr int32 NumQueries = 100000;
+	const int32 PointCounts[] = { 100000, 1000000, 10000000 };
+
+	for (const int32 NumPoints : PointCounts)
+	{
+		const UPCGBasePointData* PointData = CreatePointData(NumPoints, /*Seed=*/42);
+
+		// Bounds are shared by both, compute them first.
+		PointData->GetBounds();
+
+		double StartTime = FPlatformTime::Seconds();
+		const PCGPointOctree::FPointOctree& Octree = PointData->GetPointOctree();
+		const double OctreeBuildTime = FPlatformTime::Seconds() - StartTime;
+
+		StartTime = FPlatformTime::Seconds();
+		const FPCGPointSpatialIndex& SpatialIndex = PointData->GetPointSpatialIndex();
+		const double IndexBuildTime = FPlatformTime::Seconds() - StartTime;
+
+		TArray<FBoxCenterAndExtent> Queries;
+		Queries.Reserve(NumQueries);
+		FRandomStream RandomSource(1234);
+		for (int32 QueryIndex = 0; QueryIndex < NumQueries; ++QueryIndex)
+		{
+			Queries.Add(RandomQueryBounds(RandomSource, /*InMaxExtent=*/500.0));
+		}
+
+		int64 OctreeFound = 0;
+		StartTime = FPlatformTime::Seconds();
+		for (const FBoxCenterAndExtent& Query : Queries)
+		{
+			Octree.FindElementsWithBoundsTest(Query, [&OctreeFound](const PCGPointOctree::FPointRef&) { ++OctreeFound; });
+		}
+		const double OctreeQueryTime = FPlatformTime::Seconds() - StartTime;
+
+		int64 IndexFound = 0;
+		StartTime = FPlatformTime::Seconds();
+		for (const FBoxCenterAndExtent& Query : Queries)
+		{
+			SpatialIndex.FindElementsWithBoundsTest(Query, [&IndexFound](int32) { ++IndexFound; });
+		}
+		const double IndexQueryTime = FPlatformTime::Seconds() - StartTime;
+
+		UTEST_EQUAL(*FString::Printf(TEXT("%d points: same number of results"), NumPoints), IndexFound, OctreeFound);
+
+		AddInfo(FString::Printf(TEXT("%d points: build octree %.1f ms, flat index %.1f ms | memory octree %.1f MB, flat index %.1f MB | %d queries octree %.1f ms, flat index %.1f ms"),
+			NumPoints,
+			OctreeBuildTime * 1000.0,
+			IndexBuildTime * 1000.0,
+			Octree.GetSizeBytes() / (1024.0 * 1024.0),
+			SpatialIndex.GetAllocatedSize() / (1024.0 * 1024.0),
+			NumQueries,
+			OctreeQueryTime * 1000.0,
+			IndexQueryTime * 1000.0));
+	}
+
+	return true;
+}
+
+#endif // WITH_EDITOR
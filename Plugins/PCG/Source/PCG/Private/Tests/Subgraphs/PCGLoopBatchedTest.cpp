@@ -0,0 +1,392 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "PCGComponent.h"
+#include "PCGContext.h"
+#include "PCGGraph.h"
+#include "PCGInputOutputSettings.h"
+#include "Data/PCGPointData.h"
+#include "Elements/PCGLoopElement.h"
+#include "Graph/PCGGraphExecutor.h"
+#include "Tests/PCGTestsCommon.h"
+#include "Tests/Subgraphs/PCGLoopTestSettings.h"
+
+#include "HAL/PlatformTime.h"
+
+#if WITH_EDITOR
+
+IMPLEMENT_CUSTOM_SIMPLE_AUTOMATION_TEST(FPCGLoopBatchedOutputTest, FPCGTestBaseClass, "Plugins.PCG.Subgraph.Loop.BatchedOutput", PCGTestsCommon::TestFlags)
+IMPLEMENT_CUSTOM_SIMPLE_AUTOMATION_TEST(FPCGLoopBatchedExecutionTest, FPCGTestBaseClass, "Plugins.PCG.Subgraph.Loop.BatchedExecution", PCGTestsCommon::TestFlags)
+IMPLEMENT_CUSTOM_SIMPLE_AUTOMATION_TEST(FPCGLoopBatchedNestedTest, FPCGTestBaseClass, "Plugins.PCG.Subgraph.Loop.BatchedNested", PCGTestsCommon::TestFlags)
+IMPLEMENT_CUSTOM_SIMPLE_AUTOMATION_TEST(FPCGLoopBatchedBenchmark, FPCGTestBaseClass, "Plugins.PCG.Subgraph.Loop.BatchedBenchmark", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+namespace PCGLoopBatchedTest
+{
+	/** Graph with the loop data on 'In' and a 'Fixed' input pin. Returns the input node, the label of its 'Fixed' pin in OutFixedPinLabel. */
+	UPCGGraph* CreateGraphWithFixedPin(UPCGNode*& OutInputNode, FName& OutFixedPinLabel)
+	{
+		UPCGGraph* Graph = NewObject<UPCGGraph>();
+		Graph->SetFlags(RF_Transient);
+
+		OutInputNode = Graph->GetInputNode();
+		const FPCGPinProperties& FixedPin = CastChecked<UPCGGraphInputOutputSettings>(OutInputNode->GetSettings())->AddPin(FPCGPinProperties(PCGLoopTest::FixedLabel, EPCGDataType::Point));
+		OutFixedPinLabel = FixedPin.Label;
+		OutInputNode->UpdateAfterSettingsChangeDuringCreation();
+
+		return Graph;
+	}
+
+	/** Loop node over 'In', on a subgraph with a 'Fixed' pin, its 'In' and 'Fixed' pins connected to the given nodes. */
+	UPCGNode* AddLoopNode(UPCGGraph* Graph, UPCGGraph* Subgraph, FName SubgraphFixedPinLabel, UPCGNode* InNode, FName InPinLabel, UPCGNode* FixedNode, FName FixedPinLabel, UPCGLoopSettings*& OutLoopSettings)
+	{
+		UPCGNode* LoopNode = Graph->AddNodeOfType<UPCGLoopSettings>(OutLoopSettings);
+		OutLoopSettings->SetSubgraph(Subgraph);
+		OutLoopSettings->bUseGraphDefaultPinUsage = false;
+		OutLoopSettings->LoopPins = PCGPinConstants::DefaultInputLabel.ToString();
+		LoopNode->UpdateAfterSettingsChangeDuringCreation();
+
+		Graph->AddLabeledEdge(InNode, InPinLabel, LoopNode, PCGPinConstants::DefaultInputLabel);
+		Graph->AddLabeledEdge(FixedNode, FixedPinLabel, LoopNode, SubgraphFixedPinLabel);
+
+		return LoopNode;
+	}
+
+	/** Subgraph: a process node offsetting each loop data by the fixed data, loop data on 'In', fixed data on 'Fixed'. */
+	UPCGGraph* CreateProcessSubgraph(FName& OutFixedPinLabel)
+	{
+		UPCGNode* SubgraphInputNode = nullptr;
+		UPCGGraph* Subgraph = CreateGraphWithFixedPin(SubgraphInputNode, OutFixedPinLabel);
+
+		UPCGLoopTestProcessSettings* ProcessSettings = nullptr;
+		UPCGNode* ProcessNode = Subgraph->AddNodeOfType<UPCGLoopTestProcessSettings>(ProcessSettings);
+		Subgraph->AddLabeledEdge(SubgraphInputNode, PCGPinConstants::DefaultInputLabel, ProcessNode, PCGPinConstants::DefaultInputLabel);
+		Subgraph->AddLabeledEdge(SubgraphInputNode, OutFixedPinLabel, ProcessNode, PCGLoopTest::FixedLabel);
+		Subgraph->AddLabeledEdge(ProcessNode, PCGPinConstants::DefaultOutputLabel, Subgraph->GetOutputNode(), PCGPinConstants::DefaultOutputLabel);
+
+		return Subgraph;
+	}
+
+	/** Main graph: a source node creating NumIterations point data and a fixed point data, looped over by a Loop node on the given subgraph. */
+	UPCGGraph* CreateMainGraph(int32 NumIterations, int32 NumPointsPerData, UPCGGraph* Subgraph, FName SubgraphFixedPinLabel, UPCGLoopSettings*& OutLoopSettings)
+	{
+		UPCGGraph* MainGraph = NewObject<UPCGGraph>();
+		MainGraph->SetFlags(RF_Transient);
+
+		UPCGLoopTestSourceSettings* SourceSettings = nullptr;
+		UPCGNode* SourceNode = MainGraph->AddNodeOfType<UPCGLoopTestSourceSettings>(SourceSettings);
+		SourceSettings->NumData = NumIterations;
+		SourceSettings->NumPointsPerData = NumPointsPerData;
+
+		UPCGNode* LoopNode = AddLoopNode(MainGraph, Subgraph, SubgraphFixedPinLabel, SourceNode, PCGPinConstants::DefaultOutputLabel, SourceNode, PCGLoopTest::FixedLabel, OutLoopSettings);
+		MainGraph->AddLabeledEdge(LoopNode, PCGPinConstants::DefaultOutputLabel, MainGraph->GetOutputNode(), PCGPinConstants::DefaultOutputLabel);
+
+		return MainGraph;
+	}
+
+	/** Main graph looping over the process subgraph. */
+	UPCGGraph* CreateLoopGraph(int32 NumIterations, int32 NumPointsPerData, UPCGLoopSettings*& OutLoopSettings)
+	{
+		FName FixedPinLabel;
+		UPCGGraph* Subgraph = CreateProcessSubgraph(FixedPinLabel);
+		return CreateMainGraph(NumIterations, NumPointsPerData, Subgraph, FixedPinLabel, OutLoopSettings);
+	}
+
+	/**
+	* Main graph looping over an outer subgraph, which loops over the process subgraph (inner loop) and also outputs its loop data as is.
+	* Each outer iteration outputs two data: the processed one (offset by the fixed data) then the original one.
+	*/
+	UPCGGraph* CreateNestedLoopGraph(int32 NumIterations, int32 NumPointsPerData, UPCGLoopSettings*& OutOuterLoopSettings, UPCGLoopSettings*& OutInnerLoopSettings)
+	{
+		FName InnerFixedPinLabel;
+		UPCGGraph* InnerSubgraph = CreateProcessSubgraph(InnerFixedPinLabel);
+
+		UPCGNode* OuterInputNode = nullptr;
+		FName OuterFixedPinLabel;
+		UPCGGraph* OuterSubgraph = CreateGraphWithFixedPin(OuterInputNode, OuterFixedPinLabel);
+
+		UPCGNode* InnerLoopNode = AddLoopNode(OuterSubgraph, InnerSubgraph, InnerFixedPinLabel, OuterInputNode, PCGPinConstants::DefaultInputLabel, OuterInputNode, OuterFixedPinLabel, OutInnerLoopSettings);
+		OuterSubgraph->AddLabeledEdge(InnerLoopNode, PCGPinConstants::DefaultOutputLabel, OuterSubgraph->GetOutputNode(), PCGPinConstants::DefaultOutputLabel);
+		OuterSubgraph->AddLabeledEdge(OuterInputNode, PCGPinConstants::DefaultInputLabel, OuterSubgraph->GetOutputNode(), PCGPinConstants::DefaultOutputLabel);
+
+		return CreateMainGraph(NumIterations, NumPointsPerData, OuterSubgraph, OuterFixedPinLabel, OutOuterLoopSettings);
+	}
+
+	/** Executes the graph of the test component with a new executor (so nothing comes from the cache) and returns the graph output. */
+	FPCGDataCollection ExecuteGraph(PCGTestsCommon::FTestData& TestData)
+	{
+		TSharedPtr<FPCGGraphExecutor> GraphExecutor = MakeShared<FPCGGraphExecutor>();
+		FPCGDataCollection Output;
+		bool bDone = false;
+
+		const FPCGTaskId TaskId = GraphExecutor->Schedule(TestData.TestPCGComponent);
+		TestData.SetCurrentGenerationTask(TaskId);
+
+		GraphExecutor->ScheduleGeneric([&Output, &GraphExecutor, TaskId, &bDone]() -> bool
+		{
+			GraphExecutor->GetOutputData(TaskId, Output);
+			bDone = true;
+			return true;
+		}, [&bDone]() { bDone = true; }, TestData.TestPCGComponent, { TaskId });
+
+		while (!bDone)
+		{
+			GraphExecutor->Execute();
+		}
+
+		return Output;
+	}
+}
+
+/**
+* Simulates the output of a batched loop (outputs grouped by pin, each data tagged with its iteration), and validates that it is
+* reordered as the per-iteration loop would have output it, with the iteration tags removed and the other tags kept.
+*/
+bool FPCGLoopBatchedOutputTest::RunTest(const FString& Parameters)
+{
+	static const FString IterationTagName = TEXT("LoopIteration");
+	static const FName FirstPinLabel = TEXT("First");
+	static const FName SecondPinLabel = TEXT("Second");
+	static const FString UserTag = TEXT("UserTag");
+	constexpr int32 NumIterations = 100;
+
+	TArray<FPCGTaggedData> TaggedData;
+	TMap<const UPCGData*, TPair<int32, FName>> ExpectedIterationAndPin;
+
+	auto AddData = [&](int32 IterationIndex, FName PinLabel)
+	{
+		FPCGTaggedData& Data = TaggedData.Emplace_GetRef();
+		Data.Data = PCGTestsCommon::CreateEmptyPointData();
+		Data.Pin = PinLabel;
+		Data.Tags.Add(UserTag);
+
+		if (IterationIndex != INDEX_NONE)
+		{
+			Data.Tags.Add(PCGLoopHelpers::GetIterationTag(IterationTagName, IterationIndex));
+		}
+
+		ExpectedIterationAndPin.Add(Data.Data.Get(), { IterationIndex == INDEX_NONE ? MAX_int32 : IterationIndex, PinLabel });
+	};
+
+	// Data not derived from an iteration, expected last
+	AddData(INDEX_NONE, FirstPinLabel);
+
+	for (int32 IterationIndex = 0; IterationIndex < NumIterations; ++IterationIndex)
+	{
+		AddData(IterationIndex, FirstPinLabel);
+	}
+
+	// Second pin only has outputs for some iterations, in reverse order
+	for (int32 IterationIndex = NumIterations - 1; IterationIndex >= 0; IterationIndex -= 3)
+	{
+		AddData(IterationIndex, SecondPinLabel);
+	}
+
+	const int32 NumData = TaggedData.Num();
+	const int32 NumUntaggedData = PCGLoopHelpers::SortByIterationAndRemoveTags(IterationTagName, TaggedData);
+
+	UTEST_EQUAL("No data was lost", TaggedData.Num(), NumData);
+	UTEST_EQUAL("Data without an iteration tag is reported", NumUntaggedData, 1);
+
+	int32 PreviousIteration = -1;
+	for (int32 DataIndex = 0; DataIndex < TaggedData.Num(); ++DataIndex)
+	{
+		const FPCGTaggedData& Data = TaggedData[DataIndex];
+		const TPair<int32, FName>* IterationAndPin = ExpectedIterationAndPin.Find(Data.Data.Get());
+		UTEST_NOT_NULL(*FString::Printf(TEXT("Data %d is an input data"), DataIndex), IterationAndPin);
+
+		UTEST_TRUE(*FString::Printf(TEXT("Data %d is in iteration order"), DataIndex), IterationAndPin->Key >= PreviousIteration);
+		UTEST_EQUAL(*FString::Printf(TEXT("Data %d kept its pin"), DataIndex), Data.Pin, IterationAndPin->Value);
+		UTEST_EQUAL(*FString::Printf(TEXT("Data %d only has the user tag"), DataIndex), Data.Tags.Num(), 1);
+		UTEST_TRUE(*FString::Printf(TEXT("Data %d kept the user tag"), DataIndex), Data.Tags.Contains(UserTag));
+
+		// Within an iteration, data keeps its original order, so the first pin comes first
+		if (IterationAndPin->Key == PreviousIteration && IterationAndPin->Key != MAX_int32)
+		{
+			UTEST_EQUAL(*FString::Printf(TEXT("Data %d keeps the pin order within its iteration"), DataIndex), Data.Pin, SecondPinLabel);
+		}
+
+		PreviousIteration = IterationAndPin->Key;
+	}
+
+	UTEST_EQUAL("Data without an iteration tag is last", ExpectedIterationAndPin[TaggedData.Last().Data.Get()].Key, MAX_int32);
+
+	return true;
+}
+
+/**
+* Executes a loop over a subgraph in code, per iteration and batched, and validates that the batched output matches the per-iteration output
+* (same data order, points and tags), that the batched subgraph executes once under a 'not-a-loop index' stack frame, and that the fixed
+* data is forwarded once instead of once per iteration.
+*/
+bool FPCGLoopBatchedExecutionTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumIterations = 16;
+	constexpr int32 NumPointsPerData = 4;
+
+	PCGTestsCommon::FTestData TestData;
+	UPCGLoopSettings* LoopSettings = nullptr;
+	TestData.TestPCGComponent->SetGraphLocal(PCGLoopBatchedTest::CreateLoopGraph(NumIterations, NumPointsPerData, LoopSettings));
+	check(LoopSettings);
+
+	LoopSettings->bBatchIterations = false;
+	PCGLoopTest::ResetExecutionRecord();
+	const FPCGDataCollection PerIterationOutput = PCGLoopBatchedTest::ExecuteGraph(TestData);
+	const PCGLoopTest::FExecutionRecord PerIterationRecord = PCGLoopTest::GetExecutionRecord();
+
+	LoopSettings->bBatchIterations = true;
+	PCGLoopTest::ResetExecutionRecord();
+	const FPCGDataCollection BatchedOutput = PCGLoopBatchedTest::ExecuteGraph(TestData);
+	const PCGLoopTest::FExecutionRecord BatchedRecord = PCGLoopTest::GetExecutionRecord();
+
+	// Scheduling
+	UTEST_EQUAL("Per-iteration loop executes the subgraph once per iteration", PerIterationRecord.NumExecutions, NumIterations);
+	UTEST_EQUAL("Per-iteration subgraphs see the fixed data once", PerIterationRecord.MaxFixedInputs, 1);
+
+	TArray<int32> PerIterationLoopIndices = PerIterationRecord.LoopIndices;
+	PerIterationLoopIndices.Sort();
+	for (int32 IterationIndex = 0; IterationIndex < NumIterations; ++IterationIndex)
+	{
+		UTEST_EQUAL(*FString::Printf(TEXT("Iteration %d has its loop index frame"), IterationIndex), PerIterationLoopIndices[IterationIndex], IterationIndex);
+	}
+
+	UTEST_EQUAL("Batched loop executes the subgraph once", BatchedRecord.NumExecutions, 1);
+	UTEST_EQUAL("Batched subgraph has the 'not-a-loop index' frame", BatchedRecord.LoopIndices[0], static_cast<int32>(INDEX_NONE));
+	UTEST_EQUAL("Batched subgraph sees the data of all iterations", BatchedRecord.NumLoopInputs, NumIterations);
+	UTEST_EQUAL("Batched subgraph sees the fixed data once", BatchedRecord.MaxFixedInputs, 1);
+
+	// Output
+	UTEST_EQUAL("Per-iteration output has a data per iteration", PerIterationOutput.TaggedData.Num(), NumIterations);
+	UTEST_EQUAL("Batched output has the same number of data", BatchedOutput.TaggedData.Num(), PerIterationOutput.TaggedData.Num());
+
+	for (int32 DataIndex = 0; DataIndex < PerIterationOutput.TaggedData.Num(); ++DataIndex)
+	{
+		const FPCGTaggedData& Expected = PerIterationOutput.TaggedData[DataIndex];
+		const FPCGTaggedData& Actual = BatchedOutput.TaggedData[DataIndex];
+
+		UTEST_EQUAL(*FString::Printf(TEXT("Data %d pin"), DataIndex), Actual.Pin, Expected.Pin);
+		UTEST_EQUAL(*FString::Printf(TEXT("Data %d has the same number of tags"), DataIndex), Actual.Tags.Num(), Expected.Tags.Num());
+		UTEST_TRUE(*FString::Printf(TEXT("Data %d has the same tags"), DataIndex), Actual.Tags.Includes(Expected.Tags));
+		UTEST_TRUE(*FString::Printf(TEXT("Data %d comes from the same iteration"), DataIndex), Actual.Tags.Contains(FString::Printf(TEXT("Source:%d"), DataIndex)));
+
+		const UPCGBasePointData* ExpectedData = Cast<UPCGBasePointData>(Expected.Data);
+		const UPCGBasePointData* ActualData = Cast<UPCGBasePointData>(Actual.Data);
+		UTEST_NOT_NULL(*FString::Printf(TEXT("Per-iteration data %d is point data"), DataIndex), ExpectedData);
+		UTEST_NOT_NULL(*FString::Printf(TEXT("Batched data %d is point data"), DataIndex), ActualData);
+		check(ExpectedData && ActualData);
+
+		UTEST_EQUAL(*FString::Printf(TEXT("Data %d number of points"), DataIndex), ActualData->GetNumPoints(), ExpectedData->GetNumPoints());
+
+		const TConstPCGValueRange<FTransform> ExpectedTransforms = ExpectedData->GetConstTransformValueRange();
+		const TConstPCGValueRange<FTransform> ActualTransforms = ActualData->GetConstTransformValueRange();
+		for (int32 PointIndex = 0; PointIndex < ExpectedTransforms.Num(); ++PointIndex)
+		{
+			UTEST_EQUAL(*FString::Printf(TEXT("Data %d point %d location"), DataIndex, PointIndex), ActualTransforms[PointIndex].GetLocation(), ExpectedTransforms[PointIndex].GetLocation());
+		}
+	}
+
+	return true;
+}
+
+/**
+* Executes a batched loop nested in the subgraph of a batched loop, both using the default iteration tag, and validates that the output matches
+* the per-iteration nested loops: the inner loop only removes and sorts on its own iteration tags, so the outer loop still splits its output per
+* iteration (processed then original data of each iteration) and no iteration tag is left.
+*/
+bool FPCGLoopBatchedNestedTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumIterations = 8;
+	constexpr int32 NumPointsPerData = 2;
+
+	PCGTestsCommon::FTestData TestData;
+	UPCGLoopSettings* OuterLoopSettings = nullptr;
+	UPCGLoopSettings* InnerLoopSettings = nullptr;
+	TestData.TestPCGComponent->SetGraphLocal(PCGLoopBatchedTest::CreateNestedLoopGraph(NumIterations, NumPointsPerData, OuterLoopSettings, InnerLoopSettings));
+	check(OuterLoopSettings && InnerLoopSettings);
+
+	UTEST_EQUAL("Both loops use the same iteration tag setting", OuterLoopSettings->IterationTag, InnerLoopSettings->IterationTag);
+
+	OuterLoopSettings->bBatchIterations = false;
+	InnerLoopSettings->bBatchIterations = false;
+	const FPCGDataCollection PerIterationOutput = PCGLoopBatchedTest::ExecuteGraph(TestData);
+
+	OuterLoopSettings->bBatchIterations = true;
+	InnerLoopSettings->bBatchIterations = true;
+	PCGLoopTest::ResetExecutionRecord();
+	const FPCGDataCollection BatchedOutput = PCGLoopBatchedTest::ExecuteGraph(TestData);
+	const PCGLoopTest::FExecutionRecord BatchedRecord = PCGLoopTest::GetExecutionRecord();
+
+	UTEST_EQUAL("Nested batched loops execute the process subgraph once", BatchedRecord.NumExecutions, 1);
+	UTEST_EQUAL("Per-iteration output has two data per iteration", PerIterationOutput.TaggedData.Num(), 2 * NumIterations);
+	UTEST_EQUAL("Batched output has the same number of data", BatchedOutput.TaggedData.Num(), PerIterationOutput.TaggedData.Num());
+
+	for (int32 DataIndex = 0; DataIndex < PerIterationOutput.TaggedData.Num(); ++DataIndex)
+	{
+		const FPCGTaggedData& Expected = PerIterationOutput.TaggedData[DataIndex];
+		const FPCGTaggedData& Actual = BatchedOutput.TaggedData[DataIndex];
+
+		UTEST_EQUAL(*FString::Printf(TEXT("Data %d has the same number of tags"), DataIndex), Actual.Tags.Num(), Expected.Tags.Num());
+		UTEST_TRUE(*FString::Printf(TEXT("Data %d has the same tags"), DataIndex), Actual.Tags.Includes(Expected.Tags));
+		UTEST_TRUE(*FString::Printf(TEXT("Data %d comes from the same iteration"), DataIndex), Actual.Tags.Contains(FString::Printf(TEXT("Source:%d"), DataIndex / 2)));
+
+		for (const FString& Tag : Actual.Tags)
+		{
+			UTEST_FALSE(*FString::Printf(TEXT("Data %d has no iteration tag left"), DataIndex), Tag.StartsWith(OuterLoopSettings->IterationTag));
+		}
+
+		const UPCGBasePointData* ExpectedData = Cast<UPCGBasePointData>(Expected.Data);
+		const UPCGBasePointData* ActualData = Cast<UPCGBasePointData>(Actual.Data);
+		UTEST_NOT_NULL(*FString::Printf(TEXT("Per-iteration data %d is point data"), DataIndex), ExpectedData);
+		UTEST_NOT_NULL(*FString::Printf(TEXT("Batched data %d is point data"), DataIndex), ActualData);
+		check(ExpectedData && ActualData);
+
+		UTEST_EQUAL(*FString::Printf(TEXT("Data %d number of points"), DataIndex), ActualData->GetNumPoints(), ExpectedData->GetNumPoints());
+
+		const TConstPCGValueRange<FTransform> ExpectedTransforms = ExpectedData->GetConstTransformValueRange();
+		const TConstPCGValueRange<FTransform> ActualTransforms = ActualData->GetConstTransformValueRange();
+		for (int32 PointIndex = 0; PointIndex < ExpectedTransforms.Num(); ++PointIndex)
+		{
+			UTEST_EQUAL(*FString::Printf(TEXT("Data %d point %d location"), DataIndex, PointIndex), ActualTransforms[PointIndex].GetLocation(), ExpectedTransforms[PointIndex].GetLocation());
+		}
+	}
+
+	return true;
+}
+
+/** Times a loop of thousands of iterations over a trivial subgraph, per iteration and batched. */
+bool FPCGLoopBatchedBenchmark::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumIterations = 4096;
+	constexpr int32 NumPointsPerData = 16;
+
+	PCGTestsCommon::FTestData TestData;
+	UPCGLoopSettings* LoopSettings = nullptr;
+	TestData.TestPCGComponent->SetGraphLocal(PCGLoopBatchedTest::CreateLoopGraph(NumIterations, NumPointsPerData, LoopSettings));
+	check(LoopSettings);
+
+	auto TimeExecution = [&TestData, LoopSettings](bool bBatchIterations, int32& OutNumData)
+	{
+		LoopSettings->bBatchIterations = bBatchIterations;
+
+		const double Start = FPlatformTime::Seconds();
+		OutNumData = PCGLoopBatchedTest::ExecuteGraph(TestData).TaggedData.Num();
+		return FPlatformTime::Seconds() - Start;
+	};
+
+	int32 NumPerIterationData = 0;
+	int32 NumBatchedData = 0;
+	const double PerIterationTime = TimeExecution(/*bBatchIterations=*/false, NumPerIterationData);
+	const double BatchedTime = TimeExecution(/*bBatchIterations=*/true, NumBatchedData);
+
+	UTEST_EQUAL("Per-iteration output has a data per iteration", NumPerIterationData, NumIterations);
+	UTEST_EQUAL("Batched output has a data per iteration", NumBatchedData, NumIterations);
+
+	AddInfo(FString::Printf(TEXT("%d iterations of %d points: per iteration %.1f ms, batched %.1f ms (x%.1f)"),
+		NumIterations,
+		NumPointsPerData,
+		PerIterationTime * 1000.0,
+		BatchedTime * 1000.0,
+		BatchedTime > 0.0 ? PerIterationTime / BatchedTime : 0.0));
+
+	return true;
+}
+
+#endif // WITH_EDITOR
@@ -0,0 +1,169 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Tests/Subgraphs/PCGLoopTestSettings.h"
+
+#include "PCGContext.h"
+#include "PCGPin.h"
+#include "Data/PCGBasePointData.h"
+#include "Graph/PCGStackContext.h"
+
+#include "Misc/ScopeLock.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(PCGLoopTestSettings)
+
+namespace PCGLoopTest
+{
+	static FCriticalSection ExecutionRecordLock;
+	static FExecutionRecord ExecutionRecord;
+
+	void ResetExecutionRecord()
+	{
+		FScopeLock Lock(&ExecutionRecordLock);
+		ExecutionRecord = FExecutionRecord();
+	}
+
+	FExecutionRecord GetExecutionRecord()
+	{
+		FScopeLock Lock(&ExecutionRecordLock);
+		return ExecutionRecord;
+	}
+}
+
+UPCGLoopTestSourceSettings::UPCGLoopTestSourceSettings()
+{
+#if WITH_EDITORONLY_DATA
+	bExposeToLibrary = false;
+#endif
+}
+
+FPCGElementPtr UPCGLoopTestSourceSettings::CreateElement() const
+{
+	return MakeShared<FPCGLoopTestSourceElement>();
+}
+
+TArray<FPCGPinProperties> UPCGLoopTestSourceSettings::OutputPinProperties() const
+{
+	TArray<FPCGPinProperties> PinProperties;
+	PinProperties.Emplace(PCGPinConstants::DefaultOutputLabel, EPCGDataType::Point);
+	PinProperties.Emplace(PCGLoopTest::FixedLabel, EPCGDataType::Point);
+
+	return PinProperties;
+}
+
+bool FPCGLoopTestSourceElement::ExecuteInternal(FPCGContext* Context) const
+{
+	const UPCGLoopTestSourceSettings* Settings = Context->GetInputSettings<UPCGLoopTestSourceSettings>();
+	check(Settings);
+
+	for (int32 DataIndex = 0; DataIndex < Settings->NumData; ++DataIndex)
+	{
+		UPCGBasePointData* PointData = FPCGContext::NewPointData_AnyThread(Context);
+		PointData->SetNumPoints(Settings->NumPointsPerData);
+
+		TPCGValueRange<FTransform> Transforms = PointData->GetTransformValueRange();
+		for (int32 PointIndex = 0; PointIndex < Transforms.Num(); ++PointIndex)
+		{
+			Transforms[PointIndex].SetLocation(FVector(DataIndex * 100.0, PointIndex * 10.0, 0.0));
+		}
+
+		FPCGTaggedData& Output = Context->OutputData.TaggedData.Emplace_GetRef();
+		Output.Data = PointData;
+		Output.Pin = PCGPinConstants::DefaultOutputLabel;
+		Output.Tags.Add(FString::Printf(TEXT("Source:%d"), DataIndex));
+	}
+
+	UPCGBasePointData* FixedData = FPCGContext::NewPointData_AnyThread(Context);
+	FixedData->SetNumPoints(1);
+	FixedData->GetTransformValueRange()[0].SetLocation(FVector(0.0, 0.0, 1000.0));
+
+	FPCGTaggedData& FixedOutput = Context->OutputData.TaggedData.Emplace_GetRef();
+	FixedOutput.Data = FixedData;
+	FixedOutput.Pin = PCGLoopTest::FixedLabel;
+
+	return true;
+}
+
+UPCGLoopTestProcessSettings::UPCGLoopTestProcessSettings()
+{
+#if WITH_EDITORONLY_DATA
+	bExposeToLibrary = false;
+#endif
+}
+
+FPCGElementPtr UPCGLoopTestProcessSettings::CreateElement() const
+{
+	return MakeShared<FPCGLoopTestProcessElement>();
+}
+
+TArray<FPCGPinProperties> UPCGLoopTestProcessSettings::InputPinProperties() const
+{
+	TArray<FPCGPinProperties> PinProperties;
+	PinProperties.Emplace(PCGPinConstants::DefaultInputLabel, EPCGDataType::Point);
+	PinProperties.Emplace(PCGLoopTest::FixedLabel, EPCGDataType::Point);
+
+	return PinProperties;
+}
+
+TArray<FPCGPinProperties> UPCGLoopTestProcessSettings::OutputPinProperties() const
+{
+	TArray<FPCGPinProperties> PinProperties;
+	PinProperties.Emplace(PCGPinConstants::DefaultOutputLabel, EPCGDataType::Point);
+
+	return PinProperties;
+}
+
+bool FPCGLoopTestProcessElement::ExecuteInternal(FPCGContext* Context) const
+{
+	const TArray<FPCGTaggedData> Inputs = Context->InputData.GetInputsByPin(PCGPinConstants::DefaultInputLabel);
+	const TArray<FPCGTaggedData> FixedInputs = Context->InputData.GetInputsByPin(PCGLoopTest::FixedLabel);
+
+	FVector Offset = FVector::ZeroVector;
+	if (const UPCGBasePointData* FixedData = !FixedInputs.IsEmpty() ? Cast<UPCGBasePointData>(FixedInputs[0].Data) : nullptr)
+	{
+		Offset = FixedData->GetNumPoints() > 0 ? FixedData->GetConstTransformValueRange()[0].GetLocation() : FVector::ZeroVector;
+	}
+
+	int32 LoopIndex = MIN_int32;
+	if (const FPCGStack* Stack = Context->GetStack())
+	{
+		for (const FPCGStackFrame& Frame : Stack->GetStackFrames())
+		{
+			if (Frame.IsLoopIndexFrame())
+			{
+				LoopIndex = Frame.LoopIndex;
+				break;
+			}
+		}
+	}
+
+	{
+		FScopeLock Lock(&PCGLoopTest::ExecutionRecordLock);
+		PCGLoopTest::ExecutionRecord.NumExecutions++;
+		PCGLoopTest::ExecutionRecord.NumLoopInputs += Inputs.Num();
+		PCGLoopTest::ExecutionRecord.MaxFixedInputs = FMath::Max(PCGLoopTest::ExecutionRecord.MaxFixedInputs, FixedInputs.Num());
+		PCGLoopTest::ExecutionRecord.LoopIndices.Add(LoopIndex);
+	}
+
+	for (const FPCGTaggedData& Input : Inputs)
+	{
+		const UPCGBasePointData* InputData = Cast<UPCGBasePointData>(Input.Data);
+		if (!InputData)
+		{
+			continue;
+		}
+
+		UPCGBasePointData* OutputData = CastChecked<UPCGBasePointData>(InputData->DuplicateData(Context));
+
+		TPCGValueRange<FTransform> Transforms = OutputData->GetTransformValueRange();
+		for (FTransform& Transform : Transforms)
+		{
+			Transform.AddToTranslation(Offset);
+		}
+
+		FPCGTaggedData& Output = Context->OutputData.TaggedData.Add_GetRef(Input);
+		Output.Data = OutputData;
+		Output.Pin = PCGPinConstants::DefaultOutputLabel;
+	}
+
+	return true;
+}
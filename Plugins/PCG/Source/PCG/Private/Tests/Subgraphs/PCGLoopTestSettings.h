@@ -0,0 +1,90 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "PCGSettings.h"
+#include "PCGElement.h"
+
+#include "PCGLoopTestSettings.generated.h"
+
+namespace PCGLoopTest
+{
+	const FName FixedLabel = TEXT("Fixed");
+
+	/** What the process elements saw, over all their executions since the last reset. */
+	struct FExecutionRecord
+	{
+		int32 NumExecutions = 0;
+		int32 NumLoopInputs = 0;
+		int32 MaxFixedInputs = 0;
+
+		/** Loop index frame of each execution stack, INDEX_NONE for a batched execution. */
+		TArray<int32> LoopIndices;
+	};
+
+	void ResetExecutionRecord();
+	FExecutionRecord GetExecutionRecord();
+}
+
+/** Test node creating NumData point data on its output pin, and a single point data on the 'Fixed' pin. */
+UCLASS(HideDropdown, NotPlaceable, MinimalAPI)
+class UPCGLoopTestSourceSettings : public UPCGSettings
+{
+	GENERATED_BODY()
+
+public:
+	UPCGLoopTestSourceSettings();
+
+#if WITH_EDITOR
+	virtual FName GetDefaultNodeName() const override { return FName(TEXT("LoopTestSource")); }
+	virtual EPCGSettingsType GetType() const override { return EPCGSettingsType::Spatial; }
+#endif
+
+	virtual FPCGElementPtr CreateElement() const override;
+
+	UPROPERTY()
+	int32 NumData = 1;
+
+	UPROPERTY()
+	int32 NumPointsPerData = 1;
+
+protected:
+	virtual TArray<FPCGPinProperties> InputPinProperties() const override { return {}; }
+	virtual TArray<FPCGPinProperties> OutputPinProperties() const override;
+};
+
+class FPCGLoopTestSourceElement : public IPCGElement
+{
+protected:
+	virtual bool ExecuteInternal(FPCGContext* Context) const override;
+};
+
+/**
+* Test node offsetting the points of each input data by the location of the first point on the 'Fixed' pin, keeping the tags.
+* Records its executions (see PCGLoopTest::GetExecutionRecord).
+*/
+UCLASS(HideDropdown, NotPlaceable, MinimalAPI)
+class UPCGLoopTestProcessSettings : public UPCGSettings
+{
+	GENERATED_BODY()
+
+public:
+	UPCGLoopTestProcessSettings();
+
+#if WITH_EDITOR
+	virtual FName GetDefaultNodeName() const override { return FName(TEXT("LoopTestProcess")); }
+	virtual EPCGSettingsType GetType() const override { return EPCGSettingsType::Spatial; }
+#endif
+
+	virtual FPCGElementPtr CreateElement() const override;
+
+protected:
+	virtual TArray<FPCGPinProperties> InputPinProperties() const override;
+	virtual TArray<FPCGPinProperties> OutputPinProperties() const override;
+};
+
+class FPCGLoopTestProcessElement : public IPCGElement
+{
+protected:
+	virtual bool ExecuteInternal(FPCGContext* Context) const override;
+};
@@ -0,0 +1,239 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Utils/PCGPointSpatialIndex.h"
+
+#include "Async/ParallelFor.h"
+#include "HAL/IConsoleManager.h"
+
+#include <cmath>
+
+static TAutoConsoleVariable<bool> CVarFlatSpatialIndex(
+	TEXT("pcg.PointData.FlatSpatialIndex"),
+	false,
+	TEXT("Point queries (closest point, points inside a sphere...) use a flat spatial index built in bulk and in parallel, instead of the point octree."));
+
+namespace PCGPointSpatialIndex
+{
+	/** Points processed per parallel task during the build. */
+	constexpr int32 BuildBatchSize = 16 * 1024;
+
+	/** Bits per axis of the Morton codes. */
+	constexpr int32 MortonBitsPerAxis = 10;
+
+	/** Bits per radix sort pass. 3 passes cover the 30 bits of the Morton codes. */
+	constexpr int32 RadixBits = 10;
+	constexpr int32 NumRadixPasses = (3 * MortonBitsPerAxis + RadixBits - 1) / RadixBits;
+
+	/** Spreads the 10 low bits of the value so there are 2 zero bits between each of them. */
+	uint32 SpreadBits(uint32 InValue)
+	{
+		InValue &= 0x000003ff;
+		InValue = (InValue ^ (InValue << 16)) & 0xff0000ff;
+		InValue = (InValue ^ (InValue << 8)) & 0x0300f00f;
+		InValue = (InValue ^ (InValue << 4)) & 0x030c30c3;
+		InValue = (InValue ^ (InValue << 2)) & 0x09249249;
+		return InValue;
+	}
+
+	uint32 ComputeMortonCode(const FVector& InNormalizedPosition)
+	{
+		constexpr double MaxCoordinate = static_cast<double>((1 << MortonBitsPerAxis) - 1);
+		const uint32 X = static_cast<uint32>(FMath::Clamp(InNormalizedPosition.X * MaxCoordinate, 0.0, MaxCoordinate));
+		const uint32 Y = static_cast<uint32>(FMath::Clamp(InNormalizedPosition.Y * MaxCoordinate, 0.0, MaxCoordinate));
+		const uint32 Z = static_cast<uint32>(FMath::Clamp(InNormalizedPosition.Z * MaxCoordinate, 0.0, MaxCoordinate));
+		return (SpreadBits(X) << 2) | (SpreadBits(Y) << 1) | SpreadBits(Z);
+	}
+
+	/** Stable LSD radix sort on the Morton code stored in the high 32 bits. Ties keep the point index order, so the result is deterministic. */
+	void SortKeys(TArray<uint64>& InOutKeys)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(PCGPointSpatialIndex::SortKeys);
+
+		constexpr int32 NumBuckets = 1 << RadixBits;
+		constexpr uint64 BucketMask = NumBuckets - 1;
+
+		TArray<uint64> Temp;
+		Temp.SetNumUninitialized(InOutKeys.Num());
+
+		TArray<int32> BucketOffsets;
+		BucketOffsets.SetNumUninitialized(NumBuckets);
+
+		for (int32 Pass = 0; Pass < NumRadixPasses; ++Pass)
+		{
+			const int32 Shift = 32 + Pass * RadixBits;
+
+			FMemory::Memzero(BucketOffsets.GetData(), BucketOffsets.Num() * BucketOffsets.GetTypeSize());
+			for (const uint64 Key : InOutKeys)
+			{
+				++BucketOffsets[(Key >> Shift) & BucketMask];
+			}
+
+			int32 Offset = 0;
+			for (int32& BucketOffset : BucketOffsets)
+			{
+				const int32 Count = BucketOffset;
+				BucketOffset = Offset;
+				Offset += Count;
+			}
+
+			for (const uint64 Key : InOutKeys)
+			{
+				Temp[BucketOffsets[(Key >> Shift) & BucketMask]++] = Key;
+			}
+
+			Swap(InOutKeys, Temp);
+		}
+	}
+}
+
+bool FPCGPointSpatialIndex::IsEnabledForQueries()
+{
+	return CVarFlatSpatialIndex.GetValueOnAnyThread();
+}
+
+FPCGPointSpatialIndex::FCompactBounds FPCGPointSpatialIndex::ToCompactBounds(const FVector& InMin, const FVector& InMax) const
+{
+	auto RoundDown = [](double InValue) -> float
+	{
+		const float Value = static_cast<float>(InValue);
+		return static_cast<double>(Value) > InValue ? std::nextafter(Value, -std::numeric_limits<float>::infinity()) : Value;
+	};
+
+	auto RoundUp = [](double InValue) -> float
+	{
+		const float Value = static_cast<float>(InValue);
+		return static_cast<double>(Value) < InValue ? std::nextafter(Value, std::numeric_limits<float>::infinity()) : Value;
+	};
+
+	const FVector RelativeMin = InMin - Origin;
+	const FVector RelativeMax = InMax - Origin;
+
+	FCompactBounds Result;
+	Result.Min = FVector3f(RoundDown(RelativeMin.X), RoundDown(RelativeMin.Y), RoundDown(RelativeMin.Z));
+	Result.Max = FVector3f(RoundUp(RelativeMax.X), RoundUp(RelativeMax.Y), RoundUp(RelativeMax.Z));
+	return Result;
+}
+
+void FPCGPointSpatialIndex::Reset()
+{
+	Origin = FVector::ZeroVector;
+	SortedPointIndices.Empty();
+	PointBounds.Empty();
+	NodeBounds.Empty();
+	LevelOffsets.Empty();
+}
+
+void FPCGPointSpatialIndex::Build(int32 InNumPoints, const FBox& InDataBounds, TFunctionRef<FBox(int32 PointIndex)> InGetPointBounds)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FPCGPointSpatialIndex::Build);
+
+	using namespace PCGPointSpatialIndex;
+
+	Reset();
+
+	if (InNumPoints <= 0)
+	{
+		return;
+	}
+
+	Origin = InDataBounds.IsValid ? InDataBounds.GetCenter() : FVector::ZeroVector;
+	const FVector DataMin = InDataBounds.IsValid ? InDataBounds.Min : FVector::ZeroVector;
+	const FVector DataSize = InDataBounds.IsValid ? InDataBounds.GetSize() : FVector::OneVector;
+	const FVector InvDataSize(DataSize.X > 0.0 ? 1.0 / DataSize.X : 0.0, DataSize.Y > 0.0 ? 1.0 / DataSize.Y : 0.0, DataSize.Z > 0.0 ? 1.0 / DataSize.Z : 0.0);
+
+	const int32 NumBatches = FMath::DivideAndRoundUp(InNumPoints, BuildBatchSize);
+
+	// 1. Compact bounds and Morton code of each point, in point order.
+	TArray<FCompactBounds> UnsortedBounds;
+	UnsortedBounds.SetNumUninitialized(InNumPoints);
+
+	TArray<uint64> Keys;
+	Keys.SetNumUninitialized(InNumPoints);
+
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(FPCGPointSpatialIndex::Build::ComputeBounds);
+
+		ParallelFor(NumBatches, [&](int32 BatchIndex)
+		{
+			const int32 StartIndex = BatchIndex * BuildBatchSize;
+			const int32 EndIndex = FMath::Min(StartIndex + BuildBatchSize, InNumPoints);
+
+			for (int32 PointIndex = StartIndex; PointIndex < EndIndex; ++PointIndex)
+			{
+				const FBox Box = InGetPointBounds(PointIndex);
+				UnsortedBounds[PointIndex] = ToCompactBounds(Box.Min, Box.Max);
+
+				const uint32 MortonCode = ComputeMortonCode((Box.GetCenter() - DataMin) * InvDataSize);
+				Keys[PointIndex] = (static_cast<uint64>(MortonCode) << 32) | static_cast<uint32>(PointIndex);
+			}
+		});
+	}
+
+	// 2. Sort along the Morton curve, so points close in the index are close in space.
+	SortKeys(Keys);
+
+	SortedPointIndices.SetNumUninitialized(InNumPoints);
+	PointBounds.SetNumUninitialized(InNumPoints);
+
+	ParallelFor(NumBatches, [&](int32 BatchIndex)
+	{
+		const int32 StartIndex = BatchIndex * BuildBatchSize;
+		const int32 EndIndex = FMath::Min(StartIndex + BuildBatchSize, InNumPoints);
+
+		for (int32 Slot = StartIndex; Slot < EndIndex; ++Slot)
+		{
+			const int32 PointIndex = static_cast<int32>(Keys[Slot] & 0xffffffff);
+			SortedPointIndices[Slot] = PointIndex;
+			PointBounds[Slot] = UnsortedBounds[PointIndex];
+		}
+	});
+
+	UnsortedBounds.Empty();
+	Keys.Empty();
+
+	// 3. Nodes, level by level from the leaves up to the root. Nodes of a level only depend on the previous level, so each level is built in parallel.
+	TRACE_CPUPROFILER_EVENT_SCOPE(FPCGPointSpatialIndex::Build::BuildNodes);
+
+	int32 TotalNumNodes = 0;
+	for (int32 NumChildren = InNumPoints; ; )
+	{
+		const int32 NumNodes = FMath::DivideAndRoundUp(NumChildren, BranchingFactor);
+		LevelOffsets.Add(TotalNumNodes);
+		TotalNumNodes += NumNodes;
+		NumChildren = NumNodes;
+
+		if (NumNodes == 1)
+		{
+			break;
+		}
+	}
+
+	LevelOffsets.Add(TotalNumNodes);
+	NodeBounds.SetNumUninitialized(TotalNumNodes);
+
+	for (int32 Level = 0; Level < LevelOffsets.Num() - 1; ++Level)
+	{
+		const FCompactBounds* Children = (Level == 0) ? PointBounds.GetData() : NodeBounds.GetData() + LevelOffsets[Level - 1];
+		const int32 NumChildren = (Level == 0) ? InNumPoints : GetNumNodes(Level - 1);
+		FCompactBounds* Nodes = NodeBounds.GetData() + LevelOffsets[Level];
+
+		ParallelFor(GetNumNodes(Level), [Children, NumChildren, Nodes](int32 NodeIndex)
+		{
+			const int32 FirstChild = NodeIndex * BranchingFactor;
+			const int32 LastChild = FMath::Min(FirstChild + BranchingFactor, NumChildren);
+
+			FCompactBounds Bounds = Children[FirstChild];
+			for (int32 Child = FirstChild + 1; Child < LastChild; ++Child)
+			{
+				Bounds += Children[Child];
+			}
+
+			Nodes[NodeIndex] = Bounds;
+		}, /*bForceSingleThread=*/GetNumNodes(Level) < BuildBatchSize / BranchingFactor);
+	}
+}
+
+SIZE_T FPCGPointSpatialIndex::GetAllocatedSize() const
+{
+	return SortedPointIndices.GetAllocatedSize() + PointBounds.GetAllocatedSize() + NodeBounds.GetAllocatedSize() + LevelOffsets.GetAllocatedSize();
+}
@@ -6,6 +6,7 @@
 #include "PCGSpatialData.h"
 
 #include "Utils/PCGPointOctree.h"
+#include "Utils/PCGPointSpatialIndex.h"
 #include "Utils/PCGValueRange.h"
 
 #include "PCGBasePointData.generated.h"
@@ -142,6 +143,9 @@ public:
 	/** Get the dirty status of the Octree. Note that the Point Octree can be rebuilt from another thread, so this info can be invalidated at anytime. */
 	virtual bool IsPointOctreeDirty() const { return bOctreeIsDirty; }
 	UE_API virtual const PCGPointOctree::FPointOctree& GetPointOctree() const;
+
+	/** Flat alternative to the point octree, built in bulk on first use. Bounds tests are conservative up to float precision, see FPCGPointSpatialIndex. */
+	UE_API const FPCGPointSpatialIndex& GetPointSpatialIndex() const;
 	UE_API virtual FBox GetBounds() const override;
 		
 	UFUNCTION(BlueprintCallable, Category = SpatialData, meta = (DisplayName="Set Points From"))
@@ -220,6 +224,16 @@ protected:
 	}
 
 	UE_API void RebuildOctree() const;
+
+	void RebuildSpatialIndexIfNeeded() const
+	{
+		if (bSpatialIndexIsDirty)
+		{
+			RebuildSpatialIndex();
+		}
+	}
+
+	UE_API void RebuildSpatialIndex() const;
 	
 	void RecomputeBoundsIfNeeded() const
 	{
@@ -234,6 +248,7 @@ protected:
 	virtual void DirtyCache()
 	{
 		bOctreeIsDirty = true;
+		bSpatialIndexIsDirty = true;
 		bBoundsAreDirty = true;
 	}
 
@@ -266,9 +281,11 @@ protected:
 
 	mutable FCriticalSection CachedDataLock;
 	mutable PCGPointOctree::FPointOctree PCGPointOctree;
+	mutable FPCGPointSpatialIndex PointSpatialIndex;
 	mutable FBox Bounds;
 
 	mutable bool bOctreeIsDirty = true;
+	mutable bool bSpatialIndexIsDirty = true;
 	mutable bool bBoundsAreDirty = true;
 };
 
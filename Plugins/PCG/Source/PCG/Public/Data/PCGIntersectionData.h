@@ -47,6 +47,8 @@ public:
 	UE_API virtual FBox GetBounds() const override;
 	UE_API virtual FBox GetStrictBounds() const override;
 	UE_API virtual bool SamplePoint(const FTransform& Transform, const FBox& Bounds, FPCGPoint& OutPoint, UPCGMetadata* OutMetadata) const override;
+	UE_API virtual void SamplePointsRange(const FPCGSampleQueryRanges& InQueries, FPCGPointValueRanges& OutRanges, int32 OutStartIndex, UPCGMetadata* OutMetadata) const override;
+	UE_API virtual void ProjectPointsRange(const FPCGSampleQueryRanges& InQueries, const FPCGProjectionParams& InParams, FPCGPointValueRanges& OutRanges, int32 OutStartIndex, UPCGMetadata* OutMetadata) const override;
 	UE_API virtual bool HasNonTrivialTransform() const override;
 	UE_API virtual const UPCGSpatialData* FindFirstConcreteShapeFromNetwork() const override;
 	UE_API virtual void InitializeTargetMetadata(const FPCGInitializeFromDataParams& InParams, UPCGMetadata* MetadataToInitialize) const override;
@@ -12,8 +12,10 @@ class UPCGSpatialData;
 struct FPCGProjectionParams;
 
 class ALandscapeProxy;
+class ULandscapeHeightfieldCollisionComponent;
 class ULandscapeInfo;
 class UPCGLandscapeCache;
+struct FPCGLandscapeCacheEntry;
 
 USTRUCT(BlueprintType)
 struct FPCGLandscapeDataProps
@@ -52,6 +54,44 @@ struct FPCGLandscapeDataProps
 	bool bSampleVirtualTextureNormals = false;
 };
 
+/** Describes a regular XY lattice to sample with UPCGLandscapeData::SampleGrid. Samples are row-major (X changes fastest). */
+struct FPCGLandscapeGridSamplingParams
+{
+	/** World-space position of the (0, 0) grid vertex. */
+	FVector2D GridMin = FVector2D::ZeroVector;
+
+	/** World distance between grid vertices. */
+	double CellSize = 100.0;
+
+	int32 GridX = 0;
+	int32 GridY = 0;
+
+	/** Interpolate landscape normals in addition to heights. */
+	bool bSampleNormals = true;
+
+	/** Optional landscape layer to interpolate. Ignored when None or when the landscape data does not retrieve layer weights. */
+	FName LayerName = NAME_None;
+};
+
+/** Structure-of-arrays result of UPCGLandscapeData::SampleGrid, one element per grid vertex. */
+struct FPCGLandscapeGridSamples
+{
+	/** World-space height of the projected vertex. */
+	TArray<double> Heights;
+
+	/** World-space surface normal, only filled when normals were requested. */
+	TArray<FVector> Normals;
+
+	/** Interpolated weight of the requested layer, only filled when bHasLayer is true. */
+	TArray<float> LayerWeights;
+
+	/** True where the vertex landed on a loaded landscape component (equivalent to a successful ProjectPoint). */
+	TArray<bool> Hits;
+
+	/** True if the requested layer exists on the landscape and its weights were sampled. */
+	bool bHasLayer = false;
+};
+
 /**
 * Landscape data access abstraction for PCG. Supports multi-landscape access, but it assumes that they are not overlapping.
 */
@@ -77,10 +117,28 @@ public:
 	UE_API virtual FBox GetStrictBounds() const override;
 	UE_API virtual bool SamplePoint(const FTransform& Transform, const FBox& Bounds, FPCGPoint& OutPoint, UPCGMetadata* OutMetadata) const override;
 	UE_API virtual void SamplePoints(const TArrayView<const TPair<FTransform, FBox>>& Samples, const TArrayView<FPCGPoint>& OutPoints, UPCGMetadata* OutMetadata) const override;
+	UE_API virtual void SamplePointsRange(const FPCGSampleQueryRanges& InQueries, FPCGPointValueRanges& OutRanges, int32 OutStartIndex, UPCGMetadata* OutMetadata) const override;
 	UE_API virtual bool ProjectPoint(const FTransform& InTransform, const FBox& InBounds, const FPCGProjectionParams& InParams, FPCGPoint& OutPoint, UPCGMetadata* OutMetadata) const override;
+	UE_API virtual void ProjectPointsRange(const FPCGSampleQueryRanges& InQueries, const FPCGProjectionParams& InParams, FPCGPointValueRanges& OutRanges, int32 OutStartIndex, UPCGMetadata* OutMetadata) const override;
 	virtual bool HasNonTrivialTransform() const override { return true; }
 	UE_API virtual TArray<FPCGTaskId> PrepareForSpatialQuery(FPCGContext* InContext, const FBox& InBounds) const override;
 	UE_API virtual void InitializeTargetMetadata(const FPCGInitializeFromDataParams& InParams, UPCGMetadata* MetadataToInitialize) const override;
+
+	/**
+	* Batched projection of a regular XY grid on the landscape. Vertices are grouped by landscape component and each group reads heights, normals
+	* and the optional layer straight from the landscape cache, in parallel. Produces the same heights and normals as calling ProjectPoint on each
+	* vertex, without building points or writing metadata. Must be called from a thread allowed to create landscape cache entries.
+	*/
+	UE_API bool SampleGrid(const FPCGLandscapeGridSamplingParams& InParams, FPCGLandscapeGridSamples& OutSamples) const;
+
+	/** Returns true if this data retrieves layer weights and the given layer is known to the landscape cache. */
+	UE_API bool HasLayerWeight(FName InLayerName) const;
+
+	/**
+	* Reads a single layer weight at a world position, without going through metadata. Layers that are not painted on the component read as zero.
+	* Returns false if the position is not on a landscape component. Must be called from a thread allowed to create landscape cache entries.
+	*/
+	UE_API bool SampleLayerWeight(const FVector& InPosition, FName InLayerName, float& OutWeight) const;
 protected:
 	UE_API virtual UPCGSpatialData* CopyInternal(FPCGContext* Context) const override;
 	//~End UPCGSpatialData interface
@@ -107,6 +165,12 @@ protected:
 	*/
 	UE_API const ULandscapeInfo* GetLandscapeInfo(const FVector& InPosition) const;
 
+	/** Shared implementation of ProjectPoint and ProjectPointsRange, once the landscape component under the query is resolved. */
+	UE_API void ProjectPointOnComponent(const FTransform& InTransform, const FPCGProjectionParams& InParams, const FPCGLandscapeCacheEntry* LandscapeCacheEntry, ULandscapeHeightfieldCollisionComponent* LandscapeCollisionComponent, const FIntPoint& ComponentMapKey, const FVector2D& ComponentLocalPoint, FPCGPoint& OutPoint, UPCGMetadata* OutMetadata) const;
+
+	/** Shared implementation of SamplePoints and SamplePointsRange: sets OutKeptSamples[i] for each sample overlapping a landscape collision component. */
+	UE_API void FindOverlappingSamples(int32 InNumSamples, TFunctionRef<FTransform(int32)> InGetTransform, TFunctionRef<FBox(int32)> InGetBounds, TBitArray<>& OutKeptSamples) const;
+
 	UE_API const UPCGBasePointData* CreateBasePointData(FPCGContext* Context, const FBox& InBounds, TSubclassOf<UPCGBasePointData> PointDataClass) const;
 
 	UPROPERTY()
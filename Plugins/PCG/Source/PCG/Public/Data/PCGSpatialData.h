@@ -8,6 +8,7 @@
 #include "Metadata/PCGAttributePropertySelector.h"
 #include "Metadata/PCGMetadata.h"
 #include "Metadata/PCGMetadataCommon.h"
+#include "Utils/PCGValueRange.h"
 
 #include "PCGSpatialData.generated.h"
 
@@ -23,6 +24,7 @@ class UPCGIntersectionData;
 class UPCGUnionData;
 class UPCGDifferenceData;
 class UPCGProjectionData;
+struct FPCGPointValueRanges;
 
 namespace PCGSpatialData
 {
@@ -61,6 +63,25 @@ struct FPCGInitializeFromDataParams
 	FPCGMetadataInitializeParams MetadataInitializeParams;
 };
 
+/**
+* Batch of queries for SamplePointsRange / ProjectPointsRange: the transforms and local bounds of Num points,
+* read from value ranges at [StartIndex, StartIndex + Num). Usually the ranges of a source point data, read in place.
+*/
+struct FPCGSampleQueryRanges
+{
+	FPCGSampleQueryRanges() = default;
+	UE_API FPCGSampleQueryRanges(const UPCGBasePointData* InPointData, int32 InStartIndex, int32 InNum);
+
+	const FTransform& GetTransform(int32 Index) const { return TransformRange[StartIndex + Index]; }
+	FBox GetLocalBounds(int32 Index) const { return FBox(BoundsMinRange[StartIndex + Index], BoundsMaxRange[StartIndex + Index]); }
+
+	TConstPCGValueRange<FTransform> TransformRange;
+	TConstPCGValueRange<FVector> BoundsMinRange;
+	TConstPCGValueRange<FVector> BoundsMaxRange;
+	int32 StartIndex = 0;
+	int32 Num = 0;
+};
+
 /**
 * "Concrete" data base class for PCG generation
 * This will be the base class for data classes that actually represent
@@ -146,6 +167,13 @@ public:
 	*/
 	UE_API virtual void SamplePoints(const TArrayView<const TPair<FTransform, FBox>>& Samples, const TArrayView<FPCGPoint>& OutPoints, UPCGMetadata* OutMetadata) const;
 
+	/** Performs multiple samples at the same time, without going through FPCGPoint arrays.
+	* Reads the queries from value ranges and writes the sampled points straight into OutRanges at [OutStartIndex, OutStartIndex + InQueries.Num).
+	* Same contract as SamplePoints: the density is set to 0 for queries that were not overlapping. Properties that have no range in OutRanges are not written.
+	* Composite data sample their operands with this method and treat a sample as overlapping when its density is > 0.
+	*/
+	UE_API virtual void SamplePointsRange(const FPCGSampleQueryRanges& InQueries, FPCGPointValueRanges& OutRanges, int32 OutStartIndex, UPCGMetadata* OutMetadata) const;
+
 	/** Sample rotation, scale and other attributes from this data at the query position. Returns true if Transform location and Bounds overlaps this data. */
 	UFUNCTION(BlueprintCallable, Category = SpatialData, meta = (DisplayName = "Sample Point"))
 	UE_API bool K2_SamplePoint(const FTransform& Transform, const FBox& Bounds, FPCGPoint& OutPoint, UPCGMetadata* OutMetadata) const;
@@ -159,6 +187,9 @@ public:
 	*/
 	UE_API virtual void ProjectPoints(const TArrayView<const TPair<FTransform, FBox>>& Samples, const FPCGProjectionParams& InParams, const TArrayView<FPCGPoint>& OutPoints, UPCGMetadata* OutMetadata) const;
 
+	/** Range based version of ProjectPoints, see SamplePointsRange. Data relying on the ProjectPoint fallback implement it with ProjectPointsRangeFromSamples. */
+	UE_API virtual void ProjectPointsRange(const FPCGSampleQueryRanges& InQueries, const FPCGProjectionParams& InParams, FPCGPointValueRanges& OutRanges, int32 OutStartIndex, UPCGMetadata* OutMetadata) const;
+
 	UFUNCTION(BlueprintCallable, Category = SpatialData, meta = (DisplayName = "Project Point"))
 	UE_API bool K2_ProjectPoint(const FTransform& InTransform, const FBox& InBounds, const FPCGProjectionParams& InParams, FPCGPoint& OutPoint, UPCGMetadata* OutMetadata) const;
 
@@ -249,6 +280,12 @@ protected:
 	UE_API void InitializeMetadata(const FPCGInitializeFromDataParams& InParams);
 	UE_API virtual void InitializeMetadataInternal(const FPCGInitializeFromDataParams& InParams);
 
+	/**
+	* ProjectPointsRange implementation for data that rely on the ProjectPoint fallback: samples the queries with SamplePointsRange,
+	* then resets the transform components that are not projected to the query ones. Gives the same points as calling ProjectPoint on each query.
+	*/
+	UE_API void ProjectPointsRangeFromSamples(const FPCGSampleQueryRanges& InQueries, const FPCGProjectionParams& InParams, FPCGPointValueRanges& OutRanges, int32 OutStartIndex, UPCGMetadata* OutMetadata) const;
+
 private:
 	/** Cache to keep track of the latest attribute manipulated on this data. */
 	UPROPERTY()
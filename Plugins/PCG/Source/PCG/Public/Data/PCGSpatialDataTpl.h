@@ -12,6 +12,236 @@ namespace FPCGSpatialDataProcessing
 {
 	constexpr int32 DefaultSamplePointsChunkSize = 256;
 
+	/** Writes a sampled point for SamplePointsRange implementations: the query transform and bounds with InDensity, other properties at their FPCGPoint defaults. */
+	inline void WriteSampledPoint(FPCGPointValueRanges& OutRanges, int32 Index, const FTransform& InTransform, const FBox& InBounds, float InDensity, const FVector4& InColor = FVector4::One())
+	{
+		static const FPCGPoint DefaultPoint;
+
+		if (!OutRanges.TransformRange.IsEmpty())
+		{
+			OutRanges.TransformRange[Index] = InTransform;
+		}
+
+		if (!OutRanges.DensityRange.IsEmpty())
+		{
+			OutRanges.DensityRange[Index] = InDensity;
+		}
+
+		if (!OutRanges.SteepnessRange.IsEmpty())
+		{
+			OutRanges.SteepnessRange[Index] = DefaultPoint.Steepness;
+		}
+
+		if (!OutRanges.BoundsMinRange.IsEmpty())
+		{
+			OutRanges.BoundsMinRange[Index] = InBounds.Min;
+		}
+
+		if (!OutRanges.BoundsMaxRange.IsEmpty())
+		{
+			OutRanges.BoundsMaxRange[Index] = InBounds.Max;
+		}
+
+		if (!OutRanges.ColorRange.IsEmpty())
+		{
+			OutRanges.ColorRange[Index] = InColor;
+		}
+
+		if (!OutRanges.SeedRange.IsEmpty())
+		{
+			OutRanges.SeedRange[Index] = DefaultPoint.Seed;
+		}
+
+		if (!OutRanges.MetadataEntryRange.IsEmpty())
+		{
+			OutRanges.MetadataEntryRange[Index] = DefaultPoint.MetadataEntry;
+		}
+	}
+
+	/** Marks a query that was not overlapping, see SamplePointsRange. */
+	inline void WriteRejectedSample(FPCGPointValueRanges& OutRanges, int32 Index)
+	{
+		if (!OutRanges.DensityRange.IsEmpty())
+		{
+			OutRanges.DensityRange[Index] = 0.0f;
+		}
+	}
+
+	/** Range version of the UPCGSpatialData::ProjectPoint fallback on sampled points: the transform components that are not projected are reset to the query ones. */
+	inline void ApplyProjectionParams(const FPCGSampleQueryRanges& InQueries, const FPCGProjectionParams& InParams, FPCGPointValueRanges& OutRanges, int32 OutStartIndex)
+	{
+		if (OutRanges.TransformRange.IsEmpty() || (InParams.bProjectPositions && InParams.bProjectRotations && InParams.bProjectScales))
+		{
+			return;
+		}
+
+		for (int32 Index = 0; Index < InQueries.Num; ++Index)
+		{
+			const FTransform& QueryTransform = InQueries.GetTransform(Index);
+			FTransform& OutTransform = OutRanges.TransformRange[OutStartIndex + Index];
+
+			if (!InParams.bProjectPositions)
+			{
+				OutTransform.SetLocation(QueryTransform.GetLocation());
+			}
+
+			if (!InParams.bProjectRotations)
+			{
+				OutTransform.SetRotation(QueryTransform.GetRotation());
+			}
+
+			if (!InParams.bProjectScales)
+			{
+				OutTransform.SetScale3D(QueryTransform.GetScale3D());
+			}
+		}
+	}
+
+	/**
+	* Chunk-local structure of arrays holding sampled points, used by composite data to sample their operands with SamplePointsRange
+	* without allocating a point data. Only the given properties are stored, the others have empty ranges and are not written.
+	*/
+	struct FSampledPointsBuffer
+	{
+		explicit FSampledPointsBuffer(int32 InNum, EPCGPointNativeProperties InProperties = EPCGPointNativeProperties::All)
+			: Num(InNum)
+		{
+			auto Allocate = [InNum, InProperties](auto& Array, EPCGPointNativeProperties Property)
+			{
+				if (EnumHasAnyFlags(InProperties, Property))
+				{
+					Array.SetNumUninitialized(InNum);
+				}
+			};
+
+			Allocate(Transforms, EPCGPointNativeProperties::Transform);
+			Allocate(Densities, EPCGPointNativeProperties::Density);
+			Allocate(Steepnesses, EPCGPointNativeProperties::Steepness);
+			Allocate(BoundsMins, EPCGPointNativeProperties::BoundsMin);
+			Allocate(BoundsMaxs, EPCGPointNativeProperties::BoundsMax);
+			Allocate(Colors, EPCGPointNativeProperties::Color);
+			Allocate(Seeds, EPCGPointNativeProperties::Seed);
+			Allocate(MetadataEntries, EPCGPointNativeProperties::MetadataEntry);
+		}
+
+		/** Ranges to pass to SamplePointsRange, with OutStartIndex 0. */
+		FPCGPointValueRanges GetValueRanges()
+		{
+			FPCGPointValueRanges Ranges;
+			Ranges.TransformRange = PCGValueRangeHelpers::MakeValueRange(TArrayView<FTransform>(Transforms));
+			Ranges.DensityRange = PCGValueRangeHelpers::MakeValueRange(TArrayView<float>(Densities));
+			Ranges.SteepnessRange = PCGValueRangeHelpers::MakeValueRange(TArrayView<float>(Steepnesses));
+			Ranges.BoundsMinRange = PCGValueRangeHelpers::MakeValueRange(TArrayView<FVector>(BoundsMins));
+			Ranges.BoundsMaxRange = PCGValueRangeHelpers::MakeValueRange(TArrayView<FVector>(BoundsMaxs));
+			Ranges.ColorRange = PCGValueRangeHelpers::MakeValueRange(TArrayView<FVector4>(Colors));
+			Ranges.SeedRange = PCGValueRangeHelpers::MakeValueRange(TArrayView<int32>(Seeds));
+			Ranges.MetadataEntryRange = PCGValueRangeHelpers::MakeValueRange(TArrayView<int64>(MetadataEntries));
+			return Ranges;
+		}
+
+		/** The sampled transforms and bounds as queries for another data. Requires Transform, BoundsMin and BoundsMax. */
+		FPCGSampleQueryRanges GetQueries() const
+		{
+			check(Transforms.Num() == Num && BoundsMins.Num() == Num && BoundsMaxs.Num() == Num);
+
+			FPCGSampleQueryRanges Queries;
+			Queries.TransformRange = PCGValueRangeHelpers::MakeConstValueRange(Transforms);
+			Queries.BoundsMinRange = PCGValueRangeHelpers::MakeConstValueRange(BoundsMins);
+			Queries.BoundsMaxRange = PCGValueRangeHelpers::MakeConstValueRange(BoundsMaxs);
+			Queries.Num = Num;
+			return Queries;
+		}
+
+		FBox GetLocalBounds(int32 Index) const { return FBox(BoundsMins[Index], BoundsMaxs[Index]); }
+
+		/** Appends a query to a buffer created with no properties, to build compacted queries with GetQueries. */
+		void AddQuery(const FTransform& InTransform, const FVector& InBoundsMin, const FVector& InBoundsMax)
+		{
+			Transforms.Add(InTransform);
+			BoundsMins.Add(InBoundsMin);
+			BoundsMaxs.Add(InBoundsMax);
+			++Num;
+		}
+
+		/** Appends query InIndex of InQueries with another transform, see AddQuery. */
+		void AddQuery(const FTransform& InTransform, const FPCGSampleQueryRanges& InQueries, int32 InIndex)
+		{
+			AddQuery(InTransform, InQueries.BoundsMinRange[InQueries.StartIndex + InIndex], InQueries.BoundsMaxRange[InQueries.StartIndex + InIndex]);
+		}
+
+		void ResetQueries()
+		{
+			Transforms.Reset();
+			BoundsMins.Reset();
+			BoundsMaxs.Reset();
+			Num = 0;
+		}
+
+		/** Copies the stored properties of entry InIndex to OutRanges at OutIndex. Properties missing on either side are skipped. */
+		void WriteTo(int32 InIndex, FPCGPointValueRanges& OutRanges, int32 OutIndex) const
+		{
+			auto Write = [InIndex, OutIndex](const auto& Array, auto& Range)
+			{
+				if (!Array.IsEmpty() && !Range.IsEmpty())
+				{
+					Range[OutIndex] = Array[InIndex];
+				}
+			};
+
+			Write(Transforms, OutRanges.TransformRange);
+			Write(Densities, OutRanges.DensityRange);
+			Write(Steepnesses, OutRanges.SteepnessRange);
+			Write(BoundsMins, OutRanges.BoundsMinRange);
+			Write(BoundsMaxs, OutRanges.BoundsMaxRange);
+			Write(Colors, OutRanges.ColorRange);
+			Write(Seeds, OutRanges.SeedRange);
+			Write(MetadataEntries, OutRanges.MetadataEntryRange);
+		}
+
+		/** Entry InIndex as a point, for logic written against FPCGPoint. Requires all properties. */
+		FPCGPoint GetPoint(int32 InIndex) const
+		{
+			FPCGPoint Point(Transforms[InIndex], Densities[InIndex], Seeds[InIndex]);
+			Point.Steepness = Steepnesses[InIndex];
+			Point.BoundsMin = BoundsMins[InIndex];
+			Point.BoundsMax = BoundsMaxs[InIndex];
+			Point.Color = Colors[InIndex];
+			Point.MetadataEntry = MetadataEntries[InIndex];
+			return Point;
+		}
+
+		/** Copies entry InIndex of another buffer to entry OutIndex. Properties missing on either side are skipped. */
+		void CopyEntry(const FSampledPointsBuffer& InOther, int32 InIndex, int32 OutIndex)
+		{
+			auto Copy = [InIndex, OutIndex](const auto& InArray, auto& OutArray)
+			{
+				if (!InArray.IsEmpty() && !OutArray.IsEmpty())
+				{
+					OutArray[OutIndex] = InArray[InIndex];
+				}
+			};
+
+			Copy(InOther.Transforms, Transforms);
+			Copy(InOther.Densities, Densities);
+			Copy(InOther.Steepnesses, Steepnesses);
+			Copy(InOther.BoundsMins, BoundsMins);
+			Copy(InOther.BoundsMaxs, BoundsMaxs);
+			Copy(InOther.Colors, Colors);
+			Copy(InOther.Seeds, Seeds);
+			Copy(InOther.MetadataEntries, MetadataEntries);
+		}
+
+		int32 Num = 0;
+		TArray<FTransform> Transforms;
+		TArray<float> Densities;
+		TArray<float> Steepnesses;
+		TArray<FVector> BoundsMins;
+		TArray<FVector> BoundsMaxs;
+		TArray<FVector4> Colors;
+		TArray<int32> Seeds;
+		TArray<int64> MetadataEntries;
+	};
+
 	template<int ChunkSize, typename ProcessRangeFunc>
 	void SampleBasedRangeProcessing(FPCGAsyncState* AsyncState, ProcessRangeFunc&& InProcessRange, const TArray<FPCGPoint>& SourcePoints, TArray<FPCGPoint>& OutPoints)
 	{
@@ -81,25 +311,12 @@ namespace FPCGSpatialDataProcessing
 		{
 			ensure(Count >= 0 && Count <= ChunkSize);
 
-			TArray<TPair<FTransform, FBox>, TInlineAllocator<ChunkSize>> Samples;
-			
-			{
-				TRACE_CPUPROFILER_EVENT_SCOPE(FPCGSpatialDataProcessing::SamplePoints::PrepareSamples)
-				const TConstPCGValueRange<FTransform> SourceTransformRange = SourceData->GetConstTransformValueRange();
-				const TConstPCGValueRange<FVector> SourceBoundsMinRange = SourceData->GetConstBoundsMinValueRange();
-				const TConstPCGValueRange<FVector> SourceBoundsMaxRange = SourceData->GetConstBoundsMaxValueRange();
-
-				Samples.Reserve(Count);
-				for (int32 Index = 0; Index < Count; ++Index)
-				{
-					const int32 ReadIndex = StartReadIndex + Index;
-					Samples.Add(TPair<FTransform, FBox>(SourceTransformRange[ReadIndex], PCGPointHelpers::GetLocalBounds(SourceBoundsMinRange[ReadIndex], SourceBoundsMaxRange[ReadIndex])));
-				}
-			}
+			// The queries read the source transforms and bounds in place, for SamplePointsRange.
+			const FPCGSampleQueryRanges Queries(SourceData, StartReadIndex, Count);
 
 			{
 				TRACE_CPUPROFILER_EVENT_SCOPE(FPCGSpatialDataProcessing::SamplePoints::RangeFunc)
-				return RangeFunc(Samples, SourceData, StartReadIndex, TargetData, StartWriteIndex);
+				return RangeFunc(Queries, SourceData, StartReadIndex, TargetData, StartWriteIndex);
 			}
 		};
 
@@ -100,6 +100,8 @@ public:
 	//~Begin UPCGSpatialData interface
 	UE_API virtual FBox GetBounds() const override;
 	UE_API virtual bool SamplePoint(const FTransform& Transform, const FBox& Bounds, FPCGPoint& OutPoint, UPCGMetadata* OutMetadata) const override;
+	UE_API virtual void SamplePointsRange(const FPCGSampleQueryRanges& InQueries, FPCGPointValueRanges& OutRanges, int32 OutStartIndex, UPCGMetadata* OutMetadata) const override;
+	UE_API virtual void ProjectPointsRange(const FPCGSampleQueryRanges& InQueries, const FPCGProjectionParams& InParams, FPCGPointValueRanges& OutRanges, int32 OutStartIndex, UPCGMetadata* OutMetadata) const override;
 	UE_API virtual UPCGSpatialData* ProjectOn(FPCGContext* InContext, const UPCGSpatialData* InOther, const FPCGProjectionParams& InParams = FPCGProjectionParams()) const override;
 protected:
 	UE_API virtual UPCGSpatialData* CopyInternal(FPCGContext* Context) const override;
@@ -144,6 +146,8 @@ public:
 
 	//~Begin UPCGSpatialData interface
 	virtual bool SamplePoint(const FTransform& Transform, const FBox& Bounds, FPCGPoint& OutPoint, UPCGMetadata* OutMetadata) const override;
+	/** Samples through SamplePoint, the projection implementation does not apply to the projected spline. */
+	virtual void SamplePointsRange(const FPCGSampleQueryRanges& InQueries, FPCGPointValueRanges& OutRanges, int32 OutStartIndex, UPCGMetadata* OutMetadata) const override { UPCGSpatialData::SamplePointsRange(InQueries, OutRanges, OutStartIndex, OutMetadata); }
 	//~End UPCGSpatialData interface
 
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = SpatialData)
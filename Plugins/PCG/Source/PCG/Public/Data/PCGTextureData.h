@@ -6,6 +6,9 @@
 
 #include "RendererInterface.h"
 #include "RHI.h"
+#include "Math/Float16Color.h"
+
+#include <atomic>
 
 #include "PCGTextureData.generated.h"
 
@@ -39,6 +42,15 @@ enum class EPCGTextureFilter : uint8
 	Bilinear UMETA(Tooltip="Bilinearly interpolates the values of the four nearest texels to the sample location.")
 };
 
+/** How samples covering many texels use the CPU mip chain of the texture data. */
+UENUM(BlueprintType)
+enum class EPCGTextureMipFilter : uint8
+{
+	None UMETA(Tooltip="Always samples the full resolution texels, whatever the sample footprint."),
+	Box UMETA(Tooltip="Samples the mip level whose texels best match the sample footprint. Levels are 2x2 box averages of the level above."),
+	Trilinear UMETA(Tooltip="Blends the two mip levels around the sample footprint.")
+};
+
 UENUM()
 enum class EPCGTextureAddressMode : uint8
 {
@@ -54,8 +66,32 @@ enum class EPCGTextureResourceType : uint8
 	Invalid UMETA(Hidden)
 };
 
+/** Layout of the texels kept in CPU memory. Texels are decoded to FLinearColor when sampled. */
+UENUM()
+enum class EPCGTextureCPUStorage : uint8
+{
+	RGBA32F UMETA(ToolTip = "FLinearColor per texel (16 bytes)."),
+	BGRA8 UMETA(ToolTip = "FColor per texel, decoded as normalized RGBA (4 bytes)."),
+	RGBA16 UMETA(ToolTip = "Four unnormalized uint16 per texel (8 bytes)."),
+	RGBA16F UMETA(ToolTip = "FFloat16Color per texel (8 bytes)."),
+	R8 UMETA(ToolTip = "One normalized channel, decoded as (V, V, V, 1) (1 byte)."),
+	R16F UMETA(ToolTip = "One FFloat16 channel, decoded as (V, V, V, 1) (2 bytes)."),
+	R32F UMETA(ToolTip = "One float channel, decoded as (V, V, V, 1) (4 bytes).")
+};
+
+/** One level of the CPU mip chain of a texture data, level 1 and below. Texels are in the CPU storage layout of the texture data. */
+struct FPCGTextureCPUMip
+{
+	int32 Width = 0;
+	int32 Height = 0;
+	TArray<uint8> TexelData;
+};
+
 namespace PCGTextureSamplingHelpers
 {
+	/** Decoded texel at Index in texels laid out as InStorage. */
+	inline FLinearColor DecodeTexel(EPCGTextureCPUStorage InStorage, const uint8* InTexelData, int32 Index);
+
 	/** Returns true if a texture is CPU-accessible. */
 	TOptional<bool> IsTextureCPUAccessible(UTexture2D* Texture);
 
@@ -77,10 +113,16 @@ public:
 	virtual EPCGDataType GetDataType() const override { return EPCGDataType::BaseTexture; }
 	// ~End UPCGData interface
 
+	// ~Begin UObject interface
+	UE_API virtual void GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize) override;
+	// ~End UObject interface
+
 	//~Begin UPCGSpatialData interface
 	UE_API virtual FBox GetBounds() const override;
 	UE_API virtual FBox GetStrictBounds() const override;
 	UE_API virtual bool SamplePoint(const FTransform& Transform, const FBox& Bounds, FPCGPoint& OutPoint, UPCGMetadata* OutMetadata) const override;
+	UE_API virtual void SamplePointsRange(const FPCGSampleQueryRanges& InQueries, FPCGPointValueRanges& OutRanges, int32 OutStartIndex, UPCGMetadata* OutMetadata) const override;
+	UE_API virtual void ProjectPointsRange(const FPCGSampleQueryRanges& InQueries, const FPCGProjectionParams& InParams, FPCGPointValueRanges& OutRanges, int32 OutStartIndex, UPCGMetadata* OutMetadata) const override;
 	//~End UPCGSpatialData interface
 
 	//~Begin UPCGSpatialDataWithPointCache interface
@@ -88,8 +130,32 @@ public:
 	UE_API virtual const UPCGPointArrayData* CreatePointArrayData(FPCGContext* Context, const FBox& InBounds) const override;
 	//~End UPCGSpatialDataWithPointCache interface
 
-	/** Sample using a local space 'UV' position. */
-	UE_API bool SamplePointLocal(const FVector2D& LocalPosition, FVector4& OutColor, float& OutDensity) const;
+	/**
+	* Sample using a local space 'UV' position. InMipLevel is only used when MipFilter is not None, see ComputeMipLevel.
+	*/
+	UE_API bool SamplePointLocal(const FVector2D& LocalPosition, FVector4& OutColor, float& OutDensity, float InMipLevel = 0.0f) const;
+
+	/**
+	* Batched SamplePointLocal returning a single channel. OutValues[i] is the channel of the texture sampled at the local space 'UV' position InLocalPositions[i],
+	* or InDefaultValue where SamplePointLocal would fail (zero density). Can be called from multiple threads.
+	* Returns false, with all values set to InDefaultValue, if the texture cannot be sampled on the CPU.
+	*/
+	UE_API bool SampleChannelLocal(TConstArrayView<FVector2D> InLocalPositions, EPCGTextureColorChannel InChannel, TArrayView<float> OutValues, float InDefaultValue = 0.0f, float InMipLevel = 0.0f) const;
+
+	/**
+	* Mip level matching samples that cover InLocalFootprint of the texture, in local 'UV' units (1 is the whole texture).
+	* 0 is the full resolution, each level halves the resolution.
+	*/
+	UE_API float ComputeMipLevel(const FVector2D& InLocalFootprint) const;
+
+	/**
+	* Builds the CPU mip chain down to 1x1 from the full resolution texels, if not built yet. Sampling builds it on demand
+	* when MipFilter is not None, calling this up front keeps that cost out of the sampling. Can be called from multiple threads.
+	*/
+	UE_API void BuildCPUMipChain() const;
+
+	/** Number of levels of the CPU mip chain, including the full resolution. 1 until the chain is built. */
+	int32 GetNumCPUMipLevels() const { return bCPUMipChainBuilt ? CPUMips.Num() + 1 : 1; }
 
 	UE_API virtual bool IsValid() const;
 
@@ -100,7 +166,52 @@ public:
 	virtual int GetTextureSlice() const { return 0; }
 	virtual FIntPoint GetTextureSize() const { return FIntPoint(Width, Height); }
 
+	/** Layout of the texels in CPU memory. */
+	EPCGTextureCPUStorage GetCPUStorage() const { return CPUStorage; }
+
+	/** Memory used by the texels in CPU memory, in bytes. */
+	UE_API SIZE_T GetCPUTexelsSizeBytes() const;
+
+	/** Decoded texel at Index (X + Y * Width). */
+	FLinearColor GetTexel(int32 Index) const { return PCGTextureSamplingHelpers::DecodeTexel(CPUStorage, GetCPUTexelData(), Index); }
+
 protected:
+	/** Returns false if the data has no CPU texels to sample, logging the error once when the readback was skipped. */
+	UE_API bool CanSampleCPUTexels() const;
+
+	/** Per sample part of SamplePoint: the sampled transform, color and density. Returns false if the sample is outside the texture or rejected. */
+	UE_API bool SampleTransformAndColor(const FTransform& InTransform, const FBox& InBounds, FTransform& OutTransform, FLinearColor& OutColor, float& OutDensity) const;
+
+	/** Filtered color at a wrapped or clamped texture position in [0, 1], from the mip levels selected by MipFilter. */
+	UE_API FLinearColor SampleTexturePosition(const FVector2D& InTexturePosition, float InMipLevel) const;
+
+	/** Allocates the texel storage (uninitialized) for Width * Height texels in the given layout, and releases any other storage. */
+	UE_API void AllocateCPUTexels(EPCGTextureCPUStorage InStorage);
+
+	/** Typed access to the texel storage while writing it. T must match the layout given to AllocateCPUTexels. */
+	template <typename T>
+	T* GetMutableCPUTexels()
+	{
+		return (CPUStorage == EPCGTextureCPUStorage::RGBA32F) ? reinterpret_cast<T*>(ColorData.GetData()) : reinterpret_cast<T*>(CompactTexelData.GetData());
+	}
+
+	/** True if the texels are in CPU memory. */
+	bool HasCPUTexels() const { return !ColorData.IsEmpty() || !CompactTexelData.IsEmpty(); }
+
+	/** Raw texel storage, in the CPUStorage layout. */
+	const uint8* GetCPUTexelData() const
+	{
+		return (CPUStorage == EPCGTextureCPUStorage::RGBA32F) ? reinterpret_cast<const uint8*>(ColorData.GetData()) : CompactTexelData.GetData();
+	}
+
+	UE_API void ResetCPUTexels();
+
+	/**
+	 * Applies the storage console variables to texels just written in their native layout: widens them back to
+	 * RGBA32F when compact storage is disabled, or narrows 32-bit float texels to 16-bit floats when requested.
+	 */
+	UE_API void FinalizeCPUTexels();
+
 	UE_API const UPCGBasePointData* CreateBasePointData(FPCGContext* Context, TSubclassOf<UPCGBasePointData> PointDataClass) const;
 
 	PRAGMA_DISABLE_DEPRECATION_WARNINGS
@@ -130,6 +241,10 @@ public:
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = Settings, meta = (PCG_Overridable))
 	EPCGTextureFilter Filter = EPCGTextureFilter::Bilinear;
 
+	/** Use of the CPU mip chain for samples larger than a texel (points with bounds, ToPointData with a large texel size). Reduces aliasing of coarse sampling. */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = Settings, meta = (PCG_Overridable))
+	EPCGTextureMipFilter MipFilter = EPCGTextureMipFilter::None;
+
 	/** The size of one texel in cm, used when calling ToPointData. */
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = Settings, meta = (UIMin = "1.0", ClampMin = "1.0"))
 	float TexelSize = 50.0f;
@@ -155,9 +270,22 @@ public:
 	FBox2D TileBounds = FBox2D(FVector2D(-0.5, -0.5), FVector2D(0.5, 0.5));
 
 protected:
+	/** Texels when stored as RGBA32F. */
 	UPROPERTY()
 	TArray<FLinearColor> ColorData;
 
+	/** Texels for the other layouts, see CPUStorage. */
+	UPROPERTY()
+	TArray<uint8> CompactTexelData;
+
+	UPROPERTY()
+	EPCGTextureCPUStorage CPUStorage = EPCGTextureCPUStorage::RGBA32F;
+
+	/** Mip levels 1 and below in the CPUStorage layout, built by BuildCPUMipChain. Transient, always rebuilt from the texels. */
+	mutable TArray<FPCGTextureCPUMip> CPUMips;
+	mutable std::atomic<bool> bCPUMipChainBuilt = false;
+	mutable FCriticalSection CPUMipChainLock;
+
 	UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Category = SpatialData)
 	FBox Bounds = FBox(EForceInit::ForceInit);
 
@@ -176,6 +304,41 @@ protected:
 	UE_API void CopyBaseTextureData(UPCGBaseTextureData* NewTextureData) const;
 };
 
+inline FLinearColor PCGTextureSamplingHelpers::DecodeTexel(EPCGTextureCPUStorage InStorage, const uint8* InTexelData, int32 Index)
+{
+	switch (InStorage)
+	{
+	case EPCGTextureCPUStorage::BGRA8:
+		// Memory representation of FColor is BGRA, so we reinterpret as FLinearColor to get RGBA.
+		return reinterpret_cast<const FColor*>(InTexelData)[Index].ReinterpretAsLinear();
+	case EPCGTextureCPUStorage::RGBA16:
+	{
+		const uint16* Texel = reinterpret_cast<const uint16*>(InTexelData) + 4 * Index;
+		return FLinearColor(Texel[0], Texel[1], Texel[2], Texel[3]);
+	}
+	case EPCGTextureCPUStorage::RGBA16F:
+		return FLinearColor(reinterpret_cast<const FFloat16Color*>(InTexelData)[Index]);
+	case EPCGTextureCPUStorage::R8:
+	{
+		const uint8 Value = InTexelData[Index];
+		return FColor(Value, Value, Value).ReinterpretAsLinear();
+	}
+	case EPCGTextureCPUStorage::R16F:
+	{
+		const float Value = reinterpret_cast<const FFloat16*>(InTexelData)[Index];
+		return FLinearColor(Value, Value, Value);
+	}
+	case EPCGTextureCPUStorage::R32F:
+	{
+		const float Value = reinterpret_cast<const float*>(InTexelData)[Index];
+		return FLinearColor(Value, Value, Value);
+	}
+	case EPCGTextureCPUStorage::RGBA32F:
+	default:
+		return reinterpret_cast<const FLinearColor*>(InTexelData)[Index];
+	}
+}
+
 UCLASS(MinimalAPI, BlueprintType, ClassGroup=(Procedural))
 class UPCGTextureData : public UPCGBaseTextureData
 {
@@ -33,6 +33,8 @@ public:
 	UE_API virtual FBox GetBounds() const override;
 	UE_API virtual FBox GetStrictBounds() const override;
 	UE_API virtual bool SamplePoint(const FTransform& Transform, const FBox& Bounds, FPCGPoint& OutPoint, UPCGMetadata* OutMetadata) const override;
+	UE_API virtual void SamplePointsRange(const FPCGSampleQueryRanges& InQueries, FPCGPointValueRanges& OutRanges, int32 OutStartIndex, UPCGMetadata* OutMetadata) const override;
+	UE_API virtual void ProjectPointsRange(const FPCGSampleQueryRanges& InQueries, const FPCGProjectionParams& InParams, FPCGPointValueRanges& OutRanges, int32 OutStartIndex, UPCGMetadata* OutMetadata) const override;
 	// TODO what should this do - closest point on volume?
 	//virtual bool ProjectPoint(const FTransform& InTransform, const FBox& InBounds, const FPCGProjectionParams& InParams, FPCGPoint& OutPoint, UPCGMetadata* OutMetadata) const;
 protected:
@@ -52,6 +54,9 @@ private:
 	UE_API const UPCGBasePointData* CreateBasePointData(FPCGContext* Context, TSubclassOf<UPCGBasePointData> PointDataClass) const;
 
 protected:
+	/** Density of the volume at a position, shared by SamplePoint and SamplePointsRange. Returns false if the position is outside the bounds. */
+	UE_API bool ComputeDensityAtPosition(const FVector& InPosition, float& OutDensity) const;
+
 	UE_API void CopyBaseVolumeData(UPCGVolumeData* NewVolumeData) const;
 	UE_API void ReleaseInternalBodyInstance();
 	UE_API void SetupVolumeBodyInstance();
@@ -337,6 +337,8 @@ public:
 	//~Begin UPCGSpatialData interface
 	virtual bool IsBounded() const override { return !!Bounds.IsValid; }
 	virtual bool SamplePoint(const FTransform& Transform, const FBox& Bounds, FPCGPoint& OutPoint, UPCGMetadata* OutMetadata) const override;
+	/** Samples with the world overlap queries of SamplePoint rather than the volume implementation. */
+	virtual void SamplePointsRange(const FPCGSampleQueryRanges& InQueries, FPCGPointValueRanges& OutRanges, int32 OutStartIndex, UPCGMetadata* OutMetadata) const override { UPCGSpatialData::SamplePointsRange(InQueries, OutRanges, OutStartIndex, OutMetadata); }
 	// TODO not sure what this would mean. Without a direction, this means perhaps finding closest point on any collision surface? Should we implement this disabled?
 	//virtual bool ProjectPoint(const FTransform& InTransform, const FBox& InBounds, const FPCGProjectionParams& InParams, FPCGPoint& OutPoint, UPCGMetadata* OutMetadata) const;
 protected:
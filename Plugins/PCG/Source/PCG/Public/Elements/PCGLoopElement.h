@@ -6,6 +6,27 @@
 
 #include "PCGLoopElement.generated.h"
 
+struct FPCGStack;
+
+namespace PCGLoopHelpers
+{
+	/**
+	* Builds the iteration tag name of a batched loop execution, as '<IterationTag>_<StackCrc>'. Unique per loop node and stack, so a batched loop
+	* never mixes its tags with the ones of an enclosing batched loop (or any upstream data using the same IterationTag).
+	*/
+	PCG_API FString GetIterationTagName(const FString& IterationTag, const FPCGStack* Stack);
+
+	/** Builds the tag identifying the data of the given iteration in a batched loop, as '<IterationTagName>:<IterationIndex>'. */
+	PCG_API FString GetIterationTag(const FString& IterationTagName, int32 IterationIndex);
+
+	/**
+	* Reorders the output of a batched loop by iteration (stable), matching the order in which the per-iteration loop outputs its data, and removes the iteration tags.
+	* Data carrying the tags of several iterations goes with the first one, data without any iteration tag is kept last.
+	* Returns the number of data without any iteration tag.
+	*/
+	PCG_API int32 SortByIterationAndRemoveTags(const FString& IterationTagName, TArray<FPCGTaggedData>& InOutTaggedData);
+}
+
 UCLASS(MinimalAPI, BlueprintType, ClassGroup=(Procedural))
 class UPCGLoopSettings : public UPCGSubgraphSettings
 {
@@ -60,6 +81,20 @@ public:
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = Data, meta = (EditCondition = "!bUseGraphDefaultPinUsage"))
 	FString FeedbackPins;
 
+	/**
+	* Executes the subgraph once on the data of all iterations instead of once per iteration, which removes the per-iteration scheduling cost.
+	* Each loop data is tagged with its iteration ('<IterationTag>_<Id>:<Index>', where Id identifies this loop execution, so nested batched loops
+	* keep their tags apart), and the outputs are reordered by iteration with these iteration tags removed.
+	* Only use this when the subgraph processes each data independently, since nodes that merge, count or compare data will see all iterations at once. Ignored on feedback loops.
+	* Nodes that drop or replace the tags of their inputs (or create data from nothing) lose the iteration: their outputs can't be split per iteration and are output last, with a warning.
+	*/
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = Data, AdvancedDisplay)
+	bool bBatchIterations = false;
+
+	/** Prefix of the tag identifying the iteration of each data when batching iterations. */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = Data, AdvancedDisplay, meta = (EditCondition = "bBatchIterations"))
+	FString IterationTag = TEXT("LoopIteration");
+
 	/** Enables deprecated behavior using spaces as separators. Disable to update the node to current behavior. */
 	UE_DEPRECATED(5.5, "bTokenizeOnWhiteSpace has been deprecated.")
 	UPROPERTY(EditAnywhere, Category = Settings, meta = (EditCondition = "bTokenizeOnWhiteSpace", EditConditionHides, DeprecationMessage = "bTokenizeOnWhiteSpace has been deprecated."))
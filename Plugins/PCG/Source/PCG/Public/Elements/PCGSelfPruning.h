@@ -47,6 +47,10 @@ public:
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = Settings, meta = (PCG_Overridable))
 	bool bRandomizedPruning = true;
 
+	/** Prunes the points on multiple threads. Gives the same result as the single threaded pruning. Only used for bounds pruning (not with the Remove Duplicates mode nor with collisions). */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = Settings, meta = (PCG_Overridable, EditCondition = "PruningType != EPCGSelfPruningType::RemoveDuplicates && !bUseCollisionAttribute"))
+	bool bParallelPruning = false;
+
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = Settings, meta = (PCG_Overridable, EditCondition = "PruningType != EPCGSelfPruningType::RemoveDuplicates"))
 	bool bUseCollisionAttribute = false;
 
@@ -85,6 +89,14 @@ namespace PCGSelfPruningElement
 		bool Contains(const FPCGPoint* Point) { return false; }
 	};
 
+	/** Decision for a point in the parallel pruning. */
+	enum class EPointPruningState : uint8
+	{
+		Undecided,
+		Kept,
+		Pruned
+	};
+
 	struct FIterationState
 	{
 		const UPCGBasePointData* InputData = nullptr;
@@ -101,6 +113,12 @@ namespace PCGSelfPruningElement
 		FPCGCollisionWrapper CollisionWrapper;
 		TMap<FBodyInstance*, FBodyInstance*> TemporaryBodyInstances;
 
+		// Parallel pruning: position of each point in the sorted order, decision for each point and points still undecided (sorted indices, in order).
+		TArray<int32> PointRanks;
+		TArray<EPointPruningState> PointStates;
+		TArray<int32> PendingSortedIndices;
+		bool bParallelInitDone = false;
+
 PRAGMA_DISABLE_DEPRECATION_WARNINGS
 		UE_DEPRECATED(5.6, "Use SortedPointRefs instead")
 		TArray<FPCGPointRef> SortedPoints;
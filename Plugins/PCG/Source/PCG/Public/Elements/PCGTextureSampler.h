@@ -85,6 +85,10 @@ public:
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = Settings, meta = (PCG_Overridable))
 	EPCGTextureFilter Filter = EPCGTextureFilter::Bilinear;
 
+	/** Use of a CPU mip chain for samples larger than a texel, such as points with large bounds or a texel size much larger than the texture resolution. */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = Settings, meta = (PCG_Overridable))
+	EPCGTextureMipFilter MipFilter = EPCGTextureMipFilter::None;
+
 	/** The size of one texel in cm, used when calling ToPointData. */
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = Settings, meta = (UIMin = "1.0", ClampMin = "1.0", PCG_Overridable))
 	float TexelSize = 50.0f;
@@ -4,12 +4,26 @@
 
 #include "PCGCrc.h"
 
+#include "Templates/Function.h"
+
 class IPCGElement;
 class IPCGGraphExecutionSource;
 class UPCGComponent;
 class UPCGNode;
 struct FPCGDataCollection;
 
+/** Dependencies that are stable across sessions (see IPCGElement::ComputePersistentDependencies), used to key and validate disk cache entries. */
+struct FPCGPersistentDependencies
+{
+	/** Combined Crc of the settings and the inputs. Invalid if the results can't go through the disk cache. */
+	FPCGCrc Crc;
+
+	/** Persistent Crc of each input. Stored in the disk cache entries and compared on load, so that a Crc collision is never served. */
+	TArray<FPCGCrc> InputCrcs;
+
+	bool IsValid() const { return Crc.IsValid(); }
+};
+
 struct FPCGGetFromCacheParams
 {
 	const UPCGNode* Node = nullptr;
@@ -20,12 +34,24 @@ struct FPCGGetFromCacheParams
 
 	const IPCGGraphExecutionSource* ExecutionSource = nullptr;
 	FPCGCrc Crc;
+
+	/**
+	* Returns the dependencies that are stable across sessions, to look up the disk cache. Only called when the memory cache misses, since
+	* it hashes the full content of the inputs. Unset if results can't be read from the disk cache.
+	*/
+	TFunction<const FPCGPersistentDependencies&()> GetPersistentDependencies;
 };
 
 struct FPCGStoreInCacheParams
 {
 	const IPCGElement* Element = nullptr;
 	FPCGCrc Crc;
+
+	/** Node that produced the results. Optional, required to store results in the disk cache. */
+	const UPCGNode* Node = nullptr;
+
+	/** Dependencies that are stable across sessions. Optional, results are only written to the disk cache when they are valid. */
+	const FPCGPersistentDependencies* PersistentDependencies = nullptr;
 };
 
 /** Interface to encapsulate use of the cache in PCG elements */
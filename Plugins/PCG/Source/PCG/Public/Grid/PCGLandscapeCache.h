@@ -76,6 +76,18 @@ public:
 	void GetInterpolatedPointHeightOnly(const FVector2D& LocalPoint, FPCGPoint& OutPoint, UPCGMetadata* OutMetadata) const;
 	void GetInterpolatedLayerWeights(const FVector2D& LocalPoint, TArray<FPCGLandscapeLayerWeight>& OutLayerWeights) const;
 
+	/** Interpolates the position (and normal if requested) at the given local point without building a point or touching metadata. */
+	void GetInterpolatedPositionAndNormal(const FVector2D& LocalPoint, FVector& OutPosition, FVector* OutNormal) const;
+
+	/** Returns the index of the given layer in this entry, or INDEX_NONE if the layer is not painted on this component. */
+	int32 GetLayerIndex(FName LayerName) const { return LayerDataNames.IndexOfByKey(LayerName); }
+
+	/** Metadata-free read of a single layer weight. Returns 0 if the layer index is invalid for this entry. */
+	float GetInterpolatedLayerWeight(const FVector2D& LocalPoint, int32 LayerIndex) const;
+
+	/** Metadata-free read of a single layer weight for a batch of local points, written into the caller-provided buffer. */
+	void GetInterpolatedLayerWeight(TConstArrayView<FVector2D> LocalPoints, int32 LayerIndex, TArrayView<float> OutWeights) const;
+
 private:
 	// Private API to remove boilerplate
 	void GetInterpolatedPointInternal(const PCGLandscapeCache::FSafeIndices& Indices, FPCGPoint& OutPoint, bool bHeightOnly = false) const;
@@ -23,6 +23,7 @@ namespace FPCGAsync
 		extern PCG_API TAutoConsoleVariable<bool> CVarDisableAsyncTimeSlicingOnGameThread;
 		extern PCG_API TAutoConsoleVariable<float> CVarAsyncOutOfTickBudgetInMilliseconds;
 		extern PCG_API TAutoConsoleVariable<int32> CVarAsyncOverrideChunkSize;
+		extern PCG_API TAutoConsoleVariable<bool> CVarAsyncDynamicChunkScheduling;
 	};
 
 	/** 
@@ -117,7 +118,12 @@ namespace FPCGAsync
 
 			// Main thread is also doing work.
 			const int32 NumFutures = NumTasks - 1;
-			if (NumFutures != 0)
+			if (NumFutures != 0 && AsyncState.bAllowDynamicChunkScheduling && ConsoleVar::CVarAsyncDynamicChunkScheduling.GetValueOnAnyThread())
+			{
+				// With dynamic scheduling, all tasks claim chunks from a shared cursor, so there are no ranges to dispatch.
+				AsyncState.NextChunkToProcess = 0;
+			}
+			else if (NumFutures != 0)
 			{
 				int32 Count = 0;
 				AsyncState.TasksChunksStartEnd.Reserve(NumTasks);
@@ -145,7 +151,16 @@ namespace FPCGAsync
 			}
 		}
 
-		const int32 NumFutures = FMath::Max(0, AsyncState.TasksChunksStartEnd.Num() - 1);
+		const bool bUseDynamicChunkScheduling = AsyncState.NextChunkToProcess != INDEX_NONE;
+		int32 NumFutures = FMath::Max(0, AsyncState.TasksChunksStartEnd.Num() - 1);
+
+		if (bUseDynamicChunkScheduling)
+		{
+			// Tasks are not bound to a range, so only launch as many as there are chunks left to claim in this time slice.
+			const int32 NumChunksLeft = FMath::Max(0, ChunksNumber - AsyncState.NextChunkToProcess);
+			const int32 NumTasks = AsyncState.NumAvailableTasks > 0 ? FMath::Min(AsyncState.NumAvailableTasks, NumChunksLeft) : NumChunksLeft;
+			NumFutures = FMath::Max(0, NumTasks - 1);
+		}
 
 		// Synchronisation structure to be shared between async tasks and collapsing main thread.
 		struct FSynchroStruct 
@@ -153,6 +168,9 @@ namespace FPCGAsync
 			// Atomic to indicate tasks to stop processing new chunks.
 			std::atomic<bool> bQuit = false;
 
+			// For dynamic chunk scheduling, next chunk to be claimed by any task.
+			std::atomic<int32> NextChunkToProcess = 0;
+
 			// Queue for worker to indicate the current chunk that was processed and the number of elements written.
 			// Threadsafe for MPSC: Multiple Producers (async tasks) and Single Consumer (collapsing task).
 			TMpscQueue<TPair<int32, int32>> ChunkProcessedIndexAndNumElementsWrittenQueue;
@@ -165,7 +183,8 @@ namespace FPCGAsync
 		};
 
 		// Main thread will either work if there is no future, or work and collapse arrays if there are some.
-		if (NumFutures == 0)
+		// With dynamic scheduling, chunks may already have been processed ahead of the collapse, so always go through the collapse.
+		if (NumFutures == 0 && !bUseDynamicChunkScheduling)
 		{
 			// Main thread is working
 			check(ChunksNumber > 0);
@@ -195,6 +214,7 @@ namespace FPCGAsync
 			// Main thread is collapsing
 			// First start the futures
 			FSynchroStruct SynchroStruct{};
+			SynchroStruct.NextChunkToProcess = bUseDynamicChunkScheduling ? AsyncState.NextChunkToProcess : 0;
 
 			// Futures are not returning anything.
 			TArray<UE::Tasks::TTask<void>> AsyncTasks;
@@ -225,6 +245,29 @@ namespace FPCGAsync
 			{
 				TRACE_CPUPROFILER_EVENT_SCOPE(FPCGAsync::Private::AsyncProcessing::StartingTasks);
 
+				if (bUseDynamicChunkScheduling)
+				{
+					AsyncTasks.Emplace(UE::Tasks::Launch(UE_SOURCE_LOCATION, [&JobTask, &SynchroStruct, ChunksNumber]() -> void
+					{
+						// Claim chunks until there are none left or we were told to stop.
+						// Do at least one run if there is a chunk left, as we could fall into an infinite loop if we always have to stop before doing anything.
+						int32 ChunkToProcess = SynchroStruct.NextChunkToProcess++;
+						while (ChunkToProcess < ChunksNumber)
+						{
+							JobTask(ChunkToProcess);
+
+							if (SynchroStruct.bQuit)
+							{
+								break;
+							}
+
+							ChunkToProcess = SynchroStruct.NextChunkToProcess++;
+						}
+					}));
+
+					continue;
+				}
+
 				if (AsyncState.TasksChunksStartEnd[TaskIndex].Get<0>() == AsyncState.TasksChunksStartEnd[TaskIndex].Get<1>())
 				{
 					// No work left to do.
@@ -281,7 +324,19 @@ namespace FPCGAsync
 				FlushQueue();
 				
 				// If we have work to do, do it.
-				if (AsyncState.TasksChunksStartEnd.Last().Get<0>() != AsyncState.TasksChunksStartEnd.Last().Get<1>())
+				if (bUseDynamicChunkScheduling)
+				{
+					if (SynchroStruct.NextChunkToProcess < ChunksNumber)
+					{
+						const int32 ChunkToProcess = SynchroStruct.NextChunkToProcess++;
+						if (ChunkToProcess < ChunksNumber)
+						{
+							JobTask(ChunkToProcess);
+							continue;
+						}
+					}
+				}
+				else if (AsyncState.TasksChunksStartEnd.Last().Get<0>() != AsyncState.TasksChunksStartEnd.Last().Get<1>())
 				{
 					JobTask(AsyncState.TasksChunksStartEnd.Last().Get<0>()++);
 					continue;
@@ -335,6 +390,12 @@ namespace FPCGAsync
 				// If we reach that point, it means we finished the collapse or we ran out of time. So indicate to stop.
 				SynchroStruct.bQuit = true;
 			}
+
+			// All tasks are done, so every chunk before the cursor has been processed. Keep it for the next time slice.
+			if (bUseDynamicChunkScheduling)
+			{
+				AsyncState.NextChunkToProcess = FMath::Min(SynchroStruct.NextChunkToProcess.load(), ChunksNumber);
+			}
 		}
 
 		const bool bIsDone = AsyncState.CurrentChunkToCollapse == ChunksNumber;
@@ -363,6 +424,7 @@ namespace FPCGAsync
 	*   - We will finish to process and collapse data for all data already in process, even if we need to stop. To mitigate this, try to use small chunk sizes.
 	*   - To avoid infinite loops (when we should stop even before starting working), we will at least process 1 chunk of data per thread.
 	*   - To have async tasks, you need to have at least 3 available threads (main thread + 2 futures). Otherwise, we will only process on the main thread, without collapse.
+	*   - Tasks claim chunks dynamically by default (see FPCGAsyncState::bAllowDynamicChunkScheduling), so don't rely on which task processes a given chunk.
 	* 
 	* @param AsyncState - The context containing the information about how many tasks we can launch, async read/write index for the current job and a function to know if we need to stop processing.
 	* @param NumIterations - The number of calls that will be done to the provided function, also an upper bound on the number of data generated.
@@ -409,6 +471,7 @@ namespace FPCGAsync
 	*   - We will finish to process and collapse data for all data already in process, even if we need to stop. To mitigate this, try to use small chunk sizes.
 	*   - To avoid infinite loops (when we should stop even before starting working), we will at least process 1 chunk of data per thread.
 	*   - To have async tasks, you need to have at least 3 available threads (main thread + 2 futures). Otherwise, we will only process on the main thread, without collapse.
+	*   - Tasks claim chunks dynamically by default (see FPCGAsyncState::bAllowDynamicChunkScheduling), so don't rely on which task processes a given chunk.
 	* 
 	* @param AsyncState - The context containing the information about how many tasks we can launch, async read/write index for the current job and a function to know if we need to stop processing.
 	* @param NumIterations - The number of calls that will be done to the provided function, also an upper bound on the number of data generated.
@@ -453,6 +516,7 @@ namespace FPCGAsync
 	*   - We will finish to process and collapse data for all data already in process, even if we need to stop. To mitigate this, try to use small chunk sizes.
 	*   - To avoid infinite loops (when we should stop even before starting working), we will at least process 1 chunk of data per thread.
 	*   - To have async tasks, you need to have at least 3 available threads (main thread + 2 futures). Otherwise, we will only process on the main thread, without collapse.
+	*   - Tasks claim chunks dynamically by default (see FPCGAsyncState::bAllowDynamicChunkScheduling), so don't rely on which task processes a given chunk.
 	* 
 	* @param AsyncState - The context containing the information about how many tasks we can launch, async read/write index for the current job and a function to know if we need to stop processing.
 	* @param NumIterations - The number of calls that will be done to the provided function, also an upper bound on the number of data generated.
@@ -507,6 +571,7 @@ namespace FPCGAsync
 	*   - We will finish to process and collapse data for all data already in process, even if we need to stop. To mitigate this, try to use small chunk sizes.
 	*   - To avoid infinite loops (when we should stop even before starting working), we will at least process 1 chunk of data per thread.
 	*   - To have async tasks, you need to have at least 3 available threads (main thread + 2 futures). Otherwise, we will only process on the main thread, without collapse.
+	*   - Tasks claim chunks dynamically by default (see FPCGAsyncState::bAllowDynamicChunkScheduling), so don't rely on which task processes a given chunk.
 	* 
 	* @param AsyncState - The context containing the information about how many tasks we can launch, async read/write index for the current job and a function to know if we need to stop processing.
 	* @param NumIterations - The number of calls that will be done to the provided function, also an upper bound on the number of data generated.
@@ -561,6 +626,7 @@ namespace FPCGAsync
 	*   - We will finish to process and collapse data for all data already in process, even if we need to stop. To mitigate this, try to use small chunk sizes.
 	*   - To avoid infinite loops (when we should stop even before starting working), we will at least process 1 chunk of data per thread.
 	*   - To have async tasks, you need to have at least 3 available threads (main thread + 2 futures). Otherwise, we will only process on the main thread, without collapse.
+	*   - Tasks claim chunks dynamically by default (see FPCGAsyncState::bAllowDynamicChunkScheduling), so don't rely on which task processes a given chunk.
 	* 
 	* @param AsyncState - The context containing the information about how many tasks we can launch, async read/write index for the current job and a function to know if we need to stop processing.
 	* @param NumIterations - The number of calls that will be done to the provided function, also an upper bound on the number of data generated.
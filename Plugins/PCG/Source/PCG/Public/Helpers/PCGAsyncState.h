@@ -50,6 +50,15 @@ struct FPCGAsyncState
 	/** Map between the processed chunks but not yet processed and the number of elements written for that chunk. */
 	TMap<int32, int32> ChunkToNumElementsWrittenMap;
 
+	/**
+	* If true, async tasks claim the next chunk to process from a shared cursor instead of processing a fixed range of chunks each,
+	* which balances uneven costs per iteration. Chunks are still collapsed in order. Can be disabled globally with 'pcg.Async.DynamicChunkScheduling'.
+	*/
+	bool bAllowDynamicChunkScheduling = true;
+
+	/** For dynamic chunk scheduling, the next chunk to be claimed by a task. INDEX_NONE if tasks process fixed ranges of chunks. */
+	int32 NextChunkToProcess = INDEX_NONE;
+
 	/** For multithreading, track if the current element is run on the main thread. */
 	bool bIsRunningOnMainThread = true;
 
@@ -9,6 +9,7 @@
 #define UE_API PCG_API
 
 class UMaterialInterface;
+class UPCGBasePointData;
 
 UENUM()
 enum class EPCGMeshSelectorMaterialOverrideMode : uint8
@@ -45,12 +46,33 @@ struct FPCGMeshMaterialOverrideHelper
 	bool OverridesMaterials() const { return bUseMaterialOverrideAttributes; }
 	UE_API const TArray<TSoftObjectPtr<UMaterialInterface>>& GetMaterialOverrides(PCGMetadataEntryKey EntryKey);
 
+	/**
+	* Resolves the material overrides of all the points in one pass, to an index in a table of unique overrides (a combination),
+	* so points can be grouped by combination instead of comparing override arrays.
+	* Must be called after a successful Initialize, with the data the metadata comes from.
+	*/
+	UE_API void ResolveCombinations(const UPCGBasePointData* InPointData);
+
+	bool HasResolvedCombinations() const { return bHasResolvedCombinations; }
+	int32 GetNumCombinations() const { return Combinations.Num(); }
+
+	/** Combination of the point at this index in the resolved data. Thread safe. */
+	int32 GetCombinationId(int32 PointIndex) const { return PointCombinationIds.IsEmpty() ? 0 : PointCombinationIds[PointIndex]; }
+
+	/** Material overrides of the combination, same as GetMaterialOverrides for its points. Thread safe. */
+	const TArray<TSoftObjectPtr<UMaterialInterface>>& GetCombination(int32 CombinationId) const { return Combinations[CombinationId]; }
+
 private:
 	// Cached data
 	TArray<const FPCGMetadataAttributeBase*> MaterialAttributes;
 	TArray<TMap<PCGMetadataValueKey, TSoftObjectPtr<UMaterialInterface>>> ValueKeyToOverrideMaterials;
 	TArray<TSoftObjectPtr<UMaterialInterface>> WorkingMaterialOverrides;
 
+	// Resolved combinations
+	TArray<TArray<TSoftObjectPtr<UMaterialInterface>>> Combinations;
+	TArray<int32> PointCombinationIds;
+	bool bHasResolvedCombinations = false;
+
 	// Data needed to perform operations
 	bool bIsInitialized = false;
 	bool bIsValid = false;
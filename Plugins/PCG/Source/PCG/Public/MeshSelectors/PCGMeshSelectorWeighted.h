@@ -18,6 +18,38 @@ namespace PCGMeshSelectorWeighted
 		const TArray<TSoftObjectPtr<UMaterialInterface>>& InMaterialOverrides,
 		bool bInIsLocalToWorldDeterminantNegative,
 		const UPCGBasePointData* InPointData);
+
+	/** Points per parallel task, and tasks between two time slicing checks. */
+	constexpr int32 PointsPerChunk = 4096;
+	constexpr int32 ChunksPerSlice = 16;
+
+	/**
+	* Maps a weighted pick in [0, TotalWeight) to its entry in constant expected time, with the same result as a linear scan
+	* over the cumulative weights. The weight range is split in one bucket per entry, and each bucket starts the scan at the
+	* first entry overlapping it. Entries of zero weight (equal consecutive cumulative weights) are never picked.
+	*/
+	struct FWeightedPickTable
+	{
+		/** Cumulative weights must be non-decreasing, with a positive total weight. They are referenced, not copied. */
+		explicit FWeightedPickTable(const TArray<int>& InCumulativeWeights);
+
+		int32 Pick(int32 WeightedPick) const
+		{
+			const int32 Bucket = static_cast<int32>((static_cast<int64>(WeightedPick) * BucketFirstEntry.Num()) / TotalWeight);
+
+			int32 Entry = BucketFirstEntry[Bucket];
+			while (CumulativeWeights[Entry] <= WeightedPick)
+			{
+				++Entry;
+			}
+
+			return Entry;
+		}
+
+		const TArray<int>& CumulativeWeights;
+		TArray<int32> BucketFirstEntry;
+		int64 TotalWeight = 0;
+	};
 }
 
 USTRUCT(BlueprintType)
@@ -146,7 +146,7 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "PCG|Metadata|Advanced")
 	UE_API void Flatten();
 
-	/** Unparents current metadata by flattening the attributes (values, entries, etc.) */
+	/** Unparents current metadata by flattening the attributes (values, entries, etc.). Flattened attributes are sealed, see FPCGMetadataDomain::FlattenImpl. */
 	UE_API void FlattenImpl();
 
 	UE_DEPRECATED(5.6, "Use the version with the mapping")
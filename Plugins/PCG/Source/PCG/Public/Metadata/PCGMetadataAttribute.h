@@ -6,6 +6,8 @@
 
 #include "Utils/PCGValueRange.h"
 
+#include <atomic>
+
 #define UE_API PCG_API
 
 class FPCGMetadataDomain;
@@ -17,8 +19,23 @@ namespace PCGMetadataAttributeConstants
 	const FName LastCreatedAttributeName = TEXT("@LastCreated");
 	const FName SourceAttributeName = TEXT("@Source");
 	const FName SourceNameAttributeName = TEXT("@SourceName");
+
+	/** Sealing an attribute with more ancestors than this also resolves the entries of its ancestors, so sealed reads never walk the parent chain. */
+	constexpr int32 MaxSealedParentDepth = 1;
+
+	/** Entries (or values) per task when flattening large attributes. */
+	constexpr int32 FlattenBatchSize = 16384;
 }
 
+/** How an attribute stores its local entry key to value key mapping. */
+enum class EPCGMetadataEntryStorage : uint8
+{
+	/** Hash map, for attributes set on a few scattered entries. */
+	Sparse,
+	/** Flat array indexed by entry key, for attributes set on most entries of a contiguous key range (e.g. point data). */
+	Dense
+};
+
 class FPCGMetadataAttributeBase
 {
 public:
@@ -42,6 +59,12 @@ public:
 
 	/** Remove all entries, values and parenting. */
 	virtual void Reset() = 0;
+
+	/**
+	 * Sets every entry in [0, NumEntries) that resolves to a non default value key, through the parents, as a local entry,
+	 * so the attribute can be unparented by Flatten. Large ranges are resolved in parallel.
+	 */
+	UE_API void FlattenEntries(int64 NumEntries);
 	
 	UE_API const UPCGMetadata* GetMetadata() const;
 	const FPCGMetadataDomain* GetMetadataDomain() const { return Metadata; }
@@ -95,11 +118,38 @@ public:
 
 	bool AllowsInterpolation() const { return bAllowsInterpolation; }
 
-	int32 GetNumberOfEntries() const { return EntryToValueKeyMap.Num(); }
-	int32 GetNumberOfEntriesWithParents() const { return EntryToValueKeyMap.Num() + (Parent ? Parent->GetNumberOfEntries() : 0); }
-
-	// This call is not thread safe
-	const TMap<PCGMetadataEntryKey, PCGMetadataValueKey>& GetEntryToValueKeyMap_NotThreadSafe() const { return EntryToValueKeyMap; }
+	int32 GetNumberOfEntries() const { return EntryStorage == EPCGMetadataEntryStorage::Dense ? NumDenseEntries : EntryToValueKeyMap.Num(); }
+	int32 GetNumberOfEntriesWithParents() const { return GetNumberOfEntries() + (Parent ? Parent->GetNumberOfEntries() : 0); }
+
+	// This call is not thread safe. Only holds the entries of sparse attributes, use ForEachEntry_NotThreadSafe for any storage.
+	const TMap<PCGMetadataEntryKey, PCGMetadataValueKey>& GetEntryToValueKeyMap_NotThreadSafe() const
+	{
+		ensureMsgf(EntryStorage == EPCGMetadataEntryStorage::Sparse, TEXT("Attribute '%s' uses dense entry storage, its entry map is empty."), *Name.ToString());
+		return EntryToValueKeyMap;
+	}
+
+	// This call is not thread safe. Calls InFunc(EntryKey, ValueKey) for every local entry, whatever the entry storage.
+	template<typename Func>
+	void ForEachEntry_NotThreadSafe(Func&& InFunc) const { ForEachLocalEntry_Unsafe(Forward<Func>(InFunc)); }
+
+	EPCGMetadataEntryStorage GetEntryStorage() const { return EntryStorage; }
+
+	/**
+	 * Converts the local entries to the given storage. Converting to dense fails (returns false) when the local entry keys
+	 * are too scattered for a flat array. Unseals the attribute.
+	 */
+	UE_API bool SetEntryStorage(EPCGMetadataEntryStorage InEntryStorage);
+
+	/**
+	 * Marks the attribute as read only, so reads skip the entry lock. Without parent, that is all: unset entries read the default value.
+	 * With parents, the value key of every entry of the metadata domain is also resolved once (from the first entry if the parent chain
+	 * is deeper than MaxSealedParentDepth) into a read cache, so reads are an array lookup that never walks the chain. The cache is not
+	 * serialized and does not count as entries.
+	 * Any write unseals the attribute: a sealed attribute must not be written while it is being read.
+	 * Returns false if the entry range does not fit a flat array.
+	 */
+	UE_API bool Seal();
+	bool IsSealed() const { return bSealed.load(std::memory_order_acquire); }
 
 	const FPCGMetadataAttributeBase* GetParent() const { return Parent; }
 
@@ -120,10 +170,126 @@ private:
 	// So we will copy internally the EntryKeys to modify them (and only once) if we are not owner of the memory.
 	UE_API void GetValueKeys_Internal(TConstPCGValueRange<PCGMetadataEntryKey> EntryKeys, TArrayView<PCGMetadataValueKey> OutValueKeys, TBitArray<>& UnsetValues, bool bOwnerOfEntryKeysView = false) const;
 
+	// Lock free gather for a sealed attribute. Returns false, with OutValueKeys partially written, if any key is out of the sealed range.
+	UE_API bool GetValueKeys_Sealed(TConstPCGValueRange<PCGMetadataEntryKey> EntryKeys, TArrayView<PCGMetadataValueKey> OutValueKeys) const;
+
+	// True if the dense entries can cover [InMinKey, InMaxKey] for InNumEntries set entries.
+	static UE_API bool IsDenseSpan(PCGMetadataEntryKey InMinKey, PCGMetadataEntryKey InMaxKey, int32 InNumEntries);
+
+	// Unsafe versions, need to be write lock protected.
+	UE_API bool ConvertToDense_Unsafe();
+	UE_API void ConvertToSparse_Unsafe();
+
+	// Needs to be write lock protected. Clears the seal and frees the resolved value keys.
+	UE_API void Unseal_Unsafe();
+
+	// Lock free read for a sealed attribute. Returns false if the entry is out of the sealed range and must be read from the parents.
+	FORCEINLINE bool FindSealedValueKey(PCGMetadataEntryKey EntryKey, PCGMetadataValueKey& OutValueKey) const
+	{
+		if (EntryKey == PCGInvalidEntryKey)
+		{
+			OutValueKey = PCGDefaultValueKey;
+			return true;
+		}
+
+		if (!Parent)
+		{
+			if (!FindLocalValueKey_Unsafe(EntryKey, OutValueKey))
+			{
+				OutValueKey = PCGDefaultValueKey;
+			}
+			return true;
+		}
+
+		const int64 Index = EntryKey - SealedEntryKeyOffset;
+		if (Index >= 0 && Index < SealedValueKeys.Num())
+		{
+			OutValueKey = SealedValueKeys[Index];
+			return true;
+		}
+
+		return false;
+	}
+
 protected:
+	// Unsafe version, needs to be lock protected. Returns false if the entry has no local value key.
+	FORCEINLINE bool FindLocalValueKey_Unsafe(PCGMetadataEntryKey EntryKey, PCGMetadataValueKey& OutValueKey) const
+	{
+		if (EntryStorage == EPCGMetadataEntryStorage::Dense)
+		{
+			const int64 Index = EntryKey - DenseEntryKeyOffset;
+			if (Index >= 0 && Index < DenseEntryToValueKeys.Num() && DenseEntryToValueKeys[Index] != PCGNotFoundValueKey)
+			{
+				OutValueKey = DenseEntryToValueKeys[Index];
+				return true;
+			}
+
+			return false;
+		}
+		else if (const PCGMetadataValueKey* FoundLocalKey = EntryToValueKeyMap.Find(EntryKey))
+		{
+			OutValueKey = *FoundLocalKey;
+			return true;
+		}
+
+		return false;
+	}
+
+	// Unsafe version, needs to be write lock protected. Sets (or removes, with PCGNotFoundValueKey) the local value key of an entry.
+	UE_API void SetLocalValueKey_Unsafe(PCGMetadataEntryKey EntryKey, PCGMetadataValueKey ValueKey);
+
+	// Unsafe version, needs to be lock protected. Calls InFunc(EntryKey, ValueKey) for every local entry.
+	template<typename Func>
+	void ForEachLocalEntry_Unsafe(Func&& InFunc) const
+	{
+		if (EntryStorage == EPCGMetadataEntryStorage::Dense)
+		{
+			for (int32 Index = 0; Index < DenseEntryToValueKeys.Num(); ++Index)
+			{
+				if (DenseEntryToValueKeys[Index] != PCGNotFoundValueKey)
+				{
+					InFunc(DenseEntryKeyOffset + Index, DenseEntryToValueKeys[Index]);
+				}
+			}
+		}
+		else
+		{
+			for (const TPair<PCGMetadataEntryKey, PCGMetadataValueKey>& EntryValuePair : EntryToValueKeyMap)
+			{
+				InFunc(EntryValuePair.Key, EntryValuePair.Value);
+			}
+		}
+	}
+
+	// Unsafe version, needs to be write lock protected. Replaces all the local entries by dense entries, PCGNotFoundValueKey marking unset entries.
+	UE_API void SetDenseEntries_Unsafe(TArray<PCGMetadataValueKey>&& InValueKeys, PCGMetadataEntryKey InEntryKeyOffset);
+
+	// Unsafe version, needs to be write lock protected. Removes all the local entries, back to sparse storage.
+	UE_API void ResetEntries_Unsafe();
+
+	// Bulk getter in parallel batches of FlattenBatchSize, for flattening.
+	UE_API void GetValueKeys_Parallel(TArrayView<const PCGMetadataEntryKey> EntryKeys, TArrayView<PCGMetadataValueKey> OutValueKeys) const;
+
+	// Unsafe version, needs to be write lock protected. Replaces the local entries by the new entries 0..N-1 (PCGNotFoundValueKey for unset),
+	// stored densely unless most of them are unset.
+	UE_API void SetFlattenedEntries_Unsafe(TArray<PCGMetadataValueKey>&& InValueKeys, int32 InNumSetEntries);
+
 	TMap<PCGMetadataEntryKey, PCGMetadataValueKey> EntryToValueKeyMap;
 	mutable FRWLock EntryMapLock;
 
+	// Dense storage: value key of entry DenseEntryKeyOffset + Index, PCGNotFoundValueKey if not set on this attribute.
+	TArray<PCGMetadataValueKey> DenseEntryToValueKeys;
+	PCGMetadataEntryKey DenseEntryKeyOffset = 0;
+	int32 NumDenseEntries = 0;
+	EPCGMetadataEntryStorage EntryStorage = EPCGMetadataEntryStorage::Sparse;
+
+	// Set by Seal, cleared by any write. Entries are then read without lock.
+	std::atomic<bool> bSealed{ false };
+
+	// Sealed attributes with parents: value key of entry SealedEntryKeyOffset + Index, resolved through the parents. Runtime only.
+	TArray<PCGMetadataValueKey> SealedValueKeys;
+	PCGMetadataEntryKey SealedEntryKeyOffset = 0;
+
 	FPCGMetadataDomain* Metadata = nullptr;
 	const FPCGMetadataAttributeBase* Parent = nullptr;
 	int16 TypeId = 0;
@@ -9,6 +9,7 @@
 #include "Helpers/PCGMetadataHelpers.h"
 #include "Metadata/PCGMetadataAttribute.h"
 #include "Metadata/PCGMetadataAttributeTraits.h"
+#include "Async/ParallelFor.h"
 #include "Misc/ScopeRWLock.h"
 
 class FPCGMetadataDomain;
@@ -58,6 +59,7 @@ public:
 		// Initialize non-serialized members
 		if (InArchive.IsLoading())
 		{
+			ResetValueLookup();
 			ValueKeyOffset = GetParent() ? GetParent()->GetValueKeyOffsetForChild() : 0;
 		}
 	}
@@ -84,14 +86,18 @@ public:
 			}
 
 			TArray<T> FlattenedValues;
-			FlattenedValues.Reserve(ValueCount);
+			SetNumValuesForWrite(FlattenedValues, ValueCount);
 
+			int32 FlattenedIndex = 0;
 			for (int32 ValuesIndex = OriginalValues.Num() - 1; ValuesIndex >= 0; --ValuesIndex)
 			{
-				FlattenedValues.Append(*OriginalValues[ValuesIndex]);
+				const TArray<T>& SourceValues = *OriginalValues[ValuesIndex];
+				CopyValues_Parallel(SourceValues.GetData(), FlattenedValues.GetData() + FlattenedIndex, SourceValues.Num());
+				FlattenedIndex += SourceValues.Num();
 			}
 
 			Values = MoveTemp(FlattenedValues);
+			ResetValueLookup();
 		}
 		
 		// Reset value offset, and lose parent
@@ -108,49 +114,66 @@ public:
 			return;
 		}
 
-		TArray<PCGMetadataValueKey> AllValueKeys;
-		TArray<PCGMetadataValueKey> AllUniqueValueKeys;
-		AllValueKeys.Reserve(InEntryKeysToKeep.Num());
+		const int32 NumEntries = InEntryKeysToKeep.Num();
+		const int32 BatchSize = PCGMetadataAttributeConstants::FlattenBatchSize;
+		const int32 NumEntryBatches = FMath::DivideAndRoundUp(NumEntries, BatchSize);
 		constexpr bool bUseValueKeys = PCG::Private::MetadataTraits<T>::CompressData;
-		if constexpr (bUseValueKeys)
-		{
-			AllUniqueValueKeys.Reserve(InEntryKeysToKeep.Num());
-		}
 
 		// First gather all value keys associated with the entry keys to keep.
-		// If we compress data, we also store the unique value keys used (that is not default).
-		for (const PCGMetadataEntryKey& EntryKey : InEntryKeysToKeep)
+		TArray<PCGMetadataValueKey> AllValueKeys;
+		AllValueKeys.SetNumUninitialized(NumEntries);
+		GetValueKeys_Parallel(InEntryKeysToKeep, AllValueKeys);
+
+		// Then map each old value key (not default) to a new value key, in order of appearance. Old value keys are
+		// contiguous, so the mapping is a flat array.
+		// If we compress data, each unique old value key gets one new value. Otherwise every entry gets its own
+		// new value, and shared old value keys map to the last one.
+		TArray<PCGMetadataValueKey> ValueKeyMapping;
+		ValueKeyMapping.Init(PCGNotFoundValueKey, GetValueKeyOffsetForChild());
+		TArray<PCGMetadataValueKey> NewValuesOldKeys;
+		NewValuesOldKeys.Reserve(NumEntries);
+
+		for (const PCGMetadataValueKey ValueKey : AllValueKeys)
 		{
-			AllValueKeys.Add(GetValueKey(EntryKey));
-			if constexpr (bUseValueKeys)
+			if (ValueKey == PCGDefaultValueKey)
+			{
+				continue;
+			}
+
+			if (ValueKey >= ValueKeyMapping.Num())
 			{
-				if (AllValueKeys.Last() != PCGDefaultValueKey)
+				// Dangling value key, GetValue returns the default value for it.
+				const int32 OldNum = ValueKeyMapping.Num();
+				ValueKeyMapping.SetNumUninitialized(ValueKey + 1);
+				for (int32 i = OldNum; i <= ValueKey; ++i)
 				{
-					AllUniqueValueKeys.AddUnique(AllValueKeys.Last());
+					ValueKeyMapping[i] = PCGNotFoundValueKey;
 				}
 			}
+
+			if (!bUseValueKeys || ValueKeyMapping[ValueKey] == PCGNotFoundValueKey)
+			{
+				ValueKeyMapping[ValueKey] = NewValuesOldKeys.Add(ValueKey);
+			}
 		}
 
-		// Then for each value key (or unique values keys), gather the value in a NewValues array
-		// and also keep a mapping between old value key and new value key.
-		// Only done if the old value key is not the default one.
-		TMap<PCGMetadataValueKey, PCGMetadataValueKey> ValueKeyMapping;
+		// Then gather the values for the new value keys.
 		TArray<T> NewValues;
-		const TArray<PCGMetadataValueKey>& AllValueKeysRef = !bUseValueKeys ? AllValueKeys : AllUniqueValueKeys;
-		NewValues.Reserve(AllValueKeysRef.Num());
-		ValueKeyMapping.Reserve(AllValueKeysRef.Num());
-		for (PCGMetadataValueKey ValueKey : AllValueKeysRef)
+		SetNumValuesForWrite(NewValues, NewValuesOldKeys.Num());
 		{
-			if (ValueKey != PCGDefaultValueKey)
+			const int32 NumValueBatches = FMath::DivideAndRoundUp(NewValues.Num(), BatchSize);
+			ParallelFor(NumValueBatches, [this, &NewValues, &NewValuesOldKeys, BatchSize](int32 BatchIndex)
 			{
-				ValueKeyMapping.Add(ValueKey, NewValues.Num());
-				NewValues.Add(GetValue(ValueKey));
-			}
+				const int32 Start = BatchIndex * BatchSize;
+				const int32 Count = FMath::Min(BatchSize, NewValues.Num() - Start);
+				GetValues(TArrayView<const PCGMetadataValueKey>(NewValuesOldKeys).Slice(Start, Count), TArrayView<T>(NewValues).Slice(Start, Count));
+			}, NumValueBatches > 1 ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
 		}
 
 		// Move the new values in place of the old values.
 		ValueLock.WriteLock();
 		Values = std::move(NewValues);
+		ResetValueLookup();
 		ValueLock.WriteUnlock();
 
 		// And finally, create a new entry to value mapping.
@@ -158,19 +181,42 @@ public:
 		// (like if the entries to keep are [25, 47, 54], the new entries would be [0, 1, 2]).
 		// So the operation is:
 		// All pairs Old EK -> Old VK transform to New EK -> New VK.
-		TMap<PCGMetadataEntryKey, PCGMetadataValueKey> NewMap;
-		for (int32 i = 0; i < InEntryKeysToKeep.Num(); ++i)
+		TArray<PCGMetadataValueKey> NewEntries;
+		NewEntries.SetNumUninitialized(NumEntries);
+		TArray<int32> NumNewEntriesPerBatch;
+		NumNewEntriesPerBatch.SetNumZeroed(NumEntryBatches);
+
+		ParallelFor(NumEntryBatches, [&AllValueKeys, &InEntryKeysToKeep, &ValueKeyMapping, &NewEntries, &NumNewEntriesPerBatch, BatchSize](int32 BatchIndex)
 		{
-			PCGMetadataValueKey ValueKey = AllValueKeys[i];
-			if (ValueKey != PCGDefaultValueKey && ensure(InEntryKeysToKeep[i] != PCGInvalidEntryKey))
+			const int32 Start = BatchIndex * BatchSize;
+			const int32 End = FMath::Min(Start + BatchSize, NewEntries.Num());
+
+			int32 NumNewEntries = 0;
+			for (int32 i = Start; i < End; ++i)
 			{
-				NewMap.Add(i, ValueKeyMapping[ValueKey]);
+				const PCGMetadataValueKey ValueKey = AllValueKeys[i];
+				if (ValueKey != PCGDefaultValueKey && ensure(InEntryKeysToKeep[i] != PCGInvalidEntryKey))
+				{
+					NewEntries[i] = ValueKeyMapping[ValueKey];
+					++NumNewEntries;
+				}
+				else
+				{
+					NewEntries[i] = PCGNotFoundValueKey;
+				}
 			}
+
+			NumNewEntriesPerBatch[BatchIndex] = NumNewEntries;
+		}, NumEntryBatches > 1 ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+
+		int32 NumNewEntries = 0;
+		for (const int32 NumBatchNewEntries : NumNewEntriesPerBatch)
+		{
+			NumNewEntries += NumBatchNewEntries;
 		}
 
-		// And move the map.
 		EntryMapLock.WriteLock();
-		EntryToValueKeyMap = std::move(NewMap);
+		SetFlattenedEntries_Unsafe(MoveTemp(NewEntries), NumNewEntries);
 		EntryMapLock.WriteUnlock();
 
 		// At the end, reset value offset, and lose parent.
@@ -184,11 +230,14 @@ public:
 		Parent = nullptr;
 
 		EntryMapLock.WriteLock();
+		ResetEntries_Unsafe();
 		EntryToValueKeyMap.Empty();
+		DenseEntryToValueKeys.Empty();
 		EntryMapLock.WriteUnlock();
 
 		ValueLock.WriteLock();
 		Values.Empty();
+		ResetValueLookup();
 		ValueLock.WriteUnlock();
 	}
 
@@ -271,15 +320,29 @@ protected:
 
 		if (bCopyEntries)
 		{
-			// We go backwards, since we need to preserve order (root -> this)
-			// Latest entry in our Parents array is the root.
-			for (int32 i = Parents.Num() - 1; i >= 0; --i)
+			if (Parents.Num() == 1 && EntryStorage == EPCGMetadataEntryStorage::Dense)
 			{
-				const FPCGMetadataAttribute<T>* Current = Parents[i];
-				
-				Current->EntryMapLock.ReadLock();
-				AttributeCopy->EntryToValueKeyMap.Append(Current->EntryToValueKeyMap);
-				Current->EntryMapLock.ReadUnlock();
+				// Keep the dense layout (but not the seal, the copy is meant to be written).
+				EntryMapLock.ReadLock();
+				TArray<PCGMetadataValueKey> DenseEntriesCopy = DenseEntryToValueKeys;
+				AttributeCopy->SetDenseEntries_Unsafe(MoveTemp(DenseEntriesCopy), DenseEntryKeyOffset);
+				EntryMapLock.ReadUnlock();
+			}
+			else
+			{
+				// We go backwards, since we need to preserve order (root -> this)
+				// Latest entry in our Parents array is the root.
+				for (int32 i = Parents.Num() - 1; i >= 0; --i)
+				{
+					const FPCGMetadataAttribute<T>* Current = Parents[i];
+
+					Current->EntryMapLock.ReadLock();
+					Current->ForEachLocalEntry_Unsafe([AttributeCopy](PCGMetadataEntryKey EntryKey, PCGMetadataValueKey ValueKey)
+					{
+						AttributeCopy->EntryToValueKeyMap.Add(EntryKey, ValueKey);
+					});
+					Current->EntryMapLock.ReadUnlock();
+				}
 			}
 		}
 
@@ -755,9 +818,11 @@ public:
 		}
 		else
 		{
-			ValueLock.ReadLock();
-			const int32 ValueIndex = Values.FindLast(InValue);
-			ValueLock.ReadUnlock();
+			int32 ValueIndex = INDEX_NONE;
+			FindInValues([this, &InValue, &ValueIndex]()
+			{
+				ValueIndex = FindValueIndex_Unsafe(InValue);
+			});
 
 			if (ValueIndex != INDEX_NONE)
 			{
@@ -805,22 +870,23 @@ public:
 
 		if (ValueKeysSet != InValues.Num())
 		{
-			ValueLock.ReadLock();
-			for (int ValueIndex = 0; ValueIndex < InValues.Num(); ++ValueIndex)
+			FindInValues([this, &InValues, &ValueKeys, &ValueKeysSet]()
 			{
-				if (ValueKeys[ValueIndex] != PCGNotFoundValueKey)
+				for (int ValueIndex = 0; ValueIndex < InValues.Num(); ++ValueIndex)
 				{
-					continue;
-				}
+					if (ValueKeys[ValueIndex] != PCGNotFoundValueKey)
+					{
+						continue;
+					}
 
-				const int32 FoundValueIndex = Values.FindLast(InValues[ValueIndex]);
-				if (FoundValueIndex != INDEX_NONE)
-				{
-					ValueKeys[ValueIndex] = FoundValueIndex + ValueKeyOffset;
-					++ValueKeysSet;
+					const int32 FoundValueIndex = FindValueIndex_Unsafe(InValues[ValueIndex]);
+					if (FoundValueIndex != INDEX_NONE)
+					{
+						ValueKeys[ValueIndex] = FoundValueIndex + ValueKeyOffset;
+						++ValueKeysSet;
+					}
 				}
-			}
-			ValueLock.ReadUnlock();
+			});
 		}
 	}
 
@@ -830,6 +896,114 @@ public:
 		return PCGNotFoundValueKey;
 	}
 
+protected:
+	/**
+	* Runs the given lookup with the value lock held. Once the attribute holds enough values, lookups go through a hashed value index
+	* that is built lazily and then caught up incrementally with the values added since, in which case the lock is taken for write.
+	*/
+	template<typename LookupFunc>
+	void FindInValues(LookupFunc&& Lookup) const
+	{
+		{
+			FReadScopeLock ScopeLock(ValueLock);
+			if (Values.Num() < ValueLookupThreshold || NumValuesInLookup == Values.Num())
+			{
+				Lookup();
+				return;
+			}
+		}
+
+		FWriteScopeLock ScopeLock(ValueLock);
+		UpdateValueLookup_Unsafe();
+		Lookup();
+	}
+
+	/** Returns the index of the last value equal to InValue in this attribute (parents excluded), or INDEX_NONE. Must be called through FindInValues. */
+	int32 FindValueIndex_Unsafe(const T& InValue) const
+	{
+		if constexpr (PCG::Private::MetadataTraits<T>::CompressData)
+		{
+			if (Values.Num() < ValueLookupThreshold)
+			{
+				return Values.FindLast(InValue);
+			}
+
+			check(NumValuesInLookup == Values.Num());
+			const int32* FoundIndex = ValueLookup.Find(InValue);
+			return FoundIndex ? *FoundIndex : INDEX_NONE;
+		}
+		else
+		{
+			return INDEX_NONE;
+		}
+	}
+
+	/** Indexes the values added since the last update. Must be called with the value lock held for write. */
+	void UpdateValueLookup_Unsafe() const
+	{
+		if constexpr (PCG::Private::MetadataTraits<T>::CompressData)
+		{
+			ValueLookup.Reserve(Values.Num());
+
+			// Later values overwrite earlier duplicates, to match FindLast.
+			for (; NumValuesInLookup < Values.Num(); ++NumValuesInLookup)
+			{
+				ValueLookup.Add(Values[NumValuesInLookup], NumValuesInLookup);
+			}
+		}
+	}
+
+	/** Sizes an array that is about to be fully overwritten, without constructing trivially copyable values. */
+	static void SetNumValuesForWrite(TArray<T>& OutValues, int32 Num)
+	{
+		if constexpr (std::is_trivially_copyable_v<T>)
+		{
+			OutValues.SetNumUninitialized(Num);
+		}
+		else
+		{
+			OutValues.SetNum(Num);
+		}
+	}
+
+	/** Copies values in parallel batches of FlattenBatchSize, into constructed (or trivially copyable) values. */
+	static void CopyValues_Parallel(const T* Source, T* Destination, int32 Num)
+	{
+		const int32 BatchSize = PCGMetadataAttributeConstants::FlattenBatchSize;
+		const int32 NumBatches = FMath::DivideAndRoundUp(Num, BatchSize);
+
+		ParallelFor(NumBatches, [Source, Destination, Num, BatchSize](int32 BatchIndex)
+		{
+			const int32 Start = BatchIndex * BatchSize;
+			const int32 Count = FMath::Min(BatchSize, Num - Start);
+
+			if constexpr (std::is_trivially_copyable_v<T>)
+			{
+				FMemory::Memcpy(Destination + Start, Source + Start, Count * sizeof(T));
+			}
+			else
+			{
+				for (int32 i = Start; i < Start + Count; ++i)
+				{
+					Destination[i] = Source[i];
+				}
+			}
+		}, NumBatches > 1 ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+	}
+
+	/** Drops the value index, must be called whenever values are replaced rather than appended. */
+	void ResetValueLookup()
+	{
+		if constexpr (PCG::Private::MetadataTraits<T>::CompressData)
+		{
+			ValueLookup.Empty();
+		}
+
+		NumValuesInLookup = 0;
+	}
+
+public:
+
 	template<typename IT = T, typename TEnableIf<!PCG::Private::MetadataTraits<IT>::CompressData>::Type* = nullptr>
 	bool FindValues(const TArrayView<const T>& InValues, TArray<PCGMetadataValueKey>& OutValueKeys) const
 	{
@@ -844,7 +1018,14 @@ public:
 
 	void Prepare(int32 Count)
 	{
-		EntryToValueKeyMap.Reserve(EntryToValueKeyMap.Num() + Count);
+		if (EntryStorage == EPCGMetadataEntryStorage::Dense)
+		{
+			DenseEntryToValueKeys.Reserve(DenseEntryToValueKeys.Num() + Count);
+		}
+		else
+		{
+			EntryToValueKeyMap.Reserve(EntryToValueKeyMap.Num() + Count);
+		}
 		if constexpr (!PCG::Private::MetadataTraits<T>::CompressData)
 		{
 			Values.Reserve(Values.Num() + Count);
@@ -884,14 +1065,21 @@ public:
 			EntryMapLock.WriteLock();
 		}
 
-		EntryToValueKeyMap.Reserve(EntryToValueKeyMap.Num() + EntryKeys.Num());
+		if (EntryStorage == EPCGMetadataEntryStorage::Dense)
+		{
+			DenseEntryToValueKeys.Reserve(DenseEntryToValueKeys.Num() + EntryKeys.Num());
+		}
+		else
+		{
+			EntryToValueKeyMap.Reserve(EntryToValueKeyMap.Num() + EntryKeys.Num());
+		}
 
 		if constexpr (!PCG::Private::MetadataTraits<T>::CompressData)
 		{
 			for (int32 i = 0; i < EntryKeys.Num(); ++i)
 			{
 				const PCGMetadataValueKey ValueKey = StartIndex + i + ValueKeyOffset;
-				EntryToValueKeyMap.Emplace(*EntryKeys[i], ValueKey);
+				SetLocalValueKey_Unsafe(*EntryKeys[i], ValueKey);
 			}
 		}
 
@@ -1103,6 +1291,14 @@ protected:
 	TArray<T> Values;
 	T DefaultValue = T{};
 	PCGMetadataValueKey ValueKeyOffset = 0;
+
+	/** Below this number of values, a linear search is cheaper than maintaining the hashed value index. */
+	static constexpr int32 ValueLookupThreshold = 32;
+
+	/** Hashed value -> index in Values, only used by types that compress their data. Covers the first NumValuesInLookup values. */
+	struct FNoValueLookup {};
+	mutable std::conditional_t<PCG::Private::MetadataTraits<T>::CompressData, TMap<T, int32>, FNoValueLookup> ValueLookup;
+	mutable int32 NumValuesInLookup = 0;
 };
 
 namespace PCGMetadataAttribute
@@ -85,10 +85,13 @@ public:
 	const UPCGMetadata* GetTopMetadata() const { return TopMetadata; }
 	UE_API bool HasParent(const FPCGMetadataDomain* InTentativeParent) const;
 
-	/** Unparents current metadata by flattening the attributes (values, entries, etc.) */
+	/**
+	 * Unparents current metadata by flattening the attributes (values, entries, etc.). The attributes are then sealed (see FPCGMetadataAttributeBase::Seal):
+	 * reads skip the entry lock until the next write, so flattened metadata must not be written while it is being read from other threads.
+	 */
 	UE_API void FlattenImpl();
 
-	/** Unparents current metadata, flatten attribute and only keep the entries specified. Return true if something has changed and keys needs be updated. */
+	/** Unparents current metadata, flatten attribute and only keep the entries specified. The attributes are then sealed, as in FlattenImpl. Return true if something has changed and keys needs be updated. */
 	UE_API bool FlattenAndCompress(const TArrayView<const PCGMetadataEntryKey>& InEntryKeysToKeep);
 
 	/** Creates an attribute given a property.
@@ -256,6 +259,9 @@ protected:
 
 	UE_API void SetLastCachedSelectorOnOwner(FName AttributeName);
 
+	/** Seals every attribute once flattened (no parent, so it only marks them), so reads of the read-only data skip the entry lock. */
+	UE_API void SealAttributes();
+
 	UPCGMetadata* TopMetadata = nullptr;
 	FPCGMetadataDomainID DomainID;
 	const FPCGMetadataDomain* Parent = nullptr;
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "PCGData.h"
+#include "Graph/IPCGGraphCache.h"
 #include "PCGNode.h" // IWYU pragma: keep
 #include "PCGGraphExecutionStateInterface.h"
 #include "Helpers/PCGAsyncState.h"
@@ -111,6 +112,9 @@ UE_API PRAGMA_ENABLE_DEPRECATION_WARNINGS
 	FPCGAsyncState AsyncState;
 	FPCGCrc DependenciesCrc;
 
+	/** Dependencies that are stable across sessions, used to store results in the disk cache. Invalid if results can't be stored there. */
+	FPCGPersistentDependencies PersistentDependencies;
+
 	// TODO: replace this by a better identification mechanism
 	const UPCGNode* Node = nullptr;
 	FPCGTaskId TaskId = InvalidPCGTaskId;
@@ -58,6 +58,9 @@ public:
 	/** Returns a Crc for this and any connected data. */
 	UE_API FPCGCrc GetOrComputeCrc(bool bFullDataCrc) const;
 
+	/** Same as GetOrComputeCrc, but a newly computed Crc is not cached, so the Crc seen by the rest of the execution is unchanged. */
+	UE_API FPCGCrc GetOrComputeCrcUncached(bool bFullDataCrc) const;
+
 	/** Executes a lambda over all connected data objects. */
 	UE_API virtual void VisitDataNetwork(TFunctionRef<void(const UPCGData*)> Action) const;
 
@@ -158,6 +161,8 @@ protected:
 	UE_API void AddUIDToCrc(FArchiveCrc32& Ar) const;
 
 private:
+	friend class FPCGGraphDiskCache;
+
 	UE_API void InitUID();
 	
 	/** If the Crc cache contains a full data Crc, if data type supports it */
@@ -210,6 +215,9 @@ struct FPCGTaggedData
 	UE_API bool operator!=(const FPCGTaggedData& Other) const;
 
 	UE_API FPCGCrc ComputeCrc(bool bFullDataCrc) const;
+
+	/** Same as ComputeCrc, but doesn't cache the data Crc (see UPCGData::GetOrComputeCrcUncached). */
+	UE_API FPCGCrc ComputeCrcUncached(bool bFullDataCrc) const;
 };
 
 USTRUCT(BlueprintType)
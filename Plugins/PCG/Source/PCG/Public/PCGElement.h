@@ -14,6 +14,7 @@ class IPCGGraphExecutionSource;
 class UPCGSettingsInterface;
 struct FPCGContext;
 struct FPCGCrc;
+struct FPCGPersistentDependencies;
 
 class IPCGElement;
 class IPCGGraphCache;
@@ -166,8 +167,24 @@ public:
 	UE_DEPRECATED(5.6, "Use/Implement version with FPCGGetDependenciesCrcParams parameter instead")
 	UE_API virtual void GetDependenciesCrc(const FPCGDataCollection& InInput, const UPCGSettings* InSettings, UPCGComponent* InComponent, FPCGCrc& OutCrc) const;
 
-	/** Gather input data (pre-context creation) and tries to retrieve matching data from the cache if the element is cacheable. */
-	UE_API EPCGCachingStatus RetrieveResultsFromCache(IPCGGraphCache* Cache, const UPCGNode* Node, const FPCGDataCollection& Input, IPCGGraphExecutionSource* ExecutionSource, FPCGDataCollection& Output, FPCGCrc* OutCrc = nullptr) const;
+	/**
+	 * Calculate dependencies that are stable across sessions, from the content of the inputs instead of their per-session Crcs. Used to key the disk cache.
+	 * Hashes the full content of the inputs, without changing the Crc cached on the input data. OutDependencies is invalid if the disk cache is disabled,
+	 * if an input can't be persisted, or if the element adds its own dependencies to InDependenciesCrc.
+	 */
+	UE_API void ComputePersistentDependencies(const FPCGGetDependenciesCrcParams& InParams, const FPCGCrc& InDependenciesCrc, FPCGPersistentDependencies& OutDependencies) const;
+
+	/**
+	 * Version of the results of the element, part of the disk cache keys. Elements should bump it when a code change alters their results,
+	 * so that entries written by previous versions are not read back.
+	 */
+	virtual uint32 GetPersistentCacheVersion() const { return 0; }
+
+	/**
+	 * Gather input data (pre-context creation) and tries to retrieve matching data from the cache if the element is cacheable.
+	 * Persistent dependencies are only computed when the results are not in the memory cache.
+	 */
+	UE_API EPCGCachingStatus RetrieveResultsFromCache(IPCGGraphCache* Cache, const UPCGNode* Node, const FPCGDataCollection& Input, IPCGGraphExecutionSource* ExecutionSource, FPCGDataCollection& Output, FPCGCrc* OutCrc = nullptr, FPCGPersistentDependencies* OutPersistentDependencies = nullptr) const;
 
 	/** Public function that executes the element on the appropriately created context.
 	* The caller should call the Execute function until it returns true.
@@ -4,6 +4,7 @@
 
 #include "PCGPoint.h"
 #include "Data/PCGPointData.h"
+#include "Utils/PCGPointSpatialIndex.h"
 
 #include "Math/Vector.h"
 #include "Templates/Function.h"
@@ -43,7 +44,7 @@ public:
 private:
 	// Blueprint functions are not exposed, use the functions above or the Octree directly
 
-	/** Query the internal octree to return all the points within some bounds. */
+	/** Query the internal octree (or the flat spatial index, see FPCGPointSpatialIndex::IsEnabledForQueries) to return all the points within some bounds. */
 	UFUNCTION(BlueprintCallable, Category = PointData)
 	static TArray<FPCGPoint> GetPointsInsideBounds(const UPCGPointData* InPointData, const FBox& InBounds);
 
@@ -84,25 +85,36 @@ void UPCGOctreeQueries::ForEachPointInsideSphere(const UPCGBasePointData* InPoin
 	const UPCGPointData* PointData = Cast<UPCGPointData>(InPointData);
 	const TArray<FPCGPoint>* Points = PointData ? &PointData->GetPoints() : nullptr;
 		
-	InPointData->GetPointOctree().FindElementsWithBoundsTest(SearchBounds, [InPointData, Points, &InCenter, SquaredRadius, Callback = std::move(Callback)](const PCGPointOctree::FPointRef& PointRef)
+	auto VisitPoint = [InPointData, Points, &InCenter, SquaredRadius, &Callback](int32 PointIndex)
 	{
-		if (!InPointData->IsValidRef(PointRef))
-		{
-			return;
-		}
-
-		const double SquaredDistance = FVector::DistSquared(InCenter, Points ? (*Points)[PointRef.Index].Transform.GetLocation() : InPointData->GetTransform(PointRef.Index).GetLocation());
+		const double SquaredDistance = FVector::DistSquared(InCenter, Points ? (*Points)[PointIndex].Transform.GetLocation() : InPointData->GetTransform(PointIndex).GetLocation());
 		if (SquaredDistance <= SquaredRadius)
 		{
 			if constexpr (std::is_invocable_v<Func, const FPCGPoint&, double>)
 			{
 				check(Points);
-				Callback((*Points)[PointRef.Index], SquaredDistance);
+				Callback((*Points)[PointIndex], SquaredDistance);
 			}
 			else
 			{
-				Callback(InPointData, PointRef.Index, SquaredDistance);
+				Callback(InPointData, PointIndex, SquaredDistance);
 			}
 		}
-	});
+	};
+
+	if (FPCGPointSpatialIndex::IsEnabledForQueries())
+	{
+		// The flat index bounds test is conservative up to float precision, the distance test above is exact.
+		InPointData->GetPointSpatialIndex().FindElementsWithBoundsTest(SearchBounds, VisitPoint);
+	}
+	else
+	{
+		InPointData->GetPointOctree().FindElementsWithBoundsTest(SearchBounds, [InPointData, &VisitPoint](const PCGPointOctree::FPointRef& PointRef)
+		{
+			if (InPointData->IsValidRef(PointRef))
+			{
+				VisitPoint(PointRef.Index);
+			}
+		});
+	}
 }
\ No newline at end of file
@@ -0,0 +1,135 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "Math/Box.h"
+#include "Math/GenericOctreePublic.h"
+#include "Math/Vector.h"
+#include "Templates/Function.h"
+
+/**
+* Flat spatial index over the density bounds of points, alternative to the point octree.
+* Points are sorted along a Morton curve of their centers and grouped in a packed bounding volume hierarchy (fixed branching factor, implicit children),
+* all built in bulk and in parallel instead of inserting points one by one.
+* Bounds are stored as floats relative to the center of the data, rounded outwards, so bounds tests are conservative: a query can return a point
+* whose bounds are outside of the query bounds by less than float precision. Callers that need exact tests must do them on the returned points.
+*/
+class FPCGPointSpatialIndex
+{
+public:
+	/** Children per node, and points per leaf. */
+	static constexpr int32 BranchingFactor = 8;
+
+	/** True if the point queries ('UPCGOctreeQueries') should use the flat index instead of the octree ('pcg.PointData.FlatSpatialIndex'). */
+	static PCG_API bool IsEnabledForQueries();
+
+	/**
+	* Builds the index. InGetPointBounds returns the density bounds of a point, and is called from multiple threads.
+	* InDataBounds must contain all the points bounds, it is used as reference for the float bounds and the Morton codes.
+	*/
+	PCG_API void Build(int32 InNumPoints, const FBox& InDataBounds, TFunctionRef<FBox(int32 PointIndex)> InGetPointBounds);
+
+	PCG_API void Reset();
+
+	/** Calls InFunc(int32 PointIndex) for all points whose bounds intersect the given bounds. Same semantic as TOctree2::FindElementsWithBoundsTest, up to float precision. */
+	template <typename Func>
+	void FindElementsWithBoundsTest(const FBoxCenterAndExtent& InBounds, Func&& InFunc) const;
+
+	int32 Num() const { return SortedPointIndices.Num(); }
+
+	/** Memory used by the index, in bytes. */
+	PCG_API SIZE_T GetAllocatedSize() const;
+
+private:
+	struct FCompactBounds
+	{
+		FVector3f Min;
+		FVector3f Max;
+
+		bool Intersect(const FCompactBounds& Other) const
+		{
+			return Min.X <= Other.Max.X && Max.X >= Other.Min.X
+				&& Min.Y <= Other.Max.Y && Max.Y >= Other.Min.Y
+				&& Min.Z <= Other.Max.Z && Max.Z >= Other.Min.Z;
+		}
+
+		void operator+=(const FCompactBounds& Other)
+		{
+			Min = FVector3f::Min(Min, Other.Min);
+			Max = FVector3f::Max(Max, Other.Max);
+		}
+	};
+
+	/** Converts bounds to float bounds relative to the origin, rounded outwards. */
+	PCG_API FCompactBounds ToCompactBounds(const FVector& InMin, const FVector& InMax) const;
+
+	int32 GetNumNodes(int32 InLevel) const { return LevelOffsets[InLevel + 1] - LevelOffsets[InLevel]; }
+
+	FVector Origin = FVector::ZeroVector;
+
+	/** Point index for each slot, in Morton order. */
+	TArray<int32> SortedPointIndices;
+
+	/** Bounds of the points, in Morton order. */
+	TArray<FCompactBounds> PointBounds;
+
+	/** Bounds of the nodes, level by level from the leaves. Node N of level L covers nodes [N * BranchingFactor, (N + 1) * BranchingFactor) of level L - 1, or points for level 0. */
+	TArray<FCompactBounds> NodeBounds;
+
+	/** Start of each level in NodeBounds, plus the end of the last level. The last level has a single node, the root. */
+	TArray<int32> LevelOffsets;
+};
+
+template <typename Func>
+void FPCGPointSpatialIndex::FindElementsWithBoundsTest(const FBoxCenterAndExtent& InBounds, Func&& InFunc) const
+{
+	if (SortedPointIndices.IsEmpty())
+	{
+		return;
+	}
+
+	const FVector Center(InBounds.Center);
+	const FVector Extent(InBounds.Extent);
+	const FCompactBounds QueryBounds = ToCompactBounds(Center - Extent, Center + Extent);
+
+	struct FStackEntry
+	{
+		int32 Level;
+		int32 Node;
+	};
+
+	TArray<FStackEntry, TInlineAllocator<64>> Stack;
+	Stack.Add({ LevelOffsets.Num() - 2, 0 });
+
+	while (!Stack.IsEmpty())
+	{
+		const FStackEntry Entry = Stack.Pop(EAllowShrinking::No);
+		if (!NodeBounds[LevelOffsets[Entry.Level] + Entry.Node].Intersect(QueryBounds))
+		{
+			continue;
+		}
+
+		const int32 FirstChild = Entry.Node * BranchingFactor;
+
+		if (Entry.Level == 0)
+		{
+			const int32 LastPoint = FMath::Min(FirstChild + BranchingFactor, SortedPointIndices.Num());
+			for (int32 Slot = FirstChild; Slot < LastPoint; ++Slot)
+			{
+				if (PointBounds[Slot].Intersect(QueryBounds))
+				{
+					InFunc(SortedPointIndices[Slot]);
+				}
+			}
+		}
+		else
+		{
+			const int32 LastChild = FMath::Min(FirstChild + BranchingFactor, GetNumNodes(Entry.Level - 1));
+			for (int32 Child = LastChild - 1; Child >= FirstChild; --Child)
+			{
+				Stack.Add({ Entry.Level - 1, Child });
+			}
+		}
+	}
+}
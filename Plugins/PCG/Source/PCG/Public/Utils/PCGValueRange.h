@@ -224,6 +224,18 @@ struct PCGValueRangeHelpers
 		return TConstPCGValueRange<ElementType>(MakeConstStridedView(InView.ElementView.GetStride(), &InView.ElementView.GetUnsafe(0), InView.Num()));
 	}
 
+	/** Returns a pointer to the underlying values if they are tightly packed in memory (no stride), nullptr otherwise. Only the first ViewNum() values are valid. */
+	template<typename ElementType, typename ViewType>
+	static ElementType* GetContiguousData(const TPCGValueRange<ElementType, ViewType>& InRange)
+	{
+		if (InRange.ElementView.Num() == 0 || InRange.ElementView.GetStride() != sizeof(ElementType))
+		{
+			return nullptr;
+		}
+
+		return &InRange.ElementView.GetUnsafe(0);
+	}
+
 	// Const -> Non-const, use it at your own risk.
 	template<typename ElementType>
 	static TPCGValueRange<ElementType> MakeValueRange_Unsafe(TConstPCGValueRange<ElementType> InView)
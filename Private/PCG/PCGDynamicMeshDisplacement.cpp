@@ -20,11 +20,15 @@
 #include "Data/PCGDynamicMeshData.h"
 #include "Elements/PCGDynamicMeshBaseElement.h"
 
-// PCG texture includes.  UPCGBaseTextureData exposes SamplePointLocal() for
-// CPU‑accessible texture sampling.  We use this interface instead of
+// PCG texture includes.  UPCGBaseTextureData exposes SampleChannelLocal() for
+// batched CPU‑accessible texture sampling.  We use this interface instead of
 // directly sampling a UTexture2D.
 #include "Data/PCGTextureData.h"
 
+// WDEditor includes.  Landscape heightfield data is displaced directly,
+// without converting it to a dynamic mesh.
+#include "PCG/PCGLandscapeHeightfieldData.h"
+
 // Geometry includes
 #include "DynamicMesh/DynamicMesh3.h"
 
@@ -36,6 +40,7 @@
 #include "UDynamicMesh.h"
 
 // Engine includes
+#include "Async/ParallelFor.h"
 #include "Math/Vector.h"
 #include "Math/UnrealMathUtility.h"
 
@@ -43,6 +48,125 @@ using UE::Geometry::FDynamicMesh3;
 
 namespace
 {
+    /**
+     * Number of vertices displaced per parallel task.  Each batch samples
+     * the texture for all of its vertices with one call per projection.
+     */
+    constexpr int32 DisplacementBatchSize = 256;
+
+    /** Displacement parameters shared by the mesh and heightfield paths. */
+    struct FDisplacementParams
+    {
+        float InvScale = 1.0f;
+        float Intensity = 1.0f;
+        float DisplacementCenter = 0.5f;
+        bool bSlopeMask = false;
+        float MinDot = 0.0f;
+        float SlopeRangeInv = 0.0f;
+        float MipLevel = 0.0f;
+    };
+
+    /**
+     * Signed displacement of one vertex.  The three triplanar alphas are
+     * blended by the normal components, remapped from [0,1] around the
+     * DisplacementCenter to [-1,1], optionally attenuated by the slope mask
+     * and scaled by the intensity.
+     */
+    static float ComputeVertexDisplacement(
+        const FDisplacementParams& Params,
+        const FVector3d& N,
+        float AlphaX, float AlphaY, float AlphaZ)
+    {
+        const float AbsNX = FMath::Abs(static_cast<float>(N.X));
+        const float AbsNY = FMath::Abs(static_cast<float>(N.Y));
+        const float AbsNZ = FMath::Abs(static_cast<float>(N.Z));
+        const float SumAbs = AbsNX + AbsNY + AbsNZ + KINDA_SMALL_NUMBER;
+        const float WNX = AbsNX / SumAbs;
+        const float WNY = AbsNY / SumAbs;
+        const float WNZ = AbsNZ / SumAbs;
+
+        // Compute a weighted alpha value using the normal weights.  Then
+        // remap from [0,1] by subtracting the user‑defined
+        // DisplacementCenter and multiplying by 2.0.  A center of 0.5
+        // yields the original behaviour; other values bias the zero
+        // displacement point.
+        const float WeightedAlpha = WNX * AlphaX + WNY * AlphaY + WNZ * AlphaZ;
+        float Height = (WeightedAlpha - Params.DisplacementCenter) * 2.0f;
+
+        if (Params.bSlopeMask)
+        {
+            const float DotUp = FMath::Clamp(static_cast<float>(N.Z), 0.0f, 1.0f);
+            float Mask = (DotUp - Params.MinDot) * Params.SlopeRangeInv;
+            Mask = FMath::Clamp(Mask, 0.0f, 1.0f);
+            Height *= Mask;
+        }
+
+        return Height * Params.Intensity;
+    }
+
+    /**
+     * Displaces a heightfield in place, one lattice row per task.  The
+     * heightfield stays a heightfield: vertices move along Z only (the mesh
+     * path moves them along the normal), then the normals are recomputed
+     * from the new heights.  Mask crossings follow their lattice edges.
+     */
+    static void DisplaceHeightfield(
+        const UPCGBaseTextureData* TexData,
+        FDisplacementParams Params,
+        WDEditor::PCG::FPCGLandscapeHeightfield& Heightfield)
+    {
+        TRACE_CPUPROFILER_EVENT_SCOPE(PCGDynamicMeshDisplacement::DisplaceHeightfield);
+
+        if (!Heightfield.IsValid())
+        {
+            return;
+        }
+
+        // Lattice vertices are CellSize apart: that is the footprint of a sample.
+        if (TexData->MipFilter != EPCGTextureMipFilter::None)
+        {
+            const double Footprint = Heightfield.CellSize * FMath::Abs(Params.InvScale);
+            Params.MipLevel = TexData->ComputeMipLevel(FVector2D(Footprint, Footprint));
+            if (Params.MipLevel > 0.0f)
+            {
+                TexData->BuildCPUMipChain();
+            }
+        }
+
+        const int32 GridX = Heightfield.GridX;
+        TArray<float> NewHeights;
+        NewHeights.SetNumUninitialized(Heightfield.NumVertices());
+
+        ParallelFor(Heightfield.GridY, [&](int32 Y)
+        {
+            // Triplanar UVs of the row: [X projection | Y projection | Z projection].
+            TArray<FVector2D> UVs;
+            UVs.SetNumUninitialized(3 * GridX);
+            for (int32 X = 0; X < GridX; ++X)
+            {
+                const FVector3d P = Heightfield.GetLocalPosition(X, Y);
+                UVs[X]             = FVector2D(static_cast<float>(P.Y * Params.InvScale), static_cast<float>(P.Z * Params.InvScale));
+                UVs[GridX + X]     = FVector2D(static_cast<float>(P.X * Params.InvScale), static_cast<float>(P.Z * Params.InvScale));
+                UVs[2 * GridX + X] = FVector2D(static_cast<float>(P.X * Params.InvScale), static_cast<float>(P.Y * Params.InvScale));
+            }
+
+            TArray<float> Alphas;
+            Alphas.SetNumUninitialized(3 * GridX);
+            TexData->SampleChannelLocal(UVs, EPCGTextureColorChannel::Alpha, Alphas, 0.0f, Params.MipLevel);
+
+            for (int32 X = 0; X < GridX; ++X)
+            {
+                const int32 Index = Heightfield.VertexIndex(X, Y);
+                const FVector3d N(Heightfield.Normals[Index]);
+                const float Disp = ComputeVertexDisplacement(Params, N, Alphas[X], Alphas[GridX + X], Alphas[2 * GridX + X]);
+                NewHeights[Index] = Heightfield.Heights[Index] + Disp;
+            }
+        });
+
+        Heightfield.Heights = MoveTemp(NewHeights);
+        WDEditor::PCG::ComputeHeightfieldNormals(Heightfield);
+    }
+
     /**
      * Implementation of the displacement element.  Derives from
      * IPCGDynamicMeshBaseElement so that we can work with dynamic mesh
@@ -91,6 +215,16 @@ TArray<FPCGPinProperties> UPCGDynamicMeshDisplacementSettings::InputPinPropertie
     // ancestor classes.
     TArray<FPCGPinProperties> Pins = Super::InputPinProperties();
 
+    // The default input pin also accepts landscape heightfield data (typed
+    // Other), which is displaced without building a general mesh.
+    for (FPCGPinProperties& Pin : Pins)
+    {
+        if (Pin.Label == PCGPinConstants::DefaultInputLabel)
+        {
+            Pin.AllowedTypes |= EPCGDataType::Other;
+        }
+    }
+
     // Add an optional pin that accepts Base Texture Data.  Setting only the
     // label and AllowedTypes ensures the PCG system treats this as an input
     // pin for texture data.  Other pin properties (PinType,
@@ -138,11 +272,20 @@ bool FPCGDynamicMeshDisplacementElement::ExecuteInternal(FPCGContext* Context) c
     }
     const float InvScale = 1.0f / Scale;
     const float Intensity = Settings->DisplacementIntensity;
+    const float DisplacementCenter = Settings->DisplacementCenter;
     const bool bSlopeMask = Settings->bEnableSlopeMask;
     const float MinDot = Settings->MinSlopeDot;
     const float MaxDot = Settings->MaxSlopeDot;
     const float SlopeRangeInv = (MaxDot - MinDot) > KINDA_SMALL_NUMBER ? 1.0f / (MaxDot - MinDot) : 0.0f;
 
+    FDisplacementParams Params;
+    Params.InvScale = InvScale;
+    Params.Intensity = Intensity;
+    Params.DisplacementCenter = DisplacementCenter;
+    Params.bSlopeMask = bSlopeMask;
+    Params.MinDot = MinDot;
+    Params.SlopeRangeInv = SlopeRangeInv;
+
     // We only want to operate on dynamic mesh inputs from the default pin.
     // Any other inputs (including texture data) are consumed and not
     // forwarded downstream.  This avoids emitting texture data on the
@@ -158,6 +301,20 @@ bool FPCGDynamicMeshDisplacementElement::ExecuteInternal(FPCGContext* Context) c
             continue;
         }
 
+        // Landscape heightfields are displaced in place on a copy, without
+        // building a general mesh.
+        if (const UPCGLandscapeHeightfieldData* InHeightfieldData = Cast<const UPCGLandscapeHeightfieldData>(Input.Data))
+        {
+            FPCGTaggedData& OutTagged = Context->OutputData.TaggedData.Add_GetRef(Input);
+            if (TexData && !FMath::IsNearlyZero(Intensity))
+            {
+                UPCGLandscapeHeightfieldData* OutHeightfieldData = CastChecked<UPCGLandscapeHeightfieldData>(InHeightfieldData->DuplicateData(Context));
+                DisplaceHeightfield(TexData, Params, OutHeightfieldData->GetMutableHeightfield());
+                OutTagged.Data = OutHeightfieldData;
+            }
+            continue;
+        }
+
         // Cast the input data to dynamic mesh data.  If the cast fails,
         // ignore this input entirely (do not forward non-mesh data on the
         // mesh output pin).
@@ -198,116 +355,172 @@ bool FPCGDynamicMeshDisplacementElement::ExecuteInternal(FPCGContext* Context) c
         }
         FDynamicMesh3& Mesh = DynMesh->GetMeshRef();
 
-        // Compute per‑vertex normals.  Accumulate face normals for each
-        // incident triangle and normalize after the accumulation.  Allocate
-        // an array sized by the max vertex ID (not count) because vertex
-        // indices in FDynamicMesh3 are not guaranteed to be contiguous.
+        // Compute per‑vertex normals.  Face normals are computed once per
+        // triangle, then each vertex gathers the normals of its incident
+        // triangles.  Both passes run in parallel; the gather sums the faces
+        // in increasing triangle ID order so the result does not depend on
+        // the number of workers.  Arrays are sized by the max vertex /
+        // triangle ID (not count) because IDs in FDynamicMesh3 are not
+        // guaranteed to be contiguous.
+        const int32 MaxVertexID = Mesh.MaxVertexID();
+        const int32 MaxTriangleID = Mesh.MaxTriangleID();
+
+        TArray<FVector3d> TriangleNormals;
         TArray<FVector3d> VertexNormals;
-        VertexNormals.SetNumZeroed(Mesh.MaxVertexID());
-        for (int32 Tid : Mesh.TriangleIndicesItr())
         {
-            if (!Mesh.IsTriangle(Tid))
+            TRACE_CPUPROFILER_EVENT_SCOPE(PCGDynamicMeshDisplacement::ComputeNormals);
+
+            TriangleNormals.SetNumUninitialized(MaxTriangleID);
+            ParallelFor(MaxTriangleID, [&Mesh, &TriangleNormals](int32 Tid)
             {
-                continue;
-            }
-            const UE::Geometry::FIndex3i Tri = Mesh.GetTriangle(Tid);
-            const FVector3d A = Mesh.GetVertex(Tri.A);
-            const FVector3d B = Mesh.GetVertex(Tri.B);
-            const FVector3d C = Mesh.GetVertex(Tri.C);
-            FVector3d TriNormal = FVector3d::CrossProduct(B - A, C - A);
-            const double LenSq = TriNormal.SquaredLength();
-            if (LenSq > 0.0)
+                FVector3d TriNormal = FVector3d::ZeroVector;
+                if (Mesh.IsTriangle(Tid))
+                {
+                    const UE::Geometry::FIndex3i Tri = Mesh.GetTriangle(Tid);
+                    const FVector3d A = Mesh.GetVertex(Tri.A);
+                    const FVector3d B = Mesh.GetVertex(Tri.B);
+                    const FVector3d C = Mesh.GetVertex(Tri.C);
+                    TriNormal = FVector3d::CrossProduct(B - A, C - A);
+                    const double LenSq = TriNormal.SquaredLength();
+                    TriNormal = (LenSq > 0.0) ? TriNormal / FMath::Sqrt(LenSq) : FVector3d::ZeroVector;
+                }
+                TriangleNormals[Tid] = TriNormal;
+            }, MaxTriangleID < DisplacementBatchSize ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+
+            VertexNormals.SetNumUninitialized(MaxVertexID);
+            ParallelFor(MaxVertexID, [&Mesh, &TriangleNormals, &VertexNormals](int32 Vid)
             {
-                TriNormal /= FMath::Sqrt(LenSq);
-                VertexNormals[Tri.A] += TriNormal;
-                VertexNormals[Tri.B] += TriNormal;
-                VertexNormals[Tri.C] += TriNormal;
-            }
+                FVector3d N = FVector3d::ZeroVector;
+                if (Mesh.IsVertex(Vid))
+                {
+                    TArray<int32, TInlineAllocator<16>> VertexTriangles;
+                    Mesh.EnumerateVertexTriangles(Vid, [&VertexTriangles](int32 Tid) { VertexTriangles.Add(Tid); });
+                    VertexTriangles.Sort();
+
+                    for (int32 Tid : VertexTriangles)
+                    {
+                        N += TriangleNormals[Tid];
+                    }
+
+                    const double Len = N.Length();
+                    N = (Len > SMALL_NUMBER) ? N / Len : FVector3d(0.0, 0.0, 1.0);
+                }
+                VertexNormals[Vid] = N;
+            }, MaxVertexID < DisplacementBatchSize ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
         }
-        for (int32 Vid : Mesh.VertexIndicesItr())
+
+        // Apply displacement to the vertices, in batches of
+        // DisplacementBatchSize vertices across workers.  For each batch we
+        // compute triplanar UVs from the world positions scaled by InvScale,
+        // sample the alpha channel of the three projections with the batched
+        // texture API (failed samples return 0), blend by the normal
+        // components, remap to [−1,1], optionally apply the slope mask, and
+        // scale by Intensity.  New positions are written to a separate array
+        // and applied to the mesh afterwards, since SetVertex is not thread
+        // safe.
+        // Texture footprint of one sample: the mean edge length in UV
+        // units.  Only used when the texture data has mip filtering enabled
+        // (Get Texture Data > Mip Filter), where vertices spaced much wider
+        // than the texels read from a coarser mip level instead of aliasing.
+        float MipLevel = 0.0f;
+        if (TexData->MipFilter != EPCGTextureMipFilter::None && Mesh.EdgeCount() > 0)
         {
-            FVector3d& N = VertexNormals[Vid];
-            const double Len = N.Length();
-            if (Len > SMALL_NUMBER)
+            double EdgeLengthSum = 0.0;
+            for (int32 Eid : Mesh.EdgeIndicesItr())
             {
-                N /= Len;
-            }
-            else
-            {
-                N = FVector3d(0.0, 0.0, 1.0);
+                const UE::Geometry::FIndex2i EdgeV = Mesh.GetEdgeV(Eid);
+                EdgeLengthSum += FVector3d::Distance(Mesh.GetVertex(EdgeV.A), Mesh.GetVertex(EdgeV.B));
             }
+
+            const double Footprint = (EdgeLengthSum / Mesh.EdgeCount()) * FMath::Abs(InvScale);
+            MipLevel = TexData->ComputeMipLevel(FVector2D(Footprint, Footprint));
         }
 
-        // Lambda to sample the alpha channel from the texture data.  UVs
-        // passed are in local 0..1 space derived from world coordinates and
-        // projection size.  If sampling fails, returns 0.
-        auto SampleAlpha = [&](float U, float V) -> float
-        {
-            FVector4 OutColor;
-            float OutDensity;
-            if (TexData->SamplePointLocal(FVector2D(U, V), OutColor, OutDensity))
-            {
-                return static_cast<float>(OutColor.W);
-            }
-            return 0.0f;
-        };
-
-        // Apply displacement to each vertex.  For each vertex we compute
-        // triplanar UVs from its world position scaled by InvScale, sample
-        // the height along each axis, blend by the normal components, remap
-        // to [−1,1], optionally apply slope mask, and scale by Intensity.
-        for (int32 Vid : Mesh.VertexIndicesItr())
+        TArray<FVector3d> NewPositions;
         {
-            if (!Mesh.IsVertex(Vid))
-            {
-                continue;
-            }
-            FVector3d P = Mesh.GetVertex(Vid);
-            const FVector3d& N = VertexNormals[Vid];
-
-            // Compute local UVs for each projection axis.  P is in world
-            // coordinates; multiply by InvScale to normalize.  Use
-            // components as per triplanar mapping.
-            const float Ux = static_cast<float>(P.Y * InvScale);
-            const float Vx = static_cast<float>(P.Z * InvScale);
-            const float Uy = static_cast<float>(P.X * InvScale);
-            const float Vy = static_cast<float>(P.Z * InvScale);
-            const float Uz = static_cast<float>(P.X * InvScale);
-            const float Vz = static_cast<float>(P.Y * InvScale);
-
-            const float AlphaX = SampleAlpha(Ux, Vx);
-            const float AlphaY = SampleAlpha(Uy, Vy);
-            const float AlphaZ = SampleAlpha(Uz, Vz);
-
-            const float AbsNX = FMath::Abs(static_cast<float>(N.X));
-            const float AbsNY = FMath::Abs(static_cast<float>(N.Y));
-            const float AbsNZ = FMath::Abs(static_cast<float>(N.Z));
-            const float SumAbs = AbsNX + AbsNY + AbsNZ + KINDA_SMALL_NUMBER;
-            const float WNX = AbsNX / SumAbs;
-            const float WNY = AbsNY / SumAbs;
-            const float WNZ = AbsNZ / SumAbs;
-
-            // Compute a weighted alpha value using the normal weights.  Then
-            // remap from [0,1] by subtracting the user‑defined
-            // DisplacementCenter and multiplying by 2.0.  A center of 0.5
-            // yields the original behaviour; other values bias the zero
-            // displacement point.
-            float WeightedAlpha = WNX * AlphaX + WNY * AlphaY + WNZ * AlphaZ;
-            float Height = (WeightedAlpha - Settings->DisplacementCenter) * 2.0f;
-
-            if (bSlopeMask)
+            TRACE_CPUPROFILER_EVENT_SCOPE(PCGDynamicMeshDisplacement::Displace);
+
+            NewPositions.SetNumUninitialized(MaxVertexID);
+
+            const int32 NumBatches = FMath::DivideAndRoundUp(MaxVertexID, DisplacementBatchSize);
+            TArray<bool> BatchMoved;
+            BatchMoved.SetNumZeroed(NumBatches);
+
+            if (MipLevel > 0.0f)
             {
-                const float DotUp = FMath::Clamp(static_cast<float>(N.Z), 0.0f, 1.0f);
-                float Mask = (DotUp - MinDot) * SlopeRangeInv;
-                Mask = FMath::Clamp(Mask, 0.0f, 1.0f);
-                Height *= Mask;
+                TexData->BuildCPUMipChain();
             }
 
-            const float Disp = Height * Intensity;
-            if (!FMath::IsNearlyZero(Disp))
+            ParallelFor(NumBatches, [&](int32 BatchIndex)
+            {
+                const int32 StartVid = BatchIndex * DisplacementBatchSize;
+                const int32 EndVid = FMath::Min(StartVid + DisplacementBatchSize, MaxVertexID);
+
+                // Triplanar UVs of the batch: [X projection | Y projection | Z projection].
+                TArray<int32, TInlineAllocator<DisplacementBatchSize>> Vids;
+                TArray<FVector2D, TInlineAllocator<3 * DisplacementBatchSize>> UVs;
+                for (int32 Vid = StartVid; Vid < EndVid; ++Vid)
+                {
+                    if (Mesh.IsVertex(Vid))
+                    {
+                        Vids.Add(Vid);
+                    }
+                }
+
+                const int32 NumVids = Vids.Num();
+                UVs.SetNumUninitialized(3 * NumVids);
+                for (int32 i = 0; i < NumVids; ++i)
+                {
+                    // Use components as per triplanar mapping.  UVs are
+                    // computed in float, as the per-vertex sampling did.
+                    const FVector3d P = Mesh.GetVertex(Vids[i]);
+                    UVs[i]               = FVector2D(static_cast<float>(P.Y * InvScale), static_cast<float>(P.Z * InvScale));
+                    UVs[NumVids + i]     = FVector2D(static_cast<float>(P.X * InvScale), static_cast<float>(P.Z * InvScale));
+                    UVs[2 * NumVids + i] = FVector2D(static_cast<float>(P.X * InvScale), static_cast<float>(P.Y * InvScale));
+                }
+
+                TArray<float, TInlineAllocator<3 * DisplacementBatchSize>> Alphas;
+                Alphas.SetNumUninitialized(3 * NumVids);
+                TexData->SampleChannelLocal(UVs, EPCGTextureColorChannel::Alpha, Alphas, 0.0f, MipLevel);
+
+                for (int32 i = 0; i < NumVids; ++i)
+                {
+                    const int32 Vid = Vids[i];
+                    const FVector3d& N = VertexNormals[Vid];
+
+                    const float AlphaX = Alphas[i];
+                    const float AlphaY = Alphas[NumVids + i];
+                    const float AlphaZ = Alphas[2 * NumVids + i];
+
+                    const float Disp = ComputeVertexDisplacement(Params, N, AlphaX, AlphaY, AlphaZ);
+                    if (!FMath::IsNearlyZero(Disp))
+                    {
+                        NewPositions[Vid] = Mesh.GetVertex(Vid) + N * static_cast<double>(Disp);
+                        BatchMoved[BatchIndex] = true;
+                    }
+                    else
+                    {
+                        NewPositions[Vid] = Mesh.GetVertex(Vid);
+                    }
+                }
+            });
+
+            for (int32 BatchIndex = 0; BatchIndex < NumBatches; ++BatchIndex)
             {
-                P += N * static_cast<double>(Disp);
-                Mesh.SetVertex(Vid, P);
+                if (!BatchMoved[BatchIndex])
+                {
+                    continue;
+                }
+
+                const int32 StartVid = BatchIndex * DisplacementBatchSize;
+                const int32 EndVid = FMath::Min(StartVid + DisplacementBatchSize, MaxVertexID);
+                for (int32 Vid = StartVid; Vid < EndVid; ++Vid)
+                {
+                    if (Mesh.IsVertex(Vid))
+                    {
+                        Mesh.SetVertex(Vid, NewPositions[Vid]);
+                    }
+                }
             }
         }
 
@@ -0,0 +1,115 @@
+// Copyright BULKHEAD Limited. All Rights Reserved.
+
+// Implements the Dynamic Mesh PN Subdivision PCG node.  Each input mesh is
+// refined in place with ApplyPNSubdivideInterior, constrained on its open
+// boundary (and optionally its polygroup boundaries).
+
+#include "PCG/PCGDynamicMeshPNSubdivision.h"
+
+/* WDEditor */
+#include "PCG/PCGLandscapeHeightfieldData.h"
+#include "PCG/PCGLandscapeMeshSubdivision.h"
+
+/* PCG */
+#include "PCGContext.h"
+#include "PCGModule.h"
+#include "PCGPin.h"
+#include "Data/PCGDynamicMeshData.h"
+#include "Elements/PCGDynamicMeshBaseElement.h"
+
+/* Geometry */
+#include "DynamicMesh/DynamicMesh3.h"
+#include "UDynamicMesh.h"
+
+using UE::Geometry::FDynamicMesh3;
+
+namespace
+{
+    class FPCGDynamicMeshPNSubdivisionElement final : public IPCGDynamicMeshBaseElement
+    {
+    protected:
+        virtual bool ExecuteInternal(FPCGContext* Context) const override;
+    };
+}
+
+UPCGDynamicMeshPNSubdivisionSettings::UPCGDynamicMeshPNSubdivisionSettings() = default;
+
+FPCGElementPtr UPCGDynamicMeshPNSubdivisionSettings::CreateElement() const
+{
+    return MakeShared<FPCGDynamicMeshPNSubdivisionElement>();
+}
+
+TArray<FPCGPinProperties> UPCGDynamicMeshPNSubdivisionSettings::InputPinProperties() const
+{
+    TArray<FPCGPinProperties> Pins = Super::InputPinProperties();
+    for (FPCGPinProperties& Pin : Pins)
+    {
+        if (Pin.Label == PCGPinConstants::DefaultInputLabel)
+        {
+            Pin.AllowedTypes |= EPCGDataType::Other;
+        }
+    }
+    return Pins;
+}
+
+bool FPCGDynamicMeshPNSubdivisionElement::ExecuteInternal(FPCGContext* Context) const
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FPCGDynamicMeshPNSubdivisionElement::ExecuteInternal);
+
+    check(Context);
+
+    const UPCGDynamicMeshPNSubdivisionSettings* Settings = Context->GetInputSettings<UPCGDynamicMeshPNSubdivisionSettings>();
+    if (!Settings)
+    {
+        return true;
+    }
+
+    WDEditor::PCG::FPCGLandscapePNSubdivideSettings SubdivideSettings;
+    SubdivideSettings.SubdivisionLevels = FMath::Max(0, Settings->SubdivisionLevels);
+    SubdivideSettings.PNStrength = Settings->PNStrength;
+    SubdivideSettings.ConstraintGuardRing = FMath::Max(0, Settings->ConstraintGuardRing);
+    SubdivideSettings.bRequireNeighborAgreement = Settings->bRequireNeighborAgreement;
+    SubdivideSettings.bRecomputeNormalsEachLevel = Settings->bRecomputeNormalsEachLevel;
+    SubdivideSettings.bEnsureNormalOverlay = true;
+
+    for (const FPCGTaggedData& Input : Context->InputData.GetInputsByPin(PCGPinConstants::DefaultInputLabel))
+    {
+        // Subdivision needs a general mesh: heightfield inputs are converted here
+        UPCGDynamicMeshData* OutMeshData = nullptr;
+        if (const UPCGLandscapeHeightfieldData* HeightfieldData = Cast<const UPCGLandscapeHeightfieldData>(Input.Data))
+        {
+            OutMeshData = HeightfieldData->CreateDynamicMeshData(Context);
+        }
+        else if (Cast<const UPCGDynamicMeshData>(Input.Data))
+        {
+            OutMeshData = CopyOrSteal(Input, Context);
+        }
+
+        if (!OutMeshData)
+        {
+            continue;
+        }
+
+        FPCGTaggedData& OutTagged = Context->OutputData.TaggedData.Add_GetRef(Input);
+        OutTagged.Data = OutMeshData;
+
+        UDynamicMesh* DynMesh = OutMeshData->GetMutableDynamicMesh();
+        if (!DynMesh || SubdivideSettings.SubdivisionLevels == 0)
+        {
+            continue;
+        }
+
+        FDynamicMesh3& Mesh = DynMesh->GetMeshRef();
+
+        WDEditor::PCG::FPCGLandscapeMeshConstraints Constraints;
+        WDEditor::PCG::BuildBoundaryConstraints(Mesh, Settings->bConstrainPolygroupBoundaries, Constraints);
+
+        WDEditor::PCG::FPCGLandscapeSubdivisionStats Stats;
+        WDEditor::PCG::ApplyPNSubdivideInterior(Mesh, Constraints, SubdivideSettings, &Stats);
+
+        UE_LOG(LogPCG, Verbose, TEXT("[DynamicMeshPNSubdivision] %d levels: %d triangles refined, +%d vertices, +%d triangles"),
+            Stats.NumLevels, Stats.NumTrianglesRefined, Stats.NumVerticesAdded, Stats.NumTrianglesAdded);
+    }
+
+    return true;
+}
@@ -0,0 +1,200 @@
+// Copyright BULKHEAD Limited. All Rights Reserved.
+
+#include "PCG/PCGLandscapeHeightfield.h"
+
+/* Core */
+#include "Async/ParallelFor.h"
+#include "Math/UnrealMathUtility.h"
+
+namespace WDEditor::PCG
+{
+namespace Heightfield_Internal
+{
+	/** Below this many rows a parallel pass runs on the calling thread. */
+	constexpr int32 MinParallelRows = 64;
+
+	static FORCEINLINE EParallelForFlags GetParallelFlags(int32 NumRows)
+	{
+		return (NumRows < MinParallelRows) ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None;
+	}
+}
+
+	FIntRect ComputeHeightfieldCropCells(const FPCGLandscapeHeightfield& Heightfield, const FBox2D& CropBoundsXY)
+	{
+		if (Heightfield.GridX < 2 || Heightfield.GridY < 2 || !CropBoundsXY.bIsValid || Heightfield.CellSize <= 0.0)
+		{
+			return FIntRect();
+		}
+
+		// Cell X is kept when its open span (GridMin + X * CellSize, GridMin + (X + 1) * CellSize) overlaps the
+		// bounds: the cells that can hold a triangle centroid inside them
+		const double CellSize = Heightfield.CellSize;
+		const int32 MinX = FMath::FloorToInt32((CropBoundsXY.Min.X - Heightfield.GridMinXY.X) / CellSize);
+		const int32 MinY = FMath::FloorToInt32((CropBoundsXY.Min.Y - Heightfield.GridMinXY.Y) / CellSize);
+		const int32 MaxX = FMath::CeilToInt32((CropBoundsXY.Max.X - Heightfield.GridMinXY.X) / CellSize);
+		const int32 MaxY = FMath::CeilToInt32((CropBoundsXY.Max.Y - Heightfield.GridMinXY.Y) / CellSize);
+
+		const FIntRect Cells(
+			FMath::Clamp(MinX, 0, Heightfield.NumCellsX()),
+			FMath::Clamp(MinY, 0, Heightfield.NumCellsY()),
+			FMath::Clamp(MaxX, 0, Heightfield.NumCellsX()),
+			FMath::Clamp(MaxY, 0, Heightfield.NumCellsY()));
+
+		return (Cells.Width() > 0 && Cells.Height() > 0) ? Cells : FIntRect();
+	}
+
+	bool CropHeightfield(FPCGLandscapeHeightfield& Heightfield, const FIntRect& InCells)
+	{
+		if (!Heightfield.IsValid())
+		{
+			return false;
+		}
+
+		FIntRect Cells(
+			FMath::Clamp(InCells.Min.X, 0, Heightfield.NumCellsX()),
+			FMath::Clamp(InCells.Min.Y, 0, Heightfield.NumCellsY()),
+			FMath::Clamp(InCells.Max.X, 0, Heightfield.NumCellsX()),
+			FMath::Clamp(InCells.Max.Y, 0, Heightfield.NumCellsY()));
+
+		if (Cells.Width() <= 0 || Cells.Height() <= 0)
+		{
+			Heightfield.Reset();
+			return false;
+		}
+
+		if (Cells.Min == FIntPoint::ZeroValue && Cells.Max == FIntPoint(Heightfield.NumCellsX(), Heightfield.NumCellsY()))
+		{
+			return true;
+		}
+
+		const FPCGLandscapeHeightfield& Source = Heightfield;
+		const int32 NewGridX = Cells.Width() + 1;
+		const int32 NewGridY = Cells.Height() + 1;
+
+		TArray<float> Heights;
+		TArray<FVector3f> Normals;
+		Heights.SetNumUninitialized(NewGridX * NewGridY);
+		Normals.SetNumUninitialized(NewGridX * NewGridY);
+
+		ParallelFor(NewGridY, [&](int32 Y)
+		{
+			const int32 SourceIndex = Source.VertexIndex(Cells.Min.X, Cells.Min.Y + Y);
+			FMemory::Memcpy(&Heights[Y * NewGridX], &Source.Heights[SourceIndex], NewGridX * sizeof(float));
+			FMemory::Memcpy(&Normals[Y * NewGridX], &Source.Normals[SourceIndex], NewGridX * sizeof(FVector3f));
+		}, Heightfield_Internal::GetParallelFlags(NewGridY));
+
+		TBitArray<> Solid(false, NewGridX * NewGridY);
+		for (int32 Y = 0; Y < NewGridY; ++Y)
+		{
+			const int32 SourceIndex = Source.VertexIndex(Cells.Min.X, Cells.Min.Y + Y);
+			for (int32 X = 0; X < NewGridX; ++X)
+			{
+				Solid[X + Y * NewGridX] = Source.Solid[SourceIndex + X];
+			}
+		}
+
+		// Boundary cells stay in ascending order: the new cell index grows with the old one
+		TArray<FPCGLandscapeHeightfieldBoundaryCell> BoundaryCells;
+		for (const FPCGLandscapeHeightfieldBoundaryCell& Cell : Source.BoundaryCells)
+		{
+			const int32 X = Cell.CellIndex % Source.NumCellsX() - Cells.Min.X;
+			const int32 Y = Cell.CellIndex / Source.NumCellsX() - Cells.Min.Y;
+			if (X >= 0 && X < Cells.Width() && Y >= 0 && Y < Cells.Height())
+			{
+				FPCGLandscapeHeightfieldBoundaryCell& NewCell = BoundaryCells.Add_GetRef(Cell);
+				NewCell.CellIndex = X + Y * Cells.Width();
+			}
+		}
+
+		FIntRect CropCells = Heightfield.CropCells;
+		CropCells.Clip(Cells);
+		CropCells -= Cells.Min;
+
+		Heightfield.GridMinXY += FVector2D(Cells.Min) * Heightfield.CellSize;
+		Heightfield.GridX = NewGridX;
+		Heightfield.GridY = NewGridY;
+		Heightfield.Heights = MoveTemp(Heights);
+		Heightfield.Normals = MoveTemp(Normals);
+		Heightfield.Solid = MoveTemp(Solid);
+		Heightfield.BoundaryCells = MoveTemp(BoundaryCells);
+		Heightfield.CropCells = CropCells;
+
+		return true;
+	}
+
+	bool CropHeightfield(FPCGLandscapeHeightfield& Heightfield, const FBox2D& CropBoundsXY)
+	{
+		const FIntRect Cells = ComputeHeightfieldCropCells(Heightfield, CropBoundsXY);
+		if (Cells.Width() <= 0 || Cells.Height() <= 0)
+		{
+			Heightfield.Reset();
+			return false;
+		}
+
+		if (Heightfield.CropBoundsXY.bIsValid)
+		{
+			FBox2D& Bounds = Heightfield.CropBoundsXY;
+			Bounds.Min = FVector2D(FMath::Max(Bounds.Min.X, CropBoundsXY.Min.X), FMath::Max(Bounds.Min.Y, CropBoundsXY.Min.Y));
+			Bounds.Max = FVector2D(FMath::Min(Bounds.Max.X, CropBoundsXY.Max.X), FMath::Min(Bounds.Max.Y, CropBoundsXY.Max.Y));
+		}
+		else
+		{
+			Heightfield.CropBoundsXY = CropBoundsXY;
+		}
+
+		return CropHeightfield(Heightfield, Cells);
+	}
+
+	void ComputeHeightfieldNormals(FPCGLandscapeHeightfield& Heightfield)
+	{
+		if (!Heightfield.IsValid())
+		{
+			return;
+		}
+
+		const int32 GridX = Heightfield.GridX;
+		const int32 GridY = Heightfield.GridY;
+		const double CellSize = Heightfield.CellSize;
+		const TArray<float>& Heights = Heightfield.Heights;
+		TArray<FVector3f>& Normals = Heightfield.Normals;
+
+		ParallelFor(GridY, [&](int32 Y)
+		{
+			const int32 Y0 = FMath::Max(Y - 1, 0);
+			const int32 Y1 = FMath::Min(Y + 1, GridY - 1);
+
+			for (int32 X = 0; X < GridX; ++X)
+			{
+				const int32 X0 = FMath::Max(X - 1, 0);
+				const int32 X1 = FMath::Min(X + 1, GridX - 1);
+
+				const double DzDx = ((double)Heights[X1 + Y * GridX] - (double)Heights[X0 + Y * GridX]) / ((X1 - X0) * CellSize);
+				const double DzDy = ((double)Heights[X + Y1 * GridX] - (double)Heights[X + Y0 * GridX]) / ((Y1 - Y0) * CellSize);
+
+				FVector3d N(-DzDx, -DzDy, 1.0);
+				if (!N.Normalize())
+				{
+					N = FVector3d::UpVector;
+				}
+				Normals[X + Y * GridX] = FVector3f(N);
+			}
+		}, Heightfield_Internal::GetParallelFlags(GridY));
+	}
+
+	bool ComputeHeightfieldHeightRange(const FPCGLandscapeHeightfield& Heightfield, float& OutMin, float& OutMax)
+	{
+		if (Heightfield.Heights.IsEmpty())
+		{
+			return false;
+		}
+
+		OutMin = TNumericLimits<float>::Max();
+		OutMax = TNumericLimits<float>::Lowest();
+		for (const float Height : Heightfield.Heights)
+		{
+			OutMin = FMath::Min(OutMin, Height);
+			OutMax = FMath::Max(OutMax, Height);
+		}
+		return true;
+	}
+}
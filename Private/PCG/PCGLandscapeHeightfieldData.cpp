@@ -0,0 +1,256 @@
+// Copyright BULKHEAD Limited. All Rights Reserved.
+
+#include "PCG/PCGLandscapeHeightfieldData.h"
+
+/* WDEditor */
+#include "PCG/PCGLandscapeMeshBuilder.h"
+
+/* PCG */
+#include "PCGContext.h"
+#include "PCGPoint.h"
+#include "Data/PCGPointArrayData.h"
+#include "Data/PCGPointData.h"
+
+/* PCG GeometryScript Interop */
+#include "Data/PCGDynamicMeshData.h"
+
+/* Engine */
+#include "Materials/MaterialInterface.h"
+#include "Serialization/ArchiveCrc32.h"
+
+/* Geometry */
+#include "DynamicMesh/DynamicMesh3.h"
+#include "UDynamicMesh.h"
+
+namespace
+{
+	void SerializeHeightfield(FArchive& Ar, WDEditor::PCG::FPCGLandscapeHeightfield& Heightfield)
+	{
+		Ar << Heightfield.GridX;
+		Ar << Heightfield.GridY;
+		Ar << Heightfield.GridMinXY;
+		Ar << Heightfield.CellSize;
+		Ar << Heightfield.OriginXY;
+		Ar << Heightfield.Heights;
+		Ar << Heightfield.Normals;
+		Ar << Heightfield.Solid;
+		Ar << Heightfield.CropCells;
+		Ar << Heightfield.CropBoundsXY;
+		Ar << Heightfield.bIncludePadding;
+		Ar << Heightfield.bUseMarchingSquares;
+		Ar << Heightfield.bSolidQuadsUseDiagBLtoTR;
+		Ar << Heightfield.PaddingPolygroupID;
+
+		int32 NumBoundaryCells = Heightfield.BoundaryCells.Num();
+		Ar << NumBoundaryCells;
+		if (Ar.IsLoading())
+		{
+			Heightfield.BoundaryCells.SetNum(NumBoundaryCells);
+		}
+
+		for (WDEditor::PCG::FPCGLandscapeHeightfieldBoundaryCell& Cell : Heightfield.BoundaryCells)
+		{
+			Ar << Cell.CellIndex;
+			for (float& T : Cell.EdgeT)
+			{
+				Ar << T;
+			}
+		}
+	}
+}
+
+void UPCGLandscapeHeightfieldData::Initialize(WDEditor::PCG::FPCGLandscapeHeightfield&& InHeightfield, UMaterialInterface* InMaterial)
+{
+	Heightfield = MoveTemp(InHeightfield);
+	Material = InMaterial;
+
+	GetMutableHeightfield();
+}
+
+WDEditor::PCG::FPCGLandscapeHeightfield& UPCGLandscapeHeightfieldData::GetMutableHeightfield()
+{
+	bBoundsAreDirty = true;
+
+	{
+		FScopeLock Lock(&CachedMeshDataLock);
+		CachedMeshData = nullptr;
+	}
+
+	return Heightfield;
+}
+
+UPCGDynamicMeshData* UPCGLandscapeHeightfieldData::CreateDynamicMeshData(FPCGContext* Context) const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UPCGLandscapeHeightfieldData::CreateDynamicMeshData);
+
+	UE::Geometry::FDynamicMesh3 Mesh;
+	WDEditor::PCG::BuildMeshFromHeightfield(Heightfield, Mesh);
+
+	TArray<UMaterialInterface*> Materials;
+	if (Material)
+	{
+		Materials.Add(Material);
+	}
+
+	UPCGDynamicMeshData* MeshData = FPCGContext::NewObject_AnyThread<UPCGDynamicMeshData>(Context);
+	MeshData->Initialize(MoveTemp(Mesh), Materials);
+	return MeshData;
+}
+
+const UPCGDynamicMeshData* UPCGLandscapeHeightfieldData::ToDynamicMeshData(FPCGContext* Context) const
+{
+	FScopeLock Lock(&CachedMeshDataLock);
+
+	if (!CachedMeshData)
+	{
+		CachedMeshData = CreateDynamicMeshData(Context);
+	}
+
+	return CachedMeshData;
+}
+
+void UPCGLandscapeHeightfieldData::Serialize(FArchive& Ar)
+{
+	Super::Serialize(Ar);
+
+	SerializeHeightfield(Ar, Heightfield);
+
+	if (Ar.IsLoading())
+	{
+		bBoundsAreDirty = true;
+	}
+}
+
+void UPCGLandscapeHeightfieldData::GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize)
+{
+	Super::GetResourceSizeEx(CumulativeResourceSize);
+
+	CumulativeResourceSize.AddDedicatedSystemMemoryBytes(Heightfield.GetAllocatedSize());
+
+	// The cached mesh lives as long as this data, and is usually several times the size of the heightfield
+	FScopeLock Lock(&CachedMeshDataLock);
+	if (CachedMeshData)
+	{
+		CachedMeshData->GetResourceSizeEx(CumulativeResourceSize);
+
+		if (const UDynamicMesh* DynamicMesh = CachedMeshData->GetDynamicMesh())
+		{
+			DynamicMesh->ProcessMesh([&CumulativeResourceSize](const UE::Geometry::FDynamicMesh3& Mesh)
+			{
+				CumulativeResourceSize.AddDedicatedSystemMemoryBytes(Mesh.GetByteCount());
+			});
+		}
+	}
+}
+
+void UPCGLandscapeHeightfieldData::AddToCrc(FArchiveCrc32& Ar, bool bFullDataCrc) const
+{
+	Super::AddToCrc(Ar, bFullDataCrc);
+
+	if (bFullDataCrc)
+	{
+		FString ClassName = StaticClass()->GetPathName();
+		Ar << ClassName;
+
+		SerializeHeightfield(Ar, const_cast<WDEditor::PCG::FPCGLandscapeHeightfield&>(Heightfield));
+	}
+	else
+	{
+		AddUIDToCrc(Ar);
+	}
+}
+
+FBox UPCGLandscapeHeightfieldData::GetBounds() const
+{
+	if (bBoundsAreDirty)
+	{
+		BoundsLock.Lock();
+		if (bBoundsAreDirty)
+		{
+			ResetBounds();
+		}
+		BoundsLock.Unlock();
+	}
+
+	return CachedBounds;
+}
+
+void UPCGLandscapeHeightfieldData::ResetBounds() const
+{
+	CachedBounds = FBox(EForceInit::ForceInit);
+
+	float MinHeight = 0.0f;
+	float MaxHeight = 0.0f;
+	if (Heightfield.IsValid() && WDEditor::PCG::ComputeHeightfieldHeightRange(Heightfield, MinHeight, MaxHeight))
+	{
+		const FVector3d Min = Heightfield.GetLocalPosition(0, 0);
+		const FVector3d Max = Heightfield.GetLocalPosition(Heightfield.GridX - 1, Heightfield.GridY - 1);
+		CachedBounds = FBox(FVector(Min.X, Min.Y, MinHeight), FVector(Max.X, Max.Y, MaxHeight));
+	}
+
+	bBoundsAreDirty = false;
+}
+
+bool UPCGLandscapeHeightfieldData::SamplePoint(const FTransform& InTransform, const FBox& InBounds, FPCGPoint& OutPoint, UPCGMetadata* OutMetadata) const
+{
+	if (!Heightfield.IsValid())
+	{
+		return false;
+	}
+
+	// Lattice coordinates of the sample (local XY, as the built mesh)
+	const FVector Location = InTransform.GetLocation();
+	const double U = (Location.X + Heightfield.OriginXY.X - Heightfield.GridMinXY.X) / Heightfield.CellSize;
+	const double V = (Location.Y + Heightfield.OriginXY.Y - Heightfield.GridMinXY.Y) / Heightfield.CellSize;
+
+	if (U < 0.0 || V < 0.0 || U > Heightfield.GridX - 1 || V > Heightfield.GridY - 1)
+	{
+		return false;
+	}
+
+	// Solid where the nearest lattice vertex is solid (marching squares cells are approximated)
+	if (!Heightfield.Solid[Heightfield.VertexIndex(FMath::RoundToInt32(U), FMath::RoundToInt32(V))])
+	{
+		return false;
+	}
+
+	const int32 CellX = FMath::Min(FMath::FloorToInt32(U), Heightfield.NumCellsX() - 1);
+	const int32 CellY = FMath::Min(FMath::FloorToInt32(V), Heightfield.NumCellsY() - 1);
+	const double FracX = U - CellX;
+	const double FracY = V - CellY;
+
+	const float H00 = Heightfield.Heights[Heightfield.VertexIndex(CellX,     CellY)];
+	const float H10 = Heightfield.Heights[Heightfield.VertexIndex(CellX + 1, CellY)];
+	const float H01 = Heightfield.Heights[Heightfield.VertexIndex(CellX,     CellY + 1)];
+	const float H11 = Heightfield.Heights[Heightfield.VertexIndex(CellX + 1, CellY + 1)];
+
+	const double Height = FMath::BiLerp((double)H00, (double)H10, (double)H01, (double)H11, FracX, FracY);
+
+	OutPoint.Transform = InTransform;
+	OutPoint.Transform.SetLocation(FVector(Location.X, Location.Y, Height));
+	OutPoint.SetLocalBounds(InBounds);
+	OutPoint.Density = 1.0f;
+	return true;
+}
+
+const UPCGPointData* UPCGLandscapeHeightfieldData::ToPointData(FPCGContext* Context, const FBox& InBounds) const
+{
+	const UPCGDynamicMeshData* MeshData = ToDynamicMeshData(Context);
+	return MeshData ? MeshData->ToPointData(Context, InBounds) : nullptr;
+}
+
+const UPCGPointArrayData* UPCGLandscapeHeightfieldData::ToPointArrayData(FPCGContext* Context, const FBox& InBounds) const
+{
+	const UPCGDynamicMeshData* MeshData = ToDynamicMeshData(Context);
+	return MeshData ? MeshData->ToPointArrayData(Context, InBounds) : nullptr;
+}
+
+UPCGSpatialData* UPCGLandscapeHeightfieldData::CopyInternal(FPCGContext* Context) const
+{
+	UPCGLandscapeHeightfieldData* NewData = FPCGContext::NewObject_AnyThread<UPCGLandscapeHeightfieldData>(Context);
+
+	WDEditor::PCG::FPCGLandscapeHeightfield HeightfieldCopy = Heightfield;
+	NewData->Initialize(MoveTemp(HeightfieldCopy), Material);
+
+	return NewData;
+}
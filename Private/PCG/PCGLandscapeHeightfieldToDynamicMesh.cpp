@@ -0,0 +1,64 @@
+// Copyright BULKHEAD Limited. All Rights Reserved.
+
+// Implements the Heightfield To Dynamic Mesh PCG node.  Each heightfield
+// input is converted with UPCGLandscapeHeightfieldData::CreateDynamicMeshData;
+// dynamic mesh inputs pass through.
+
+#include "PCG/PCGLandscapeHeightfieldToDynamicMesh.h"
+
+/* WDEditor */
+#include "PCG/PCGLandscapeHeightfieldData.h"
+
+/* PCG */
+#include "PCGContext.h"
+#include "PCGPin.h"
+#include "Data/PCGDynamicMeshData.h"
+
+namespace
+{
+    class FPCGLandscapeHeightfieldToDynamicMeshElement final : public IPCGDynamicMeshBaseElement
+    {
+    protected:
+        virtual bool ExecuteInternal(FPCGContext* Context) const override;
+    };
+}
+
+FPCGElementPtr UPCGLandscapeHeightfieldToDynamicMeshSettings::CreateElement() const
+{
+    return MakeShared<FPCGLandscapeHeightfieldToDynamicMeshElement>();
+}
+
+TArray<FPCGPinProperties> UPCGLandscapeHeightfieldToDynamicMeshSettings::InputPinProperties() const
+{
+    TArray<FPCGPinProperties> Pins = Super::InputPinProperties();
+    for (FPCGPinProperties& Pin : Pins)
+    {
+        if (Pin.Label == PCGPinConstants::DefaultInputLabel)
+        {
+            Pin.AllowedTypes |= EPCGDataType::Other;
+        }
+    }
+    return Pins;
+}
+
+bool FPCGLandscapeHeightfieldToDynamicMeshElement::ExecuteInternal(FPCGContext* Context) const
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FPCGLandscapeHeightfieldToDynamicMeshElement::ExecuteInternal);
+
+    check(Context);
+
+    for (const FPCGTaggedData& Input : Context->InputData.GetInputsByPin(PCGPinConstants::DefaultInputLabel))
+    {
+        if (const UPCGLandscapeHeightfieldData* HeightfieldData = Cast<const UPCGLandscapeHeightfieldData>(Input.Data))
+        {
+            FPCGTaggedData& OutTagged = Context->OutputData.TaggedData.Add_GetRef(Input);
+            OutTagged.Data = HeightfieldData->CreateDynamicMeshData(Context);
+        }
+        else if (Cast<const UPCGDynamicMeshData>(Input.Data))
+        {
+            Context->OutputData.TaggedData.Add(Input);
+        }
+    }
+
+    return true;
+}
@@ -1,13 +1,17 @@
 // Copyright BULKHEAD Limited. All Rights Reserved.
 
 #include "PCG/PCGLandscapeMeshBuilder.h"
+#include "PCG/PCGGridLattice.h"
 
 /* GeometryCore */
 #include "DynamicMesh/DynamicMesh3.h" // includes FEdgeSplitInfo and EMeshResult definitions
 #include "DynamicMesh/MeshNormals.h"
 #include "IndexTypes.h"
 
-/* Math */
+/* Core */
+#include "Async/ParallelFor.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "HAL/PlatformTime.h"
 #include "Math/UnrealMathUtility.h"
 
 using UE::Geometry::FDynamicMesh3;
@@ -51,29 +55,29 @@ namespace Builder_Internal
                 return N;
         }
 
-        /** Undirected key for caching edge-intersection vertices on grid edges. */
-        static uint64 MakeGridEdgeKey(int32 X, int32 Y, int32 Dir /*0=H,1=V*/)
+        /** Mask crossing on the edge S0 -> S1, in [0, 1] from S0 (threshold-based interpolation of the mask). */
+        static double ComputeEdgeCrossingT(const FPCGLandscapeGridSample& S0, const FPCGLandscapeGridSample& S1, float MaskThreshold)
         {
-                // pack into 64: (Dir<<62) | (Y<<31) | X
-                const uint64 UX = (uint32)X;
-                const uint64 UY = (uint32)Y;
-                return (uint64(Dir) << 62) | (UY << 31) | UX;
+                const double M0 = (double)S0.Mask;
+                const double M1 = (double)S1.Mask;
+                const double Den = (M1 - M0);
+
+                // If Den ~ 0, fall back to midpoint.
+                double T = 0.5;
+                if (FMath::Abs(Den) > 1e-8)
+                {
+                        T = ((double)MaskThreshold - M0) / Den;
+                        T = FMath::Clamp(T, 0.0, 1.0);
+                }
+                return T;
         }
 
-        static int32 GetOrCreateEdgeVertex(
-                FDynamicMesh3& Mesh,
-                TMap<uint64, int32>& EdgeVertexCache,
-                TSet<int32>& OutBoundaryVerts,
+        /** Position of the mask crossing on a grid edge (threshold-based interpolation of the edge endpoints). */
+        static FVector3d ComputeEdgeVertexPosition(
                 const FPCGLandscapeMeshGridDesc& Grid,
                 const FPCGLandscapeMeshBuilderSettings& Settings,
                 int32 X, int32 Y, int32 Dir)
         {
-                const uint64 Key = MakeGridEdgeKey(X, Y, Dir);
-                if (const int32* Found = EdgeVertexCache.Find(Key))
-                {
-                        return *Found;
-                }
-
                 const int32 GridX = Grid.GridX;
                 const int32 GridY = Grid.GridY;
                 const TArray<FPCGLandscapeGridSample>& Samples = *Grid.Samples;
@@ -90,37 +94,45 @@ namespace Builder_Internal
                 const FPCGLandscapeGridSample& S0 = Samples[SampleIndex(X0, Y0, GridX)];
                 const FPCGLandscapeGridSample& S1 = Samples[SampleIndex(X1, Y1, GridX)];
 
-                const double M0 = (double)S0.Mask;
-                const double M1 = (double)S1.Mask;
-                const double Den = (M1 - M0);
-
-                // Threshold-based interpolation. If Den ~ 0, fall back to midpoint.
-                double T = 0.5;
-                if (FMath::Abs(Den) > 1e-8)
-                {
-                        T = ((double)Settings.MaskThreshold - M0) / Den;
-                        T = FMath::Clamp(T, 0.0, 1.0);
-                }
+                const double T = ComputeEdgeCrossingT(S0, S1, Settings.MaskThreshold);
 
                 const FVector3d P0 = MakePos(Grid.GridMinXY, Settings.CellSize, X0, Y0, S0.Height);
                 const FVector3d P1 = MakePos(Grid.GridMinXY, Settings.CellSize, X1, Y1, S1.Height);
 
-                const FVector3d Pos = Lerp3(P0, P1, T);
-                const FVector3d Nor = LerpNormalSafe(S0.Normal, S1.Normal, T);
+                return Lerp3(P0, P1, T);
+        }
 
-                const int32 Vid = Mesh.AppendVertex(Pos);
+        static int32 GetOrCreateEdgeVertex(
+                FDynamicMesh3& Mesh,
+                TPCGGridEdgeArray<int32>& EdgeVertexCache,
+                FPCGDenseIndexSet& OutBoundaryVerts,
+                const FPCGLandscapeMeshGridDesc& Grid,
+                const FPCGLandscapeMeshBuilderSettings& Settings,
+                int32 X, int32 Y, int32 Dir)
+        {
+                int32& Vid = EdgeVertexCache.Get(X, Y, Dir);
+                if (Vid != INDEX_NONE)
+                {
+                        return Vid;
+                }
+
+                Vid = Mesh.AppendVertex(ComputeEdgeVertexPosition(Grid, Settings, X, Y, Dir));
 
                 // Mark as mask-boundary vertex (hard constraint for subdivision)
                 OutBoundaryVerts.Add(Vid);
 
-                EdgeVertexCache.Add(Key, Vid);
                 return Vid;
         }
 
-        static void AddTriDeterministic(FDynamicMesh3& Mesh, int32 A, int32 B, int32 C)
+        static FORCEINLINE FIndex3i MakeTriDeterministic(int32 A, int32 B, int32 C)
         {
                 // Flip winding so front faces point up (fix backface-only rendering)
-                Mesh.AppendTriangle(A, C, B);
+                return FIndex3i(A, C, B);
+        }
+
+        static void AddTriDeterministic(FDynamicMesh3& Mesh, int32 A, int32 B, int32 C)
+        {
+                Mesh.AppendTriangle(MakeTriDeterministic(A, B, C));
         }
 
         static void AccumulateConstraintEdgesFromVertices(
@@ -175,16 +187,13 @@ namespace Builder_Internal
                 }
         }
 
-        static bool TriangleCentroidInsideXY(
-                const FDynamicMesh3& Mesh,
-                int32 Tid,
+        /** Crop rule shared by the sample and heightfield paths: a triangle is kept when its XY centroid is inside the bounds. */
+        static bool CentroidInsideXY(
+                const FVector3d& A,
+                const FVector3d& B,
+                const FVector3d& C,
                 const FBox2D& CropBoundsXY)
         {
-                const FIndex3i T = Mesh.GetTriangle(Tid);
-                const FVector3d A = Mesh.GetVertex(T.A);
-                const FVector3d B = Mesh.GetVertex(T.B);
-                const FVector3d C = Mesh.GetVertex(T.C);
-
                 const FVector2D Centroid(
                         (float)((A.X + B.X + C.X) / 3.0),
                         (float)((A.Y + B.Y + C.Y) / 3.0));
@@ -192,6 +201,15 @@ namespace Builder_Internal
                 return CropBoundsXY.IsInside(Centroid);
         }
 
+        static bool TriangleCentroidInsideXY(
+                const FDynamicMesh3& Mesh,
+                int32 Tid,
+                const FBox2D& CropBoundsXY)
+        {
+                const FIndex3i T = Mesh.GetTriangle(Tid);
+                return CentroidInsideXY(Mesh.GetVertex(T.A), Mesh.GetVertex(T.B), Mesh.GetVertex(T.C), CropBoundsXY);
+        }
+
         static void CropMeshToBoundsXY(FDynamicMesh3& Mesh, const FBox2D& CropBoundsXY)
         {
                 TArray<int32> ToRemove;
@@ -244,12 +262,10 @@ namespace Builder_Internal
                 }
         }
 
+        /** GetEdgeVertex(X, Y, Dir) returns the vertex of a crossed grid edge, creating it on first use. */
+        template <typename GetEdgeVertexFunc>
         static void BuildCellPolygon_MarchingSquares(
-                FDynamicMesh3& Mesh,
-                TMap<uint64, int32>& EdgeVertexCache,
-                TSet<int32>& BoundaryVerts,
-                const FPCGLandscapeMeshGridDesc& Grid,
-                const FPCGLandscapeMeshBuilderSettings& Settings,
+                GetEdgeVertexFunc&& GetEdgeVertex,
                 int32 CellX, int32 CellY,
                 int32 V00, int32 V10, int32 V11, int32 V01,
                 bool bS00, bool bS10, bool bS11, bool bS01,
@@ -270,10 +286,11 @@ namespace Builder_Internal
                 const bool bE2 = (bS01 != bS11);
                 const bool bE3 = (bS00 != bS01);
 
-                const int32 E0 = bE0 ? GetOrCreateEdgeVertex(Mesh, EdgeVertexCache, BoundaryVerts, Grid, Settings, CellX,     CellY,     0) : -1;
-                const int32 E1 = bE1 ? GetOrCreateEdgeVertex(Mesh, EdgeVertexCache, BoundaryVerts, Grid, Settings, CellX + 1, CellY,     1) : -1;
-                const int32 E2 = bE2 ? GetOrCreateEdgeVertex(Mesh, EdgeVertexCache, BoundaryVerts, Grid, Settings, CellX,     CellY + 1, 0) : -1;
-                const int32 E3 = bE3 ? GetOrCreateEdgeVertex(Mesh, EdgeVertexCache, BoundaryVerts, Grid, Settings, CellX,     CellY,     1) : -1;
+                // Edge vertices are created in E0..E3 order, which fixes the vertex IDs.
+                const int32 E0 = bE0 ? GetEdgeVertex(CellX,     CellY,     0) : -1;
+                const int32 E1 = bE1 ? GetEdgeVertex(CellX + 1, CellY,     1) : -1;
+                const int32 E2 = bE2 ? GetEdgeVertex(CellX,     CellY + 1, 0) : -1;
+                const int32 E3 = bE3 ? GetEdgeVertex(CellX,     CellY,     1) : -1;
 
                 switch (Case)
                 {
@@ -295,10 +312,12 @@ namespace Builder_Internal
                 }
         }
 
+        /** AddTri(A, B, C) receives the fan triangles in order. */
+        template <typename AddTriFunc>
         static void TriangulatePolygonFan(
-                FDynamicMesh3& Mesh,
                 const TArray<int32>& Poly,
-                bool bDeterministic)
+                bool bDeterministic,
+                AddTriFunc&& AddTri)
         {
                 const int32 N = Poly.Num();
                 if (N < 3)
@@ -309,7 +328,7 @@ namespace Builder_Internal
                 const int32 Root = Poly[0];
                 for (int32 i = 1; i < N - 1; ++i)
                 {
-                        AddTriDeterministic(Mesh, Root, Poly[i], Poly[i + 1]);
+                        AddTri(Root, Poly[i], Poly[i + 1]);
                 }
         }
 
@@ -480,7 +499,7 @@ const FVector3f N = (FVector3f)Samples[SIdx].Normal;
             const FPCGLandscapeMeshGridDesc& Grid,
             const TArray<FPCGLandscapeGridSample>& Samples,
             double CellSize,
-            const TSet<int32>& MaskBoundaryVerts)
+            const FPCGDenseIndexSet& MaskBoundaryVerts)
         {
                 if (!Mesh.HasAttributes())
                 {
@@ -605,6 +624,301 @@ const FVector3f N = (FVector3f)Samples[SIdx].Normal;
                 }
         }
 
+        /** Corner solidity and corner vertex IDs of one grid cell. */
+        struct FCellCorners
+        {
+                int32 I00, I10, I11, I01;
+                bool S00, S10, S11, S01;
+
+                FCellCorners(const TArray<FPCGLandscapeGridSample>& Samples, float MaskThreshold, int32 X, int32 Y, int32 GridX)
+                        : I00(SampleIndex(X,     Y,     GridX))
+                        , I10(SampleIndex(X + 1, Y,     GridX))
+                        , I11(SampleIndex(X + 1, Y + 1, GridX))
+                        , I01(SampleIndex(X,     Y + 1, GridX))
+                        , S00(IsSolid(Samples[I00].Mask, MaskThreshold))
+                        , S10(IsSolid(Samples[I10].Mask, MaskThreshold))
+                        , S11(IsSolid(Samples[I11].Mask, MaskThreshold))
+                        , S01(IsSolid(Samples[I01].Mask, MaskThreshold))
+                {
+                }
+
+                int32 NumSolid() const
+                {
+                        return (int32)S00 + (int32)S10 + (int32)S11 + (int32)S01;
+                }
+        };
+
+        /**
+         * Triangulates one cell. Corner vertex IDs are the sample indices (corners are appended first, in
+         * sample order). Returns the cell classification: 0 = empty, 4 = solid, anything else = mixed.
+         */
+        template <typename GetEdgeVertexFunc, typename AddTriFunc>
+        static int32 TriangulateCell(
+                const FPCGLandscapeMeshGridDesc& Grid,
+                const FPCGLandscapeMeshBuilderSettings& Settings,
+                int32 X, int32 Y,
+                TArray<int32>& Poly,
+                GetEdgeVertexFunc&& GetEdgeVertex,
+                AddTriFunc&& AddTri)
+        {
+                const FCellCorners C(*Grid.Samples, Settings.MaskThreshold, X, Y, Grid.GridX);
+                const int32 NumSolid = C.NumSolid();
+
+                if (NumSolid == 0)
+                {
+                        return NumSolid;
+                }
+
+                if (NumSolid == 4)
+                {
+                        if (Settings.bSolidQuadsUseDiagBLtoTR)
+                        {
+                                AddTri(C.I00, C.I10, C.I11);
+                                AddTri(C.I00, C.I11, C.I01);
+                        }
+                        else
+                        {
+                                AddTri(C.I00, C.I10, C.I01);
+                                AddTri(C.I10, C.I11, C.I01);
+                        }
+                        return NumSolid;
+                }
+
+                if (Settings.bUseMarchingSquares)
+                {
+                        BuildCellPolygon_MarchingSquares(
+                                GetEdgeVertex,
+                                X, Y,
+                                C.I00, C.I10, C.I11, C.I01,
+                                C.S00, C.S10, C.S11, C.S01,
+                                Poly);
+
+                        TriangulatePolygonFan(Poly, Settings.bDeterministicTriangulation, AddTri);
+                }
+
+                return NumSolid;
+        }
+
+        static void CountCell(int32 NumSolid, int32& NumEmpty, int32& NumSolidCells, int32& NumMixed)
+        {
+                if (NumSolid == 0)      { ++NumEmpty; }
+                else if (NumSolid == 4) { ++NumSolidCells; }
+                else                    { ++NumMixed; }
+        }
+
+        // ------------------------------------------------------------
+        // Topology: serial reference
+        // ------------------------------------------------------------
+        static void BuildTopologySerial(
+                const FPCGLandscapeMeshGridDesc& Grid,
+                const FPCGLandscapeMeshBuilderSettings& Settings,
+                FDynamicMesh3& Mesh,
+                FPCGDenseIndexSet& OutMaskBoundaryVerts,
+                FPCGLandscapeMeshBuilderStats& Stats)
+        {
+                // Marching squares edge vertex cache, one entry per lattice edge
+                TPCGGridEdgeArray<int32> EdgeVertexCache;
+                EdgeVertexCache.Init(Grid.GridX, Grid.GridY, INDEX_NONE);
+
+                auto GetEdgeVertex = [&](int32 X, int32 Y, int32 Dir)
+                {
+                        return GetOrCreateEdgeVertex(Mesh, EdgeVertexCache, OutMaskBoundaryVerts, Grid, Settings, X, Y, Dir);
+                };
+
+                auto AddTri = [&Mesh](int32 A, int32 B, int32 C)
+                {
+                        AddTriDeterministic(Mesh, A, B, C);
+                };
+
+                TArray<int32> Poly;
+                Poly.Reserve(8);
+
+                for (int32 Y = 0; Y < Grid.GridY - 1; ++Y)
+                {
+                        for (int32 X = 0; X < Grid.GridX - 1; ++X)
+                        {
+                                const int32 NumSolid = TriangulateCell(Grid, Settings, X, Y, Poly, GetEdgeVertex, AddTri);
+                                CountCell(NumSolid, Stats.NumCellsEmpty, Stats.NumCellsSolid, Stats.NumCellsMixed);
+                        }
+                }
+
+                Stats.NumBands = 1;
+        }
+
+        // ------------------------------------------------------------
+        // Topology: row bands triangulated in parallel
+        //
+        // Each band of cell rows produces its new edge vertices and its triangles in
+        // exactly the order the serial loop would, with vertex references encoded
+        // relative to the band. Bands are then appended to the mesh in band order, so
+        // vertex, triangle and edge IDs match the serial build.
+        //
+        // Seams: a horizontal edge on the first row of a band is always created by the
+        // previous band (the cell above it is mixed whenever the edge is crossed), so the
+        // band references it through the previous band's bottom row table.
+        // ------------------------------------------------------------
+        struct FTopologyBand
+        {
+                int32 FirstRow = 0;
+                int32 EndRow = 0;
+
+                int32 NumCellsSolid = 0;
+                int32 NumCellsEmpty = 0;
+                int32 NumCellsMixed = 0;
+
+                /** New edge vertices, in creation order. */
+                TArray<FVector3d> EdgeVertexPositions;
+
+                /** Triangles (already in AppendTriangle winding), with encoded vertex references. */
+                TArray<FIndex3i> Triangles;
+
+                /** Band-local edge vertex of each horizontal edge on row EndRow (GridX - 1 entries), INDEX_NONE if not crossed. */
+                TArray<int32> BottomRowEdgeVertices;
+
+                /** First vertex ID of the band edge vertices, set during the merge. */
+                int32 VertexIDBase = 0;
+        };
+
+        static FORCEINLINE int32 DecodeBandVertex(int32 Ref, const FTopologyBand& Band, const FTopologyBand* PreviousBand)
+        {
+                return PCGGridBandVertexRef::Decode(
+                        Ref,
+                        Band.VertexIDBase,
+                        PreviousBand ? TConstArrayView<int32>(PreviousBand->BottomRowEdgeVertices) : TConstArrayView<int32>(),
+                        PreviousBand ? PreviousBand->VertexIDBase : 0);
+        }
+
+        static void TriangulateBand(
+                const FPCGLandscapeMeshGridDesc& Grid,
+                const FPCGLandscapeMeshBuilderSettings& Settings,
+                FTopologyBand& Band)
+        {
+                const int32 GridX = Grid.GridX;
+                const int32 NumRows = Band.EndRow - Band.FirstRow;
+
+                // Edge cache for the vertex rows touched by the band, [FirstRow, EndRow].
+                TPCGGridEdgeArray<int32> EdgeVertices;
+                EdgeVertices.Init(GridX, NumRows + 1, INDEX_NONE, Band.FirstRow);
+
+                auto GetEdgeVertex = [&](int32 X, int32 Y, int32 Dir)
+                {
+                        if (Dir == 0 && Y == Band.FirstRow && Band.FirstRow > 0)
+                        {
+                                return PCGGridBandVertexRef::EncodePreviousBandEdgeVertex(X);
+                        }
+
+                        int32& LocalIndex = EdgeVertices.Get(X, Y, Dir);
+
+                        if (LocalIndex == INDEX_NONE)
+                        {
+                                LocalIndex = Band.EdgeVertexPositions.Add(ComputeEdgeVertexPosition(Grid, Settings, X, Y, Dir));
+                        }
+
+                        return PCGGridBandVertexRef::EncodeBandEdgeVertex(LocalIndex);
+                };
+
+                auto AddTri = [&Band](int32 A, int32 B, int32 C)
+                {
+                        Band.Triangles.Add(MakeTriDeterministic(A, B, C));
+                };
+
+                Band.Triangles.Reserve(NumRows * (GridX - 1) * 2);
+
+                TArray<int32> Poly;
+                Poly.Reserve(8);
+
+                for (int32 Y = Band.FirstRow; Y < Band.EndRow; ++Y)
+                {
+                        for (int32 X = 0; X < GridX - 1; ++X)
+                        {
+                                const int32 NumSolid = TriangulateCell(Grid, Settings, X, Y, Poly, GetEdgeVertex, AddTri);
+                                CountCell(NumSolid, Band.NumCellsEmpty, Band.NumCellsSolid, Band.NumCellsMixed);
+                        }
+                }
+
+                Band.BottomRowEdgeVertices = TArray<int32>(EdgeVertices.GetHorizontalRow(Band.EndRow));
+        }
+
+        static void BuildTopologyTiled(
+                const FPCGLandscapeMeshGridDesc& Grid,
+                const FPCGLandscapeMeshBuilderSettings& Settings,
+                FDynamicMesh3& Mesh,
+                FPCGDenseIndexSet& OutMaskBoundaryVerts,
+                FPCGLandscapeMeshBuilderStats& Stats)
+        {
+                const int32 NumCellRows = Grid.GridY - 1;
+
+                const int32 RowsPerBand = ComputeGridRowsPerBand(NumCellRows, Settings.TiledBuildRowsPerBand);
+
+                const int32 NumBands = FMath::DivideAndRoundUp(NumCellRows, RowsPerBand);
+
+                TArray<FTopologyBand> Bands;
+                Bands.SetNum(NumBands);
+                for (int32 BandIndex = 0; BandIndex < NumBands; ++BandIndex)
+                {
+                        Bands[BandIndex].FirstRow = BandIndex * RowsPerBand;
+                        Bands[BandIndex].EndRow = FMath::Min(NumCellRows, (BandIndex + 1) * RowsPerBand);
+                }
+
+                double StartTime = FPlatformTime::Seconds();
+
+                ParallelFor(NumBands, [&](int32 BandIndex)
+                {
+                        TRACE_CPUPROFILER_EVENT_SCOPE(PCGLandscapeMeshBuilder::TriangulateBand);
+                        TriangulateBand(Grid, Settings, Bands[BandIndex]);
+                });
+
+                Stats.TriangulateMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+                StartTime = FPlatformTime::Seconds();
+
+                // Merge in band order (serial vertex/triangle order).
+                {
+                        TRACE_CPUPROFILER_EVENT_SCOPE(PCGLandscapeMeshBuilder::MergeBands);
+
+                        int32 NumEdgeVertices = 0;
+                        for (const FTopologyBand& Band : Bands)
+                        {
+                                NumEdgeVertices += Band.EdgeVertexPositions.Num();
+                        }
+                        OutMaskBoundaryVerts.Reserve(Mesh.MaxVertexID() + NumEdgeVertices);
+
+                        for (int32 BandIndex = 0; BandIndex < NumBands; ++BandIndex)
+                        {
+                                FTopologyBand& Band = Bands[BandIndex];
+                                const FTopologyBand* PreviousBand = (BandIndex > 0) ? &Bands[BandIndex - 1] : nullptr;
+
+                                Band.VertexIDBase = Mesh.MaxVertexID();
+                                for (int32 LocalIndex = 0; LocalIndex < Band.EdgeVertexPositions.Num(); ++LocalIndex)
+                                {
+                                        const int32 Vid = Mesh.AppendVertex(Band.EdgeVertexPositions[LocalIndex]);
+                                        check(Vid == Band.VertexIDBase + LocalIndex);
+
+                                        // Mark as mask-boundary vertex (hard constraint for subdivision)
+                                        OutMaskBoundaryVerts.Add(Vid);
+                                }
+
+                                for (const FIndex3i& Tri : Band.Triangles)
+                                {
+                                        Mesh.AppendTriangle(
+                                                DecodeBandVertex(Tri.A, Band, PreviousBand),
+                                                DecodeBandVertex(Tri.B, Band, PreviousBand),
+                                                DecodeBandVertex(Tri.C, Band, PreviousBand));
+                                }
+
+                                Stats.NumCellsSolid += Band.NumCellsSolid;
+                                Stats.NumCellsEmpty += Band.NumCellsEmpty;
+                                Stats.NumCellsMixed += Band.NumCellsMixed;
+
+                                // The next band only needs VertexIDBase and the bottom row table.
+                                Band.EdgeVertexPositions.Empty();
+                                Band.Triangles.Empty();
+                        }
+                }
+
+                Stats.MergeMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+                Stats.NumBands = NumBands;
+        }
+
 } // namespace Builder_Internal
 
 bool BuildMeshFromSamples(
@@ -638,9 +952,10 @@ bool BuildMeshFromSamples(
                 OutConstraints.ConstrainedVertices.Reset();
                 OutConstraints.ConstrainedEdges.Reset();
 
-                // 1) Create base grid corner vertices (world space for now)
-                TArray<int32> CornerVID;
-                CornerVID.SetNumUninitialized(GridX * GridY);
+                // 1) Create base grid corner vertices (world space for now).
+                //    Corner vertex IDs are the sample indices, the topology builders rely on it.
+                double StartTime = FPlatformTime::Seconds();
+                const double BuildStartTime = StartTime;
 
                 for (int32 Y = 0; Y < GridY; ++Y)
                 {
@@ -649,103 +964,32 @@ bool BuildMeshFromSamples(
                                 const FPCGLandscapeGridSample& S = Samples[Builder_Internal::SampleIndex(X, Y, GridX)];
                                 const FVector3d P = Builder_Internal::MakePos(GridDesc.GridMinXY, Settings.CellSize, X, Y, S.Height);
                                 const int32 Vid = OutMesh.AppendVertex(P);
-                                CornerVID[Builder_Internal::SampleIndex(X, Y, GridX)] = Vid;
+                                check(Vid == Builder_Internal::SampleIndex(X, Y, GridX));
                         }
                 }
 
-                // Marching squares edge vertex cache + boundary vertices set
-                TMap<uint64, int32> EdgeVertexCache;
-                EdgeVertexCache.Reserve(Stats.NumCellsTotal * 2);
-
-                TSet<int32> MaskBoundaryVerts;
+                Stats.CornersMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
 
-                // 2) Build topology per cell (hybrid)
-                TArray<int32> Poly;
-                Poly.Reserve(8);
+                // 2) Build topology per cell (hybrid). Both paths produce identical meshes.
+                FPCGDenseIndexSet MaskBoundaryVerts;
 
-                for (int32 Y = 0; Y < GridY - 1; ++Y)
+                if (Settings.bUseTiledBuild && GridY - 1 > 1)
                 {
-                        for (int32 X = 0; X < GridX - 1; ++X)
-                        {
-                                const int32 I00 = Builder_Internal::SampleIndex(X,     Y,     GridX);
-                                const int32 I10 = Builder_Internal::SampleIndex(X + 1, Y,     GridX);
-                                const int32 I11 = Builder_Internal::SampleIndex(X + 1, Y + 1, GridX);
-                                const int32 I01 = Builder_Internal::SampleIndex(X,     Y + 1, GridX);
-
-                                const float M00 = Samples[I00].Mask;
-                                const float M10 = Samples[I10].Mask;
-                                const float M11 = Samples[I11].Mask;
-                                const float M01 = Samples[I01].Mask;
-
-                                const bool S00 = Builder_Internal::IsSolid(M00, Settings.MaskThreshold);
-                                const bool S10 = Builder_Internal::IsSolid(M10, Settings.MaskThreshold);
-                                const bool S11 = Builder_Internal::IsSolid(M11, Settings.MaskThreshold);
-                                const bool S01 = Builder_Internal::IsSolid(M01, Settings.MaskThreshold);
-
-                                const int32 NumSolid = (int32)S00 + (int32)S10 + (int32)S11 + (int32)S01;
-
-                                if (NumSolid == 0)
-                                {
-                                        Stats.NumCellsEmpty++;
-                                        continue;
-                                }
-                                if (NumSolid == 4)
-                                {
-                                        Stats.NumCellsSolid++;
-
-                                        const int32 V00 = CornerVID[I00];
-                                        const int32 V10 = CornerVID[I10];
-                                        const int32 V11 = CornerVID[I11];
-                                        const int32 V01 = CornerVID[I01];
-
-                                        if (Settings.bSolidQuadsUseDiagBLtoTR)
-                                        {
-                                                Builder_Internal::AddTriDeterministic(OutMesh, V00, V10, V11);
-                                                Builder_Internal::AddTriDeterministic(OutMesh, V00, V11, V01);
-                                        }
-                                        else
-                                        {
-                                                Builder_Internal::AddTriDeterministic(OutMesh, V00, V10, V01);
-                                                Builder_Internal::AddTriDeterministic(OutMesh, V10, V11, V01);
-                                        }
-
-                                        continue;
-                                }
-
-                                Stats.NumCellsMixed++;
-
-                                if (!Settings.bUseMarchingSquares)
-                                {
-                                        continue;
-                                }
-
-                                const int32 V00 = CornerVID[I00];
-                                const int32 V10 = CornerVID[I10];
-                                const int32 V11 = CornerVID[I11];
-                                const int32 V01 = CornerVID[I01];
-
-                                Builder_Internal::BuildCellPolygon_MarchingSquares(
-                                        OutMesh,
-                                        EdgeVertexCache,
-                                        MaskBoundaryVerts,
-                                        GridDesc,
-                                        Settings,
-                                        X, Y,
-                                        V00, V10, V11, V01,
-                                        S00, S10, S11, S01,
-                                        Poly);
-
-                                Builder_Internal::TriangulatePolygonFan(OutMesh, Poly, Settings.bDeterministicTriangulation);
-                        }
+                        Builder_Internal::BuildTopologyTiled(GridDesc, Settings, OutMesh, MaskBoundaryVerts, Stats);
+                }
+                else
+                {
+                        StartTime = FPlatformTime::Seconds();
+                        Builder_Internal::BuildTopologySerial(GridDesc, Settings, OutMesh, MaskBoundaryVerts, Stats);
+                        Stats.TriangulateMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
                 }
 
                 Stats.NumTrianglesBeforeCrop = OutMesh.TriangleCount();
 
+                StartTime = FPlatformTime::Seconds();
+
                 // 3) Promote mask-boundary vertices to hard constraints
-                for (int32 Vid : MaskBoundaryVerts)
-                {
-                        OutConstraints.ConstrainedVertices.Add(Vid);
-                }
+                OutConstraints.ConstrainedVertices = MaskBoundaryVerts;
 
                 // 4) Add crop boundary constraints (tile seam safety)
                 if (Settings.bConstrainCropBoundary)
@@ -756,6 +1000,9 @@ bool BuildMeshFromSamples(
                 // 5) Convert constrained vertices -> constrained edges (incident edges)
                 Builder_Internal::AccumulateConstraintEdgesFromVertices(OutMesh, OutConstraints);
 
+                Stats.ConstraintsMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+                StartTime = FPlatformTime::Seconds();
+
                 // 6) Subdivision is disabled in this node. Boundary refinement and any
                 //    advanced subdivision should be performed in a separate node.
 
@@ -779,14 +1026,7 @@ bool BuildMeshFromSamples(
                                         {
                                                 continue;
                                         }
-                                        const FIndex3i TriV = OutMesh.GetTriangle(Tid);
-                                        const FVector3d A = OutMesh.GetVertex(TriV.A);
-                                        const FVector3d B = OutMesh.GetVertex(TriV.B);
-                                        const FVector3d C = OutMesh.GetVertex(TriV.C);
-                                        const FVector2D Centroid(
-                                                (float)((A.X + B.X + C.X) / 3.0),
-                                                (float)((A.Y + B.Y + C.Y) / 3.0));
-                                        if (!CropBoundsXY.IsInside(Centroid))
+                                        if (!Builder_Internal::TriangleCentroidInsideXY(OutMesh, Tid, CropBoundsXY))
                                         {
                                                 OutMesh.SetTriangleGroup(Tid, Settings.PaddingPolygroupID);
                                         }
@@ -794,6 +1034,8 @@ bool BuildMeshFromSamples(
                         }
                 }
                 Stats.NumTrianglesAfterCrop = OutMesh.TriangleCount();
+                Stats.CropMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+                StartTime = FPlatformTime::Seconds();
 
                 // 8) Optional cleanup
                 if (Settings.bRemoveIsolatedVertices)
@@ -807,7 +1049,7 @@ bool BuildMeshFromSamples(
                 // 10) Override boundary normals from sampled landscape normals (seam-free)
                 Builder_Internal::OverrideBoundaryNormalsFromSamples(OutMesh, CropBoundsXY, GridDesc, Samples, Settings.CellSize);
                 // Also override normals along the mask boundary using sampled normals.
-                if (MaskBoundaryVerts.Num() > 0)
+                if (!MaskBoundaryVerts.IsEmpty())
                 {
                         Builder_Internal::OverrideMaskBoundaryNormalsFromSamples(
                                 OutMesh,
@@ -817,15 +1059,339 @@ bool BuildMeshFromSamples(
                                 MaskBoundaryVerts);
                 }
 
+                Stats.NormalsMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
                 // 11) Convert mesh to local space in XY (does not affect normals)
                 const FVector2D OriginXY = CropBoundsXY.GetCenter();
                 Builder_Internal::TranslateMeshToLocalXY(OutMesh, OriginXY);
 
+                Stats.TotalMs = (FPlatformTime::Seconds() - BuildStartTime) * 1000.0;
+
                 if (OutStats)
                 {
                         *OutStats = Stats;
                 }
 
+                return (OutMesh.TriangleCount() > 0);
+        }
+
+bool BuildHeightfieldFromSamples(
+                const FPCGLandscapeMeshGridDesc& GridDesc,
+                const FPCGLandscapeMeshBuilderSettings& Settings,
+                const FBox2D& CropBoundsXY,
+                FPCGLandscapeHeightfield& OutHeightfield)
+        {
+                OutHeightfield.Reset();
+
+                if (!GridDesc.Samples || GridDesc.GridX < 2 || GridDesc.GridY < 2)
+                {
+                        return false;
+                }
+
+                const int32 GridX = GridDesc.GridX;
+                const int32 GridY = GridDesc.GridY;
+
+                const TArray<FPCGLandscapeGridSample>& Samples = *GridDesc.Samples;
+                if (Samples.Num() != GridX * GridY)
+                {
+                        return false;
+                }
+
+                FPCGLandscapeHeightfield& Heightfield = OutHeightfield;
+                Heightfield.GridX = GridX;
+                Heightfield.GridY = GridY;
+                Heightfield.GridMinXY = GridDesc.GridMinXY;
+                Heightfield.CellSize = Settings.CellSize;
+                Heightfield.OriginXY = CropBoundsXY.GetCenter();
+                Heightfield.bUseMarchingSquares = Settings.bUseMarchingSquares;
+                Heightfield.bSolidQuadsUseDiagBLtoTR = Settings.bSolidQuadsUseDiagBLtoTR;
+                Heightfield.PaddingPolygroupID = Settings.bIncludePadding ? Settings.PaddingPolygroupID : -1;
+                Heightfield.CropBoundsXY = CropBoundsXY;
+                Heightfield.bIncludePadding = Settings.bIncludePadding;
+
+                // 1) Per-vertex arrays
+                Heightfield.Heights.SetNumUninitialized(GridX * GridY);
+                Heightfield.Normals.SetNumUninitialized(GridX * GridY);
+                ParallelFor(GridY, [&](int32 Y)
+                {
+                        for (int32 X = 0; X < GridX; ++X)
+                        {
+                                const int32 Index = Builder_Internal::SampleIndex(X, Y, GridX);
+                                Heightfield.Heights[Index] = (float)Samples[Index].Height;
+                                Heightfield.Normals[Index] = FVector3f(Samples[Index].Normal);
+                        }
+                });
+
+                Heightfield.Solid.Init(false, GridX * GridY);
+                for (int32 Index = 0; Index < GridX * GridY; ++Index)
+                {
+                        Heightfield.Solid[Index] = Builder_Internal::IsSolid(Samples[Index].Mask, Settings.MaskThreshold);
+                }
+
+                // 2) Mixed cells with their edge crossings, rows in parallel, appended in row order
+                if (Settings.bUseMarchingSquares)
+                {
+                        TArray<TArray<FPCGLandscapeHeightfieldBoundaryCell>> RowBoundaryCells;
+                        RowBoundaryCells.SetNum(GridY - 1);
+
+                        ParallelFor(GridY - 1, [&](int32 Y)
+                        {
+                                for (int32 X = 0; X < GridX - 1; ++X)
+                                {
+                                        const Builder_Internal::FCellCorners C(Samples, Settings.MaskThreshold, X, Y, GridX);
+                                        const int32 NumSolid = C.NumSolid();
+                                        if (NumSolid == 0 || NumSolid == 4)
+                                        {
+                                                continue;
+                                        }
+
+                                        // E0..E3 as in BuildCellPolygon_MarchingSquares, each from its lower lattice vertex
+                                        FPCGLandscapeHeightfieldBoundaryCell& Cell = RowBoundaryCells[Y].AddDefaulted_GetRef();
+                                        Cell.CellIndex = Heightfield.CellIndex(X, Y);
+                                        Cell.EdgeT[0] = (float)Builder_Internal::ComputeEdgeCrossingT(Samples[C.I00], Samples[C.I10], Settings.MaskThreshold);
+                                        Cell.EdgeT[1] = (float)Builder_Internal::ComputeEdgeCrossingT(Samples[C.I10], Samples[C.I11], Settings.MaskThreshold);
+                                        Cell.EdgeT[2] = (float)Builder_Internal::ComputeEdgeCrossingT(Samples[C.I01], Samples[C.I11], Settings.MaskThreshold);
+                                        Cell.EdgeT[3] = (float)Builder_Internal::ComputeEdgeCrossingT(Samples[C.I00], Samples[C.I01], Settings.MaskThreshold);
+                                }
+                        });
+
+                        for (TArray<FPCGLandscapeHeightfieldBoundaryCell>& RowCells : RowBoundaryCells)
+                        {
+                                Heightfield.BoundaryCells.Append(RowCells);
+                        }
+                }
+
+                // 3) Crop to the cells overlapping the partition bounds, unless the padding is kept. Their triangles
+                //    are cropped by centroid when the mesh is built.
+                Heightfield.CropCells = ComputeHeightfieldCropCells(Heightfield, CropBoundsXY);
+                if (Heightfield.CropCells.Width() <= 0 || Heightfield.CropCells.Height() <= 0)
+                {
+                        Heightfield.Reset();
+                        return false;
+                }
+
+                if (!Settings.bIncludePadding)
+                {
+                        return CropHeightfield(Heightfield, Heightfield.CropCells);
+                }
+
+                return true;
+        }
+
+bool BuildMeshFromHeightfield(
+                const FPCGLandscapeHeightfield& Heightfield,
+                FDynamicMesh3& OutMesh)
+        {
+                OutMesh.Clear();
+
+                if (!Heightfield.IsValid())
+                {
+                        return false;
+                }
+
+                const int32 GridX = Heightfield.GridX;
+                const int32 GridY = Heightfield.GridY;
+                const int32 NumCellsX = Heightfield.NumCellsX();
+
+                const bool bUsePadding = Heightfield.PaddingPolygroupID >= 0;
+                if (bUsePadding)
+                {
+                        OutMesh.EnableTriangleGroups();
+                }
+
+                auto IsCellSolid = [&Heightfield](int32 CellX, int32 CellY)
+                {
+                        return Heightfield.Solid[Heightfield.VertexIndex(CellX, CellY)]
+                                && Heightfield.Solid[Heightfield.VertexIndex(CellX + 1, CellY)]
+                                && Heightfield.Solid[Heightfield.VertexIndex(CellX + 1, CellY + 1)]
+                                && Heightfield.Solid[Heightfield.VertexIndex(CellX, CellY + 1)];
+                };
+
+                // 1) Corner vertices that belong to a triangle, in lattice order. With marching squares every
+                //    cell around a solid vertex is triangulated, otherwise only all-solid cells are.
+                TArray<int32> CornerVids;
+                CornerVids.Init(INDEX_NONE, GridX * GridY);
+
+                TArray<FVector3f> VertexNormals;
+
+                for (int32 Y = 0; Y < GridY; ++Y)
+                {
+                        for (int32 X = 0; X < GridX; ++X)
+                        {
+                                const int32 Index = Heightfield.VertexIndex(X, Y);
+                                if (!Heightfield.Solid[Index])
+                                {
+                                        continue;
+                                }
+
+                                bool bUsed = Heightfield.bUseMarchingSquares;
+                                for (int32 CellY = FMath::Max(Y - 1, 0); !bUsed && CellY <= FMath::Min(Y, GridY - 2); ++CellY)
+                                {
+                                        for (int32 CellX = FMath::Max(X - 1, 0); !bUsed && CellX <= FMath::Min(X, GridX - 2); ++CellX)
+                                        {
+                                                bUsed = IsCellSolid(CellX, CellY);
+                                        }
+                                }
+
+                                if (bUsed)
+                                {
+                                        CornerVids[Index] = OutMesh.AppendVertex(Heightfield.GetLocalPosition(X, Y));
+                                        VertexNormals.Add(Heightfield.Normals[Index]);
+                                }
+                        }
+                }
+
+                // 2) Cells in order, triangulated as BuildMeshFromSamples does
+                TPCGGridEdgeArray<int32> EdgeVertices;
+                if (!Heightfield.BoundaryCells.IsEmpty())
+                {
+                        EdgeVertices.Init(GridX, GridY, INDEX_NONE);
+                }
+
+                const FPCGLandscapeHeightfieldBoundaryCell* BoundaryCell = nullptr;
+                int32 NextBoundaryCell = 0;
+                int32 CellX = 0;
+                int32 CellY = 0;
+
+                auto GetEdgeVertex = [&](int32 X, int32 Y, int32 Dir)
+                {
+                        int32& Vid = EdgeVertices.Get(X, Y, Dir);
+                        if (Vid != INDEX_NONE)
+                        {
+                                return Vid;
+                        }
+
+                        const int32 Edge = (Dir == 0) ? ((Y == CellY) ? 0 : 2) : ((X == CellX) ? 3 : 1);
+                        const double T = (double)BoundaryCell->EdgeT[Edge];
+
+                        const int32 X1 = (Dir == 0) ? X + 1 : X;
+                        const int32 Y1 = (Dir == 0) ? Y : Y + 1;
+
+                        const FVector3d N0(Heightfield.Normals[Heightfield.VertexIndex(X, Y)]);
+                        const FVector3d N1(Heightfield.Normals[Heightfield.VertexIndex(X1, Y1)]);
+
+                        Vid = OutMesh.AppendVertex(Builder_Internal::Lerp3(Heightfield.GetLocalPosition(X, Y), Heightfield.GetLocalPosition(X1, Y1), T));
+                        VertexNormals.Add(FVector3f(Builder_Internal::LerpNormalSafe(N0, N1, T)));
+                        return Vid;
+                };
+
+                // Triangles are cropped in world XY, like BuildMeshFromSamples does before moving to local space
+                const bool bCrop = Heightfield.CropBoundsXY.bIsValid && (!Heightfield.bIncludePadding || bUsePadding);
+                const FVector3d LocalToWorld(Heightfield.OriginXY.X, Heightfield.OriginXY.Y, 0.0);
+                int32 NumCroppedTriangles = 0;
+
+                auto AddTri = [&](int32 A, int32 B, int32 C)
+                {
+                        int32 GroupID = 0;
+                        if (bCrop && !Builder_Internal::CentroidInsideXY(
+                                OutMesh.GetVertex(A) + LocalToWorld,
+                                OutMesh.GetVertex(B) + LocalToWorld,
+                                OutMesh.GetVertex(C) + LocalToWorld,
+                                Heightfield.CropBoundsXY))
+                        {
+                                if (!Heightfield.bIncludePadding)
+                                {
+                                        ++NumCroppedTriangles;
+                                        return;
+                                }
+                                GroupID = Heightfield.PaddingPolygroupID;
+                        }
+
+                        OutMesh.AppendTriangle(Builder_Internal::MakeTriDeterministic(A, B, C), GroupID);
+                };
+
+                TArray<int32> Poly;
+                Poly.Reserve(8);
+
+                for (CellY = 0; CellY < GridY - 1; ++CellY)
+                {
+                        for (CellX = 0; CellX < GridX - 1; ++CellX)
+                        {
+                                const int32 I00 = Heightfield.VertexIndex(CellX,     CellY);
+                                const int32 I10 = Heightfield.VertexIndex(CellX + 1, CellY);
+                                const int32 I11 = Heightfield.VertexIndex(CellX + 1, CellY + 1);
+                                const int32 I01 = Heightfield.VertexIndex(CellX,     CellY + 1);
+
+                                const bool S00 = Heightfield.Solid[I00];
+                                const bool S10 = Heightfield.Solid[I10];
+                                const bool S11 = Heightfield.Solid[I11];
+                                const bool S01 = Heightfield.Solid[I01];
+                                const int32 NumSolid = (int32)S00 + (int32)S10 + (int32)S11 + (int32)S01;
+
+                                if (NumSolid == 0)
+                                {
+                                        continue;
+                                }
+
+                                if (NumSolid == 4)
+                                {
+                                        if (Heightfield.bSolidQuadsUseDiagBLtoTR)
+                                        {
+                                                AddTri(CornerVids[I00], CornerVids[I10], CornerVids[I11]);
+                                                AddTri(CornerVids[I00], CornerVids[I11], CornerVids[I01]);
+                                        }
+                                        else
+                                        {
+                                                AddTri(CornerVids[I00], CornerVids[I10], CornerVids[I01]);
+                                                AddTri(CornerVids[I10], CornerVids[I11], CornerVids[I01]);
+                                        }
+                                        continue;
+                                }
+
+                                if (!Heightfield.bUseMarchingSquares)
+                                {
+                                        continue;
+                                }
+
+                                const int32 CellIndex = Heightfield.CellIndex(CellX, CellY);
+                                while (NextBoundaryCell < Heightfield.BoundaryCells.Num() && Heightfield.BoundaryCells[NextBoundaryCell].CellIndex < CellIndex)
+                                {
+                                        ++NextBoundaryCell;
+                                }
+
+                                if (NextBoundaryCell >= Heightfield.BoundaryCells.Num() || Heightfield.BoundaryCells[NextBoundaryCell].CellIndex != CellIndex)
+                                {
+                                        // Mixed cell without crossings (inconsistent data), left open
+                                        continue;
+                                }
+
+                                BoundaryCell = &Heightfield.BoundaryCells[NextBoundaryCell];
+
+                                Builder_Internal::BuildCellPolygon_MarchingSquares(
+                                        GetEdgeVertex,
+                                        CellX, CellY,
+                                        CornerVids[I00], CornerVids[I10], CornerVids[I11], CornerVids[I01],
+                                        S00, S10, S11, S01,
+                                        Poly);
+
+                                Builder_Internal::TriangulatePolygonFan(Poly, /*bDeterministic=*/true, AddTri);
+                        }
+                }
+
+                // 3) Corners only used by cropped triangles, as the isolated vertex removal of BuildMeshFromSamples
+                if (NumCroppedTriangles > 0)
+                {
+                        Builder_Internal::RemoveIsolatedVertices(OutMesh);
+                }
+
+                // 4) Per-vertex normals from the heightfield, one element per remaining vertex
+                OutMesh.EnableAttributes();
+                UE::Geometry::FDynamicMeshNormalOverlay* Normals = OutMesh.Attributes()->PrimaryNormals();
+                check(Normals && VertexNormals.Num() == OutMesh.MaxVertexID());
+
+                TArray<int32> NormalElementIDs;
+                NormalElementIDs.Init(INDEX_NONE, OutMesh.MaxVertexID());
+                for (int32 Vid : OutMesh.VertexIndicesItr())
+                {
+                        NormalElementIDs[Vid] = Normals->AppendElement(VertexNormals[Vid]);
+                }
+
+                for (int32 Tid : OutMesh.TriangleIndicesItr())
+                {
+                        const FIndex3i T = OutMesh.GetTriangle(Tid);
+                        Normals->SetTriangle(Tid, FIndex3i(NormalElementIDs[T.A], NormalElementIDs[T.B], NormalElementIDs[T.C]));
+                }
+
                 return (OutMesh.TriangleCount() > 0);
         }
 } // namespace WDEditor::PCG
\ No newline at end of file
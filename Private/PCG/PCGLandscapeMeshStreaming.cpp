@@ -0,0 +1,256 @@
+// Copyright BULKHEAD Limited. All Rights Reserved.
+
+#include "PCG/PCGLandscapeMeshStreaming.h"
+
+/* GeometryCore */
+#include "DynamicMesh/DynamicMeshAttributeSet.h"
+#include "IndexTypes.h"
+
+/* Core */
+#include "Math/UnrealMathUtility.h"
+
+using UE::Geometry::FDynamicMesh3;
+using UE::Geometry::FIndex3i;
+
+namespace WDEditor::PCG
+{
+	int64 FPCGLandscapeMeshStreamingState::GetNumGridPoints(const FBox2D& InCropBoundsXY, double InCellSize, int32 InOverscanCells)
+	{
+		const FVector2D Size = InCropBoundsXY.GetSize() + FVector2D(2.0 * FMath::Max(0, InOverscanCells) * InCellSize);
+		const int64 GridX = FMath::Max<int64>(2, (int64)FMath::FloorToDouble(Size.X / InCellSize) + 1);
+		const int64 GridY = FMath::Max<int64>(2, (int64)FMath::FloorToDouble(Size.Y / InCellSize) + 1);
+		return GridX * GridY;
+	}
+
+	bool FPCGLandscapeMeshStreamingState::Init(const FBox2D& InCropBoundsXY, double InCellSize, int32 InOverscanCells, int32 InTileCells, bool bTriangleGroups)
+	{
+		if (!InCropBoundsXY.bIsValid || InCellSize <= 0.0 || GetNumGridPoints(InCropBoundsXY, InCellSize, InOverscanCells) > MaxStreamedGridPoints)
+		{
+			return false;
+		}
+
+		const FVector2D CropSize = InCropBoundsXY.GetSize();
+		const int64 CropCellsX = FMath::Max<int64>(1, (int64)FMath::CeilToDouble(CropSize.X / InCellSize));
+		const int64 CropCellsY = FMath::Max<int64>(1, (int64)FMath::CeilToDouble(CropSize.Y / InCellSize));
+
+		TileCells = FMath::Max(16, InTileCells);
+		NumTilesX = (int32)FMath::DivideAndRoundUp<int64>(CropCellsX, TileCells);
+		NumTilesY = (int32)FMath::DivideAndRoundUp<int64>(CropCellsY, TileCells);
+
+		CropBoundsXY = InCropBoundsXY;
+		CellSize = InCellSize;
+		OverscanCells = FMath::Max(0, InOverscanCells);
+		LatticeMinXY = InCropBoundsXY.Min - FVector2D(OverscanCells * InCellSize);
+		NextTileIndex = 0;
+
+		Mesh.Clear();
+		Mesh.EnableAttributes();
+		if (bTriangleGroups)
+		{
+			Mesh.EnableTriangleGroups();
+		}
+		SeamVertices.Reset();
+		return true;
+	}
+
+	FBox2D FPCGLandscapeMeshStreamingState::GetTileCropBounds(int32 TileIndex) const
+	{
+		const int32 TileX = TileIndex % NumTilesX;
+		const int32 TileY = TileIndex / NumTilesX;
+		const double TileSize = TileCells * CellSize;
+
+		return FBox2D(
+			FVector2D(
+				CropBoundsXY.Min.X + TileX * TileSize,
+				CropBoundsXY.Min.Y + TileY * TileSize),
+			FVector2D(
+				(TileX == NumTilesX - 1) ? CropBoundsXY.Max.X : CropBoundsXY.Min.X + (TileX + 1) * TileSize,
+				(TileY == NumTilesY - 1) ? CropBoundsXY.Max.Y : CropBoundsXY.Min.Y + (TileY + 1) * TileSize));
+	}
+
+	FBox2D FPCGLandscapeMeshStreamingState::GetTileExpandedBounds(int32 TileIndex) const
+	{
+		const FBox2D TileCropXY = GetTileCropBounds(TileIndex);
+		const FVector2D Overscan(OverscanCells * CellSize);
+		return FBox2D(TileCropXY.Min - Overscan, TileCropXY.Max + Overscan);
+	}
+
+	FBox2D FPCGLandscapeMeshStreamingState::GetTileBuildCropBounds(int32 TileIndex, bool bIncludePadding) const
+	{
+		FBox2D BuildCropXY = GetTileCropBounds(TileIndex);
+		if (bIncludePadding)
+		{
+			const int32 TileX = TileIndex % NumTilesX;
+			const int32 TileY = TileIndex / NumTilesX;
+			const double OverscanWorld = OverscanCells * CellSize;
+
+			BuildCropXY.Min.X -= (TileX == 0) ? OverscanWorld : 0.0;
+			BuildCropXY.Min.Y -= (TileY == 0) ? OverscanWorld : 0.0;
+			BuildCropXY.Max.X += (TileX == NumTilesX - 1) ? OverscanWorld : 0.0;
+			BuildCropXY.Max.Y += (TileY == NumTilesY - 1) ? OverscanWorld : 0.0;
+		}
+		return BuildCropXY;
+	}
+
+	bool FPCGLandscapeMeshStreamingState::IsSeamLine(int32 LatticeLine, int32 InNumTiles) const
+	{
+		const int32 Cell = LatticeLine - OverscanCells;
+		return Cell > 0 && Cell % TileCells == 0 && Cell / TileCells < InNumTiles;
+	}
+
+	bool FPCGLandscapeMeshStreamingState::MakeSeamKey(const FVector3d& LocalPosition, FIntVector& OutKey) const
+	{
+		constexpr double Tolerance = 1.0e-3; // in cells
+
+		const FVector2D CropCenter = CropBoundsXY.GetCenter();
+		const double U = (LocalPosition.X + CropCenter.X - LatticeMinXY.X) / CellSize;
+		const double V = (LocalPosition.Y + CropCenter.Y - LatticeMinXY.Y) / CellSize;
+		const int32 RoundU = FMath::RoundToInt32(U);
+		const int32 RoundV = FMath::RoundToInt32(V);
+		const bool bOnLineU = FMath::Abs(U - RoundU) <= Tolerance;
+		const bool bOnLineV = FMath::Abs(V - RoundV) <= Tolerance;
+		const bool bOnSeamU = bOnLineU && IsSeamLine(RoundU, NumTilesX);
+		const bool bOnSeamV = bOnLineV && IsSeamLine(RoundV, NumTilesY);
+
+		if (!bOnSeamU && !bOnSeamV)
+		{
+			return false;
+		}
+
+		if (bOnLineU && bOnLineV)
+		{
+			OutKey = FIntVector(RoundU, RoundV, 0);
+		}
+		else if (bOnSeamU)
+		{
+			OutKey = FIntVector(RoundU, FMath::FloorToInt32(V), 1);
+		}
+		else
+		{
+			OutKey = FIntVector(FMath::FloorToInt32(U), RoundV, 2);
+		}
+		return true;
+	}
+
+	void FPCGLandscapeMeshStreamingState::AppendTile(const FDynamicMesh3& TileMesh, const FVector2D& TileOriginXY, int32 PaddingPolygroupID)
+	{
+		UE::Geometry::FDynamicMeshNormalOverlay* Normals = Mesh.Attributes()->PrimaryNormals();
+		const UE::Geometry::FDynamicMeshNormalOverlay* TileNormals =
+			TileMesh.HasAttributes() ? TileMesh.Attributes()->PrimaryNormals() : nullptr;
+
+		const FVector2D Offset = TileOriginXY - CropBoundsXY.GetCenter();
+		const FBox2D LocalCropBoundsXY = CropBoundsXY.ShiftBy(-CropBoundsXY.GetCenter());
+
+		TArray<int32> VertexMap;
+		VertexMap.Init(INDEX_NONE, TileMesh.MaxVertexID());
+
+		// Vertices are created on first use, so isolated tile vertices are dropped.
+		auto MapVertex = [&](int32 TileVid, int32 TileElement)
+		{
+			int32& Vid = VertexMap[TileVid];
+			if (Vid != INDEX_NONE)
+			{
+				return Vid;
+			}
+
+			const FVector3d Position = TileMesh.GetVertex(TileVid) + FVector3d(Offset.X, Offset.Y, 0.0);
+
+			FIntVector SeamKey;
+			const bool bOnSeam = MakeSeamKey(Position, SeamKey);
+			if (const int32* WeldedVid = bOnSeam ? SeamVertices.Find(SeamKey) : nullptr)
+			{
+				Vid = *WeldedVid;
+				return Vid;
+			}
+
+			Vid = Mesh.AppendVertex(Position);
+			const int32 Nid = Normals->AppendElement(
+				(TileNormals && TileNormals->IsElement(TileElement)) ? TileNormals->GetElement(TileElement) : FVector3f::UnitZ());
+			check(Nid == Vid);
+
+			if (bOnSeam)
+			{
+				SeamVertices.Add(SeamKey, Vid);
+			}
+			return Vid;
+		};
+
+		for (int32 TileTid : TileMesh.TriangleIndicesItr())
+		{
+			const FIndex3i TileTri = TileMesh.GetTriangle(TileTid);
+			const FIndex3i TileElements = TileNormals ? TileNormals->GetTriangle(TileTid) : FIndex3i::Invalid();
+
+			const FIndex3i Tri(
+				MapVertex(TileTri.A, TileElements.A),
+				MapVertex(TileTri.B, TileElements.B),
+				MapVertex(TileTri.C, TileElements.C));
+
+			const int32 Tid = Mesh.AppendTriangle(Tri);
+			if (Tid < 0)
+			{
+				continue;
+			}
+
+			Normals->SetTriangle(Tid, Tri);
+
+			// Padding triangles (outside the region crop bounds) go to the padding polygroup
+			if (PaddingPolygroupID >= 0)
+			{
+				const FVector3d Centroid = Mesh.GetTriCentroid(Tid);
+				if (!LocalCropBoundsXY.IsInside(FVector2D(Centroid.X, Centroid.Y)))
+				{
+					Mesh.SetTriangleGroup(Tid, PaddingPolygroupID);
+				}
+			}
+		}
+	}
+
+	void FPCGLandscapeMeshStreamingState::FinishTile(int32 TileIndex)
+	{
+		const int32 TileX = TileIndex % NumTilesX;
+		const int32 TileY = TileIndex / NumTilesX;
+		if (TileX != NumTilesX - 1)
+		{
+			return;
+		}
+
+		// Later tiles only reach the seam at the bottom of the next tile row and above. Vertical edge
+		// keys store the lattice row below the vertex, which is below that seam for finished rows.
+		const int32 NextRowFirstLine = OverscanCells + (TileY + 1) * TileCells;
+		for (auto It = SeamVertices.CreateIterator(); It; ++It)
+		{
+			if (It.Key().Y < NextRowFirstLine)
+			{
+				It.RemoveCurrent();
+			}
+		}
+	}
+
+	bool BuildStreamingTileFromSamples(
+		FPCGLandscapeMeshStreamingState& State,
+		int32 TileIndex,
+		const FPCGLandscapeMeshGridDesc& TileGridDesc,
+		const FPCGLandscapeMeshBuilderSettings& Settings)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(WDEditor::PCG::BuildStreamingTileFromSamples);
+
+		// Tiles always crop, so neighbours do not overlap. With padding, border tiles keep
+		// the overscan on their outer sides and the padding polygroup is assigned on append.
+		FPCGLandscapeMeshBuilderSettings Build = Settings;
+		Build.bIncludePadding = false;
+		Build.bRemoveIsolatedVertices = true;
+
+		const FBox2D BuildCropXY = State.GetTileBuildCropBounds(TileIndex, Settings.bIncludePadding);
+
+		FDynamicMesh3 TileMesh;
+		FPCGLandscapeMeshConstraints Constraints;
+		if (!BuildMeshFromSamples(TileGridDesc, Build, BuildCropXY, TileMesh, Constraints, nullptr))
+		{
+			return false;
+		}
+
+		const int32 PaddingPolygroupID = Settings.bIncludePadding ? Settings.PaddingPolygroupID : -1;
+		State.AppendTile(TileMesh, BuildCropXY.GetCenter(), PaddingPolygroupID);
+		return true;
+	}
+} // namespace WDEditor::PCG
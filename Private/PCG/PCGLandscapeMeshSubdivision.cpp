@@ -4,6 +4,7 @@
 
 /* Geometry */
 #include "DynamicMesh/DynamicMesh3.h"
+#include "DynamicMesh/MeshNormals.h"
 
 /* Math */
 #include "Math/Vector.h"
@@ -12,62 +13,78 @@
 /* GeometryCore */
 #include "IndexTypes.h"
 
-/* Containers */
-#include "Containers/Map.h"
+/* Async */
+#include "Async/ParallelFor.h"
 
 using UE::Geometry::FDynamicMesh3;
+using UE::Geometry::FIndex2i;
 using UE::Geometry::FIndex3i;
 
 namespace WDEditor::PCG
 {
 namespace Subdivision_Internal
 {
-	static uint64 MakeUndirectedEdgeKey(int32 A, int32 B)
+	/** Below this many items a parallel phase runs on the calling thread. */
+	constexpr int32 MinParallelItems = 1024;
+
+	static FORCEINLINE EParallelForFlags GetParallelFlags(int32 Num)
 	{
-		const uint32 MinV = (uint32)FMath::Min(A, B);
-		const uint32 MaxV = (uint32)FMath::Max(A, B);
-		return (uint64(MinV) << 32) | uint64(MaxV);
+		return (Num < MinParallelItems) ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None;
 	}
 
-	/** Compute simple per-vertex normals (triangle-area weighted). */
+	/**
+	 * Compute simple per-vertex normals (sum of unit face normals).
+	 * Each vertex sums its one-ring in triangle ID order, so the result does not depend on scheduling.
+	 */
 	static void ComputeVertexNormals(
 		const FDynamicMesh3& Mesh,
 		TArray<FVector3d>& OutNormals)
 	{
-		OutNormals.SetNumZeroed(Mesh.MaxVertexID());
+		const int32 MaxTriangleID = Mesh.MaxTriangleID();
+		const int32 MaxVertexID = Mesh.MaxVertexID();
 
-		for (int32 Tid : Mesh.TriangleIndicesItr())
+		TArray<FVector3d> TriangleNormals;
+		TriangleNormals.SetNumUninitialized(MaxTriangleID);
+		ParallelFor(MaxTriangleID, [&Mesh, &TriangleNormals](int32 Tid)
 		{
-			if (!Mesh.IsTriangle(Tid))
+			FVector3d N = FVector3d::ZeroVector;
+			if (Mesh.IsTriangle(Tid))
 			{
-				continue;
-			}
+				const FIndex3i Tri = Mesh.GetTriangle(Tid);
 
-			const FIndex3i Tri = Mesh.GetTriangle(Tid);
+				const FVector3d A = Mesh.GetVertex(Tri.A);
+				const FVector3d B = Mesh.GetVertex(Tri.B);
+				const FVector3d C = Mesh.GetVertex(Tri.C);
 
-			const FVector3d A = Mesh.GetVertex(Tri.A);
-			const FVector3d B = Mesh.GetVertex(Tri.B);
-			const FVector3d C = Mesh.GetVertex(Tri.C);
+				N = (B - A).Cross(C - A);
+				const double Len = N.Length();
+				N = (Len > UE_KINDA_SMALL_NUMBER) ? N / Len : FVector3d::ZeroVector;
+			}
+			TriangleNormals[Tid] = N;
+		}, GetParallelFlags(MaxTriangleID));
 
-			const FVector3d N = (B - A).Cross(C - A);
-			const double Len = N.Length();
-			if (Len > UE_KINDA_SMALL_NUMBER)
+		OutNormals.SetNumUninitialized(MaxVertexID);
+		ParallelFor(MaxVertexID, [&Mesh, &TriangleNormals, &OutNormals](int32 Vid)
+		{
+			FVector3d N = FVector3d::ZeroVector;
+			if (Mesh.IsVertex(Vid))
 			{
-				const FVector3d Nn = N / Len;
-				OutNormals[Tri.A] += Nn;
-				OutNormals[Tri.B] += Nn;
-				OutNormals[Tri.C] += Nn;
+				TArray<int32, TInlineAllocator<16>> VertexTriangles;
+				Mesh.EnumerateVertexTriangles(Vid, [&VertexTriangles](int32 Tid) { VertexTriangles.Add(Tid); });
+				VertexTriangles.Sort();
+
+				for (int32 Tid : VertexTriangles)
+				{
+					N += TriangleNormals[Tid];
+				}
 			}
-		}
 
-		for (int32 Vid : Mesh.VertexIndicesItr())
-		{
-			FVector3d& N = OutNormals[Vid];
 			if (!N.Normalize())
 			{
 				N = FVector3d::UpVector;
 			}
-		}
+			OutNormals[Vid] = N;
+		}, GetParallelFlags(MaxVertexID));
 	}
 
 	static FVector3d PN_EdgeMidpoint(
@@ -89,8 +106,124 @@ namespace Subdivision_Internal
 
 		return M + Strength * (dA - dB) * N;
 	}
+
+	/** Vertices within GuardRing edge hops of a constrained vertex, constrained vertices included. */
+	static void ComputeGuardedVertices(
+		const FDynamicMesh3& Mesh,
+		const FPCGLandscapeMeshConstraints& Constraints,
+		int32 GuardRing,
+		TArray<bool>& OutGuarded)
+	{
+		const int32 MaxVertexID = Mesh.MaxVertexID();
+
+		OutGuarded.SetNumUninitialized(MaxVertexID);
+		ParallelFor(MaxVertexID, [&Constraints, &OutGuarded](int32 Vid)
+		{
+			OutGuarded[Vid] = Constraints.IsVertexConstrained(Vid);
+		}, GetParallelFlags(MaxVertexID));
+
+		TArray<bool> PreviousRing;
+		for (int32 Ring = 0; Ring < GuardRing; ++Ring)
+		{
+			PreviousRing = OutGuarded;
+			ParallelFor(MaxVertexID, [&Mesh, &PreviousRing, &OutGuarded](int32 Vid)
+			{
+				if (PreviousRing[Vid] || !Mesh.IsVertex(Vid))
+				{
+					return;
+				}
+
+				for (const int32 Nbr : Mesh.VtxVerticesItr(Vid))
+				{
+					if (PreviousRing[Nbr])
+					{
+						OutGuarded[Vid] = true;
+						break;
+					}
+				}
+			}, GetParallelFlags(MaxVertexID));
+		}
+	}
+
+	/**
+	 * Sub-triangles of a triangle whose edges (AB, BC, CA) have midpoints M (INDEX_NONE if not split),
+	 * keeping the winding. 1 split edge: 2 triangles, 2: 3 triangles, 3: 4 triangles (regular split).
+	 */
+	static int32 SplitTriangle(const FIndex3i& Tri, const FIndex3i& M, FIndex3i* OutTris)
+	{
+		const int32 NumSplit = (M.A != INDEX_NONE) + (M.B != INDEX_NONE) + (M.C != INDEX_NONE);
+
+		if (NumSplit == 3)
+		{
+			OutTris[0] = FIndex3i(Tri.A, M.A, M.C);
+			OutTris[1] = FIndex3i(M.A, Tri.B, M.B);
+			OutTris[2] = FIndex3i(M.C, M.B, Tri.C);
+			OutTris[3] = FIndex3i(M.A, M.B, M.C);
+			return 4;
+		}
+
+		// Rotate so that edge 0 (P -> Q) is split and, with two splits, edge 1 (Q -> R) is the other one
+		int32 Rotation = 0;
+		for (; Rotation < 3; ++Rotation)
+		{
+			const bool bSplit0 = M[Rotation] != INDEX_NONE;
+			const bool bSplit1 = M[(Rotation + 1) % 3] != INDEX_NONE;
+			if (bSplit0 && (NumSplit == 1 || bSplit1))
+			{
+				break;
+			}
+		}
+		check(Rotation < 3);
+
+		const int32 P = Tri[Rotation];
+		const int32 Q = Tri[(Rotation + 1) % 3];
+		const int32 R = Tri[(Rotation + 2) % 3];
+		const int32 MPQ = M[Rotation];
+
+		if (NumSplit == 1)
+		{
+			OutTris[0] = FIndex3i(P, MPQ, R);
+			OutTris[1] = FIndex3i(MPQ, Q, R);
+			return 2;
+		}
+
+		const int32 MQR = M[(Rotation + 1) % 3];
+		OutTris[0] = FIndex3i(MPQ, Q, MQR);
+		OutTris[1] = FIndex3i(P, MPQ, MQR);
+		OutTris[2] = FIndex3i(P, MQR, R);
+		return 3;
+	}
 }
 
+	void BuildBoundaryConstraints(
+		const FDynamicMesh3& Mesh,
+		bool bConstrainGroupBoundaries,
+		FPCGLandscapeMeshConstraints& OutConstraints)
+	{
+		OutConstraints.ConstrainedVertices.Reset();
+		OutConstraints.ConstrainedEdges.Reset();
+
+		OutConstraints.ConstrainedVertices.Reserve(Mesh.MaxVertexID());
+		OutConstraints.ConstrainedEdges.Reserve(Mesh.MaxEdgeID());
+
+		const bool bUseGroups = bConstrainGroupBoundaries && Mesh.HasTriangleGroups();
+
+		for (int32 Eid : Mesh.EdgeIndicesItr())
+		{
+			const FIndex2i EdgeT = Mesh.GetEdgeT(Eid);
+			const bool bBoundary = (EdgeT.B == FDynamicMesh3::InvalidID);
+			const bool bGroupBoundary = bUseGroups && !bBoundary && Mesh.GetTriangleGroup(EdgeT.A) != Mesh.GetTriangleGroup(EdgeT.B);
+
+			if (bBoundary || bGroupBoundary)
+			{
+				const FIndex2i EdgeV = Mesh.GetEdgeV(Eid);
+				OutConstraints.ConstrainedEdges.Add(Eid);
+				OutConstraints.ConstrainedVertices.Add(EdgeV.A);
+				OutConstraints.ConstrainedVertices.Add(EdgeV.B);
+			}
+		}
+	}
+
 	bool ApplyPNSubdivideInterior(
 		FDynamicMesh3& Mesh,
 		const FPCGLandscapeMeshConstraints& Constraints,
@@ -109,97 +242,269 @@ namespace Subdivision_Internal
 			return false;
 		}
 
+		// Constrained edges are never split, so their vertex pairs survive every level while
+		// their edge IDs do not (triangles around them are rebuilt).
+		TArray<FIndex2i> ConstrainedEdgeVertices;
+		for (const int32 Eid : Constraints.ConstrainedEdges)
+		{
+			if (Mesh.IsEdge(Eid))
+			{
+				ConstrainedEdgeVertices.Add(Mesh.GetEdgeV(Eid));
+			}
+		}
+
+		// Normals of constrained vertices are kept, so partition seams keep matching.
+		TArray<TPair<int32, FVector3f>> ConstrainedVertexNormals;
+		if (Mesh.HasAttributes() && Mesh.Attributes()->PrimaryNormals())
+		{
+			const UE::Geometry::FDynamicMeshNormalOverlay* Normals = Mesh.Attributes()->PrimaryNormals();
+			for (const int32 Vid : Constraints.ConstrainedVertices)
+			{
+				if (!Mesh.IsVertex(Vid))
+				{
+					continue;
+				}
+
+				for (const int32 Tid : Mesh.VtxTrianglesItr(Vid))
+				{
+					const int32 Elem = Normals->GetElementIDAtVertex(Tid, Vid);
+					if (Elem != INDEX_NONE)
+					{
+						ConstrainedVertexNormals.Emplace(Vid, Normals->GetElement(Elem));
+						break;
+					}
+				}
+			}
+		}
+
+		const bool bHasGroups = Mesh.HasTriangleGroups();
+		const bool bHasMaterialIDs = Mesh.HasAttributes() && Mesh.Attributes()->HasMaterialID();
+
 		bool bAnyRefined = false;
 
+		TArray<FVector3d> VertexNormals;
 		for (int32 Level = 0; Level < Settings.SubdivisionLevels; ++Level)
 		{
-			TArray<FVector3d> VertexNormals;
-			Subdivision_Internal::ComputeVertexNormals(Mesh, VertexNormals);
+			TRACE_CPUPROFILER_EVENT_SCOPE(PCGLandscapeMeshSubdivision::Level);
 
-			TMap<uint64, int32> EdgeMidpointVertex;
-			TArray<int32> TrianglesToRefine;
+			const int32 MaxVertexID = Mesh.MaxVertexID();
+			const int32 MaxEdgeID = Mesh.MaxEdgeID();
+			const int32 MaxTriangleID = Mesh.MaxTriangleID();
 
-			for (int32 Tid : Mesh.TriangleIndicesItr())
+			if (Level == 0 || Settings.bRecomputeNormalsEachLevel)
 			{
-				if (!Mesh.IsTriangle(Tid))
-				{
-					continue;
-				}
+				Subdivision_Internal::ComputeVertexNormals(Mesh, VertexNormals);
+			}
 
-				const FIndex3i Tri = Mesh.GetTriangle(Tid);
+			// 1) Classify triangles: refinable if no vertex is constrained or guarded and no edge is constrained
+			TArray<bool> Guarded;
+			Subdivision_Internal::ComputeGuardedVertices(Mesh, Constraints, FMath::Max(0, Settings.ConstraintGuardRing), Guarded);
 
-				if (Constraints.IsVertexConstrained(Tri.A) ||
-					Constraints.IsVertexConstrained(Tri.B) ||
-					Constraints.IsVertexConstrained(Tri.C))
+			TArray<bool> EdgeConstrained;
+			EdgeConstrained.SetNumZeroed(MaxEdgeID);
+			for (const FIndex2i& EdgeV : ConstrainedEdgeVertices)
+			{
+				const int32 Eid = Mesh.FindEdge(EdgeV.A, EdgeV.B);
+				if (Eid != FDynamicMesh3::InvalidID)
 				{
-					continue;
+					EdgeConstrained[Eid] = true;
 				}
+			}
 
-				const FIndex3i TriEdges = Mesh.GetTriEdges(Tid);
-
-				if (Constraints.IsEdgeConstrained(TriEdges.A) ||
-					Constraints.IsEdgeConstrained(TriEdges.B) ||
-					Constraints.IsEdgeConstrained(TriEdges.C))
+			TArray<bool> Refinable;
+			Refinable.SetNumUninitialized(MaxTriangleID);
+			ParallelFor(MaxTriangleID, [&](int32 Tid)
+			{
+				bool bRefinable = Mesh.IsTriangle(Tid);
+				if (bRefinable)
 				{
-					continue;
+					const FIndex3i Tri = Mesh.GetTriangle(Tid);
+					const FIndex3i TriEdges = Mesh.GetTriEdges(Tid);
+					bRefinable =
+						!Guarded[Tri.A] && !Guarded[Tri.B] && !Guarded[Tri.C] &&
+						!EdgeConstrained[TriEdges.A] && !EdgeConstrained[TriEdges.B] && !EdgeConstrained[TriEdges.C];
+				}
+				Refinable[Tid] = bRefinable;
+			}, Subdivision_Internal::GetParallelFlags(MaxTriangleID));
+
+			// 2) Edges to split. With neighbor agreement an edge is split only if every triangle on it is
+			//    refinable, otherwise if any is. Triangles next to split edges get a conforming split, so
+			//    there are never T-junctions.
+			TArray<int32> EdgeMidpointVertex;
+			EdgeMidpointVertex.SetNumUninitialized(MaxEdgeID);
+			ParallelFor(MaxEdgeID, [&](int32 Eid)
+			{
+				bool bSplit = false;
+				if (Mesh.IsEdge(Eid) && !EdgeConstrained[Eid])
+				{
+					const FIndex2i EdgeT = Mesh.GetEdgeT(Eid);
+					const bool bRefinableA = Refinable[EdgeT.A];
+					const bool bRefinableB = (EdgeT.B != FDynamicMesh3::InvalidID) && Refinable[EdgeT.B];
+					const bool bBoundary = (EdgeT.B == FDynamicMesh3::InvalidID);
+
+					bSplit = Settings.bRequireNeighborAgreement
+						? (bRefinableA && (bBoundary || bRefinableB))
+						: (bRefinableA || bRefinableB);
 				}
+				EdgeMidpointVertex[Eid] = bSplit ? 1 : 0;
+			}, Subdivision_Internal::GetParallelFlags(MaxEdgeID));
 
-				TrianglesToRefine.Add(Tid);
+			// New vertex slots in edge ID order (prefix sum)
+			TArray<int32> SplitEdges;
+			for (int32 Eid = 0; Eid < MaxEdgeID; ++Eid)
+			{
+				if (EdgeMidpointVertex[Eid])
+				{
+					SplitEdges.Add(Eid);
+				}
+				EdgeMidpointVertex[Eid] = INDEX_NONE;
 			}
 
-			if (TrianglesToRefine.IsEmpty())
+			if (SplitEdges.IsEmpty())
 			{
 				break;
 			}
 
-			TrianglesToRefine.Sort();
+			// 3) PN midpoints
+			const int32 NumNewVertices = SplitEdges.Num();
+			TArray<FVector3d> MidpointPositions;
+			MidpointPositions.SetNumUninitialized(NumNewVertices);
+			ParallelFor(NumNewVertices, [&](int32 Slot)
+			{
+				const FIndex2i EdgeV = Mesh.GetEdgeV(SplitEdges[Slot]);
+				MidpointPositions[Slot] = Subdivision_Internal::PN_EdgeMidpoint(
+					Mesh.GetVertex(EdgeV.A), VertexNormals[EdgeV.A],
+					Mesh.GetVertex(EdgeV.B), VertexNormals[EdgeV.B],
+					Settings.PNStrength);
+			}, Subdivision_Internal::GetParallelFlags(NumNewVertices));
+
+			// Vertex IDs in slot order (MaxVertexID + Slot on a compact mesh)
+			for (int32 Slot = 0; Slot < NumNewVertices; ++Slot)
+			{
+				EdgeMidpointVertex[SplitEdges[Slot]] = Mesh.AppendVertex(MidpointPositions[Slot]);
+			}
 
-			for (int32 Tid : TrianglesToRefine)
+			if (!Settings.bRecomputeNormalsEachLevel)
+			{
+				VertexNormals.SetNum(Mesh.MaxVertexID());
+				for (int32 Slot = 0; Slot < NumNewVertices; ++Slot)
+				{
+					const FIndex2i EdgeV = Mesh.GetEdgeV(SplitEdges[Slot]);
+					FVector3d N = VertexNormals[EdgeV.A] + VertexNormals[EdgeV.B];
+					VertexNormals[EdgeMidpointVertex[SplitEdges[Slot]]] = N.Normalize() ? N : FVector3d::UpVector;
+				}
+			}
+
+			Stats.NumVerticesAdded += NumNewVertices;
+
+			// 4) Rebuild the triangles with split edges, in triangle ID order
+			TArray<int32> SplitTriangles;
+			TArray<int32> SubTriangleOffsets;
+			int32 NumSubTriangles = 0;
+			for (int32 Tid = 0; Tid < MaxTriangleID; ++Tid)
 			{
 				if (!Mesh.IsTriangle(Tid))
 				{
 					continue;
 				}
 
-				const FIndex3i Tri = Mesh.GetTriangle(Tid);
-				const int32 A = Tri.A;
-				const int32 B = Tri.B;
-				const int32 C = Tri.C;
+				const FIndex3i TriEdges = Mesh.GetTriEdges(Tid);
+				const int32 NumSplit =
+					(EdgeMidpointVertex[TriEdges.A] != INDEX_NONE) +
+					(EdgeMidpointVertex[TriEdges.B] != INDEX_NONE) +
+					(EdgeMidpointVertex[TriEdges.C] != INDEX_NONE);
 
-				auto GetMidpoint = [&](int32 V0, int32 V1) -> int32
+				if (NumSplit > 0)
 				{
-					const uint64 Key = Subdivision_Internal::MakeUndirectedEdgeKey(V0, V1);
-					if (const int32* Found = EdgeMidpointVertex.Find(Key))
+					SplitTriangles.Add(Tid);
+					SubTriangleOffsets.Add(NumSubTriangles);
+					NumSubTriangles += NumSplit + 1;
+				}
+			}
+
+			TArray<FIndex3i> SubTriangles;
+			SubTriangles.SetNumUninitialized(NumSubTriangles);
+			ParallelFor(SplitTriangles.Num(), [&](int32 Index)
+			{
+				const int32 Tid = SplitTriangles[Index];
+				const FIndex3i TriEdges = Mesh.GetTriEdges(Tid);
+				const FIndex3i Midpoints(
+					EdgeMidpointVertex[TriEdges.A],
+					EdgeMidpointVertex[TriEdges.B],
+					EdgeMidpointVertex[TriEdges.C]);
+
+				Subdivision_Internal::SplitTriangle(Mesh.GetTriangle(Tid), Midpoints, &SubTriangles[SubTriangleOffsets[Index]]);
+			}, Subdivision_Internal::GetParallelFlags(SplitTriangles.Num()));
+
+			TArray<int32> ParentGroups;
+			TArray<int32> ParentMaterialIDs;
+			ParentGroups.SetNumUninitialized(SplitTriangles.Num());
+			ParentMaterialIDs.SetNumUninitialized(SplitTriangles.Num());
+			for (int32 Index = 0; Index < SplitTriangles.Num(); ++Index)
+			{
+				const int32 Tid = SplitTriangles[Index];
+				ParentGroups[Index] = bHasGroups ? Mesh.GetTriangleGroup(Tid) : 0;
+				ParentMaterialIDs[Index] = bHasMaterialIDs ? Mesh.Attributes()->GetMaterialID()->GetValue(Tid) : 0;
+			}
+
+			for (const int32 Tid : SplitTriangles)
+			{
+				Mesh.RemoveTriangle(Tid, /*bRemoveIsolatedVertices=*/false);
+			}
+
+			for (int32 Index = 0; Index < SplitTriangles.Num(); ++Index)
+			{
+				const int32 End = (Index + 1 < SplitTriangles.Num()) ? SubTriangleOffsets[Index + 1] : NumSubTriangles;
+				for (int32 Sub = SubTriangleOffsets[Index]; Sub < End; ++Sub)
+				{
+					const int32 NewTid = Mesh.AppendTriangle(SubTriangles[Sub], ParentGroups[Index]);
+					if (NewTid >= 0 && bHasMaterialIDs)
 					{
-						return *Found;
+						Mesh.Attributes()->GetMaterialID()->SetValue(NewTid, ParentMaterialIDs[Index]);
 					}
+				}
+			}
 
-					const FVector3d P =
-						Subdivision_Internal::PN_EdgeMidpoint(
-							Mesh.GetVertex(V0), VertexNormals[V0],
-							Mesh.GetVertex(V1), VertexNormals[V1],
-							Settings.PNStrength);
-
-					const int32 NewVid = Mesh.AppendVertex(P);
-					EdgeMidpointVertex.Add(Key, NewVid);
-					Stats.NumVerticesAdded++;
-					return NewVid;
-				};
+			Stats.NumTrianglesRefined += SplitTriangles.Num();
+			Stats.NumTrianglesAdded += NumSubTriangles;
+			bAnyRefined = true;
+		}
 
-				const int32 AB = GetMidpoint(A, B);
-				const int32 BC = GetMidpoint(B, C);
-				const int32 CA = GetMidpoint(C, A);
+		// Per-vertex normals for the new topology, constrained vertices keep their previous normal
+		if (bAnyRefined && (Settings.bEnsureNormalOverlay || Mesh.HasAttributes()))
+		{
+			if (!Mesh.HasAttributes())
+			{
+				Mesh.EnableAttributes();
+			}
 
-				Mesh.RemoveTriangle(Tid, false);
+			UE::Geometry::FDynamicMeshNormalOverlay* Normals = Mesh.Attributes()->PrimaryNormals();
+			if (!Normals)
+			{
+				Mesh.Attributes()->SetNumNormalLayers(1);
+				Normals = Mesh.Attributes()->PrimaryNormals();
+			}
 
-				Mesh.AppendTriangle(A,  AB, CA);
-				Mesh.AppendTriangle(AB, B,  BC);
-				Mesh.AppendTriangle(CA, BC, C);
-				Mesh.AppendTriangle(AB, BC, CA);
+			UE::Geometry::FMeshNormals::InitializeOverlayToPerVertexNormals(Normals, /*bUseMeshVertexNormalsIfAvailable=*/false);
+			UE::Geometry::FMeshNormals::QuickRecomputeOverlayNormals(
+				Mesh,
+				/*bInvert=*/false,
+				/*bWeightByArea=*/true,
+				/*bWeightByAngle=*/true,
+				/*bParallelCompute=*/true);
 
-				Stats.NumTrianglesRefined++;
-				Stats.NumTrianglesAdded += 4;
-				bAnyRefined = true;
+			for (const TPair<int32, FVector3f>& VertexNormal : ConstrainedVertexNormals)
+			{
+				for (const int32 Tid : Mesh.VtxTrianglesItr(VertexNormal.Key))
+				{
+					const int32 Elem = Normals->GetElementIDAtVertex(Tid, VertexNormal.Key);
+					if (Elem != INDEX_NONE)
+					{
+						// Per-vertex overlay: one element per vertex
+						Normals->SetElement(Elem, VertexNormal.Value);
+						break;
+					}
+				}
 			}
 		}
 
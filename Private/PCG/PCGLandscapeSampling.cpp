@@ -5,11 +5,8 @@
  #include "Data/PCGLandscapeData.h"
 #include "Data/PCGPointData.h"
 
-// Additional includes for metadata access when sampling layer weights
-#include "Metadata/PCGMetadata.h"
-#include "Metadata/PCGMetadataCommon.h"
-// Include spatial data for initializing metadata from a source
-#include "Data/PCGSpatialData.h"
+/* Async */
+#include "Async/ParallelFor.h"
  
  namespace WDEditor::PCG
  {
@@ -29,7 +26,11 @@
                          0.0);
          }
  
-         bool SampleLandscapeToGrid(
+         // ------------------------------------------------------------
+         // Batched path: one UPCGLandscapeData::SampleGrid call for the
+         // whole lattice, then a parallel SoA -> sample conversion.
+         // ------------------------------------------------------------
+         static bool SampleLandscapeToGrid_Batched(
                  const UPCGLandscapeData* LandscapeData,
                  const FBox2D& ExpandedBoundsXY,
                  int32 GridX,
@@ -37,11 +38,74 @@
                  const FPCGLandscapeSamplingSettings& Settings,
                  TArray<FPCGLandscapeGridSample>& OutSamples)
          {
-                 if (!LandscapeData || GridX < 1 || GridY < 1)
+                 TRACE_CPUPROFILER_EVENT_SCOPE(WDEditor::PCG::SampleLandscapeToGrid_Batched);
+
+                 FPCGLandscapeGridSamplingParams Params;
+                 Params.GridMin = FVector2D(ExpandedBoundsXY.Min);
+                 Params.CellSize = Settings.CellSize;
+                 Params.GridX = GridX;
+                 Params.GridY = GridY;
+                 Params.bSampleNormals = Settings.bSampleNormals;
+                 Params.LayerName = Settings.MaskLayerName;
+
+                 FPCGLandscapeGridSamples Sampled;
+                 if (!LandscapeData->SampleGrid(Params, Sampled))
                  {
                          return false;
                  }
- 
+
+                 OutSamples.SetNumUninitialized(GridX * GridY);
+
+                 // Same mask rules as the per-point path: layer weight when the layer exists,
+                 // density (1 on hit, 0 on miss) otherwise.
+                 const bool bUseLayer = Sampled.bHasLayer;
+
+                 ParallelFor(GridY, [&](int32 Y)
+                 {
+                         for (int32 X = 0; X < GridX; ++X)
+                         {
+                                 const int32 Index = X + Y * GridX;
+                                 FPCGLandscapeGridSample& Sample = OutSamples[Index];
+
+                                 if (!Sampled.Hits[Index])
+                                 {
+                                         Sample.Height = 0.0;
+                                         Sample.Normal = FVector3d::UpVector;
+                                         Sample.Mask   = 0.0f;
+                                         continue;
+                                 }
+
+                                 Sample.Height = Sampled.Heights[Index];
+                                 Sample.Normal = Settings.bSampleNormals
+                                         ? FVector3d(Sampled.Normals[Index])
+                                         : FVector3d::UpVector;
+
+                                 float MaskValue = bUseLayer ? Sampled.LayerWeights[Index] : 1.0f;
+                                 if (Settings.bInvertMask)
+                                 {
+                                         MaskValue = 1.0f - MaskValue;
+                                 }
+                                 Sample.Mask = FMath::Clamp(MaskValue, 0.0f, 1.0f);
+                         }
+                 });
+
+                 return true;
+         }
+
+         // ------------------------------------------------------------
+         // Per-point path: one ProjectPoint per vertex. Kept as a fallback
+         // and as the reference for the batched path.
+         // ------------------------------------------------------------
+         static bool SampleLandscapeToGrid_PerPoint(
+                 const UPCGLandscapeData* LandscapeData,
+                 const FBox2D& ExpandedBoundsXY,
+                 int32 GridX,
+                 int32 GridY,
+                 const FPCGLandscapeSamplingSettings& Settings,
+                 TArray<FPCGLandscapeGridSample>& OutSamples)
+         {
+                 TRACE_CPUPROFILER_EVENT_SCOPE(WDEditor::PCG::SampleLandscapeToGrid_PerPoint);
+
                  OutSamples.SetNum(GridX * GridY);
  
                  // Use ProjectPoint – SamplePoint does NOT project to surface
@@ -54,28 +118,10 @@
                  ProjectionParams.bProjectRotations = true;
                  ProjectionParams.bProjectScales    = false;
  
-    // If the caller requested a landscape layer mask, allocate a single metadata container
-    // up front and initialize it from the landscape. This avoids allocating new UObjects
-    // during GC and allows reuse of the same metadata throughout the grid sampling. If
-    // MaskLayerName is NAME_None, we will leave MetadataPtr null and fall back to density.
-    UPCGMetadata* MetadataPtr = nullptr;
-    const bool bUseLayerMask = !Settings.MaskLayerName.IsNone();
-    if (bUseLayerMask)
-    {
-        // Allocate a new metadata container. Use NewObject without specifying an Outer to
-        // create a transient UObject. This allocation happens once, outside the sampling
-        // loops, so it is safe with respect to GC.
-        MetadataPtr = NewObject<UPCGMetadata>();
-
-        // Initialize metadata attributes for this landscape. InitializeTargetMetadata will
-        // populate the metadata with all layer names defined on the landscape so that
-        // ProjectPoint can fill weight values. Use FPCGInitializeFromDataParams with
-        // the landscape data as the source, and ensure metadata and attributes are inherited.
-        FPCGInitializeFromDataParams InitParams(LandscapeData);
-        InitParams.bInheritMetadata = true;
-        InitParams.bInheritAttributes = true;
-        LandscapeData->InitializeTargetMetadata(InitParams, MetadataPtr);
-    }
+    // Layer masks are read straight from the landscape cache, so no metadata container
+    // or per-sample metadata entry is needed. If the layer is not available, fall back
+    // to density like the batched path.
+    const bool bUseLayerMask = LandscapeData->HasLayerWeight(Settings.MaskLayerName);
 
     for (int32 Y = 0; Y < GridY; ++Y)
     {
@@ -97,17 +143,13 @@
                                          FVector(WorldPos.X, WorldPos.Y, 0.0));
  
             FPCGPoint Point;
-            // Decide whether to request metadata based on MaskLayerName. If we need a layer mask,
-            // pass the pre-allocated MetadataPtr to collect layer weights. Otherwise, pass
-            // nullptr to avoid unnecessary metadata writes.
-            UPCGMetadata* OutMetadata = bUseLayerMask ? MetadataPtr : nullptr;
             const bool bHit =
                 LandscapeData->ProjectPoint(
                     QueryTransform,
                     QueryBounds,
                     ProjectionParams,
                     Point,
-                    /*OutMetadata=*/OutMetadata);
+                    /*OutMetadata=*/nullptr);
  
                                  if (!bHit)
                                  {
@@ -135,30 +177,16 @@
                                  }
  
             // --------------------------------------------------------------
-            // Mask sampling: if MaskLayerName is specified and metadata is available,
-            // read the layer weight from the metadata. Otherwise, use density.
+            // Mask sampling: if a layer mask is available, read the single
+            // layer weight from the cache. Otherwise, use density.
             // --------------------------------------------------------------
             float MaskValue = 0.0f;
-            if (bUseLayerMask && MetadataPtr)
+            if (bUseLayerMask)
             {
-                // Read the layer attribute from the initialized metadata using
-                // the projected point's MetadataEntry. Note: Attribute can be null
-                // if the layer does not exist or is not enabled on this landscape.
-                const auto* Attribute = MetadataPtr->GetConstTypedAttribute<float>(
-                    FPCGAttributeIdentifier(Settings.MaskLayerName));
-                if (Attribute && Point.MetadataEntry != PCGInvalidEntryKey)
-                {
-                    MaskValue = Attribute->GetValueFromItemKey(Point.MetadataEntry);
-                }
-                else
-                {
-                    // Fallback to density if attribute is missing or point has no metadata entry
-                    MaskValue = FMath::Clamp(Point.Density, 0.0f, 1.0f);
-                }
+                LandscapeData->SampleLayerWeight(QueryTransform.GetLocation(), Settings.MaskLayerName, MaskValue);
             }
             else
             {
-                // No mask layer specified or metadata disabled; use density
                 MaskValue = FMath::Clamp(Point.Density, 0.0f, 1.0f);
             }
 
@@ -173,4 +201,22 @@
  
                  return true;
          }
+
+         bool SampleLandscapeToGrid(
+                 const UPCGLandscapeData* LandscapeData,
+                 const FBox2D& ExpandedBoundsXY,
+                 int32 GridX,
+                 int32 GridY,
+                 const FPCGLandscapeSamplingSettings& Settings,
+                 TArray<FPCGLandscapeGridSample>& OutSamples)
+         {
+                 if (!LandscapeData || GridX < 1 || GridY < 1)
+                 {
+                         return false;
+                 }
+
+                 return Settings.bUseBatchedSampling
+                         ? SampleLandscapeToGrid_Batched(LandscapeData, ExpandedBoundsXY, GridX, GridY, Settings, OutSamples)
+                         : SampleLandscapeToGrid_PerPoint(LandscapeData, ExpandedBoundsXY, GridX, GridY, Settings, OutSamples);
+         }
  }
\ No newline at end of file
@@ -14,10 +14,13 @@
  /* Geometry */
  #include "UDynamicMesh.h"
  #include "DynamicMesh/DynamicMesh3.h"
+#include "DynamicMesh/DynamicMeshAttributeSet.h"
  
  /* WDEditor */
  #include "PCG/PCGLandscapeSampling.h"
  #include "PCG/PCGLandscapeMeshBuilder.h"
+#include "PCG/PCGLandscapeMeshStreaming.h"
+#include "PCG/PCGLandscapeHeightfieldData.h"
 
 // Materials
 #include "Materials/MaterialInterface.h"
@@ -43,17 +46,179 @@
  TArray<FPCGPinProperties> UPCGLandscapeToDynamicMeshSettings::OutputPinProperties() const
  {
          TArray<FPCGPinProperties> Pins;
-         Pins.Emplace(PCGPinConstants::DefaultOutputLabel, EPCGDataType::DynamicMesh);
+         // Heightfield data is typed Other, see UPCGLandscapeHeightfieldData
+         Pins.Emplace(PCGPinConstants::DefaultOutputLabel, bOutputHeightfield ? EPCGDataType::Other : EPCGDataType::DynamicMesh);
          return Pins;
  }
  
  namespace
  {
+        using UE::Geometry::FDynamicMesh3;
+        using UE::Geometry::FIndex3i;
+
+        constexpr int64 MaxGridPoints = 16ll * 1024ll * 1024ll; // 16 million (safe upper bound)
+
+        struct FPCGLandscapeToDynamicMeshContext : public FPCGContext
+        {
+                bool bStreaming = false;
+                TObjectPtr<UPCGDynamicMeshData> OutMeshData = nullptr;
+                TSet<FString> OutTags;
+                WDEditor::PCG::FPCGLandscapeMeshStreamingState Streaming;
+
+        protected:
+                virtual void AddExtraStructReferencedObjects(FReferenceCollector& Collector) override
+                {
+                        if (OutMeshData)
+                        {
+                                Collector.AddReferencedObject(OutMeshData);
+                        }
+                }
+        };
+
          class FPCGLandscapeToDynamicMeshElement final : public IPCGDynamicMeshBaseElement
          {
+        public:
+                virtual FPCGContext* CreateContext() override { return new FPCGLandscapeToDynamicMeshContext(); }
+
          protected:
                  virtual bool ExecuteInternal(FPCGContext* Context) const override;
+
+        private:
+                /** Meshes the remaining streaming tiles until the time slice runs out. True when the output was emitted. */
+                bool ExecuteStreaming(FPCGLandscapeToDynamicMeshContext* Context, const UPCGLandscapeToDynamicMeshSettings* Settings, uint32 CachedGridSize) const;
          };
+
+        static WDEditor::PCG::FPCGLandscapeSamplingSettings MakeSamplingSettings(const UPCGLandscapeToDynamicMeshSettings& Settings, double CellSize)
+        {
+                WDEditor::PCG::FPCGLandscapeSamplingSettings Samp;
+                Samp.CellSize = CellSize;
+                Samp.MaskLayerName = Settings.MaskLayerName;
+                Samp.bSampleNormals = true;
+                // Propagate inversion flag to sampling settings
+                Samp.bInvertMask = Settings.bInvertMask;
+                Samp.bUseBatchedSampling = Settings.bUseBatchedSampling;
+                return Samp;
+        }
+
+
+        static WDEditor::PCG::FPCGLandscapeMeshBuilderSettings MakeBuilderSettings(const UPCGLandscapeToDynamicMeshSettings& Settings, double CellSize)
+        {
+                WDEditor::PCG::FPCGLandscapeMeshBuilderSettings Build;
+                Build.CellSize = CellSize;
+                Build.MaskThreshold = Settings.MaskThreshold;
+                Build.bUseMarchingSquares = Settings.bUseMarchingSquares;
+                Build.bUseTiledBuild = Settings.bUseTiledBuild;
+                // Subdivision settings have been deprecated in this node. Refinement should be handled
+                // by a separate subdivision node. The build settings related to subdivision are left
+                // at their defaults. We continue to set removal and compaction flags.
+                Build.bRemoveIsolatedVertices = Settings.bRemoveIsolatedVertices;
+                // Do not alter bConstrainCropBoundary based on subdivision. Always constrain the crop
+                // boundary so that the mesh matches the landscape bounds.
+                Build.bConstrainCropBoundary = true;
+
+                // Padding: include overscan padding faces and assign them to a separate polygroup
+                Build.bIncludePadding = Settings.bIncludePadding;
+                Build.PaddingPolygroupID = Settings.PaddingPolygroupID;
+                return Build;
+        }
+
+        /** Assigns the material, then moves BuiltMesh into the output with the final compaction and Z offset. */
+        static void WriteMeshToOutput(
+                const UPCGLandscapeToDynamicMeshSettings& Settings,
+                UPCGDynamicMeshData* OutMeshData,
+                FDynamicMesh3&& BuiltMesh,
+                uint32 CachedGridSize)
+        {
+                // ============================================================
+                // Assign material to the dynamic mesh data
+                // ============================================================
+                // If a material is specified in the settings, assign it to the output mesh. Note that
+                // SetMaterials expects an array of materials corresponding to material slots on the
+                // dynamic mesh. We only assign a single material slot here.
+                if (Settings.Material)
+                {
+                        TArray<UMaterialInterface*> MatArray;
+                        MatArray.Add(Settings.Material);
+                        OutMeshData->SetMaterials(MatArray);
+                }
+
+                // ============================================================
+                // Write result
+                // ============================================================
+
+                UDynamicMesh* DynMesh = OutMeshData->GetMutableDynamicMesh();
+                check(DynMesh);
+
+                DynMesh->EditMesh(
+                        [&](FDynamicMesh3& Mesh)
+                        {
+                                // Move the freshly built mesh into the dynamic mesh
+                                Mesh = MoveTemp(BuiltMesh);
+
+                                // Optional: compact the mesh to remove unused vertices/attributes
+                                if (Settings.bCompactAtEnd)
+                                {
+                                        Mesh.CompactInPlace();
+                                }
+
+                                // Apply a vertical offset to the mesh to align it with the landscape.
+                                // We subtract half of the partition grid size along Z so that the
+                                // generated mesh sits correctly on top of the landscape tile.  The
+                                // offset is only applied if a valid grid size was retrieved.  Because
+                                // FDynamicMesh3 in UE5.6 does not provide a Translate() method, we
+                                // manually adjust each vertex position.
+                                if (CachedGridSize > 0)
+                                {
+                                        const double OffsetZ = -0.5 * static_cast<double>(CachedGridSize);
+                                        for (int32 Vid : Mesh.VertexIndicesItr())
+                                        {
+                                                FVector3d Position = Mesh.GetVertex(Vid);
+                                                Position.Z += OffsetZ;
+                                                Mesh.SetVertex(Vid, Position);
+                                        }
+                                }
+                        },
+                        EDynamicMeshChangeType::GeneralEdit,
+                        EDynamicMeshAttributeChangeFlags::Unknown,
+                        true);
+        }
+
+        /** Samples and meshes one tile, then welds it into the streamed mesh. Tile memory is released on return. */
+        static void MeshStreamingTile(
+                WDEditor::PCG::FPCGLandscapeMeshStreamingState& State,
+                const UPCGLandscapeToDynamicMeshSettings& Settings,
+                const UPCGLandscapeData* LandscapeData,
+                int32 TileIndex)
+        {
+                TRACE_CPUPROFILER_EVENT_SCOPE(PCGLandscapeToDynamicMesh::MeshStreamingTile);
+
+                const double CellSize = State.CellSize;
+                const FBox2D TileExpandedXY = State.GetTileExpandedBounds(TileIndex);
+
+                const FVector2D Size = TileExpandedXY.GetSize();
+                const int32 GridX = FMath::Max(2, FMath::FloorToInt(Size.X / CellSize) + 1);
+                const int32 GridY = FMath::Max(2, FMath::FloorToInt(Size.Y / CellSize) + 1);
+
+                TArray<WDEditor::PCG::FPCGLandscapeGridSample> Samples;
+                if (WDEditor::PCG::SampleLandscapeToGrid(
+                                LandscapeData,
+                                TileExpandedXY,
+                                GridX,
+                                GridY,
+                                MakeSamplingSettings(Settings, CellSize),
+                                Samples))
+                {
+                        WDEditor::PCG::FPCGLandscapeMeshGridDesc GridDesc;
+                        GridDesc.GridX = GridX;
+                        GridDesc.GridY = GridY;
+                        GridDesc.GridMinXY = TileExpandedXY.Min;
+                        GridDesc.Samples = &Samples;
+
+                        WDEditor::PCG::BuildStreamingTileFromSamples(State, TileIndex, GridDesc, MakeBuilderSettings(Settings, CellSize));
+                }
+
+                State.FinishTile(TileIndex);
+        }
  }
  
  FPCGElementPtr UPCGLandscapeToDynamicMeshSettings::CreateElement() const
@@ -61,8 +226,11 @@
          return MakeShared<FPCGLandscapeToDynamicMeshElement>();
  }
  
- bool FPCGLandscapeToDynamicMeshElement::ExecuteInternal(FPCGContext* Context) const
+ bool FPCGLandscapeToDynamicMeshElement::ExecuteInternal(FPCGContext* InContext) const
  {
+        FPCGLandscapeToDynamicMeshContext* Context = static_cast<FPCGLandscapeToDynamicMeshContext*>(InContext);
+        check(Context);
+
         const auto* Settings =
                 Context->GetInputSettings<UPCGLandscapeToDynamicMeshSettings>();
          check(Settings);
@@ -93,6 +261,12 @@
                         CachedGridSize = PCGComp->GetGenerationGridSize();
                 }
         }
+
+        // Resumed time slice of a streaming build
+        if (Context->bStreaming)
+        {
+                return ExecuteStreaming(Context, Settings, CachedGridSize);
+        }
  
          const auto LandscapeInputs =
                  Context->InputData.GetInputsByPin(
@@ -224,19 +398,49 @@
          ExpandedBoundsXY.Min -= FVector2D((float)OverscanWorld);
          ExpandedBoundsXY.Max += FVector2D((float)OverscanWorld);
  
+         // Grid size in int64: oversized regions must not overflow before the checks below
          const FVector2D Size = ExpandedBoundsXY.GetSize();
-         const int32 GridX =
-                 FMath::Max(2, FMath::FloorToInt(Size.X / CellSize) + 1);
-         const int32 GridY =
-                 FMath::Max(2, FMath::FloorToInt(Size.Y / CellSize) + 1);
+         const int64 GridX64 =
+                 FMath::Max<int64>(2, (int64)FMath::FloorToDouble(Size.X / CellSize) + 1);
+         const int64 GridY64 =
+                 FMath::Max<int64>(2, (int64)FMath::FloorToDouble(Size.Y / CellSize) + 1);
          // ============================================================
          // Safety: prevent insane allocations
          // ============================================================
  
-         constexpr int64 MaxGridPoints = 16ll * 1024ll * 1024ll; // 16 million (safe upper bound)
- 
-         const int64 TotalPoints = (int64)GridX * (int64)GridY;
-         if (TotalPoints <= 0 || TotalPoints > MaxGridPoints)
+         const int64 TotalPoints = GridX64 * GridY64;
+         if (TotalPoints > MaxGridPoints
+                 && Settings->bStreamLargeRegions
+                 && !Settings->bOutputHeightfield)
+         {
+                 // Streaming bounds the working memory, not the output: very large regions are still refused
+                 const bool bTriangleGroups = Settings->bIncludePadding && Settings->PaddingPolygroupID >= 0;
+                 if (TotalPoints > WDEditor::PCG::MaxStreamedGridPoints
+                         || !Context->Streaming.Init(CropBoundsXY, CellSize, Settings->OverscanCells, Settings->StreamingTileCells, bTriangleGroups))
+                 {
+                         PCGE_LOG_C(Error, GraphAndLog, Context, FText::Format(
+                                 NSLOCTEXT("WDEditor", "LandscapeToDynamicMesh_RegionTooLarge",
+                                         "Region too large to mesh ({0} grid points, the streaming limit is {1}). Increase the cell size or reduce the bounds."),
+                                 FText::AsNumber(TotalPoints),
+                                 FText::AsNumber(WDEditor::PCG::MaxStreamedGridPoints)));
+
+                         EmitOutput();
+                         return true;
+                 }
+
+                 UE_LOG(LogPCG, Log,
+                         TEXT("PCGLandscapeToDynamicMesh: Grid too large for a single build (%lld points), streaming %dx%d tiles."),
+                         TotalPoints,
+                         Context->Streaming.NumTilesX,
+                         Context->Streaming.NumTilesY);
+
+                 Context->bStreaming = true;
+                 Context->OutMeshData = OutMeshData;
+                 Context->OutTags = MeshInputs[0].Tags;
+                 return ExecuteStreaming(Context, Settings, CachedGridSize);
+         }
+
+         if (TotalPoints > MaxGridPoints)
          {
                  UE_LOG(LogPCG, Warning,
                          TEXT("PCGLandscapeToDynamicMesh: Aborting build. Grid too large (%lld points). "
@@ -248,17 +452,15 @@
                  EmitOutput();
                  return true;
          }
+
+         const int32 GridX = (int32)GridX64;
+         const int32 GridY = (int32)GridY64;
  
          // ============================================================
          // Sample landscape
          // ============================================================
  
-         WDEditor::PCG::FPCGLandscapeSamplingSettings Samp;
-         Samp.CellSize = CellSize;
-         Samp.MaskLayerName = Settings->MaskLayerName;
-         Samp.bSampleNormals = true;
-         // Propagate inversion flag to sampling settings
-         Samp.bInvertMask = Settings->bInvertMask;
+         const WDEditor::PCG::FPCGLandscapeSamplingSettings Samp = MakeSamplingSettings(*Settings, CellSize);
  
          TArray<WDEditor::PCG::FPCGLandscapeGridSample> Samples;
          if (!WDEditor::PCG::SampleLandscapeToGrid(
@@ -283,21 +485,44 @@
          GridDesc.GridMinXY = ExpandedBoundsXY.Min;
          GridDesc.Samples = &Samples;
  
-         WDEditor::PCG::FPCGLandscapeMeshBuilderSettings Build;
-         Build.CellSize = CellSize;
-         Build.MaskThreshold = Settings->MaskThreshold;
-         Build.bUseMarchingSquares = Settings->bUseMarchingSquares;
-        // Subdivision settings have been deprecated in this node. Refinement should be handled
-        // by a separate subdivision node. The build settings related to subdivision are left
-        // at their defaults. We continue to set removal and compaction flags.
-        Build.bRemoveIsolatedVertices = Settings->bRemoveIsolatedVertices;
-        // Do not alter bConstrainCropBoundary based on subdivision. Always constrain the crop
-        // boundary so that the mesh matches the landscape bounds.
-        Build.bConstrainCropBoundary = true;
-
-        // Padding: include overscan padding faces and assign them to a separate polygroup
-        Build.bIncludePadding = Settings->bIncludePadding;
-        Build.PaddingPolygroupID = Settings->PaddingPolygroupID;
+         const WDEditor::PCG::FPCGLandscapeMeshBuilderSettings Build = MakeBuilderSettings(*Settings, CellSize);
+
+         if (Settings->bOutputHeightfield)
+         {
+                 WDEditor::PCG::FPCGLandscapeHeightfield Heightfield;
+                 if (!WDEditor::PCG::BuildHeightfieldFromSamples(GridDesc, Build, CropBoundsXY, Heightfield))
+                 {
+                         EmitOutput();
+                         return true;
+                 }
+
+                 // Same vertical offset as WriteMeshToOutput
+                 if (CachedGridSize > 0)
+                 {
+                         const float OffsetZ = -0.5f * static_cast<float>(CachedGridSize);
+                         for (float& Height : Heightfield.Heights)
+                         {
+                                 Height += OffsetZ;
+                         }
+                 }
+
+                 UE_LOG(LogPCG, Verbose,
+                         TEXT("PCGLandscapeToDynamicMesh: Heightfield %dx%d, %d boundary cells, %.2f MB."),
+                         Heightfield.GridX,
+                         Heightfield.GridY,
+                         Heightfield.BoundaryCells.Num(),
+                         Heightfield.GetAllocatedSize() / (1024.0 * 1024.0));
+
+                 UPCGLandscapeHeightfieldData* HeightfieldData =
+                         FPCGContext::NewObject_AnyThread<UPCGLandscapeHeightfieldData>(Context);
+                 HeightfieldData->Initialize(MoveTemp(Heightfield), Settings->Material);
+
+                 FPCGTaggedData& Out = Context->OutputData.TaggedData.Emplace_GetRef();
+                 Out.Data = HeightfieldData;
+                 Out.Pin  = PCGPinConstants::DefaultOutputLabel;
+                 Out.Tags = MeshInputs[0].Tags;
+                 return true;
+         }
  
          UE::Geometry::FDynamicMesh3 BuiltMesh;
          WDEditor::PCG::FPCGLandscapeMeshConstraints Constraints;
@@ -314,59 +539,51 @@
                  return true;
          }
 
-        // ============================================================
-        // Assign material to the dynamic mesh data
-        // ============================================================
-        // If a material is specified in the settings, assign it to the output mesh. Note that
-        // SetMaterials expects an array of materials corresponding to material slots on the
-        // dynamic mesh. We only assign a single material slot here.
-        if (Settings->Material)
-        {
-            TArray<UMaterialInterface*> MatArray;
-            MatArray.Add(Settings->Material);
-            OutMeshData->SetMaterials(MatArray);
-        }
- 
-         // ============================================================
-         // Write result
-         // ============================================================
- 
-         UDynamicMesh* DynMesh = OutMeshData->GetMutableDynamicMesh();
-         check(DynMesh);
- 
-        DynMesh->EditMesh(
-                [&](UE::Geometry::FDynamicMesh3& Mesh)
-                {
-                        // Move the freshly built mesh into the dynamic mesh
-                        Mesh = MoveTemp(BuiltMesh);
-
-                        // Optional: compact the mesh to remove unused vertices/attributes
-                        if (Settings->bCompactAtEnd)
-                        {
-                                Mesh.CompactInPlace();
-                        }
 
-                        // Apply a vertical offset to the mesh to align it with the landscape.
-                        // We subtract half of the partition grid size along Z so that the
-                        // generated mesh sits correctly on top of the landscape tile.  The
-                        // offset is only applied if a valid grid size was retrieved.  Because
-                        // FDynamicMesh3 in UE5.6 does not provide a Translate() method, we
-                        // manually adjust each vertex position.
-                        if (CachedGridSize > 0)
-                        {
-                                const double OffsetZ = -0.5 * static_cast<double>(CachedGridSize);
-                                for (int32 Vid : Mesh.VertexIndicesItr())
-                                {
-                                        FVector3d Position = Mesh.GetVertex(Vid);
-                                        Position.Z += OffsetZ;
-                                        Mesh.SetVertex(Vid, Position);
-                                }
-                        }
-                },
-                EDynamicMeshChangeType::GeneralEdit,
-                EDynamicMeshAttributeChangeFlags::Unknown,
-                true);
+         WriteMeshToOutput(*Settings, OutMeshData, MoveTemp(BuiltMesh), CachedGridSize);
  
          EmitOutput();
          return true;
- }
\ No newline at end of file
+ }
+
+bool FPCGLandscapeToDynamicMeshElement::ExecuteStreaming(
+        FPCGLandscapeToDynamicMeshContext* Context,
+        const UPCGLandscapeToDynamicMeshSettings* Settings,
+        uint32 CachedGridSize) const
+{
+        WDEditor::PCG::FPCGLandscapeMeshStreamingState& State = Context->Streaming;
+
+        const auto LandscapeInputs =
+                Context->InputData.GetInputsByPin(
+                        UPCGLandscapeToDynamicMeshSettings::LandscapePinLabel);
+        const UPCGLandscapeData* LandscapeData =
+                !LandscapeInputs.IsEmpty() ? Cast<UPCGLandscapeData>(LandscapeInputs[0].Data) : nullptr;
+        check(LandscapeData);
+
+        // At least one tile per slice
+        while (State.NextTileIndex < State.NumTiles())
+        {
+                MeshStreamingTile(State, *Settings, LandscapeData, State.NextTileIndex++);
+
+                if (State.NextTileIndex < State.NumTiles() && Context->ShouldStop())
+                {
+                        return false;
+                }
+        }
+
+        if (State.Mesh.TriangleCount() > 0)
+        {
+                WriteMeshToOutput(*Settings, Context->OutMeshData, MoveTemp(State.Mesh), CachedGridSize);
+        }
+
+        State.Mesh.Clear();
+        State.SeamVertices.Empty();
+
+        FPCGTaggedData& Out =
+                Context->OutputData.TaggedData.Emplace_GetRef();
+        Out.Data = Context->OutMeshData;
+        Out.Pin  = PCGPinConstants::DefaultOutputLabel;
+        Out.Tags = Context->OutTags;
+
+        return true;
+}
@@ -1,10 +1,13 @@
 #include "PCG/PCGPointsToDynamicMeshGrid.h"
+#include "PCG/PCGGridLattice.h"
 
 /* PCG */
 #include "PCGContext.h"
 #include "PCGElement.h"
 #include "PCGComponent.h"
-#include "Data/PCGPointData.h"
+#include "PCGModule.h"
+#include "Data/PCGBasePointData.h"
+#include "Metadata/Accessors/PCGAttributeAccessorHelpers.h"
 
 /* PCG GeometryScript Interop */
 #include "Data/PCGDynamicMeshData.h"
@@ -16,6 +19,7 @@
 #include "DynamicMesh/DynamicMeshAttributeSet.h"
 
 /* Misc */
+#include "Async/ParallelFor.h"
 #include "Containers/BitArray.h"
 #include "Math/UnrealMathUtility.h"
 
@@ -43,46 +47,449 @@ TArray<FPCGPinProperties> UPCGPointsToDynamicMeshGridSettings::OutputPinProperti
 
 namespace
 {
+	using namespace WDEditor::PCG;
+	using UE::Geometry::FIndex3i;
+
 	class FPCGPointsToDynamicMeshGridDataElement final : public IPCGDynamicMeshBaseElement
 	{
+	public:
+		// Reads through value ranges, so point array data is not converted to point data first
+		virtual bool SupportsBasePointDataInputs(FPCGContext* InContext) const override { return true; }
+
 	protected:
 		virtual bool ExecuteInternal(FPCGContext* Context) const override;
 	};
 
-	static float ReadFloatAttribute(
-		const FPCGPoint& Point,
-		const UPCGMetadata* Metadata,
-		const FName AttributeName,
-		float DefaultValue)
+	// Same safety bound as Landscape To Dynamic Mesh
+	constexpr int64 MaxGridPoints = 16ll * 1024ll * 1024ll;
+
+	// Auto layout: largest distance of a row point to the row axis, as a fraction of the point spacing
+	constexpr double AutoRowTolerance = 1.0e-2;
+
+	// Canonical normal-from-rotation (authoritative for this node)
+	static FVector ComputeVertexNormalFromPointRotation(const FTransform& Transform)
+	{
+		const FQuat Q = Transform.GetRotation().GetNormalized();
+		return Q.RotateVector(FVector::UpVector).GetSafeNormal();
+	}
+
+	// ------------------------------------------------------------
+	// Topology: row bands, see PCGGridLattice.h
+	//
+	// Bands record their edge vertices and triangles with band relative
+	// references and are appended in band order, so the parallel build
+	// gives the same mesh as a single band.
+	// ------------------------------------------------------------
+	struct FGridBand
 	{
-		if (!Metadata || AttributeName.IsNone())
+		int32 FirstRow = 0;
+		int32 EndRow = 0;
+
+		/** New edge vertices and their normals, in creation order. */
+		TArray<FVector3d> EdgeVertexPositions;
+		TArray<FVector3f> EdgeVertexNormals;
+
+		/** Triangles with encoded vertex references. */
+		TArray<FIndex3i> Triangles;
+
+		/** Band-local edge vertex of each horizontal edge on row EndRow, INDEX_NONE if not crossed. */
+		TArray<int32> BottomRowEdgeVertices;
+
+		/** First vertex ID of the band edge vertices, set during the merge. */
+		int32 VertexIDBase = 0;
+	};
+
+	static void TriangulateBand(
+		const FPCGPointsGridLattice& Grid,
+		const UPCGPointsToDynamicMeshGridSettings& Settings,
+		FGridBand& Band)
+	{
+		const int32 GridX = Grid.GridX;
+		const int32 NumRows = Band.EndRow - Band.FirstRow;
+		const bool bMarchingSquares = (Settings.TopologyMode != EPCGGridTopologyMode::UniformGrid);
+
+		// Marching squares edge vertices for the vertex rows [FirstRow, EndRow]
+		TPCGGridEdgeArray<int32> EdgeVertices;
+		if (bMarchingSquares)
 		{
-			return DefaultValue;
+			EdgeVertices.Init(GridX, NumRows + 1, INDEX_NONE, Band.FirstRow);
 		}
 
-		if (const FPCGMetadataAttribute<float>* Attr =
-			Metadata->GetConstTypedAttribute<float>(AttributeName))
+		auto GetEdgeVertex = [&](int32 A, int32 B)
+		{
+			const int32 Min = FMath::Min(A, B);
+			const int32 X = Min % GridX;
+			const int32 Y = Min / GridX;
+			const int32 Dir = (FMath::Abs(B - A) == 1) ? 0 : 1;
+
+			// Crossed edge on the first row: the previous band made it, unless the cell above was skipped
+			if (Dir == 0 && Y == Band.FirstRow && Band.FirstRow > 0 && Grid.IsCellComplete(X, Y - 1))
+			{
+				return PCGGridBandVertexRef::EncodePreviousBandEdgeVertex(X);
+			}
+
+			int32& LocalIndex = EdgeVertices.Get(X, Y, Dir);
+			if (LocalIndex == INDEX_NONE)
+			{
+				const float VA = Grid.Mask[A];
+				const float VB = Grid.Mask[B];
+
+				// Match Landscape semantics
+				const float T =
+					(VA != VB)
+						? FMath::Clamp(
+							(Settings.MaskThreshold - VA) / (VB - VA),
+							0.0f, 1.0f)
+						: 0.5f;
+
+				LocalIndex = Band.EdgeVertexPositions.Add(FMath::Lerp(Grid.Positions[A], Grid.Positions[B], (double)T));
+				Band.EdgeVertexNormals.Add(Grid.Normals[A]);
+			}
+
+			return PCGGridBandVertexRef::EncodeBandEdgeVertex(LocalIndex);
+		};
+
+		Band.Triangles.Reserve(NumRows * (GridX - 1) * 2);
+
+		TArray<int32, TInlineAllocator<8>> Poly;
+
+		for (int32 y = Band.FirstRow; y < Band.EndRow; ++y)
 		{
-			return Attr->GetValueFromItemKey(Point.MetadataEntry);
+			for (int32 x = 0; x < GridX - 1; ++x)
+			{
+				if (!Grid.IsCellComplete(x, y))
+				{
+					continue;
+				}
+
+				const int32 v[4] =
+				{
+					Grid.Index(x,     y),
+					Grid.Index(x,     y + 1),
+					Grid.Index(x + 1, y + 1),
+					Grid.Index(x + 1, y)
+				};
+
+				const int SolidCount =
+					(Grid.Solid[v[0]] ? 1 : 0) +
+					(Grid.Solid[v[1]] ? 1 : 0) +
+					(Grid.Solid[v[2]] ? 1 : 0) +
+					(Grid.Solid[v[3]] ? 1 : 0);
+
+				// Fully empty → nothing
+				if (SolidCount == 0)
+				{
+					continue;
+				}
+
+				// Uniform Grid mode (never marching squares) or fully solid → classic grid
+				if (!bMarchingSquares || SolidCount == 4)
+				{
+					Band.Triangles.Emplace(v[0], v[2], v[3]);
+					Band.Triangles.Emplace(v[0], v[1], v[2]);
+					continue;
+				}
+
+				// Mixed → marching squares (edge-shared)
+				Poly.Reset();
+
+				auto AddCorner = [&](int c) { Poly.Add(v[c]); };
+				auto AddEdge = [&](int a, int b) { Poly.Add(GetEdgeVertex(v[a], v[b])); };
+
+				if (Grid.Solid[v[0]]) AddCorner(0);
+				if (Grid.Solid[v[0]] != Grid.Solid[v[1]]) AddEdge(0, 1);
+				if (Grid.Solid[v[1]]) AddCorner(1);
+				if (Grid.Solid[v[1]] != Grid.Solid[v[2]]) AddEdge(1, 2);
+				if (Grid.Solid[v[2]]) AddCorner(2);
+				if (Grid.Solid[v[2]] != Grid.Solid[v[3]]) AddEdge(2, 3);
+				if (Grid.Solid[v[3]]) AddCorner(3);
+				if (Grid.Solid[v[3]] != Grid.Solid[v[0]]) AddEdge(3, 0);
+
+				for (int32 i = 1; i + 1 < Poly.Num(); ++i)
+				{
+					Band.Triangles.Emplace(Poly[0], Poly[i], Poly[i + 1]);
+				}
+			}
 		}
 
-		return DefaultValue;
+		if (bMarchingSquares)
+		{
+			Band.BottomRowEdgeVertices = TArray<int32>(EdgeVertices.GetHorizontalRow(Band.EndRow));
+		}
 	}
+}
 
-	// Canonical normal-from-rotation (authoritative for this node)
-	static FVector ComputeVertexNormalFromPointRotation(const FPCGPoint& Point)
+namespace WDEditor::PCG
+{
+	bool ResolvePointsGridLayout(
+		FPCGContext* Context,
+		const UPCGPointsToDynamicMeshGridSettings& Settings,
+		const UPCGBasePointData* PointData,
+		const TConstPCGValueRange<FTransform>& Transforms,
+		FPCGPointsGridLattice& OutGrid,
+		TArray<int32>& OutLatticeIndices)
 	{
-		const FQuat Q = Point.Transform.GetRotation().GetNormalized();
-		return Q.RotateVector(FVector::UpVector).GetSafeNormal();
+		const int32 NumPoints = PointData->GetNumPoints();
+		if (NumPoints < 4)
+		{
+			return false;
+		}
+
+		switch (Settings.GridLayout)
+		{
+		case EPCGPointsGridLayout::Dimensions:
+		{
+			OutGrid.GridX = Settings.GridDimensions.X;
+			OutGrid.GridY = Settings.GridDimensions.Y;
+
+			if ((int64)OutGrid.GridX * OutGrid.GridY != NumPoints)
+			{
+				UE_LOG(LogPCG, Warning,
+					TEXT("PCGPointsToDynamicMeshGrid: Grid dimensions %dx%d do not match the point count (%d)."),
+					OutGrid.GridX, OutGrid.GridY, NumPoints);
+				return false;
+			}
+			break;
+		}
+
+		case EPCGPointsGridLayout::RowColumnAttributes:
+		{
+			FPCGAttributePropertyInputSelector RowSelector;
+			RowSelector.Update(Settings.RowAttribute.ToString());
+			FPCGAttributePropertyInputSelector ColumnSelector;
+			ColumnSelector.Update(Settings.ColumnAttribute.ToString());
+
+			TArray<int32> Rows;
+			TArray<int32> Columns;
+			if (!PCGAttributeAccessorHelpers::ExtractAllValues(PointData, RowSelector, Rows, Context)
+				|| !PCGAttributeAccessorHelpers::ExtractAllValues(PointData, ColumnSelector, Columns, Context)
+				|| Rows.Num() != NumPoints
+				|| Columns.Num() != NumPoints)
+			{
+				return false;
+			}
+
+			int32 MinRow = MAX_int32, MaxRow = MIN_int32;
+			int32 MinColumn = MAX_int32, MaxColumn = MIN_int32;
+			for (int32 i = 0; i < NumPoints; ++i)
+			{
+				MinRow = FMath::Min(MinRow, Rows[i]);
+				MaxRow = FMath::Max(MaxRow, Rows[i]);
+				MinColumn = FMath::Min(MinColumn, Columns[i]);
+				MaxColumn = FMath::Max(MaxColumn, Columns[i]);
+			}
+
+			const int64 GridX = (int64)MaxColumn - MinColumn + 1;
+			const int64 GridY = (int64)MaxRow - MinRow + 1;
+			if (GridX * GridY > MaxGridPoints)
+			{
+				UE_LOG(LogPCG, Warning,
+					TEXT("PCGPointsToDynamicMeshGrid: Aborting build. Grid too large (%lldx%lld)."),
+					GridX, GridY);
+				return false;
+			}
+
+			OutGrid.GridX = (int32)GridX;
+			OutGrid.GridY = (int32)GridY;
+
+			OutLatticeIndices.SetNumUninitialized(NumPoints);
+			OutGrid.Present.Init(false, OutGrid.GridX * OutGrid.GridY);
+
+			int32 NumDuplicates = 0;
+			for (int32 i = 0; i < NumPoints; ++i)
+			{
+				const int32 VertexIndex = OutGrid.Index(Columns[i] - MinColumn, Rows[i] - MinRow);
+				if (OutGrid.Present[VertexIndex])
+				{
+					OutLatticeIndices[i] = INDEX_NONE;
+					++NumDuplicates;
+					continue;
+				}
+
+				OutGrid.Present[VertexIndex] = true;
+				OutLatticeIndices[i] = VertexIndex;
+			}
+
+			if (NumDuplicates > 0)
+			{
+				UE_LOG(LogPCG, Warning,
+					TEXT("PCGPointsToDynamicMeshGrid: %d points share a row/column with an earlier point and were ignored."),
+					NumDuplicates);
+			}
+			break;
+		}
+
+		case EPCGPointsGridLayout::Auto:
+		default:
+		{
+			// Row length from the leading points on the first row, as output by Create Points Grid. The row axis is
+			// the XY direction from the first to the second point, so rotated grids work too, and a point is on the
+			// row while it lies ahead on that axis, within a fraction of the point spacing from it.
+			const FVector2D Origin(Transforms[0].GetLocation());
+			const FVector2D FirstStep = FVector2D(Transforms[1].GetLocation()) - Origin;
+			const double Spacing = FirstStep.Size();
+
+			int32 RowLength = 1;
+			if (Spacing > UE_KINDA_SMALL_NUMBER)
+			{
+				const FVector2D RowAxis = FirstStep / Spacing;
+				const double Tolerance = Spacing * AutoRowTolerance;
+
+				RowLength = 2;
+				while (RowLength < NumPoints)
+				{
+					const FVector2D Offset = FVector2D(Transforms[RowLength].GetLocation()) - Origin;
+					if (FVector2D::DotProduct(RowAxis, Offset) <= 0.0 || FMath::Abs(FVector2D::CrossProduct(RowAxis, Offset)) > Tolerance)
+					{
+						break;
+					}
+
+					++RowLength;
+				}
+			}
+
+			if (RowLength >= 2 && RowLength < NumPoints && NumPoints % RowLength == 0)
+			{
+				OutGrid.GridX = RowLength;
+				OutGrid.GridY = NumPoints / RowLength;
+				break;
+			}
+
+			// Square grid in any point order (previous behavior)
+			const int32 GridSize = FMath::RoundToInt(FMath::Sqrt((float)NumPoints));
+			if (GridSize * GridSize != NumPoints)
+			{
+				UE_LOG(LogPCG, Warning,
+					TEXT("PCGPointsToDynamicMeshGrid: Auto layout found no row length dividing the point count (%d) and the points are not a square grid. Use Explicit Dimensions or Row / Column Attributes."),
+					NumPoints);
+				return false;
+			}
+
+			UE_LOG(LogPCG, Warning,
+				TEXT("PCGPointsToDynamicMeshGrid: Auto layout could not infer the rows from the first points, falling back to a %dx%d square grid."),
+				GridSize, GridSize);
+
+			OutGrid.GridX = OutGrid.GridY = GridSize;
+			break;
+		}
+		}
+
+		return OutGrid.GridX >= 2 && OutGrid.GridY >= 2 && (int64)OutGrid.GridX * OutGrid.GridY <= MaxGridPoints;
 	}
 
-	static uint64 MakeEdgeKey(int32 A, int32 B)
+	void BuildPointsGridMesh(
+		const FPCGPointsGridLattice& Grid,
+		const UPCGPointsToDynamicMeshGridSettings& Settings,
+		UE::Geometry::FDynamicMesh3& Mesh)
 	{
-		const uint32 Min = FMath::Min(A, B);
-		const uint32 Max = FMath::Max(A, B);
-		return (uint64(Min) << 32) | uint64(Max);
+		TRACE_CPUPROFILER_EVENT_SCOPE(WDEditor::PCG::BuildPointsGridMesh);
+
+		const int32 NumGridVertices = Grid.GridX * Grid.GridY;
+
+		// ------------------------------------------------------------
+		// Triangulate
+		// ------------------------------------------------------------
+		const int32 NumCellRows = Grid.GridY - 1;
+		const int32 RowsPerBand = Settings.bUseParallelBuild
+			? ComputeGridRowsPerBand(NumCellRows, Settings.RowsPerBand)
+			: NumCellRows;
+		const int32 NumBands = FMath::DivideAndRoundUp(NumCellRows, RowsPerBand);
+
+		TArray<FGridBand> Bands;
+		Bands.SetNum(NumBands);
+		for (int32 BandIndex = 0; BandIndex < NumBands; ++BandIndex)
+		{
+			Bands[BandIndex].FirstRow = BandIndex * RowsPerBand;
+			Bands[BandIndex].EndRow = FMath::Min(NumCellRows, (BandIndex + 1) * RowsPerBand);
+		}
+
+		ParallelFor(NumBands, [&](int32 BandIndex)
+		{
+			TRACE_CPUPROFILER_EVENT_SCOPE(PCGPointsToDynamicMeshGrid::TriangulateBand);
+			TriangulateBand(Grid, Settings, Bands[BandIndex]);
+		}, NumBands == 1 ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+
+		Mesh.Clear();
+		Mesh.EnableAttributes();
+
+		auto* Normals = Mesh.Attributes()->PrimaryNormals();
+
+		// Vertices and normal elements are appended in lockstep, so normal IDs equal vertex IDs.
+		auto AppendVertex = [&](const FVector3d& Position, const FVector3f& Normal)
+		{
+			const int32 VID = Mesh.AppendVertex(Position);
+			const int32 NID = Normals->AppendElement(Normal);
+			check(VID == NID);
+			return VID;
+		};
+
+		// Base vertices
+		for (int32 i = 0; i < NumGridVertices; ++i)
+		{
+			AppendVertex(Grid.Positions[i], Grid.Normals[i]);
+		}
+
+		// Bands in order
+		for (int32 BandIndex = 0; BandIndex < NumBands; ++BandIndex)
+		{
+			FGridBand& Band = Bands[BandIndex];
+			const FGridBand* PreviousBand = (BandIndex > 0) ? &Bands[BandIndex - 1] : nullptr;
+
+			Band.VertexIDBase = Mesh.MaxVertexID();
+			for (int32 LocalIndex = 0; LocalIndex < Band.EdgeVertexPositions.Num(); ++LocalIndex)
+			{
+				AppendVertex(Band.EdgeVertexPositions[LocalIndex], Band.EdgeVertexNormals[LocalIndex]);
+			}
+
+			const TConstArrayView<int32> PreviousBottomRow = PreviousBand ? TConstArrayView<int32>(PreviousBand->BottomRowEdgeVertices) : TConstArrayView<int32>();
+			const int32 PreviousVertexIDBase = PreviousBand ? PreviousBand->VertexIDBase : 0;
+
+			for (const FIndex3i& Ref : Band.Triangles)
+			{
+				const FIndex3i Tri(
+					PCGGridBandVertexRef::Decode(Ref.A, Band.VertexIDBase, PreviousBottomRow, PreviousVertexIDBase),
+					PCGGridBandVertexRef::Decode(Ref.B, Band.VertexIDBase, PreviousBottomRow, PreviousVertexIDBase),
+					PCGGridBandVertexRef::Decode(Ref.C, Band.VertexIDBase, PreviousBottomRow, PreviousVertexIDBase));
+
+				const int32 T = Mesh.AppendTriangle(Tri);
+				if (T >= 0)
+				{
+					Normals->SetTriangle(T, Tri);
+				}
+			}
+
+			// The bottom row is still needed by the next band
+			Band.EdgeVertexPositions.Empty();
+			Band.EdgeVertexNormals.Empty();
+			Band.Triangles.Empty();
+		}
+
+		// Grid vertices without a point
+		for (int32 i = 0; i < Grid.Present.Num(); ++i)
+		{
+			if (!Grid.Present[i])
+			{
+				Mesh.RemoveVertex(i);
+			}
+		}
+
+		if (Settings.bRemoveIsolatedVertices)
+		{
+			for (int32 V : Mesh.VertexIndicesItr())
+			{
+				if (Mesh.GetVtxTriangleCount(V) == 0)
+				{
+					Mesh.RemoveVertex(V);
+				}
+			}
+		}
+
+		if (Settings.bCompactAtEnd)
+		{
+			Mesh.CompactInPlace();
+		}
 	}
-}
+} // namespace WDEditor::PCG
 
 FPCGElementPtr UPCGPointsToDynamicMeshGridSettings::CreateElement() const
 {
@@ -107,7 +514,7 @@ bool FPCGPointsToDynamicMeshGridDataElement::ExecuteInternal(FPCGContext* Contex
 		return true;
 	}
 
-	const UPCGPointData* PointData = Cast<UPCGPointData>(PointInputs[0].Data);
+	const UPCGBasePointData* PointData = Cast<UPCGBasePointData>(PointInputs[0].Data);
 	if (!PointData)
 	{
 		return true;
@@ -119,8 +526,7 @@ bool FPCGPointsToDynamicMeshGridDataElement::ExecuteInternal(FPCGContext* Contex
 		return true;
 	}
 
-	const TArray<FPCGPoint>& Points = PointData->GetPoints();
-	const int32 NumPoints = Points.Num();
+	const int32 NumPoints = PointData->GetNumPoints();
 
 	auto EmitOutput = [&]()
 	{
@@ -136,217 +542,73 @@ bool FPCGPointsToDynamicMeshGridDataElement::ExecuteInternal(FPCGContext* Contex
 		return true;
 	}
 
-	const int32 GridSize = FMath::RoundToInt(FMath::Sqrt((float)NumPoints));
-	if (GridSize < 2 || GridSize * GridSize != NumPoints)
+	const TConstPCGValueRange<FTransform> Transforms = PointData->GetConstTransformValueRange();
+
+	FPCGPointsGridLattice Grid;
+	TArray<int32> LatticeIndices;
+	if (!ResolvePointsGridLayout(Context, *Settings, PointData, Transforms, Grid, LatticeIndices))
 	{
 		EmitOutput();
 		return true;
 	}
 
-	const FBox Bounds = PointData->GetBounds();
-	const FVector Center = Bounds.GetCenter();
-	const FVector OriginXY(Center.X, Center.Y, 0.0f);
-
-	const UPCGMetadata* Metadata = PointData->Metadata;
-	UDynamicMesh* DynMesh = OutMeshData->GetMutableDynamicMesh();
-
-	DynMesh->EditMesh(
-		[&](UE::Geometry::FDynamicMesh3& Mesh)
-		{
-			Mesh.Clear();
-			Mesh.EnableAttributes();
-
-			auto* Normals = Mesh.Attributes()->PrimaryNormals();
-
-			TArray<int32> NormalIDs;
-			NormalIDs.SetNumUninitialized(NumPoints);
-
-			TArray<bool> Solid;
-			Solid.SetNumUninitialized(NumPoints);
-
-			// Base vertices
-			for (int32 i = 0; i < NumPoints; ++i)
-			{
-				const FPCGPoint& P = Points[i];
-				const float Mask = ReadFloatAttribute(P, Metadata, Settings->KeepMaskAttribute, 1.0f);
-
-				Solid[i] =
-					!Settings->bInvertMask
-						? (Mask >= Settings->MaskThreshold)
-						: (Mask < Settings->MaskThreshold);
-
-				FVector Pos = P.Transform.GetLocation() - OriginXY;
-				Pos.Z = P.Transform.GetLocation().Z;
-
-				Mesh.AppendVertex((FVector3d)Pos);
-				NormalIDs[i] = Normals->AppendElement(
-					(FVector3f)ComputeVertexNormalFromPointRotation(P));
-			}
-
-			auto Idx = [GridSize](int32 X, int32 Y) { return Y * GridSize + X; };
-
-			TMap<uint64, int32> EdgeVertexMap;
-			TMap<uint64, int32> EdgeNormalMap;
-
-			for (int32 y = 0; y < GridSize - 1; ++y)
-			{
-				for (int32 x = 0; x < GridSize - 1; ++x)
-				{
-					const int32 v[4] =
-					{
-						Idx(x,     y),
-						Idx(x,     y + 1),
-						Idx(x + 1, y + 1),
-						Idx(x + 1, y)
-					};
-
-					const int SolidCount =
-						(Solid[v[0]] ? 1 : 0) +
-						(Solid[v[1]] ? 1 : 0) +
-						(Solid[v[2]] ? 1 : 0) +
-						(Solid[v[3]] ? 1 : 0);
-
-// ------------------------------------------------------------
-// Uniform Grid mode: NEVER use marching squares
-// ------------------------------------------------------------
-if (Settings->TopologyMode == EPCGGridTopologyMode::UniformGrid)
-{
-	// Emit nothing only if fully empty
-	if (SolidCount == 0)
-	{
-		continue;
-	}
-
-	// Otherwise emit classic grid
-	const int32 T0 = Mesh.AppendTriangle(v[0], v[2], v[3]);
-	if (T0 >= 0)
+	// Mask values in bulk; a missing attribute keeps every vertex solid.
+	TArray<float> MaskValues;
+	if (!Settings->KeepMaskAttribute.IsNone())
 	{
-		Normals->SetTriangle(T0, { NormalIDs[v[0]], NormalIDs[v[2]], NormalIDs[v[3]] });
-	}
+		FPCGAttributePropertyInputSelector MaskSelector;
+		MaskSelector.Update(Settings->KeepMaskAttribute.ToString());
 
-	const int32 T1 = Mesh.AppendTriangle(v[0], v[1], v[2]);
-	if (T1 >= 0)
-	{
-		Normals->SetTriangle(T1, { NormalIDs[v[0]], NormalIDs[v[1]], NormalIDs[v[2]] });
+		if (!PCGAttributeAccessorHelpers::ExtractAllValues(
+				PointData, MaskSelector, MaskValues, Context,
+				EPCGAttributeAccessorFlags::AllowBroadcastAndConstructible, /*bQuiet=*/true))
+		{
+			MaskValues.Reset();
+		}
 	}
 
-	continue;
-}
-
-// ------------------------------------------------------------
-// Landscape Parity (hybrid marching squares)
-// ------------------------------------------------------------
+	const FBox Bounds = PointData->GetBounds();
+	const FVector Center = Bounds.GetCenter();
+	const FVector OriginXY(Center.X, Center.Y, 0.0f);
 
-// Fully solid → uniform grid
-if (SolidCount == 4)
-{
-	const int32 T0 = Mesh.AppendTriangle(v[0], v[2], v[3]);
-	if (T0 >= 0)
-	{
-		Normals->SetTriangle(T0, { NormalIDs[v[0]], NormalIDs[v[2]], NormalIDs[v[3]] });
-	}
+	// ------------------------------------------------------------
+	// Grid vertices
+	// ------------------------------------------------------------
+	const int32 NumGridVertices = Grid.GridX * Grid.GridY;
+	Grid.Positions.SetNumZeroed(NumGridVertices);
+	Grid.Normals.Init(FVector3f::UnitZ(), NumGridVertices);
+	Grid.Mask.SetNumZeroed(NumGridVertices);
+	Grid.Solid.SetNumZeroed(NumGridVertices);
 
-	const int32 T1 = Mesh.AppendTriangle(v[0], v[1], v[2]);
-	if (T1 >= 0)
+	ParallelFor(NumPoints, [&](int32 PointIndex)
 	{
-		Normals->SetTriangle(T1, { NormalIDs[v[0]], NormalIDs[v[1]], NormalIDs[v[2]] });
-	}
-
-	continue;
-}
-
-// Fully empty → nothing
-if (SolidCount == 0)
-{
-	continue;
-}
+		const int32 VertexIndex = LatticeIndices.IsEmpty() ? PointIndex : LatticeIndices[PointIndex];
+		if (VertexIndex == INDEX_NONE)
+		{
+			return;
+		}
 
-					// Mixed → marching squares (edge-shared)
-					TArray<int32> PolyVIDs;
-					TArray<int32> PolyNIDs;
+		const FTransform& Transform = Transforms[PointIndex];
+		const float Mask = MaskValues.IsEmpty() ? 1.0f : MaskValues[PointIndex];
 
-					auto AddCorner = [&](int c)
-					{
-						PolyVIDs.Add(v[c]);
-						PolyNIDs.Add(NormalIDs[v[c]]);
-					};
+		FVector Pos = Transform.GetLocation() - OriginXY;
+		Pos.Z = Transform.GetLocation().Z;
 
-					auto AddEdge = [&](int a, int b)
-					{
-						const uint64 Key = MakeEdgeKey(v[a], v[b]);
-						if (!EdgeVertexMap.Contains(Key))
-						{
-const FVector PA = Mesh.GetVertex(v[a]);
-const FVector PB = Mesh.GetVertex(v[b]);
-
-const float VA = ReadFloatAttribute(
-	Points[v[a]], Metadata, Settings->KeepMaskAttribute, 1.0f);
-
-const float VB = ReadFloatAttribute(
-	Points[v[b]], Metadata, Settings->KeepMaskAttribute, 1.0f);
-
-// Match Landscape semantics
-const float T =
-	(VA != VB)
-		? FMath::Clamp(
-			(Settings->MaskThreshold - VA) / (VB - VA),
-			0.0f, 1.0f)
-		: 0.5f;
-
-const FVector P = FMath::Lerp(PA, PB, T);
-
-
-							const int32 VID = Mesh.AppendVertex((FVector3d)P);
-							const int32 NID = Normals->AppendElement(
-								(FVector3f)ComputeVertexNormalFromPointRotation(Points[v[a]]));
-
-							EdgeVertexMap.Add(Key, VID);
-							EdgeNormalMap.Add(Key, NID);
-						}
-
-						PolyVIDs.Add(EdgeVertexMap[Key]);
-						PolyNIDs.Add(EdgeNormalMap[Key]);
-					};
-
-					if (Solid[v[0]]) AddCorner(0);
-					if (Solid[v[0]] != Solid[v[1]]) AddEdge(0, 1);
-					if (Solid[v[1]]) AddCorner(1);
-					if (Solid[v[1]] != Solid[v[2]]) AddEdge(1, 2);
-					if (Solid[v[2]]) AddCorner(2);
-					if (Solid[v[2]] != Solid[v[3]]) AddEdge(2, 3);
-					if (Solid[v[3]]) AddCorner(3);
-					if (Solid[v[3]] != Solid[v[0]]) AddEdge(3, 0);
-
-					for (int32 i = 1; i + 1 < PolyVIDs.Num(); ++i)
-					{
-						const int32 T = Mesh.AppendTriangle(
-							PolyVIDs[0], PolyVIDs[i], PolyVIDs[i + 1]);
-
-						if (T >= 0)
-						{
-							Normals->SetTriangle(
-								T,
-								{ PolyNIDs[0], PolyNIDs[i], PolyNIDs[i + 1] });
-						}
-					}
-				}
-			}
+		Grid.Positions[VertexIndex] = (FVector3d)Pos;
+		Grid.Normals[VertexIndex] = (FVector3f)ComputeVertexNormalFromPointRotation(Transform);
+		Grid.Mask[VertexIndex] = Mask;
+		Grid.Solid[VertexIndex] =
+			!Settings->bInvertMask
+				? (Mask >= Settings->MaskThreshold)
+				: (Mask < Settings->MaskThreshold);
+	});
 
-			if (Settings->bRemoveIsolatedVertices)
-			{
-				for (int32 V : Mesh.VertexIndicesItr())
-				{
-					if (Mesh.GetVtxTriangleCount(V) == 0)
-					{
-						Mesh.RemoveVertex(V);
-					}
-				}
-			}
+	UDynamicMesh* DynMesh = OutMeshData->GetMutableDynamicMesh();
 
-			if (Settings->bCompactAtEnd)
-			{
-				Mesh.CompactInPlace();
-			}
+	DynMesh->EditMesh(
+		[&](UE::Geometry::FDynamicMesh3& Mesh)
+		{
+			BuildPointsGridMesh(Grid, *Settings, Mesh);
 		},
 		EDynamicMeshChangeType::GeneralEdit,
 		EDynamicMeshAttributeChangeFlags::Unknown,
@@ -0,0 +1,124 @@
+// Copyright BULKHEAD Limited. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && WITH_EDITOR
+
+/* WDEditor */
+#include "PCG/PCGGridLattice.h"
+
+/* Engine */
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+
+/**
+ * Marching squares edge vertex cache and constraint set on a 4096 x 4096 lattice with a noisy mask:
+ * hash map / hash set keyed by edge (previous implementation) against the dense edge arrays and bit
+ * arrays. Both must find the same crossings; memory and time are reported as test info.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FWDEditorPCGGridLatticeBenchmark,
+	"WDEditor.PCG.GridLattice.Benchmark",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+namespace WDEditor::PCG::Tests
+{
+	/** Same packing as the former MakeGridEdgeKey. */
+	static uint64 MakeGridEdgeKey(int32 X, int32 Y, int32 Dir)
+	{
+		return (uint64(Dir) << 62) | (uint64(uint32(Y)) << 31) | uint64(uint32(X));
+	}
+
+	/** Calls Func(X, Y, Dir) for each crossed edge of each cell, in cell order (edges may repeat). */
+	template <typename Func>
+	static void ForEachCellCrossing(const TBitArray<>& Solid, int32 GridSize, Func&& InFunc)
+	{
+		for (int32 Y = 0; Y < GridSize - 1; ++Y)
+		{
+			for (int32 X = 0; X < GridSize - 1; ++X)
+			{
+				const bool S00 = Solid[X + Y * GridSize];
+				const bool S10 = Solid[X + 1 + Y * GridSize];
+				const bool S11 = Solid[X + 1 + (Y + 1) * GridSize];
+				const bool S01 = Solid[X + (Y + 1) * GridSize];
+
+				if (S00 != S10) { InFunc(X,     Y,     0); }
+				if (S10 != S11) { InFunc(X + 1, Y,     1); }
+				if (S01 != S11) { InFunc(X,     Y + 1, 0); }
+				if (S00 != S01) { InFunc(X,     Y,     1); }
+			}
+		}
+	}
+}
+
+bool FWDEditorPCGGridLatticeBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace WDEditor::PCG;
+	using namespace WDEditor::PCG::Tests;
+
+	constexpr int32 GridSize = 4096;
+
+	TBitArray<> Solid(false, GridSize * GridSize);
+	FRandomStream RandomSource(42);
+	for (int32 Y = 0; Y < GridSize; ++Y)
+	{
+		for (int32 X = 0; X < GridSize; ++X)
+		{
+			const float Blobs = 0.5f + 0.5f * FMath::Sin(X * 0.011f + 1.3f) * FMath::Sin(Y * 0.009f);
+			Solid[X + Y * GridSize] = (Blobs + RandomSource.FRandRange(-0.2f, 0.2f)) >= 0.5f;
+		}
+	}
+
+	// Hash map cache + hash set of boundary vertices.
+	int32 MapNumVertices = 0;
+	double StartTime = FPlatformTime::Seconds();
+	TMap<uint64, int32> EdgeVertexMap;
+	TSet<int32> BoundarySet;
+	ForEachCellCrossing(Solid, GridSize, [&](int32 X, int32 Y, int32 Dir)
+	{
+		const uint64 Key = MakeGridEdgeKey(X, Y, Dir);
+		if (!EdgeVertexMap.Contains(Key))
+		{
+			const int32 Vid = GridSize * GridSize + MapNumVertices++;
+			EdgeVertexMap.Add(Key, Vid);
+			BoundarySet.Add(Vid);
+		}
+	});
+	const double MapTime = FPlatformTime::Seconds() - StartTime;
+	const SIZE_T MapBytes = EdgeVertexMap.GetAllocatedSize() + BoundarySet.GetAllocatedSize();
+
+	// Dense edge arrays + bit array.
+	int32 DenseNumVertices = 0;
+	StartTime = FPlatformTime::Seconds();
+	TPCGGridEdgeArray<int32> EdgeVertices;
+	EdgeVertices.Init(GridSize, GridSize, INDEX_NONE);
+	FPCGDenseIndexSet BoundaryBits;
+	ForEachCellCrossing(Solid, GridSize, [&](int32 X, int32 Y, int32 Dir)
+	{
+		int32& Vid = EdgeVertices.Get(X, Y, Dir);
+		if (Vid == INDEX_NONE)
+		{
+			Vid = GridSize * GridSize + DenseNumVertices++;
+			BoundaryBits.Add(Vid);
+		}
+	});
+	const double DenseTime = FPlatformTime::Seconds() - StartTime;
+	const SIZE_T DenseBytes = EdgeVertices.GetAllocatedSize() + BoundaryBits.GetAllocatedSize();
+
+	TestTrue(TEXT("Mask has crossings"), MapNumVertices > 0);
+	TestEqual(TEXT("Same number of edge vertices"), DenseNumVertices, MapNumVertices);
+	TestEqual(TEXT("Same number of boundary vertices"), BoundaryBits.Num(), BoundarySet.Num());
+
+	AddInfo(FString::Printf(
+		TEXT("%dx%d lattice, %d edge vertices: hash map + set %.1f MB, %.1f ms | dense arrays + bits %.1f MB, %.1f ms"),
+		GridSize, GridSize,
+		MapNumVertices,
+		MapBytes / (1024.0 * 1024.0),
+		MapTime * 1000.0,
+		DenseBytes / (1024.0 * 1024.0),
+		DenseTime * 1000.0));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS && WITH_EDITOR
@@ -0,0 +1,292 @@
+// Copyright BULKHEAD Limited. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && WITH_EDITOR
+
+/* WDEditor */
+#include "PCG/PCGLandscapeHeightfield.h"
+#include "PCG/PCGLandscapeHeightfieldData.h"
+#include "PCG/PCGLandscapeMeshBuilder.h"
+
+/* GeometryCore */
+#include "DynamicMesh/DynamicMesh3.h"
+
+/* Engine */
+#include "Math/RandomStream.h"
+
+/**
+ * Builds a synthetic grid (rolling heights, noisy mask with holes and islands) as a mesh, and as a
+ * heightfield converted to a mesh, and checks both have the same triangles: counts, open boundary and
+ * area. The heightfield and mesh memory are reported as test info.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FWDEditorPCGLandscapeHeightfieldMatchesMesh,
+	"WDEditor.PCG.LandscapeHeightfield.MatchesMesh",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+namespace WDEditor::PCG::Tests
+{
+	static void MakeHeightfieldTestGrid(int32 GridSize, int32 Seed, TArray<FPCGLandscapeGridSample>& OutSamples)
+	{
+		FRandomStream RandomSource(Seed);
+
+		OutSamples.SetNum(GridSize * GridSize);
+		for (int32 Y = 0; Y < GridSize; ++Y)
+		{
+			for (int32 X = 0; X < GridSize; ++X)
+			{
+				FPCGLandscapeGridSample& Sample = OutSamples[X + Y * GridSize];
+				Sample.Height = 200.0 * FMath::Sin(X * 0.05) * FMath::Cos(Y * 0.07);
+				Sample.Normal = FVector3d::UpVector;
+
+				const float Blobs = 0.5f + 0.5f * FMath::Sin(X * 0.11f + 1.3f) * FMath::Sin(Y * 0.09f);
+				Sample.Mask = FMath::Clamp(Blobs + RandomSource.FRandRange(-0.3f, 0.3f), 0.0f, 1.0f);
+			}
+		}
+	}
+
+	static void GetHeightfieldTestMeshStats(const UE::Geometry::FDynamicMesh3& Mesh, int32& OutNumBoundaryEdges, double& OutArea)
+	{
+		OutNumBoundaryEdges = 0;
+		for (int32 Eid : Mesh.EdgeIndicesItr())
+		{
+			OutNumBoundaryEdges += Mesh.IsBoundaryEdge(Eid) ? 1 : 0;
+		}
+
+		OutArea = 0.0;
+		for (int32 Tid : Mesh.TriangleIndicesItr())
+		{
+			OutArea += Mesh.GetTriArea(Tid);
+		}
+	}
+
+	static int32 CountHeightfieldTestGroupTriangles(const UE::Geometry::FDynamicMesh3& Mesh, int32 GroupID)
+	{
+		int32 NumTriangles = 0;
+		for (int32 Tid : Mesh.TriangleIndicesItr())
+		{
+			NumTriangles += (Mesh.GetTriangleGroup(Tid) == GroupID) ? 1 : 0;
+		}
+		return NumTriangles;
+	}
+}
+
+bool FWDEditorPCGLandscapeHeightfieldMatchesMesh::RunTest(const FString& Parameters)
+{
+	using namespace WDEditor::PCG;
+	using namespace WDEditor::PCG::Tests;
+
+	constexpr int32 GridSize = 257;
+
+	TArray<FPCGLandscapeGridSample> Samples;
+	MakeHeightfieldTestGrid(GridSize, /*Seed=*/7, Samples);
+
+	FPCGLandscapeMeshGridDesc GridDesc;
+	GridDesc.GridX = GridSize;
+	GridDesc.GridY = GridSize;
+	GridDesc.GridMinXY = FVector2D(-1000.0, 500.0);
+	GridDesc.Samples = &Samples;
+
+	FPCGLandscapeMeshBuilderSettings Settings;
+
+	// One overscan cell on each side, as the node
+	const FBox2D CropBounds(
+		GridDesc.GridMinXY + FVector2D(Settings.CellSize),
+		GridDesc.GridMinXY + FVector2D((GridSize - 2) * Settings.CellSize));
+
+	UE::Geometry::FDynamicMesh3 Mesh;
+	FPCGLandscapeMeshConstraints Constraints;
+	if (!TestTrue(TEXT("Mesh build produces triangles"), BuildMeshFromSamples(GridDesc, Settings, CropBounds, Mesh, Constraints)))
+	{
+		return false;
+	}
+	Mesh.CompactInPlace();
+
+	FPCGLandscapeHeightfield Heightfield;
+	if (!TestTrue(TEXT("Heightfield build succeeds"), BuildHeightfieldFromSamples(GridDesc, Settings, CropBounds, Heightfield)))
+	{
+		return false;
+	}
+	TestEqual(TEXT("Heightfield is cropped to the crop bounds"), Heightfield.GridX, GridSize - 2);
+	TestTrue(TEXT("Heightfield has boundary cells"), Heightfield.BoundaryCells.Num() > 0);
+
+	UE::Geometry::FDynamicMesh3 HeightfieldMesh;
+	if (!TestTrue(TEXT("Heightfield mesh has triangles"), BuildMeshFromHeightfield(Heightfield, HeightfieldMesh)))
+	{
+		return false;
+	}
+
+	TestEqual(TEXT("Triangle count"), HeightfieldMesh.TriangleCount(), Mesh.TriangleCount());
+	TestEqual(TEXT("Vertex count"), HeightfieldMesh.VertexCount(), Mesh.VertexCount());
+
+	int32 NumBoundaryEdges = 0;
+	int32 NumHeightfieldBoundaryEdges = 0;
+	double Area = 0.0;
+	double HeightfieldArea = 0.0;
+	GetHeightfieldTestMeshStats(Mesh, NumBoundaryEdges, Area);
+	GetHeightfieldTestMeshStats(HeightfieldMesh, NumHeightfieldBoundaryEdges, HeightfieldArea);
+
+	TestEqual(TEXT("Boundary edge count"), NumHeightfieldBoundaryEdges, NumBoundaryEdges);
+	TestTrue(TEXT("Area"), FMath::IsNearlyEqual(HeightfieldArea, Area, Area * 1.0e-5));
+
+	float MinHeight = 0.0f;
+	float MaxHeight = 0.0f;
+	if (TestTrue(TEXT("Height range"), ComputeHeightfieldHeightRange(Heightfield, MinHeight, MaxHeight)))
+	{
+		TestTrue(TEXT("Heights within the sampled range"), MinHeight >= -200.0f - UE_KINDA_SMALL_NUMBER && MaxHeight <= 200.0f + UE_KINDA_SMALL_NUMBER);
+	}
+
+	AddInfo(FString::Printf(
+		TEXT("%dx%d: heightfield %.2f MB (%d boundary cells), mesh %.2f MB (%d vertices, %d triangles)"),
+		Heightfield.GridX, Heightfield.GridY,
+		Heightfield.GetAllocatedSize() / (1024.0 * 1024.0), Heightfield.BoundaryCells.Num(),
+		Mesh.GetByteCount() / (1024.0 * 1024.0), Mesh.VertexCount(), Mesh.TriangleCount()));
+
+	return true;
+}
+
+/**
+ * Same comparison with crop bounds off the lattice, so the cells along the crop edges are split: both
+ * builds must crop their triangles by centroid, without and with the padding (padding polygroup).
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FWDEditorPCGLandscapeHeightfieldMatchesMeshUnalignedCrop,
+	"WDEditor.PCG.LandscapeHeightfield.MatchesMeshUnalignedCrop",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FWDEditorPCGLandscapeHeightfieldMatchesMeshUnalignedCrop::RunTest(const FString& Parameters)
+{
+	using namespace WDEditor::PCG;
+	using namespace WDEditor::PCG::Tests;
+
+	constexpr int32 GridSize = 129;
+	constexpr int32 PaddingPolygroupID = 3;
+
+	TArray<FPCGLandscapeGridSample> Samples;
+	MakeHeightfieldTestGrid(GridSize, /*Seed=*/11, Samples);
+
+	FPCGLandscapeMeshGridDesc GridDesc;
+	GridDesc.GridX = GridSize;
+	GridDesc.GridY = GridSize;
+	GridDesc.GridMinXY = FVector2D(-1000.0, 500.0);
+	GridDesc.Samples = &Samples;
+
+	for (const bool bIncludePadding : { false, true })
+	{
+		const FString Prefix = bIncludePadding ? TEXT("Padding: ") : TEXT("No padding: ");
+
+		FPCGLandscapeMeshBuilderSettings Settings;
+		Settings.bIncludePadding = bIncludePadding;
+		Settings.PaddingPolygroupID = PaddingPolygroupID;
+
+		// The bounds split cell column 1, cell row 2 and the cell column and row GridSize - 4
+		const FBox2D CropBounds(
+			GridDesc.GridMinXY + FVector2D(1.37, 2.61) * Settings.CellSize,
+			GridDesc.GridMinXY + FVector2D(GridSize - 3.29, GridSize - 3.83) * Settings.CellSize);
+
+		UE::Geometry::FDynamicMesh3 Mesh;
+		FPCGLandscapeMeshConstraints Constraints;
+		if (!TestTrue(Prefix + TEXT("Mesh build produces triangles"), BuildMeshFromSamples(GridDesc, Settings, CropBounds, Mesh, Constraints)))
+		{
+			return false;
+		}
+		Mesh.CompactInPlace();
+
+		FPCGLandscapeHeightfield Heightfield;
+		if (!TestTrue(Prefix + TEXT("Heightfield build succeeds"), BuildHeightfieldFromSamples(GridDesc, Settings, CropBounds, Heightfield)))
+		{
+			return false;
+		}
+
+		// Without padding the heightfield keeps the cells overlapping the bounds, split ones included
+		TestEqual(Prefix + TEXT("Heightfield crop X"), Heightfield.GridX, bIncludePadding ? GridSize : GridSize - 3);
+		TestEqual(Prefix + TEXT("Heightfield crop Y"), Heightfield.GridY, bIncludePadding ? GridSize : GridSize - 4);
+
+		UE::Geometry::FDynamicMesh3 HeightfieldMesh;
+		if (!TestTrue(Prefix + TEXT("Heightfield mesh has triangles"), BuildMeshFromHeightfield(Heightfield, HeightfieldMesh)))
+		{
+			return false;
+		}
+
+		TestEqual(Prefix + TEXT("Triangle count"), HeightfieldMesh.TriangleCount(), Mesh.TriangleCount());
+		TestEqual(Prefix + TEXT("Vertex count"), HeightfieldMesh.VertexCount(), Mesh.VertexCount());
+
+		int32 NumBoundaryEdges = 0;
+		int32 NumHeightfieldBoundaryEdges = 0;
+		double Area = 0.0;
+		double HeightfieldArea = 0.0;
+		GetHeightfieldTestMeshStats(Mesh, NumBoundaryEdges, Area);
+		GetHeightfieldTestMeshStats(HeightfieldMesh, NumHeightfieldBoundaryEdges, HeightfieldArea);
+
+		TestEqual(Prefix + TEXT("Boundary edge count"), NumHeightfieldBoundaryEdges, NumBoundaryEdges);
+		TestTrue(Prefix + TEXT("Area"), FMath::IsNearlyEqual(HeightfieldArea, Area, Area * 1.0e-5));
+
+		if (bIncludePadding)
+		{
+			const int32 NumPaddingTriangles = CountHeightfieldTestGroupTriangles(Mesh, PaddingPolygroupID);
+			TestTrue(Prefix + TEXT("Mesh has padding triangles"), NumPaddingTriangles > 0);
+			TestEqual(Prefix + TEXT("Padding triangle count"), CountHeightfieldTestGroupTriangles(HeightfieldMesh, PaddingPolygroupID), NumPaddingTriangles);
+		}
+	}
+
+	return true;
+}
+
+/**
+ * The mesh cached by ToDynamicMeshData is counted in the resource size of the heightfield data, and no
+ * longer once the heightfield is modified.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FWDEditorPCGLandscapeHeightfieldDataResourceSize,
+	"WDEditor.PCG.LandscapeHeightfield.DataResourceSize",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FWDEditorPCGLandscapeHeightfieldDataResourceSize::RunTest(const FString& Parameters)
+{
+	using namespace WDEditor::PCG;
+	using namespace WDEditor::PCG::Tests;
+
+	constexpr int32 GridSize = 65;
+
+	TArray<FPCGLandscapeGridSample> Samples;
+	MakeHeightfieldTestGrid(GridSize, /*Seed=*/5, Samples);
+
+	FPCGLandscapeMeshGridDesc GridDesc;
+	GridDesc.GridX = GridSize;
+	GridDesc.GridY = GridSize;
+	GridDesc.Samples = &Samples;
+
+	FPCGLandscapeMeshBuilderSettings Settings;
+
+	const FBox2D CropBounds(
+		GridDesc.GridMinXY + FVector2D(Settings.CellSize),
+		GridDesc.GridMinXY + FVector2D((GridSize - 2) * Settings.CellSize));
+
+	FPCGLandscapeHeightfield Heightfield;
+	if (!TestTrue(TEXT("Heightfield build succeeds"), BuildHeightfieldFromSamples(GridDesc, Settings, CropBounds, Heightfield)))
+	{
+		return false;
+	}
+
+	UPCGLandscapeHeightfieldData* Data = NewObject<UPCGLandscapeHeightfieldData>();
+	Data->Initialize(MoveTemp(Heightfield));
+
+	const SIZE_T HeightfieldSize = Data->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+
+	const UPCGDynamicMeshData* MeshData = Data->ToDynamicMeshData(nullptr);
+	if (!TestNotNull(TEXT("Cached mesh data"), MeshData))
+	{
+		return false;
+	}
+
+	const SIZE_T CachedMeshSize = Data->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+	TestTrue(TEXT("Cached mesh is counted in the resource size"), CachedMeshSize > HeightfieldSize + Data->GetHeightfield().GetAllocatedSize());
+
+	Data->GetMutableHeightfield();
+	TestEqual(TEXT("Resource size drops with the cached mesh"), Data->GetResourceSizeBytes(EResourceSizeMode::Exclusive), HeightfieldSize);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS && WITH_EDITOR
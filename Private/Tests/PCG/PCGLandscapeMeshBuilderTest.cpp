@@ -0,0 +1,217 @@
+// Copyright BULKHEAD Limited. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && WITH_EDITOR
+
+/* WDEditor */
+#include "PCG/PCGLandscapeMeshBuilder.h"
+
+/* GeometryCore */
+#include "DynamicMesh/DynamicMesh3.h"
+#include "DynamicMesh/DynamicMeshAttributeSet.h"
+
+/* Engine */
+#include "Math/RandomStream.h"
+
+/**
+ * Builds the same synthetic grid (rolling heights, noisy mask with holes and islands) with the
+ * serial and the tiled topology, with automatic and with small bands, and checks the meshes
+ * are identical: vertex positions and IDs, triangles, edges, constraints and normals.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FWDEditorPCGLandscapeMeshBuilderTiledMatchesSerial,
+	"WDEditor.PCG.LandscapeMeshBuilder.TiledMatchesSerial",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+/** Serial and tiled build timings on a 4097 x 4097 grid, reported as test info. */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FWDEditorPCGLandscapeMeshBuilderBenchmark,
+	"WDEditor.PCG.LandscapeMeshBuilder.Benchmark",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+namespace WDEditor::PCG::Tests
+{
+	static void MakeSyntheticGrid(int32 GridSize, int32 Seed, TArray<FPCGLandscapeGridSample>& OutSamples)
+	{
+		FRandomStream RandomSource(Seed);
+
+		OutSamples.SetNum(GridSize * GridSize);
+		for (int32 Y = 0; Y < GridSize; ++Y)
+		{
+			for (int32 X = 0; X < GridSize; ++X)
+			{
+				FPCGLandscapeGridSample& Sample = OutSamples[X + Y * GridSize];
+				Sample.Height = 200.0 * FMath::Sin(X * 0.05) * FMath::Cos(Y * 0.07);
+				Sample.Normal = FVector3d::UpVector;
+
+				// Large blobs plus per-sample noise, so there are long mask boundaries and isolated cells.
+				const float Blobs = 0.5f + 0.5f * FMath::Sin(X * 0.11f + 1.3f) * FMath::Sin(Y * 0.09f);
+				Sample.Mask = FMath::Clamp(Blobs + RandomSource.FRandRange(-0.3f, 0.3f), 0.0f, 1.0f);
+			}
+		}
+	}
+
+	static FPCGLandscapeMeshGridDesc MakeGridDesc(int32 GridSize, const TArray<FPCGLandscapeGridSample>& Samples)
+	{
+		FPCGLandscapeMeshGridDesc GridDesc;
+		GridDesc.GridX = GridSize;
+		GridDesc.GridY = GridSize;
+		GridDesc.GridMinXY = FVector2D(-1000.0, 500.0);
+		GridDesc.Samples = &Samples;
+		return GridDesc;
+	}
+
+	/** Crop bounds one cell inside the grid, as the node does with one overscan cell. */
+	static FBox2D MakeCropBounds(const FPCGLandscapeMeshGridDesc& GridDesc, double CellSize)
+	{
+		const FVector2D Min = GridDesc.GridMinXY + FVector2D(CellSize);
+		const FVector2D Max = GridDesc.GridMinXY + FVector2D((GridDesc.GridX - 2) * CellSize, (GridDesc.GridY - 2) * CellSize);
+		return FBox2D(Min, Max);
+	}
+}
+
+bool FWDEditorPCGLandscapeMeshBuilderTiledMatchesSerial::RunTest(const FString& Parameters)
+{
+	using namespace WDEditor::PCG;
+	using namespace WDEditor::PCG::Tests;
+
+	constexpr int32 GridSize = 301;
+
+	TArray<FPCGLandscapeGridSample> Samples;
+	MakeSyntheticGrid(GridSize, /*Seed=*/42, Samples);
+
+	const FPCGLandscapeMeshGridDesc GridDesc = MakeGridDesc(GridSize, Samples);
+
+	FPCGLandscapeMeshBuilderSettings Settings;
+	const FBox2D CropBounds = MakeCropBounds(GridDesc, Settings.CellSize);
+
+	Settings.bUseTiledBuild = false;
+	UE::Geometry::FDynamicMesh3 SerialMesh;
+	FPCGLandscapeMeshConstraints SerialConstraints;
+	FPCGLandscapeMeshBuilderStats SerialStats;
+	TestTrue(TEXT("Serial build produces triangles"), BuildMeshFromSamples(GridDesc, Settings, CropBounds, SerialMesh, SerialConstraints, &SerialStats));
+	TestTrue(TEXT("Grid has mixed cells"), SerialStats.NumCellsMixed > 0);
+
+	// 0 = automatic band size; 7 and 1 put band seams every few rows, with a shorter last band.
+	for (const int32 RowsPerBand : { 0, 7, 1 })
+	{
+		Settings.bUseTiledBuild = true;
+		Settings.TiledBuildRowsPerBand = RowsPerBand;
+
+		UE::Geometry::FDynamicMesh3 TiledMesh;
+		FPCGLandscapeMeshConstraints TiledConstraints;
+		FPCGLandscapeMeshBuilderStats TiledStats;
+		BuildMeshFromSamples(GridDesc, Settings, CropBounds, TiledMesh, TiledConstraints, &TiledStats);
+
+		const FString Prefix = FString::Printf(TEXT("RowsPerBand %d (%d bands): "), RowsPerBand, TiledStats.NumBands);
+
+		TestEqual(Prefix + TEXT("solid cells"), TiledStats.NumCellsSolid, SerialStats.NumCellsSolid);
+		TestEqual(Prefix + TEXT("empty cells"), TiledStats.NumCellsEmpty, SerialStats.NumCellsEmpty);
+		TestEqual(Prefix + TEXT("mixed cells"), TiledStats.NumCellsMixed, SerialStats.NumCellsMixed);
+		TestEqual(Prefix + TEXT("triangles before crop"), TiledStats.NumTrianglesBeforeCrop, SerialStats.NumTrianglesBeforeCrop);
+
+		if (!TestEqual(Prefix + TEXT("max vertex ID"), TiledMesh.MaxVertexID(), SerialMesh.MaxVertexID())
+			|| !TestEqual(Prefix + TEXT("max triangle ID"), TiledMesh.MaxTriangleID(), SerialMesh.MaxTriangleID())
+			|| !TestEqual(Prefix + TEXT("max edge ID"), TiledMesh.MaxEdgeID(), SerialMesh.MaxEdgeID()))
+		{
+			continue;
+		}
+
+		int32 NumVertexMismatches = 0;
+		for (int32 Vid = 0; Vid < SerialMesh.MaxVertexID(); ++Vid)
+		{
+			if (SerialMesh.IsVertex(Vid) != TiledMesh.IsVertex(Vid)
+				|| (SerialMesh.IsVertex(Vid) && SerialMesh.GetVertex(Vid) != TiledMesh.GetVertex(Vid)))
+			{
+				++NumVertexMismatches;
+			}
+		}
+		TestEqual(Prefix + TEXT("vertex mismatches"), NumVertexMismatches, 0);
+
+		int32 NumTriangleMismatches = 0;
+		for (int32 Tid = 0; Tid < SerialMesh.MaxTriangleID(); ++Tid)
+		{
+			if (SerialMesh.IsTriangle(Tid) != TiledMesh.IsTriangle(Tid)
+				|| (SerialMesh.IsTriangle(Tid) && SerialMesh.GetTriangle(Tid) != TiledMesh.GetTriangle(Tid)))
+			{
+				++NumTriangleMismatches;
+			}
+		}
+		TestEqual(Prefix + TEXT("triangle mismatches"), NumTriangleMismatches, 0);
+
+		int32 NumEdgeMismatches = 0;
+		for (int32 Eid = 0; Eid < SerialMesh.MaxEdgeID(); ++Eid)
+		{
+			if (SerialMesh.IsEdge(Eid) != TiledMesh.IsEdge(Eid)
+				|| (SerialMesh.IsEdge(Eid) && SerialMesh.GetEdgeV(Eid) != TiledMesh.GetEdgeV(Eid)))
+			{
+				++NumEdgeMismatches;
+			}
+		}
+		TestEqual(Prefix + TEXT("edge mismatches"), NumEdgeMismatches, 0);
+
+		TestTrue(Prefix + TEXT("constrained vertices"), TiledConstraints.ConstrainedVertices.Array() == SerialConstraints.ConstrainedVertices.Array());
+		TestTrue(Prefix + TEXT("constrained edges"), TiledConstraints.ConstrainedEdges.Array() == SerialConstraints.ConstrainedEdges.Array());
+
+		const UE::Geometry::FDynamicMeshNormalOverlay* SerialNormals = SerialMesh.Attributes() ? SerialMesh.Attributes()->PrimaryNormals() : nullptr;
+		const UE::Geometry::FDynamicMeshNormalOverlay* TiledNormals = TiledMesh.Attributes() ? TiledMesh.Attributes()->PrimaryNormals() : nullptr;
+		if (TestTrue(Prefix + TEXT("both meshes have normals"), SerialNormals && TiledNormals)
+			&& TestEqual(Prefix + TEXT("normal elements"), TiledNormals->MaxElementID(), SerialNormals->MaxElementID()))
+		{
+			int32 NumNormalMismatches = 0;
+			for (int32 Elem = 0; Elem < SerialNormals->MaxElementID(); ++Elem)
+			{
+				if (SerialNormals->IsElement(Elem) && SerialNormals->GetElement(Elem) != TiledNormals->GetElement(Elem))
+				{
+					++NumNormalMismatches;
+				}
+			}
+			TestEqual(Prefix + TEXT("normal mismatches"), NumNormalMismatches, 0);
+		}
+	}
+
+	return true;
+}
+
+bool FWDEditorPCGLandscapeMeshBuilderBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace WDEditor::PCG;
+	using namespace WDEditor::PCG::Tests;
+
+	constexpr int32 GridSize = 4097;
+
+	TArray<FPCGLandscapeGridSample> Samples;
+	MakeSyntheticGrid(GridSize, /*Seed=*/42, Samples);
+
+	const FPCGLandscapeMeshGridDesc GridDesc = MakeGridDesc(GridSize, Samples);
+
+	for (const bool bUseTiledBuild : { false, true })
+	{
+		FPCGLandscapeMeshBuilderSettings Settings;
+		Settings.bUseTiledBuild = bUseTiledBuild;
+
+		UE::Geometry::FDynamicMesh3 Mesh;
+		FPCGLandscapeMeshConstraints Constraints;
+		FPCGLandscapeMeshBuilderStats Stats;
+		BuildMeshFromSamples(GridDesc, Settings, MakeCropBounds(GridDesc, Settings.CellSize), Mesh, Constraints, &Stats);
+
+		AddInfo(FString::Printf(
+			TEXT("%s %dx%d (%d bands, %d triangles): corners %.1f ms, triangulate %.1f ms, merge %.1f ms, constraints %.1f ms, crop %.1f ms, normals %.1f ms, total %.1f ms"),
+			bUseTiledBuild ? TEXT("Tiled") : TEXT("Serial"),
+			GridSize, GridSize,
+			Stats.NumBands,
+			Stats.NumTrianglesAfterCrop,
+			Stats.CornersMs,
+			Stats.TriangulateMs,
+			Stats.MergeMs,
+			Stats.ConstraintsMs,
+			Stats.CropMs,
+			Stats.NormalsMs,
+			Stats.TotalMs));
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS && WITH_EDITOR
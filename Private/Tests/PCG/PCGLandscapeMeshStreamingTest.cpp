@@ -0,0 +1,217 @@
+// Copyright BULKHEAD Limited. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && WITH_EDITOR
+
+/* WDEditor */
+#include "PCG/PCGLandscapeMeshBuilder.h"
+#include "PCG/PCGLandscapeMeshStreaming.h"
+
+/* GeometryCore */
+#include "DynamicMesh/DynamicMesh3.h"
+
+/* Engine */
+#include "Math/RandomStream.h"
+
+/**
+ * Meshes a synthetic region (rolling heights, noisy mask with holes and islands, crop max off the lattice)
+ * in 4x3 streamed tiles and in a single build, and checks the streamed mesh has no duplicate vertex on the
+ * tile seams and matches the single build: vertex positions, triangle count, open boundary and area. Seam
+ * vertices of finished tile rows must have been dropped.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FWDEditorPCGLandscapeMeshStreamingMatchesSingleBuild,
+	"WDEditor.PCG.LandscapeMeshStreaming.MatchesSingleBuild",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+namespace WDEditor::PCG::Tests
+{
+	static void MakeStreamingTestGrid(int32 GridX, int32 GridY, int32 Seed, TArray<FPCGLandscapeGridSample>& OutSamples)
+	{
+		FRandomStream RandomSource(Seed);
+
+		OutSamples.SetNum(GridX * GridY);
+		for (int32 Y = 0; Y < GridY; ++Y)
+		{
+			for (int32 X = 0; X < GridX; ++X)
+			{
+				FPCGLandscapeGridSample& Sample = OutSamples[X + Y * GridX];
+				Sample.Height = 150.0 * FMath::Sin(X * 0.06) * FMath::Cos(Y * 0.08);
+				Sample.Normal = FVector3d::UpVector;
+
+				const float Blobs = 0.5f + 0.5f * FMath::Sin(X * 0.13f + 0.7f) * FMath::Sin(Y * 0.1f);
+				Sample.Mask = FMath::Clamp(Blobs + RandomSource.FRandRange(-0.3f, 0.3f), 0.0f, 1.0f);
+			}
+		}
+	}
+
+	/** XY position key, in hundredths of a unit. */
+	static FIntPoint MakeStreamingTestPositionKey(const FVector3d& Position)
+	{
+		return FIntPoint(FMath::RoundToInt32(Position.X * 100.0), FMath::RoundToInt32(Position.Y * 100.0));
+	}
+
+	static void GetStreamingTestMeshStats(const UE::Geometry::FDynamicMesh3& Mesh, int32& OutNumBoundaryEdges, double& OutArea)
+	{
+		OutNumBoundaryEdges = 0;
+		for (int32 Eid : Mesh.EdgeIndicesItr())
+		{
+			OutNumBoundaryEdges += Mesh.IsBoundaryEdge(Eid) ? 1 : 0;
+		}
+
+		OutArea = 0.0;
+		for (int32 Tid : Mesh.TriangleIndicesItr())
+		{
+			OutArea += Mesh.GetTriArea(Tid);
+		}
+	}
+}
+
+bool FWDEditorPCGLandscapeMeshStreamingMatchesSingleBuild::RunTest(const FString& Parameters)
+{
+	using namespace WDEditor::PCG;
+	using namespace WDEditor::PCG::Tests;
+
+	constexpr double CellSize = 100.0;
+	constexpr int32 OverscanCells = 1;
+	constexpr int32 TileCells = 32;
+
+	// 110.4 x 80.6 cells: 4 x 3 tiles, the last tiles end off the lattice
+	const FVector2D GridMinXY(-3000.0, 1200.0);
+	const FBox2D CropBoundsXY(
+		GridMinXY + FVector2D(OverscanCells * CellSize),
+		GridMinXY + FVector2D(OverscanCells * CellSize) + FVector2D(110.4 * CellSize, 80.6 * CellSize));
+
+	const FVector2D ExpandedSize = CropBoundsXY.GetSize() + FVector2D(2.0 * OverscanCells * CellSize);
+	const int32 GridX = FMath::FloorToInt32(ExpandedSize.X / CellSize) + 1;
+	const int32 GridY = FMath::FloorToInt32(ExpandedSize.Y / CellSize) + 1;
+
+	TArray<FPCGLandscapeGridSample> Samples;
+	MakeStreamingTestGrid(GridX, GridY, /*Seed=*/11, Samples);
+
+	FPCGLandscapeMeshBuilderSettings Settings;
+	Settings.CellSize = CellSize;
+	Settings.bRemoveIsolatedVertices = true;
+
+	// Single build
+	FPCGLandscapeMeshGridDesc GridDesc;
+	GridDesc.GridX = GridX;
+	GridDesc.GridY = GridY;
+	GridDesc.GridMinXY = GridMinXY;
+	GridDesc.Samples = &Samples;
+
+	UE::Geometry::FDynamicMesh3 Mesh;
+	FPCGLandscapeMeshConstraints Constraints;
+	if (!TestTrue(TEXT("Single build produces triangles"), BuildMeshFromSamples(GridDesc, Settings, CropBoundsXY, Mesh, Constraints)))
+	{
+		return false;
+	}
+	Mesh.CompactInPlace();
+
+	// Streamed build, tile samples taken from the same grid
+	FPCGLandscapeMeshStreamingState State;
+	if (!TestTrue(TEXT("Streaming init succeeds"), State.Init(CropBoundsXY, CellSize, OverscanCells, TileCells, /*bTriangleGroups=*/false)))
+	{
+		return false;
+	}
+	TestEqual(TEXT("Tiles in X"), State.NumTilesX, 4);
+	TestEqual(TEXT("Tiles in Y"), State.NumTilesY, 3);
+
+	TArray<FPCGLandscapeGridSample> TileSamples;
+	for (int32 TileIndex = 0; TileIndex < State.NumTiles(); ++TileIndex)
+	{
+		const FBox2D TileExpandedXY = State.GetTileExpandedBounds(TileIndex);
+		const int32 OffsetX = FMath::RoundToInt32((TileExpandedXY.Min.X - GridMinXY.X) / CellSize);
+		const int32 OffsetY = FMath::RoundToInt32((TileExpandedXY.Min.Y - GridMinXY.Y) / CellSize);
+		const int32 TileGridX = FMath::FloorToInt32(TileExpandedXY.GetSize().X / CellSize) + 1;
+		const int32 TileGridY = FMath::FloorToInt32(TileExpandedXY.GetSize().Y / CellSize) + 1;
+
+		if (!TestTrue(FString::Printf(TEXT("Tile %d is inside the grid"), TileIndex),
+			OffsetX >= 0 && OffsetY >= 0 && OffsetX + TileGridX <= GridX && OffsetY + TileGridY <= GridY))
+		{
+			return false;
+		}
+
+		TileSamples.SetNum(TileGridX * TileGridY);
+		for (int32 Y = 0; Y < TileGridY; ++Y)
+		{
+			for (int32 X = 0; X < TileGridX; ++X)
+			{
+				TileSamples[X + Y * TileGridX] = Samples[(OffsetX + X) + (OffsetY + Y) * GridX];
+			}
+		}
+
+		FPCGLandscapeMeshGridDesc TileGridDesc;
+		TileGridDesc.GridX = TileGridX;
+		TileGridDesc.GridY = TileGridY;
+		TileGridDesc.GridMinXY = TileExpandedXY.Min;
+		TileGridDesc.Samples = &TileSamples;
+
+		BuildStreamingTileFromSamples(State, TileIndex, TileGridDesc, Settings);
+		State.FinishTile(TileIndex);
+
+		// Seam vertices of finished rows are dropped
+		if (TileIndex % State.NumTilesX == State.NumTilesX - 1)
+		{
+			const int32 NextRowFirstLine = OverscanCells + (TileIndex / State.NumTilesX + 1) * TileCells;
+			for (const TPair<FIntVector, int32>& SeamVertex : State.SeamVertices)
+			{
+				if (!TestTrue(FString::Printf(TEXT("Seam vertex after tile %d is below the next row"), TileIndex), SeamVertex.Key.Y >= NextRowFirstLine))
+				{
+					return false;
+				}
+			}
+		}
+	}
+
+	TestEqual(TEXT("Seam vertices are all dropped at the end"), State.SeamVertices.Num(), 0);
+
+	UE::Geometry::FDynamicMesh3& StreamedMesh = State.Mesh;
+	StreamedMesh.CompactInPlace();
+
+	// No duplicate vertex, on the seams or anywhere else
+	TMap<FIntPoint, int32> StreamedPositions;
+	for (int32 Vid : StreamedMesh.VertexIndicesItr())
+	{
+		int32& Count = StreamedPositions.FindOrAdd(MakeStreamingTestPositionKey(StreamedMesh.GetVertex(Vid)));
+		++Count;
+	}
+
+	int32 NumDuplicates = 0;
+	for (const TPair<FIntPoint, int32>& Position : StreamedPositions)
+	{
+		NumDuplicates += Position.Value - 1;
+	}
+	TestEqual(TEXT("No duplicate vertices"), NumDuplicates, 0);
+
+	// Same vertices as the single build
+	int32 NumMissing = 0;
+	for (int32 Vid : Mesh.VertexIndicesItr())
+	{
+		NumMissing += StreamedPositions.Contains(MakeStreamingTestPositionKey(Mesh.GetVertex(Vid))) ? 0 : 1;
+	}
+	TestEqual(TEXT("Every single build vertex is streamed"), NumMissing, 0);
+
+	TestEqual(TEXT("Vertex count"), StreamedMesh.VertexCount(), Mesh.VertexCount());
+	TestEqual(TEXT("Triangle count"), StreamedMesh.TriangleCount(), Mesh.TriangleCount());
+
+	int32 NumBoundaryEdges = 0;
+	int32 NumStreamedBoundaryEdges = 0;
+	double Area = 0.0;
+	double StreamedArea = 0.0;
+	GetStreamingTestMeshStats(Mesh, NumBoundaryEdges, Area);
+	GetStreamingTestMeshStats(StreamedMesh, NumStreamedBoundaryEdges, StreamedArea);
+
+	TestEqual(TEXT("Boundary edge count (open seams add edges)"), NumStreamedBoundaryEdges, NumBoundaryEdges);
+	TestTrue(TEXT("Area"), FMath::IsNearlyEqual(StreamedArea, Area, Area * 1.0e-5));
+
+	// Regions over the streaming limit are refused
+	FPCGLandscapeMeshStreamingState TooLargeState;
+	const FBox2D TooLargeBoundsXY(FVector2D::ZeroVector, FVector2D(20000.0 * CellSize));
+	TestFalse(TEXT("Streaming refuses regions over the limit"), TooLargeState.Init(TooLargeBoundsXY, CellSize, OverscanCells, TileCells, false));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS && WITH_EDITOR
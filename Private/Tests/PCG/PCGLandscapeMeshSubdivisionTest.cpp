@@ -0,0 +1,150 @@
+// Copyright BULKHEAD Limited. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && WITH_EDITOR
+
+/* WDEditor */
+#include "PCG/PCGLandscapeMeshSubdivision.h"
+
+/* GeometryCore */
+#include "DynamicMesh/DynamicMesh3.h"
+#include "DynamicMesh/DynamicMeshAttributeSet.h"
+
+/**
+ * Subdivides a rolling grid mesh with a hole, constrained on its open boundary, twice from the same
+ * input and checks the results are identical, that constrained vertices did not move and that the
+ * boundary was not split (no cracks against a neighbouring tile).
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FWDEditorPCGLandscapeMeshSubdivisionInterior,
+	"WDEditor.PCG.LandscapeMeshSubdivision.Interior",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+namespace WDEditor::PCG::Tests
+{
+	/** GridSize x GridSize vertices, 100 units apart, without the cells of a centered square hole. */
+	static void MakeGridMesh(int32 GridSize, UE::Geometry::FDynamicMesh3& OutMesh)
+	{
+		OutMesh = UE::Geometry::FDynamicMesh3();
+		OutMesh.EnableTriangleGroups();
+		OutMesh.EnableAttributes();
+
+		for (int32 Y = 0; Y < GridSize; ++Y)
+		{
+			for (int32 X = 0; X < GridSize; ++X)
+			{
+				OutMesh.AppendVertex(FVector3d(X * 100.0, Y * 100.0, 150.0 * FMath::Sin(X * 0.4) * FMath::Cos(Y * 0.3)));
+			}
+		}
+
+		const int32 HoleMin = GridSize / 2 - 2;
+		const int32 HoleMax = GridSize / 2 + 2;
+		for (int32 Y = 0; Y < GridSize - 1; ++Y)
+		{
+			for (int32 X = 0; X < GridSize - 1; ++X)
+			{
+				if (X >= HoleMin && X < HoleMax && Y >= HoleMin && Y < HoleMax)
+				{
+					continue;
+				}
+
+				const int32 V00 = X + Y * GridSize;
+				const int32 V10 = V00 + 1;
+				const int32 V01 = V00 + GridSize;
+				const int32 V11 = V01 + 1;
+				OutMesh.AppendTriangle(V00, V11, V10, 0);
+				OutMesh.AppendTriangle(V00, V01, V11, 0);
+			}
+		}
+	}
+
+	static int32 CountBoundaryEdges(const UE::Geometry::FDynamicMesh3& Mesh)
+	{
+		int32 NumBoundaryEdges = 0;
+		for (int32 Eid : Mesh.EdgeIndicesItr())
+		{
+			NumBoundaryEdges += Mesh.IsBoundaryEdge(Eid) ? 1 : 0;
+		}
+		return NumBoundaryEdges;
+	}
+}
+
+bool FWDEditorPCGLandscapeMeshSubdivisionInterior::RunTest(const FString& Parameters)
+{
+	using namespace WDEditor::PCG;
+	using namespace WDEditor::PCG::Tests;
+
+	constexpr int32 GridSize = 65;
+
+	FPCGLandscapePNSubdivideSettings SubdivideSettings;
+	SubdivideSettings.SubdivisionLevels = 2;
+
+	UE::Geometry::FDynamicMesh3 Meshes[2];
+	FPCGLandscapeMeshConstraints Constraints;
+	FPCGLandscapeSubdivisionStats Stats;
+	int32 NumInputBoundaryEdges = 0;
+	TArray<TPair<int32, FVector3d>> ConstrainedPositions;
+
+	for (int32 Run = 0; Run < 2; ++Run)
+	{
+		MakeGridMesh(GridSize, Meshes[Run]);
+
+		BuildBoundaryConstraints(Meshes[Run], /*bConstrainGroupBoundaries=*/false, Constraints);
+		if (Run == 0)
+		{
+			NumInputBoundaryEdges = CountBoundaryEdges(Meshes[Run]);
+			for (const int32 Vid : Constraints.ConstrainedVertices)
+			{
+				ConstrainedPositions.Emplace(Vid, Meshes[Run].GetVertex(Vid));
+			}
+		}
+
+		TestTrue(TEXT("Mesh was refined"), ApplyPNSubdivideInterior(Meshes[Run], Constraints, SubdivideSettings, &Stats));
+	}
+
+	const UE::Geometry::FDynamicMesh3& Mesh = Meshes[0];
+
+	TestTrue(TEXT("Has constrained vertices"), ConstrainedPositions.Num() > 0);
+	TestTrue(TEXT("Vertices were added"), Stats.NumVerticesAdded > 0);
+	TestEqual(TEXT("Boundary edges are not split"), CountBoundaryEdges(Mesh), NumInputBoundaryEdges);
+
+	int32 NumMovedVertices = 0;
+	for (const TPair<int32, FVector3d>& Constrained : ConstrainedPositions)
+	{
+		NumMovedVertices += Mesh.GetVertex(Constrained.Key).Equals(Constrained.Value, 0.0) ? 0 : 1;
+	}
+	TestEqual(TEXT("Constrained vertices did not move"), NumMovedVertices, 0);
+
+	TestEqual(TEXT("Same vertex count"), Meshes[1].VertexCount(), Mesh.VertexCount());
+	TestEqual(TEXT("Same triangle count"), Meshes[1].TriangleCount(), Mesh.TriangleCount());
+	TestEqual(TEXT("Same max triangle ID"), Meshes[1].MaxTriangleID(), Mesh.MaxTriangleID());
+
+	int32 NumMismatches = 0;
+	for (int32 Vid : Mesh.VertexIndicesItr())
+	{
+		NumMismatches += (Meshes[1].IsVertex(Vid) && Meshes[1].GetVertex(Vid) == Mesh.GetVertex(Vid)) ? 0 : 1;
+	}
+	for (int32 Tid : Mesh.TriangleIndicesItr())
+	{
+		NumMismatches += (Meshes[1].IsTriangle(Tid) && Meshes[1].GetTriangle(Tid) == Mesh.GetTriangle(Tid)) ? 0 : 1;
+	}
+	TestEqual(TEXT("Runs are identical"), NumMismatches, 0);
+
+	// The normal overlay is rebuilt for the new triangles.
+	const UE::Geometry::FDynamicMeshNormalOverlay* Normals = Mesh.Attributes() ? Mesh.Attributes()->PrimaryNormals() : nullptr;
+	TestNotNull(TEXT("Normal overlay"), Normals);
+	if (Normals)
+	{
+		int32 NumUnsetTriangles = 0;
+		for (int32 Tid : Mesh.TriangleIndicesItr())
+		{
+			NumUnsetTriangles += Normals->IsSetTriangle(Tid) ? 0 : 1;
+		}
+		TestEqual(TEXT("Normals set on all triangles"), NumUnsetTriangles, 0);
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS && WITH_EDITOR
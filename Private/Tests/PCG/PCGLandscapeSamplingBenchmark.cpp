@@ -0,0 +1,158 @@
+// Copyright BULKHEAD Limited. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && WITH_EDITOR
+
+/* WDEditor */
+#include "PCG/PCGLandscapeSampling.h"
+
+/* PCG */
+#include "Data/PCGLandscapeData.h"
+#include "Helpers/PCGHelpers.h"
+
+/* Engine */
+#include "Editor.h"
+#include "HAL/PlatformTime.h"
+#include "LandscapeInfo.h"
+#include "LandscapeProxy.h"
+
+/**
+ * Compares the batched landscape grid sampler with the per-point ProjectPoint path on the landscape
+ * of the currently opened editor level: a 1 km tile at 50 cm cells, once with density and once with
+ * the first landscape layer as mask. Both paths must agree; timings are reported as test info.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FWDEditorPCGLandscapeSamplingBenchmark,
+	"WDEditor.PCG.LandscapeSampling.Benchmark",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+namespace WDEditor::PCG::Tests
+{
+	static double TimeSampling(
+		const UPCGLandscapeData* LandscapeData,
+		const FBox2D& GridBounds,
+		int32 GridSize,
+		const FPCGLandscapeSamplingSettings& Settings,
+		TArray<FPCGLandscapeGridSample>& OutSamples)
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		SampleLandscapeToGrid(LandscapeData, GridBounds, GridSize, GridSize, Settings, OutSamples);
+		return FPlatformTime::Seconds() - StartTime;
+	}
+}
+
+bool FWDEditorPCGLandscapeSamplingBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace WDEditor::PCG;
+
+	UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+	TArray<TWeakObjectPtr<ALandscapeProxy>> Landscapes;
+	if (World)
+	{
+		Landscapes = PCGHelpers::GetAllLandscapeProxies(World);
+	}
+
+	if (Landscapes.IsEmpty())
+	{
+		AddInfo(TEXT("No landscape in the editor world, skipping landscape sampling benchmark."));
+		return true;
+	}
+
+	FBox LandscapeBounds(ForceInit);
+	for (const TWeakObjectPtr<ALandscapeProxy>& Landscape : Landscapes)
+	{
+		LandscapeBounds += PCGHelpers::GetLandscapeBounds(Landscape.Get());
+	}
+
+	FPCGLandscapeDataProps DataProps;
+	DataProps.bGetLayerWeights = true;
+
+	UPCGLandscapeData* LandscapeData = NewObject<UPCGLandscapeData>();
+	LandscapeData->Initialize(Landscapes, LandscapeBounds, DataProps);
+
+	// 1 km tile at 50 cm cells, centered on the landscape
+	constexpr double CellSize = 50.0;
+	constexpr int32 GridSize = 2001;
+	const FVector2D Center(LandscapeBounds.GetCenter());
+	const FVector2D HalfSize(0.5 * CellSize * (GridSize - 1));
+	const FBox2D GridBounds(Center - HalfSize, Center + HalfSize);
+
+	FName FirstLayerName = NAME_None;
+	if (const ULandscapeInfo* LandscapeInfo = Landscapes[0]->GetLandscapeInfo())
+	{
+		for (const FLandscapeInfoLayerSettings& Layer : LandscapeInfo->Layers)
+		{
+			if (Layer.LayerInfoObj)
+			{
+				FirstLayerName = Layer.LayerName;
+				break;
+			}
+		}
+	}
+
+	TArray<FName, TInlineAllocator<2>> MaskLayers = { NAME_None };
+	if (FirstLayerName != NAME_None)
+	{
+		MaskLayers.Add(FirstLayerName);
+	}
+
+	for (const FName MaskLayer : MaskLayers)
+	{
+		FPCGLandscapeSamplingSettings Settings;
+		Settings.CellSize = CellSize;
+		Settings.MaskLayerName = MaskLayer;
+
+		TArray<FPCGLandscapeGridSample> PerPointSamples;
+		TArray<FPCGLandscapeGridSample> BatchedSamples;
+
+		// Warm up the landscape cache so that entry creation is not attributed to either path
+		Settings.bUseBatchedSampling = true;
+		Tests::TimeSampling(LandscapeData, GridBounds, GridSize, Settings, BatchedSamples);
+
+		Settings.bUseBatchedSampling = false;
+		const double PerPointTime = Tests::TimeSampling(LandscapeData, GridBounds, GridSize, Settings, PerPointSamples);
+
+		Settings.bUseBatchedSampling = true;
+		const double BatchedTime = Tests::TimeSampling(LandscapeData, GridBounds, GridSize, Settings, BatchedSamples);
+
+		AddInfo(FString::Printf(
+			TEXT("Mask '%s', %d samples: per-point %.3f ms, batched %.3f ms (x%.1f)"),
+			*MaskLayer.ToString(),
+			GridSize * GridSize,
+			PerPointTime * 1000.0,
+			BatchedTime * 1000.0,
+			BatchedTime > 0.0 ? PerPointTime / BatchedTime : 0.0));
+
+		if (!TestEqual(TEXT("Sample count"), BatchedSamples.Num(), PerPointSamples.Num()))
+		{
+			continue;
+		}
+
+		int32 NumSurfaceMismatches = 0;
+		int32 NumMaskMismatches = 0;
+		for (int32 Index = 0; Index < PerPointSamples.Num(); ++Index)
+		{
+			const FPCGLandscapeGridSample& A = PerPointSamples[Index];
+			const FPCGLandscapeGridSample& B = BatchedSamples[Index];
+
+			if (!FMath::IsNearlyEqual(A.Height, B.Height, 1e-3) || !A.Normal.Equals(B.Normal, 1e-4))
+			{
+				++NumSurfaceMismatches;
+			}
+
+			if (!FMath::IsNearlyEqual(A.Mask, B.Mask, 1e-5f))
+			{
+				++NumMaskMismatches;
+			}
+		}
+
+		TestEqual(FString::Printf(TEXT("Mismatching heights/normals (mask '%s')"), *MaskLayer.ToString()), NumSurfaceMismatches, 0);
+
+		TestEqual(FString::Printf(TEXT("Mismatching masks (mask '%s')"), *MaskLayer.ToString()), NumMaskMismatches, 0);
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS && WITH_EDITOR
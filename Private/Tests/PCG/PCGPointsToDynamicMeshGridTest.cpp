@@ -0,0 +1,410 @@
+// Copyright BULKHEAD Limited. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && WITH_EDITOR
+
+/* WDEditor */
+#include "PCG/PCGPointsToDynamicMeshGrid.h"
+
+/* PCG */
+#include "Data/PCGPointArrayData.h"
+#include "Metadata/PCGMetadata.h"
+#include "Metadata/PCGMetadataAttributeTpl.h"
+
+/* GeometryCore */
+#include "DynamicMesh/DynamicMesh3.h"
+
+/* Engine */
+#include "Algo/Find.h"
+#include "Math/RandomStream.h"
+
+/**
+ * Auto layout: rectangular row-major grids (axis aligned, and rotated with small jitter off the rows) resolve
+ * to their dimensions and mesh every cell. Points whose first row cannot be inferred fall back to a square
+ * grid with a warning, and fail with a warning when they are not a square grid either.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FWDEditorPCGPointsToDynamicMeshGridAutoLayout,
+	"WDEditor.PCG.PointsToDynamicMeshGrid.AutoLayout",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+/**
+ * Row/column layout with missing grid vertices and a duplicate point, in shuffled order: the holes are
+ * not present, the duplicate is ignored with a warning, and only the cells with four points are meshed.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FWDEditorPCGPointsToDynamicMeshGridRowColumnHoles,
+	"WDEditor.PCG.PointsToDynamicMeshGrid.RowColumnHoles",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+/**
+ * Landscape parity triangulation of a noisy mask in parallel row bands must give the serial mesh: same
+ * vertices in the same order, same triangles, and the same edge vertices on the band seam rows.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FWDEditorPCGPointsToDynamicMeshGridParallelMatchesSerial,
+	"WDEditor.PCG.PointsToDynamicMeshGrid.ParallelMatchesSerial",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+namespace WDEditor::PCG::Tests
+{
+	static UPCGPointArrayData* MakeGridTestPoints(TConstArrayView<FVector> Locations)
+	{
+		UPCGPointArrayData* PointData = NewObject<UPCGPointArrayData>();
+		PointData->SetNumPoints(Locations.Num());
+
+		TPCGValueRange<int64> MetadataEntries = PointData->GetMetadataEntryValueRange();
+		for (int32 i = 0; i < Locations.Num(); ++i)
+		{
+			MetadataEntries[i] = PointData->Metadata->AddEntry();
+		}
+
+		TPCGValueRange<FTransform> Transforms = PointData->GetTransformValueRange();
+		for (int32 i = 0; i < Locations.Num(); ++i)
+		{
+			Transforms[i].SetLocation(Locations[i]);
+		}
+
+		return PointData;
+	}
+
+	/** Grid vertices from the points, as the node does (mask from Mask, or all solid). */
+	static void FillGridTestVertices(
+		const UPCGBasePointData* PointData,
+		TConstArrayView<int32> LatticeIndices,
+		TConstArrayView<float> Mask,
+		float MaskThreshold,
+		FPCGPointsGridLattice& Grid)
+	{
+		const int32 NumGridVertices = Grid.GridX * Grid.GridY;
+		Grid.Positions.SetNumZeroed(NumGridVertices);
+		Grid.Normals.Init(FVector3f::UnitZ(), NumGridVertices);
+		Grid.Mask.Init(1.0f, NumGridVertices);
+		Grid.Solid.Init(true, NumGridVertices);
+
+		const TConstPCGValueRange<FTransform> Transforms = PointData->GetConstTransformValueRange();
+		for (int32 PointIndex = 0; PointIndex < Transforms.Num(); ++PointIndex)
+		{
+			const int32 VertexIndex = LatticeIndices.IsEmpty() ? PointIndex : LatticeIndices[PointIndex];
+			if (VertexIndex == INDEX_NONE)
+			{
+				continue;
+			}
+
+			Grid.Positions[VertexIndex] = Transforms[PointIndex].GetLocation();
+			if (!Mask.IsEmpty())
+			{
+				Grid.Mask[VertexIndex] = Mask[PointIndex];
+				Grid.Solid[VertexIndex] = Mask[PointIndex] >= MaskThreshold;
+			}
+		}
+	}
+
+	/** Row-major locations of a GridX x GridY grid, rotated by YawDegrees, with a deterministic offset off the rows. */
+	static TArray<FVector> MakeRowMajorLocations(int32 GridX, int32 GridY, double Spacing, double YawDegrees, double Jitter)
+	{
+		const FVector2D XAxis(FMath::Cos(FMath::DegreesToRadians(YawDegrees)), FMath::Sin(FMath::DegreesToRadians(YawDegrees)));
+		const FVector2D YAxis(-XAxis.Y, XAxis.X);
+
+		TArray<FVector> Locations;
+		for (int32 Y = 0; Y < GridY; ++Y)
+		{
+			for (int32 X = 0; X < GridX; ++X)
+			{
+				const double RowOffset = Jitter * (((X + Y) % 3) - 1);
+				const FVector2D Location = XAxis * (X * Spacing) + YAxis * (Y * Spacing + RowOffset) + FVector2D(1000.0, -500.0);
+				Locations.Emplace(Location.X, Location.Y, 10.0 * X);
+			}
+		}
+
+		return Locations;
+	}
+}
+
+bool FWDEditorPCGPointsToDynamicMeshGridAutoLayout::RunTest(const FString& Parameters)
+{
+	using namespace WDEditor::PCG;
+	using namespace WDEditor::PCG::Tests;
+
+	UPCGPointsToDynamicMeshGridSettings* Settings = NewObject<UPCGPointsToDynamicMeshGridSettings>();
+	Settings->GridLayout = EPCGPointsGridLayout::Auto;
+
+	struct FLayoutCase
+	{
+		const TCHAR* Name;
+		int32 GridX;
+		int32 GridY;
+		double YawDegrees;
+		double Jitter;
+	};
+
+	const FLayoutCase Cases[] =
+	{
+		{ TEXT("Axis aligned 5x3"), 5, 3, 0.0, 0.0 },
+		{ TEXT("Rotated 7x4 with jitter"), 7, 4, 30.0, 0.4 },
+		{ TEXT("Rotated 9x2 with jitter"), 9, 2, -75.0, 0.4 }
+	};
+
+	for (const FLayoutCase& Case : Cases)
+	{
+		const UPCGPointArrayData* PointData = MakeGridTestPoints(MakeRowMajorLocations(Case.GridX, Case.GridY, 100.0, Case.YawDegrees, Case.Jitter));
+
+		FPCGPointsGridLattice Grid;
+		TArray<int32> LatticeIndices;
+		if (!TestTrue(FString::Printf(TEXT("%s: layout resolved"), Case.Name),
+			ResolvePointsGridLayout(nullptr, *Settings, PointData, PointData->GetConstTransformValueRange(), Grid, LatticeIndices)))
+		{
+			return false;
+		}
+
+		TestEqual(FString::Printf(TEXT("%s: columns"), Case.Name), Grid.GridX, Case.GridX);
+		TestEqual(FString::Printf(TEXT("%s: rows"), Case.Name), Grid.GridY, Case.GridY);
+		TestTrue(FString::Printf(TEXT("%s: points are in grid order"), Case.Name), LatticeIndices.IsEmpty());
+
+		FillGridTestVertices(PointData, LatticeIndices, {}, Settings->MaskThreshold, Grid);
+
+		UE::Geometry::FDynamicMesh3 Mesh;
+		BuildPointsGridMesh(Grid, *Settings, Mesh);
+		TestEqual(FString::Printf(TEXT("%s: vertex count"), Case.Name), Mesh.VertexCount(), Case.GridX * Case.GridY);
+		TestEqual(FString::Printf(TEXT("%s: triangle count"), Case.Name), Mesh.TriangleCount(), 2 * (Case.GridX - 1) * (Case.GridY - 1));
+	}
+
+	// The third point leaves the row axis after two points, which do not divide 9: square fallback.
+	{
+		const TArray<FVector> Locations =
+		{
+			FVector(0.0, 0.0, 0.0), FVector(100.0, 0.0, 0.0), FVector(0.0, 100.0, 0.0),
+			FVector(200.0, 0.0, 0.0), FVector(100.0, 100.0, 0.0), FVector(200.0, 100.0, 0.0),
+			FVector(0.0, 200.0, 0.0), FVector(100.0, 200.0, 0.0), FVector(200.0, 200.0, 0.0)
+		};
+		const UPCGPointArrayData* PointData = MakeGridTestPoints(Locations);
+
+		AddExpectedError(TEXT("falling back to a 3x3 square grid"), EAutomationExpectedMessageFlags::Contains, 1);
+
+		FPCGPointsGridLattice Grid;
+		TArray<int32> LatticeIndices;
+		TestTrue(TEXT("Square fallback resolved"), ResolvePointsGridLayout(nullptr, *Settings, PointData, PointData->GetConstTransformValueRange(), Grid, LatticeIndices));
+		TestEqual(TEXT("Square fallback columns"), Grid.GridX, 3);
+		TestEqual(TEXT("Square fallback rows"), Grid.GridY, 3);
+	}
+
+	// A single row of 10 points is neither rows nor a square grid.
+	{
+		const UPCGPointArrayData* PointData = MakeGridTestPoints(MakeRowMajorLocations(10, 1, 100.0, 0.0, 0.0));
+
+		AddExpectedError(TEXT("are not a square grid"), EAutomationExpectedMessageFlags::Contains, 1);
+
+		FPCGPointsGridLattice Grid;
+		TArray<int32> LatticeIndices;
+		TestFalse(TEXT("Single row is refused"), ResolvePointsGridLayout(nullptr, *Settings, PointData, PointData->GetConstTransformValueRange(), Grid, LatticeIndices));
+	}
+
+	return true;
+}
+
+bool FWDEditorPCGPointsToDynamicMeshGridRowColumnHoles::RunTest(const FString& Parameters)
+{
+	using namespace WDEditor::PCG;
+	using namespace WDEditor::PCG::Tests;
+
+	constexpr int32 GridX = 6;
+	constexpr int32 GridY = 5;
+	constexpr int32 FirstColumn = -2;
+	constexpr int32 FirstRow = 3;
+	const FIntPoint Holes[] = { FIntPoint(2, 2), FIntPoint(5, 4) };
+
+	// Grid coordinates of the points: every vertex but the holes, shuffled, plus a duplicate of (0, 0).
+	TArray<FIntPoint> Coordinates;
+	for (int32 Y = 0; Y < GridY; ++Y)
+	{
+		for (int32 X = 0; X < GridX; ++X)
+		{
+			if (!Algo::Find(Holes, FIntPoint(X, Y)))
+			{
+				Coordinates.Emplace(X, Y);
+			}
+		}
+	}
+
+	FRandomStream RandomSource(7);
+	for (int32 i = Coordinates.Num() - 1; i > 0; --i)
+	{
+		Coordinates.Swap(i, RandomSource.RandRange(0, i));
+	}
+	Coordinates.Emplace(0, 0);
+
+	TArray<FVector> Locations;
+	for (const FIntPoint& Coordinate : Coordinates)
+	{
+		Locations.Emplace(Coordinate.X * 100.0, Coordinate.Y * 100.0, 0.0);
+	}
+
+	UPCGPointArrayData* PointData = MakeGridTestPoints(Locations);
+	FPCGMetadataAttribute<int32>* RowAttribute = PointData->Metadata->CreateAttribute<int32>(TEXT("Row"), 0, /*bAllowsInterpolation=*/false, /*bOverrideParent=*/false);
+	FPCGMetadataAttribute<int32>* ColumnAttribute = PointData->Metadata->CreateAttribute<int32>(TEXT("Column"), 0, /*bAllowsInterpolation=*/false, /*bOverrideParent=*/false);
+	check(RowAttribute && ColumnAttribute);
+
+	const TConstPCGValueRange<int64> MetadataEntries = PointData->GetConstMetadataEntryValueRange();
+	for (int32 i = 0; i < Coordinates.Num(); ++i)
+	{
+		RowAttribute->SetValue(MetadataEntries[i], FirstRow + Coordinates[i].Y);
+		ColumnAttribute->SetValue(MetadataEntries[i], FirstColumn + Coordinates[i].X);
+	}
+
+	UPCGPointsToDynamicMeshGridSettings* Settings = NewObject<UPCGPointsToDynamicMeshGridSettings>();
+	Settings->GridLayout = EPCGPointsGridLayout::RowColumnAttributes;
+
+	AddExpectedError(TEXT("1 points share a row/column"), EAutomationExpectedMessageFlags::Contains, 1);
+
+	FPCGPointsGridLattice Grid;
+	TArray<int32> LatticeIndices;
+	if (!TestTrue(TEXT("Layout resolved"), ResolvePointsGridLayout(nullptr, *Settings, PointData, PointData->GetConstTransformValueRange(), Grid, LatticeIndices)))
+	{
+		return false;
+	}
+
+	TestEqual(TEXT("Columns"), Grid.GridX, GridX);
+	TestEqual(TEXT("Rows"), Grid.GridY, GridY);
+	TestEqual(TEXT("Lattice index per point"), LatticeIndices.Num(), Coordinates.Num());
+	TestEqual(TEXT("Duplicate is ignored"), LatticeIndices.Last(), (int32)INDEX_NONE);
+	TestEqual(TEXT("Present vertices"), Grid.Present.CountSetBits(), GridX * GridY - (int32)UE_ARRAY_COUNT(Holes));
+
+	for (int32 i = 0; i < Coordinates.Num() - 1; ++i)
+	{
+		if (!TestEqual(FString::Printf(TEXT("Point %d lands on its row/column"), i), LatticeIndices[i], Grid.Index(Coordinates[i].X, Coordinates[i].Y)))
+		{
+			return false;
+		}
+	}
+
+	for (const FIntPoint& Hole : Holes)
+	{
+		TestFalse(FString::Printf(TEXT("Hole (%d, %d) is not present"), Hole.X, Hole.Y), Grid.Present[Grid.Index(Hole.X, Hole.Y)]);
+	}
+
+	FillGridTestVertices(PointData, LatticeIndices, {}, Settings->MaskThreshold, Grid);
+
+	// The inner hole removes its four cells, the corner hole one cell.
+	UE::Geometry::FDynamicMesh3 Mesh;
+	BuildPointsGridMesh(Grid, *Settings, Mesh);
+	TestEqual(TEXT("Triangle count"), Mesh.TriangleCount(), 2 * ((GridX - 1) * (GridY - 1) - 5));
+	TestEqual(TEXT("Vertex count"), Mesh.VertexCount(), GridX * GridY - (int32)UE_ARRAY_COUNT(Holes));
+
+	for (int32 Tid : Mesh.TriangleIndicesItr())
+	{
+		if (!TestTrue(TEXT("Triangles span a single cell"), FMath::IsNearlyEqual(Mesh.GetTriArea(Tid), 0.5 * 100.0 * 100.0, 1.0e-3)))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool FWDEditorPCGPointsToDynamicMeshGridParallelMatchesSerial::RunTest(const FString& Parameters)
+{
+	using namespace WDEditor::PCG;
+	using namespace WDEditor::PCG::Tests;
+
+	constexpr int32 GridX = 96;
+	constexpr int32 GridY = 80;
+	constexpr int32 RowsPerBand = 7;
+
+	TArray<FVector> Locations = MakeRowMajorLocations(GridX, GridY, 100.0, 0.0, 0.0);
+	TArray<float> Mask;
+	FRandomStream RandomSource(23);
+	for (int32 Y = 0; Y < GridY; ++Y)
+	{
+		for (int32 X = 0; X < GridX; ++X)
+		{
+			const float Blobs = 0.5f + 0.5f * FMath::Sin(X * 0.17f + 0.4f) * FMath::Sin(Y * 0.13f);
+			Mask.Add(FMath::Clamp(Blobs + RandomSource.FRandRange(-0.3f, 0.3f), 0.0f, 1.0f));
+			Locations[X + Y * GridX].Z = 50.0 * FMath::Sin(X * 0.1) * FMath::Cos(Y * 0.05);
+		}
+	}
+
+	const UPCGPointArrayData* PointData = MakeGridTestPoints(Locations);
+
+	UPCGPointsToDynamicMeshGridSettings* SerialSettings = NewObject<UPCGPointsToDynamicMeshGridSettings>();
+	SerialSettings->TopologyMode = EPCGGridTopologyMode::LandscapeParity;
+	SerialSettings->bUseParallelBuild = false;
+
+	UPCGPointsToDynamicMeshGridSettings* ParallelSettings = NewObject<UPCGPointsToDynamicMeshGridSettings>();
+	ParallelSettings->TopologyMode = EPCGGridTopologyMode::LandscapeParity;
+	ParallelSettings->bUseParallelBuild = true;
+	ParallelSettings->RowsPerBand = RowsPerBand;
+
+	FPCGPointsGridLattice Grid;
+	TArray<int32> LatticeIndices;
+	if (!TestTrue(TEXT("Layout resolved"), ResolvePointsGridLayout(nullptr, *SerialSettings, PointData, PointData->GetConstTransformValueRange(), Grid, LatticeIndices)))
+	{
+		return false;
+	}
+	TestEqual(TEXT("Columns"), Grid.GridX, GridX);
+	TestEqual(TEXT("Rows"), Grid.GridY, GridY);
+
+	FillGridTestVertices(PointData, LatticeIndices, Mask, SerialSettings->MaskThreshold, Grid);
+
+	UE::Geometry::FDynamicMesh3 SerialMesh;
+	UE::Geometry::FDynamicMesh3 ParallelMesh;
+	BuildPointsGridMesh(Grid, *SerialSettings, SerialMesh);
+	BuildPointsGridMesh(Grid, *ParallelSettings, ParallelMesh);
+
+	TestTrue(TEXT("Mask has holes and solid areas"), SerialMesh.TriangleCount() > 0 && SerialMesh.TriangleCount() < 2 * (GridX - 1) * (GridY - 1));
+	TestEqual(TEXT("Vertex count"), ParallelMesh.VertexCount(), SerialMesh.VertexCount());
+	TestEqual(TEXT("Triangle count"), ParallelMesh.TriangleCount(), SerialMesh.TriangleCount());
+	if (ParallelMesh.VertexCount() != SerialMesh.VertexCount() || ParallelMesh.TriangleCount() != SerialMesh.TriangleCount())
+	{
+		return false;
+	}
+
+	for (int32 Vid = 0; Vid < SerialMesh.MaxVertexID(); ++Vid)
+	{
+		if (!TestTrue(FString::Printf(TEXT("Vertex %d matches"), Vid), SerialMesh.GetVertex(Vid).Equals(ParallelMesh.GetVertex(Vid), 1.0e-6)))
+		{
+			return false;
+		}
+	}
+
+	for (int32 Tid = 0; Tid < SerialMesh.MaxTriangleID(); ++Tid)
+	{
+		if (!TestTrue(FString::Printf(TEXT("Triangle %d matches"), Tid), SerialMesh.GetTriangle(Tid) == ParallelMesh.GetTriangle(Tid)))
+		{
+			return false;
+		}
+	}
+
+	// Edge vertices on band seam rows are created once and shared by both bands.
+	auto CountSeamEdgeVertices = [](const UE::Geometry::FDynamicMesh3& Mesh, TSet<FIntPoint>& OutPositions)
+	{
+		int32 NumSeamVertices = 0;
+		for (int32 Vid : Mesh.VertexIndicesItr())
+		{
+			const FVector3d Position = Mesh.GetVertex(Vid);
+			const int32 Row = FMath::RoundToInt32(Position.Y / 100.0);
+			const bool bOnSeamRow = FMath::IsNearlyEqual(Position.Y, Row * 100.0, 1.0e-3) && Row > 0 && Row < GridY - 1 && Row % RowsPerBand == 0;
+			const bool bOnLatticeColumn = FMath::IsNearlyEqual(Position.X / 100.0, FMath::RoundToDouble(Position.X / 100.0), 1.0e-5);
+			if (bOnSeamRow && !bOnLatticeColumn)
+			{
+				OutPositions.Add(FIntPoint(FMath::RoundToInt32(Position.X * 100.0), Row));
+				++NumSeamVertices;
+			}
+		}
+		return NumSeamVertices;
+	};
+
+	TSet<FIntPoint> SerialSeamPositions;
+	TSet<FIntPoint> ParallelSeamPositions;
+	const int32 NumSerialSeamVertices = CountSeamEdgeVertices(SerialMesh, SerialSeamPositions);
+	const int32 NumParallelSeamVertices = CountSeamEdgeVertices(ParallelMesh, ParallelSeamPositions);
+
+	TestTrue(TEXT("Mask crosses the band seams"), NumSerialSeamVertices > 0);
+	TestEqual(TEXT("Seam edge vertex count"), NumParallelSeamVertices, NumSerialSeamVertices);
+	TestEqual(TEXT("No duplicate seam edge vertices"), ParallelSeamPositions.Num(), NumParallelSeamVertices);
+	TestTrue(TEXT("Same seam edge vertices"), ParallelSeamPositions.Difference(SerialSeamPositions).IsEmpty());
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS && WITH_EDITOR
@@ -22,6 +22,8 @@
  * Unlike earlier versions, there is no DisplacementTexture property; the
  * height map must be provided via the optional Texture input pin.  If no
  * texture data is connected, the mesh will pass through unchanged.
+ * Landscape heightfield inputs are displaced directly, along Z only, and
+ * their normals are recomputed from the new heights.
  */
 UCLASS(
     BlueprintType,
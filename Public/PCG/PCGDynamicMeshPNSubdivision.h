@@ -0,0 +1,83 @@
+// Copyright BULKHEAD Limited. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/* PCG GeometryScript Interop */
+#include "Elements/PCGDynamicMeshBaseElement.h"
+#include "PCGCommon.h"
+
+#include "PCGDynamicMeshPNSubdivision.generated.h"
+
+/**
+ * Settings for the Dynamic Mesh PN Subdivision node.  This node refines the
+ * interior of a dynamic mesh with PN-style (curved) edge midpoints, see
+ * PCGLandscapeMeshSubdivision.  Open boundary edges, and optionally polygroup
+ * boundaries, are constrained: they are never split and their vertices never
+ * move, so tiles or partitions of the same terrain keep matching seams.
+ */
+UCLASS(
+    BlueprintType,
+    ClassGroup=(PCG),
+    meta=(
+        DisplayName="Dynamic Mesh PN Subdivision",
+        Category="PCG|Dynamic Mesh"
+    )
+)
+class WDEDITOR_API UPCGDynamicMeshPNSubdivisionSettings : public UPCGDynamicMeshBaseSettings
+{
+    GENERATED_BODY()
+
+public:
+    UPCGDynamicMeshPNSubdivisionSettings();
+
+    /** Factory that creates the element corresponding to this settings class. */
+    virtual FPCGElementPtr CreateElement() const override;
+
+    /** Number of refinement passes.  Each pass splits every refinable edge once. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Subdivision",
+        meta=(ClampMin="0", ClampMax="4", PCG_Overridable))
+    int32 SubdivisionLevels = 1;
+
+    /**
+     * PN curvature strength.  0 places new vertices on the edge midpoints,
+     * typical values are 0.15 to 0.35.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Subdivision",
+        meta=(ClampMin="0.0", ClampMax="1.0", PCG_Overridable))
+    float PNStrength = 0.25f;
+
+    /** Rings of triangles around constrained vertices that are left unrefined. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Constraints",
+        meta=(ClampMin="0", ClampMax="8", PCG_Overridable))
+    int32 ConstraintGuardRing = 1;
+
+    /** Also constrain the edges between triangles of different polygroups. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Constraints", meta=(PCG_Overridable))
+    bool bConstrainPolygroupBoundaries = false;
+
+    /**
+     * Split an edge only when every triangle on it is refinable.  When
+     * disabled, an edge is split when any of its triangles is.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Subdivision", AdvancedDisplay)
+    bool bRequireNeighborAgreement = true;
+
+    /** Recompute the vertex normals driving the PN midpoints after each level. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Subdivision", AdvancedDisplay)
+    bool bRecomputeNormalsEachLevel = true;
+
+#if WITH_EDITOR
+    virtual FName GetDefaultNodeName() const override { return TEXT("DynamicMeshPNSubdivision"); }
+
+    virtual FText GetDefaultNodeTitle() const override
+    {
+        return NSLOCTEXT("WDEditor", "DynamicMeshPNSubdivision_Title", "Dynamic Mesh PN Subdivision");
+    }
+#endif
+
+protected:
+    /** The input pin also accepts landscape heightfield data, converted to a mesh before refinement. */
+    virtual TArray<FPCGPinProperties> InputPinProperties() const override;
+};
@@ -0,0 +1,236 @@
+// Copyright BULKHEAD Limited. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "Async/TaskGraphInterfaces.h"
+#include "Containers/BitArray.h"
+
+/**
+ * Dense topology helpers for regular vertex lattices (row-major, X changes fastest).
+ *
+ * On a lattice every edge has an implicit index, so per-edge data (marching squares
+ * crossing vertices, ...) is stored in flat arrays instead of hash maps keyed by edge.
+ * Used by PCGLandscapeMeshBuilder and PCGPointsToDynamicMeshGrid.
+ *
+ * Both also triangulate rows of cells in parallel bands: each band records its new edge
+ * vertices and triangles with band relative vertex references, and bands are appended to
+ * the mesh in band order so the result is identical to the serial build.
+ */
+
+namespace WDEditor::PCG
+{
+	/**
+	 * One value per lattice edge, for the vertex rows [FirstRow, FirstRow + NumRows).
+	 * Horizontal edge (X, Y) joins (X, Y)-(X + 1, Y), vertical edge (X, Y) joins (X, Y)-(X, Y + 1).
+	 * A window (FirstRow > 0) covers a band of a larger lattice and is indexed with lattice coordinates.
+	 */
+	template <typename ValueType>
+	class TPCGGridEdgeArray
+	{
+	public:
+		void Init(int32 InGridX, int32 InNumRows, const ValueType& InValue, int32 InFirstRow = 0)
+		{
+			check(InGridX >= 1 && InNumRows >= 1);
+
+			GridX = InGridX;
+			FirstRow = InFirstRow;
+			NumRows = InNumRows;
+
+			HorizontalEdges.Init(InValue, (GridX - 1) * NumRows);
+			VerticalEdges.Init(InValue, GridX * (NumRows - 1));
+		}
+
+		void Empty()
+		{
+			HorizontalEdges.Empty();
+			VerticalEdges.Empty();
+			GridX = FirstRow = NumRows = 0;
+		}
+
+		FORCEINLINE ValueType& Horizontal(int32 X, int32 Y)
+		{
+			checkSlow(X >= 0 && X < GridX - 1 && Y >= FirstRow && Y < FirstRow + NumRows);
+			return HorizontalEdges[X + (Y - FirstRow) * (GridX - 1)];
+		}
+
+		FORCEINLINE ValueType& Vertical(int32 X, int32 Y)
+		{
+			checkSlow(X >= 0 && X < GridX && Y >= FirstRow && Y < FirstRow + NumRows - 1);
+			return VerticalEdges[X + (Y - FirstRow) * GridX];
+		}
+
+		/** Dir: 0 = horizontal, 1 = vertical. */
+		FORCEINLINE ValueType& Get(int32 X, int32 Y, int32 Dir)
+		{
+			return (Dir == 0) ? Horizontal(X, Y) : Vertical(X, Y);
+		}
+
+		/** Edge between two adjacent lattice vertices given by their row-major indices. */
+		FORCEINLINE ValueType& GetByVertices(int32 VertexA, int32 VertexB)
+		{
+			const int32 Min = FMath::Min(VertexA, VertexB);
+			const int32 Max = FMath::Max(VertexA, VertexB);
+			checkSlow(Max - Min == 1 || Max - Min == GridX);
+			return (Max - Min == 1) ? Horizontal(Min % GridX, Min / GridX) : Vertical(Min % GridX, Min / GridX);
+		}
+
+		/** Values of the horizontal edges on row Y, GridX - 1 entries. */
+		TConstArrayView<ValueType> GetHorizontalRow(int32 Y) const
+		{
+			check(Y >= FirstRow && Y < FirstRow + NumRows);
+			return TConstArrayView<ValueType>(HorizontalEdges.GetData() + (Y - FirstRow) * (GridX - 1), GridX - 1);
+		}
+
+		SIZE_T GetAllocatedSize() const
+		{
+			return HorizontalEdges.GetAllocatedSize() + VerticalEdges.GetAllocatedSize();
+		}
+
+	private:
+		int32 GridX = 0;
+		int32 FirstRow = 0;
+		int32 NumRows = 0;
+
+		TArray<ValueType> HorizontalEdges;
+		TArray<ValueType> VerticalEdges;
+	};
+
+	/**
+	 * Set of non-negative indices (vertex or edge IDs) stored as a bit array, grown on demand.
+	 * Iterates in ascending index order.
+	 */
+	class FPCGDenseIndexSet
+	{
+	public:
+		/** Pre-sizes the set for indices in [0, InNum). */
+		void Reserve(int32 InNum)
+		{
+			if (Bits.Num() < InNum)
+			{
+				Bits.PadToNum(InNum, false);
+			}
+		}
+
+		FORCEINLINE void Add(int32 Index)
+		{
+			check(Index >= 0);
+			if (Index >= Bits.Num())
+			{
+				Bits.PadToNum(FMath::Max(Index + 1, Bits.Num() * 2), false);
+			}
+			Bits[Index] = true;
+		}
+
+		FORCEINLINE bool Contains(int32 Index) const
+		{
+			return Index >= 0 && Index < Bits.Num() && Bits[Index];
+		}
+
+		void Reset()
+		{
+			Bits.Reset();
+		}
+
+		/** Number of indices in the set (counts the bits). */
+		int32 Num() const
+		{
+			return Bits.CountSetBits();
+		}
+
+		bool IsEmpty() const
+		{
+			return Bits.Find(true) == INDEX_NONE;
+		}
+
+		/** Indices in ascending order. */
+		TArray<int32> Array() const
+		{
+			TArray<int32> Result;
+			for (TConstSetBitIterator<> It(Bits); It; ++It)
+			{
+				Result.Add(It.GetIndex());
+			}
+			return Result;
+		}
+
+		SIZE_T GetAllocatedSize() const
+		{
+			return Bits.GetAllocatedSize();
+		}
+
+		/** Range-for support. The end iterator is only a sentinel. */
+		class FConstIterator
+		{
+		public:
+			explicit FConstIterator(const TBitArray<>& InBits) : It(InBits) {}
+
+			FORCEINLINE int32 operator*() const { return It.GetIndex(); }
+			FORCEINLINE FConstIterator& operator++() { ++It; return *this; }
+			FORCEINLINE bool operator!=(const FConstIterator&) const { return (bool)It; }
+
+		private:
+			TConstSetBitIterator<> It;
+		};
+
+		FConstIterator begin() const { return FConstIterator(Bits); }
+		FConstIterator end() const { return FConstIterator(Bits); }
+
+	private:
+		TBitArray<> Bits;
+	};
+
+	/**
+	 * Vertex references recorded by a row band: >= 0 is a lattice (corner) vertex ID, < 0 is a new
+	 * edge vertex of the band, or a horizontal edge vertex on the bottom row of the previous band.
+	 * Seams: a horizontal edge on the first row of a band is created by the previous band whenever
+	 * the cell above it was triangulated, the band then references it through the previous band's
+	 * bottom row table (GetHorizontalRow of its edge array, band local indices).
+	 */
+	namespace PCGGridBandVertexRef
+	{
+		constexpr int32 PreviousBandEdgeFlag = 1 << 30;
+
+		FORCEINLINE int32 EncodeBandEdgeVertex(int32 LocalIndex)
+		{
+			return -1 - LocalIndex;
+		}
+
+		FORCEINLINE int32 EncodePreviousBandEdgeVertex(int32 X)
+		{
+			return -1 - (X | PreviousBandEdgeFlag);
+		}
+
+		/** Mesh vertex ID of a reference, given the first vertex ID of the band edge vertices and of the previous band's. */
+		FORCEINLINE int32 Decode(int32 Ref, int32 VertexIDBase, TConstArrayView<int32> PreviousBottomRow, int32 PreviousVertexIDBase)
+		{
+			if (Ref >= 0)
+			{
+				return Ref;
+			}
+
+			const int32 Edge = -1 - Ref;
+			if (Edge & PreviousBandEdgeFlag)
+			{
+				const int32 LocalIndex = PreviousBottomRow[Edge & ~PreviousBandEdgeFlag];
+				check(LocalIndex != INDEX_NONE);
+				return PreviousVertexIDBase + LocalIndex;
+			}
+
+			return VertexIDBase + Edge;
+		}
+	}
+
+	/** Cell rows per band for a parallel build of NumCellRows rows. InRowsPerBand <= 0 picks a few bands per worker (mask coverage is uneven). */
+	inline int32 ComputeGridRowsPerBand(int32 NumCellRows, int32 InRowsPerBand)
+	{
+		if (InRowsPerBand > 0)
+		{
+			return InRowsPerBand;
+		}
+
+		const int32 TargetNumBands = FMath::Max(1, FTaskGraphInterface::Get().GetNumWorkerThreads() * 4);
+		return FMath::Max(16, FMath::DivideAndRoundUp(NumCellRows, TargetNumBands));
+	}
+}
@@ -0,0 +1,137 @@
+// Copyright BULKHEAD Limited. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "Containers/BitArray.h"
+
+/**
+ * Heightfield-native representation of a landscape tile.
+ *
+ * Most of a landscape mesh is a regular lattice: a height, a normal and a solid bit per lattice vertex
+ * describe it completely. Only the cells crossed by the mask boundary (marching squares cells) need more,
+ * they are kept in a sparse list with the crossing position on each of their edges. Compared to an
+ * FDynamicMesh3 (positions, half-edge topology, normal overlay) a tile takes several times less memory,
+ * and per-vertex operations (displacement, normals, crop) are plain array loops.
+ *
+ * BuildHeightfieldFromSamples and BuildMeshFromHeightfield (PCGLandscapeMeshBuilder) convert from
+ * samples and to a general mesh. UPCGLandscapeHeightfieldData carries it through PCG graphs.
+ */
+
+namespace WDEditor::PCG
+{
+	/** A cell crossed by the mask boundary. */
+	struct FPCGLandscapeHeightfieldBoundaryCell
+	{
+		/** Cell index, X + Y * (GridX - 1). */
+		int32 CellIndex = INDEX_NONE;
+
+		/**
+		 * Crossing position on the cell edges E0 (bottom), E1 (right), E2 (top), E3 (left), in [0, 1] from the
+		 * lower lattice vertex of the edge. Only meaningful for crossed edges (corners with different solidity).
+		 */
+		float EdgeT[4] = { 0.5f, 0.5f, 0.5f, 0.5f };
+	};
+
+	/** Lattice of GridX * GridY vertices, row-major (X changes fastest). */
+	struct FPCGLandscapeHeightfield
+	{
+		int32 GridX = 0;
+		int32 GridY = 0;
+
+		/** World-space XY of lattice vertex (0, 0). */
+		FVector2D GridMinXY = FVector2D::ZeroVector;
+
+		/** World distance between lattice vertices. */
+		double CellSize = 100.0;
+
+		/** Meshes built from the heightfield are in local XY: world XY - OriginXY. Z is not offset. */
+		FVector2D OriginXY = FVector2D::ZeroVector;
+
+		/** Z per lattice vertex. */
+		TArray<float> Heights;
+
+		/** Unit normal per lattice vertex. */
+		TArray<FVector3f> Normals;
+
+		/** Mask solidity per lattice vertex. */
+		TBitArray<> Solid;
+
+		/** Cells crossed by the mask boundary, in ascending cell index. Empty when marching squares is disabled. */
+		TArray<FPCGLandscapeHeightfieldBoundaryCell> BoundaryCells;
+
+		/** Cells overlapping CropBoundsXY, [Min, Max): the only cells that can hold a triangle inside it. */
+		FIntRect CropCells;
+
+		/**
+		 * World-space crop bounds. As in BuildMeshFromSamples, a triangle whose XY centroid is not inside them is
+		 * padding: dropped, or kept when bIncludePadding is set. Nothing is cropped while invalid.
+		 */
+		FBox2D CropBoundsXY = FBox2D(ForceInit);
+		bool bIncludePadding = false;
+
+		/** Triangulation options, as in FPCGLandscapeMeshBuilderSettings. */
+		bool bUseMarchingSquares = true;
+		bool bSolidQuadsUseDiagBLtoTR = true;
+
+		/** Polygroup of the padding triangles when >= 0. */
+		int32 PaddingPolygroupID = -1;
+
+		FORCEINLINE int32 NumVertices() const { return GridX * GridY; }
+		FORCEINLINE int32 NumCellsX() const { return GridX - 1; }
+		FORCEINLINE int32 NumCellsY() const { return GridY - 1; }
+
+		FORCEINLINE int32 VertexIndex(int32 X, int32 Y) const { return X + Y * GridX; }
+		FORCEINLINE int32 CellIndex(int32 X, int32 Y) const { return X + Y * (GridX - 1); }
+
+		/** Position of lattice vertex (X, Y) in the local space of the built meshes. */
+		FORCEINLINE FVector3d GetLocalPosition(int32 X, int32 Y) const
+		{
+			return FVector3d(
+				GridMinXY.X + (double)X * CellSize - OriginXY.X,
+				GridMinXY.Y + (double)Y * CellSize - OriginXY.Y,
+				(double)Heights[VertexIndex(X, Y)]);
+		}
+
+		bool IsValid() const
+		{
+			return GridX >= 2 && GridY >= 2
+				&& Heights.Num() == NumVertices()
+				&& Normals.Num() == NumVertices()
+				&& Solid.Num() == NumVertices();
+		}
+
+		void Reset()
+		{
+			*this = FPCGLandscapeHeightfield();
+		}
+
+		SIZE_T GetAllocatedSize() const
+		{
+			return Heights.GetAllocatedSize() + Normals.GetAllocatedSize() + Solid.GetAllocatedSize() + BoundaryCells.GetAllocatedSize();
+		}
+	};
+
+	/** Cells overlapping CropBoundsXY (world), clamped to the lattice. May be empty. */
+	FIntRect ComputeHeightfieldCropCells(const FPCGLandscapeHeightfield& Heightfield, const FBox2D& CropBoundsXY);
+
+	/**
+	 * Keeps the cells in Cells (clamped to the lattice) and the vertices around them. Boundary cells are
+	 * remapped, CropCells is intersected with the kept cells.
+	 * @return false if no cell is kept (the heightfield is then reset).
+	 */
+	bool CropHeightfield(FPCGLandscapeHeightfield& Heightfield, const FIntRect& Cells);
+
+	/** Crops to the cells overlapping CropBoundsXY (world) and narrows Heightfield.CropBoundsXY to it. */
+	bool CropHeightfield(FPCGLandscapeHeightfield& Heightfield, const FBox2D& CropBoundsXY);
+
+	/**
+	 * Recomputes the normals from the heights: central differences inside the lattice, one-sided on its border.
+	 * Rows run in parallel, the result does not depend on scheduling.
+	 */
+	void ComputeHeightfieldNormals(FPCGLandscapeHeightfield& Heightfield);
+
+	/** Min / max height over all lattice vertices. Returns false on an empty heightfield. */
+	bool ComputeHeightfieldHeightRange(const FPCGLandscapeHeightfield& Heightfield, float& OutMin, float& OutMax);
+}
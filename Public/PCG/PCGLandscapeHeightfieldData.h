@@ -0,0 +1,89 @@
+// Copyright BULKHEAD Limited. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "Data/PCGSpatialData.h"
+#include "Misc/SpinLock.h"
+
+#include "PCG/PCGLandscapeHeightfield.h"
+
+#include "PCGLandscapeHeightfieldData.generated.h"
+
+class UMaterialInterface;
+class UPCGDynamicMeshData;
+
+/**
+ * Landscape tile as a heightfield (see PCGLandscapeHeightfield), output by Landscape To Dynamic Mesh when
+ * Output Heightfield is enabled. Dynamic Mesh Displacement works on it directly; nodes that need a general
+ * mesh call CreateDynamicMeshData, and ToDynamicMeshData caches the conversion for read-only uses (points,
+ * sampling by other data).
+ *
+ * Typed as Other: Dynamic Mesh pins of other nodes take the output of Heightfield To Dynamic Mesh.
+ */
+UCLASS(BlueprintType, ClassGroup = (Procedural))
+class WDEDITOR_API UPCGLandscapeHeightfieldData : public UPCGSpatialData
+{
+	GENERATED_BODY()
+
+public:
+	void Initialize(WDEditor::PCG::FPCGLandscapeHeightfield&& InHeightfield, UMaterialInterface* InMaterial = nullptr);
+
+	const WDEditor::PCG::FPCGLandscapeHeightfield& GetHeightfield() const { return Heightfield; }
+
+	/** Invalidates the cached bounds and mesh. */
+	WDEditor::PCG::FPCGLandscapeHeightfield& GetMutableHeightfield();
+
+	UMaterialInterface* GetMaterial() const { return Material; }
+
+	/** New dynamic mesh data built from the heightfield, owned by the caller (safe to modify). */
+	UPCGDynamicMeshData* CreateDynamicMeshData(FPCGContext* Context) const;
+
+	/** Dynamic mesh data built on first use and kept with this data (counted in its resource size). Must not be modified. */
+	const UPCGDynamicMeshData* ToDynamicMeshData(FPCGContext* Context) const;
+
+	// ~Begin UObject interface
+	virtual void Serialize(FArchive& Ar) override;
+	virtual void GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize) override;
+	// ~End UObject interface
+
+	// ~Begin UPCGData interface
+	virtual EPCGDataType GetDataType() const override { return EPCGDataType::Other; }
+	virtual void AddToCrc(FArchiveCrc32& Ar, bool bFullDataCrc) const override;
+	// ~End UPCGData interface
+
+	// ~Begin UPCGSpatialData interface
+	virtual int GetDimension() const override { return 2; }
+	virtual FBox GetBounds() const override;
+	virtual bool SamplePoint(const FTransform& Transform, const FBox& Bounds, FPCGPoint& OutPoint, UPCGMetadata* OutMetadata) const override;
+	virtual const UPCGPointData* ToPointData(FPCGContext* Context, const FBox& InBounds = FBox(EForceInit::ForceInit)) const override;
+	virtual const UPCGPointArrayData* ToPointArrayData(FPCGContext* Context, const FBox& InBounds = FBox(EForceInit::ForceInit)) const override;
+	// ~End UPCGSpatialData interface
+
+protected:
+	// ~Begin UPCGData interface
+	virtual bool SupportsFullDataCrc() const override { return true; }
+	// ~End UPCGData interface
+
+	// ~Begin UPCGSpatialData interface
+	virtual UPCGSpatialData* CopyInternal(FPCGContext* Context) const override;
+	// ~End UPCGSpatialData interface
+
+	UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Category = "Heightfield")
+	TObjectPtr<UMaterialInterface> Material = nullptr;
+
+private:
+	/** const but sets the mutable CachedBounds. */
+	void ResetBounds() const;
+
+	WDEditor::PCG::FPCGLandscapeHeightfield Heightfield;
+
+	mutable FBox CachedBounds = FBox(EForceInit::ForceInit);
+	mutable bool bBoundsAreDirty = true;
+	mutable UE::FSpinLock BoundsLock;
+
+	UPROPERTY(Transient)
+	mutable TObjectPtr<UPCGDynamicMeshData> CachedMeshData = nullptr;
+	mutable FCriticalSection CachedMeshDataLock;
+};
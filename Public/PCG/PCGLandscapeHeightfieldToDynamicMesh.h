@@ -0,0 +1,47 @@
+// Copyright BULKHEAD Limited. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/* PCG GeometryScript Interop */
+#include "Elements/PCGDynamicMeshBaseElement.h"
+#include "PCGCommon.h"
+
+#include "PCGLandscapeHeightfieldToDynamicMesh.generated.h"
+
+/**
+ * Settings for the Heightfield To Dynamic Mesh node.  Converts landscape
+ * heightfield data (Landscape To Dynamic Mesh with Output Heightfield) into
+ * dynamic mesh data, for the nodes that need a general mesh.  Dynamic mesh
+ * inputs are forwarded unchanged.
+ */
+UCLASS(
+    BlueprintType,
+    ClassGroup=(PCG),
+    meta=(
+        DisplayName="Heightfield To Dynamic Mesh",
+        Category="PCG|Dynamic Mesh"
+    )
+)
+class WDEDITOR_API UPCGLandscapeHeightfieldToDynamicMeshSettings : public UPCGDynamicMeshBaseSettings
+{
+    GENERATED_BODY()
+
+public:
+    /** Factory that creates the element corresponding to this settings class. */
+    virtual FPCGElementPtr CreateElement() const override;
+
+#if WITH_EDITOR
+    virtual FName GetDefaultNodeName() const override { return TEXT("HeightfieldToDynamicMesh"); }
+
+    virtual FText GetDefaultNodeTitle() const override
+    {
+        return NSLOCTEXT("WDEditor", "HeightfieldToDynamicMesh_Title", "Heightfield To Dynamic Mesh");
+    }
+#endif
+
+protected:
+    /** The input pin also accepts heightfield data (typed Other). */
+    virtual TArray<FPCGPinProperties> InputPinProperties() const override;
+};
@@ -6,6 +6,7 @@
 
 #include "DynamicMesh/DynamicMesh3.h"
 
+#include "PCG/PCGLandscapeHeightfield.h"
 #include "PCG/PCGLandscapeMeshSubdivision.h"
 
 /**
@@ -77,6 +78,16 @@ namespace WDEditor::PCG
                  * your downstream tools (e.g. 0-255 for 8-bit groups).
                  */
                 int32 PaddingPolygroupID = -1;
+
+                /**
+                 * If true, rows of cells are triangulated in parallel bands and merged in
+                 * band order. The mesh (vertex, triangle and edge IDs) is identical to the
+                 * serial build.
+                 */
+                bool bUseTiledBuild = true;
+
+                /** Cell rows per band for the tiled build. <= 0 picks a size from the worker count. */
+                int32 TiledBuildRowsPerBand = 0;
         };
 
         /** Input grid description. Samples must be GridX*GridY and row-major (X changes fastest). */
@@ -107,6 +118,18 @@ namespace WDEditor::PCG
                 int32 NumTrianglesAfterCrop = 0;
 
                 FPCGLandscapeSubdivisionStats SubdivisionStats;
+
+                /** Row bands used for the topology (1 for the serial build). */
+                int32 NumBands = 0;
+
+                /** Timings in milliseconds. MergeMs is only set by the tiled build. */
+                double CornersMs = 0.0;
+                double TriangulateMs = 0.0;
+                double MergeMs = 0.0;
+                double ConstraintsMs = 0.0;
+                double CropMs = 0.0;
+                double NormalsMs = 0.0;
+                double TotalMs = 0.0;
         };
 
         /**
@@ -131,4 +154,30 @@ namespace WDEditor::PCG
                 UE::Geometry::FDynamicMesh3& OutMesh,
                 FPCGLandscapeMeshConstraints& OutConstraints,
                 FPCGLandscapeMeshBuilderStats* OutStats = nullptr);
+
+        /**
+         * Build a heightfield from overscanned grid samples: heights, normals and solidity per vertex, and the
+         * edge crossings of the mask boundary cells when marching squares is enabled. Cropped to the cells
+         * overlapping CropBounds unless Settings.bIncludePadding is set; BuildMeshFromHeightfield then crops
+         * (or marks as padding) the triangles by centroid, as BuildMeshFromSamples does.
+         * Subdivision, constraint and cleanup settings do not apply.
+         *
+         * @return true if the heightfield has cells inside CropBounds.
+         */
+        bool BuildHeightfieldFromSamples(
+                const FPCGLandscapeMeshGridDesc& GridDesc,
+                const FPCGLandscapeMeshBuilderSettings& Settings,
+                const FBox2D& CropBoundsXY,
+                FPCGLandscapeHeightfield& OutHeightfield);
+
+        /**
+         * Build the general mesh of a heightfield, in local XY (Heightfield.OriginXY). The triangles match
+         * BuildMeshFromSamples after crop and isolated vertex removal; normals are the heightfield normals
+         * (interpolated on mask crossings), in a per-vertex primary overlay.
+         *
+         * @return true if the mesh contains triangles.
+         */
+        bool BuildMeshFromHeightfield(
+                const FPCGLandscapeHeightfield& Heightfield,
+                UE::Geometry::FDynamicMesh3& OutMesh);
 } // namespace WDEditor::PCG
\ No newline at end of file
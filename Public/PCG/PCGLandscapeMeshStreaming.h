@@ -0,0 +1,97 @@
+// Copyright BULKHEAD Limited. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "DynamicMesh/DynamicMesh3.h"
+
+#include "PCG/PCGLandscapeMeshBuilder.h"
+
+/**
+ * Streamed build of regions too large for a single BuildMeshFromSamples call.
+ *
+ * The region is meshed in tiles of TileCells cells on the region lattice, one tile at a time, and each tile
+ * is welded into a single mesh. Tile crop bounds lie on lattice lines, so every cell belongs to exactly one
+ * tile. Vertices on interior tile seams are keyed by their lattice corner or lattice edge and reused by the
+ * later tiles; tiles go row by row, so the seam vertices of a finished tile row are dropped.
+ */
+
+namespace WDEditor::PCG
+{
+	/**
+	 * Upper bound of the grid vertices of a streamed region (overscan included). A lattice vertex yields at
+	 * most three mesh vertices (itself and two edge crossings) and a cell at most six triangles, which keeps
+	 * vertex and triangle IDs of the welded mesh well within int32.
+	 */
+	constexpr int64 MaxStreamedGridPoints = 256ll * 1024ll * 1024ll;
+
+	struct FPCGLandscapeMeshStreamingState
+	{
+		FBox2D CropBoundsXY = FBox2D(ForceInit);
+		FVector2D LatticeMinXY = FVector2D::ZeroVector;
+		double CellSize = 100.0;
+		int32 OverscanCells = 0;
+		int32 TileCells = 0;
+		int32 NumTilesX = 0;
+		int32 NumTilesY = 0;
+		int32 NextTileIndex = 0;
+
+		/** Welded mesh, local to the crop bounds center like the single build. Normal element IDs equal vertex IDs. */
+		UE::Geometry::FDynamicMesh3 Mesh;
+
+		/** Seam vertex of each lattice corner (Z = 0), vertical (Z = 1) or horizontal (Z = 2) lattice edge. */
+		TMap<FIntVector, int32> SeamVertices;
+
+		/**
+		 * Sets up the tiles covering CropBoundsXY and clears the mesh.
+		 * False if the region, overscan included, has more than MaxStreamedGridPoints grid vertices.
+		 */
+		bool Init(const FBox2D& InCropBoundsXY, double InCellSize, int32 InOverscanCells, int32 InTileCells, bool bTriangleGroups);
+
+		/** Grid vertices of the region, overscan included, as the single build would sample them. */
+		static int64 GetNumGridPoints(const FBox2D& InCropBoundsXY, double InCellSize, int32 InOverscanCells);
+
+		int32 NumTiles() const
+		{
+			return NumTilesX * NumTilesY;
+		}
+
+		/** Tile bounds: interior seams are computed the same way by both neighbours, the last tiles end at the region bounds. */
+		FBox2D GetTileCropBounds(int32 TileIndex) const;
+
+		/** Bounds to sample for a tile: its crop bounds plus the overscan. */
+		FBox2D GetTileExpandedBounds(int32 TileIndex) const;
+
+		/** Bounds the tile mesh is cropped to: its crop bounds, plus the overscan on the region border sides with padding. */
+		FBox2D GetTileBuildCropBounds(int32 TileIndex, bool bIncludePadding) const;
+
+		/** Lattice line (vertex column or row index) is an interior tile boundary. */
+		bool IsSeamLine(int32 LatticeLine, int32 InNumTiles) const;
+
+		/** Key of a vertex (local to the crop bounds center) lying on an interior seam, false for any other vertex. */
+		bool MakeSeamKey(const FVector3d& LocalPosition, FIntVector& OutKey) const;
+
+		/**
+		 * Appends the triangles of a tile mesh (local to TileOriginXY) to the streamed mesh, welding seam vertices.
+		 * Triangles outside the region crop bounds go to PaddingPolygroupID when it is >= 0.
+		 */
+		void AppendTile(const UE::Geometry::FDynamicMesh3& TileMesh, const FVector2D& TileOriginXY, int32 PaddingPolygroupID);
+
+		/** Call once a tile is done, meshed or not. After the last tile of a row, drops the seam vertices no later tile can reach. */
+		void FinishTile(int32 TileIndex);
+	};
+
+	/**
+	 * Builds the mesh of one tile from samples covering GetTileExpandedBounds(TileIndex) and welds it into the
+	 * streamed mesh. Settings.bIncludePadding and PaddingPolygroupID apply to the region, the tile itself is
+	 * always cropped.
+	 *
+	 * @return true if the tile has triangles.
+	 */
+	bool BuildStreamingTileFromSamples(
+		FPCGLandscapeMeshStreamingState& State,
+		int32 TileIndex,
+		const FPCGLandscapeMeshGridDesc& TileGridDesc,
+		const FPCGLandscapeMeshBuilderSettings& Settings);
+} // namespace WDEditor::PCG
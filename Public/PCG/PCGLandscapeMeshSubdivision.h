@@ -7,6 +7,8 @@
 #include "DynamicMesh/DynamicMesh3.h"
 #include "DynamicMesh/DynamicMeshAttributeSet.h"
 
+#include "PCG/PCGGridLattice.h"
+
 /**
  * PN-style interior-only subdivision utilities for PCG-generated meshes.
  *
@@ -15,7 +17,11 @@
  *  - Never splits or moves constrained vertices / edges
  *  - Is deterministic and partition-safe
  *
- * Intended for use by PCGLandscapeToDynamicMesh and similar nodes.
+ * Each level classifies triangles in parallel, picks the edges to split, gives their midpoints
+ * vertex IDs in edge ID order (prefix sum over a flat per-edge table) and rebuilds the split
+ * triangles in one pass. Triangles next to a split edge get a conforming split (no T-junctions).
+ *
+ * Exposed as the Dynamic Mesh PN Subdivision node (PCGDynamicMeshPNSubdivision).
  */
 
 namespace WDEditor::PCG
@@ -31,15 +37,15 @@ namespace WDEditor::PCG
 
 	/**
 	 * Hard constraints for refinement.
-	 * These must be populated by the caller.
+	 * These must be populated by the caller. Stored as bit arrays indexed by vertex / edge ID.
 	 */
 	struct FPCGLandscapeMeshConstraints
 	{
 		/** Vertices that must never move or be refined. */
-		TSet<int32> ConstrainedVertices;
+		FPCGDenseIndexSet ConstrainedVertices;
 
 		/** Edges that must never be split. */
-		TSet<int32> ConstrainedEdges;
+		FPCGDenseIndexSet ConstrainedEdges;
 
 		FORCEINLINE bool IsVertexConstrained(int32 Vid) const
 		{
@@ -87,8 +93,18 @@ namespace WDEditor::PCG
 		bool bEnsureNormalOverlay = true;
 	};
 
+	/**
+	 * Constrains the open boundary edges (region crop, mask holes) and their vertices, and optionally the
+	 * edges between triangles of different polygroups. Replaces the content of OutConstraints.
+	 */
+	void BuildBoundaryConstraints(
+		const UE::Geometry::FDynamicMesh3& Mesh,
+		bool bConstrainGroupBoundaries,
+		FPCGLandscapeMeshConstraints& OutConstraints);
+
 	/**
 	 * Applies interior-only PN-style subdivision.
+	 * Constrained vertices keep their position and, when the mesh has a normal overlay, their normal.
 	 *
 	 * @return true if any triangles were refined.
 	 */
@@ -27,8 +27,18 @@
  
                  /** Invert the sampled mask (1 – weight) before thresholding. */
                  bool bInvertMask = false;
+
+                 /**
+                  * Sample through UPCGLandscapeData::SampleGrid (grouped by landscape component, parallel,
+                  * no metadata). When false, falls back to one ProjectPoint call per vertex.
+                  */
+                 bool bUseBatchedSampling = true;
          };
  
+         /**
+          * Sample the landscape at every vertex of a GridX*GridY lattice starting at ExpandedBoundsXY.Min.
+          * OutSamples is row-major (X changes fastest), as expected by BuildMeshFromSamples.
+          */
          bool SampleLandscapeToGrid(
                  const UPCGLandscapeData* LandscapeData,
                  const FBox2D& ExpandedBoundsXY,
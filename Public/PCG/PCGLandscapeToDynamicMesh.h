@@ -72,6 +72,14 @@ class UMaterialInterface;
          UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Sampling",
                  meta=(PCG_Overridable, ClampMin="0"))
          int32 OverscanCells = 1;
+
+         /**
+          * Sample the grid in batches grouped by landscape component, on all workers and without metadata.
+          * Disable to fall back to one ProjectPoint call per grid vertex.
+          */
+         UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Sampling",
+                 meta=(PCG_Overridable), AdvancedDisplay)
+         bool bUseBatchedSampling = true;
  
          // ============================================================
          // Bounds
@@ -81,6 +89,25 @@ class UMaterialInterface;
                  meta=(PCG_Overridable))
          EPCGLandscapeBoundsIntersectMode BoundsMode =
                  EPCGLandscapeBoundsIntersectMode::Intersect;
+
+         // ============================================================
+         // Streaming
+         // ============================================================
+
+         /**
+          * When the grid exceeds the single build limit (16M vertices), sample and mesh the region
+          * in tiles, one or more per frame, and weld them into the output instead of aborting.
+          * Working memory is bounded by a row of tiles; isolated vertices are always removed.
+          * Regions over 256M grid vertices are refused with an error, streamed or not.
+          */
+         UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Streaming",
+                 meta=(PCG_Overridable))
+         bool bStreamLargeRegions = true;
+
+         /** Cells per tile side when streaming. Smaller tiles use less memory and give shorter time slices. */
+         UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Streaming",
+                 meta=(PCG_Overridable, ClampMin="16", EditCondition="bStreamLargeRegions"), AdvancedDisplay)
+         int32 StreamingTileCells = 1024;
  
          // ============================================================
          // Mask / Topology
@@ -102,6 +129,14 @@ class UMaterialInterface;
                  meta=(PCG_Overridable))
          bool bUseMarchingSquares = true;
  
+         /**
+          * Triangulate rows of cells in parallel bands, merged in order. The mesh is identical to the serial build.
+          * Disable to fall back to the serial triangulation.
+          */
+         UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Mask",
+                 meta=(PCG_Overridable), AdvancedDisplay)
+         bool bUseTiledBuild = true;
+ 
          /** Invert the sampled mask (1 – weight) before thresholding. */
          UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Mask",
                  meta=(PCG_Overridable))
@@ -129,6 +164,20 @@ class UMaterialInterface;
               meta=(PCG_Overridable, ClampMin="1", EditCondition="bIncludePadding"))
     int32 PaddingPolygroupID = 1;
 
+    // ============================================================
+    // Output
+    // ============================================================
+
+    /**
+     * Output landscape heightfield data instead of a dynamic mesh: heights, normals and mask solidity per
+     * grid vertex plus the mask boundary cells, several times smaller than the mesh. Dynamic Mesh
+     * Displacement works on it directly; use Heightfield To Dynamic Mesh before other dynamic mesh nodes.
+     * Regions over the single build limit are not streamed in this mode.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Mesh",
+              meta=(PCG_Overridable))
+    bool bOutputHeightfield = false;
+
     // ============================================================
     // Material
     // ============================================================
@@ -1,8 +1,20 @@
 #pragma once
 
 #include "PCGSettings.h"
+#include "Utils/PCGValueRange.h"
+
+#include "Containers/BitArray.h"
+
 #include "PCGPointsToDynamicMeshGrid.generated.h"
 
+class UPCGBasePointData;
+struct FPCGContext;
+
+namespace UE::Geometry
+{
+	class FDynamicMesh3;
+}
+
 /**
  * Builds a Dynamic Mesh grid from input points, writing into an input DynamicMeshData.
  * Thread-safe: does NOT spawn components. Use Epic's Spawn Dynamic Mesh node after this.
@@ -23,6 +35,9 @@
  * Mask semantics match Landscape visibility:
  *     Value >= Threshold  -> solid
  *     Value <  Threshold  -> hole
+ *
+ * Grid layout: any point data (UPCGPointData or UPCGPointArrayData), read in bulk through value ranges
+ * and attribute accessors. The lattice is GridX x GridY vertices, see EPCGPointsGridLayout.
  */
 UENUM(BlueprintType)
 enum class EPCGGridTopologyMode : uint8
@@ -31,6 +46,24 @@ enum class EPCGGridTopologyMode : uint8
 	LandscapeParity  UMETA(DisplayName = "Landscape Parity (Hybrid Marching Squares)")
 };
 
+/** How input points map to grid vertices. */
+UENUM(BlueprintType)
+enum class EPCGPointsGridLayout : uint8
+{
+	/**
+	 * Row-major points (X changes fastest), as output by Create Points Grid. The row length is the number of
+	 * leading points along the direction from the first point to the second (within 1% of their spacing), so
+	 * rotated grids are supported. Falls back to a square grid, with a warning, when the rows cannot be inferred.
+	 */
+	Auto                UMETA(DisplayName = "Auto (Row Major)"),
+
+	/** Row-major points with the given number of columns (X) and rows (Y). */
+	Dimensions          UMETA(DisplayName = "Explicit Dimensions"),
+
+	/** Integer row/column attributes on each point. Missing grid vertices are holes, duplicates are ignored. */
+	RowColumnAttributes UMETA(DisplayName = "Row / Column Attributes")
+};
+
 UCLASS(
 	BlueprintType,
 	ClassGroup = (PCG),
@@ -94,6 +127,69 @@ public:
 	)
 	EPCGGridTopologyMode TopologyMode = EPCGGridTopologyMode::UniformGrid;
 
+	/**
+	 * Triangulate rows of cells in parallel bands, appended in order. The mesh is identical to the serial build.
+	 * Disable to triangulate on a single thread.
+	 */
+	UPROPERTY(
+		EditAnywhere,
+		BlueprintReadWrite,
+		Category = "Topology",
+		meta = (PCG_Overridable),
+		AdvancedDisplay
+	)
+	bool bUseParallelBuild = true;
+
+	/** Cell rows per band for the parallel build. 0 picks a size from the worker count. */
+	UPROPERTY(
+		EditAnywhere,
+		BlueprintReadWrite,
+		Category = "Topology",
+		meta = (PCG_Overridable, ClampMin = "0", EditCondition = "bUseParallelBuild"),
+		AdvancedDisplay
+	)
+	int32 RowsPerBand = 0;
+
+	// ============================================================
+	// Grid
+	// ============================================================
+
+	/** How input points map to grid vertices. */
+	UPROPERTY(
+		EditAnywhere,
+		BlueprintReadWrite,
+		Category = "Grid",
+		meta = (PCG_Overridable)
+	)
+	EPCGPointsGridLayout GridLayout = EPCGPointsGridLayout::Auto;
+
+	/** Columns (X) and rows (Y) of the grid. The point count must be X * Y. */
+	UPROPERTY(
+		EditAnywhere,
+		BlueprintReadWrite,
+		Category = "Grid",
+		meta = (PCG_Overridable, ClampMin = "2", EditCondition = "GridLayout == EPCGPointsGridLayout::Dimensions", EditConditionHides)
+	)
+	FIntPoint GridDimensions = FIntPoint(2, 2);
+
+	/** Integer attribute holding the row (Y) of each point. The grid starts at the smallest row. */
+	UPROPERTY(
+		EditAnywhere,
+		BlueprintReadWrite,
+		Category = "Grid",
+		meta = (PCG_Overridable, EditCondition = "GridLayout == EPCGPointsGridLayout::RowColumnAttributes", EditConditionHides)
+	)
+	FName RowAttribute = TEXT("Row");
+
+	/** Integer attribute holding the column (X) of each point. The grid starts at the smallest column. */
+	UPROPERTY(
+		EditAnywhere,
+		BlueprintReadWrite,
+		Category = "Grid",
+		meta = (PCG_Overridable, EditCondition = "GridLayout == EPCGPointsGridLayout::RowColumnAttributes", EditConditionHides)
+	)
+	FName ColumnAttribute = TEXT("Column");
+
 	// ============================================================
 	// Masking / Visibility
 	// ============================================================
@@ -150,3 +246,55 @@ public:
 	)
 	bool bCompactAtEnd = true;
 };
+
+namespace WDEditor::PCG
+{
+	/** Grid vertices built from the input points, row-major (X changes fastest). */
+	struct FPCGPointsGridLattice
+	{
+		int32 GridX = 0;
+		int32 GridY = 0;
+
+		TArray<FVector3d> Positions;
+		TArray<FVector3f> Normals;
+		TArray<float> Mask;
+		TArray<bool> Solid;
+
+		/** Grid vertices that have a point. Empty when every grid vertex has one. */
+		TBitArray<> Present;
+
+		FORCEINLINE int32 Index(int32 X, int32 Y) const
+		{
+			return Y * GridX + X;
+		}
+
+		/** Cells with a missing corner are not triangulated. */
+		FORCEINLINE bool IsCellComplete(int32 X, int32 Y) const
+		{
+			return Present.IsEmpty()
+				|| (Present[Index(X, Y)] && Present[Index(X, Y + 1)] && Present[Index(X + 1, Y + 1)] && Present[Index(X + 1, Y)]);
+		}
+	};
+
+	/**
+	 * Grid size and, for the row/column layout, the grid vertex of each point (INDEX_NONE for duplicates).
+	 * OutLatticeIndices stays empty when points are already in grid order, OutGrid.Present only filled for the
+	 * row/column layout. Needs at least 4 points.
+	 */
+	bool ResolvePointsGridLayout(
+		FPCGContext* Context,
+		const UPCGPointsToDynamicMeshGridSettings& Settings,
+		const UPCGBasePointData* PointData,
+		const TConstPCGValueRange<FTransform>& Transforms,
+		FPCGPointsGridLattice& OutGrid,
+		TArray<int32>& OutLatticeIndices);
+
+	/**
+	 * Clears Mesh and triangulates the grid vertices into it (in row bands when Settings.bUseParallelBuild),
+	 * then removes grid vertices without a point and applies the mesh cleanup settings.
+	 */
+	void BuildPointsGridMesh(
+		const FPCGPointsGridLattice& Grid,
+		const UPCGPointsToDynamicMeshGridSettings& Settings,
+		UE::Geometry::FDynamicMesh3& Mesh);
+} // namespace WDEditor::PCG